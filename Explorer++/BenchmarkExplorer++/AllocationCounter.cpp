@@ -0,0 +1,61 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::atomic<uint64_t> g_numAllocations = 0;
+std::atomic<uint64_t> g_numBytesAllocated = 0;
+
+void *CountedAllocate(size_t size)
+{
+	g_numAllocations.fetch_add(1, std::memory_order_relaxed);
+	g_numBytesAllocated.fetch_add(size, std::memory_order_relaxed);
+
+	// malloc(0) is allowed to return nullptr, whereas operator new must return a unique pointer.
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+}
+
+AllocationStats GetAllocationStats()
+{
+	return { g_numAllocations.load(std::memory_order_relaxed),
+		g_numBytesAllocated.load(std::memory_order_relaxed) };
+}
+
+// The array and sized forms of these functions forward to the forms below by default, so only the
+// basic forms need to be replaced.
+void *operator new(size_t size)
+{
+	void *ptr = CountedAllocate(size);
+
+	if (!ptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	return ptr;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+	return CountedAllocate(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+	std::free(ptr);
+}
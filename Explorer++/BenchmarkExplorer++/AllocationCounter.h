@@ -0,0 +1,18 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <cstdint>
+
+// The global allocation functions are replaced within this executable, so that the number of
+// allocations made by a piece of code can be measured. The counts include allocations made on
+// every thread.
+struct AllocationStats
+{
+	uint64_t numAllocations;
+	uint64_t numBytesAllocated;
+};
+
+AllocationStats GetAllocationStats();
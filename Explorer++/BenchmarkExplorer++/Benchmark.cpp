@@ -0,0 +1,140 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "Benchmark.h"
+#include <algorithm>
+
+BenchmarkState::BenchmarkState(size_t numItems, std::chrono::nanoseconds minRunTime) :
+	m_numItems(numItems),
+	m_minRunTime(minRunTime)
+{
+}
+
+size_t BenchmarkState::GetNumItems() const
+{
+	return m_numItems;
+}
+
+bool BenchmarkState::KeepRunning()
+{
+	if (!m_started)
+	{
+		m_started = true;
+		ResumeTiming();
+		return true;
+	}
+
+	// Timing should only ever be paused for part of an iteration.
+	DCHECK(m_running);
+
+	m_numIterations++;
+
+	// The elapsed time is only updated when timing is paused, so the time for the current
+	// iteration needs to be added here.
+	auto elapsedTime = m_elapsedTime + (std::chrono::steady_clock::now() - m_startTime);
+
+	if (elapsedTime < m_minRunTime)
+	{
+		return true;
+	}
+
+	PauseTiming();
+
+	return false;
+}
+
+void BenchmarkState::PauseTiming()
+{
+	DCHECK(m_running);
+
+	auto now = std::chrono::steady_clock::now();
+	auto allocationStats = ::GetAllocationStats();
+
+	m_elapsedTime += now - m_startTime;
+	m_allocationStats.numAllocations +=
+		allocationStats.numAllocations - m_startAllocationStats.numAllocations;
+	m_allocationStats.numBytesAllocated +=
+		allocationStats.numBytesAllocated - m_startAllocationStats.numBytesAllocated;
+
+	m_running = false;
+}
+
+void BenchmarkState::ResumeTiming()
+{
+	DCHECK(!m_running);
+
+	m_running = true;
+	m_startAllocationStats = ::GetAllocationStats();
+	m_startTime = std::chrono::steady_clock::now();
+}
+
+uint64_t BenchmarkState::GetNumIterations() const
+{
+	return m_numIterations;
+}
+
+std::chrono::nanoseconds BenchmarkState::GetElapsedTime() const
+{
+	return m_elapsedTime;
+}
+
+void BenchmarkState::AddToCounter(const std::string &name, uint64_t value)
+{
+	m_counters[name] += value;
+}
+
+AllocationStats BenchmarkState::GetAllocationStats() const
+{
+	return m_allocationStats;
+}
+
+const std::map<std::string, uint64_t> &BenchmarkState::GetCounters() const
+{
+	return m_counters;
+}
+
+void BenchmarkRegistry::Register(const std::string &name, BenchmarkFunction function,
+	std::optional<size_t> maxItems)
+{
+	m_benchmarks.emplace_back(name, std::move(function), maxItems);
+}
+
+const std::vector<BenchmarkRegistry::Benchmark> &BenchmarkRegistry::GetBenchmarks() const
+{
+	return m_benchmarks;
+}
+
+BenchmarkResult RunBenchmark(const BenchmarkRegistry::Benchmark &benchmark, size_t numItems,
+	std::chrono::nanoseconds minRunTime)
+{
+	BenchmarkState state(numItems, minRunTime);
+	benchmark.function(state);
+
+	// Every benchmark is expected to run the measurement loop to completion.
+	CHECK_GT(state.GetNumIterations(), 0u) << benchmark.name;
+
+	auto numIterations = static_cast<double>(state.GetNumIterations());
+	auto elapsedNanoseconds = static_cast<double>(state.GetElapsedTime().count());
+	auto allocationStats = state.GetAllocationStats();
+
+	BenchmarkResult result;
+	result.name = benchmark.name;
+	result.numItems = numItems;
+	result.numIterations = state.GetNumIterations();
+	result.nanosecondsPerIteration = elapsedNanoseconds / numIterations;
+	result.nanosecondsPerItem =
+		result.nanosecondsPerIteration / static_cast<double>(std::max<size_t>(numItems, 1));
+	result.allocationsPerIteration =
+		static_cast<double>(allocationStats.numAllocations) / numIterations;
+	result.bytesAllocatedPerIteration =
+		static_cast<double>(allocationStats.numBytesAllocated) / numIterations;
+
+	for (const auto &[name, value] : state.GetCounters())
+	{
+		result.countersPerIteration[name] = static_cast<double>(value) / numIterations;
+	}
+
+	return result;
+}
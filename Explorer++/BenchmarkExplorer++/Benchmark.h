@@ -0,0 +1,105 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "AllocationCounter.h"
+#include <boost/core/noncopyable.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct BenchmarkResult
+{
+	std::string name;
+	size_t numItems;
+	uint64_t numIterations;
+
+	// All of the values below are averages over the iterations that were run.
+	double nanosecondsPerIteration;
+	double nanosecondsPerItem;
+	double allocationsPerIteration;
+	double bytesAllocatedPerIteration;
+
+	// Any benchmark-specific counters (e.g. the number of messages posted), averaged in the same
+	// way.
+	std::map<std::string, double> countersPerIteration;
+};
+
+// Passed to each benchmark. A benchmark performs any setup it needs and then runs the code being
+// measured in a loop of the form:
+//
+// while (state.KeepRunning())
+// {
+//     ...
+// }
+//
+// Only the time spent (and allocations made) within the loop are measured. The loop continues
+// until the minimum run time has been reached.
+class BenchmarkState : private boost::noncopyable
+{
+public:
+	BenchmarkState(size_t numItems, std::chrono::nanoseconds minRunTime);
+
+	size_t GetNumItems() const;
+	bool KeepRunning();
+
+	// Can be used to exclude per-iteration setup (e.g. restoring an unsorted copy of the input)
+	// from the measurements.
+	void PauseTiming();
+	void ResumeTiming();
+
+	// Allows a benchmark to report a quantity other than time and allocations. The value should
+	// be the total for the entire run; it will be averaged over the number of iterations.
+	void AddToCounter(const std::string &name, uint64_t value);
+
+	uint64_t GetNumIterations() const;
+	std::chrono::nanoseconds GetElapsedTime() const;
+	AllocationStats GetAllocationStats() const;
+	const std::map<std::string, uint64_t> &GetCounters() const;
+
+private:
+	const size_t m_numItems;
+	const std::chrono::nanoseconds m_minRunTime;
+
+	bool m_started = false;
+	bool m_running = false;
+	uint64_t m_numIterations = 0;
+
+	std::chrono::steady_clock::time_point m_startTime;
+	AllocationStats m_startAllocationStats = {};
+	std::chrono::nanoseconds m_elapsedTime = {};
+	AllocationStats m_allocationStats = {};
+	std::map<std::string, uint64_t> m_counters;
+};
+
+using BenchmarkFunction = std::function<void(BenchmarkState &state)>;
+
+class BenchmarkRegistry : private boost::noncopyable
+{
+public:
+	struct Benchmark
+	{
+		std::string name;
+		BenchmarkFunction function;
+
+		// Some operations (e.g. inserting items one at a time) scale quadratically. Those
+		// benchmarks will be skipped for item counts above this value.
+		std::optional<size_t> maxItems;
+	};
+
+	void Register(const std::string &name, BenchmarkFunction function,
+		std::optional<size_t> maxItems = std::nullopt);
+	const std::vector<Benchmark> &GetBenchmarks() const;
+
+private:
+	std::vector<Benchmark> m_benchmarks;
+};
+
+BenchmarkResult RunBenchmark(const BenchmarkRegistry::Benchmark &benchmark, size_t numItems,
+	std::chrono::nanoseconds minRunTime);
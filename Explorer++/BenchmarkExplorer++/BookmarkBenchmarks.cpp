@@ -0,0 +1,143 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "BookmarkBenchmarks.h"
+#include "Benchmark.h"
+#include "Bookmarks/BookmarkItem.h"
+#include "Bookmarks/BookmarkSearchIndex.h"
+#include "Bookmarks/BookmarkTree.h"
+#include <format>
+
+namespace
+{
+
+// Builds a folder that contains the specified number of bookmarks, split across a set of
+// subfolders, in the same way that a large imported bookmarks file would typically be organized.
+std::unique_ptr<BookmarkItem> CreateBookmarkFolder(size_t numBookmarks)
+{
+	constexpr size_t BOOKMARKS_PER_FOLDER = 100;
+
+	auto importFolder = std::make_unique<BookmarkItem>(std::nullopt, L"Imported", std::nullopt);
+	std::unique_ptr<BookmarkItem> currentFolder;
+
+	for (size_t i = 0; i < numBookmarks; i++)
+	{
+		if (!currentFolder)
+		{
+			currentFolder = std::make_unique<BookmarkItem>(std::nullopt,
+				std::format(L"Folder {}", i / BOOKMARKS_PER_FOLDER), std::nullopt);
+		}
+
+		currentFolder->AddChild(std::make_unique<BookmarkItem>(std::nullopt,
+			std::format(L"Bookmark {}", i), std::format(L"C:\\Bookmarks\\Location {}", i)));
+
+		if (currentFolder->GetChildren().size() == BOOKMARKS_PER_FOLDER || i == numBookmarks - 1)
+		{
+			importFolder->AddChild(std::move(currentFolder));
+		}
+	}
+
+	return importFolder;
+}
+
+void BulkImportBenchmark(BenchmarkState &state)
+{
+	while (state.KeepRunning())
+	{
+		state.PauseTiming();
+		BookmarkTree bookmarkTree;
+		auto importFolder = CreateBookmarkFolder(state.GetNumItems());
+		state.ResumeTiming();
+
+		// Adding the folder results in every item within it being indexed by GUID.
+		bookmarkTree.AddBookmarkItem(bookmarkTree.GetBookmarksMenuFolder(),
+			std::move(importFolder), bookmarkTree.GetBookmarksMenuFolder()->GetChildren().size());
+	}
+}
+
+void LookupByIdBenchmark(BenchmarkState &state)
+{
+	BookmarkTree bookmarkTree;
+	auto *importFolder = bookmarkTree.AddBookmarkItem(bookmarkTree.GetBookmarksMenuFolder(),
+		CreateBookmarkFolder(state.GetNumItems()),
+		bookmarkTree.GetBookmarksMenuFolder()->GetChildren().size());
+
+	std::vector<std::wstring> guids;
+	guids.reserve(state.GetNumItems());
+
+	for (const auto &folder : importFolder->GetChildren())
+	{
+		for (const auto &bookmark : folder->GetChildren())
+		{
+			guids.push_back(bookmark->GetGUID());
+		}
+	}
+
+	while (state.KeepRunning())
+	{
+		size_t numFound = 0;
+
+		for (const auto &guid : guids)
+		{
+			if (bookmarkTree.GetBookmarkItemById(guid))
+			{
+				numFound++;
+			}
+		}
+
+		CHECK_EQ(numFound, guids.size());
+	}
+}
+
+void BuildSearchIndexBenchmark(BenchmarkState &state)
+{
+	BookmarkTree bookmarkTree;
+	bookmarkTree.AddBookmarkItem(bookmarkTree.GetBookmarksMenuFolder(),
+		CreateBookmarkFolder(state.GetNumItems()),
+		bookmarkTree.GetBookmarksMenuFolder()->GetChildren().size());
+
+	while (state.KeepRunning())
+	{
+		BookmarkSearchIndex searchIndex(&bookmarkTree);
+	}
+}
+
+// The target here is for each query to complete in under a millisecond with 50,000 bookmarks, since
+// queries are run as the user types. The 100,000 item run provides an upper bound for that.
+void SearchBenchmark(BenchmarkState &state)
+{
+	BookmarkTree bookmarkTree;
+	bookmarkTree.AddBookmarkItem(bookmarkTree.GetBookmarksMenuFolder(),
+		CreateBookmarkFolder(state.GetNumItems()),
+		bookmarkTree.GetBookmarksMenuFolder()->GetChildren().size());
+
+	BookmarkSearchIndex searchIndex(&bookmarkTree);
+
+	// A mix of a query that matches every item, one that matches a small number of items and one
+	// that matches a single item.
+	const std::vector<std::wstring> queries = { L"bookmark", L"location 12", L"bookmark 1234" };
+	uint64_t numQueries = 0;
+
+	while (state.KeepRunning())
+	{
+		for (const auto &query : queries)
+		{
+			searchIndex.Search(query, 50);
+			numQueries++;
+		}
+	}
+
+	state.AddToCounter("queries", numQueries);
+}
+
+}
+
+void RegisterBookmarkBenchmarks(BenchmarkRegistry &registry)
+{
+	registry.Register("Bookmarks.BulkImport", BulkImportBenchmark);
+	registry.Register("Bookmarks.LookupById", LookupByIdBenchmark);
+	registry.Register("Bookmarks.BuildSearchIndex", BuildSearchIndexBenchmark);
+	registry.Register("Bookmarks.Search", SearchBenchmark);
+}
@@ -0,0 +1,320 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "HelperBenchmarks.h"
+#include "Benchmark.h"
+#include "SyntheticItems.h"
+#include "../Helper/CachedFormatter.h"
+#include "../Helper/Helper.h"
+#include "../Helper/ResultQueue.h"
+#include "../Helper/StringHelper.h"
+#include "../Helper/TaskScheduler.h"
+#include "../Helper/WildcardMatcher.h"
+#include <Shlwapi.h>
+#include <algorithm>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+
+constexpr wchar_t WILDCARD_PATTERN[] = L"*.txt:IMG_*.jpg:report-?*:*backup*";
+
+std::vector<std::wstring> CreateSyntheticNames(size_t numItems)
+{
+	auto items = CreateSyntheticItems(numItems);
+
+	std::vector<std::wstring> names;
+	names.reserve(items.size());
+	std::transform(items.begin(), items.end(), std::back_inserter(names),
+		[](const BasicItemInfo_t &item) { return std::wstring(item.wfd.cFileName); });
+	return names;
+}
+
+void CheckWildcardMatchBenchmark(BenchmarkState &state)
+{
+	auto names = CreateSyntheticNames(state.GetNumItems());
+
+	while (state.KeepRunning())
+	{
+		size_t numMatching = std::count_if(names.begin(), names.end(),
+			[](const std::wstring &name)
+			{ return CheckWildcardMatch(WILDCARD_PATTERN, name.c_str(), false); });
+
+		CHECK_LE(numMatching, names.size());
+	}
+}
+
+void WildcardMatcherBenchmark(BenchmarkState &state)
+{
+	auto names = CreateSyntheticNames(state.GetNumItems());
+	WildcardMatcher matcher(WILDCARD_PATTERN, false);
+
+	while (state.KeepRunning())
+	{
+		size_t numMatching = std::count_if(names.begin(), names.end(),
+			[&matcher](const std::wstring &name) { return matcher.Matches(name); });
+
+		CHECK_LE(numMatching, names.size());
+	}
+}
+
+void FormatSizeStringBenchmark(BenchmarkState &state)
+{
+	auto items = CreateSyntheticItems(state.GetNumItems());
+
+	while (state.KeepRunning())
+	{
+		size_t totalLength = 0;
+
+		for (const auto &item : items)
+		{
+			ULARGE_INTEGER size = { item.wfd.nFileSizeLow, item.wfd.nFileSizeHigh };
+			totalLength += FormatSizeString(size.QuadPart).size();
+		}
+
+		CHECK_GT(totalLength, 0u);
+	}
+}
+
+void CachedFormatSizeBenchmark(BenchmarkState &state)
+{
+	auto items = CreateSyntheticItems(state.GetNumItems());
+	auto &formatter = CachedFormatter::GetForCurrentThread();
+
+	while (state.KeepRunning())
+	{
+		size_t totalLength = 0;
+
+		for (const auto &item : items)
+		{
+			ULARGE_INTEGER size = { item.wfd.nFileSizeLow, item.wfd.nFileSizeHigh };
+			wchar_t sizeText[64];
+			totalLength += formatter.FormatSize(size.QuadPart, SizeDisplayFormat::None, sizeText);
+		}
+
+		CHECK_GT(totalLength, 0u);
+	}
+}
+
+void CreateFileTimeStringBenchmark(BenchmarkState &state)
+{
+	auto items = CreateSyntheticItems(state.GetNumItems());
+
+	while (state.KeepRunning())
+	{
+		size_t totalLength = 0;
+
+		for (const auto &item : items)
+		{
+			wchar_t fileTime[128];
+
+			if (CreateFileTimeString(&item.wfd.ftLastWriteTime, fileTime, std::size(fileTime),
+					false))
+			{
+				totalLength += std::wstring(fileTime).size();
+			}
+		}
+
+		CHECK_GT(totalLength, 0u);
+	}
+}
+
+void CachedFormatFileTimeBenchmark(BenchmarkState &state)
+{
+	auto items = CreateSyntheticItems(state.GetNumItems());
+	auto &formatter = CachedFormatter::GetForCurrentThread();
+
+	while (state.KeepRunning())
+	{
+		size_t totalLength = 0;
+
+		for (const auto &item : items)
+		{
+			wchar_t fileTime[128];
+			totalLength += formatter.FormatFileTime(item.wfd.ftLastWriteTime, false, fileTime);
+		}
+
+		CHECK_GT(totalLength, 0u);
+	}
+}
+
+void NaturalSortCompareBenchmark(BenchmarkState &state)
+{
+	auto names = CreateSyntheticNames(state.GetNumItems());
+
+	while (state.KeepRunning())
+	{
+		size_t numLess = 0;
+
+		for (size_t i = 1; i < names.size(); i++)
+		{
+			if (StrCmpLogicalW(names[i - 1].c_str(), names[i].c_str()) < 0)
+			{
+				numLess++;
+			}
+		}
+
+		CHECK_LT(numLess, names.size());
+	}
+}
+
+// Stands in for a window's message queue, so that the number of messages posted when delivering
+// results back to the UI thread can be counted.
+class SimulatedMessageQueue
+{
+public:
+	SimulatedMessageQueue(size_t capacity)
+	{
+		m_messages.reserve(capacity);
+	}
+
+	void Post(int id)
+	{
+		{
+			std::scoped_lock lock(m_mutex);
+			m_messages.push_back(id);
+			m_numPosted++;
+		}
+
+		m_messageAvailable.notify_one();
+	}
+
+	int Get()
+	{
+		std::unique_lock lock(m_mutex);
+		m_messageAvailable.wait(lock, [this] { return m_nextIndex < m_messages.size(); });
+		return m_messages[m_nextIndex++];
+	}
+
+	// Removes any remaining messages, without freeing the storage used for them.
+	void Reset()
+	{
+		std::scoped_lock lock(m_mutex);
+		m_messages.clear();
+		m_nextIndex = 0;
+	}
+
+	uint64_t GetNumPosted()
+	{
+		std::scoped_lock lock(m_mutex);
+		return m_numPosted;
+	}
+
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_messageAvailable;
+	std::vector<int> m_messages;
+	size_t m_nextIndex = 0;
+	uint64_t m_numPosted = 0;
+};
+
+// Delivers each result through a future that's stored in a map, with one message posted per
+// result.
+void FutureResultDeliveryBenchmark(BenchmarkState &state)
+{
+	TaskScheduler taskScheduler;
+
+	// The tasks are allowed to run on every worker, so that results arrive concurrently, as they
+	// would from several busy queues.
+	TaskQueue taskQueue(&taskScheduler, TaskPriority::Normal, taskScheduler.GetNumWorkers());
+	SimulatedMessageQueue messageQueue(state.GetNumItems());
+	int numItems = static_cast<int>(state.GetNumItems());
+
+	while (state.KeepRunning())
+	{
+		std::unordered_map<int, std::future<int>> results;
+
+		for (int i = 0; i < numItems; i++)
+		{
+			auto result = taskQueue.Push(
+				[&messageQueue, i]
+				{
+					messageQueue.Post(i);
+					return i;
+				});
+			results.insert({ i, std::move(result) });
+		}
+
+		int64_t total = 0;
+
+		for (int i = 0; i < numItems; i++)
+		{
+			auto itr = results.find(messageQueue.Get());
+			CHECK(itr != results.end());
+			total += itr->second.get();
+			results.erase(itr);
+		}
+
+		CHECK_GE(total, 0);
+
+		state.PauseTiming();
+		messageQueue.Reset();
+		state.ResumeTiming();
+	}
+
+	state.AddToCounter("messages", messageQueue.GetNumPosted());
+}
+
+// Delivers results through a ResultQueue, which only posts a message when the queue goes from
+// being empty to non-empty.
+void ResultQueueDeliveryBenchmark(BenchmarkState &state)
+{
+	TaskScheduler taskScheduler;
+	SimulatedMessageQueue messageQueue(state.GetNumItems());
+	ResultQueue<int> resultQueue(
+		[&messageQueue]
+		{
+			messageQueue.Post(0);
+			return true;
+		});
+
+	// As above, the tasks are allowed to run on every worker.
+	TaskQueue taskQueue(&taskScheduler, TaskPriority::Normal, taskScheduler.GetNumWorkers());
+	size_t numItems = state.GetNumItems();
+
+	while (state.KeepRunning())
+	{
+		for (int i = 0; i < static_cast<int>(numItems); i++)
+		{
+			taskQueue.Post([&resultQueue, generation = resultQueue.GetGeneration(), i]
+				{ resultQueue.Push(generation, i); });
+		}
+
+		int64_t total = 0;
+		size_t numProcessed = 0;
+
+		while (numProcessed < numItems)
+		{
+			messageQueue.Get();
+			numProcessed += resultQueue.Drain([&total](int result) { total += result; });
+		}
+
+		CHECK_GE(total, 0);
+
+		state.PauseTiming();
+		messageQueue.Reset();
+		state.ResumeTiming();
+	}
+
+	state.AddToCounter("messages", messageQueue.GetNumPosted());
+}
+
+}
+
+void RegisterHelperBenchmarks(BenchmarkRegistry &registry)
+{
+	registry.Register("Helper.CheckWildcardMatch", CheckWildcardMatchBenchmark);
+	registry.Register("Helper.WildcardMatcher", WildcardMatcherBenchmark);
+	registry.Register("Helper.FormatSizeString", FormatSizeStringBenchmark);
+	registry.Register("Helper.CachedFormatter.FormatSize", CachedFormatSizeBenchmark);
+	registry.Register("Helper.CreateFileTimeString", CreateFileTimeStringBenchmark);
+	registry.Register("Helper.CachedFormatter.FormatFileTime", CachedFormatFileTimeBenchmark);
+	registry.Register("Helper.NaturalSortCompare", NaturalSortCompareBenchmark);
+	registry.Register("Helper.ResultDelivery.Future", FutureResultDeliveryBenchmark);
+	registry.Register("Helper.ResultDelivery.ResultQueue", ResultQueueDeliveryBenchmark);
+}
@@ -0,0 +1,172 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+// Runs a set of benchmarks that cover performance-sensitive parts of the application (sorting,
+// filtering, column text retrieval, etc.) against synthetic sets of items. For each benchmark and
+// item count, the average time and number of allocations per iteration are reported. Results can
+// also be written out as JSON, so that they can be compared between commits.
+//
+// Note that the benchmarks should be run using a release build, since the results from a debug
+// build aren't representative.
+
+#include "pch.h"
+#include "Benchmark.h"
+#include "BookmarkBenchmarks.h"
+#include "HelperBenchmarks.h"
+#include "PluginBenchmarks.h"
+#include "ShellBrowserBenchmarks.h"
+#include <CLI/App.hpp>
+#include <CLI/Config.hpp>
+#include <CLI/Formatter.hpp>
+#include <format>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+
+// Each of the item counts here is 10 times larger than the previous one, which makes it easy to
+// see how an operation scales.
+constexpr size_t ITEM_COUNTS[] = { 1'000, 10'000, 100'000, 1'000'000 };
+
+struct Options
+{
+	std::string filter;
+	size_t maxItems = 100'000;
+	int minRunTimeMs = 500;
+	std::string outputPath;
+	bool list = false;
+};
+
+std::string GetBuildConfiguration()
+{
+#ifdef _DEBUG
+	return "Debug";
+#else
+	return "Release";
+#endif
+}
+
+std::string GetBuildArchitecture()
+{
+#if defined(_M_ARM64)
+	return "ARM64";
+#elif defined(_M_X64)
+	return "x64";
+#else
+	return "x86";
+#endif
+}
+
+nlohmann::json ResultToJson(const BenchmarkResult &result)
+{
+	nlohmann::json json = { { "name", result.name }, { "items", result.numItems },
+		{ "iterations", result.numIterations },
+		{ "nanosecondsPerIteration", result.nanosecondsPerIteration },
+		{ "nanosecondsPerItem", result.nanosecondsPerItem },
+		{ "allocationsPerIteration", result.allocationsPerIteration },
+		{ "bytesAllocatedPerIteration", result.bytesAllocatedPerIteration } };
+
+	if (!result.countersPerIteration.empty())
+	{
+		json["countersPerIteration"] = result.countersPerIteration;
+	}
+
+	return json;
+}
+
+void PrintResult(const BenchmarkResult &result)
+{
+	std::cout << std::format("{:<40} {:>9} {:>15.0f} ns {:>10.1f} ns/item {:>12.1f} allocs",
+		result.name, result.numItems, result.nanosecondsPerIteration, result.nanosecondsPerItem,
+		result.allocationsPerIteration);
+
+	for (const auto &[name, value] : result.countersPerIteration)
+	{
+		std::cout << std::format(" {:>12.1f} {}", value, name);
+	}
+
+	std::cout << "\n";
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	CLI::App app("Explorer++ benchmarks");
+
+	Options options;
+	app.add_option("--filter", options.filter,
+		"Only run benchmarks whose name contains this string");
+	app.add_option("--max-items", options.maxItems,
+		"The largest number of items to run each benchmark with. Note that 1,000,000 items "
+		"requires over 1GB of memory.");
+	app.add_option("--min-time", options.minRunTimeMs,
+		"The minimum amount of time (in milliseconds) to run each benchmark for");
+	app.add_option("--output", options.outputPath, "Write the results as JSON to this file");
+	app.add_flag("--list", options.list, "List the available benchmarks");
+
+	CLI11_PARSE(app, argc, argv);
+
+	auto comInitializationResult = wil::CoInitializeEx(COINIT_APARTMENTTHREADED);
+
+	BenchmarkRegistry registry;
+	RegisterBookmarkBenchmarks(registry);
+	RegisterHelperBenchmarks(registry);
+	RegisterPluginBenchmarks(registry);
+	RegisterShellBrowserBenchmarks(registry);
+
+	if (options.list)
+	{
+		for (const auto &benchmark : registry.GetBenchmarks())
+		{
+			std::cout << benchmark.name << "\n";
+		}
+
+		return EXIT_SUCCESS;
+	}
+
+	std::chrono::milliseconds minRunTime(options.minRunTimeMs);
+	nlohmann::json results = nlohmann::json::array();
+
+	for (const auto &benchmark : registry.GetBenchmarks())
+	{
+		if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		for (size_t numItems : ITEM_COUNTS)
+		{
+			if (numItems > options.maxItems
+				|| (benchmark.maxItems && numItems > *benchmark.maxItems))
+			{
+				continue;
+			}
+
+			auto result = RunBenchmark(benchmark, numItems, minRunTime);
+			PrintResult(result);
+			results.push_back(ResultToJson(result));
+		}
+	}
+
+	if (!options.outputPath.empty())
+	{
+		nlohmann::json output = { { "configuration", GetBuildConfiguration() },
+			{ "architecture", GetBuildArchitecture() }, { "minRunTimeMs", options.minRunTimeMs },
+			{ "results", results } };
+
+		std::ofstream outputStream(options.outputPath);
+
+		if (!outputStream)
+		{
+			std::cerr << "Couldn't open " << options.outputPath << " for writing\n";
+			return EXIT_FAILURE;
+		}
+
+		outputStream << output.dump(4) << "\n";
+	}
+
+	return EXIT_SUCCESS;
+}
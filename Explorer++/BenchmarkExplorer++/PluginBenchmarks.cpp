@@ -0,0 +1,182 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+// The benchmarks here compare the two ways items can be handed to a Lua plugin: copying each item
+// into its own table (the approach taken by the tabs API, where each tab is copied into a value
+// object) and creating a view over each item (the approach taken by the items API).
+
+#include "pch.h"
+#include "PluginBenchmarks.h"
+#include "Benchmark.h"
+#include "SyntheticItems.h"
+#include "Plugins/ApiBinding.h"
+#include "Plugins/ItemsApi/ItemView.h"
+#include "ShellBrowser/ItemPredicates.h"
+#include "../Helper/StringHelper.h"
+#include <sol/sol.hpp>
+
+namespace
+{
+
+// Reads the name, size and modification time of every item.
+constexpr char ITERATE_SCRIPT[] = R"(
+function iterate(items)
+	local totalSize = 0
+	local totalNameLength = 0
+	local latest = 0
+
+	for _, item in ipairs(items) do
+		totalSize = totalSize + item.size
+		totalNameLength = totalNameLength + #item.name
+
+		if item.modified > latest then
+			latest = item.modified
+		end
+	end
+
+	return totalNameLength
+end
+
+function filterInLua(items)
+	local matches = {}
+
+	for _, item in ipairs(items) do
+		if string.find(item.name, "%.txt$") and item.size >= 4096 then
+			matches[#matches + 1] = item
+		end
+	end
+
+	return #matches
+end
+)";
+
+void SetUpLuaState(sol::state &lua)
+{
+	lua.open_libraries(sol::lib::base, sol::lib::string, sol::lib::table);
+
+	sol::table itemsTable = lua.create_named_table("items");
+	Plugins::BindItemViewType(itemsTable);
+
+	lua.script(ITERATE_SCRIPT);
+}
+
+std::vector<Plugins::ItemView> CreateViews(const std::vector<BasicItemInfo_t> &items)
+{
+	auto scope = std::make_shared<Plugins::ItemViewScope>(0, [] { return true; });
+
+	std::vector<Plugins::ItemView> views;
+	views.reserve(items.size());
+
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		views.emplace_back(scope, static_cast<int>(i), &items[i].wfd, items[i].isFindDataValid);
+	}
+
+	return views;
+}
+
+sol::table CreateItemTables(sol::state &lua, const std::vector<BasicItemInfo_t> &items)
+{
+	sol::table itemTables = lua.create_table(static_cast<int>(items.size()), 0);
+
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		const auto &wfd = items[i].wfd;
+		ULARGE_INTEGER size = { wfd.nFileSizeLow, wfd.nFileSizeHigh };
+
+		itemTables[i + 1] = lua.create_table_with("name", wstrToUtf8Str(wfd.cFileName), "size",
+			size.QuadPart, "attributes", wfd.dwFileAttributes, "modified",
+			Plugins::FileTimeToUnixTime(wfd.ftLastWriteTime));
+	}
+
+	return itemTables;
+}
+
+void ItemTablesIterationBenchmark(BenchmarkState &state)
+{
+	auto items = CreateSyntheticItems(state.GetNumItems());
+
+	sol::state lua;
+	SetUpLuaState(lua);
+	sol::protected_function iterate = lua["iterate"];
+
+	while (state.KeepRunning())
+	{
+		sol::table itemTables = CreateItemTables(lua, items);
+		int totalNameLength = iterate(itemTables);
+		CHECK_GT(totalNameLength, 0);
+	}
+}
+
+void ItemViewsIterationBenchmark(BenchmarkState &state)
+{
+	auto items = CreateSyntheticItems(state.GetNumItems());
+
+	sol::state lua;
+	SetUpLuaState(lua);
+	sol::protected_function iterate = lua["iterate"];
+
+	while (state.KeepRunning())
+	{
+		int totalNameLength = iterate(sol::as_table(CreateViews(items)));
+		CHECK_GT(totalNameLength, 0);
+	}
+}
+
+// Filters the items in Lua, by examining each view in turn.
+void ItemViewsLuaFilterBenchmark(BenchmarkState &state)
+{
+	auto items = CreateSyntheticItems(state.GetNumItems());
+
+	sol::state lua;
+	SetUpLuaState(lua);
+	sol::protected_function filterInLua = lua["filterInLua"];
+
+	while (state.KeepRunning())
+	{
+		int numMatches = filterInLua(sol::as_table(CreateViews(items)));
+		CHECK_LE(numMatches, static_cast<int>(items.size()));
+	}
+}
+
+// Filters the items natively (as items.filter() does) and only hands the matching views to Lua.
+void ItemViewsNativeFilterBenchmark(BenchmarkState &state)
+{
+	auto items = CreateSyntheticItems(state.GetNumItems());
+
+	sol::state lua;
+	SetUpLuaState(lua);
+
+	auto predicate = ItemPredicates::All({ ItemPredicates::MatchesWildcard(L"*.txt", false),
+		ItemPredicates::SizeInRange(4096, (std::numeric_limits<uint64_t>::max)()) });
+	auto scope = std::make_shared<Plugins::ItemViewScope>(0, [] { return true; });
+
+	while (state.KeepRunning())
+	{
+		std::vector<Plugins::ItemView> views;
+
+		for (size_t i = 0; i < items.size(); i++)
+		{
+			if (predicate(items[i].wfd, items[i].isFindDataValid))
+			{
+				views.emplace_back(scope, static_cast<int>(i), &items[i].wfd,
+					items[i].isFindDataValid);
+			}
+		}
+
+		sol::table matches = sol::make_object(lua, sol::as_table(std::move(views)));
+		CHECK_LE(matches.size(), items.size());
+	}
+}
+
+}
+
+void RegisterPluginBenchmarks(BenchmarkRegistry &registry)
+{
+	// Each item is represented by a Lua object, so the largest item count is skipped.
+	registry.Register("Plugins.ItemIteration.Tables", ItemTablesIterationBenchmark, 100'000);
+	registry.Register("Plugins.ItemIteration.Views", ItemViewsIterationBenchmark, 100'000);
+	registry.Register("Plugins.ItemFilter.Lua", ItemViewsLuaFilterBenchmark, 100'000);
+	registry.Register("Plugins.ItemFilter.Native", ItemViewsNativeFilterBenchmark, 100'000);
+}
@@ -0,0 +1,487 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+// The benchmarks here exercise the same functions that ShellBrowserImpl uses when sorting,
+// filtering and inserting items. ShellBrowserImpl itself stores its items in a listview, so the
+// listview is replaced by a vector of item indexes here.
+
+#include "pch.h"
+#include "ShellBrowserBenchmarks.h"
+#include "Benchmark.h"
+#include "SyntheticItems.h"
+#include "ShellBrowser/ColumnDataRetrieval.h"
+#include "ShellBrowser/FolderSettings.h"
+#include "ShellBrowser/ItemPredicates.h"
+#include "ShellBrowser/SortHelper.h"
+#include "ShellChangeWatcher.h"
+#include "ShellEnumerator.h"
+#include "../Helper/ShellHelper.h"
+#include "../Helper/StringHelper.h"
+#include "../Helper/TaskScheduler.h"
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <numeric>
+#include <random>
+
+namespace
+{
+
+using ItemComparator = std::function<int(const BasicItemInfo_t &, const BasicItemInfo_t &)>;
+
+std::vector<int> CreateShuffledIndexes(size_t numItems)
+{
+	std::vector<int> indexes(numItems);
+	std::iota(indexes.begin(), indexes.end(), 0);
+	std::shuffle(indexes.begin(), indexes.end(), std::mt19937(0));
+	return indexes;
+}
+
+// Equivalent to sorting the items in the listview (via ListView_SortItems).
+BenchmarkFunction MakeSortBenchmark(ItemComparator comparator)
+{
+	return [comparator](BenchmarkState &state)
+	{
+		auto items = CreateSyntheticItems(state.GetNumItems());
+		auto shuffledIndexes = CreateShuffledIndexes(items.size());
+		std::vector<int> indexes;
+
+		while (state.KeepRunning())
+		{
+			state.PauseTiming();
+			indexes = shuffledIndexes;
+			state.ResumeTiming();
+
+			std::sort(indexes.begin(), indexes.end(),
+				[&items, &comparator](int index1, int index2)
+				{ return comparator(items[index1], items[index2]) < 0; });
+		}
+	};
+}
+
+std::vector<int> CreateSortedIndexes(const std::vector<BasicItemInfo_t> &items, size_t numItems)
+{
+	GlobalFolderSettings globalFolderSettings;
+	std::vector<int> indexes(numItems);
+	std::iota(indexes.begin(), indexes.end(), 0);
+	std::sort(indexes.begin(), indexes.end(),
+		[&items, &globalFolderSettings](int index1, int index2)
+		{ return SortByName(items[index1], items[index2], globalFolderSettings) < 0; });
+	return indexes;
+}
+
+// Equivalent to inserting the items into the listview one at a time, with each item being placed
+// in its sorted position. The position is found using DetermineSortedPosition(), as it is in
+// ShellBrowserImpl::DetermineItemSortedPosition().
+void InsertSortedBenchmark(BenchmarkState &state)
+{
+	GlobalFolderSettings globalFolderSettings;
+	auto items = CreateSyntheticItems(state.GetNumItems());
+	std::vector<int> indexes;
+
+	while (state.KeepRunning())
+	{
+		state.PauseTiming();
+		indexes.clear();
+		indexes.reserve(items.size());
+		state.ResumeTiming();
+
+		for (int i = 0; i < static_cast<int>(items.size()); i++)
+		{
+			int position = DetermineSortedPosition(static_cast<int>(indexes.size()),
+				[&items, &indexes, &globalFolderSettings, i](int existingPosition)
+				{
+					return SortByName(items[i], items[indexes[existingPosition]],
+						globalFolderSettings);
+				});
+			indexes.insert(indexes.begin() + position, i);
+		}
+	}
+}
+
+// Equivalent to ShellBrowserImpl processing a batch of SHCNE_CREATE notifications (e.g. as a result
+// of a set of items being copied into the directory). For each notification, the item is checked
+// to be a child of the directory, the existing items are searched for the item (as is done in
+// ShellBrowserImpl::GetItemInternalIndexForPidl()) and the item is then inserted in its sorted
+// position.
+void ChangeNotificationsBenchmark(BenchmarkState &state)
+{
+	constexpr size_t NUM_NOTIFICATIONS = 100;
+
+	GlobalFolderSettings globalFolderSettings;
+	size_t numExistingItems = state.GetNumItems();
+	auto items = CreateSyntheticItems(numExistingItems + NUM_NOTIFICATIONS);
+
+	unique_pidl_absolute pidlDirectory(ILCloneFull(items[0].pidlComplete.get()));
+	ILRemoveLastID(pidlDirectory.get());
+
+	// The items past the existing items are the ones that are created.
+	std::vector<ShellChangeNotification> notifications;
+	notifications.reserve(NUM_NOTIFICATIONS);
+
+	for (size_t i = numExistingItems; i < items.size(); i++)
+	{
+		notifications.emplace_back(SHCNE_CREATE, items[i].pidlComplete.get(), nullptr);
+	}
+
+	auto existingIndexes = CreateSortedIndexes(items, numExistingItems);
+	std::vector<int> indexes;
+	uint64_t numProcessed = 0;
+
+	while (state.KeepRunning())
+	{
+		state.PauseTiming();
+		indexes = existingIndexes;
+		state.ResumeTiming();
+
+		for (size_t i = 0; i < notifications.size(); i++)
+		{
+			const auto &change = notifications[i];
+			int newIndex = static_cast<int>(numExistingItems + i);
+
+			if (!ILIsParent(pidlDirectory.get(), change.pidl1.get(), TRUE))
+			{
+				continue;
+			}
+
+			bool itemExists = std::any_of(indexes.begin(), indexes.end(),
+				[&items, &change](int index)
+				{
+					return ArePidlsEquivalent(change.pidl1.get(),
+						items[index].pidlComplete.get());
+				});
+
+			if (itemExists)
+			{
+				continue;
+			}
+
+			int position = DetermineSortedPosition(static_cast<int>(indexes.size()),
+				[&items, &indexes, &globalFolderSettings, newIndex](int existingPosition)
+				{
+					return SortByName(items[newIndex], items[indexes[existingPosition]],
+						globalFolderSettings);
+				});
+			indexes.insert(indexes.begin() + position, newIndex);
+		}
+
+		CHECK_EQ(indexes.size(), items.size());
+		numProcessed += notifications.size();
+	}
+
+	state.AddToCounter("notifications", numProcessed);
+}
+
+// Equivalent to ShellBrowserImpl::IsFilenameFiltered(), which is called for each item when a
+// filter is applied.
+void FilterBenchmark(BenchmarkState &state)
+{
+	GlobalFolderSettings globalFolderSettings;
+	auto items = CreateSyntheticItems(state.GetNumItems());
+	const std::wstring filter = L"*.txt:IMG_*.jpg:report-?*";
+
+	while (state.KeepRunning())
+	{
+		size_t numFiltered = 0;
+
+		for (const auto &item : items)
+		{
+			if (WI_IsFlagSet(item.wfd.dwFileAttributes, FILE_ATTRIBUTE_DIRECTORY))
+			{
+				continue;
+			}
+
+			if (!CheckWildcardMatch(filter.c_str(),
+					GetNameColumnText(item, globalFolderSettings).c_str(), false))
+			{
+				numFiltered++;
+			}
+		}
+
+		CHECK_LE(numFiltered, items.size());
+	}
+}
+
+// Equivalent to the predicate pass performed by ShellBrowserImpl::SelectItemsMatchingPredicate().
+void SelectMatchingBenchmark(BenchmarkState &state)
+{
+	auto items = CreateSyntheticItems(state.GetNumItems());
+	auto predicate = ItemPredicates::All({ ItemPredicates::MatchesWildcard(L"*.jpg:*.png", false),
+		ItemPredicates::SizeInRange(1024, 1024 * 1024) });
+
+	while (state.KeepRunning())
+	{
+		size_t numMatching = std::count_if(items.begin(), items.end(),
+			[&predicate](const BasicItemInfo_t &item)
+			{ return predicate(item.wfd, item.isFindDataValid); });
+
+		CHECK_LE(numMatching, items.size());
+	}
+}
+
+// Retrieves the text for a column for every item, as happens when the listview is populated in
+// details view.
+BenchmarkFunction MakeColumnTextBenchmark(
+	std::function<std::wstring(const BasicItemInfo_t &, const GlobalFolderSettings &)> getText)
+{
+	return [getText](BenchmarkState &state)
+	{
+		GlobalFolderSettings globalFolderSettings;
+		auto items = CreateSyntheticItems(state.GetNumItems());
+
+		while (state.KeepRunning())
+		{
+			size_t totalLength = 0;
+
+			for (const auto &item : items)
+			{
+				totalLength += getText(item, globalFolderSettings).size();
+			}
+
+			CHECK_GT(totalLength, 0u);
+		}
+	};
+}
+
+// A set of metadata columns covering each of the sources metadata is read from (document
+// properties, image properties and media attributes).
+const std::vector<ColumnType> METADATA_COLUMNS = { ColumnType::Title, ColumnType::Subject,
+	ColumnType::Authors, ColumnType::Comment, ColumnType::CameraModel, ColumnType::DateTaken,
+	ColumnType::Width, ColumnType::Height, ColumnType::MediaDuration, ColumnType::MediaBitrate };
+
+// Metadata columns need to read the contents of each item, so the items here, unlike the synthetic
+// items used elsewhere, exist on disk. Half of the items are small bitmaps (so that the image
+// properties can be read) and half are text files.
+class MetadataTestFiles
+{
+public:
+	MetadataTestFiles(size_t numItems) :
+		m_directory(std::filesystem::temp_directory_path() / L"ExplorerPlusPlusBenchmark")
+	{
+		std::filesystem::remove_all(m_directory);
+		std::filesystem::create_directories(m_directory);
+
+		for (size_t i = 0; i < numItems; i++)
+		{
+			bool isImage = (i % 2) == 0;
+			auto path = m_directory / std::format(L"item{}.{}", i, isImage ? L"bmp" : L"txt");
+
+			if (isImage)
+			{
+				WriteBitmap(path);
+			}
+			else
+			{
+				std::ofstream(path) << "Text file " << i << "\n";
+			}
+
+			BasicItemInfo_t item;
+			HRESULT hr = SHParseDisplayName(path.c_str(), nullptr,
+				wil::out_param(item.pidlComplete), 0, nullptr);
+			CHECK(SUCCEEDED(hr));
+			item.pridl.reset(ILCloneChild(ILFindLastID(item.pidlComplete.get())));
+
+			item.wfd = {};
+			StringCchCopy(item.wfd.cFileName, std::size(item.wfd.cFileName),
+				path.filename().c_str());
+			item.isFindDataValid = true;
+
+			m_items.push_back(std::move(item));
+		}
+	}
+
+	~MetadataTestFiles()
+	{
+		std::error_code error;
+		std::filesystem::remove_all(m_directory, error);
+	}
+
+	const std::vector<BasicItemInfo_t> &GetItems() const
+	{
+		return m_items;
+	}
+
+private:
+	static constexpr LONG BITMAP_SIZE = 16;
+
+	static void WriteBitmap(const std::filesystem::path &path)
+	{
+		// 24-bit rows are padded to a multiple of 4 bytes, which 16 pixels already is.
+		constexpr DWORD pixelDataSize = BITMAP_SIZE * BITMAP_SIZE * 3;
+
+		BITMAPINFOHEADER infoHeader = {};
+		infoHeader.biSize = sizeof(infoHeader);
+		infoHeader.biWidth = BITMAP_SIZE;
+		infoHeader.biHeight = BITMAP_SIZE;
+		infoHeader.biPlanes = 1;
+		infoHeader.biBitCount = 24;
+		infoHeader.biCompression = BI_RGB;
+
+		BITMAPFILEHEADER fileHeader = {};
+		// "BM", stored little-endian.
+		fileHeader.bfType = 0x4D42;
+		fileHeader.bfOffBits = sizeof(fileHeader) + sizeof(infoHeader);
+		fileHeader.bfSize = fileHeader.bfOffBits + pixelDataSize;
+
+		std::vector<char> pixelData(pixelDataSize, '\x80');
+
+		std::ofstream stream(path, std::ios::binary);
+		stream.write(reinterpret_cast<const char *>(&fileHeader), sizeof(fileHeader));
+		stream.write(reinterpret_cast<const char *>(&infoHeader), sizeof(infoHeader));
+		stream.write(pixelData.data(), pixelData.size());
+	}
+
+	const std::filesystem::path m_directory;
+	std::vector<BasicItemInfo_t> m_items;
+};
+
+// Retrieves each metadata column separately, which opens the item once per column.
+void MetadataColumnsPerColumnBenchmark(BenchmarkState &state)
+{
+	GlobalFolderSettings globalFolderSettings;
+	MetadataTestFiles testFiles(state.GetNumItems());
+
+	while (state.KeepRunning())
+	{
+		size_t totalLength = 0;
+
+		for (const auto &item : testFiles.GetItems())
+		{
+			for (auto columnType : METADATA_COLUMNS)
+			{
+				totalLength += GetColumnText(columnType, item, globalFolderSettings).size();
+			}
+		}
+
+		CHECK_GT(totalLength, 0u);
+	}
+}
+
+// Retrieves all the metadata columns for an item at once, which is what ShellBrowserImpl does.
+void MetadataColumnsBatchedBenchmark(BenchmarkState &state)
+{
+	GlobalFolderSettings globalFolderSettings;
+	MetadataTestFiles testFiles(state.GetNumItems());
+	CancellationToken cancellationToken;
+
+	while (state.KeepRunning())
+	{
+		size_t totalLength = 0;
+
+		for (const auto &item : testFiles.GetItems())
+		{
+			auto texts = GetMetadataColumnTexts(METADATA_COLUMNS, item, globalFolderSettings,
+				cancellationToken);
+
+			for (const auto &text : texts)
+			{
+				totalLength += text.size();
+			}
+		}
+
+		CHECK_GT(totalLength, 0u);
+	}
+}
+
+// Enumerates a directory on disk using ShellEnumerator, which is the first step when navigating to
+// a directory. The files created are empty, since their contents aren't read during enumeration.
+void EnumerateDirectoryBenchmark(BenchmarkState &state)
+{
+	auto directory =
+		std::filesystem::temp_directory_path() / L"ExplorerPlusPlusEnumerationBenchmark";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+
+	auto cleanup = wil::scope_exit(
+		[&directory]
+		{
+			std::error_code error;
+			std::filesystem::remove_all(directory, error);
+		});
+
+	for (size_t i = 0; i < state.GetNumItems(); i++)
+	{
+		std::ofstream(directory / std::format(L"item{}.txt", i));
+	}
+
+	unique_pidl_absolute pidlDirectory;
+	HRESULT hr = SHParseDisplayName(directory.c_str(), nullptr, wil::out_param(pidlDirectory), 0,
+		nullptr);
+	CHECK(SUCCEEDED(hr));
+
+	wil::com_ptr_nothrow<IShellFolder> shellFolder;
+	hr = BindToIdl(pidlDirectory.get(), IID_PPV_ARGS(&shellFolder));
+	CHECK(SUCCEEDED(hr));
+
+	ShellEnumerator enumerator;
+	std::vector<unique_pidl_child> items;
+
+	while (state.KeepRunning())
+	{
+		state.PauseTiming();
+		items.clear();
+		state.ResumeTiming();
+
+		hr = enumerator.EnumerateDirectory(shellFolder.get(), nullptr,
+			ShellEnumerator::Flags::Standard, items);
+		CHECK(SUCCEEDED(hr));
+		CHECK_EQ(items.size(), state.GetNumItems());
+	}
+}
+
+}
+
+void RegisterShellBrowserBenchmarks(BenchmarkRegistry &registry)
+{
+	GlobalFolderSettings globalFolderSettings;
+
+	registry.Register("ShellBrowser.SortByName",
+		MakeSortBenchmark(
+			[globalFolderSettings](const BasicItemInfo_t &item1, const BasicItemInfo_t &item2)
+			{ return SortByName(item1, item2, globalFolderSettings); }));
+	registry.Register("ShellBrowser.SortBySize", MakeSortBenchmark(SortBySize));
+	registry.Register("ShellBrowser.SortByDateModified",
+		MakeSortBenchmark([](const BasicItemInfo_t &item1, const BasicItemInfo_t &item2)
+			{ return SortByDate(item1, item2, DateType::Modified); }));
+	registry.Register("ShellBrowser.SortByExtension", MakeSortBenchmark(SortByExtension));
+	registry.Register("ShellBrowser.SortByAttributes", MakeSortBenchmark(SortByAttributes));
+
+	// The linear search for each item means this benchmark is quadratic in the number of items.
+	registry.Register("ShellBrowser.InsertSorted", InsertSortedBenchmark, 10'000);
+
+	// Each notification results in every existing item being compared against the new item, using
+	// a comparison that goes through the shell, so this benchmark is limited to a smaller number of
+	// items.
+	registry.Register("ShellBrowser.ChangeNotifications", ChangeNotificationsBenchmark, 10'000);
+
+	registry.Register("ShellBrowser.Filter", FilterBenchmark);
+	registry.Register("ShellBrowser.SelectMatching", SelectMatchingBenchmark);
+
+	registry.Register("ShellBrowser.ColumnText.Name", MakeColumnTextBenchmark(GetNameColumnText));
+	registry.Register("ShellBrowser.ColumnText.Size", MakeColumnTextBenchmark(GetSizeColumnText));
+	registry.Register("ShellBrowser.ColumnText.DateModified",
+		MakeColumnTextBenchmark(
+			[](const BasicItemInfo_t &item, const GlobalFolderSettings &globalFolderSettings)
+			{ return GetTimeColumnText(item, TimeType::Modified, globalFolderSettings); }));
+	registry.Register("ShellBrowser.ColumnText.Attributes",
+		MakeColumnTextBenchmark(
+			[](const BasicItemInfo_t &item, const GlobalFolderSettings &globalFolderSettings)
+			{
+				UNREFERENCED_PARAMETER(globalFolderSettings);
+
+				return GetAttributeColumnText(item);
+			}));
+
+	// Creating the items on disk is slow, so this benchmark isn't run with more than 100,000
+	// items.
+	registry.Register("ShellBrowser.EnumerateDirectory", EnumerateDirectoryBenchmark, 100'000);
+
+	// These benchmarks read real files from disk, so they're limited to a smaller number of
+	// items.
+	registry.Register("ShellBrowser.MetadataColumns.PerColumn", MetadataColumnsPerColumnBenchmark,
+		1'000);
+	registry.Register("ShellBrowser.MetadataColumns.Batched", MetadataColumnsBatchedBenchmark,
+		1'000);
+}
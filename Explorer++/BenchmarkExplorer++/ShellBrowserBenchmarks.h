@@ -0,0 +1,9 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+class BenchmarkRegistry;
+
+void RegisterShellBrowserBenchmarks(BenchmarkRegistry &registry);
@@ -0,0 +1,121 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "SyntheticItems.h"
+#include <ShlObj.h>
+#include <cmath>
+#include <format>
+#include <random>
+
+namespace
+{
+
+// The folder the synthetic items are placed in. The folder doesn't need to exist.
+constexpr wchar_t SYNTHETIC_FOLDER_PATH[] = L"C:\\Synthetic";
+
+constexpr const wchar_t *NAME_PREFIXES[] = { L"Document", L"IMG_", L"report-", L"Backup",
+	L"notes", L"Screenshot ", L"track", L"setup", L"Invoice #", L"data_" };
+
+constexpr const wchar_t *EXTENSIONS[] = { L"txt", L"jpg", L"png", L"docx", L"pdf", L"mp3", L"exe",
+	L"zip", L"cpp", L"h", L"lnk", L"" };
+
+// Roughly 1 in every FOLDER_FREQUENCY items will be a folder.
+constexpr int FOLDER_FREQUENCY = 10;
+
+// The dates generated will be spread over this period.
+constexpr auto DATE_RANGE = std::chrono::years(5);
+
+FILETIME ToFileTime(std::chrono::file_clock::time_point timePoint)
+{
+	ULARGE_INTEGER value;
+	value.QuadPart = timePoint.time_since_epoch().count();
+	return { value.LowPart, value.HighPart };
+}
+
+}
+
+std::vector<BasicItemInfo_t> CreateSyntheticItems(size_t numItems, unsigned int seed)
+{
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<size_t> prefixDistribution(0, std::size(NAME_PREFIXES) - 1);
+	std::uniform_int_distribution<size_t> extensionDistribution(0, std::size(EXTENSIONS) - 1);
+	std::uniform_int_distribution<int> folderDistribution(0, FOLDER_FREQUENCY - 1);
+	std::uniform_int_distribution<int> attributeDistribution(0, 99);
+
+	// File sizes are spread logarithmically, so that there's a realistic mix of small and large
+	// files.
+	std::uniform_real_distribution<double> sizeExponentDistribution(0, 33);
+
+	auto now = std::chrono::file_clock::now();
+	std::uniform_int_distribution<int64_t> ageDistribution(0,
+		std::chrono::duration_cast<std::chrono::file_clock::duration>(DATE_RANGE).count());
+
+	std::vector<BasicItemInfo_t> items;
+	items.reserve(numItems);
+
+	for (size_t i = 0; i < numItems; i++)
+	{
+		bool isFolder = folderDistribution(generator) == 0;
+		std::wstring name = std::format(L"{}{}", NAME_PREFIXES[prefixDistribution(generator)], i);
+
+		if (!isFolder)
+		{
+			const wchar_t *extension = EXTENSIONS[extensionDistribution(generator)];
+
+			if (*extension != '\0')
+			{
+				name += std::format(L".{}", extension);
+			}
+		}
+
+		BasicItemInfo_t item;
+		item.pidlComplete.reset(
+			SHSimpleIDListFromPath(std::format(L"{}\\{}", SYNTHETIC_FOLDER_PATH, name).c_str()));
+		CHECK(item.pidlComplete);
+		item.pridl.reset(ILCloneChild(ILFindLastID(item.pidlComplete.get())));
+
+		item.wfd = {};
+		StringCchCopy(item.wfd.cFileName, std::size(item.wfd.cFileName), name.c_str());
+
+		if (isFolder)
+		{
+			item.wfd.dwFileAttributes = FILE_ATTRIBUTE_DIRECTORY;
+		}
+		else
+		{
+			ULARGE_INTEGER size;
+			size.QuadPart =
+				static_cast<ULONGLONG>(std::exp2(sizeExponentDistribution(generator)));
+			item.wfd.nFileSizeLow = size.LowPart;
+			item.wfd.nFileSizeHigh = size.HighPart;
+			item.wfd.dwFileAttributes = FILE_ATTRIBUTE_ARCHIVE;
+		}
+
+		int attributeChance = attributeDistribution(generator);
+
+		if (attributeChance < 5)
+		{
+			WI_SetFlag(item.wfd.dwFileAttributes, FILE_ATTRIBUTE_HIDDEN);
+		}
+		else if (attributeChance < 7)
+		{
+			WI_SetFlag(item.wfd.dwFileAttributes, FILE_ATTRIBUTE_SYSTEM);
+		}
+
+		auto modified = now - std::chrono::file_clock::duration(ageDistribution(generator));
+		auto created = modified - std::chrono::file_clock::duration(ageDistribution(generator));
+		item.wfd.ftCreationTime = ToFileTime(created);
+		item.wfd.ftLastWriteTime = ToFileTime(modified);
+		item.wfd.ftLastAccessTime = ToFileTime(now);
+
+		item.isFindDataValid = true;
+		StringCchCopy(item.szDisplayName, std::size(item.szDisplayName), name.c_str());
+		item.isRoot = false;
+
+		items.push_back(std::move(item));
+	}
+
+	return items;
+}
@@ -0,0 +1,17 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "ShellBrowser/ItemData.h"
+#include <vector>
+
+// Generates a set of items that resembles the contents of a large folder (a mix of files and
+// folders, with a range of names, extensions, sizes, dates and attributes). The items don't exist
+// on disk, which means that only properties derived from the item's find data can be used (for
+// example, sorting by size is fine, but sorting by owner isn't).
+//
+// The same seed will always result in the same set of items, so that results can be compared
+// between runs.
+std::vector<BasicItemInfo_t> CreateSyntheticItems(size_t numItems, unsigned int seed = 0);
@@ -4,9 +4,14 @@
 
 #include "stdafx.h"
 #include "AddressBar.h"
+#include "AddressBarCompleter.h"
+#include "Bookmarks/BookmarkTreeFactory.h"
 #include "BrowserWindow.h"
 #include "CoreInterface.h"
+#include "FrequentLocationsServiceFactory.h"
+#include "HistoryServiceFactory.h"
 #include "NavigationHelper.h"
+#include "ShellBrowser/DirectoryEnumerationCacheFactory.h"
 #include "ShellBrowser/ShellBrowserImpl.h"
 #include "ShellBrowser/ShellNavigationController.h"
 #include "Tab.h"
@@ -40,6 +45,8 @@ AddressBar::AddressBar(HWND parent, BrowserWindow *browserWindow, CoreInterface
 	Initialize(parent);
 }
 
+AddressBar::~AddressBar() = default;
+
 HWND AddressBar::CreateAddressBar(HWND parent)
 {
 	return CreateComboBox(parent,
@@ -62,9 +69,7 @@ void AddressBar::Initialize(HWND parent)
 	m_windowSubclasses.push_back(std::make_unique<WindowSubclassWrapper>(hEdit,
 		std::bind_front(&AddressBar::EditSubclass, this)));
 
-	/* Turn on auto complete for the edit control within the combobox.
-	This will let the os complete paths as they are typed. */
-	SHAutoComplete(hEdit, SHACF_FILESYSTEM | SHACF_AUTOSUGGEST_FORCE_ON);
+	InitializeAutoComplete(hEdit);
 
 	m_windowSubclasses.push_back(std::make_unique<WindowSubclassWrapper>(parent,
 		std::bind_front(&AddressBar::ParentWndProc, this)));
@@ -83,6 +88,44 @@ void AddressBar::Initialize(HWND parent)
 	m_fontSetter.fontUpdatedSignal.AddObserver(std::bind(&AddressBar::OnFontOrDpiUpdated, this));
 }
 
+void AddressBar::InitializeAutoComplete(HWND edit)
+{
+	m_completer = std::make_unique<AddressBarCompleter>(
+		HistoryServiceFactory::GetInstance()->GetHistoryService(),
+		FrequentLocationsServiceFactory::GetInstance()->GetFrequentLocationsService(),
+		BookmarkTreeFactory::GetInstance()->GetBookmarkTree(),
+		BookmarkTreeFactory::GetInstance()->GetBookmarkSearchIndex(),
+		DirectoryEnumerationCacheFactory::GetInstance()->GetDirectoryEnumerationCache());
+
+	// The suggestions are generated by the completer each time the text changes and then handed
+	// to the autocomplete object through this list. The autocomplete object is only responsible
+	// for displaying the suggestions.
+	m_autoCompleteList = winrt::make_self<AutoCompleteListImpl>();
+
+	wil::com_ptr_nothrow<IAutoComplete2> autoComplete;
+	HRESULT hr = CoCreateInstance(CLSID_AutoComplete, nullptr, CLSCTX_INPROC_SERVER,
+		IID_PPV_ARGS(&autoComplete));
+
+	if (FAILED(hr))
+	{
+		return;
+	}
+
+	hr = autoComplete->Init(edit, static_cast<IEnumString *>(m_autoCompleteList.get()), nullptr,
+		nullptr);
+
+	if (FAILED(hr))
+	{
+		return;
+	}
+
+	// Bookmark suggestions are matched on the words in the bookmark name, so won't necessarily
+	// start with the text that's been entered. Prefix filtering would hide those suggestions.
+	autoComplete->SetOptions(ACO_AUTOSUGGEST | ACO_UPDOWNKEYDROPSLIST | ACO_NOPREFIXFILTERING);
+
+	m_autoCompleteDropDown = autoComplete.try_query<IAutoCompleteDropDown>();
+}
+
 LRESULT AddressBar::ComboBoxSubclass(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
 	switch (msg)
@@ -114,6 +157,10 @@ LRESULT AddressBar::EditSubclass(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lPar
 
 	case WM_SETFOCUS:
 		m_coreInterface->FocusChanged();
+
+		// Any outstanding changes to the suggestion sources are processed now, rather than in
+		// response to the first keystroke.
+		m_completer->UpdateIndexIfRequired();
 		break;
 	}
 
@@ -124,6 +171,15 @@ LRESULT AddressBar::ParentWndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lP
 {
 	switch (uMsg)
 	{
+	case WM_COMMAND:
+		// This notification is only sent when the user changes the text, not when the text is set
+		// programmatically.
+		if (reinterpret_cast<HWND>(lParam) == m_hwnd && HIWORD(wParam) == CBN_EDITCHANGE)
+		{
+			OnTextEdited();
+		}
+		break;
+
 	case WM_NOTIFY:
 		if (reinterpret_cast<LPNMHDR>(lParam)->hwndFrom == m_hwnd)
 		{
@@ -140,6 +196,16 @@ LRESULT AddressBar::ParentWndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lP
 	return DefSubclassProc(hwnd, uMsg, wParam, lParam);
 }
 
+void AddressBar::OnTextEdited()
+{
+	m_autoCompleteList->SetStrings(m_completer->GetSuggestions(GetWindowString(m_hwnd)));
+
+	if (m_autoCompleteDropDown)
+	{
+		m_autoCompleteDropDown->ResetEnumerator();
+	}
+}
+
 void AddressBar::OnEnterPressed()
 {
 	std::wstring path = GetWindowString(m_hwnd);
@@ -7,11 +7,14 @@
 #include "MainFontSetter.h"
 #include "ShellBrowser/HistoryEntry.h"
 #include "SignalWrapper.h"
+#include "../Helper/AutoCompleteListImpl.h"
 #include "../Helper/BaseWindow.h"
 #include "../Helper/WindowSubclassWrapper.h"
+#include <wil/com.h>
 #include <wil/resource.h>
 #include <optional>
 
+class AddressBarCompleter;
 class BrowserWindow;
 class CoreInterface;
 struct NavigateParams;
@@ -28,7 +31,7 @@ public:
 
 private:
 	AddressBar(HWND parent, BrowserWindow *browserWindow, CoreInterface *coreInterface);
-	~AddressBar() = default;
+	~AddressBar();
 
 	static HWND CreateAddressBar(HWND parent);
 
@@ -37,6 +40,8 @@ private:
 	LRESULT ParentWndProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 
 	void Initialize(HWND parent);
+	void InitializeAutoComplete(HWND edit);
+	void OnTextEdited();
 	void OnEnterPressed();
 	void OnEscapePressed();
 	void OnBeginDrag();
@@ -58,6 +63,10 @@ private:
 
 	std::wstring m_currentText;
 
+	std::unique_ptr<AddressBarCompleter> m_completer;
+	winrt::com_ptr<AutoCompleteListImpl> m_autoCompleteList;
+	wil::com_ptr_nothrow<IAutoCompleteDropDown> m_autoCompleteDropDown;
+
 	std::vector<std::unique_ptr<WindowSubclassWrapper>> m_windowSubclasses;
 	std::vector<boost::signals2::scoped_connection> m_connections;
 };
@@ -0,0 +1,231 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "AddressBarCompleter.h"
+#include "Bookmarks/BookmarkItem.h"
+#include "Bookmarks/BookmarkSearchIndex.h"
+#include "Bookmarks/BookmarkTree.h"
+#include "FrequentLocationsService.h"
+#include "HistoryService.h"
+#include "ShellBrowser/DirectoryEnumerationCache.h"
+#include "../Helper/PerformanceTracer.h"
+#include "../Helper/ShellHelper.h"
+#include <algorithm>
+
+namespace
+{
+
+void AddSuggestionIfUnique(std::wstring suggestion, std::vector<std::wstring> &suggestions)
+{
+	bool alreadySuggested = std::ranges::any_of(suggestions,
+		[&suggestion](const std::wstring &existingSuggestion)
+		{
+			return CompareStringOrdinal(existingSuggestion.c_str(),
+					   static_cast<int>(existingSuggestion.size()), suggestion.c_str(),
+					   static_cast<int>(suggestion.size()), TRUE)
+				== CSTR_EQUAL;
+		});
+
+	if (!alreadySuggested)
+	{
+		suggestions.push_back(std::move(suggestion));
+	}
+}
+
+}
+
+AddressBarCompleter::AddressBarCompleter(HistoryService *historyService,
+	FrequentLocationsService *frequentLocationsService, BookmarkTree *bookmarkTree,
+	BookmarkSearchIndex *bookmarkSearchIndex, DirectoryEnumerationCache *enumerationCache) :
+	m_historyService(historyService),
+	m_frequentLocationsService(frequentLocationsService),
+	m_bookmarkTree(bookmarkTree),
+	m_bookmarkSearchIndex(bookmarkSearchIndex),
+	m_enumerationCache(enumerationCache)
+{
+	m_connections.push_back(m_historyService->AddHistoryChangedObserver(
+		std::bind(&AddressBarCompleter::OnIndexSourceChanged, this)));
+	m_connections.push_back(m_frequentLocationsService->AddLocationsChangedObserver(
+		std::bind(&AddressBarCompleter::OnIndexSourceChanged, this)));
+	m_connections.push_back(m_bookmarkTree->bookmarkItemAddedSignal.AddObserver(
+		std::bind(&AddressBarCompleter::OnIndexSourceChanged, this)));
+	m_connections.push_back(m_bookmarkTree->bookmarkItemUpdatedSignal.AddObserver(
+		std::bind(&AddressBarCompleter::OnIndexSourceChanged, this)));
+	m_connections.push_back(m_bookmarkTree->bookmarkItemRemovedSignal.AddObserver(
+		std::bind(&AddressBarCompleter::OnIndexSourceChanged, this)));
+}
+
+void AddressBarCompleter::OnIndexSourceChanged()
+{
+	m_indexOutdated = true;
+}
+
+void AddressBarCompleter::UpdateIndexIfRequired()
+{
+	if (!m_indexOutdated)
+	{
+		return;
+	}
+
+	ScopedTraceSpan span("AddressBar", "BuildCompletionIndex");
+
+	// The index is recreated (rather than cleared), so that the time its rankings are calculated
+	// relative to is updated.
+	m_index = std::make_unique<LocationCompletionIndex>();
+
+	// History items are returned with the most recent items first, so items that are otherwise
+	// ranked equally will be suggested in order of recency.
+	for (const auto &path : m_historyService->GetHistoryItemPaths())
+	{
+		m_index->AddLocation(path, LocationCompletionIndex::Source::History);
+	}
+
+	for (const auto &visit : m_frequentLocationsService->GetVisits())
+	{
+		std::wstring path;
+		HRESULT hr = GetDisplayName(visit.GetLocation().Raw(), SHGDN_FORPARSING, path);
+
+		if (FAILED(hr))
+		{
+			continue;
+		}
+
+		m_index->AddLocation(path, LocationCompletionIndex::Source::FrequentLocations,
+			visit.GetScore());
+	}
+
+	AddBookmarksToIndex(m_bookmarkTree->GetRoot());
+
+	m_indexOutdated = false;
+}
+
+void AddressBarCompleter::AddBookmarksToIndex(BookmarkItem *bookmarkItem)
+{
+	bookmarkItem->VisitRecursively(
+		[this](BookmarkItem *currentItem)
+		{
+			if (currentItem->IsBookmark())
+			{
+				m_index->AddLocation(currentItem->GetLocation(),
+					LocationCompletionIndex::Source::Bookmarks);
+			}
+		});
+}
+
+std::vector<std::wstring> AddressBarCompleter::GetSuggestions(const std::wstring &text)
+{
+	ScopedTraceSpan span("AddressBar", "GetSuggestions");
+
+	UpdateIndexIfRequired();
+
+	auto suggestions = m_index->Query(text, MAX_SUGGESTIONS);
+
+	if (suggestions.size() < MAX_SUGGESTIONS)
+	{
+		AddBookmarkSearchSuggestions(text, suggestions);
+	}
+
+	if (suggestions.size() < MAX_SUGGESTIONS)
+	{
+		AddDirectoryChildSuggestions(text, suggestions);
+	}
+
+	return suggestions;
+}
+
+void AddressBarCompleter::AddBookmarkSearchSuggestions(const std::wstring &text,
+	std::vector<std::wstring> &suggestions)
+{
+	// Once a path separator has been entered, the text is treated as a path, rather than as a set
+	// of words to search for.
+	if (text.find(L'\\') != std::wstring::npos)
+	{
+		return;
+	}
+
+	auto bookmarkItems =
+		m_bookmarkSearchIndex->Search(text, MAX_SUGGESTIONS - suggestions.size());
+
+	for (const auto *bookmarkItem : bookmarkItems)
+	{
+		if (!bookmarkItem->IsBookmark())
+		{
+			continue;
+		}
+
+		AddSuggestionIfUnique(bookmarkItem->GetLocation(), suggestions);
+	}
+}
+
+void AddressBarCompleter::AddDirectoryChildSuggestions(const std::wstring &text,
+	std::vector<std::wstring> &suggestions)
+{
+	auto separatorPosition = text.find_last_of(L'\\');
+
+	if (separatorPosition == std::wstring::npos)
+	{
+		return;
+	}
+
+	std::wstring parentText = text.substr(0, separatorPosition + 1);
+
+	// The parsing path of a drive root includes a trailing backslash, while the parsing path of
+	// most other directories doesn't.
+	auto snapshot = m_enumerationCache->MaybeGetSnapshotForPath(parentText);
+
+	if (!snapshot && separatorPosition > 0)
+	{
+		snapshot = m_enumerationCache->MaybeGetSnapshotForPath(
+			text.substr(0, separatorPosition));
+	}
+
+	if (!snapshot)
+	{
+		return;
+	}
+
+	const auto &children = GetDirectoryChildren(snapshot);
+	auto lookupPrefix = LocationCompletionIndex::GetLookupPath(
+		std::wstring_view(text).substr(separatorPosition + 1));
+
+	for (auto itr = std::ranges::lower_bound(children, lookupPrefix, {},
+			 &DirectoryChild::lookupName);
+		 itr != children.end() && itr->lookupName.starts_with(lookupPrefix)
+		 && suggestions.size() < MAX_SUGGESTIONS;
+		 ++itr)
+	{
+		AddSuggestionIfUnique(parentText + itr->name, suggestions);
+	}
+}
+
+const std::vector<AddressBarCompleter::DirectoryChild> &AddressBarCompleter::GetDirectoryChildren(
+	const std::shared_ptr<const DirectorySnapshot> &snapshot)
+{
+	if (m_childrenSnapshot.lock() == snapshot)
+	{
+		return m_directoryChildren;
+	}
+
+	m_directoryChildren.clear();
+	m_directoryChildren.reserve(snapshot->items.size());
+
+	for (const auto &item : snapshot->items)
+	{
+		std::wstring name = PathFindFileName(item.parsingName.c_str());
+
+		if (name.empty())
+		{
+			continue;
+		}
+
+		m_directoryChildren.push_back({ LocationCompletionIndex::GetLookupPath(name), name });
+	}
+
+	std::ranges::sort(m_directoryChildren, {}, &DirectoryChild::lookupName);
+
+	m_childrenSnapshot = snapshot;
+
+	return m_directoryChildren;
+}
@@ -0,0 +1,89 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "LocationCompletionIndex.h"
+#include <boost/core/noncopyable.hpp>
+#include <boost/signals2.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+class BookmarkItem;
+class BookmarkSearchIndex;
+class BookmarkTree;
+class DirectoryEnumerationCache;
+struct DirectorySnapshot;
+class FrequentLocationsService;
+class HistoryService;
+
+// Provides the suggestions that are shown as the user types into the address bar. There are three
+// types of suggestions:
+//
+// - Previously visited and bookmarked locations that start with the text entered. These are
+//   retrieved from a LocationCompletionIndex, which is rebuilt whenever one of the underlying
+//   sources changes. Since the sources typically change as a result of a navigation, rather than
+//   while the user is typing, the rebuild is deferred until the index is next needed.
+// - The locations of bookmarks whose name or location contains words that start with the words
+//   entered. These are retrieved from the BookmarkSearchIndex and are only provided if the text
+//   doesn't contain a path separator (i.e. the user isn't typing a path).
+// - Items within the directory that's been entered so far. These are only provided if the
+//   directory is in the enumeration cache (i.e. because it's currently being shown in a tab), so
+//   generating suggestions never requires accessing the disk.
+class AddressBarCompleter : private boost::noncopyable
+{
+public:
+	static constexpr size_t MAX_SUGGESTIONS = 50;
+
+	AddressBarCompleter(HistoryService *historyService,
+		FrequentLocationsService *frequentLocationsService, BookmarkTree *bookmarkTree,
+		BookmarkSearchIndex *bookmarkSearchIndex, DirectoryEnumerationCache *enumerationCache);
+
+	// Rebuilds the index if any of its sources have changed. This is called automatically when
+	// retrieving suggestions, but can be called ahead of time (e.g. when the address bar gains
+	// focus), so that the work isn't done in response to a keystroke.
+	void UpdateIndexIfRequired();
+
+	// Returns up to MAX_SUGGESTIONS suggestions for the specified text. Indexed locations come
+	// first, in ranked order, followed by any matching bookmarks and then any matching items in the
+	// directory that's been entered.
+	std::vector<std::wstring> GetSuggestions(const std::wstring &text);
+
+private:
+	struct DirectoryChild
+	{
+		// The item name, in lowercase.
+		std::wstring lookupName;
+
+		std::wstring name;
+	};
+
+	void OnIndexSourceChanged();
+	void AddBookmarksToIndex(BookmarkItem *bookmarkItem);
+
+	void AddBookmarkSearchSuggestions(const std::wstring &text,
+		std::vector<std::wstring> &suggestions);
+	void AddDirectoryChildSuggestions(const std::wstring &text,
+		std::vector<std::wstring> &suggestions);
+	const std::vector<DirectoryChild> &GetDirectoryChildren(
+		const std::shared_ptr<const DirectorySnapshot> &snapshot);
+
+	HistoryService *const m_historyService;
+	FrequentLocationsService *const m_frequentLocationsService;
+	BookmarkTree *const m_bookmarkTree;
+	BookmarkSearchIndex *const m_bookmarkSearchIndex;
+	DirectoryEnumerationCache *const m_enumerationCache;
+
+	std::unique_ptr<LocationCompletionIndex> m_index;
+	bool m_indexOutdated = true;
+
+	// The children of the directory most recently used for suggestions, sorted by lookup name. A
+	// directory can contain a large number of items, so this is retained while the user continues
+	// typing within the same directory.
+	std::weak_ptr<const DirectorySnapshot> m_childrenSnapshot;
+	std::vector<DirectoryChild> m_directoryChildren;
+
+	std::vector<boost::signals2::scoped_connection> m_connections;
+};
@@ -112,6 +112,14 @@ std::vector<AdvancedOptionsPage::AdvancedOption> AdvancedOptionsPage::Initialize
 	option.description = {};
 	advancedOptions.push_back(option);
 
+	option.id = AdvancedOptionId::HibernateInactiveTabs;
+	option.name = ResourceHelper::LoadString(m_resourceInstance,
+		IDS_ADVANCED_OPTION_HIBERNATE_INACTIVE_TABS_NAME);
+	option.type = AdvancedOptionType::Boolean;
+	option.description = ResourceHelper::LoadString(m_resourceInstance,
+		IDS_ADVANCED_OPTION_HIBERNATE_INACTIVE_TABS_DESCRIPTION);
+	advancedOptions.push_back(option);
+
 	return advancedOptions;
 }
 
@@ -163,6 +171,9 @@ bool AdvancedOptionsPage::GetBooleanConfigValue(AdvancedOptionId id)
 	case AdvancedOptionId::QuickAccessInTreeView:
 		return m_config->showQuickAccessInTreeView.get();
 
+	case AdvancedOptionId::HibernateInactiveTabs:
+		return m_config->hibernateInactiveTabs;
+
 	default:
 		DCHECK(false);
 		break;
@@ -191,6 +202,10 @@ void AdvancedOptionsPage::SetBooleanConfigValue(AdvancedOptionId id, bool value)
 		m_config->showQuickAccessInTreeView = value;
 		break;
 
+	case AdvancedOptionId::HibernateInactiveTabs:
+		m_config->hibernateInactiveTabs = value;
+		break;
+
 	default:
 		DCHECK(false);
 		break;
@@ -26,7 +26,8 @@ private:
 		CheckSystemIsPinnedToNameSpaceTree,
 		OpenTabsInForeground,
 		GoUpOnDoubleClick,
-		QuickAccessInTreeView
+		QuickAccessInTreeView,
+		HibernateInactiveTabs
 	};
 
 	enum class AdvancedOptionType
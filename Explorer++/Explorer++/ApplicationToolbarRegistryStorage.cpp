@@ -114,7 +114,7 @@ void Load(const std::wstring &mainKeyPath, ApplicationModel *model)
 	}
 }
 
-void Save(const std::wstring &mainKeyPath, const ApplicationModel *model)
+bool Save(const std::wstring &mainKeyPath, const ApplicationModel *model)
 {
 	std::wstring fullKeyPath = mainKeyPath + L"\\" + APPLICATION_TOOLBAR_KEY_PATH;
 	SHDeleteKey(HKEY_CURRENT_USER, fullKeyPath.c_str());
@@ -123,10 +123,14 @@ void Save(const std::wstring &mainKeyPath, const ApplicationModel *model)
 	LSTATUS res = RegCreateKeyEx(HKEY_CURRENT_USER, fullKeyPath.c_str(), 0, nullptr,
 		REG_OPTION_NON_VOLATILE, KEY_WRITE, nullptr, &applicationToolbarKey, nullptr);
 
-	if (res == ERROR_SUCCESS)
+	if (res != ERROR_SUCCESS)
 	{
-		SaveToKey(applicationToolbarKey.get(), model);
+		return false;
 	}
+
+	SaveToKey(applicationToolbarKey.get(), model);
+
+	return true;
 }
 
 }
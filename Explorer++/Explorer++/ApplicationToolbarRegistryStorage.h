@@ -15,7 +15,7 @@ namespace ApplicationToolbarRegistryStorage
 {
 
 void Load(const std::wstring &mainKeyPath, ApplicationModel *model);
-void Save(const std::wstring &mainKeyPath, const ApplicationModel *model);
+bool Save(const std::wstring &mainKeyPath, const ApplicationModel *model);
 
 }
 
@@ -88,6 +88,11 @@ void BookmarkItem::ClearOriginalGUID()
 	m_originalGuid.reset();
 }
 
+void BookmarkItem::RegenerateGUID()
+{
+	m_guid = CreateGUID();
+}
+
 std::wstring BookmarkItem::GetName() const
 {
 	return m_name;
@@ -78,6 +78,10 @@ public:
 	std::optional<std::wstring> GetOriginalGUID() const;
 	void ClearOriginalGUID();
 
+	// Assigns a new GUID to the item. This should only be called before the item has been added to
+	// a BookmarkTree, since the tree indexes items by their GUID.
+	void RegenerateGUID();
+
 	std::wstring GetName() const;
 	void SetName(std::wstring_view name);
 
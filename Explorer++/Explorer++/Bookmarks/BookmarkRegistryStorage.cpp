@@ -257,7 +257,7 @@ std::unique_ptr<BookmarkItem> V1::LoadBookmarkItem(HKEY key, BookmarkTree *bookm
 	return bookmarkItem;
 }
 
-void BookmarkRegistryStorage::Save(const std::wstring &applicationKeyPath,
+bool BookmarkRegistryStorage::Save(const std::wstring &applicationKeyPath,
 	BookmarkTree *bookmarkTree)
 {
 	std::wstring v2KeyPath = BuildFullKeyPath(applicationKeyPath, V2::bookmarksKeyPath);
@@ -267,10 +267,14 @@ void BookmarkRegistryStorage::Save(const std::wstring &applicationKeyPath,
 	LSTATUS res = RegCreateKeyEx(HKEY_CURRENT_USER, v2KeyPath.c_str(), 0, nullptr,
 		REG_OPTION_NON_VOLATILE, KEY_WRITE, nullptr, &bookmarksKey, nullptr);
 
-	if (res == ERROR_SUCCESS)
+	if (res != ERROR_SUCCESS)
 	{
-		V2::Save(bookmarksKey.get(), bookmarkTree);
+		return false;
 	}
+
+	V2::Save(bookmarksKey.get(), bookmarkTree);
+
+	return true;
 }
 
 void V2::Save(HKEY parentKey, BookmarkTree *bookmarkTree)
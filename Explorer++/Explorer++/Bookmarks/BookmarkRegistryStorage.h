@@ -11,5 +11,5 @@ class BookmarkTree;
 namespace BookmarkRegistryStorage
 {
 void Load(const std::wstring &applicationKeyPath, BookmarkTree *bookmarkTree);
-void Save(const std::wstring &applicationKeyPath, BookmarkTree *bookmarkTree);
+bool Save(const std::wstring &applicationKeyPath, BookmarkTree *bookmarkTree);
 }
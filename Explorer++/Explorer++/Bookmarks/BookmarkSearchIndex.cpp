@@ -0,0 +1,243 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "Bookmarks/BookmarkSearchIndex.h"
+#include "Bookmarks/BookmarkTree.h"
+#include <algorithm>
+
+BookmarkSearchIndex::BookmarkSearchIndex(BookmarkTree *bookmarkTree)
+{
+	for (auto &child : bookmarkTree->GetRoot()->GetChildren())
+	{
+		AddItemRecursive(child.get());
+	}
+
+	m_connections.push_back(bookmarkTree->bookmarkItemAddedSignal.AddObserver(
+		std::bind_front(&BookmarkSearchIndex::OnBookmarkItemAdded, this)));
+	m_connections.push_back(bookmarkTree->bookmarkItemUpdatedSignal.AddObserver(
+		std::bind_front(&BookmarkSearchIndex::OnBookmarkItemUpdated, this)));
+	m_connections.push_back(bookmarkTree->bookmarkItemPreRemovalSignal.AddObserver(
+		std::bind_front(&BookmarkSearchIndex::OnBookmarkItemPreRemoval, this)));
+}
+
+void BookmarkSearchIndex::OnBookmarkItemAdded(BookmarkItem &bookmarkItem, size_t index)
+{
+	UNREFERENCED_PARAMETER(index);
+
+	AddItemRecursive(&bookmarkItem);
+}
+
+void BookmarkSearchIndex::OnBookmarkItemUpdated(BookmarkItem &bookmarkItem,
+	BookmarkItem::PropertyType propertyType)
+{
+	if (propertyType != BookmarkItem::PropertyType::Name
+		&& propertyType != BookmarkItem::PropertyType::Location)
+	{
+		return;
+	}
+
+	RemoveItem(&bookmarkItem);
+	AddItem(&bookmarkItem);
+}
+
+void BookmarkSearchIndex::OnBookmarkItemPreRemoval(BookmarkItem &bookmarkItem)
+{
+	bookmarkItem.VisitRecursively([this](BookmarkItem *currentItem) { RemoveItem(currentItem); });
+}
+
+void BookmarkSearchIndex::AddItemRecursive(BookmarkItem *bookmarkItem)
+{
+	bookmarkItem->VisitRecursively([this](BookmarkItem *currentItem) { AddItem(currentItem); });
+}
+
+void BookmarkSearchIndex::AddItem(BookmarkItem *bookmarkItem)
+{
+	AddWords(bookmarkItem, bookmarkItem->GetName(), Field::Name);
+
+	if (bookmarkItem->IsBookmark())
+	{
+		AddWords(bookmarkItem, bookmarkItem->GetLocation(), Field::Location);
+	}
+}
+
+void BookmarkSearchIndex::AddWords(BookmarkItem *bookmarkItem, const std::wstring &text,
+	Field field)
+{
+	auto &itemWords = m_itemWords[bookmarkItem];
+
+	for (auto &word : SplitIntoWords(text))
+	{
+		auto itr = m_index.find(word);
+
+		if (itr == m_index.end())
+		{
+			itr = m_index.emplace(word, Postings()).first;
+		}
+
+		itr->second[bookmarkItem] |= static_cast<int>(field);
+		itemWords.push_back(std::move(word));
+	}
+}
+
+void BookmarkSearchIndex::RemoveItem(BookmarkItem *bookmarkItem)
+{
+	auto itemItr = m_itemWords.find(bookmarkItem);
+
+	if (itemItr == m_itemWords.end())
+	{
+		return;
+	}
+
+	for (const auto &word : itemItr->second)
+	{
+		auto itr = m_index.find(word);
+
+		if (itr == m_index.end())
+		{
+			// The same word can appear multiple times for a single item, in which case it will
+			// already have been removed.
+			continue;
+		}
+
+		itr->second.erase(bookmarkItem);
+
+		if (itr->second.empty())
+		{
+			m_index.erase(itr);
+		}
+	}
+
+	m_itemWords.erase(itemItr);
+}
+
+std::vector<BookmarkItem *> BookmarkSearchIndex::Search(std::wstring_view query,
+	size_t maxResults) const
+{
+	auto queryWords = SplitIntoWords(std::wstring(query));
+
+	if (queryWords.empty() || maxResults == 0)
+	{
+		return {};
+	}
+
+	// Each query word narrows the set of matching items, so the set can only ever shrink after the
+	// first word has been processed.
+	auto scores = ScoreQueryWord(queryWords[0], m_index);
+
+	for (size_t i = 1; i < queryWords.size() && !scores.empty(); i++)
+	{
+		auto wordScores = ScoreQueryWord(queryWords[i], m_index);
+
+		for (auto itr = scores.begin(); itr != scores.end();)
+		{
+			auto wordScoreItr = wordScores.find(itr->first);
+
+			if (wordScoreItr == wordScores.end())
+			{
+				itr = scores.erase(itr);
+				continue;
+			}
+
+			itr->second += wordScoreItr->second;
+			++itr;
+		}
+	}
+
+	std::vector<std::pair<BookmarkItem *, int>> rankedItems(scores.begin(), scores.end());
+	size_t numResults = (std::min)(maxResults, rankedItems.size());
+
+	std::partial_sort(rankedItems.begin(), rankedItems.begin() + numResults, rankedItems.end(),
+		[](const auto &first, const auto &second)
+		{
+			if (first.second != second.second)
+			{
+				return first.second > second.second;
+			}
+
+			int nameComparison = StrCmpLogicalW(first.first->GetName().c_str(),
+				second.first->GetName().c_str());
+
+			if (nameComparison != 0)
+			{
+				return nameComparison < 0;
+			}
+
+			return first.first->GetGUID() < second.first->GetGUID();
+		});
+
+	std::vector<BookmarkItem *> results;
+	results.reserve(numResults);
+
+	for (size_t i = 0; i < numResults; i++)
+	{
+		results.push_back(rankedItems[i].first);
+	}
+
+	return results;
+}
+
+// Returns the score for each item that has a word starting with the specified query word. Higher
+// scores are ranked first.
+std::unordered_map<BookmarkItem *, int> BookmarkSearchIndex::ScoreQueryWord(
+	const std::wstring &queryWord, const std::map<std::wstring, Postings, std::less<>> &index)
+{
+	std::unordered_map<BookmarkItem *, int> scores;
+
+	for (auto itr = index.lower_bound(queryWord);
+		 itr != index.end() && itr->first.starts_with(queryWord); ++itr)
+	{
+		bool exactMatch = (itr->first.size() == queryWord.size());
+
+		for (const auto &[bookmarkItem, fields] : itr->second)
+		{
+			int matchScore;
+
+			if (fields & static_cast<int>(Field::Name))
+			{
+				matchScore = exactMatch ? 4 : 3;
+			}
+			else
+			{
+				matchScore = exactMatch ? 2 : 1;
+			}
+
+			int &score = scores[bookmarkItem];
+			score = (std::max)(score, matchScore);
+		}
+	}
+
+	return scores;
+}
+
+std::vector<std::wstring> BookmarkSearchIndex::SplitIntoWords(const std::wstring &text)
+{
+	std::wstring lowercaseText = text;
+	CharLowerBuff(lowercaseText.data(), static_cast<DWORD>(lowercaseText.size()));
+
+	std::vector<std::wstring> words;
+	std::wstring currentWord;
+
+	for (wchar_t c : lowercaseText)
+	{
+		if (IsCharAlphaNumeric(c))
+		{
+			currentWord.push_back(c);
+			continue;
+		}
+
+		if (!currentWord.empty())
+		{
+			words.push_back(std::move(currentWord));
+			currentWord.clear();
+		}
+	}
+
+	if (!currentWord.empty())
+	{
+		words.push_back(std::move(currentWord));
+	}
+
+	return words;
+}
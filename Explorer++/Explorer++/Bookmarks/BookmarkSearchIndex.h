@@ -0,0 +1,63 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "Bookmarks/BookmarkItem.h"
+#include <boost/core/noncopyable.hpp>
+#include <boost/signals2.hpp>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class BookmarkTree;
+
+// Maintains an in-memory index of the words that appear in the name and location of each bookmark
+// item, so that bookmarks can be searched (e.g. as the user types) without having to examine every
+// item in the tree. The index is kept up to date as items in the tree are added, updated and
+// removed.
+//
+// Each word in a query is matched against the start of the words in an item's name and location.
+// An item is only returned if every word in the query matches. Results are ranked so that exact
+// word matches come before prefix matches and matches in the name come before matches in the
+// location.
+class BookmarkSearchIndex : private boost::noncopyable
+{
+public:
+	BookmarkSearchIndex(BookmarkTree *bookmarkTree);
+
+	std::vector<BookmarkItem *> Search(std::wstring_view query, size_t maxResults) const;
+
+private:
+	enum class Field
+	{
+		Name = 1 << 0,
+		Location = 1 << 1
+	};
+
+	// Maps an item to the fields (a combination of Field values) the word appears in.
+	using Postings = std::unordered_map<BookmarkItem *, int>;
+
+	void OnBookmarkItemAdded(BookmarkItem &bookmarkItem, size_t index);
+	void OnBookmarkItemUpdated(BookmarkItem &bookmarkItem, BookmarkItem::PropertyType propertyType);
+	void OnBookmarkItemPreRemoval(BookmarkItem &bookmarkItem);
+
+	void AddItemRecursive(BookmarkItem *bookmarkItem);
+	void AddItem(BookmarkItem *bookmarkItem);
+	void RemoveItem(BookmarkItem *bookmarkItem);
+	void AddWords(BookmarkItem *bookmarkItem, const std::wstring &text, Field field);
+
+	static std::vector<std::wstring> SplitIntoWords(const std::wstring &text);
+	static std::unordered_map<BookmarkItem *, int> ScoreQueryWord(const std::wstring &queryWord,
+		const std::map<std::wstring, Postings, std::less<>> &index);
+
+	std::map<std::wstring, Postings, std::less<>> m_index;
+
+	// The words indexed for each item, so that they can be removed later.
+	std::unordered_map<BookmarkItem *, std::vector<std::wstring>> m_itemWords;
+
+	std::vector<boost::signals2::scoped_connection> m_connections;
+};
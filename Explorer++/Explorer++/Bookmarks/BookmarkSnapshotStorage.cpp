@@ -0,0 +1,323 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "Bookmarks/BookmarkSnapshotStorage.h"
+#include "Bookmarks/BookmarkItem.h"
+#include "Bookmarks/BookmarkTree.h"
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+#include <glog/logging.h>
+#include <fstream>
+#include <optional>
+#include <sstream>
+
+namespace
+{
+
+// This should be incremented whenever the format below changes. Snapshots with a different
+// version will simply be ignored (and replaced the next time settings are saved).
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+struct SourceFileInfo
+{
+	int64_t lastWriteTime;
+	uint64_t size;
+
+	bool operator==(const SourceFileInfo &) const = default;
+
+	template <class Archive>
+	void serialize(Archive &archive)
+	{
+		archive(lastWriteTime, size);
+	}
+};
+
+struct SnapshotItem
+{
+	BookmarkItem::Type type;
+	std::wstring guid;
+	std::wstring name;
+	std::wstring location;
+	uint64_t dateCreated;
+	uint64_t dateModified;
+	std::vector<SnapshotItem> children;
+
+	template <class Archive>
+	void serialize(Archive &archive)
+	{
+		archive(type, guid, name, location, dateCreated, dateModified, children);
+	}
+};
+
+struct SnapshotPermanentFolder
+{
+	uint64_t dateCreated;
+	uint64_t dateModified;
+	std::vector<SnapshotItem> children;
+
+	template <class Archive>
+	void serialize(Archive &archive)
+	{
+		archive(dateCreated, dateModified, children);
+	}
+};
+
+struct Snapshot
+{
+	SnapshotPermanentFolder bookmarksToolbar;
+	SnapshotPermanentFolder bookmarksMenu;
+	SnapshotPermanentFolder otherBookmarks;
+
+	template <class Archive>
+	void serialize(Archive &archive)
+	{
+		archive(bookmarksToolbar, bookmarksMenu, otherBookmarks);
+	}
+};
+
+uint64_t FileTimeToInteger(const FILETIME &fileTime)
+{
+	return (static_cast<uint64_t>(fileTime.dwHighDateTime) << 32) | fileTime.dwLowDateTime;
+}
+
+FILETIME IntegerToFileTime(uint64_t value)
+{
+	return { static_cast<DWORD>(value & 0xFFFFFFFF), static_cast<DWORD>(value >> 32) };
+}
+
+std::optional<SourceFileInfo> GetSourceFileInfo(const std::filesystem::path &sourcePath)
+{
+	std::error_code error;
+	auto lastWriteTime = std::filesystem::last_write_time(sourcePath, error);
+
+	if (error)
+	{
+		return std::nullopt;
+	}
+
+	auto size = std::filesystem::file_size(sourcePath, error);
+
+	if (error)
+	{
+		return std::nullopt;
+	}
+
+	return SourceFileInfo{ lastWriteTime.time_since_epoch().count(), size };
+}
+
+SnapshotItem BuildSnapshotItem(const BookmarkItem *bookmarkItem)
+{
+	SnapshotItem snapshotItem = { bookmarkItem->GetType(), bookmarkItem->GetGUID(),
+		bookmarkItem->GetName(), bookmarkItem->IsBookmark() ? bookmarkItem->GetLocation() : L"",
+		FileTimeToInteger(bookmarkItem->GetDateCreated()),
+		FileTimeToInteger(bookmarkItem->GetDateModified()), {} };
+
+	for (const auto &child : bookmarkItem->GetChildren())
+	{
+		snapshotItem.children.push_back(BuildSnapshotItem(child.get()));
+	}
+
+	return snapshotItem;
+}
+
+SnapshotPermanentFolder BuildSnapshotPermanentFolder(const BookmarkItem *bookmarkItem)
+{
+	SnapshotPermanentFolder permanentFolder = { FileTimeToInteger(bookmarkItem->GetDateCreated()),
+		FileTimeToInteger(bookmarkItem->GetDateModified()), {} };
+
+	for (const auto &child : bookmarkItem->GetChildren())
+	{
+		permanentFolder.children.push_back(BuildSnapshotItem(child.get()));
+	}
+
+	return permanentFolder;
+}
+
+std::unique_ptr<BookmarkItem> CreateBookmarkItem(const SnapshotItem &snapshotItem)
+{
+	std::optional<std::wstring> location;
+
+	if (snapshotItem.type == BookmarkItem::Type::Bookmark)
+	{
+		location = snapshotItem.location;
+	}
+
+	auto bookmarkItem = std::make_unique<BookmarkItem>(snapshotItem.guid, snapshotItem.name,
+		location);
+
+	// Child items are added directly here, rather than through the bookmark tree, since the tree
+	// will process the entire set of items once the top-level item is added.
+	for (const auto &child : snapshotItem.children)
+	{
+		bookmarkItem->AddChild(CreateBookmarkItem(child));
+	}
+
+	// Adding a child updates the modification time of the parent, so the dates are set last.
+	bookmarkItem->SetDateCreated(IntegerToFileTime(snapshotItem.dateCreated));
+	bookmarkItem->SetDateModified(IntegerToFileTime(snapshotItem.dateModified));
+
+	return bookmarkItem;
+}
+
+void LoadPermanentFolder(const SnapshotPermanentFolder &permanentFolder,
+	BookmarkTree *bookmarkTree, BookmarkItem *bookmarkItem)
+{
+	size_t index = 0;
+
+	for (const auto &child : permanentFolder.children)
+	{
+		bookmarkTree->AddBookmarkItem(bookmarkItem, CreateBookmarkItem(child), index++);
+	}
+
+	bookmarkItem->SetDateCreated(IntegerToFileTime(permanentFolder.dateCreated));
+	bookmarkItem->SetDateModified(IntegerToFileTime(permanentFolder.dateModified));
+}
+
+bool ValidateSnapshotItems(const std::vector<SnapshotItem> &snapshotItems)
+{
+	for (const auto &snapshotItem : snapshotItems)
+	{
+		if (snapshotItem.type != BookmarkItem::Type::Bookmark
+			&& snapshotItem.type != BookmarkItem::Type::Folder)
+		{
+			return false;
+		}
+
+		if (snapshotItem.type == BookmarkItem::Type::Bookmark && !snapshotItem.children.empty())
+		{
+			return false;
+		}
+
+		if (!ValidateSnapshotItems(snapshotItem.children))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+}
+
+namespace BookmarkSnapshotStorage
+{
+
+bool Load(const std::filesystem::path &snapshotPath, const std::filesystem::path &sourcePath,
+	BookmarkTree *bookmarkTree)
+{
+	auto sourceFileInfo = GetSourceFileInfo(sourcePath);
+
+	if (!sourceFileInfo)
+	{
+		return false;
+	}
+
+	std::string data;
+
+	{
+		// The entire file is read in a single call and then deserialized from memory.
+		std::ifstream inputStream(snapshotPath, std::ios::binary | std::ios::ate);
+
+		if (!inputStream)
+		{
+			return false;
+		}
+
+		data.resize(static_cast<size_t>(inputStream.tellg()));
+		inputStream.seekg(0);
+		inputStream.read(data.data(), data.size());
+
+		if (!inputStream)
+		{
+			return false;
+		}
+	}
+
+	Snapshot snapshot;
+
+	try
+	{
+		std::istringstream stringstream(std::move(data));
+		cereal::BinaryInputArchive inputArchive(stringstream);
+
+		uint32_t version;
+		inputArchive(version);
+
+		if (version != SNAPSHOT_VERSION)
+		{
+			return false;
+		}
+
+		SourceFileInfo snapshotSourceFileInfo;
+		inputArchive(snapshotSourceFileInfo);
+
+		if (snapshotSourceFileInfo != *sourceFileInfo)
+		{
+			return false;
+		}
+
+		inputArchive(snapshot);
+	}
+	catch (const std::exception &e)
+	{
+		// In addition to cereal::Exception, a corrupted length field can result in
+		// std::length_error or std::bad_alloc being thrown when a container is resized.
+		LOG(WARNING) << "Bookmark snapshot could not be read: " << e.what();
+		return false;
+	}
+
+	if (!ValidateSnapshotItems(snapshot.bookmarksToolbar.children)
+		|| !ValidateSnapshotItems(snapshot.bookmarksMenu.children)
+		|| !ValidateSnapshotItems(snapshot.otherBookmarks.children))
+	{
+		return false;
+	}
+
+	LoadPermanentFolder(snapshot.bookmarksToolbar, bookmarkTree,
+		bookmarkTree->GetBookmarksToolbarFolder());
+	LoadPermanentFolder(snapshot.bookmarksMenu, bookmarkTree,
+		bookmarkTree->GetBookmarksMenuFolder());
+	LoadPermanentFolder(snapshot.otherBookmarks, bookmarkTree,
+		bookmarkTree->GetOtherBookmarksFolder());
+
+	return true;
+}
+
+bool Save(const std::filesystem::path &snapshotPath, const std::filesystem::path &sourcePath,
+	const BookmarkTree *bookmarkTree)
+{
+	auto sourceFileInfo = GetSourceFileInfo(sourcePath);
+
+	if (!sourceFileInfo)
+	{
+		return false;
+	}
+
+	Snapshot snapshot = { BuildSnapshotPermanentFolder(bookmarkTree->GetBookmarksToolbarFolder()),
+		BuildSnapshotPermanentFolder(bookmarkTree->GetBookmarksMenuFolder()),
+		BuildSnapshotPermanentFolder(bookmarkTree->GetOtherBookmarksFolder()) };
+
+	std::ostringstream stringstream;
+
+	{
+		cereal::BinaryOutputArchive outputArchive(stringstream);
+		outputArchive(SNAPSHOT_VERSION, *sourceFileInfo, snapshot);
+	}
+
+	std::ofstream outputStream(snapshotPath, std::ios::binary | std::ios::trunc);
+
+	if (!outputStream)
+	{
+		return false;
+	}
+
+	auto data = stringstream.str();
+	outputStream.write(data.data(), data.size());
+
+	return outputStream.good();
+}
+
+}
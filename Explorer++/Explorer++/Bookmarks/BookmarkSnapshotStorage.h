@@ -0,0 +1,29 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <filesystem>
+
+class BookmarkTree;
+
+// Loading bookmarks from the config file requires walking the XML DOM, which is slow when there
+// are a large number of bookmarks. Whenever the config file is saved, a binary snapshot of the
+// bookmarks is written alongside it. On startup, the snapshot can then be loaded instead.
+//
+// Each snapshot records the size and last write time of the config file it was written alongside.
+// If the config file has changed since then (e.g. because it was edited by hand, or replaced), the
+// snapshot is considered stale and won't be loaded.
+namespace BookmarkSnapshotStorage
+{
+
+// Returns true if the snapshot was loaded. If the snapshot is missing, stale or invalid, false
+// will be returned and the bookmark tree won't be modified.
+bool Load(const std::filesystem::path &snapshotPath, const std::filesystem::path &sourcePath,
+	BookmarkTree *bookmarkTree);
+
+bool Save(const std::filesystem::path &snapshotPath, const std::filesystem::path &sourcePath,
+	const BookmarkTree *bookmarkTree);
+
+}
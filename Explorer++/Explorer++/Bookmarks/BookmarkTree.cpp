@@ -8,6 +8,7 @@
 #include "MainResource.h"
 #include "ResourceHelper.h"
 #include <glog/logging.h>
+#include <utility>
 
 BookmarkTree::BookmarkTree() :
 	m_root(ROOT_FOLDER_GUID,
@@ -31,6 +32,11 @@ BookmarkTree::BookmarkTree() :
 		std::nullopt);
 	m_otherBookmarks = otherBookmarksFolder.get();
 	m_root.AddChild(std::move(otherBookmarksFolder));
+
+	for (auto *permanentFolder : { &m_root, m_bookmarksToolbar, m_bookmarksMenu, m_otherBookmarks })
+	{
+		m_guidIndex.emplace(permanentFolder->GetGUID(), permanentFolder);
+	}
 }
 
 BookmarkItem *BookmarkTree::GetRoot()
@@ -88,6 +94,20 @@ BookmarkItem *BookmarkTree::AddBookmarkItem(BookmarkItem *parent,
 			currentItem->updatedSignal.AddObserver(
 				std::bind_front(&BookmarkTree::OnBookmarkItemUpdated, this),
 				boost::signals2::at_front);
+
+			bool inserted = m_guidIndex.emplace(currentItem->GetGUID(), currentItem).second;
+
+			if (!inserted)
+			{
+				// GUIDs are normally unique, but items loaded from a config file that's been
+				// edited by hand could share a GUID. Since the index can only refer to a single
+				// item, the item being added is given a new GUID in that case.
+				LOG(WARNING) << "Duplicate bookmark GUID found; assigning a new GUID";
+
+				currentItem->RegenerateGUID();
+				inserted = m_guidIndex.emplace(currentItem->GetGUID(), currentItem).second;
+				DCHECK(inserted);
+			}
 		});
 
 	if (index > parent->GetChildren().size())
@@ -149,11 +169,31 @@ void BookmarkTree::RemoveBookmarkItem(BookmarkItem *bookmarkItem)
 
 	std::wstring guid = bookmarkItem->GetGUID();
 
+	bookmarkItem->VisitRecursively([this](BookmarkItem *currentItem)
+		{ m_guidIndex.erase(currentItem->GetGUID()); });
+
 	size_t childIndex = parent->GetChildIndex(bookmarkItem);
 	parent->RemoveChild(childIndex);
 	bookmarkItemRemovedSignal.m_signal(guid);
 }
 
+BookmarkItem *BookmarkTree::GetBookmarkItemById(std::wstring_view guid)
+{
+	return const_cast<BookmarkItem *>(std::as_const(*this).GetBookmarkItemById(guid));
+}
+
+const BookmarkItem *BookmarkTree::GetBookmarkItemById(std::wstring_view guid) const
+{
+	auto itr = m_guidIndex.find(guid);
+
+	if (itr == m_guidIndex.end())
+	{
+		return nullptr;
+	}
+
+	return itr->second;
+}
+
 void BookmarkTree::OnBookmarkItemUpdated(BookmarkItem &bookmarkItem,
 	BookmarkItem::PropertyType propertyType)
 {
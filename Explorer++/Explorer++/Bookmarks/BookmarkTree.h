@@ -7,6 +7,9 @@
 #include "Bookmarks/BookmarkItem.h"
 #include "SignalWrapper.h"
 #include <tchar.h>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 
 class BookmarkTree
 {
@@ -29,6 +32,10 @@ public:
 	void MoveBookmarkItem(BookmarkItem *bookmarkItem, BookmarkItem *newParent, size_t index);
 	void RemoveBookmarkItem(BookmarkItem *bookmarkItem);
 
+	// Returns the item with the specified GUID, or nullptr if there's no such item in the tree.
+	BookmarkItem *GetBookmarkItemById(std::wstring_view guid);
+	const BookmarkItem *GetBookmarkItemById(std::wstring_view guid) const;
+
 	// Signals
 	SignalWrapper<BookmarkTree, void(BookmarkItem &bookmarkItem, size_t index)>
 		bookmarkItemAddedSignal;
@@ -50,10 +57,29 @@ private:
 	static inline const TCHAR *MENU_FOLDER_GUID = _T("00000000-0000-0000-0000-000000000003");
 	static inline const TCHAR *OTHER_FOLDER_GUID = _T("00000000-0000-0000-0000-000000000004");
 
+	// Allows items in the GUID index to be looked up using a std::wstring_view, without having to
+	// construct a std::wstring first.
+	struct GuidHash
+	{
+		using is_transparent = void;
+
+		size_t operator()(std::wstring_view guid) const
+		{
+			return std::hash<std::wstring_view>{}(guid);
+		}
+	};
+
+	using GuidIndex = std::unordered_map<std::wstring, BookmarkItem *, GuidHash, std::equal_to<>>;
+
 	void OnBookmarkItemUpdated(BookmarkItem &bookmarkItem, BookmarkItem::PropertyType propertyType);
 
 	BookmarkItem m_root;
 	BookmarkItem *m_bookmarksToolbar;
 	BookmarkItem *m_bookmarksMenu;
 	BookmarkItem *m_otherBookmarks;
+
+	// Maps the GUID of every item in the tree (including the permanent folders) to the item
+	// itself. GUIDs never change once an item has been created, so the index only needs to be
+	// updated when items are added or removed. Moving an item doesn't affect it.
+	GuidIndex m_guidIndex;
 };
@@ -4,6 +4,7 @@
 
 #include "stdafx.h"
 #include "BookmarkTreeFactory.h"
+#include "Bookmarks/BookmarkSearchIndex.h"
 #include "Bookmarks/BookmarkTree.h"
 
 BookmarkTreeFactory::~BookmarkTreeFactory() = default;
@@ -29,3 +30,13 @@ BookmarkTree *BookmarkTreeFactory::GetBookmarkTree()
 
 	return m_bookmarkTree.get();
 }
+
+BookmarkSearchIndex *BookmarkTreeFactory::GetBookmarkSearchIndex()
+{
+	if (!m_bookmarkSearchIndex)
+	{
+		m_bookmarkSearchIndex = std::make_unique<BookmarkSearchIndex>(GetBookmarkTree());
+	}
+
+	return m_bookmarkSearchIndex.get();
+}
@@ -6,6 +6,7 @@
 
 #include <memory>
 
+class BookmarkSearchIndex;
 class BookmarkTree;
 
 // This class doesn't do much at the moment. But it could be updated to return different
@@ -17,6 +18,10 @@ public:
 
 	BookmarkTree *GetBookmarkTree();
 
+	// The search index is only built the first time it's requested, since it's not needed unless
+	// the user actually searches their bookmarks.
+	BookmarkSearchIndex *GetBookmarkSearchIndex();
+
 private:
 	BookmarkTreeFactory() = default;
 	~BookmarkTreeFactory();
@@ -24,4 +29,5 @@ private:
 	static inline BookmarkTreeFactory *m_staticInstance = nullptr;
 
 	std::unique_ptr<BookmarkTree> m_bookmarkTree;
+	std::unique_ptr<BookmarkSearchIndex> m_bookmarkSearchIndex;
 };
@@ -21,6 +21,7 @@
 #include "../Helper/Macros.h"
 #include "../Helper/MenuHelper.h"
 #include "../Helper/WindowHelper.h"
+#include <algorithm>
 #include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/adaptor/indexed.hpp>
 #include <glog/logging.h>
@@ -251,6 +252,12 @@ void BookmarkListView::NavigateToBookmarkFolder(BookmarkItem *bookmarkFolder, bo
 
 	m_currentBookmarkFolder = bookmarkFolder;
 
+	if (m_showingSearchResults)
+	{
+		m_showingSearchResults = false;
+		UpdateBlockDrop();
+	}
+
 	ListView_DeleteAllItems(m_hListView);
 
 	int position = 0;
@@ -265,6 +272,51 @@ void BookmarkListView::NavigateToBookmarkFolder(BookmarkItem *bookmarkFolder, bo
 	m_navigationCompletedSignal(bookmarkFolder, addHistoryEntry);
 }
 
+void BookmarkListView::ShowSearchResults(const std::vector<BookmarkItem *> &bookmarkItems)
+{
+	if (!m_showingSearchResults)
+	{
+		m_showingSearchResults = true;
+		UpdateBlockDrop();
+	}
+
+	SendMessage(m_hListView, WM_SETREDRAW, FALSE, 0);
+
+	ListView_DeleteAllItems(m_hListView);
+
+	int position = 0;
+
+	for (auto *bookmarkItem : bookmarkItems)
+	{
+		InsertBookmarkItemIntoListView(bookmarkItem, position);
+
+		position++;
+	}
+
+	SendMessage(m_hListView, WM_SETREDRAW, TRUE, 0);
+}
+
+bool BookmarkListView::IsShowingSearchResults() const
+{
+	return m_showingSearchResults;
+}
+
+void BookmarkListView::LeaveSearchResults()
+{
+	if (m_showingSearchResults)
+	{
+		NavigateToBookmarkFolder(m_currentBookmarkFolder, false);
+	}
+}
+
+void BookmarkListView::UpdateBlockDrop()
+{
+	// It's only possible to drop items when using the default sort mode, since that's the only mode
+	// in which the listview indexes match the bookmark item indexes. That's never the case when
+	// showing search results, as the items can come from any folder.
+	SetBlockDrop(m_showingSearchResults || m_sortColumn != BookmarkHelper::ColumnType::Default);
+}
+
 boost::signals2::connection BookmarkListView::AddNavigationCompletedObserver(
 	const BookmarkNavigationCompletedSignal::slot_type &observer,
 	boost::signals2::connect_position position)
@@ -400,9 +452,7 @@ void BookmarkListView::SetSortColumn(BookmarkHelper::ColumnType sortColumn)
 	m_previousSortColumn = m_sortColumn;
 	m_sortColumn = sortColumn;
 
-	// It's only possible to drop items when using the default sort mode, since that's the only mode
-	// in which the listview indexes match the bookmark item indexes.
-	SetBlockDrop(sortColumn != BookmarkHelper::ColumnType::Default);
+	UpdateBlockDrop();
 
 	SortItems();
 	UpdateHeader();
@@ -530,8 +580,26 @@ void BookmarkListView::OnShowContextMenu(const POINT &ptScreen)
 			ClientToScreen(m_hListView, &finalPoint);
 		}
 
-		m_bookmarkContextMenu.ShowMenu(m_hListView, m_currentBookmarkFolder, rawBookmarkItems,
-			finalPoint);
+		BookmarkItem *parentFolder = m_currentBookmarkFolder;
+
+		if (m_showingSearchResults)
+		{
+			// The menu positions pasted items relative to the selected items within their parent
+			// folder, so that's only possible when the selected items share a parent.
+			parentFolder = rawBookmarkItems[0]->GetParent();
+
+			bool sameParent = std::all_of(rawBookmarkItems.begin(), rawBookmarkItems.end(),
+				[parentFolder](const BookmarkItem *bookmarkItem) {
+					return bookmarkItem->GetParent() == parentFolder;
+				});
+
+			if (!sameParent)
+			{
+				return;
+			}
+		}
+
+		m_bookmarkContextMenu.ShowMenu(m_hListView, parentFolder, rawBookmarkItems, finalPoint);
 	}
 }
 
@@ -576,6 +644,8 @@ void BookmarkListView::OnMenuItemSelected(int menuItemId)
 
 void BookmarkListView::OnNewBookmark()
 {
+	LeaveSearchResults();
+
 	size_t targetIndex;
 	auto lastSelectedItemindex = GetLastSelectedItemIndex();
 
@@ -639,6 +709,8 @@ void BookmarkListView::SelectItem(const BookmarkItem *bookmarkItem)
 
 void BookmarkListView::CreateNewFolder()
 {
+	LeaveSearchResults();
+
 	auto bookmarkItem = std::make_unique<BookmarkItem>(std::nullopt,
 		ResourceHelper::LoadString(m_resourceInstance, IDS_BOOKMARKS_NEWBOOKMARKFOLDER),
 		std::nullopt);
@@ -993,6 +1065,11 @@ void BookmarkListView::ToggleColumn(BookmarkHelper::ColumnType columnType)
 
 void BookmarkListView::OnBookmarkItemAdded(BookmarkItem &bookmarkItem, size_t index)
 {
+	if (m_showingSearchResults)
+	{
+		return;
+	}
+
 	if (bookmarkItem.GetParent() == m_currentBookmarkFolder)
 	{
 		InsertBookmarkItemIntoListView(&bookmarkItem, static_cast<int>(index));
@@ -1002,12 +1079,18 @@ void BookmarkListView::OnBookmarkItemAdded(BookmarkItem &bookmarkItem, size_t in
 void BookmarkListView::OnBookmarkItemUpdated(BookmarkItem &bookmarkItem,
 	BookmarkItem::PropertyType propertyType)
 {
-	if (bookmarkItem.GetParent() != m_currentBookmarkFolder)
+	if (!m_showingSearchResults && bookmarkItem.GetParent() != m_currentBookmarkFolder)
 	{
 		return;
 	}
 
 	auto index = GetBookmarkItemIndex(&bookmarkItem);
+
+	if (m_showingSearchResults && !index)
+	{
+		return;
+	}
+
 	CHECK(index);
 
 	BookmarkHelper::ColumnType columnType = MapPropertyTypeToColumnType(propertyType);
@@ -1028,6 +1111,12 @@ void BookmarkListView::OnBookmarkItemMoved(BookmarkItem *bookmarkItem,
 {
 	UNREFERENCED_PARAMETER(oldIndex);
 
+	// Search results aren't tied to a folder, so moving an item doesn't affect whether it's shown.
+	if (m_showingSearchResults)
+	{
+		return;
+	}
+
 	if (oldParent == m_currentBookmarkFolder)
 	{
 		RemoveBookmarkItem(bookmarkItem);
@@ -1041,6 +1130,25 @@ void BookmarkListView::OnBookmarkItemMoved(BookmarkItem *bookmarkItem,
 
 void BookmarkListView::OnBookmarkItemPreRemoval(BookmarkItem &bookmarkItem)
 {
+	if (m_showingSearchResults)
+	{
+		// Only a single notification is sent when a folder is removed, so any of its descendants
+		// that appear in the results need to be removed as well.
+		for (int i = ListView_GetItemCount(m_hListView) - 1; i >= 0; i--)
+		{
+			for (auto *item = GetBookmarkItemFromListView(i); item; item = item->GetParent())
+			{
+				if (item == &bookmarkItem)
+				{
+					ListView_DeleteItem(m_hListView, i);
+					break;
+				}
+			}
+		}
+
+		return;
+	}
+
 	if (bookmarkItem.GetParent() == m_currentBookmarkFolder)
 	{
 		RemoveBookmarkItem(&bookmarkItem);
@@ -1072,19 +1180,14 @@ std::optional<int> BookmarkListView::GetBookmarkItemIndex(const BookmarkItem *bo
 
 std::optional<int> BookmarkListView::GetBookmarkItemIndexUsingGuid(std::wstring_view guid) const
 {
-	int numItems = ListView_GetItemCount(m_hListView);
+	const BookmarkItem *bookmarkItem = std::as_const(*m_bookmarkTree).GetBookmarkItemById(guid);
 
-	for (int i = 0; i < numItems; i++)
+	if (!bookmarkItem)
 	{
-		const BookmarkItem *bookmarkItem = GetBookmarkItemFromListView(i);
-
-		if (bookmarkItem->GetGUID() == guid)
-		{
-			return i;
-		}
+		return std::nullopt;
 	}
 
-	return std::nullopt;
+	return GetBookmarkItemIndex(bookmarkItem);
 }
 
 BookmarkHelper::ColumnType BookmarkListView::MapPropertyTypeToColumnType(
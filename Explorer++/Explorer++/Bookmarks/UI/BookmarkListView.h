@@ -36,6 +36,14 @@ public:
 		const std::vector<Column> &initialColumns);
 
 	void NavigateToBookmarkFolder(BookmarkItem *bookmarkFolder, bool addHistoryEntry) override;
+
+	// Replaces the contents of the listview with the specified items, which can come from any
+	// folder. The current folder is retained, so that navigating back to it (which also happens
+	// implicitly when an item is added to it from the listview) ends the search.
+	void ShowSearchResults(const std::vector<BookmarkItem *> &bookmarkItems);
+	bool IsShowingSearchResults() const;
+	void LeaveSearchResults();
+
 	boost::signals2::connection AddNavigationCompletedObserver(
 		const BookmarkNavigationCompletedSignal::slot_type &observer,
 		boost::signals2::connect_position position = boost::signals2::at_back) override;
@@ -110,6 +118,7 @@ private:
 		size_t oldIndex, const BookmarkItem *newParent, size_t newIndex);
 	void OnBookmarkItemPreRemoval(BookmarkItem &bookmarkItem);
 
+	void UpdateBlockDrop();
 	void RemoveBookmarkItem(const BookmarkItem *bookmarkItem);
 	std::optional<int> GetBookmarkItemIndex(const BookmarkItem *bookmarkItem) const;
 	std::optional<int> GetBookmarkItemIndexUsingGuid(std::wstring_view guid) const;
@@ -135,6 +144,7 @@ private:
 
 	BookmarkTree *m_bookmarkTree = nullptr;
 	BookmarkItem *m_currentBookmarkFolder = nullptr;
+	bool m_showingSearchResults = false;
 	BookmarkHelper::ColumnType m_sortColumn;
 	bool m_sortAscending;
 	std::optional<BookmarkHelper::ColumnType> m_previousSortColumn;
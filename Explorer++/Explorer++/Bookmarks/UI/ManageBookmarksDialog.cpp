@@ -7,6 +7,7 @@
 #include "Bookmarks/BookmarkHelper.h"
 #include "Bookmarks/BookmarkIconManager.h"
 #include "Bookmarks/BookmarkNavigationController.h"
+#include "Bookmarks/BookmarkSearchIndex.h"
 #include "Bookmarks/BookmarkTree.h"
 #include "Bookmarks/UI/BookmarkTreeView.h"
 #include "BrowserWindow.h"
@@ -19,6 +20,7 @@
 #include "../Helper/ListViewHelper.h"
 #include "../Helper/Macros.h"
 #include "../Helper/MenuHelper.h"
+#include "../Helper/WindowHelper.h"
 #include "../Helper/WindowSubclassWrapper.h"
 #include <glog/logging.h>
 
@@ -26,12 +28,13 @@ const TCHAR ManageBookmarksDialogPersistentSettings::SETTINGS_KEY[] = _T("Manage
 
 ManageBookmarksDialog::ManageBookmarksDialog(HINSTANCE resourceInstance, HWND hParent,
 	BrowserWindow *browserWindow, CoreInterface *coreInterface, IconFetcher *iconFetcher,
-	BookmarkTree *bookmarkTree) :
+	BookmarkTree *bookmarkTree, BookmarkSearchIndex *bookmarkSearchIndex) :
 	ThemedDialog(resourceInstance, IDD_MANAGE_BOOKMARKS, hParent, DialogSizingType::Both),
 	m_browserWindow(browserWindow),
 	m_coreInterface(coreInterface),
 	m_iconFetcher(iconFetcher),
-	m_bookmarkTree(bookmarkTree)
+	m_bookmarkTree(bookmarkTree),
+	m_bookmarkSearchIndex(bookmarkSearchIndex)
 {
 	m_persistentSettings = &ManageBookmarksDialogPersistentSettings::GetInstance();
 
@@ -50,6 +53,7 @@ ManageBookmarksDialog::~ManageBookmarksDialog()
 INT_PTR ManageBookmarksDialog::OnInitDialog()
 {
 	SetupToolbar();
+	SetupSearchField();
 	SetupTreeView();
 	SetupListView();
 
@@ -67,11 +71,13 @@ INT_PTR ManageBookmarksDialog::OnInitDialog()
 void ManageBookmarksDialog::AddDynamicControls()
 {
 	CreateToolbar();
+	CreateSearchField();
 }
 
 std::vector<ResizableDialogControl> ManageBookmarksDialog::GetResizableControls()
 {
 	std::vector<ResizableDialogControl> controls;
+	controls.emplace_back(m_searchField, MovingType::Horizontal, SizingType::None);
 	controls.emplace_back(GetDlgItem(m_hDlg, IDC_MANAGEBOOKMARKS_TREEVIEW), MovingType::None,
 		SizingType::Vertical);
 	controls.emplace_back(GetDlgItem(m_hDlg, IDC_MANAGEBOOKMARKS_LISTVIEW), MovingType::None,
@@ -176,6 +182,49 @@ void ManageBookmarksDialog::SetupToolbar()
 		HIWORD(dwButtonSize), 0);
 }
 
+void ManageBookmarksDialog::CreateSearchField()
+{
+	m_searchField = CreateWindowEx(WS_EX_CLIENTEDGE, WC_EDIT, EMPTY_STRING,
+		WS_VISIBLE | WS_CHILD | WS_TABSTOP | ES_AUTOHSCROLL, 0, 0, 0, 0, m_hDlg,
+		reinterpret_cast<HMENU>(static_cast<INT_PTR>(SEARCH_FIELD_ID)), GetModuleHandle(nullptr),
+		nullptr);
+}
+
+void ManageBookmarksDialog::SetupSearchField()
+{
+	SendMessage(m_searchField, WM_SETFONT, SendMessage(m_hDlg, WM_GETFONT, 0, 0), false);
+
+	auto placeholderText = ResourceHelper::LoadString(GetResourceInstance(),
+		IDS_MANAGE_BOOKMARKS_DEFAULT_SEARCH_TEXT);
+	SendMessage(m_searchField, EM_SETCUEBANNER, true,
+		reinterpret_cast<LPARAM>(placeholderText.c_str()));
+
+	RECT rcTreeView;
+	GetWindowRect(GetDlgItem(m_hDlg, IDC_MANAGEBOOKMARKS_TREEVIEW), &rcTreeView);
+	MapWindowPoints(HWND_DESKTOP, m_hDlg, reinterpret_cast<LPPOINT>(&rcTreeView), 2);
+
+	RECT rcListView;
+	GetWindowRect(GetDlgItem(m_hDlg, IDC_MANAGEBOOKMARKS_LISTVIEW), &rcListView);
+	MapWindowPoints(HWND_DESKTOP, m_hDlg, reinterpret_cast<LPPOINT>(&rcListView), 2);
+
+	auto &dpiCompat = DpiCompatibility::GetInstance();
+	int width = (std::min)(dpiCompat.ScaleValue(m_hDlg, SEARCH_FIELD_WIDTH),
+		GetRectWidth(&rcListView) / 2);
+	int spacing = dpiCompat.ScaleValue(m_hDlg, SEARCH_FIELD_SPACING);
+
+	// The search field sits at the right of the toolbar row, so the toolbar is shrunk to make room
+	// for it.
+	auto dwButtonSize = static_cast<DWORD>(SendMessage(m_hToolbar, TB_GETBUTTONSIZE, 0, 0));
+	int toolbarWidth = rcListView.right - width - spacing - rcTreeView.left;
+
+	SetWindowPos(m_toolbarParent, nullptr, 0, 0, toolbarWidth, HIWORD(dwButtonSize),
+		SWP_NOMOVE | SWP_NOZORDER);
+	SetWindowPos(m_hToolbar, nullptr, 0, 0, toolbarWidth, HIWORD(dwButtonSize),
+		SWP_NOMOVE | SWP_NOZORDER);
+	SetWindowPos(m_searchField, nullptr, rcListView.right - width,
+		(rcTreeView.top - HIWORD(dwButtonSize)) / 2, width, HIWORD(dwButtonSize), SWP_NOZORDER);
+}
+
 void ManageBookmarksDialog::SetupTreeView()
 {
 	HWND hTreeView = GetDlgItem(m_hDlg, IDC_MANAGEBOOKMARKS_TREEVIEW);
@@ -271,6 +320,11 @@ INT_PTR ManageBookmarksDialog::OnCommand(WPARAM wParam, LPARAM lParam)
 	{
 		return HandleMenuOrAccelerator(wParam);
 	}
+	else if (HIWORD(wParam) == EN_CHANGE && LOWORD(wParam) == SEARCH_FIELD_ID)
+	{
+		OnSearchTextChanged();
+		return 0;
+	}
 
 	return 1;
 }
@@ -604,6 +658,8 @@ void ManageBookmarksDialog::OnNewBookmark()
 
 	if (focus == listView)
 	{
+		m_bookmarkListView->LeaveSearchResults();
+
 		auto lastSelectedItemIndex = m_bookmarkListView->GetLastSelectedItemIndex();
 
 		if (lastSelectedItemIndex)
@@ -672,6 +728,8 @@ void ManageBookmarksDialog::OnPaste()
 
 	if (focus == GetDlgItem(m_hDlg, IDC_MANAGEBOOKMARKS_LISTVIEW))
 	{
+		m_bookmarkListView->LeaveSearchResults();
+
 		auto lastSelectedItemindex = m_bookmarkListView->GetLastSelectedItemIndex();
 
 		if (lastSelectedItemindex)
@@ -733,9 +791,30 @@ void ManageBookmarksDialog::OnListViewNavigation(BookmarkItem *bookmarkFolder, b
 	m_currentBookmarkFolder = bookmarkFolder;
 	m_bookmarkTreeView->SelectFolder(bookmarkFolder->GetGUID());
 
+	// Navigating to a folder ends any search that was in progress. Clearing the text here won't
+	// result in a second navigation, since the listview is no longer showing search results.
+	if (GetWindowTextLength(m_searchField) > 0)
+	{
+		SetWindowText(m_searchField, EMPTY_STRING);
+	}
+
 	UpdateToolbarState();
 }
 
+void ManageBookmarksDialog::OnSearchTextChanged()
+{
+	std::wstring query = GetWindowString(m_searchField);
+
+	if (query.empty())
+	{
+		m_bookmarkListView->LeaveSearchResults();
+		return;
+	}
+
+	m_bookmarkListView->ShowSearchResults(
+		m_bookmarkSearchIndex->Search(query, MAX_SEARCH_RESULTS));
+}
+
 void ManageBookmarksDialog::UpdateToolbarState()
 {
 	SendMessage(m_hToolbar, TB_ENABLEBUTTON, TOOLBAR_ID_BACK, m_navigationController->CanGoBack());
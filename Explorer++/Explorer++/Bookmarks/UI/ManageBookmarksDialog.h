@@ -13,6 +13,7 @@
 #include <unordered_set>
 
 class BookmarkNavigationController;
+class BookmarkSearchIndex;
 class BookmarkTree;
 class BookmarkTreeView;
 class BrowserWindow;
@@ -50,7 +51,8 @@ class ManageBookmarksDialog : public ThemedDialog
 {
 public:
 	ManageBookmarksDialog(HINSTANCE resourceInstance, HWND hParent, BrowserWindow *browserWindow,
-		CoreInterface *coreInterface, IconFetcher *iconFetcher, BookmarkTree *bookmarkTree);
+		CoreInterface *coreInterface, IconFetcher *iconFetcher, BookmarkTree *bookmarkTree,
+		BookmarkSearchIndex *bookmarkSearchIndex);
 	~ManageBookmarksDialog();
 
 protected:
@@ -71,6 +73,11 @@ private:
 	static const int TOOLBAR_ID_ORGANIZE = 10002;
 	static const int TOOLBAR_ID_VIEWS = 10003;
 
+	static const int SEARCH_FIELD_ID = 10004;
+	static const int SEARCH_FIELD_WIDTH = 200;
+	static const int SEARCH_FIELD_SPACING = 6;
+	static const size_t MAX_SEARCH_RESULTS = 500;
+
 	ManageBookmarksDialog &operator=(const ManageBookmarksDialog &mbd);
 
 	void AddDynamicControls() override;
@@ -78,6 +85,8 @@ private:
 
 	void CreateToolbar();
 	void SetupToolbar();
+	void CreateSearchField();
+	void SetupSearchField();
 	void SetupTreeView();
 	void SetupListView();
 
@@ -85,6 +94,7 @@ private:
 
 	void OnTreeViewSelectionChanged(BookmarkItem *bookmarkFolder);
 	void OnListViewNavigation(BookmarkItem *bookmarkFolder, bool addHistoryEntry);
+	void OnSearchTextChanged();
 
 	void UpdateToolbarState();
 
@@ -116,11 +126,14 @@ private:
 	wil::unique_himagelist m_imageListToolbar;
 	IconImageListMapping m_imageListToolbarMappings;
 
+	HWND m_searchField;
+
 	BrowserWindow *m_browserWindow = nullptr;
 	CoreInterface *m_coreInterface = nullptr;
 	IconFetcher *m_iconFetcher = nullptr;
 
 	BookmarkTree *m_bookmarkTree = nullptr;
+	BookmarkSearchIndex *m_bookmarkSearchIndex = nullptr;
 
 	BookmarkItem *m_currentBookmarkFolder = nullptr;
 
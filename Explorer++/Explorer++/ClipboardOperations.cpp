@@ -9,8 +9,6 @@
 #include "PasteSymLinksServer.h"
 #include "../Helper/Clipboard.h"
 
-using namespace std::chrono_literals;
-
 namespace
 {
 
@@ -20,7 +18,7 @@ enum class LinkType
 	SymLink
 };
 
-void CreateSymLink(const std::filesystem::path &sourceFilePath,
+void CreateSymLinkAtPath(const std::filesystem::path &sourceFilePath,
 	const std::filesystem::path &destinationFilePath, std::error_code &error)
 {
 	bool isDirectory = std::filesystem::is_directory(sourceFilePath, error);
@@ -40,49 +38,48 @@ void CreateSymLink(const std::filesystem::path &sourceFilePath,
 	}
 }
 
-ClipboardOperations::PastedItems PasteLinksOfType(const std::wstring &destination,
-	LinkType linkType)
+ClipboardOperations::PastedItem CreateLink(const std::wstring &sourcePath,
+	const std::wstring &destination, LinkType linkType)
 {
-	Clipboard clipboard;
-	auto paths = clipboard.ReadHDropData();
+	std::filesystem::path sourceFilePath(sourcePath);
 
-	if (!paths)
-	{
-		return {};
-	}
+	std::filesystem::path destinationFilePath(destination);
+	destinationFilePath /= sourceFilePath.filename();
 
-	ClipboardOperations::PastedItems pastedItems;
+	std::error_code error;
 
-	for (const auto &path : *paths)
+	switch (linkType)
 	{
-		std::filesystem::path sourceFilePath(path);
-
-		std::filesystem::path destinationFilePath(destination);
-		destinationFilePath /= sourceFilePath.filename();
+	case LinkType::HardLink:
+		std::filesystem::create_hard_link(sourceFilePath, destinationFilePath, error);
+		break;
 
-		std::error_code error;
+	case LinkType::SymLink:
+		CreateSymLinkAtPath(sourceFilePath, destinationFilePath, error);
+		break;
 
-		switch (linkType)
-		{
-		case LinkType::HardLink:
-			std::filesystem::create_hard_link(sourceFilePath, destinationFilePath, error);
-			break;
+	default:
+		CHECK(false);
+	}
 
-		case LinkType::SymLink:
-			CreateSymLink(sourceFilePath, destinationFilePath, error);
-			break;
+	return { destinationFilePath, error };
+}
 
-		default:
-			CHECK(false);
-		}
+ClipboardOperations::PastedItems CreateLinks(const std::vector<std::wstring> &sourcePaths,
+	const std::wstring &destination, LinkType linkType)
+{
+	ClipboardOperations::PastedItems pastedItems;
 
-		pastedItems.emplace_back(destinationFilePath, error);
+	for (const auto &sourcePath : sourcePaths)
+	{
+		pastedItems.push_back(CreateLink(sourcePath, destination, linkType));
 	}
 
 	return pastedItems;
 }
 
-ClipboardOperations::PastedItems PasteSymLinksViaElevatedProcess(const std::wstring &destination)
+ClipboardOperations::PastedItems PasteSymLinksViaElevatedProcess(const std::wstring &destination,
+	const std::vector<std::wstring> &sourcePaths)
 {
 	auto clientLauncher = [&destination]
 	{
@@ -91,8 +88,11 @@ ClipboardOperations::PastedItems PasteSymLinksViaElevatedProcess(const std::wstr
 		return LaunchCurrentProcess(nullptr, parameters, LaunchCurrentProcessFlags::Elevated);
 	};
 
+	// The elevated process is sent the paths that were read from the clipboard here, rather than
+	// reading the clipboard itself, since the clipboard contents could change in the meantime.
 	PasteSymLinksServer server;
-	return server.LaunchClientAndWaitForResponse(clientLauncher, 10s);
+	return server.LaunchClientAndWaitForResponse(sourcePaths, clientLauncher,
+		PasteSymLinksServer::DEFAULT_TIMEOUT);
 }
 
 }
@@ -107,12 +107,28 @@ bool CanPasteLinkInDirectory(PCIDLIST_ABSOLUTE pidl)
 
 PastedItems PasteHardLinks(const std::wstring &destination)
 {
-	return PasteLinksOfType(destination, LinkType::HardLink);
+	Clipboard clipboard;
+	auto sourcePaths = clipboard.ReadHDropData();
+
+	if (!sourcePaths)
+	{
+		return {};
+	}
+
+	return CreateLinks(*sourcePaths, destination, LinkType::HardLink);
 }
 
 PastedItems PasteSymLinks(const std::wstring &destination)
 {
-	auto pastedItems = PasteLinksOfType(destination, LinkType::SymLink);
+	Clipboard clipboard;
+	auto sourcePaths = clipboard.ReadHDropData();
+
+	if (!sourcePaths)
+	{
+		return {};
+	}
+
+	auto pastedItems = CreateLinks(*sourcePaths, destination, LinkType::SymLink);
 
 	auto itr = std::find_if(pastedItems.begin(), pastedItems.end(),
 		[](const auto &pastedItem) {
@@ -133,7 +149,12 @@ PastedItems PasteSymLinks(const std::wstring &destination)
 	// If at least one symlink operation failed due to insufficient privileges, it's assumed they
 	// all failed for that reason. In which case, the operation needs to be retried in an elevated
 	// process.
-	return PasteSymLinksViaElevatedProcess(destination);
+	return PasteSymLinksViaElevatedProcess(destination, *sourcePaths);
+}
+
+PastedItem CreateSymLink(const std::wstring &sourcePath, const std::wstring &destination)
+{
+	return CreateLink(sourcePath, destination, LinkType::SymLink);
 }
 
 }
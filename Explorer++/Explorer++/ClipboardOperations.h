@@ -58,4 +58,8 @@ bool CanPasteLinkInDirectory(PCIDLIST_ABSOLUTE pidl);
 PastedItems PasteHardLinks(const std::wstring &destination);
 PastedItems PasteSymLinks(const std::wstring &destination);
 
+// Creates a symlink to the source item within the destination directory. This is used by the
+// elevated process that PasteSymLinks() falls back to when symlinks can't be created directly.
+PastedItem CreateSymLink(const std::wstring &sourcePath, const std::wstring &destination);
+
 }
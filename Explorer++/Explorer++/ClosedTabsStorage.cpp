@@ -0,0 +1,300 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "ClosedTabsStorage.h"
+#include "PreservedTab.h"
+#include "../Helper/PidlHelper.h"
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+#include <glog/logging.h>
+#include <fstream>
+#include <optional>
+#include <sstream>
+
+namespace
+{
+
+// This should be incremented whenever the format below changes. Files with a different version
+// will simply be ignored (and replaced the next time closed tabs are saved).
+constexpr uint32_t STORAGE_VERSION = 1;
+
+struct StoredHistoryEntry
+{
+	std::vector<BYTE> pidl;
+	std::wstring displayName;
+	std::wstring fullPathForDisplay;
+
+	template <class Archive>
+	void serialize(Archive &archive)
+	{
+		archive(pidl, displayName, fullPathForDisplay);
+	}
+};
+
+struct StoredFolderSettings
+{
+	int sortMode;
+	int groupMode;
+	int viewMode;
+	bool autoArrange;
+	int sortDirection;
+	int groupSortDirection;
+	bool showInGroups;
+	bool showHidden;
+	bool applyFilter;
+	bool filterCaseSensitive;
+	std::wstring filter;
+
+	template <class Archive>
+	void serialize(Archive &archive)
+	{
+		archive(sortMode, groupMode, viewMode, autoArrange, sortDirection, groupSortDirection,
+			showInGroups, showHidden, applyFilter, filterCaseSensitive, filter);
+	}
+};
+
+struct StoredTab
+{
+	int index;
+	std::vector<StoredHistoryEntry> history;
+	int currentEntry;
+	bool useCustomName;
+	std::wstring customName;
+	Tab::LockState lockState;
+	StoredFolderSettings folderSettings;
+
+	template <class Archive>
+	void serialize(Archive &archive)
+	{
+		archive(index, history, currentEntry, useCustomName, customName, lockState,
+			folderSettings);
+	}
+};
+
+StoredFolderSettings BuildStoredFolderSettings(const FolderSettings &folderSettings)
+{
+	return { folderSettings.sortMode._to_integral(), folderSettings.groupMode._to_integral(),
+		folderSettings.viewMode._to_integral(), folderSettings.autoArrange,
+		folderSettings.sortDirection._to_integral(),
+		folderSettings.groupSortDirection._to_integral(), folderSettings.showInGroups,
+		folderSettings.showHidden, folderSettings.applyFilter, folderSettings.filterCaseSensitive,
+		folderSettings.filter };
+}
+
+StoredTab BuildStoredTab(const PreservedTab &preservedTab)
+{
+	StoredTab storedTab = { preservedTab.index, {}, preservedTab.currentEntry,
+		preservedTab.useCustomName, preservedTab.customName, preservedTab.lockState,
+		BuildStoredFolderSettings(preservedTab.preservedFolderState.folderSettings) };
+
+	for (size_t i = 0; i < preservedTab.GetNumHistoryEntries(); i++)
+	{
+		const auto &entry = preservedTab.GetHistoryEntry(i);
+		auto pidl = preservedTab.GetHistoryEntryPidl(i);
+		auto *pidlData = reinterpret_cast<const BYTE *>(pidl.Raw());
+
+		// The system icon index isn't stored, since it's only valid within the current process.
+		storedTab.history.push_back({ { pidlData, pidlData + ILGetSize(pidl.Raw()) },
+			entry.displayName, entry.fullPathForDisplay });
+	}
+
+	return storedTab;
+}
+
+std::optional<FolderSettings> CreateFolderSettings(const StoredFolderSettings &storedSettings)
+{
+	auto sortMode = SortMode::_from_integral_nothrow(storedSettings.sortMode);
+	auto groupMode = SortMode::_from_integral_nothrow(storedSettings.groupMode);
+	auto viewMode = ViewMode::_from_integral_nothrow(storedSettings.viewMode);
+	auto sortDirection = SortDirection::_from_integral_nothrow(storedSettings.sortDirection);
+	auto groupSortDirection =
+		SortDirection::_from_integral_nothrow(storedSettings.groupSortDirection);
+
+	if (!sortMode || !groupMode || !viewMode || !sortDirection || !groupSortDirection)
+	{
+		return std::nullopt;
+	}
+
+	FolderSettings folderSettings;
+	folderSettings.sortMode = *sortMode;
+	folderSettings.groupMode = *groupMode;
+	folderSettings.viewMode = *viewMode;
+	folderSettings.autoArrange = storedSettings.autoArrange;
+	folderSettings.sortDirection = *sortDirection;
+	folderSettings.groupSortDirection = *groupSortDirection;
+	folderSettings.showInGroups = storedSettings.showInGroups;
+	folderSettings.showHidden = storedSettings.showHidden;
+	folderSettings.applyFilter = storedSettings.applyFilter;
+	folderSettings.filterCaseSensitive = storedSettings.filterCaseSensitive;
+	folderSettings.filter = storedSettings.filter;
+	return folderSettings;
+}
+
+std::unique_ptr<PreservedTab> CreatePreservedTab(const StoredTab &storedTab)
+{
+	if (storedTab.history.empty() || storedTab.currentEntry < 0
+		|| static_cast<size_t>(storedTab.currentEntry) >= storedTab.history.size())
+	{
+		return nullptr;
+	}
+
+	if (storedTab.lockState != Tab::LockState::NotLocked
+		&& storedTab.lockState != Tab::LockState::Locked
+		&& storedTab.lockState != Tab::LockState::AddressLocked)
+	{
+		return nullptr;
+	}
+
+	auto folderSettings = CreateFolderSettings(storedTab.folderSettings);
+
+	if (!folderSettings)
+	{
+		return nullptr;
+	}
+
+	// The ID is assigned when the tab is added to the TabRestorer.
+	auto preservedTab = std::make_unique<PreservedTab>(0, storedTab.index, *folderSettings);
+	preservedTab->currentEntry = storedTab.currentEntry;
+	preservedTab->useCustomName = storedTab.useCustomName;
+	preservedTab->customName = storedTab.customName;
+	preservedTab->lockState = storedTab.lockState;
+
+	for (const auto &entry : storedTab.history)
+	{
+		if (!IsValidPidlData(entry.pidl))
+		{
+			return nullptr;
+		}
+
+		preservedTab->AddHistoryEntry(reinterpret_cast<PCIDLIST_ABSOLUTE>(entry.pidl.data()),
+			entry.displayName, entry.fullPathForDisplay, std::nullopt);
+	}
+
+	return preservedTab;
+}
+
+}
+
+namespace ClosedTabsStorage
+{
+
+std::vector<std::unique_ptr<PreservedTab>> Load(const std::filesystem::path &path)
+{
+	std::string data;
+
+	{
+		// The entire file is read in a single call and then deserialized from memory.
+		std::ifstream inputStream(path, std::ios::binary | std::ios::ate);
+
+		if (!inputStream)
+		{
+			return {};
+		}
+
+		data.resize(static_cast<size_t>(inputStream.tellg()));
+		inputStream.seekg(0);
+		inputStream.read(data.data(), data.size());
+
+		if (!inputStream)
+		{
+			return {};
+		}
+	}
+
+	std::vector<StoredTab> storedTabs;
+
+	try
+	{
+		std::istringstream stringstream(std::move(data));
+		cereal::BinaryInputArchive inputArchive(stringstream);
+
+		uint32_t version;
+		inputArchive(version);
+
+		if (version != STORAGE_VERSION)
+		{
+			return {};
+		}
+
+		inputArchive(storedTabs);
+	}
+	catch (const std::exception &e)
+	{
+		// A corrupted length field can also result in std::length_error or std::bad_alloc being
+		// thrown, when a container is resized.
+		LOG(WARNING) << "Closed tabs could not be read: " << e.what();
+		return {};
+	}
+
+	std::vector<std::unique_ptr<PreservedTab>> closedTabs;
+
+	for (const auto &storedTab : storedTabs)
+	{
+		auto preservedTab = CreatePreservedTab(storedTab);
+
+		if (!preservedTab)
+		{
+			continue;
+		}
+
+		closedTabs.push_back(std::move(preservedTab));
+	}
+
+	return closedTabs;
+}
+
+bool Save(const std::filesystem::path &path, const TabRestorer::ClosedTabs &closedTabs)
+{
+	std::vector<StoredTab> storedTabs;
+	storedTabs.reserve(closedTabs.size());
+
+	for (const auto &closedTab : closedTabs)
+	{
+		storedTabs.push_back(BuildStoredTab(*closedTab));
+	}
+
+	std::ostringstream stringstream;
+
+	{
+		cereal::BinaryOutputArchive outputArchive(stringstream);
+		outputArchive(STORAGE_VERSION, storedTabs);
+	}
+
+	// The file is written to a temporary location first, so that an existing file is never left
+	// partially written.
+	auto temporaryPath = path;
+	temporaryPath += L".tmp";
+
+	{
+		std::ofstream outputStream(temporaryPath, std::ios::binary | std::ios::trunc);
+
+		if (!outputStream)
+		{
+			return false;
+		}
+
+		auto data = stringstream.str();
+		outputStream.write(data.data(), data.size());
+
+		if (!outputStream)
+		{
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporaryPath, path, error);
+
+	if (error)
+	{
+		std::filesystem::remove(temporaryPath, error);
+		return false;
+	}
+
+	return true;
+}
+
+}
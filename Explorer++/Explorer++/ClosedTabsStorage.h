@@ -0,0 +1,23 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "TabRestorer.h"
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+// Allows recently closed tabs to be saved to a binary file, so that they can still be restored
+// after the application is restarted.
+namespace ClosedTabsStorage
+{
+
+// Returns the tabs stored in the file, ordered from most to least recently closed. If the file is
+// missing or invalid, no tabs will be returned. Individual tabs that are invalid will be skipped.
+std::vector<std::unique_ptr<PreservedTab>> Load(const std::filesystem::path &path);
+
+bool Save(const std::filesystem::path &path, const TabRestorer::ClosedTabs &closedTabs);
+
+}
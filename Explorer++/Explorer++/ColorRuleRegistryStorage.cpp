@@ -135,7 +135,7 @@ void Load(const std::wstring &mainKeyPath, ColorRuleModel *model)
 	}
 }
 
-void Save(const std::wstring &mainKeyPath, const ColorRuleModel *model)
+bool Save(const std::wstring &mainKeyPath, const ColorRuleModel *model)
 {
 	std::wstring fullKeyPath = mainKeyPath + L"\\" + COLOR_RULES_KEY_PATH;
 	SHDeleteKey(HKEY_CURRENT_USER, fullKeyPath.c_str());
@@ -144,10 +144,14 @@ void Save(const std::wstring &mainKeyPath, const ColorRuleModel *model)
 	LSTATUS res = RegCreateKeyEx(HKEY_CURRENT_USER, fullKeyPath.c_str(), 0, nullptr,
 		REG_OPTION_NON_VOLATILE, KEY_WRITE, nullptr, &colorRulesKey, nullptr);
 
-	if (res == ERROR_SUCCESS)
+	if (res != ERROR_SUCCESS)
 	{
-		SaveToKey(colorRulesKey.get(), model);
+		return false;
 	}
+
+	SaveToKey(colorRulesKey.get(), model);
+
+	return true;
 }
 
 }
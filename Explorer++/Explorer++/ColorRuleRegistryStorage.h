@@ -12,6 +12,6 @@ namespace ColorRuleRegistryStorage
 {
 
 void Load(const std::wstring &mainKeyPath, ColorRuleModel *model);
-void Save(const std::wstring &mainKeyPath, const ColorRuleModel *model);
+bool Save(const std::wstring &mainKeyPath, const ColorRuleModel *model);
 
 }
@@ -207,11 +207,12 @@ std::optional<CommandLine::ExitInfo> ProcessCommandLineFlags(const CLI::App &app
 
 	if (app.count(wstrToUtf8Str(CommandLine::PASTE_SYMLINKS_ARGUMENT)) > 0)
 	{
-		auto pastedItems =
-			ClipboardOperations::PasteSymLinks(immediatelyHandledOptions.pasteSymLinksDestination);
+		const auto &destination = immediatelyHandledOptions.pasteSymLinksDestination;
 
 		PasteSymLinksClient client;
-		client.NotifyServerOfResult(pastedItems);
+		client.CreateLinksAndNotifyServer([&destination](const std::wstring &sourcePath)
+			{ return ClipboardOperations::CreateSymLink(sourcePath, destination); },
+			PasteSymLinksClient::DEFAULT_TIMEOUT);
 
 		return CommandLine::ExitInfo{ EXIT_CODE_NORMAL };
 	}
@@ -15,6 +15,7 @@
 #include "../Helper/SetDefaultFileManager.h"
 #include "../Helper/ShellHelper.h"
 #include "../Helper/StringHelper.h"
+#include <chrono>
 #include <optional>
 
 // clang-format off
@@ -105,6 +106,15 @@ struct Config
 	ValueWrapper<BOOL> extendTabControl = FALSE;
 	bool openTabsInForeground = false;
 
+	// Tab hibernation
+	bool hibernateInactiveTabs = true;
+	std::chrono::minutes tabHibernationTimeout = std::chrono::minutes(30);
+
+	// Once the estimated amount of memory used by all background tabs exceeds this value (in
+	// megabytes), the least recently used tabs will be hibernated, regardless of the timeout above.
+	// A value of 0 disables this limit.
+	int tabHibernationMemoryBudgetMB = 512;
+
 	// Treeview
 	bool checkPinnedToNamespaceTreeProperty = false;
 	ValueWrapper<bool> showQuickAccessInTreeView = true;
@@ -60,6 +60,12 @@ class ShellBrowserImpl;
 class StatusBar;
 class TabContainer;
 class TabRestorer;
+class TaskScheduler;
+
+namespace Plugins
+{
+class PluginColumnManager;
+}
 
 /* Basic interface between Explorerplusplus
 and some of the other components (such as the
@@ -83,6 +89,8 @@ public:
 
 	virtual IconResourceLoader *GetIconResourceLoader() const = 0;
 	virtual CachedIcons *GetCachedIcons() = 0;
+	virtual TaskScheduler *GetTaskScheduler() = 0;
+	virtual Plugins::PluginColumnManager *GetPluginColumnManager() = 0;
 
 	virtual HWND GetTreeView() const = 0;
 
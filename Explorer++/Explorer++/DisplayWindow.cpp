@@ -14,6 +14,8 @@
 #include "../Helper/Macros.h"
 #include "../Helper/ShellHelper.h"
 
+static const int FOLDER_SIZE_LINE_INDEX = 1;
+
 void Explorerplusplus::UpdateDisplayWindow(const Tab &tab)
 {
 	DisplayWindow_ClearTextBuffer(m_hDisplayWindow);
@@ -121,56 +123,28 @@ void Explorerplusplus::UpdateDisplayWindowForOneFile(const Tab &tab)
 			if (((dwAttributes & FILE_ATTRIBUTE_DIRECTORY) == FILE_ATTRIBUTE_DIRECTORY)
 				&& m_config->globalFolderSettings.showFolderSizes)
 			{
-				FolderSize_t *pfs = nullptr;
-				FolderSizeExtraInfo *pfsei = nullptr;
-				DWFolderSize displayWindowFolderSize;
 				TCHAR szDisplayText[256];
 				TCHAR szTotalSize[64];
 				TCHAR szCalculating[64];
-				DWORD threadId;
-
-				pfs = (FolderSize_t *) malloc(sizeof(FolderSize_t));
 
-				if (pfs != nullptr)
-				{
-					pfsei = (FolderSizeExtraInfo *) malloc(sizeof(FolderSizeExtraInfo));
-
-					if (pfsei != nullptr)
-					{
-						pfsei->pContainer = (void *) this;
-						pfsei->uId = m_iDWFolderSizeUniqueId;
-						pfs->pData = (LPVOID) pfsei;
-
-						pfs->pfnCallback = FolderSizeCallbackStub;
-
-						StringCchCopy(pfs->szPath, SIZEOF_ARRAY(pfs->szPath), fullItemName.c_str());
-
-						LoadString(m_resourceInstance, IDS_GENERAL_TOTALSIZE, szTotalSize,
-							SIZEOF_ARRAY(szTotalSize));
-						LoadString(m_resourceInstance, IDS_GENERAL_CALCULATING, szCalculating,
-							SIZEOF_ARRAY(szCalculating));
-						StringCchPrintf(szDisplayText, SIZEOF_ARRAY(szDisplayText), _T("%s: %s"),
-							szTotalSize, szCalculating);
-						DisplayWindow_BufferText(m_hDisplayWindow, szDisplayText);
-
-						/* Maintain a global list of folder size operations. */
-						displayWindowFolderSize.uId = m_iDWFolderSizeUniqueId;
-						displayWindowFolderSize.iTabId =
-							GetActivePane()->GetTabContainer()->GetSelectedTab().GetId();
-						displayWindowFolderSize.bValid = TRUE;
-						m_DWFolderSizes.push_back(displayWindowFolderSize);
-
-						HANDLE hThread = CreateThread(nullptr, 0, Thread_CalculateFolderSize,
-							(LPVOID) pfs, 0, &threadId);
-						CloseHandle(hThread);
-
-						m_iDWFolderSizeUniqueId++;
-					}
-					else
-					{
-						free(pfs);
-					}
-				}
+				LoadString(m_resourceInstance, IDS_GENERAL_TOTALSIZE, szTotalSize,
+					SIZEOF_ARRAY(szTotalSize));
+				LoadString(m_resourceInstance, IDS_GENERAL_CALCULATING, szCalculating,
+					SIZEOF_ARRAY(szCalculating));
+				StringCchPrintf(szDisplayText, SIZEOF_ARRAY(szDisplayText), _T("%s: %s"),
+					szTotalSize, szCalculating);
+				DisplayWindow_BufferText(m_hDisplayWindow, szDisplayText);
+
+				int tabId = tab.GetId();
+				int requestId = m_folderSizeCalculator.Calculate(fullItemName,
+					std::bind_front(&Explorerplusplus::OnDisplayWindowFolderSizeProgress, this,
+						tabId));
+
+				// Any previous request is no longer needed. Note that the previous request is
+				// only cancelled once the new request has been made. That way, if both requests
+				// are for the same folder, the existing calculation will simply continue.
+				CancelDisplayWindowFolderSizeRequest();
+				m_displayWindowFolderSizeRequest = { requestId, tabId };
 			}
 			else
 			{
@@ -389,3 +363,59 @@ void Explorerplusplus::UpdateDisplayWindowForMultipleFiles(const Tab &tab)
 
 	DisplayWindow_BufferText(m_hDisplayWindow, szTotalSize);
 }
+
+void Explorerplusplus::CancelDisplayWindowFolderSizeRequest()
+{
+	if (!m_displayWindowFolderSizeRequest)
+	{
+		return;
+	}
+
+	m_folderSizeCalculator.Cancel(m_displayWindowFolderSizeRequest->requestId);
+	m_displayWindowFolderSizeRequest.reset();
+}
+
+void Explorerplusplus::OnDisplayWindowFolderSizeProgress(int tabId, const FolderInfo &folderInfo,
+	bool complete)
+{
+	if (complete)
+	{
+		m_displayWindowFolderSizeRequest.reset();
+	}
+
+	// The result is only shown if the calculation was for the current tab. If the selection in
+	// that tab had changed, the request would have been cancelled.
+	if (tabId != GetActivePane()->GetTabContainer()->GetSelectedTab().GetId())
+	{
+		return;
+	}
+
+	auto displayFormat = m_config->globalFolderSettings.forceSize
+		? m_config->globalFolderSettings.sizeDisplayFormat
+		: +SizeDisplayFormat::None;
+	auto folderSizeText = FormatSizeString(folderInfo.size, displayFormat);
+
+	TCHAR szTotalSize[64];
+	LoadString(m_resourceInstance, IDS_GENERAL_TOTALSIZE, szTotalSize, SIZEOF_ARRAY(szTotalSize));
+
+	TCHAR szSizeString[128];
+
+	if (complete)
+	{
+		StringCchPrintf(szSizeString, SIZEOF_ARRAY(szSizeString), _T("%s: %s"), szTotalSize,
+			folderSizeText.c_str());
+	}
+	else
+	{
+		// While the calculation is still running, the running total is shown.
+		TCHAR szCalculating[64];
+		LoadString(m_resourceInstance, IDS_GENERAL_CALCULATING, szCalculating,
+			SIZEOF_ARRAY(szCalculating));
+
+		StringCchPrintf(szSizeString, SIZEOF_ARRAY(szSizeString), _T("%s: %s (%s)"), szTotalSize,
+			folderSizeText.c_str(), szCalculating);
+	}
+
+	/* TODO: The line index should be stored in some other (variable) way. */
+	DisplayWindow_SetLine(m_hDisplayWindow, FOLDER_SIZE_LINE_INDEX, szSizeString);
+}
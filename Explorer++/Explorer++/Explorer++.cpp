@@ -10,6 +10,7 @@
 #include "Config.h"
 #include "Explorer++_internal.h"
 #include "FeatureList.h"
+#include "FrequentLocationsServiceFactory.h"
 #include "GlobalHistoryMenu.h"
 #include "HistoryServiceFactory.h"
 #include "MainFontSetter.h"
@@ -24,6 +25,7 @@
 #include "TabStorage.h"
 #include "ThemeWindowTracker.h"
 #include "UiTheming.h"
+#include "../Helper/PerformanceTracer.h"
 #include "../Helper/WindowSubclassWrapper.h"
 #include "../Helper/iDirectoryMonitor.h"
 
@@ -33,11 +35,15 @@ Explorerplusplus::Explorerplusplus(HWND hwnd, InitializationData *initialization
 	m_acceleratorManager(initializationData->acceleratorManager),
 	m_commandController(this),
 	m_cachedIcons(MAX_CACHED_ICONS),
+	m_pluginEventDispatcher(std::bind_front(&Explorerplusplus::SchedulePluginEventDelivery, this),
+		&m_pluginProfiler),
 	m_pluginMenuManager(hwnd, MENU_PLUGIN_START_ID, MENU_PLUGIN_END_ID),
 	m_acceleratorUpdater(initializationData->acceleratorManager),
 	m_pluginCommandManager(initializationData->acceleratorManager, ACCELERATOR_PLUGIN_START_ID,
 		ACCELERATOR_PLUGIN_END_ID),
-	m_iconFetcher(hwnd, &m_cachedIcons),
+	m_iconFetcher(hwnd, &m_cachedIcons, &m_taskScheduler),
+	m_shellItemDetailsFetcher(&m_taskScheduler),
+	m_folderSizeCalculator(&m_taskScheduler),
 	m_tabBarBackgroundBrush(CreateSolidBrush(TAB_BAR_DARK_MODE_BACKGROUND_COLOR))
 {
 	m_resourceInstance = nullptr;
@@ -45,6 +51,11 @@ Explorerplusplus::Explorerplusplus(HWND hwnd, InitializationData *initialization
 	m_config = std::make_shared<Config>();
 	FeatureList::GetInstance()->InitializeFromCommandLine(*initializationData->commandLineSettings);
 
+	if (FeatureList::GetInstance()->IsEnabled(Feature::PerformanceTracing))
+	{
+		PerformanceTracer::GetInstance().SetEnabled(true);
+	}
+
 	m_bSavePreferencesToXMLFile = FALSE;
 	m_bLanguageLoaded = false;
 	m_bShowTabBar = true;
@@ -56,8 +67,6 @@ Explorerplusplus::Explorerplusplus(HWND hwnd, InitializationData *initialization
 	m_hDisplayWindow = nullptr;
 	m_lastActiveWindow = nullptr;
 	m_hActiveListView = nullptr;
-
-	m_iDWFolderSizeUniqueId = 0;
 }
 
 Explorerplusplus::~Explorerplusplus()
@@ -83,5 +92,6 @@ ShellBrowser *Explorerplusplus::GetActiveShellBrowser()
 void Explorerplusplus::OnShellBrowserCreated(ShellBrowser *shellBrowser)
 {
 	ShellBrowserHistoryHelper::CreateAndAttachToShellBrowser(shellBrowser,
-		HistoryServiceFactory::GetInstance()->GetHistoryService());
+		HistoryServiceFactory::GetInstance()->GetHistoryService(),
+		FrequentLocationsServiceFactory::GetInstance()->GetFrequentLocationsService());
 }
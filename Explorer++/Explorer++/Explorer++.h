@@ -10,15 +10,20 @@
 #include "BrowserWindow.h"
 #include "CommandLine.h"
 #include "CoreInterface.h"
+#include "FolderSizeCalculator.h"
 #include "IconFetcherImpl.h"
 #include "Literals.h"
 #include "MainToolbarStorage.h"
 #include "PluginInterface.h"
+#include "Plugins/PluginColumnManager.h"
 #include "Plugins/PluginCommandManager.h"
+#include "Plugins/PluginEventDispatcher.h"
 #include "Plugins/PluginMenuManager.h"
+#include "Plugins/PluginProfiler.h"
 #include "ShellBrowser/Columns.h"
 #include "ShellBrowser/ShellBrowserEmbedder.h"
 #include "ShellBrowser/SortModes.h"
+#include "ShellItemDetailsFetcherImpl.h"
 #include "Tab.h"
 #include "TabNavigationInterface.h"
 #include "ValueWrapper.h"
@@ -27,13 +32,12 @@
 #include "../Helper/DropHandler.h"
 #include "../Helper/FileActionHandler.h"
 #include "../Helper/ShellContextMenu.h"
+#include "../Helper/TaskScheduler.h"
 #include <boost/signals2.hpp>
 #include <wil/resource.h>
+#include <filesystem>
 #include <optional>
 
-/* Sent when a folder size calculation has finished. */
-#define WM_APP_FOLDERSIZECOMPLETED WM_APP + 3
-
 // Forward declarations.
 class AcceleratorManager;
 class AddressBar;
@@ -55,8 +59,10 @@ class MainWindow;
 struct NavigateParams;
 struct RebarBandStorageInfo;
 class ShellBrowserImpl;
+class SettingsChangeTracker;
 class ShellTreeView;
 class TabContainer;
+class TabHibernationManager;
 class TabRestorer;
 class TabRestorerMenu;
 struct TabSettings;
@@ -116,6 +122,7 @@ public:
 
 private:
 	static constexpr UINT WM_APP_CLOSE = WM_APP + 1;
+	static constexpr UINT WM_APP_DELIVER_PLUGIN_EVENTS = WM_APP + 2;
 
 	static const int OPEN_IN_NEW_TAB_MENU_ITEM_ID = ShellContextMenu::MAX_SHELL_MENU_ID + 1;
 
@@ -139,6 +146,19 @@ private:
 	static const UINT_PTR LISTVIEW_ITEM_CHANGED_TIMER_ID = 100001;
 	static const UINT LISTVIEW_ITEM_CHANGED_TIMEOUT = 50;
 
+	static const UINT_PTR TAB_HIBERNATION_TIMER_ID = 100002;
+
+	// When a bookmark, color rule or application is changed, settings will be saved after this
+	// delay. That way, the change is persisted shortly after it's made, rather than only at the
+	// next autosave, while a burst of changes only results in a single save.
+	static const UINT_PTR SETTINGS_CHANGED_TIMER_ID = 100003;
+	static const UINT SETTINGS_CHANGED_SAVE_DELAY = 2000;
+
+	// Used to deliver plugin events that were deferred because a plugin exceeded its time budget.
+	// Timer messages are only generated once there are no other messages waiting, so the deferred
+	// events won't hold up input or painting.
+	static const UINT_PTR PLUGIN_EVENTS_TIMER_ID = 100004;
+
 	// Represents the maximum number of icons that can be cached. This cache is
 	// shared between various components in the application.
 	static const int MAX_CACHED_ICONS = 1000;
@@ -155,24 +175,10 @@ private:
 		void *pData;
 	};
 
-	struct DWFolderSizeCompletion
-	{
-		ULARGE_INTEGER liFolderSize;
-		int uId;
-		int iTabId;
-	};
-
-	struct DWFolderSize
+	struct DisplayWindowFolderSizeRequest
 	{
-		int uId;
-		int iTabId;
-		BOOL bValid;
-	};
-
-	struct FolderSizeExtraInfo
-	{
-		void *pContainer;
-		int uId;
+		int requestId;
+		int tabId;
 	};
 
 	struct InternalRebarBandInfo
@@ -261,6 +267,8 @@ private:
 	void OnSearch();
 	void OnCustomizeColors();
 	void OnRunScript();
+	void OnShowPerformanceTrace();
+	void OnShowPluginDiagnostics();
 	void OnShowOptions();
 	void OnSearchTabs();
 	void OnOpenOnlineDocumentation();
@@ -308,6 +316,8 @@ private:
 	HRESULT CreateInitialTabs();
 	void RestorePreviousTabs();
 	void CreateCommandLineTabs();
+	void LoadClosedTabs();
+	void SaveClosedTabs();
 	void OnTabListViewSelectionChanged(const Tab &tab);
 
 	/* TabNavigationInterface methods. */
@@ -326,9 +336,12 @@ private:
 	UiTheming *GetUiTheming() override;
 	AcceleratorUpdater *GetAccleratorUpdater() override;
 	Plugins::PluginCommandManager *GetPluginCommandManager() override;
+	Plugins::PluginEventDispatcher *GetPluginEventDispatcher() override;
+	Plugins::PluginProfiler *GetPluginProfiler() override;
 
 	/* Plugins. */
 	void InitializePlugins();
+	void SchedulePluginEventDelivery(Plugins::PluginEventDispatcher::DeliveryTiming timing);
 
 	/* Menus. */
 	void SetProgramMenuItemStates(HMENU hProgramMenu);
@@ -374,6 +387,10 @@ private:
 	void ValidateLoadedSettings();
 	void ApplyDisplayWindowPosition();
 	void TestConfigFile();
+	void InitializeHistoryJournal();
+	void InitializeFrequentLocationsJournal();
+	void OnSettingsChanged();
+	std::optional<std::filesystem::path> GetDataFilePath(const std::wstring &fileName) const;
 
 	/* Registry settings. */
 	LONG LoadGenericSettingsFromRegistry();
@@ -484,6 +501,8 @@ private:
 	void UpdateDisplayWindowForZeroFiles(const Tab &tab);
 	void UpdateDisplayWindowForOneFile(const Tab &tab);
 	void UpdateDisplayWindowForMultipleFiles(const Tab &tab);
+	void CancelDisplayWindowFolderSizeRequest();
+	void OnDisplayWindowFolderSizeProgress(int tabId, const FolderInfo &folderInfo, bool complete);
 
 	/* Columns. */
 	void CopyColumnInfoToClipboard();
@@ -500,6 +519,8 @@ private:
 	IDirectoryMonitor *GetDirectoryMonitor() const override;
 	IconResourceLoader *GetIconResourceLoader() const override;
 	CachedIcons *GetCachedIcons() override;
+	TaskScheduler *GetTaskScheduler() override;
+	Plugins::PluginColumnManager *GetPluginColumnManager() override;
 	BOOL GetSavePreferencesToXmlFile() const override;
 	void SetSavePreferencesToXmlFile(BOOL savePreferencesToXmlFile) override;
 	void FocusChanged() override;
@@ -551,11 +572,6 @@ private:
 	void StopDirectoryMonitoringForTab(const Tab &tab);
 	int DetermineListViewObjectIndex(HWND hListView);
 
-	static void FolderSizeCallbackStub(int nFolders, int nFiles, PULARGE_INTEGER lTotalFolderSize,
-		LPVOID pData);
-	void FolderSizeCallback(FolderSizeExtraInfo *pfsei, int nFolders, int nFiles,
-		PULARGE_INTEGER lTotalFolderSize);
-
 	const CommandLine::Settings *const m_commandLineSettings;
 	AcceleratorManager *const m_acceleratorManager;
 
@@ -591,6 +607,10 @@ private:
 
 	std::unique_ptr<IconResourceLoader> m_iconResourceLoader;
 
+	// Runs the background work for the whole application. This needs to be declared before any of
+	// the members that queue work on it, so that it's destroyed after them.
+	TaskScheduler m_taskScheduler;
+
 	CachedIcons m_cachedIcons;
 
 	wil::com_ptr_nothrow<IImageList> m_mainMenuSystemImageList;
@@ -620,6 +640,7 @@ private:
 	std::unique_ptr<TabRestorer> m_tabRestorer;
 	std::unique_ptr<MainMenuSubMenuView> m_tabRestorerMenuView;
 	std::unique_ptr<TabRestorerMenu> m_tabRestorerMenu;
+	std::unique_ptr<TabHibernationManager> m_tabHibernationManager;
 	TabsInitializedSignal m_tabsInitializedSignal;
 
 	ToolbarContextMenuSignal m_toolbarContextMenuSignal;
@@ -630,6 +651,11 @@ private:
 	std::unique_ptr<UiTheming> m_uiTheming;
 
 	/* Plugins. */
+	// Plugins remove their columns and any pending event calls when they're unloaded, so these
+	// need to be declared before the plugin manager.
+	Plugins::PluginProfiler m_pluginProfiler;
+	Plugins::PluginEventDispatcher m_pluginEventDispatcher;
+	Plugins::PluginColumnManager m_pluginColumnManager;
 	std::unique_ptr<Plugins::PluginManager> m_pluginManager;
 	Plugins::PluginMenuManager m_pluginMenuManager;
 	AcceleratorUpdater m_acceleratorUpdater;
@@ -641,6 +667,7 @@ private:
 	/* User options variables. */
 	std::shared_ptr<Config> m_config;
 	BOOL m_bSavePreferencesToXMLFile;
+	std::unique_ptr<SettingsChangeTracker> m_settingsChangeTracker;
 
 	bool m_themeValueLoadedFromXml = false;
 	bool m_groupSortDirectionGlobalLoadedFromXml = false;
@@ -672,6 +699,9 @@ private:
 	// ultimately used to retrieve the icons).
 	IconFetcherImpl m_iconFetcher;
 
+	// Retrieves the names of the items shown in the history and parent items menus.
+	ShellItemDetailsFetcherImpl m_shellItemDetailsFetcher;
+
 	/* Undo support. */
 	FileActionHandler m_FileActionHandler;
 
@@ -685,8 +715,8 @@ private:
 	Applications::ApplicationToolbar *m_applicationToolbar = nullptr;
 
 	/* Display window folder sizes. */
-	std::list<DWFolderSize> m_DWFolderSizes;
-	int m_iDWFolderSizeUniqueId;
+	FolderSizeCalculator m_folderSizeCalculator;
+	std::optional<DisplayWindowFolderSizeRequest> m_displayWindowFolderSizeRequest;
 
 	// WM_DEVICECHANGE notifications
 	DeviceChangeSignal m_deviceChangeSignal;
@@ -21,6 +21,19 @@ const TCHAR REG_SETTINGS_KEY[] = _T("Software\\Explorer++\\Settings");
 saved to/loaded from. */
 const TCHAR XML_FILENAME[] = _T("config.xml");
 
+// The name of the file that global history is stored in.
+const TCHAR HISTORY_JOURNAL_FILENAME[] = _T("history.dat");
+
+// The name of the file that frequently visited locations are stored in.
+const TCHAR FREQUENT_LOCATIONS_JOURNAL_FILENAME[] = _T("frequentlocations.dat");
+
+// The name of the file that recently closed tabs are stored in.
+const TCHAR CLOSED_TABS_FILENAME[] = _T("closedtabs.dat");
+
+// When settings are saved to the config file, a binary copy of the bookmarks is also saved to this
+// file, since it can be loaded much more quickly.
+const TCHAR BOOKMARKS_SNAPSHOT_FILENAME[] = _T("bookmarks.dat");
+
 const TCHAR LANGUAGE_DLL_FILENAME_PATTERN[] = _T("Explorer++*.dll");
 
 // The first instance of the application will create a mutex with this name, which later instances
@@ -12,6 +12,10 @@ BETTER_ENUM(Feature, int,
 	Plugins,
 
 	// When enabled, the quick access folder in the treeview will be automatically updated.
-	AutomaticQuickAccessUpdates
+	AutomaticQuickAccessUpdates,
+
+	// When enabled, spans and counters from various parts of the application will be recorded.
+	// The results can be viewed and exported via Tools > Performance Trace.
+	PerformanceTracing
 )
 // clang-format on
@@ -0,0 +1,209 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "FolderSizeCalculator.h"
+#include "../Helper/PerformanceTracer.h"
+#include "../Helper/WindowSubclassWrapper.h"
+#include <glog/logging.h>
+#include <algorithm>
+
+namespace
+{
+
+HWND CreateMessageWindow()
+{
+	HWND messageWindow = CreateWindow(WC_STATIC, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, nullptr,
+		GetModuleHandle(nullptr), nullptr);
+	CHECK(messageWindow);
+	return messageWindow;
+}
+
+}
+
+FolderSizeCalculator::FolderSizeCalculator(TaskScheduler *taskScheduler) :
+	m_messageWindow(CreateMessageWindow()),
+	m_taskQueue(taskScheduler, TaskPriority::Normal, MAX_CONCURRENT_CALCULATIONS)
+{
+	m_windowSubclasses.push_back(std::make_unique<WindowSubclassWrapper>(m_messageWindow.get(),
+		std::bind_front(&FolderSizeCalculator::WindowSubclass, this)));
+}
+
+FolderSizeCalculator::~FolderSizeCalculator()
+{
+	// Any calculations that are still running will see that they've been cancelled and stop at the
+	// next opportunity, which means that destroying the task queue won't be blocked waiting for
+	// them for long.
+	m_taskQueue.CancelPendingTasks();
+}
+
+LRESULT FolderSizeCalculator::WindowSubclass(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
+{
+	switch (msg)
+	{
+	case WM_APP_FOLDER_SIZE_PROGRESS:
+		OnProgress(static_cast<int>(wParam));
+		return 0;
+	}
+
+	return DefSubclassProc(hwnd, msg, wParam, lParam);
+}
+
+int FolderSizeCalculator::Calculate(const std::wstring &path, Callback callback)
+{
+	int requestId = m_requestIdCounter++;
+
+	auto itr = std::find_if(m_calculations.begin(), m_calculations.end(),
+		[&path](const auto &entry) { return entry.second.path == path; });
+
+	if (itr != m_calculations.end())
+	{
+		itr->second.requests.emplace(requestId, std::move(callback));
+		m_requestCalculations.emplace(requestId, itr->first);
+		return requestId;
+	}
+
+	int calculationId = m_calculationIdCounter++;
+
+	Calculation calculation;
+	calculation.path = path;
+	calculation.state = std::make_shared<CalculationState>();
+	calculation.requests.emplace(requestId, std::move(callback));
+
+	m_taskQueue.Post(
+		[messageWindow = m_messageWindow.get(), calculationId, path,
+			state = calculation.state](const CancellationToken &cancellationToken)
+		{ CalculateFolderSize(messageWindow, calculationId, path, state, cancellationToken); });
+
+	m_calculations.emplace(calculationId, std::move(calculation));
+	m_requestCalculations.emplace(requestId, calculationId);
+
+	return requestId;
+}
+
+void FolderSizeCalculator::Cancel(int requestId)
+{
+	auto requestItr = m_requestCalculations.find(requestId);
+
+	if (requestItr == m_requestCalculations.end())
+	{
+		return;
+	}
+
+	auto calculationItr = m_calculations.find(requestItr->second);
+	CHECK(calculationItr != m_calculations.end());
+
+	auto &calculation = calculationItr->second;
+	calculation.requests.erase(requestId);
+	m_requestCalculations.erase(requestItr);
+
+	if (calculation.requests.empty())
+	{
+		calculation.state->cancellationToken.Cancel();
+		m_calculations.erase(calculationItr);
+	}
+}
+
+void FolderSizeCalculator::CalculateFolderSize(HWND messageWindow, int calculationId,
+	const std::wstring &path, std::shared_ptr<CalculationState> state,
+	const CancellationToken &queueCancellationToken)
+{
+	auto isCancelled = [&state, &queueCancellationToken]
+	{ return state->cancellationToken.IsCancelled() || queueCancellationToken.IsCancelled(); };
+
+	// The calculation may have been cancelled while it was waiting in the queue.
+	if (isCancelled())
+	{
+		return;
+	}
+
+	ScopedTraceSpan span("FolderSizeCalculator", "CalculateFolderSize");
+
+	auto lastUpdateTime = std::chrono::steady_clock::now();
+
+	auto folderInfo = GetFolderInfo(path,
+		[messageWindow, calculationId, &state, &lastUpdateTime,
+			&isCancelled](const FolderInfo &runningTotal)
+		{
+			if (isCancelled())
+			{
+				return false;
+			}
+
+			auto now = std::chrono::steady_clock::now();
+
+			if (now - lastUpdateTime >= PROGRESS_UPDATE_INTERVAL)
+			{
+				{
+					std::scoped_lock lock(state->mutex);
+					state->folderInfo = runningTotal;
+				}
+
+				PostMessage(messageWindow, WM_APP_FOLDER_SIZE_PROGRESS, calculationId, 0);
+
+				lastUpdateTime = now;
+			}
+
+			return true;
+		});
+
+	if (!folderInfo)
+	{
+		return;
+	}
+
+	{
+		std::scoped_lock lock(state->mutex);
+		state->folderInfo = *folderInfo;
+		state->complete = true;
+	}
+
+	PostMessage(messageWindow, WM_APP_FOLDER_SIZE_PROGRESS, calculationId, 0);
+}
+
+void FolderSizeCalculator::OnProgress(int calculationId)
+{
+	auto itr = m_calculations.find(calculationId);
+
+	if (itr == m_calculations.end())
+	{
+		// The calculation has either been cancelled or has already completed (progress messages
+		// can still be in the queue when the final message is processed).
+		return;
+	}
+
+	FolderInfo folderInfo;
+	bool complete;
+
+	{
+		std::scoped_lock lock(itr->second.state->mutex);
+		folderInfo = itr->second.state->folderInfo;
+		complete = itr->second.state->complete;
+	}
+
+	// The requests are copied, since a callback may go on to start or cancel a calculation.
+	std::vector<std::pair<int, Callback>> requests(itr->second.requests.begin(),
+		itr->second.requests.end());
+
+	if (complete)
+	{
+		for (const auto &[requestId, callback] : requests)
+		{
+			m_requestCalculations.erase(requestId);
+		}
+
+		m_calculations.erase(itr);
+	}
+
+	for (const auto &[requestId, callback] : requests)
+	{
+		// An earlier callback may have cancelled this request.
+		if (!complete && !m_requestCalculations.contains(requestId))
+		{
+			continue;
+		}
+
+		callback(folderInfo, complete);
+	}
+}
@@ -0,0 +1,91 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "../Helper/FolderSize.h"
+#include "../Helper/TaskScheduler.h"
+#include <boost/core/noncopyable.hpp>
+#include <wil/resource.h>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class WindowSubclassWrapper;
+
+// Calculates folder sizes in the background, with only a small number of calculations running at
+// any one time. Calculating the size of a folder involves walking the entire folder tree, so
+// running many calculations at once (e.g. when the user moves quickly through a list of folders)
+// would only result in the calculations competing with each other for disk access.
+//
+// Requests for the same folder that are made while a calculation is in progress share that
+// calculation. A calculation is stopped once every request for it has been cancelled. While a
+// calculation is running, the running totals are periodically passed back to the callback.
+// Callbacks are always invoked on the thread that created this object.
+class FolderSizeCalculator : private boost::noncopyable
+{
+public:
+	// Invoked with the running totals while the calculation is in progress and once more (with
+	// complete set to true) when it has finished.
+	using Callback = std::function<void(const FolderInfo &folderInfo, bool complete)>;
+
+	FolderSizeCalculator(TaskScheduler *taskScheduler);
+	~FolderSizeCalculator();
+
+	int Calculate(const std::wstring &path, Callback callback);
+	void Cancel(int requestId);
+
+private:
+	static constexpr UINT WM_APP_FOLDER_SIZE_PROGRESS = WM_APP + 1;
+
+	// More than one calculation is allowed to run at a time, so that a single slow walk (e.g. of a
+	// folder on a network drive) doesn't hold up requests for other folders. The limit is kept low,
+	// since the calculations otherwise compete with each other for the disk.
+	static constexpr int MAX_CONCURRENT_CALCULATIONS = 2;
+
+	// The minimum amount of time between progress updates for a single calculation.
+	static constexpr std::chrono::milliseconds PROGRESS_UPDATE_INTERVAL =
+		std::chrono::milliseconds(200);
+
+	// This is shared with the worker thread performing the calculation.
+	struct CalculationState
+	{
+		// Cancelled once every request for the calculation has been cancelled. Cancelling the
+		// whole queue (which happens when this object is destroyed) is signalled separately,
+		// through the token passed to the task.
+		CancellationToken cancellationToken;
+
+		std::mutex mutex;
+		FolderInfo folderInfo = {};
+		bool complete = false;
+	};
+
+	struct Calculation
+	{
+		std::wstring path;
+		std::shared_ptr<CalculationState> state;
+		std::unordered_map<int, Callback> requests;
+	};
+
+	LRESULT WindowSubclass(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+	static void CalculateFolderSize(HWND messageWindow, int calculationId,
+		const std::wstring &path, std::shared_ptr<CalculationState> state,
+		const CancellationToken &queueCancellationToken);
+	void OnProgress(int calculationId);
+
+	wil::unique_hwnd m_messageWindow;
+	std::vector<std::unique_ptr<WindowSubclassWrapper>> m_windowSubclasses;
+	TaskQueue m_taskQueue;
+
+	std::unordered_map<int, Calculation> m_calculations;
+	int m_calculationIdCounter = 0;
+
+	// Maps each request to the calculation it's attached to.
+	std::unordered_map<int, int> m_requestCalculations;
+	int m_requestIdCounter = 0;
+};
@@ -0,0 +1,132 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "FrequentLocationsJournal.h"
+#include <cmath>
+#include <istream>
+
+FrequentLocationsJournal::FrequentLocationsJournal(const std::filesystem::path &path) :
+	m_journal(path, MAGIC, VERSION)
+{
+}
+
+std::vector<LocationVisitInfo> FrequentLocationsJournal::Load()
+{
+	std::vector<LocationVisitInfo> visits;
+
+	m_journal.Load(
+		[&visits](std::istream &stream)
+		{
+			auto visitInfo = ReadEntry(stream);
+
+			if (!visitInfo)
+			{
+				return false;
+			}
+
+			visits.push_back(std::move(*visitInfo));
+			return true;
+		});
+
+	return visits;
+}
+
+bool FrequentLocationsJournal::Append(const LocationVisitInfo &visitInfo)
+{
+	auto record = SerializeEntry(visitInfo);
+
+	if (!record)
+	{
+		return true;
+	}
+
+	return m_journal.Append(*record);
+}
+
+bool FrequentLocationsJournal::Rewrite(const std::vector<LocationVisitInfo> &visits)
+{
+	std::vector<std::string> records;
+	records.reserve(visits.size());
+
+	for (const auto &visitInfo : visits)
+	{
+		auto record = SerializeEntry(visitInfo);
+
+		if (record)
+		{
+			records.push_back(std::move(*record));
+		}
+	}
+
+	return m_journal.Rewrite(records);
+}
+
+size_t FrequentLocationsJournal::GetNumEntries() const
+{
+	return m_journal.GetNumRecords();
+}
+
+std::optional<std::string> FrequentLocationsJournal::SerializeEntry(
+	const LocationVisitInfo &visitInfo)
+{
+	auto pidl = visitInfo.GetLocation();
+	auto pidlSize = static_cast<uint32_t>(ILGetSize(pidl.Raw()));
+
+	if (pidlSize == 0 || pidlSize > MAX_PIDL_SIZE)
+	{
+		return std::nullopt;
+	}
+
+	auto numVisits = static_cast<uint32_t>(visitInfo.GetNumVisits());
+	int64_t lastVisitTime = visitInfo.GetLastVisitTime().time_since_epoch().count();
+	double score = visitInfo.GetScore();
+
+	std::string buffer;
+	buffer.reserve(sizeof(pidlSize) + pidlSize + sizeof(numVisits) + sizeof(lastVisitTime)
+		+ sizeof(score));
+	buffer.append(reinterpret_cast<const char *>(&pidlSize), sizeof(pidlSize));
+	buffer.append(reinterpret_cast<const char *>(pidl.Raw()), pidlSize);
+	buffer.append(reinterpret_cast<const char *>(&numVisits), sizeof(numVisits));
+	buffer.append(reinterpret_cast<const char *>(&lastVisitTime), sizeof(lastVisitTime));
+	buffer.append(reinterpret_cast<const char *>(&score), sizeof(score));
+
+	return buffer;
+}
+
+std::optional<LocationVisitInfo> FrequentLocationsJournal::ReadEntry(std::istream &stream)
+{
+	uint32_t pidlSize;
+	stream.read(reinterpret_cast<char *>(&pidlSize), sizeof(pidlSize));
+
+	if (!stream || pidlSize < sizeof(USHORT) || pidlSize > MAX_PIDL_SIZE)
+	{
+		return std::nullopt;
+	}
+
+	std::vector<BYTE> pidlData(pidlSize);
+	stream.read(reinterpret_cast<char *>(pidlData.data()), pidlSize);
+
+	if (!stream || !IsValidPidlData(pidlData))
+	{
+		return std::nullopt;
+	}
+
+	uint32_t numVisits;
+	int64_t lastVisitTime;
+	double score;
+	stream.read(reinterpret_cast<char *>(&numVisits), sizeof(numVisits));
+	stream.read(reinterpret_cast<char *>(&lastVisitTime), sizeof(lastVisitTime));
+	stream.read(reinterpret_cast<char *>(&score), sizeof(score));
+
+	if (!stream || numVisits == 0 || numVisits > MAX_NUM_VISITS || !std::isfinite(score))
+	{
+		return std::nullopt;
+	}
+
+	return LocationVisitInfo(reinterpret_cast<PCIDLIST_ABSOLUTE>(pidlData.data()),
+		static_cast<int>(numVisits),
+		LocationVisitInfo::Clock::time_point(LocationVisitInfo::Clock::duration(lastVisitTime)),
+		score);
+}
@@ -0,0 +1,51 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "LocationVisitInfo.h"
+#include "../Helper/AppendOnlyJournal.h"
+#include <filesystem>
+#include <iosfwd>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Persists frequently visited locations to disk. Each time a location is visited, its updated
+// details are appended to an append-only journal as a fixed-layout record. A record supersedes any
+// earlier records for the same location, so the journal can be compacted by rewriting it with a
+// single record for each location.
+class FrequentLocationsJournal
+{
+public:
+	FrequentLocationsJournal(const std::filesystem::path &path);
+
+	// Returns the records in the journal, in the order they were added. If the journal ends with an
+	// incomplete record (e.g. because the application crashed while writing it), the record will be
+	// discarded.
+	std::vector<LocationVisitInfo> Load();
+
+	bool Append(const LocationVisitInfo &visitInfo);
+
+	// Replaces the contents of the journal with the specified records.
+	bool Rewrite(const std::vector<LocationVisitInfo> &visits);
+
+	// Returns the number of records in the journal, including superseded records.
+	size_t GetNumEntries() const;
+
+private:
+	static constexpr uint32_t MAGIC = 0x4C465845;
+	static constexpr uint32_t VERSION = 1;
+
+	// Used when reading the journal, to detect records that are clearly invalid.
+	static constexpr uint32_t MAX_PIDL_SIZE = 64 * 1024;
+	static constexpr uint32_t MAX_NUM_VISITS = (std::numeric_limits<int>::max)();
+
+	// Returns std::nullopt if the record is invalid, in which case it won't be written.
+	static std::optional<std::string> SerializeEntry(const LocationVisitInfo &visitInfo);
+	static std::optional<LocationVisitInfo> ReadEntry(std::istream &stream);
+
+	AppendOnlyJournal m_journal;
+};
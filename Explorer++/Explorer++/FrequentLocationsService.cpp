@@ -4,29 +4,124 @@
 
 #include "stdafx.h"
 #include "FrequentLocationsService.h"
+#include "FrequentLocationsJournal.h"
 
-void FrequentLocationsService::RegisterLocationVisit(const PidlAbsolute &pidl)
+FrequentLocationsService::FrequentLocationsService(size_t maxLocations) :
+	m_maxLocations(maxLocations)
+{
+}
+
+FrequentLocationsService::~FrequentLocationsService() = default;
+
+void FrequentLocationsService::SetJournal(std::unique_ptr<FrequentLocationsJournal> journal)
+{
+	m_journal = std::move(journal);
+
+	auto visits = m_journal->Load();
+
+	for (const auto &visitInfo : visits)
+	{
+		RestoreLocationVisit(visitInfo);
+	}
+
+	RemoveExcessLocations();
+	MaybeCompactJournal();
+
+	if (!visits.empty())
+	{
+		m_locationsChangedSignal();
+	}
+}
+
+void FrequentLocationsService::RestoreLocationVisit(const LocationVisitInfo &visitInfo)
+{
+	auto &locationIndex = m_locationVisits.get<ByLocation>();
+	auto itr = locationIndex.find(visitInfo.GetLocation());
+
+	// Records in the journal are stored in the order they were written, so a later record for a
+	// location supersedes any earlier ones.
+	if (itr == locationIndex.end())
+	{
+		locationIndex.insert(visitInfo);
+	}
+	else
+	{
+		locationIndex.replace(itr, visitInfo);
+	}
+}
+
+void FrequentLocationsService::RegisterLocationVisit(const PidlAbsolute &pidl,
+	LocationVisitInfo::Clock::time_point visitTime)
 {
 	auto &locationIndex = m_locationVisits.get<ByLocation>();
 	auto itr = locationIndex.find(pidl);
 
 	if (itr == locationIndex.end())
 	{
-		locationIndex.emplace(pidl);
+		itr = locationIndex.emplace(pidl, visitTime).first;
 	}
 	else
 	{
-		locationIndex.modify(itr, [](auto &locationInfo) { locationInfo.AddVisit(); });
+		locationIndex.modify(itr, [visitTime](auto &locationInfo)
+			{ locationInfo.AddVisit(visitTime); });
 	}
 
+	if (m_journal)
+	{
+		m_journal->Append(*itr);
+	}
+
+	RemoveExcessLocations();
+	MaybeCompactJournal();
+
 	m_locationsChangedSignal();
 }
 
+void FrequentLocationsService::RemoveExcessLocations()
+{
+	auto &visitsIndex = m_locationVisits.get<ByVisits>();
+
+	// The lowest ranked locations are at the end of the index.
+	while (visitsIndex.size() > m_maxLocations)
+	{
+		visitsIndex.erase(std::prev(visitsIndex.end()));
+	}
+}
+
+void FrequentLocationsService::RemoveExpiredLocations(LocationVisitInfo::Clock::time_point now)
+{
+	auto &visitsIndex = m_locationVisits.get<ByVisits>();
+	double minScore = LocationVisitInfo::GetVisitScore(now - EXPIRY_AGE);
+
+	while (!visitsIndex.empty() && std::prev(visitsIndex.end())->GetScore() < minScore)
+	{
+		visitsIndex.erase(std::prev(visitsIndex.end()));
+	}
+}
+
+void FrequentLocationsService::MaybeCompactJournal()
+{
+	if (!m_journal || m_journal->GetNumEntries() <= m_maxLocations * JOURNAL_COMPACTION_FACTOR)
+	{
+		return;
+	}
+
+	RemoveExpiredLocations(LocationVisitInfo::Clock::now());
+
+	const auto &visitsIndex = m_locationVisits.get<ByVisits>();
+	m_journal->Rewrite({ visitsIndex.begin(), visitsIndex.end() });
+}
+
 const FrequentLocationsService::ByVisitsIndex &FrequentLocationsService::GetVisits() const
 {
 	return m_locationVisits.get<ByVisits>();
 }
 
+size_t FrequentLocationsService::GetNumLocations() const
+{
+	return m_locationVisits.size();
+}
+
 boost::signals2::connection FrequentLocationsService::AddLocationsChangedObserver(
 	const LocationsChangedSignal::slot_type &observer)
 {
@@ -9,16 +9,32 @@
 #include <boost/multi_index/composite_key.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
+#include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/signals2.hpp>
+#include <memory>
+
+class FrequentLocationsJournal;
 
 // Stores information about how often locations are visited. A sorted set of frequently visited
-// locations can be retrieved.
+// locations can be retrieved, with locations ranked by their decayed visit score (see
+// LocationVisitInfo), so that locations visited often in the past gradually give way to locations
+// visited recently.
+//
+// Only a fixed number of locations are retained. Since the locations are kept in sorted order,
+// retrieving the top N locations only requires walking the first N items, regardless of how many
+// locations are stored.
 class FrequentLocationsService
 {
 public:
 	using LocationsChangedSignal = boost::signals2::signal<void()>;
 
+	static constexpr size_t DEFAULT_MAX_LOCATIONS = 1000;
+
+	// Locations whose score has decayed below that of a single visit made this long ago are
+	// removed when the journal is compacted.
+	static constexpr std::chrono::hours EXPIRY_AGE = std::chrono::days(180);
+
 	// This struct and the one below are used as tags with the multi_index_container. That is, they
 	// allow specific indices to be accessed in a more descriptive way (rather than by the index
 	// order number).
@@ -33,20 +49,20 @@ public:
 	// clang-format off
 	using LocationVisits = boost::multi_index_container<LocationVisitInfo,
 		boost::multi_index::indexed_by<
-			// An index of visits, sorted by visit count and then last visit time (when the visit
-			// counts are the same).
+			// An index of visits, sorted by score and then last visit time (when the scores are
+			// the same).
 			boost::multi_index::ordered_non_unique<
 				boost::multi_index::tag<ByVisits>,
 				boost::multi_index::composite_key<
 					LocationVisitInfo,
-					boost::multi_index::const_mem_fun<LocationVisitInfo, int, &LocationVisitInfo::GetNumVisits>,
+					boost::multi_index::const_mem_fun<LocationVisitInfo, double, &LocationVisitInfo::GetScore>,
 					boost::multi_index::const_mem_fun<LocationVisitInfo, LocationVisitInfo::Clock::time_point,
 						&LocationVisitInfo::GetLastVisitTime>
 				>,
-				// Items are sorted in descending order of visit count (i.e. most visited first) and
+				// Items are sorted in descending order of score (i.e. highest ranked first) and
 				// descending order of last visit time (i.e. most recently visited items first).
 				boost::multi_index::composite_key_compare<
-					std::greater<int>,
+					std::greater<double>,
 					std::greater<LocationVisitInfo::Clock::time_point>
 				>
 			>,
@@ -61,12 +77,32 @@ public:
 
 	using ByVisitsIndex = LocationVisits::index<ByVisits>::type;
 
-	void RegisterLocationVisit(const PidlAbsolute &pidl);
+	FrequentLocationsService(size_t maxLocations = DEFAULT_MAX_LOCATIONS);
+	~FrequentLocationsService();
+
+	// Loads any locations stored in the journal. All visits registered after this point will also
+	// be written to the journal.
+	void SetJournal(std::unique_ptr<FrequentLocationsJournal> journal);
+
+	void RegisterLocationVisit(const PidlAbsolute &pidl,
+		LocationVisitInfo::Clock::time_point visitTime = LocationVisitInfo::Clock::now());
 	const ByVisitsIndex &GetVisits() const;
+	size_t GetNumLocations() const;
 	boost::signals2::connection AddLocationsChangedObserver(
 		const LocationsChangedSignal::slot_type &observer);
 
 private:
+	// Once the journal contains this many times the maximum number of locations, it will be
+	// compacted.
+	static constexpr size_t JOURNAL_COMPACTION_FACTOR = 2;
+
+	void RestoreLocationVisit(const LocationVisitInfo &visitInfo);
+	void RemoveExcessLocations();
+	void RemoveExpiredLocations(LocationVisitInfo::Clock::time_point now);
+	void MaybeCompactJournal();
+
+	const size_t m_maxLocations;
 	LocationVisits m_locationVisits;
+	std::unique_ptr<FrequentLocationsJournal> m_journal;
 	LocationsChangedSignal m_locationsChangedSignal;
 };
@@ -0,0 +1,29 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "FrequentLocationsServiceFactory.h"
+#include "FrequentLocationsService.h"
+
+FrequentLocationsServiceFactory::~FrequentLocationsServiceFactory() = default;
+
+FrequentLocationsServiceFactory *FrequentLocationsServiceFactory::GetInstance()
+{
+	if (!m_staticInstance)
+	{
+		m_staticInstance = new FrequentLocationsServiceFactory();
+	}
+
+	return m_staticInstance;
+}
+
+FrequentLocationsService *FrequentLocationsServiceFactory::GetFrequentLocationsService()
+{
+	if (!m_frequentLocationsService)
+	{
+		m_frequentLocationsService = std::make_unique<FrequentLocationsService>();
+	}
+
+	return m_frequentLocationsService.get();
+}
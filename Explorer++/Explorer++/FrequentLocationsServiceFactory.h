@@ -0,0 +1,25 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <memory>
+
+class FrequentLocationsService;
+
+class FrequentLocationsServiceFactory
+{
+public:
+	static FrequentLocationsServiceFactory *GetInstance();
+
+	FrequentLocationsService *GetFrequentLocationsService();
+
+private:
+	FrequentLocationsServiceFactory() = default;
+	~FrequentLocationsServiceFactory();
+
+	static inline FrequentLocationsServiceFactory *m_staticInstance = nullptr;
+
+	std::unique_ptr<FrequentLocationsService> m_frequentLocationsService;
+};
@@ -7,17 +7,20 @@
 #include "HistoryService.h"
 
 GlobalHistoryMenu::GlobalHistoryMenu(MenuView *menuView, HistoryService *historyService,
-	BrowserWindow *browserWindow, IconFetcher *iconFetcher) :
-	ShellItemsMenu(menuView, GetHistoryItems(historyService), browserWindow, iconFetcher),
+	BrowserWindow *browserWindow, IconFetcher *iconFetcher,
+	ShellItemDetailsFetcher *detailsFetcher) :
+	ShellItemsMenu(menuView, GetHistoryItems(historyService), browserWindow, iconFetcher,
+		detailsFetcher),
 	m_historyService(historyService)
 {
 	Initialize();
 }
 
 GlobalHistoryMenu::GlobalHistoryMenu(MenuView *menuView, HistoryService *historyService,
-	BrowserWindow *browserWindow, IconFetcher *iconFetcher, UINT menuStartId, UINT menuEndId) :
+	BrowserWindow *browserWindow, IconFetcher *iconFetcher,
+	ShellItemDetailsFetcher *detailsFetcher, UINT menuStartId, UINT menuEndId) :
 	ShellItemsMenu(menuView, GetHistoryItems(historyService), browserWindow, iconFetcher,
-		menuStartId, menuEndId),
+		detailsFetcher, menuStartId, menuEndId),
 	m_historyService(historyService)
 {
 	Initialize();
@@ -36,7 +39,5 @@ void GlobalHistoryMenu::OnHistoryChanged()
 
 std::vector<PidlAbsolute> GlobalHistoryMenu::GetHistoryItems(const HistoryService *historyService)
 {
-	const auto &history = historyService->GetHistoryItems();
-	std::vector<PidlAbsolute> historyVector({ history.begin(), history.end() });
-	return historyVector;
+	return historyService->GetHistoryItems(MAX_MENU_ITEMS);
 }
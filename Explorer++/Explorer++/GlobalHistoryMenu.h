@@ -13,11 +13,16 @@ class GlobalHistoryMenu : public ShellItemsMenu
 {
 public:
 	GlobalHistoryMenu(MenuView *menuView, HistoryService *historyService,
-		BrowserWindow *browserWindow, IconFetcher *iconFetcher);
+		BrowserWindow *browserWindow, IconFetcher *iconFetcher,
+		ShellItemDetailsFetcher *detailsFetcher);
 	GlobalHistoryMenu(MenuView *menuView, HistoryService *historyService,
-		BrowserWindow *browserWindow, IconFetcher *iconFetcher, UINT menuStartId, UINT menuEndId);
+		BrowserWindow *browserWindow, IconFetcher *iconFetcher,
+		ShellItemDetailsFetcher *detailsFetcher, UINT menuStartId, UINT menuEndId);
 
 private:
+	// The maximum number of history items that will be shown in the menu.
+	static constexpr size_t MAX_MENU_ITEMS = 50;
+
 	void Initialize();
 	void OnHistoryChanged();
 	static std::vector<PidlAbsolute> GetHistoryItems(const HistoryService *historyService);
@@ -0,0 +1,134 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "HistoryJournal.h"
+#include <istream>
+
+HistoryJournal::HistoryJournal(const std::filesystem::path &path) :
+	m_journal(path, MAGIC, VERSION)
+{
+}
+
+std::vector<HistoryJournal::Entry> HistoryJournal::Load()
+{
+	std::vector<Entry> entries;
+
+	m_journal.Load(
+		[&entries](std::istream &stream)
+		{
+			auto entry = ReadEntry(stream);
+
+			if (!entry)
+			{
+				return false;
+			}
+
+			entries.push_back(std::move(*entry));
+			return true;
+		});
+
+	return entries;
+}
+
+bool HistoryJournal::Append(const Entry &entry)
+{
+	auto record = SerializeEntry(entry);
+
+	if (!record)
+	{
+		return true;
+	}
+
+	return m_journal.Append(*record);
+}
+
+bool HistoryJournal::Rewrite(const std::vector<Entry> &entries)
+{
+	std::vector<std::string> records;
+	records.reserve(entries.size());
+
+	for (const auto &entry : entries)
+	{
+		auto record = SerializeEntry(entry);
+
+		if (record)
+		{
+			records.push_back(std::move(*record));
+		}
+	}
+
+	return m_journal.Rewrite(records);
+}
+
+size_t HistoryJournal::GetNumEntries() const
+{
+	return m_journal.GetNumRecords();
+}
+
+std::optional<std::string> HistoryJournal::SerializeEntry(const Entry &entry)
+{
+	auto pidlSize = static_cast<uint32_t>(ILGetSize(entry.pidl.Raw()));
+	auto pathLength = static_cast<uint32_t>(entry.parsingPath.size());
+
+	if (pidlSize == 0 || pidlSize > MAX_PIDL_SIZE || pathLength > MAX_PATH_LENGTH)
+	{
+		// There's no point writing an entry that would be rejected when the journal is read back.
+		return std::nullopt;
+	}
+
+	std::string buffer;
+	buffer.reserve(sizeof(pidlSize) + pidlSize + sizeof(pathLength) + pathLength * sizeof(wchar_t));
+	buffer.append(reinterpret_cast<const char *>(&pidlSize), sizeof(pidlSize));
+	buffer.append(reinterpret_cast<const char *>(entry.pidl.Raw()), pidlSize);
+	buffer.append(reinterpret_cast<const char *>(&pathLength), sizeof(pathLength));
+	buffer.append(reinterpret_cast<const char *>(entry.parsingPath.data()),
+		pathLength * sizeof(wchar_t));
+
+	return buffer;
+}
+
+std::optional<HistoryJournal::Entry> HistoryJournal::ReadEntry(std::istream &stream)
+{
+	uint32_t pidlSize;
+	stream.read(reinterpret_cast<char *>(&pidlSize), sizeof(pidlSize));
+
+	if (!stream || pidlSize < sizeof(USHORT) || pidlSize > MAX_PIDL_SIZE)
+	{
+		return std::nullopt;
+	}
+
+	std::vector<BYTE> pidlData(pidlSize);
+	stream.read(reinterpret_cast<char *>(pidlData.data()), pidlSize);
+
+	if (!stream)
+	{
+		return std::nullopt;
+	}
+
+	if (!IsValidPidlData(pidlData))
+	{
+		return std::nullopt;
+	}
+
+	auto *pidl = reinterpret_cast<PCIDLIST_ABSOLUTE>(pidlData.data());
+
+	uint32_t pathLength;
+	stream.read(reinterpret_cast<char *>(&pathLength), sizeof(pathLength));
+
+	if (!stream || pathLength > MAX_PATH_LENGTH)
+	{
+		return std::nullopt;
+	}
+
+	std::wstring parsingPath(pathLength, '\0');
+	stream.read(reinterpret_cast<char *>(parsingPath.data()), pathLength * sizeof(wchar_t));
+
+	if (!stream)
+	{
+		return std::nullopt;
+	}
+
+	return Entry{ pidl, parsingPath };
+}
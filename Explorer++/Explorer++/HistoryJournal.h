@@ -0,0 +1,56 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "../Helper/AppendOnlyJournal.h"
+#include "../Helper/PidlHelper.h"
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Persists global history to disk, with each history item being stored as a separate record in an
+// append-only journal. Since items can be superseded (e.g. when a folder is visited again), the
+// journal can be compacted, by rewriting it with a specific set of items.
+class HistoryJournal
+{
+public:
+	struct Entry
+	{
+		PidlAbsolute pidl;
+		std::wstring parsingPath;
+	};
+
+	HistoryJournal(const std::filesystem::path &path);
+
+	// Returns the entries in the journal, in the order they were added. If the journal ends with an
+	// incomplete entry (e.g. because the application crashed while writing it), the entry will be
+	// discarded.
+	std::vector<Entry> Load();
+
+	bool Append(const Entry &entry);
+
+	// Replaces the contents of the journal with the specified entries (which should be provided in
+	// the order they were originally added).
+	bool Rewrite(const std::vector<Entry> &entries);
+
+	// Returns the number of entries in the journal, including superseded entries.
+	size_t GetNumEntries() const;
+
+private:
+	static constexpr uint32_t MAGIC = 0x4A485845;
+	static constexpr uint32_t VERSION = 1;
+
+	// Used when reading the journal, to detect entries that are clearly invalid.
+	static constexpr uint32_t MAX_PIDL_SIZE = 64 * 1024;
+	static constexpr uint32_t MAX_PATH_LENGTH = 32 * 1024;
+
+	// Returns std::nullopt if the entry is invalid, in which case it won't be written.
+	static std::optional<std::string> SerializeEntry(const Entry &entry);
+	static std::optional<Entry> ReadEntry(std::istream &stream);
+
+	AppendOnlyJournal m_journal;
+};
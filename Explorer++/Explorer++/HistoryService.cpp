@@ -4,23 +4,180 @@
 
 #include "stdafx.h"
 #include "HistoryService.h"
+#include "HistoryJournal.h"
 #include "../Helper/ShellHelper.h"
+#include <algorithm>
+
+HistoryService::HistoryService(size_t maxItems) : m_maxItems(maxItems)
+{
+}
+
+HistoryService::~HistoryService() = default;
+
+void HistoryService::SetJournal(std::unique_ptr<HistoryJournal> journal)
+{
+	m_journal = std::move(journal);
+
+	bool historyChanged = false;
+
+	for (const auto &entry : m_journal->Load())
+	{
+		historyChanged |= AddHistoryItemInternal(entry.pidl, entry.parsingPath);
+	}
+
+	MaybeCompactJournal();
+
+	if (historyChanged)
+	{
+		m_historyChangedSignal();
+	}
+}
 
 void HistoryService::AddHistoryItem(const PidlAbsolute &pidl)
 {
-	if (!m_historyItems.empty() && (pidl == m_historyItems.front()))
+	std::wstring parsingPath;
+	GetDisplayName(pidl.Raw(), SHGDN_FORPARSING, parsingPath);
+
+	if (!AddHistoryItemInternal(pidl, parsingPath))
 	{
-		// This item is the same as the most recent history item.
 		return;
 	}
 
-	m_historyItems.push_front(pidl);
+	if (m_journal)
+	{
+		m_journal->Append({ pidl, parsingPath });
+		MaybeCompactJournal();
+	}
+
 	m_historyChangedSignal();
 }
 
-const std::deque<PidlAbsolute> &HistoryService::GetHistoryItems() const
+bool HistoryService::AddHistoryItemInternal(const PidlAbsolute &pidl,
+	const std::wstring &parsingPath)
+{
+	auto &recencyIndex = m_historyItems.get<ByRecency>();
+
+	if (!recencyIndex.empty() && (pidl == recencyIndex.front().pidl))
+	{
+		// This item is the same as the most recent history item.
+		return false;
+	}
+
+	// If the location has been visited previously, the existing item is removed, so that the
+	// location only appears once (at the position of the most recent visit).
+	auto &locationIndex = m_historyItems.get<ByLocation>();
+	auto itr = locationIndex.find(pidl);
+
+	if (itr != locationIndex.end())
+	{
+		locationIndex.erase(itr);
+	}
+
+	recencyIndex.push_front({ pidl, parsingPath, GetLookupPath(parsingPath),
+		m_sequenceNumberCounter++ });
+
+	while (recencyIndex.size() > m_maxItems)
+	{
+		recencyIndex.pop_back();
+	}
+
+	return true;
+}
+
+void HistoryService::MaybeCompactJournal()
+{
+	if (!m_journal || m_journal->GetNumEntries() <= m_maxItems * JOURNAL_COMPACTION_FACTOR)
+	{
+		return;
+	}
+
+	const auto &recencyIndex = m_historyItems.get<ByRecency>();
+
+	// Entries in the journal are stored in the order they were added (i.e. oldest first).
+	std::vector<HistoryJournal::Entry> entries;
+	entries.reserve(recencyIndex.size());
+
+	for (auto itr = recencyIndex.rbegin(); itr != recencyIndex.rend(); ++itr)
+	{
+		entries.push_back({ itr->pidl, itr->parsingPath });
+	}
+
+	m_journal->Rewrite(entries);
+}
+
+std::vector<PidlAbsolute> HistoryService::GetHistoryItems(size_t maxItems) const
 {
-	return m_historyItems;
+	const auto &recencyIndex = m_historyItems.get<ByRecency>();
+
+	std::vector<PidlAbsolute> historyItems;
+	historyItems.reserve((std::min)(maxItems, recencyIndex.size()));
+
+	for (const auto &item : recencyIndex)
+	{
+		if (historyItems.size() == maxItems)
+		{
+			break;
+		}
+
+		historyItems.push_back(item.pidl);
+	}
+
+	return historyItems;
+}
+
+std::vector<PidlAbsolute> HistoryService::GetHistoryItemsWithPrefix(const std::wstring &prefix,
+	size_t maxItems) const
+{
+	auto lookupPrefix = GetLookupPath(prefix);
+	const auto &lookupPathIndex = m_historyItems.get<ByLookupPath>();
+
+	std::vector<const HistoryItem *> matchingItems;
+
+	for (auto itr = lookupPathIndex.lower_bound(lookupPrefix);
+		 itr != lookupPathIndex.end() && itr->lookupPath.starts_with(lookupPrefix); ++itr)
+	{
+		matchingItems.push_back(&*itr);
+	}
+
+	auto numItems = (std::min)(maxItems, matchingItems.size());
+	std::partial_sort(matchingItems.begin(), matchingItems.begin() + numItems, matchingItems.end(),
+		[](const HistoryItem *item1, const HistoryItem *item2)
+		{ return item1->sequenceNumber > item2->sequenceNumber; });
+
+	std::vector<PidlAbsolute> historyItems;
+	historyItems.reserve(numItems);
+
+	for (size_t i = 0; i < numItems; i++)
+	{
+		historyItems.push_back(matchingItems[i]->pidl);
+	}
+
+	return historyItems;
+}
+
+std::vector<std::wstring> HistoryService::GetHistoryItemPaths(size_t maxItems) const
+{
+	const auto &recencyIndex = m_historyItems.get<ByRecency>();
+
+	std::vector<std::wstring> paths;
+	paths.reserve((std::min)(maxItems, recencyIndex.size()));
+
+	for (const auto &item : recencyIndex)
+	{
+		if (paths.size() == maxItems)
+		{
+			break;
+		}
+
+		paths.push_back(item.parsingPath);
+	}
+
+	return paths;
+}
+
+size_t HistoryService::GetNumHistoryItems() const
+{
+	return m_historyItems.size();
 }
 
 boost::signals2::connection HistoryService::AddHistoryChangedObserver(
@@ -28,3 +185,10 @@ boost::signals2::connection HistoryService::AddHistoryChangedObserver(
 {
 	return m_historyChangedSignal.connect(observer);
 }
+
+std::wstring HistoryService::GetLookupPath(const std::wstring &path)
+{
+	std::wstring lookupPath = path;
+	CharLowerBuff(lookupPath.data(), static_cast<DWORD>(lookupPath.size()));
+	return lookupPath;
+}
@@ -5,24 +5,112 @@
 #pragma once
 
 #include "../Helper/PidlHelper.h"
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
 #include <boost/signals2.hpp>
-#include <deque>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
 
-// Stores global history (i.e. the history of navigations across all tabs).
+class HistoryJournal;
+
+// Stores global history (i.e. the history of navigations across all tabs). Each location only
+// appears once, at the position of its most recent visit, and only a fixed number of the most
+// recently visited locations are retained.
 class HistoryService
 {
 public:
 	using HistoryChangedSignal = boost::signals2::signal<void()>;
 
+	static constexpr size_t DEFAULT_MAX_ITEMS = 1000;
+
+	HistoryService(size_t maxItems = DEFAULT_MAX_ITEMS);
+	~HistoryService();
+
+	// Loads any history stored in the journal. All history items added after this point will also
+	// be written to the journal.
+	void SetJournal(std::unique_ptr<HistoryJournal> journal);
+
 	void AddHistoryItem(const PidlAbsolute &pidl);
 
-	// Returns the set of history items, with more recent items appearing first.
-	const std::deque<PidlAbsolute> &GetHistoryItems() const;
+	// Returns up to maxItems history items, with more recent items appearing first.
+	std::vector<PidlAbsolute> GetHistoryItems(
+		size_t maxItems = (std::numeric_limits<size_t>::max)()) const;
+
+	// Returns up to maxItems history items whose parsing path starts with the specified prefix
+	// (ignoring case). As above, more recent items appear first.
+	std::vector<PidlAbsolute> GetHistoryItemsWithPrefix(const std::wstring &prefix,
+		size_t maxItems) const;
+
+	// Returns the parsing paths of up to maxItems history items, in the same order as
+	// GetHistoryItems().
+	std::vector<std::wstring> GetHistoryItemPaths(
+		size_t maxItems = (std::numeric_limits<size_t>::max)()) const;
+
+	size_t GetNumHistoryItems() const;
 
 	boost::signals2::connection AddHistoryChangedObserver(
 		const HistoryChangedSignal::slot_type &observer);
 
 private:
-	std::deque<PidlAbsolute> m_historyItems;
+	// Once the journal contains this many times the maximum number of items, it will be compacted.
+	static constexpr size_t JOURNAL_COMPACTION_FACTOR = 2;
+
+	struct HistoryItem
+	{
+		PidlAbsolute pidl;
+		std::wstring parsingPath;
+
+		// The parsing path, in lowercase. Used for prefix lookups.
+		std::wstring lookupPath;
+
+		// Incremented for each item added. Allows the relative order of items to be determined
+		// without having to walk the recency index.
+		uint64_t sequenceNumber;
+	};
+
+	struct ByRecency
+	{
+	};
+
+	struct ByLocation
+	{
+	};
+
+	struct ByLookupPath
+	{
+	};
+
+	// clang-format off
+	using HistoryItems = boost::multi_index_container<HistoryItem,
+		boost::multi_index::indexed_by<
+			// Items in the order they were visited, with the most recent item first.
+			boost::multi_index::sequenced<
+				boost::multi_index::tag<ByRecency>
+			>,
+			boost::multi_index::hashed_unique<
+				boost::multi_index::tag<ByLocation>,
+				boost::multi_index::member<HistoryItem, PidlAbsolute, &HistoryItem::pidl>
+			>,
+			boost::multi_index::ordered_non_unique<
+				boost::multi_index::tag<ByLookupPath>,
+				boost::multi_index::member<HistoryItem, std::wstring, &HistoryItem::lookupPath>
+			>
+		>
+	>;
+	// clang-format on
+
+	bool AddHistoryItemInternal(const PidlAbsolute &pidl, const std::wstring &parsingPath);
+	void MaybeCompactJournal();
+	static std::wstring GetLookupPath(const std::wstring &path);
+
+	const size_t m_maxItems;
+	HistoryItems m_historyItems;
+	uint64_t m_sequenceNumberCounter = 0;
+	std::unique_ptr<HistoryJournal> m_journal;
 	HistoryChangedSignal m_historyChangedSignal;
 };
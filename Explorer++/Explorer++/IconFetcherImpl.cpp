@@ -5,14 +5,15 @@
 #include "stdafx.h"
 #include "IconFetcherImpl.h"
 #include "../Helper/CachedIcons.h"
+#include "../Helper/PerformanceTracer.h"
 #include "../Helper/WindowSubclassWrapper.h"
 
-IconFetcherImpl::IconFetcherImpl(HWND hwnd, CachedIcons *cachedIcons) :
+IconFetcherImpl::IconFetcherImpl(HWND hwnd, CachedIcons *cachedIcons,
+	TaskScheduler *taskScheduler, TaskPriority taskPriority) :
 	m_hwnd(hwnd),
-	m_cachedIcons(cachedIcons),
-	m_iconThreadPool(1, std::bind(CoInitializeEx, nullptr, COINIT_APARTMENTTHREADED),
-		CoUninitialize),
-	m_iconResultIDCounter(0)
+	m_iconResults([hwnd]() { return PostMessage(hwnd, WM_APP_ICON_RESULT_READY, 0, 0) != 0; }),
+	m_iconTaskQueue(taskScheduler, taskPriority),
+	m_cachedIcons(cachedIcons)
 {
 	FAIL_FAST_IF_FAILED(GetDefaultFileIconIndex(m_defaultFileIconIndex));
 	FAIL_FAST_IF_FAILED(GetDefaultFolderIconIndex(m_defaultFolderIconIndex));
@@ -23,7 +24,12 @@ IconFetcherImpl::IconFetcherImpl(HWND hwnd, CachedIcons *cachedIcons) :
 
 IconFetcherImpl::~IconFetcherImpl()
 {
-	m_iconThreadPool.clear_queue();
+	m_iconTaskQueue.CancelPendingTasks();
+}
+
+void IconFetcherImpl::SetTaskPriority(TaskPriority priority)
+{
+	m_iconTaskQueue.SetPriority(priority);
 }
 
 LRESULT IconFetcherImpl::WindowSubclass(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
@@ -31,7 +37,7 @@ LRESULT IconFetcherImpl::WindowSubclass(HWND hwnd, UINT msg, WPARAM wParam, LPAR
 	switch (msg)
 	{
 	case WM_APP_ICON_RESULT_READY:
-		ProcessIconResult(static_cast<int>(wParam));
+		ProcessIconResults();
 		return 0;
 		break;
 	}
@@ -41,13 +47,12 @@ LRESULT IconFetcherImpl::WindowSubclass(HWND hwnd, UINT msg, WPARAM wParam, LPAR
 
 void IconFetcherImpl::QueueIconTask(std::wstring_view path, Callback callback)
 {
-	int iconResultID = m_iconResultIDCounter++;
+	TraceCounterAdjust("IconFetcher", "Requests", 1);
 
-	auto iconResult = m_iconThreadPool.push(
-		[this, iconResultID, copiedPath = std::wstring(path)](int id) -> std::optional<IconResult>
+	m_iconTaskQueue.Post(
+		[resultQueue = &m_iconResults, generation = m_iconResults.GetGeneration(),
+			copiedPath = std::wstring(path), callback = std::move(callback)]() mutable
 		{
-			UNREFERENCED_PARAMETER(id);
-
 			// SHGetFileInfo will fail for non-filesystem paths that are passed in
 			// as strings. For example, attempting to retrieve the icon for the
 			// recycle bin will fail if you pass the parsing path (i.e.
@@ -60,48 +65,40 @@ void IconFetcherImpl::QueueIconTask(std::wstring_view path, Callback callback)
 
 			if (FAILED(hr))
 			{
-				return std::nullopt;
+				return;
 			}
 
 			auto iconIndex = FindIconAsync(pidl.get());
 
 			if (!iconIndex)
 			{
-				return std::nullopt;
+				return;
 			}
 
 			IconResult result;
 			result.iconIndex = *iconIndex;
-			result.path = copiedPath;
-
-			PostMessage(m_hwnd, WM_APP_ICON_RESULT_READY, iconResultID, 0);
-
-			return result;
+			result.path = std::move(copiedPath);
+			result.callback = std::move(callback);
+			resultQueue->Push(generation, std::move(result));
 		});
-
-	FutureResult futureResult;
-	futureResult.callback = callback;
-	futureResult.iconResult = std::move(iconResult);
-	m_iconResults.insert({ iconResultID, std::move(futureResult) });
 }
 
 void IconFetcherImpl::QueueIconTask(PCIDLIST_ABSOLUTE pidl, Callback callback)
 {
-	int iconResultID = m_iconResultIDCounter++;
-
 	BasicItemInfo basicItemInfo;
 	basicItemInfo.pidl.reset(ILCloneFull(pidl));
 
-	auto iconResult = m_iconThreadPool.push(
-		[this, iconResultID, basicItemInfo](int id) -> std::optional<IconResult>
-		{
-			UNREFERENCED_PARAMETER(id);
+	TraceCounterAdjust("IconFetcher", "Requests", 1);
 
+	m_iconTaskQueue.Post(
+		[resultQueue = &m_iconResults, generation = m_iconResults.GetGeneration(), basicItemInfo,
+			callback = std::move(callback)]() mutable
+		{
 			auto iconIndex = FindIconAsync(basicItemInfo.pidl.get());
 
 			if (!iconIndex)
 			{
-				return std::nullopt;
+				return;
 			}
 
 			IconResult result;
@@ -115,19 +112,15 @@ void IconFetcherImpl::QueueIconTask(PCIDLIST_ABSOLUTE pidl, Callback callback)
 				result.path = filePath;
 			}
 
-			PostMessage(m_hwnd, WM_APP_ICON_RESULT_READY, iconResultID, 0);
-
-			return result;
+			result.callback = std::move(callback);
+			resultQueue->Push(generation, std::move(result));
 		});
-
-	FutureResult futureResult;
-	futureResult.callback = callback;
-	futureResult.iconResult = std::move(iconResult);
-	m_iconResults.insert({ iconResultID, std::move(futureResult) });
 }
 
 std::optional<int> IconFetcherImpl::FindIconAsync(PCIDLIST_ABSOLUTE pidl)
 {
+	ScopedTraceSpan span("IconFetcher", "FindIcon");
+
 	// Must use SHGFI_ICON here, rather than SHGFO_SYSICONINDEX, or else
 	// icon overlays won't be applied.
 	SHFILEINFO shfi;
@@ -144,36 +137,25 @@ std::optional<int> IconFetcherImpl::FindIconAsync(PCIDLIST_ABSOLUTE pidl)
 	return shfi.iIcon;
 }
 
-void IconFetcherImpl::ProcessIconResult(int iconResultId)
+void IconFetcherImpl::ProcessIconResults()
 {
-	auto itr = m_iconResults.find(iconResultId);
-
-	if (itr == m_iconResults.end())
-	{
-		return;
-	}
-
-	auto &futureResult = itr->second;
-	auto result = futureResult.iconResult.get();
-
-	if (!result)
-	{
-		// Icon lookup failed.
-		return;
-	}
+	m_iconResults.Drain([this](const IconResult &result) { ProcessIconResult(result); });
+}
 
-	if (!result->path.empty())
+void IconFetcherImpl::ProcessIconResult(const IconResult &result)
+{
+	if (!result.path.empty())
 	{
-		m_cachedIcons->addOrUpdateFileIcon(result->path, result->iconIndex);
+		m_cachedIcons->addOrUpdateFileIcon(result.path, result.iconIndex);
 	}
 
-	futureResult.callback(result->iconIndex);
+	result.callback(result.iconIndex);
 }
 
 void IconFetcherImpl::ClearQueue()
 {
-	m_iconThreadPool.clear_queue();
-	m_iconResults.clear();
+	m_iconTaskQueue.CancelPendingTasks();
+	m_iconResults.DiscardPending();
 }
 
 int IconFetcherImpl::GetCachedIconIndexOrDefault(const std::wstring &itemPath,
@@ -5,10 +5,9 @@
 #pragma once
 
 #include "IconFetcher.h"
+#include "../Helper/ResultQueue.h"
 #include "../Helper/ShellHelper.h"
-#include "../ThirdParty/CTPL/cpl_stl.h"
-#include <future>
-#include <unordered_map>
+#include "../Helper/TaskScheduler.h"
 
 class CachedIcons;
 class WindowSubclassWrapper;
@@ -16,9 +15,12 @@ class WindowSubclassWrapper;
 class IconFetcherImpl : public IconFetcher
 {
 public:
-	IconFetcherImpl(HWND hwnd, CachedIcons *cachedIcons);
+	IconFetcherImpl(HWND hwnd, CachedIcons *cachedIcons, TaskScheduler *taskScheduler,
+		TaskPriority taskPriority = TaskPriority::Normal);
 	~IconFetcherImpl();
 
+	void SetTaskPriority(TaskPriority priority);
+
 	void QueueIconTask(std::wstring_view path, Callback callback) override;
 	void QueueIconTask(PCIDLIST_ABSOLUTE pidl, Callback callback) override;
 	void ClearQueue() override;
@@ -49,27 +51,23 @@ private:
 	{
 		int iconIndex;
 		std::wstring path;
-	};
-
-	struct FutureResult
-	{
 		Callback callback;
-		std::future<std::optional<IconResult>> iconResult;
 	};
 
 	LRESULT WindowSubclass(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
 	static std::optional<int> FindIconAsync(PCIDLIST_ABSOLUTE pidl);
-	void ProcessIconResult(int iconResultId);
+	void ProcessIconResults();
+	void ProcessIconResult(const IconResult &result);
 
 	const HWND m_hwnd;
 	std::vector<std::unique_ptr<WindowSubclassWrapper>> m_windowSubclasses;
 	int m_defaultFileIconIndex;
 	int m_defaultFolderIconIndex;
 
-	ctpl::thread_pool m_iconThreadPool;
-	std::unordered_map<int, FutureResult> m_iconResults;
-	int m_iconResultIDCounter;
+	// This needs to be declared before the task queue, so that it outlives any running tasks.
+	ResultQueue<IconResult> m_iconResults;
+	TaskQueue m_iconTaskQueue;
 	CachedIcons *m_cachedIcons;
 	std::function<void(int data)> m_callback;
 };
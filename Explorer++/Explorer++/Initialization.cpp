@@ -4,6 +4,7 @@
 
 #include "stdafx.h"
 #include "Explorer++.h"
+#include "ApplicationModelFactory.h"
 #include "Bookmarks/BookmarkTreeFactory.h"
 #include "Bookmarks/UI/BookmarksMainMenu.h"
 #include "ColorRule.h"
@@ -13,22 +14,31 @@
 #include "DarkModeHelper.h"
 #include "DisplayWindow/DisplayWindow.h"
 #include "Explorer++_internal.h"
+#include "FrequentLocationsJournal.h"
+#include "FrequentLocationsService.h"
+#include "FrequentLocationsServiceFactory.h"
+#include "HistoryJournal.h"
+#include "HistoryService.h"
+#include "HistoryServiceFactory.h"
 #include "LoadSaveInterface.h"
 #include "MainResource.h"
 #include "MainToolbar.h"
 #include "MainWindow.h"
 #include "MenuRanges.h"
 #include "ResourceHelper.h"
+#include "SettingsChangeTracker.h"
 #include "ShellBrowser/ShellBrowserImpl.h"
 #include "ShellBrowser/ViewModes.h"
 #include "Tab.h"
 #include "TabContainer.h"
+#include "TabHibernationManager.h"
 #include "TaskbarThumbnails.h"
 #include "ThemeManager.h"
 #include "ThemeWindowTracker.h"
 #include "UiTheming.h"
 #include "ViewModeHelper.h"
 #include "../Helper/iDirectoryMonitor.h"
+#include "../Helper/ProcessHelper.h"
 
 /*
  * Main window creation.
@@ -40,6 +50,14 @@ void Explorerplusplus::OnCreate()
 	InitializeDefaultColorRules();
 
 	LoadAllSettings();
+	InitializeHistoryJournal();
+	InitializeFrequentLocationsJournal();
+
+	m_settingsChangeTracker = std::make_unique<SettingsChangeTracker>(
+		BookmarkTreeFactory::GetInstance()->GetBookmarkTree(),
+		ColorRuleModelFactory::GetInstance()->GetColorRuleModel(),
+		Applications::ApplicationModelFactory::GetInstance()->GetApplicationModel(),
+		std::bind_front(&Explorerplusplus::OnSettingsChanged, this));
 
 	if (m_commandLineSettings->shellChangeNotificationType)
 	{
@@ -101,6 +119,11 @@ void Explorerplusplus::OnCreate()
 	m_themeWindowTracker = std::make_unique<ThemeWindowTracker>(m_hContainer);
 
 	SetTimer(m_hContainer, AUTOSAVE_TIMER_ID, AUTOSAVE_TIMEOUT, nullptr);
+	SetTimer(m_hContainer, TAB_HIBERNATION_TIMER_ID,
+		static_cast<UINT>(std::chrono::duration_cast<std::chrono::milliseconds>(
+			TabHibernationManager::CHECK_INTERVAL)
+				.count()),
+		nullptr);
 
 	m_applicationInitialized = true;
 	m_applicationInitializedSignal();
@@ -119,6 +142,75 @@ void Explorerplusplus::InitializeDefaultColorRules()
 		false, FILE_ATTRIBUTE_ENCRYPTED, RGB(0, 128, 0)));
 }
 
+void Explorerplusplus::InitializeHistoryJournal()
+{
+	auto journalPath = GetDataFilePath(NExplorerplusplus::HISTORY_JOURNAL_FILENAME);
+
+	if (!journalPath)
+	{
+		return;
+	}
+
+	HistoryServiceFactory::GetInstance()->GetHistoryService()->SetJournal(
+		std::make_unique<HistoryJournal>(*journalPath));
+}
+
+void Explorerplusplus::InitializeFrequentLocationsJournal()
+{
+	auto journalPath = GetDataFilePath(NExplorerplusplus::FREQUENT_LOCATIONS_JOURNAL_FILENAME);
+
+	if (!journalPath)
+	{
+		return;
+	}
+
+	FrequentLocationsServiceFactory::GetInstance()->GetFrequentLocationsService()->SetJournal(
+		std::make_unique<FrequentLocationsJournal>(*journalPath));
+}
+
+// When settings are being saved to the config file, data files (such as the history journal) are
+// stored alongside the config file, so that the application remains portable. Otherwise, they're
+// stored in the local application data directory.
+std::optional<std::filesystem::path> Explorerplusplus::GetDataFilePath(
+	const std::wstring &fileName) const
+{
+	std::filesystem::path directory;
+
+	if (m_bSavePreferencesToXMLFile)
+	{
+		TCHAR processImageName[MAX_PATH];
+		GetProcessImageName(GetCurrentProcessId(), processImageName,
+			SIZEOF_ARRAY(processImageName));
+
+		directory = processImageName;
+		directory = directory.parent_path();
+	}
+	else
+	{
+		wil::unique_cotaskmem_string localAppDataPath;
+		HRESULT hr =
+			SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &localAppDataPath);
+
+		if (FAILED(hr))
+		{
+			return std::nullopt;
+		}
+
+		directory = localAppDataPath.get();
+		directory /= NExplorerplusplus::APP_NAME;
+
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+
+		if (error)
+		{
+			return std::nullopt;
+		}
+	}
+
+	return directory / fileName;
+}
+
 void Explorerplusplus::InitializeDisplayWindow()
 {
 	DWInitialSettings_t initialSettings;
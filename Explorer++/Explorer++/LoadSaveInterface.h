@@ -22,13 +22,15 @@ public:
 	virtual void LoadColorRules() = 0;
 	virtual void LoadDialogStates() = 0;
 
-	/* Saving functions. */
+	/* Saving functions. The bookmark, application
+	toolbar and color rule functions return false if
+	the section couldn't be saved. */
 	virtual void SaveGenericSettings() = 0;
-	virtual void SaveBookmarks() = 0;
+	virtual bool SaveBookmarks() = 0;
 	virtual void SaveTabs() = 0;
 	virtual void SaveDefaultColumns() = 0;
-	virtual void SaveApplicationToolbar() = 0;
+	virtual bool SaveApplicationToolbar() = 0;
 	virtual void SaveMainRebarInformation() = 0;
-	virtual void SaveColorRules() = 0;
+	virtual bool SaveColorRules() = 0;
 	virtual void SaveDialogStates() = 0;
 };
@@ -76,9 +76,9 @@ void LoadSaveRegistry::SaveGenericSettings()
 	m_pContainer->SaveGenericSettingsToRegistry();
 }
 
-void LoadSaveRegistry::SaveBookmarks()
+bool LoadSaveRegistry::SaveBookmarks()
 {
-	BookmarkRegistryStorage::Save(NExplorerplusplus::REG_MAIN_KEY,
+	return BookmarkRegistryStorage::Save(NExplorerplusplus::REG_MAIN_KEY,
 		BookmarkTreeFactory::GetInstance()->GetBookmarkTree());
 }
 
@@ -92,9 +92,9 @@ void LoadSaveRegistry::SaveDefaultColumns()
 	m_pContainer->SaveDefaultColumnsToRegistry();
 }
 
-void LoadSaveRegistry::SaveApplicationToolbar()
+bool LoadSaveRegistry::SaveApplicationToolbar()
 {
-	Applications::ApplicationToolbarRegistryStorage::Save(NExplorerplusplus::REG_MAIN_KEY,
+	return Applications::ApplicationToolbarRegistryStorage::Save(NExplorerplusplus::REG_MAIN_KEY,
 		Applications::ApplicationModelFactory::GetInstance()->GetApplicationModel());
 }
 
@@ -110,9 +110,9 @@ void LoadSaveRegistry::SaveMainRebarInformation()
 	}
 }
 
-void LoadSaveRegistry::SaveColorRules()
+bool LoadSaveRegistry::SaveColorRules()
 {
-	ColorRuleRegistryStorage::Save(NExplorerplusplus::REG_MAIN_KEY,
+	return ColorRuleRegistryStorage::Save(NExplorerplusplus::REG_MAIN_KEY,
 		ColorRuleModelFactory::GetInstance()->GetColorRuleModel());
 }
 
@@ -25,12 +25,12 @@ public:
 
 	/* Saving functions. */
 	void SaveGenericSettings() override;
-	void SaveBookmarks() override;
+	bool SaveBookmarks() override;
 	void SaveTabs() override;
 	void SaveDefaultColumns() override;
-	void SaveApplicationToolbar() override;
+	bool SaveApplicationToolbar() override;
 	void SaveMainRebarInformation() override;
-	void SaveColorRules() override;
+	bool SaveColorRules() override;
 	void SaveDialogStates() override;
 
 private:
@@ -9,6 +9,7 @@
 // clang-format on
 #include "ApplicationModelFactory.h"
 #include "ApplicationToolbarXmlStorage.h"
+#include "Bookmarks/BookmarkSnapshotStorage.h"
 #include "Bookmarks/BookmarkTreeFactory.h"
 #include "Bookmarks/BookmarkXmlStorage.h"
 #include "ColorRuleModelFactory.h"
@@ -123,8 +124,47 @@ void LoadSaveXML::ReleaseSaveEnvironment()
 	PathRemoveFileSpec(szConfigFile);
 	PathAppend(szConfigFile, NExplorerplusplus::XML_FILENAME);
 
-	wil::unique_variant var(XMLSettings::VariantString(szConfigFile));
-	m_pXMLDom->save(var);
+	// The file is written to a temporary location first and then moved into place. That way, if
+	// the application crashes (or the system loses power) part of the way through the save, the
+	// existing config file will remain intact.
+	std::wstring temporaryConfigFile = std::wstring(szConfigFile) + L".tmp";
+
+	wil::unique_variant var(XMLSettings::VariantString(temporaryConfigFile.c_str()));
+	HRESULT hr = m_pXMLDom->save(var);
+
+	if (FAILED(hr))
+	{
+		DeleteFile(temporaryConfigFile.c_str());
+		return;
+	}
+
+	BOOL res = MoveFileEx(temporaryConfigFile.c_str(), szConfigFile,
+		MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+
+	if (!res)
+	{
+		DeleteFile(temporaryConfigFile.c_str());
+		return;
+	}
+
+	// The snapshot has to be written once the config file is in place, since it records the
+	// details of the file it corresponds to.
+	if (m_bookmarksSaved)
+	{
+		auto configDirectory = GetConfigDirectory();
+		BookmarkSnapshotStorage::Save(
+			configDirectory / NExplorerplusplus::BOOKMARKS_SNAPSHOT_FILENAME,
+			configDirectory / NExplorerplusplus::XML_FILENAME,
+			BookmarkTreeFactory::GetInstance()->GetBookmarkTree());
+	}
+}
+
+std::filesystem::path LoadSaveXML::GetConfigDirectory()
+{
+	TCHAR processImageName[MAX_PATH];
+	GetProcessImageName(GetCurrentProcessId(), processImageName, SIZEOF_ARRAY(processImageName));
+
+	return std::filesystem::path(processImageName).parent_path();
 }
 
 void LoadSaveXML::LoadGenericSettings()
@@ -134,8 +174,17 @@ void LoadSaveXML::LoadGenericSettings()
 
 void LoadSaveXML::LoadBookmarks()
 {
-	BookmarkXmlStorage::Load(m_pXMLDom.get(),
-		BookmarkTreeFactory::GetInstance()->GetBookmarkTree());
+	auto *bookmarkTree = BookmarkTreeFactory::GetInstance()->GetBookmarkTree();
+	auto configDirectory = GetConfigDirectory();
+
+	if (BookmarkSnapshotStorage::Load(
+			configDirectory / NExplorerplusplus::BOOKMARKS_SNAPSHOT_FILENAME,
+			configDirectory / NExplorerplusplus::XML_FILENAME, bookmarkTree))
+	{
+		return;
+	}
+
+	BookmarkXmlStorage::Load(m_pXMLDom.get(), bookmarkTree);
 }
 
 void LoadSaveXML::LoadPreviousTabs()
@@ -175,10 +224,14 @@ void LoadSaveXML::SaveGenericSettings()
 	m_pContainer->SaveGenericSettingsToXML(m_pXMLDom.get(), m_pRoot.get());
 }
 
-void LoadSaveXML::SaveBookmarks()
+// Note that the sections below are only added to the document here. The document is written out
+// as a whole, when this object is destroyed.
+bool LoadSaveXML::SaveBookmarks()
 {
 	BookmarkXmlStorage::Save(m_pXMLDom.get(), m_pRoot.get(),
 		BookmarkTreeFactory::GetInstance()->GetBookmarkTree(), 1);
+	m_bookmarksSaved = true;
+	return true;
 }
 
 void LoadSaveXML::SaveTabs()
@@ -191,10 +244,11 @@ void LoadSaveXML::SaveDefaultColumns()
 	m_pContainer->SaveDefaultColumnsToXML(m_pXMLDom.get(), m_pRoot.get());
 }
 
-void LoadSaveXML::SaveApplicationToolbar()
+bool LoadSaveXML::SaveApplicationToolbar()
 {
 	Applications::ApplicationToolbarXmlStorage::Save(m_pXMLDom.get(), m_pRoot.get(),
 		Applications::ApplicationModelFactory::GetInstance()->GetApplicationModel());
+	return true;
 }
 
 void LoadSaveXML::SaveMainRebarInformation()
@@ -202,10 +256,11 @@ void LoadSaveXML::SaveMainRebarInformation()
 	m_pContainer->SaveMainRebarInformationToXML(m_pXMLDom.get(), m_pRoot.get());
 }
 
-void LoadSaveXML::SaveColorRules()
+bool LoadSaveXML::SaveColorRules()
 {
 	ColorRuleXmlStorage::Save(m_pXMLDom.get(), m_pRoot.get(),
 		ColorRuleModelFactory::GetInstance()->GetColorRuleModel());
+	return true;
 }
 
 void LoadSaveXML::SaveDialogStates()
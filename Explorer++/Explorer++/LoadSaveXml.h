@@ -7,6 +7,7 @@
 #include "LoadSaveInterface.h"
 #include <wil/com.h>
 #include <MsXml2.h>
+#include <filesystem>
 #include <objbase.h>
 
 class Explorerplusplus;
@@ -29,12 +30,12 @@ public:
 
 	/* Saving functions. */
 	void SaveGenericSettings() override;
-	void SaveBookmarks() override;
+	bool SaveBookmarks() override;
 	void SaveTabs() override;
 	void SaveDefaultColumns() override;
-	void SaveApplicationToolbar() override;
+	bool SaveApplicationToolbar() override;
 	void SaveMainRebarInformation() override;
-	void SaveColorRules() override;
+	bool SaveColorRules() override;
 	void SaveDialogStates() override;
 
 private:
@@ -42,6 +43,7 @@ private:
 	void ReleaseLoadEnvironment();
 	void InitializeSaveEnvironment();
 	void ReleaseSaveEnvironment();
+	static std::filesystem::path GetConfigDirectory();
 
 	Explorerplusplus *m_pContainer;
 	BOOL m_bLoad;
@@ -51,4 +53,5 @@ private:
 
 	/* Used exclusively for saving. */
 	wil::com_ptr_nothrow<IXMLDOMElement> m_pRoot;
+	bool m_bookmarksSaved = false;
 };
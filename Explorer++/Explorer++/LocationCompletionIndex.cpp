@@ -0,0 +1,121 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "LocationCompletionIndex.h"
+#include "LocationVisitInfo.h"
+#include <algorithm>
+#include <cmath>
+
+LocationCompletionIndex::LocationCompletionIndex(Clock::time_point referenceTime) :
+	m_referenceTime(referenceTime)
+{
+}
+
+void LocationCompletionIndex::AddLocation(const std::wstring &path, Source source,
+	std::optional<double> visitScore)
+{
+	if (path.empty())
+	{
+		return;
+	}
+
+	auto [itr, inserted] = m_entries.try_emplace(GetLookupPath(path));
+	Entry &entry = itr->second;
+
+	if (inserted)
+	{
+		entry.path = path;
+		entry.sequenceNumber = m_sequenceNumberCounter++;
+	}
+
+	entry.sources |= static_cast<int>(source);
+
+	if (visitScore && (!entry.visitScore || *visitScore > *entry.visitScore))
+	{
+		entry.visitScore = visitScore;
+	}
+
+	entry.rank = CalculateRank(entry);
+}
+
+void LocationCompletionIndex::Clear()
+{
+	m_entries.clear();
+	m_sequenceNumberCounter = 0;
+}
+
+std::vector<std::wstring> LocationCompletionIndex::Query(std::wstring_view prefix,
+	size_t maxResults) const
+{
+	if (prefix.empty() || maxResults == 0)
+	{
+		return {};
+	}
+
+	auto lookupPrefix = GetLookupPath(prefix);
+
+	std::vector<const Entry *> matchingEntries;
+
+	for (auto itr = m_entries.lower_bound(lookupPrefix);
+		 itr != m_entries.end() && itr->first.starts_with(lookupPrefix); ++itr)
+	{
+		matchingEntries.push_back(&itr->second);
+	}
+
+	auto numResults = (std::min)(maxResults, matchingEntries.size());
+	std::partial_sort(matchingEntries.begin(), matchingEntries.begin() + numResults,
+		matchingEntries.end(),
+		[](const Entry *entry1, const Entry *entry2)
+		{
+			if (entry1->rank != entry2->rank)
+			{
+				return entry1->rank > entry2->rank;
+			}
+
+			return entry1->sequenceNumber < entry2->sequenceNumber;
+		});
+
+	std::vector<std::wstring> results;
+	results.reserve(numResults);
+
+	for (size_t i = 0; i < numResults; i++)
+	{
+		results.push_back(matchingEntries[i]->path);
+	}
+
+	return results;
+}
+
+size_t LocationCompletionIndex::GetNumLocations() const
+{
+	return m_entries.size();
+}
+
+double LocationCompletionIndex::CalculateRank(const Entry &entry) const
+{
+	int numBaselineVisits = 1;
+
+	if ((entry.sources & static_cast<int>(Source::Bookmarks)) != 0)
+	{
+		numBaselineVisits += BOOKMARK_VISIT_BONUS;
+	}
+
+	double rank = LocationVisitInfo::GetVisitScore(m_referenceTime - UNKNOWN_VISIT_AGE)
+		+ std::log2(numBaselineVisits);
+
+	if (entry.visitScore)
+	{
+		rank = LocationVisitInfo::CombineScores(rank, *entry.visitScore);
+	}
+
+	return rank;
+}
+
+std::wstring LocationCompletionIndex::GetLookupPath(std::wstring_view path)
+{
+	std::wstring lookupPath(path);
+	CharLowerBuff(lookupPath.data(), static_cast<DWORD>(lookupPath.size()));
+	return lookupPath;
+}
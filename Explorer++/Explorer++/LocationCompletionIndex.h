@@ -0,0 +1,80 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <chrono>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// An in-memory index of locations (e.g. from history, frequently visited locations and bookmarks)
+// that can be queried by path prefix. It's designed to be queried each time the user types a
+// character, so a query only examines the locations that match the prefix, rather than every
+// location in the index.
+//
+// Matching locations are ranked by their visit score (see LocationVisitInfo), so the rank of each
+// location only needs to be calculated when the location is added, rather than on each query.
+class LocationCompletionIndex : private boost::noncopyable
+{
+public:
+	using Clock = std::chrono::system_clock;
+
+	enum class Source
+	{
+		History = 1 << 0,
+		FrequentLocations = 1 << 1,
+		Bookmarks = 1 << 2
+	};
+
+	// Every location is treated as having been visited once, this long before the reference time,
+	// in addition to any visits it has a score for. That means locations without a visit score
+	// (e.g. items from history) are still ranked, while having little effect on the ranking of
+	// locations that do have one.
+	static constexpr std::chrono::hours UNKNOWN_VISIT_AGE{ 24 * 30 };
+
+	explicit LocationCompletionIndex(Clock::time_point referenceTime = Clock::now());
+
+	// Adds a location to the index. The visit score, if provided, should be a score returned by
+	// LocationVisitInfo::GetScore(). If the location (compared without regard to case) is already
+	// present, the details are merged into the existing entry, so the same location can be added
+	// from multiple sources.
+	void AddLocation(const std::wstring &path, Source source,
+		std::optional<double> visitScore = std::nullopt);
+	void Clear();
+
+	// Returns up to maxResults locations whose path starts with the specified prefix (ignoring
+	// case), with the highest ranked locations first. Locations with the same rank are returned in
+	// the order they were added.
+	std::vector<std::wstring> Query(std::wstring_view prefix, size_t maxResults) const;
+
+	size_t GetNumLocations() const;
+
+	static std::wstring GetLookupPath(std::wstring_view path);
+
+private:
+	// Bookmarked locations are ranked as if they'd been visited this many more times (at the same
+	// time as the visit described above).
+	static constexpr int BOOKMARK_VISIT_BONUS = 2;
+
+	struct Entry
+	{
+		std::wstring path;
+		int sources = 0;
+		std::optional<double> visitScore;
+		uint64_t sequenceNumber = 0;
+		double rank = 0;
+	};
+
+	double CalculateRank(const Entry &entry) const;
+
+	const Clock::time_point m_referenceTime;
+
+	// Keyed by the lowercase path, so that all the locations with a particular prefix are adjacent.
+	std::map<std::wstring, Entry, std::less<>> m_entries;
+	uint64_t m_sequenceNumberCounter = 0;
+};
@@ -4,11 +4,10 @@
 
 #include "stdafx.h"
 #include "LocationVisitInfo.h"
+#include <cmath>
 
-LocationVisitInfo::LocationVisitInfo(const PidlAbsolute &pidl) :
-	m_pidl(pidl),
-	m_numVisits(1),
-	m_lastVisitTime(Clock::now())
+LocationVisitInfo::LocationVisitInfo(const PidlAbsolute &pidl, Clock::time_point visitTime) :
+	LocationVisitInfo(pidl, 1, visitTime, GetVisitScore(visitTime))
 {
 }
 
@@ -17,12 +16,25 @@ LocationVisitInfo::LocationVisitInfo(const PidlAbsolute &pidl, int numVisits) :
 	m_numVisits((std::max)(numVisits, 1)),
 	m_lastVisitTime(Clock::now())
 {
+	// This is equivalent to each of the visits having been made at the current time.
+	m_score = GetVisitScore(m_lastVisitTime) + std::log2(m_numVisits);
 }
 
-void LocationVisitInfo::AddVisit()
+LocationVisitInfo::LocationVisitInfo(const PidlAbsolute &pidl, int numVisits,
+	Clock::time_point lastVisitTime, double score) :
+	m_pidl(pidl),
+	m_numVisits((std::max)(numVisits, 1)),
+	m_lastVisitTime(lastVisitTime),
+	m_score(score)
+{
+}
+
+void LocationVisitInfo::AddVisit(Clock::time_point visitTime)
 {
 	m_numVisits++;
-	m_lastVisitTime = Clock::now();
+	m_lastVisitTime = (std::max)(m_lastVisitTime, visitTime);
+
+	m_score = CombineScores(m_score, GetVisitScore(visitTime));
 }
 
 PidlAbsolute LocationVisitInfo::GetLocation() const
@@ -39,3 +51,21 @@ LocationVisitInfo::Clock::time_point LocationVisitInfo::GetLastVisitTime() const
 {
 	return m_lastVisitTime;
 }
+
+double LocationVisitInfo::GetScore() const
+{
+	return m_score;
+}
+
+double LocationVisitInfo::GetVisitScore(Clock::time_point visitTime)
+{
+	return std::chrono::duration<double>(visitTime - SCORE_EPOCH)
+		/ std::chrono::duration<double>(VISIT_HALF_LIFE);
+}
+
+double LocationVisitInfo::CombineScores(double score1, double score2)
+{
+	// This calculates log2(2^score1 + 2^score2), without the intermediate values overflowing.
+	double maxScore = (std::max)(score1, score2);
+	return maxScore + std::log2(1 + std::exp2(-std::abs(score1 - score2)));
+}
@@ -8,21 +8,47 @@
 #include <chrono>
 
 // Holds information about visits to a particular location (identified by its pidl).
+//
+// Each location has a score, which combines how often and how recently the location has been
+// visited. Every visit contributes a weight to the score, with the weight halving every
+// VISIT_HALF_LIFE. The weight is calculated relative to a fixed point in time (rather than the
+// current time), so a more recent visit simply has a larger weight. Since the weight of every
+// visit decays at the same rate, the relative order of two scores never changes over time, which
+// means that locations can be kept sorted by score and only need to be repositioned when visited.
+//
+// The weights grow exponentially over time, so the score is stored as the base-2 logarithm of the
+// sum of the weights.
 class LocationVisitInfo
 {
 public:
 	using Clock = std::chrono::system_clock;
 
-	LocationVisitInfo(const PidlAbsolute &pidl);
+	static constexpr std::chrono::hours VISIT_HALF_LIFE = std::chrono::days(14);
+
+	LocationVisitInfo(const PidlAbsolute &pidl, Clock::time_point visitTime = Clock::now());
 	LocationVisitInfo(const PidlAbsolute &pidl, int numVisits);
+	LocationVisitInfo(const PidlAbsolute &pidl, int numVisits, Clock::time_point lastVisitTime,
+		double score);
 
-	void AddVisit();
+	void AddVisit(Clock::time_point visitTime = Clock::now());
 	PidlAbsolute GetLocation() const;
 	int GetNumVisits() const;
 	Clock::time_point GetLastVisitTime() const;
+	double GetScore() const;
+
+	// Returns the score of a location that's been visited a single time, at the specified time.
+	static double GetVisitScore(Clock::time_point visitTime);
+
+	// Returns the score that results from combining the visits represented by two scores.
+	static double CombineScores(double score1, double score2);
 
 private:
+	static constexpr std::chrono::sys_days SCORE_EPOCH =
+		std::chrono::year_month_day(std::chrono::year(2024), std::chrono::January,
+			std::chrono::day(1));
+
 	PidlAbsolute m_pidl;
 	int m_numVisits;
 	Clock::time_point m_lastVisitTime;
+	double m_score;
 };
@@ -78,6 +78,12 @@ void Explorerplusplus::InitializeMainMenu()
 	if (!FeatureList::GetInstance()->IsEnabled(Feature::Plugins))
 	{
 		DeleteMenu(mainMenu, IDM_TOOLS_RUNSCRIPT, MF_BYCOMMAND);
+		DeleteMenu(mainMenu, IDM_TOOLS_PLUGIN_DIAGNOSTICS, MF_BYCOMMAND);
+	}
+
+	if (!FeatureList::GetInstance()->IsEnabled(Feature::PerformanceTracing))
+	{
+		DeleteMenu(mainMenu, IDM_TOOLS_PERFORMANCE_TRACE, MF_BYCOMMAND);
 	}
 
 	SetMenu(m_hContainer, mainMenu);
@@ -92,7 +98,7 @@ void Explorerplusplus::InitializeMainMenu()
 	m_globalHistoryMenuView = std::make_unique<MainMenuSubMenuView>(mainMenu, IDM_GO_HISTORY);
 	m_globalHistoryMenu = std::make_unique<GlobalHistoryMenu>(m_globalHistoryMenuView.get(),
 		HistoryServiceFactory::GetInstance()->GetHistoryService(), this, &m_iconFetcher,
-		MENU_GLOBAL_HISTORY_START_ID, MENU_GLOBAL_HISTORY_END_ID);
+		&m_shellItemDetailsFetcher, MENU_GLOBAL_HISTORY_START_ID, MENU_GLOBAL_HISTORY_END_ID);
 
 	AddGetMenuItemHelperTextObserver(
 		std::bind_front(&Explorerplusplus::MaybeGetMenuItemHelperText, this));
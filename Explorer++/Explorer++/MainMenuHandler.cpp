@@ -17,6 +17,8 @@
 #include "MergeFilesDialog.h"
 #include "ModelessDialogs.h"
 #include "OptionsDialog.h"
+#include "PerformanceTraceDialog.h"
+#include "PluginDiagnosticsDialog.h"
 #include "ScriptingDialog.h"
 #include "SearchDialog.h"
 #include "SearchTabsDialog.h"
@@ -137,6 +139,36 @@ void Explorerplusplus::OnRunScript()
 	}
 }
 
+void Explorerplusplus::OnShowPerformanceTrace()
+{
+	if (g_hwndPerformanceTrace == nullptr)
+	{
+		auto *performanceTraceDialog =
+			PerformanceTraceDialog::Create(m_resourceInstance, m_hContainer);
+		g_hwndPerformanceTrace = performanceTraceDialog->ShowModelessDialog(
+			[]() { g_hwndPerformanceTrace = nullptr; });
+	}
+	else
+	{
+		SetFocus(g_hwndPerformanceTrace);
+	}
+}
+
+void Explorerplusplus::OnShowPluginDiagnostics()
+{
+	if (g_hwndPluginDiagnostics == nullptr)
+	{
+		auto *pluginDiagnosticsDialog =
+			PluginDiagnosticsDialog::Create(m_resourceInstance, m_hContainer, &m_pluginProfiler);
+		g_hwndPluginDiagnostics = pluginDiagnosticsDialog->ShowModelessDialog(
+			[]() { g_hwndPluginDiagnostics = nullptr; });
+	}
+	else
+	{
+		SetFocus(g_hwndPluginDiagnostics);
+	}
+}
+
 void Explorerplusplus::OnShowOptions()
 {
 	if (g_hwndOptions == nullptr)
@@ -68,21 +68,23 @@ const std::unordered_map<MainToolbarButton, Icon, ToolbarButtonHash> TOOLBAR_BUT
 
 MainToolbar *MainToolbar::Create(HWND parent, HINSTANCE resourceInstance,
 	BrowserWindow *browserWindow, CoreInterface *coreInterface, IconFetcher *iconFetcher,
-	std::shared_ptr<Config> config,
+	ShellItemDetailsFetcher *detailsFetcher, std::shared_ptr<Config> config,
 	const std::optional<MainToolbarStorage::MainToolbarButtons> &initialButtons)
 {
 	return new MainToolbar(parent, resourceInstance, browserWindow, coreInterface, iconFetcher,
-		config, initialButtons);
+		detailsFetcher, config, initialButtons);
 }
 
 MainToolbar::MainToolbar(HWND parent, HINSTANCE resourceInstance, BrowserWindow *browserWindow,
-	CoreInterface *coreInterface, IconFetcher *iconFetcher, std::shared_ptr<Config> config,
+	CoreInterface *coreInterface, IconFetcher *iconFetcher, ShellItemDetailsFetcher *detailsFetcher,
+	std::shared_ptr<Config> config,
 	const std::optional<MainToolbarStorage::MainToolbarButtons> &initialButtons) :
 	BaseWindow(CreateMainToolbar(parent)),
 	m_resourceInstance(resourceInstance),
 	m_browserWindow(browserWindow),
 	m_coreInterface(coreInterface),
 	m_iconFetcher(iconFetcher),
+	m_detailsFetcher(detailsFetcher),
 	m_config(config),
 	m_fontSetter(m_hwnd, config.get()),
 	m_tooltipFontSetter(reinterpret_cast<HWND>(SendMessage(m_hwnd, TB_GETTOOLTIPS, 0, 0)),
@@ -708,7 +710,7 @@ void MainToolbar::ShowHistoryMenu(TabHistoryMenu::MenuType historyType)
 void MainToolbar::ShowUpNavigationMenu()
 {
 	PopupMenuView popupMenu;
-	TabParentItemsMenu menu(&popupMenu, m_browserWindow, m_iconFetcher);
+	TabParentItemsMenu menu(&popupMenu, m_browserWindow, m_iconFetcher, m_detailsFetcher);
 	popupMenu.Show(m_hwnd, GetMenuPositionForButton(MainToolbarButton::Up));
 }
 
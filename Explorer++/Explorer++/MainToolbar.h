@@ -22,6 +22,7 @@
 class BrowserWindow;
 struct Config;
 class IconFetcher;
+class ShellItemDetailsFetcher;
 struct NavigateParams;
 
 class MainToolbar : public BaseWindow
@@ -29,7 +30,7 @@ class MainToolbar : public BaseWindow
 public:
 	static MainToolbar *Create(HWND parent, HINSTANCE resourceInstance,
 		BrowserWindow *browserWindow, CoreInterface *coreInterface, IconFetcher *iconFetcher,
-		std::shared_ptr<Config> config,
+		ShellItemDetailsFetcher *detailsFetcher, std::shared_ptr<Config> config,
 		const std::optional<MainToolbarStorage::MainToolbarButtons> &initialButtons);
 
 	void UpdateConfigDependentButtonStates();
@@ -42,7 +43,8 @@ public:
 
 private:
 	MainToolbar(HWND parent, HINSTANCE resourceInstance, BrowserWindow *browserWindow,
-		CoreInterface *coreInterface, IconFetcher *iconFetcher, std::shared_ptr<Config> config,
+		CoreInterface *coreInterface, IconFetcher *iconFetcher,
+		ShellItemDetailsFetcher *detailsFetcher, std::shared_ptr<Config> config,
 		const std::optional<MainToolbarStorage::MainToolbarButtons> &initialButtons);
 	~MainToolbar();
 
@@ -97,6 +99,7 @@ private:
 	BrowserWindow *m_browserWindow = nullptr;
 	CoreInterface *m_coreInterface = nullptr;
 	IconFetcher *m_iconFetcher = nullptr;
+	ShellItemDetailsFetcher *m_detailsFetcher = nullptr;
 	std::shared_ptr<Config> m_config;
 
 	wil::unique_himagelist m_imageListSmall;
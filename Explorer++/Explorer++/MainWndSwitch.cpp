@@ -32,17 +32,17 @@
 #include "ShellBrowser/ViewModes.h"
 #include "TabBacking.h"
 #include "TabContainer.h"
+#include "TabHibernationManager.h"
 #include "TabRestorer.h"
 #include "TabRestorerMenu.h"
 #include "../Helper/BulkClipboardWriter.h"
+#include "../Helper/CachedFormatter.h"
 #include "../Helper/Controls.h"
 #include "../Helper/ListViewHelper.h"
 #include "../Helper/Macros.h"
 #include "../Helper/ShellHelper.h"
 #include "../Helper/WindowHelper.h"
 
-static const int FOLDER_SIZE_LINE_INDEX = 1;
-
 /* Defines the distance between the cursor
 and the right edge of the treeview during
 a resizing operation. */
@@ -149,6 +149,20 @@ LRESULT CALLBACK Explorerplusplus::WindowProcedure(HWND hwnd, UINT Msg, WPARAM w
 
 			KillTimer(m_hContainer, LISTVIEW_ITEM_CHANGED_TIMER_ID);
 		}
+		else if (wParam == TAB_HIBERNATION_TIMER_ID)
+		{
+			m_tabHibernationManager->HibernateInactiveTabs();
+		}
+		else if (wParam == SETTINGS_CHANGED_TIMER_ID)
+		{
+			KillTimer(m_hContainer, SETTINGS_CHANGED_TIMER_ID);
+			SaveAllSettings();
+		}
+		else if (wParam == PLUGIN_EVENTS_TIMER_ID)
+		{
+			KillTimer(m_hContainer, PLUGIN_EVENTS_TIMER_ID);
+			m_pluginEventDispatcher.DeliverQueuedCalls();
+		}
 		break;
 
 	case WM_USER_UPDATEWINDOWS:
@@ -166,6 +180,17 @@ LRESULT CALLBACK Explorerplusplus::WindowProcedure(HWND hwnd, UINT Msg, WPARAM w
 	}
 	break;
 
+	case WM_USER_DIRECTORYCHANGED:
+	{
+		Tab *tab = GetActivePane()->GetTabContainer()->GetTabOptional(static_cast<int>(wParam));
+
+		if (tab)
+		{
+			tab->GetShellBrowser()->InvalidateCachedSnapshot(static_cast<int>(lParam));
+		}
+	}
+	break;
+
 	case WM_USER_DISPLAYWINDOWRESIZED:
 		OnDisplayWindowResized(wParam);
 		break;
@@ -175,58 +200,6 @@ LRESULT CALLBACK Explorerplusplus::WindowProcedure(HWND hwnd, UINT Msg, WPARAM w
 			OnAssocChanged();
 			break;*/
 
-	case WM_APP_FOLDERSIZECOMPLETED:
-	{
-		DWFolderSizeCompletion *pDWFolderSizeCompletion = nullptr;
-		TCHAR szSizeString[64];
-		TCHAR szTotalSize[64];
-		BOOL bValid = FALSE;
-
-		pDWFolderSizeCompletion = (DWFolderSizeCompletion *) wParam;
-
-		std::list<DWFolderSize>::iterator itr;
-
-		/* First, make sure we should still display the
-		results (we won't if the listview selection has
-		changed, or this folder size was calculated for
-		a tab other than the current one). */
-		for (itr = m_DWFolderSizes.begin(); itr != m_DWFolderSizes.end(); itr++)
-		{
-			if (itr->uId == pDWFolderSizeCompletion->uId)
-			{
-				if (itr->iTabId == GetActivePane()->GetTabContainer()->GetSelectedTab().GetId())
-				{
-					bValid = itr->bValid;
-				}
-
-				m_DWFolderSizes.erase(itr);
-
-				break;
-			}
-		}
-
-		if (bValid)
-		{
-			auto displayFormat = m_config->globalFolderSettings.forceSize
-				? m_config->globalFolderSettings.sizeDisplayFormat
-				: +SizeDisplayFormat::None;
-			auto folderSizeText =
-				FormatSizeString(pDWFolderSizeCompletion->liFolderSize.QuadPart, displayFormat);
-
-			LoadString(m_resourceInstance, IDS_GENERAL_TOTALSIZE, szTotalSize,
-				SIZEOF_ARRAY(szTotalSize));
-
-			StringCchPrintf(szSizeString, SIZEOF_ARRAY(szSizeString), _T("%s: %s"), szTotalSize,
-				folderSizeText.c_str());
-
-			/* TODO: The line index should be stored in some other (variable) way. */
-			DisplayWindow_SetLine(m_hDisplayWindow, FOLDER_SIZE_LINE_INDEX, szSizeString);
-		}
-
-		free(pDWFolderSizeCompletion);
-	}
-	break;
-
 	case WM_COPYDATA:
 	{
 		auto *pcds = reinterpret_cast<COPYDATASTRUCT *>(lParam);
@@ -281,6 +254,10 @@ LRESULT CALLBACK Explorerplusplus::WindowProcedure(HWND hwnd, UINT Msg, WPARAM w
 		OnSettingChange(reinterpret_cast<const WCHAR *>(lParam));
 		break;
 
+	case WM_TIMECHANGE:
+		CachedFormatter::InvalidateAll();
+		break;
+
 	// COM calls (such as IDropTarget::DragEnter) can result in a call being made to PeekMessage().
 	// That method will then dispatch non-queued messages, with WM_CLOSE being one such message.
 	// That's an issue, as it means if a WM_CLOSE message is in the message queue when a COM method
@@ -299,6 +276,10 @@ LRESULT CALLBACK Explorerplusplus::WindowProcedure(HWND hwnd, UINT Msg, WPARAM w
 		RequestCloseApplication();
 		break;
 
+	case WM_APP_DELIVER_PLUGIN_EVENTS:
+		m_pluginEventDispatcher.DeliverQueuedCalls();
+		break;
+
 	case WM_DESTROY:
 		return OnDestroy();
 	}
@@ -1309,7 +1290,8 @@ LRESULT Explorerplusplus::HandleMenuOrToolbarButtonOrAccelerator(HWND hwnd, int
 		if (g_hwndManageBookmarks == nullptr)
 		{
 			auto *pManageBookmarksDialog = new ManageBookmarksDialog(m_resourceInstance, hwnd, this,
-				this, &m_iconFetcher, BookmarkTreeFactory::GetInstance()->GetBookmarkTree());
+				this, &m_iconFetcher, BookmarkTreeFactory::GetInstance()->GetBookmarkTree(),
+				BookmarkTreeFactory::GetInstance()->GetBookmarkSearchIndex());
 			g_hwndManageBookmarks = pManageBookmarksDialog->ShowModelessDialog(
 				[]() { g_hwndManageBookmarks = nullptr; });
 		}
@@ -1332,6 +1314,14 @@ LRESULT Explorerplusplus::HandleMenuOrToolbarButtonOrAccelerator(HWND hwnd, int
 		OnRunScript();
 		break;
 
+	case IDM_TOOLS_PERFORMANCE_TRACE:
+		OnShowPerformanceTrace();
+		break;
+
+	case IDM_TOOLS_PLUGIN_DIAGNOSTICS:
+		OnShowPluginDiagnostics();
+		break;
+
 	case IDM_TOOLS_OPTIONS:
 		OnShowOptions();
 		break;
@@ -40,6 +40,16 @@ void MenuView::AppendItem(UINT id, const std::wstring &text, wil::unique_hbitmap
 	DCHECK(didInsert);
 }
 
+void MenuView::SetItemText(UINT id, const std::wstring &text)
+{
+	MENUITEMINFO menuItemInfo = {};
+	menuItemInfo.cbSize = sizeof(menuItemInfo);
+	menuItemInfo.fMask = MIIM_STRING;
+	menuItemInfo.dwTypeData = const_cast<LPWSTR>(text.c_str());
+	auto res = SetMenuItemInfo(GetMenu(), id, false, &menuItemInfo);
+	CHECK(res);
+}
+
 void MenuView::SetBitmapForItem(UINT id, wil::unique_hbitmap bitmap)
 {
 	MENUITEMINFO menuItemInfo = {};
@@ -55,6 +65,13 @@ void MenuView::SetBitmapForItem(UINT id, wil::unique_hbitmap bitmap)
 	}
 }
 
+void MenuView::SetHelpTextForItem(UINT id, const std::wstring &helpText)
+{
+	auto itr = m_itemHelpTextMapping.find(id);
+	CHECK(itr != m_itemHelpTextMapping.end());
+	itr->second = helpText;
+}
+
 void MenuView::EnableItem(UINT id, bool enable)
 {
 	MenuHelper::EnableItem(GetMenu(), id, enable);
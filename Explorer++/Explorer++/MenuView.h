@@ -22,7 +22,9 @@ public:
 
 	void AppendItem(UINT id, const std::wstring &text, wil::unique_hbitmap bitmap = nullptr,
 		const std::wstring &helpText = L"");
+	void SetItemText(UINT id, const std::wstring &text);
 	void SetBitmapForItem(UINT id, wil::unique_hbitmap bitmap);
+	void SetHelpTextForItem(UINT id, const std::wstring &helpText);
 	void EnableItem(UINT id, bool enable);
 	void ClearMenu();
 	std::wstring GetHelpTextForItem(UINT id) const;
@@ -10,3 +10,5 @@ extern HWND g_hwndRunScript;
 extern HWND g_hwndOptions;
 extern HWND g_hwndManageBookmarks;
 extern HWND g_hwndSearchTabs;
+extern HWND g_hwndPerformanceTrace;
+extern HWND g_hwndPluginDiagnostics;
@@ -16,6 +16,7 @@
 #include "MainToolbar.h"
 #include "Plugins/PluginManager.h"
 #include "ResourceHelper.h"
+#include "SettingsChangeTracker.h"
 #include "ShellBrowser/ShellBrowserImpl.h"
 #include "ShellBrowser/ShellNavigationController.h"
 #include "ShellBrowser/ViewModes.h"
@@ -24,6 +25,7 @@
 #include "TabContainer.h"
 #include "ToolbarHelper.h"
 #include "../Helper/BulkClipboardWriter.h"
+#include "../Helper/CachedFormatter.h"
 #include "../Helper/Controls.h"
 #include "../Helper/DpiCompatibility.h"
 #include "../Helper/FileOperations.h"
@@ -39,6 +41,7 @@
 #include <glog/logging.h>
 #include <wil/resource.h>
 #include <algorithm>
+#include <chrono>
 
 void Explorerplusplus::TestConfigFile()
 {
@@ -80,6 +83,18 @@ void Explorerplusplus::LoadAllSettings()
 	to load settings. */
 	TestConfigFile();
 
+	// Each loading phase is timed, so that it's possible to see where time is being spent during
+	// startup.
+	auto runTimedPhase = [](const char *phaseName, auto &&phase)
+	{
+		auto start = std::chrono::steady_clock::now();
+		phase();
+		auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - start);
+		LOG(INFO) << "Settings load phase \"" << phaseName << "\" took " << duration.count()
+				  << "us";
+	};
+
 	std::unique_ptr<ILoadSave> loadSave;
 
 	/* Initialize the LoadSave interface. Note
@@ -88,7 +103,8 @@ void Explorerplusplus::LoadAllSettings()
 	methods to be different. */
 	if (m_bLoadSettingsFromXML)
 	{
-		loadSave = std::make_unique<LoadSaveXML>(this, TRUE);
+		runTimedPhase("ParseConfigFile",
+			[this, &loadSave] { loadSave = std::make_unique<LoadSaveXML>(this, TRUE); });
 
 		/* When loading from the config file, also
 		set the option to save back to it on exit. */
@@ -99,14 +115,14 @@ void Explorerplusplus::LoadAllSettings()
 		loadSave = std::make_unique<LoadSaveRegistry>(this);
 	}
 
-	loadSave->LoadBookmarks();
-	loadSave->LoadGenericSettings();
-	loadSave->LoadPreviousTabs();
-	loadSave->LoadDefaultColumns();
-	loadSave->LoadApplicationToolbar();
-	loadSave->LoadMainRebarInformation();
-	loadSave->LoadColorRules();
-	loadSave->LoadDialogStates();
+	runTimedPhase("Bookmarks", [&loadSave] { loadSave->LoadBookmarks(); });
+	runTimedPhase("GenericSettings", [&loadSave] { loadSave->LoadGenericSettings(); });
+	runTimedPhase("PreviousTabs", [&loadSave] { loadSave->LoadPreviousTabs(); });
+	runTimedPhase("DefaultColumns", [&loadSave] { loadSave->LoadDefaultColumns(); });
+	runTimedPhase("ApplicationToolbar", [&loadSave] { loadSave->LoadApplicationToolbar(); });
+	runTimedPhase("MainRebarInformation", [&loadSave] { loadSave->LoadMainRebarInformation(); });
+	runTimedPhase("ColorRules", [&loadSave] { loadSave->LoadColorRules(); });
+	runTimedPhase("DialogStates", [&loadSave] { loadSave->LoadDialogStates(); });
 
 	ValidateLoadedSettings();
 }
@@ -537,6 +553,11 @@ std::optional<LRESULT> Explorerplusplus::OnCtlColorStatic(HWND hwnd, HDC hdc)
 
 void Explorerplusplus::OnSettingChange(const WCHAR *systemParameter)
 {
+	// This notification is sent when the regional settings are changed (in which case
+	// systemParameter will be "intl"), as well as for a range of other settings. The cached date
+	// and size formatting data is cheap to rebuild, so it's simply invalidated in every case.
+	CachedFormatter::InvalidateAll();
+
 	// The "ImmersiveColorSet" change notification will be sent when the user changes the dark mode
 	// setting in Windows (or one of the individual Windows mode/app mode settings). Changes to the
 	// Windows mode settings will be ignored, as the app mode setting is what's used to determine
@@ -608,8 +629,11 @@ void Explorerplusplus::RequestCloseApplication()
 	// the plugins be destroyed automatically could result in objects
 	// being destroyed in the wrong order.
 	m_pluginManager.reset();
+	KillTimer(m_hContainer, PLUGIN_EVENTS_TIMER_ID);
 
 	KillTimer(m_hContainer, AUTOSAVE_TIMER_ID);
+	KillTimer(m_hContainer, TAB_HIBERNATION_TIMER_ID);
+	KillTimer(m_hContainer, SETTINGS_CHANGED_TIMER_ID);
 
 	SaveAllSettings();
 
@@ -1096,14 +1120,44 @@ void Explorerplusplus::SaveAllSettings()
 		loadSave = std::make_unique<LoadSaveRegistry>(this);
 	}
 
+	// The config file is always rewritten in full, so every section needs to be included and the
+	// change tracker isn't used. Registry sections are stored separately, so sections that haven't
+	// changed can be skipped. A section is only marked as saved once it's been written
+	// successfully, so that a failed save will be retried.
+	auto saveSection = [this](SettingsChangeTracker::Section section, auto save)
+	{
+		if (m_bSavePreferencesToXMLFile)
+		{
+			save();
+			return;
+		}
+
+		if (m_settingsChangeTracker->HasChanged(section) && save())
+		{
+			m_settingsChangeTracker->ClearChanged(section);
+		}
+	};
+
 	loadSave->SaveGenericSettings();
 	loadSave->SaveTabs();
 	loadSave->SaveDefaultColumns();
-	loadSave->SaveBookmarks();
-	loadSave->SaveApplicationToolbar();
+	saveSection(SettingsChangeTracker::Section::Bookmarks,
+		[&loadSave] { return loadSave->SaveBookmarks(); });
+	saveSection(SettingsChangeTracker::Section::ApplicationToolbar,
+		[&loadSave] { return loadSave->SaveApplicationToolbar(); });
 	loadSave->SaveMainRebarInformation();
-	loadSave->SaveColorRules();
+	saveSection(SettingsChangeTracker::Section::ColorRules,
+		[&loadSave] { return loadSave->SaveColorRules(); });
+
 	loadSave->SaveDialogStates();
+
+	SaveClosedTabs();
+}
+
+void Explorerplusplus::OnSettingsChanged()
+{
+	// Calling SetTimer() with an existing timer ID resets the timer.
+	SetTimer(m_hContainer, SETTINGS_CHANGED_TIMER_ID, SETTINGS_CHANGED_SAVE_DELAY, nullptr);
 }
 
 const Config *Explorerplusplus::GetConfig() const
@@ -1166,6 +1220,16 @@ CachedIcons *Explorerplusplus::GetCachedIcons()
 	return &m_cachedIcons;
 }
 
+TaskScheduler *Explorerplusplus::GetTaskScheduler()
+{
+	return &m_taskScheduler;
+}
+
+Plugins::PluginColumnManager *Explorerplusplus::GetPluginColumnManager()
+{
+	return &m_pluginColumnManager;
+}
+
 BOOL Explorerplusplus::GetSavePreferencesToXmlFile() const
 {
 	return m_bSavePreferencesToXMLFile;
@@ -1174,6 +1238,10 @@ BOOL Explorerplusplus::GetSavePreferencesToXmlFile() const
 void Explorerplusplus::SetSavePreferencesToXmlFile(BOOL savePreferencesToXmlFile)
 {
 	m_bSavePreferencesToXMLFile = savePreferencesToXmlFile;
+
+	// The settings stored in the new location may be out of date, so everything needs to be written
+	// the next time settings are saved.
+	m_settingsChangeTracker->MarkAllChanged();
 }
 
 void Explorerplusplus::OnShowHiddenFiles()
@@ -4,9 +4,10 @@
 
 #include "stdafx.h"
 #include "PasteSymLinksClient.h"
-#include <cereal/archives/binary.hpp>
+#include <execution>
 
-void PasteSymLinksClient::NotifyServerOfResult(const ClipboardOperations::PastedItems &pastedItems)
+void PasteSymLinksClient::CreateLinksAndNotifyServer(LinkCreator linkCreator,
+	std::chrono::milliseconds timeout)
 {
 	try
 	{
@@ -20,15 +21,60 @@ void PasteSymLinksClient::NotifyServerOfResult(const ClipboardOperations::Pasted
 			return;
 		}
 
-		std::stringstream stringstream;
-		cereal::BinaryOutputArchive outputArchive(stringstream);
+		std::vector<std::wstring> sourcePaths;
+		ClipboardOperations::PastedItems pastedItems;
+		std::string message;
+		bool finished = false;
 
-		outputArchive(pastedItems);
+		while (!finished)
+		{
+			sourcePaths.clear();
+
+			while (sourcePaths.size() < MAX_BATCH_SIZE)
+			{
+				auto readResult = ReadMessage(sharedData->requests, message, timeout);
+
+				if (readResult == ReadResult::EndOfStream)
+				{
+					finished = true;
+					break;
+				}
+
+				std::optional<std::wstring> sourcePath;
+
+				if (readResult == ReadResult::Message)
+				{
+					sourcePath = DeserializeRequest(message);
+				}
+
+				if (!sourcePath)
+				{
+					Abandon(sharedData->requests);
+					Abandon(sharedData->results);
+					return;
+				}
 
-		sharedData->serializedResultData = stringstream.view();
+				sourcePaths.push_back(*sourcePath);
+			}
 
-		boost::interprocess::scoped_lock lock(sharedData->resultMutex);
-		sharedData->resultCondition.notify_all();
+			// Each link is independent, so the links in each batch are created in parallel. The
+			// results are still sent back in the same order as the requests.
+			pastedItems.resize(sourcePaths.size());
+			std::transform(std::execution::par, sourcePaths.begin(), sourcePaths.end(),
+				pastedItems.begin(), linkCreator);
+
+			for (const auto &pastedItem : pastedItems)
+			{
+				if (!WriteMessage(sharedData->results, SerializeResult(pastedItem), timeout))
+				{
+					Abandon(sharedData->requests);
+					Abandon(sharedData->results);
+					return;
+				}
+			}
+		}
+
+		FinishWriting(sharedData->results);
 	}
 	catch (const boost::interprocess::interprocess_exception &e)
 	{
@@ -36,10 +82,4 @@ void PasteSymLinksClient::NotifyServerOfResult(const ClipboardOperations::Pasted
 		// server is gone).
 		LOG(ERROR) << e.what();
 	}
-	catch (const boost::container::length_error &e)
-	{
-		// If this exception is thrown, it indicates that the shared memory isn't large enough to
-		// hold the serialized string.
-		LOG(ERROR) << e.what();
-	}
 }
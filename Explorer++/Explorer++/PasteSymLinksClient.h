@@ -6,9 +6,21 @@
 
 #include "ClipboardOperations.h"
 #include "PasteSymLinksServerClientBase.h"
+#include <chrono>
+#include <functional>
+#include <string>
 
 class PasteSymLinksClient : public PasteSymLinksServerClientBase
 {
 public:
-	void NotifyServerOfResult(const ClipboardOperations::PastedItems &pastedItems);
+	using LinkCreator =
+		std::function<ClipboardOperations::PastedItem(const std::wstring &sourcePath)>;
+
+	// The maximum number of requests that are read before the links for those requests are
+	// created.
+	static constexpr size_t MAX_BATCH_SIZE = 64;
+
+	// Reads the requests sent by the server, creates a link for each one (using the provided
+	// function, which will be called concurrently) and streams the results back to the server.
+	void CreateLinksAndNotifyServer(LinkCreator linkCreator, std::chrono::milliseconds timeout);
 };
@@ -4,10 +4,11 @@
 
 #include "stdafx.h"
 #include "PasteSymLinksServer.h"
-#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <thread>
 
 ClipboardOperations::PastedItems PasteSymLinksServer::LaunchClientAndWaitForResponse(
-	std::function<bool()> clientLauncher, std::chrono::milliseconds responseTimeout)
+	const std::vector<std::wstring> &sourcePaths, std::function<bool()> clientLauncher,
+	std::chrono::milliseconds responseTimeout)
 {
 	try
 	{
@@ -15,29 +16,61 @@ ClipboardOperations::PastedItems PasteSymLinksServer::LaunchClientAndWaitForResp
 		// explicit removal, since it will be destroyed once all handles are closed.
 		Segment segment(boost::interprocess::create_only, SHARED_MEMORY_NAME, SHARED_MEMORY_SIZE);
 
-		const CharAllocator allocator(segment.get_segment_manager());
-		auto *sharedData = segment.construct<SharedData>(SHARED_DATA_NAME)(allocator);
-
-		boost::interprocess::scoped_lock lock(sharedData->resultMutex);
+		auto *sharedData = segment.construct<SharedData>(SHARED_DATA_NAME)();
 
 		if (!clientLauncher())
 		{
 			return {};
 		}
 
-		auto waitResult = sharedData->resultCondition.wait_for(lock, responseTimeout);
+		// The requests are written on a separate thread, so that the results can be read at the
+		// same time. If both were done on this thread, the client could block waiting for space
+		// in the result channel, while this thread was blocked waiting for space in the request
+		// channel.
+		std::jthread requestWriter(
+			[sharedData, &sourcePaths, responseTimeout]
+			{
+				for (const auto &sourcePath : sourcePaths)
+				{
+					if (!WriteMessage(sharedData->requests, SerializeRequest(sourcePath),
+							responseTimeout))
+					{
+						return;
+					}
+				}
+
+				FinishWriting(sharedData->requests);
+			});
+
+		ClipboardOperations::PastedItems pastedItems;
+		std::string message;
 
-		if (waitResult == boost::interprocess::cv_status::timeout)
+		while (true)
 		{
-			return {};
-		}
+			auto readResult = ReadMessage(sharedData->results, message, responseTimeout);
 
-		std::stringstream stringstream;
-		stringstream << sharedData->serializedResultData;
-		cereal::BinaryInputArchive inputArchive(stringstream);
+			if (readResult == ReadResult::EndOfStream)
+			{
+				break;
+			}
 
-		ClipboardOperations::PastedItems pastedItems;
-		inputArchive(pastedItems);
+			std::optional<ClipboardOperations::PastedItem> pastedItem;
+
+			if (readResult == ReadResult::Message)
+			{
+				pastedItem = DeserializeResult(message);
+			}
+
+			if (!pastedItem)
+			{
+				// This will also stop the request writer, if it's still waiting on the client.
+				Abandon(sharedData->requests);
+				Abandon(sharedData->results);
+				return {};
+			}
+
+			pastedItems.push_back(*pastedItem);
+		}
 
 		return pastedItems;
 	}
@@ -8,10 +8,17 @@
 #include "PasteSymLinksServerClientBase.h"
 #include <chrono>
 #include <functional>
+#include <string>
+#include <vector>
 
 class PasteSymLinksServer : public PasteSymLinksServerClientBase
 {
 public:
+	// Sends the source paths to the client and returns the results the client sends back, in the
+	// same order. The timeout applies to each wait for the client, so a large paste won't time out
+	// as long as the client continues to make progress. If the exchange fails at any point, an
+	// empty result will be returned.
 	ClipboardOperations::PastedItems LaunchClientAndWaitForResponse(
-		std::function<bool()> clientLauncher, std::chrono::milliseconds responseTimeout);
+		const std::vector<std::wstring> &sourcePaths, std::function<bool()> clientLauncher,
+		std::chrono::milliseconds responseTimeout);
 };
@@ -0,0 +1,196 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "PasteSymLinksServerClientBase.h"
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <sstream>
+
+bool PasteSymLinksServerClientBase::WriteMessage(Channel &channel, std::string_view message,
+	std::chrono::milliseconds timeout)
+{
+	if (message.size() > MAX_MESSAGE_SIZE)
+	{
+		return false;
+	}
+
+	auto size = static_cast<uint32_t>(message.size());
+
+	return WriteBytes(channel, reinterpret_cast<const char *>(&size), sizeof(size), timeout)
+		&& WriteBytes(channel, message.data(), message.size(), timeout);
+}
+
+PasteSymLinksServerClientBase::ReadResult PasteSymLinksServerClientBase::ReadMessage(
+	Channel &channel, std::string &message, std::chrono::milliseconds timeout)
+{
+	uint32_t size;
+	auto result = ReadBytes(channel, reinterpret_cast<char *>(&size), sizeof(size), timeout);
+
+	if (result != ReadResult::Message)
+	{
+		return result;
+	}
+
+	if (size > MAX_MESSAGE_SIZE)
+	{
+		return ReadResult::Failed;
+	}
+
+	message.resize(size);
+	result = ReadBytes(channel, message.data(), size, timeout);
+
+	// The stream should never end part way through a message.
+	if (result != ReadResult::Message)
+	{
+		return ReadResult::Failed;
+	}
+
+	return ReadResult::Message;
+}
+
+void PasteSymLinksServerClientBase::FinishWriting(Channel &channel)
+{
+	boost::interprocess::scoped_lock lock(channel.mutex);
+	channel.writerFinished = true;
+	channel.dataWritten.notify_all();
+}
+
+void PasteSymLinksServerClientBase::Abandon(Channel &channel)
+{
+	boost::interprocess::scoped_lock lock(channel.mutex);
+	channel.abandoned = true;
+	channel.dataWritten.notify_all();
+	channel.dataRead.notify_all();
+}
+
+bool PasteSymLinksServerClientBase::WriteBytes(Channel &channel, const char *data, size_t size,
+	std::chrono::milliseconds timeout)
+{
+	boost::interprocess::scoped_lock lock(channel.mutex);
+
+	while (size > 0)
+	{
+		auto hasSpace = [&channel]
+		{
+			return channel.abandoned
+				|| (channel.writeOffset - channel.readOffset) < CHANNEL_BUFFER_SIZE;
+		};
+
+		if (!channel.dataRead.wait_for(lock, timeout, hasSpace) || channel.abandoned)
+		{
+			return false;
+		}
+
+		size_t freeSpace = CHANNEL_BUFFER_SIZE - (channel.writeOffset - channel.readOffset);
+		size_t position = channel.writeOffset % CHANNEL_BUFFER_SIZE;
+
+		// The data is copied in up to the end of the buffer. Anything left over will be copied to
+		// the start of the buffer on the next iteration.
+		size_t numBytes = (std::min)({ size, freeSpace, CHANNEL_BUFFER_SIZE - position });
+		std::memcpy(channel.buffer + position, data, numBytes);
+
+		channel.writeOffset += numBytes;
+		data += numBytes;
+		size -= numBytes;
+
+		channel.dataWritten.notify_all();
+	}
+
+	return true;
+}
+
+PasteSymLinksServerClientBase::ReadResult PasteSymLinksServerClientBase::ReadBytes(
+	Channel &channel, char *data, size_t size, std::chrono::milliseconds timeout)
+{
+	boost::interprocess::scoped_lock lock(channel.mutex);
+
+	while (size > 0)
+	{
+		auto hasData = [&channel]
+		{
+			return channel.abandoned || channel.writerFinished
+				|| channel.writeOffset > channel.readOffset;
+		};
+
+		if (!channel.dataWritten.wait_for(lock, timeout, hasData) || channel.abandoned)
+		{
+			return ReadResult::Failed;
+		}
+
+		size_t availableData = channel.writeOffset - channel.readOffset;
+
+		if (availableData == 0)
+		{
+			// The writer has finished and all of its data has been read.
+			return ReadResult::EndOfStream;
+		}
+
+		size_t position = channel.readOffset % CHANNEL_BUFFER_SIZE;
+		size_t numBytes = (std::min)({ size, availableData, CHANNEL_BUFFER_SIZE - position });
+		std::memcpy(data, channel.buffer + position, numBytes);
+
+		channel.readOffset += numBytes;
+		data += numBytes;
+		size -= numBytes;
+
+		channel.dataRead.notify_all();
+	}
+
+	return ReadResult::Message;
+}
+
+std::string PasteSymLinksServerClientBase::SerializeRequest(const std::wstring &sourcePath)
+{
+	std::stringstream stringstream;
+	cereal::BinaryOutputArchive outputArchive(stringstream);
+	outputArchive(sourcePath);
+	return stringstream.str();
+}
+
+std::optional<std::wstring> PasteSymLinksServerClientBase::DeserializeRequest(
+	const std::string &message)
+{
+	try
+	{
+		std::stringstream stringstream(message);
+		cereal::BinaryInputArchive inputArchive(stringstream);
+
+		std::wstring sourcePath;
+		inputArchive(sourcePath);
+		return sourcePath;
+	}
+	catch (const cereal::Exception &e)
+	{
+		LOG(ERROR) << e.what();
+		return std::nullopt;
+	}
+}
+
+std::string PasteSymLinksServerClientBase::SerializeResult(
+	const ClipboardOperations::PastedItem &pastedItem)
+{
+	std::stringstream stringstream;
+	cereal::BinaryOutputArchive outputArchive(stringstream);
+	outputArchive(pastedItem);
+	return stringstream.str();
+}
+
+std::optional<ClipboardOperations::PastedItem> PasteSymLinksServerClientBase::DeserializeResult(
+	const std::string &message)
+{
+	try
+	{
+		std::stringstream stringstream(message);
+		cereal::BinaryInputArchive inputArchive(stringstream);
+
+		ClipboardOperations::PastedItem pastedItem;
+		inputArchive(pastedItem);
+		return pastedItem;
+	}
+	catch (const cereal::Exception &e)
+	{
+		LOG(ERROR) << e.what();
+		return std::nullopt;
+	}
+}
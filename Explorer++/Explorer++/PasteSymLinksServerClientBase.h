@@ -4,37 +4,101 @@
 
 #pragma once
 
+#include "ClipboardOperations.h"
 #include "ManagedWindowsSharedMemoryWrapper.h"
-#include <boost/interprocess/containers/string.hpp>
 #include <boost/interprocess/sync/interprocess_condition.hpp>
 #include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
 
+// The server (the original, unelevated, process) and the client (an elevated process) communicate
+// through a pair of channels in shared memory. The server streams the paths of the items to link
+// to over the request channel and the client streams back the result for each item over the result
+// channel.
+//
+// Each channel is a fixed-size ring buffer. A message is written as a 32-bit length, followed by
+// the serialized data, with the data being copied in as space becomes available. That means the
+// size of the shared memory segment is independent of the number of items being pasted (and the
+// length of their paths) and that a writer is blocked whenever its reader falls behind.
 class PasteSymLinksServerClientBase
 {
 public:
+	static constexpr size_t CHANNEL_BUFFER_SIZE = 16 * 1024;
 	static constexpr size_t SHARED_MEMORY_SIZE = 64 * 1024;
 
+	// Any message larger than this is treated as invalid.
+	static constexpr uint32_t MAX_MESSAGE_SIZE = 1024 * 1024;
+
+	// The maximum amount of time either side will wait for the other to make progress.
+	static constexpr std::chrono::milliseconds DEFAULT_TIMEOUT{ 10000 };
+
 	virtual ~PasteSymLinksServerClientBase() = default;
 
 protected:
 	using Segment = boost::interprocess::managed_windows_shared_memory;
-	using Manager = Segment::segment_manager;
-	template <typename T>
-	using Allocator = boost::interprocess::allocator<T, Manager>;
-	using CharAllocator = Allocator<char>;
-	using String = boost::interprocess::basic_string<char, std::char_traits<char>, CharAllocator>;
+
+	struct Channel
+	{
+		boost::interprocess::interprocess_mutex mutex;
+		boost::interprocess::interprocess_condition dataWritten;
+		boost::interprocess::interprocess_condition dataRead;
+
+		// These offsets only ever increase. The position within the buffer is the offset modulo
+		// the buffer size.
+		uint64_t readOffset = 0;
+		uint64_t writeOffset = 0;
+
+		// Set by the writer once it has written all of its messages.
+		bool writerFinished = false;
+
+		// Set by either side if it gives up on the exchange, so that the other side doesn't wait
+		// for data (or space) that will never arrive.
+		bool abandoned = false;
+
+		char buffer[CHANNEL_BUFFER_SIZE];
+	};
 
 	struct SharedData
 	{
-		boost::interprocess::interprocess_mutex resultMutex;
-		boost::interprocess::interprocess_condition resultCondition;
-		String serializedResultData;
+		Channel requests;
+		Channel results;
+	};
 
-		SharedData(const CharAllocator &allocator) : serializedResultData(allocator)
-		{
-		}
+	enum class ReadResult
+	{
+		Message,
+		EndOfStream,
+		Failed
 	};
 
 	static constexpr char SHARED_MEMORY_NAME[] = "Explorer++PasteSymLinksSharedMemory";
 	static constexpr char SHARED_DATA_NAME[] = "SharedData";
+
+	// Returns false if the message couldn't be written, either because the reader has abandoned
+	// the channel, or because no space became available within the timeout.
+	static bool WriteMessage(Channel &channel, std::string_view message,
+		std::chrono::milliseconds timeout);
+
+	// The timeout applies to each wait for data, rather than to the message as a whole.
+	static ReadResult ReadMessage(Channel &channel, std::string &message,
+		std::chrono::milliseconds timeout);
+
+	static void FinishWriting(Channel &channel);
+	static void Abandon(Channel &channel);
+
+	// The deserialization methods return an empty value if the message is invalid.
+	static std::string SerializeRequest(const std::wstring &sourcePath);
+	static std::optional<std::wstring> DeserializeRequest(const std::string &message);
+	static std::string SerializeResult(const ClipboardOperations::PastedItem &pastedItem);
+	static std::optional<ClipboardOperations::PastedItem> DeserializeResult(
+		const std::string &message);
+
+private:
+	static bool WriteBytes(Channel &channel, const char *data, size_t size,
+		std::chrono::milliseconds timeout);
+	static ReadResult ReadBytes(Channel &channel, char *data, size_t size,
+		std::chrono::milliseconds timeout);
 };
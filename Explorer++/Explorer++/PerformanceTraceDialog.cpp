@@ -0,0 +1,286 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "PerformanceTraceDialog.h"
+#include "Explorer++_internal.h"
+#include "MainResource.h"
+#include "ResourceHelper.h"
+#include "../Helper/PerformanceTracer.h"
+#include "../Helper/StringHelper.h"
+#include "../Helper/WindowHelper.h"
+#include <glog/logging.h>
+#include <format>
+
+namespace
+{
+
+std::wstring FormatMilliseconds(PerformanceTracer::Clock::duration duration)
+{
+	return std::format(L"{:.3f}",
+		std::chrono::duration<double, std::milli>(duration).count());
+}
+
+}
+
+PerformanceTraceDialog *PerformanceTraceDialog::Create(HINSTANCE resourceInstance, HWND parent)
+{
+	return new PerformanceTraceDialog(resourceInstance, parent);
+}
+
+PerformanceTraceDialog::PerformanceTraceDialog(HINSTANCE resourceInstance, HWND parent) :
+	ThemedDialog(resourceInstance, IDD_PERFORMANCE_TRACE, parent,
+		BaseDialog::DialogSizingType::Both),
+	m_persistentSettings(&PerformanceTraceDialogPersistentSettings::GetInstance())
+{
+}
+
+INT_PTR PerformanceTraceDialog::OnInitDialog()
+{
+	SetupListView();
+
+	m_persistentSettings->RestoreDialogPosition(m_hDlg, true);
+
+	return TRUE;
+}
+
+wil::unique_hicon PerformanceTraceDialog::GetDialogIcon(int iconWidth, int iconHeight) const
+{
+	UNREFERENCED_PARAMETER(iconWidth);
+	UNREFERENCED_PARAMETER(iconHeight);
+
+	return wil::unique_hicon(LoadIcon(GetModuleHandle(nullptr), MAKEINTRESOURCE(IDI_MAIN)));
+}
+
+std::vector<ResizableDialogControl> PerformanceTraceDialog::GetResizableControls()
+{
+	std::vector<ResizableDialogControl> controls;
+	controls.emplace_back(GetDlgItem(m_hDlg, IDC_PERFORMANCE_TRACE_LIST), MovingType::None,
+		SizingType::Both);
+	controls.emplace_back(GetDlgItem(m_hDlg, IDC_PERFORMANCE_TRACE_REFRESH),
+		MovingType::Vertical, SizingType::None);
+	controls.emplace_back(GetDlgItem(m_hDlg, IDC_PERFORMANCE_TRACE_RESET), MovingType::Vertical,
+		SizingType::None);
+	controls.emplace_back(GetDlgItem(m_hDlg, IDC_PERFORMANCE_TRACE_EXPORT),
+		MovingType::Vertical, SizingType::None);
+	controls.emplace_back(GetDlgItem(m_hDlg, IDCANCEL), MovingType::Both, SizingType::None);
+	return controls;
+}
+
+void PerformanceTraceDialog::SetupListView()
+{
+	HWND listView = GetDlgItem(m_hDlg, IDC_PERFORMANCE_TRACE_LIST);
+	ListView_SetExtendedListViewStyle(listView,
+		LVS_EX_LABELTIP | LVS_EX_FULLROWSELECT | LVS_EX_DOUBLEBUFFER);
+
+	int index = 0;
+
+	for (auto column : COLUMNS)
+	{
+		InsertColumn(column, index);
+		index++;
+	}
+
+	RefreshSummaries();
+}
+
+void PerformanceTraceDialog::InsertColumn(const Column &column, int index)
+{
+	std::wstring columnText =
+		ResourceHelper::LoadString(GetResourceInstance(), GetColumnTextStringId(column.type));
+
+	RECT listViewRect;
+	HWND listView = GetDlgItem(m_hDlg, IDC_PERFORMANCE_TRACE_LIST);
+	[[maybe_unused]] auto res = GetClientRect(listView, &listViewRect);
+	assert(res);
+
+	LVCOLUMN lvColumn = {};
+	lvColumn.mask = LVCF_TEXT | LVCF_WIDTH;
+	lvColumn.pszText = columnText.data();
+	lvColumn.cx = static_cast<int>(column.percentageWidth * GetRectWidth(&listViewRect));
+	[[maybe_unused]] int insertedIndex = ListView_InsertColumn(listView, index, &lvColumn);
+	assert(insertedIndex == index);
+}
+
+UINT PerformanceTraceDialog::GetColumnTextStringId(ColumnType columnType)
+{
+	switch (columnType)
+	{
+	case ColumnType::Category:
+		return IDS_PERFORMANCE_TRACE_COLUMN_CATEGORY;
+
+	case ColumnType::Name:
+		return IDS_PERFORMANCE_TRACE_COLUMN_NAME;
+
+	case ColumnType::Type:
+		return IDS_PERFORMANCE_TRACE_COLUMN_TYPE;
+
+	case ColumnType::Count:
+		return IDS_PERFORMANCE_TRACE_COLUMN_COUNT;
+
+	case ColumnType::Total:
+		return IDS_PERFORMANCE_TRACE_COLUMN_TOTAL;
+
+	case ColumnType::Average:
+		return IDS_PERFORMANCE_TRACE_COLUMN_AVERAGE;
+
+	case ColumnType::Maximum:
+		return IDS_PERFORMANCE_TRACE_COLUMN_MAXIMUM;
+
+	default:
+		LOG(FATAL) << "Performance trace column type not found";
+		__assume(0);
+	}
+}
+
+void PerformanceTraceDialog::RefreshSummaries()
+{
+	HWND listView = GetDlgItem(m_hDlg, IDC_PERFORMANCE_TRACE_LIST);
+	SendMessage(listView, WM_SETREDRAW, FALSE, NULL);
+
+	ListView_DeleteAllItems(listView);
+
+	const auto &tracer = PerformanceTracer::GetInstance();
+	auto spanText = ResourceHelper::LoadString(GetResourceInstance(),
+		IDS_PERFORMANCE_TRACE_TYPE_SPAN);
+	auto counterText = ResourceHelper::LoadString(GetResourceInstance(),
+		IDS_PERFORMANCE_TRACE_TYPE_COUNTER);
+
+	for (const auto &summary : tracer.GetSpanSummaries())
+	{
+		AddRow({ utf8StrToWstr(std::string(summary.category)),
+			utf8StrToWstr(std::string(summary.name)), spanText, std::to_wstring(summary.count),
+			FormatMilliseconds(summary.totalDuration),
+			FormatMilliseconds(summary.totalDuration / summary.count),
+			FormatMilliseconds(summary.maxDuration) });
+	}
+
+	for (const auto &summary : tracer.GetCounterSummaries())
+	{
+		AddRow({ utf8StrToWstr(std::string(summary.category)),
+			utf8StrToWstr(std::string(summary.name)), counterText,
+			std::to_wstring(summary.value), L"", L"", std::to_wstring(summary.maxValue) });
+	}
+
+	SendMessage(listView, WM_SETREDRAW, TRUE, NULL);
+}
+
+void PerformanceTraceDialog::AddRow(const std::vector<std::wstring> &columnText)
+{
+	DCHECK_EQ(columnText.size(), std::size(COLUMNS));
+
+	HWND listView = GetDlgItem(m_hDlg, IDC_PERFORMANCE_TRACE_LIST);
+
+	std::wstring firstColumnText = columnText[0];
+
+	LVITEM item = {};
+	item.mask = LVIF_TEXT;
+	item.iItem = ListView_GetItemCount(listView);
+	item.iSubItem = 0;
+	item.pszText = firstColumnText.data();
+	int index = ListView_InsertItem(listView, &item);
+	CHECK_NE(index, -1);
+
+	for (int i = 1; i < std::ssize(columnText); i++)
+	{
+		std::wstring text = columnText[i];
+		ListView_SetItemText(listView, index, i, text.data());
+	}
+}
+
+INT_PTR PerformanceTraceDialog::OnCommand(WPARAM wParam, LPARAM lParam)
+{
+	UNREFERENCED_PARAMETER(lParam);
+
+	switch (LOWORD(wParam))
+	{
+	case IDC_PERFORMANCE_TRACE_REFRESH:
+		RefreshSummaries();
+		break;
+
+	case IDC_PERFORMANCE_TRACE_RESET:
+		OnReset();
+		break;
+
+	case IDC_PERFORMANCE_TRACE_EXPORT:
+		OnExport();
+		break;
+
+	case IDCANCEL:
+		DestroyWindow(m_hDlg);
+		break;
+	}
+
+	return 0;
+}
+
+void PerformanceTraceDialog::OnReset()
+{
+	PerformanceTracer::GetInstance().Clear();
+	RefreshSummaries();
+}
+
+void PerformanceTraceDialog::OnExport()
+{
+	// The filter consists of pairs of null-terminated strings, with the entire list terminated by
+	// an additional null character.
+	std::wstring filter =
+		ResourceHelper::LoadString(GetResourceInstance(), IDS_PERFORMANCE_TRACE_FILTER);
+	filter += L'\0';
+	filter += L"*.json";
+	filter += L'\0';
+
+	TCHAR fileName[MAX_PATH] = L"trace.json";
+
+	OPENFILENAME ofn = {};
+	ofn.lStructSize = sizeof(ofn);
+	ofn.hwndOwner = m_hDlg;
+	ofn.lpstrFilter = filter.c_str();
+	ofn.lpstrFile = fileName;
+	ofn.nMaxFile = static_cast<DWORD>(std::size(fileName));
+	ofn.Flags = OFN_ENABLESIZING | OFN_OVERWRITEPROMPT | OFN_EXPLORER;
+	ofn.lpstrDefExt = L"json";
+
+	if (!GetSaveFileName(&ofn))
+	{
+		return;
+	}
+
+	if (!PerformanceTracer::GetInstance().ExportTrace(fileName))
+	{
+		auto message =
+			ResourceHelper::LoadString(GetResourceInstance(), IDS_PERFORMANCE_TRACE_EXPORT_FAILED);
+		MessageBox(m_hDlg, message.c_str(), NExplorerplusplus::APP_NAME, MB_ICONWARNING | MB_OK);
+	}
+}
+
+INT_PTR PerformanceTraceDialog::OnClose()
+{
+	DestroyWindow(m_hDlg);
+	return 0;
+}
+
+void PerformanceTraceDialog::SaveState()
+{
+	m_persistentSettings->SaveDialogPosition(m_hDlg);
+	m_persistentSettings->m_bStateSaved = TRUE;
+}
+
+INT_PTR PerformanceTraceDialog::OnNcDestroy()
+{
+	delete this;
+
+	return 0;
+}
+
+PerformanceTraceDialogPersistentSettings::PerformanceTraceDialogPersistentSettings() :
+	DialogSettings(SETTINGS_KEY.c_str())
+{
+}
+
+PerformanceTraceDialogPersistentSettings &PerformanceTraceDialogPersistentSettings::GetInstance()
+{
+	static PerformanceTraceDialogPersistentSettings persistentSettings;
+	return persistentSettings;
+}
@@ -0,0 +1,77 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "ThemedDialog.h"
+#include "../Helper/DialogSettings.h"
+#include <string>
+#include <vector>
+
+class PerformanceTraceDialog;
+
+class PerformanceTraceDialogPersistentSettings : public DialogSettings
+{
+public:
+	static PerformanceTraceDialogPersistentSettings &GetInstance();
+
+private:
+	friend PerformanceTraceDialog;
+
+	static const inline std::wstring SETTINGS_KEY = L"PerformanceTrace";
+
+	PerformanceTraceDialogPersistentSettings();
+};
+
+// Displays a summary of the spans and counters recorded by PerformanceTracer and allows the full
+// trace to be exported.
+class PerformanceTraceDialog : public ThemedDialog
+{
+public:
+	static PerformanceTraceDialog *Create(HINSTANCE resourceInstance, HWND parent);
+
+private:
+	enum class ColumnType
+	{
+		Category,
+		Name,
+		Type,
+		Count,
+		Total,
+		Average,
+		Maximum
+	};
+
+	struct Column
+	{
+		ColumnType type;
+		float percentageWidth;
+	};
+
+	static inline const Column COLUMNS[] = { { ColumnType::Category, 0.16f },
+		{ ColumnType::Name, 0.24f }, { ColumnType::Type, 0.1f }, { ColumnType::Count, 0.12f },
+		{ ColumnType::Total, 0.12f }, { ColumnType::Average, 0.12f },
+		{ ColumnType::Maximum, 0.12f } };
+
+	PerformanceTraceDialog(HINSTANCE resourceInstance, HWND parent);
+
+	INT_PTR OnInitDialog() override;
+	wil::unique_hicon GetDialogIcon(int iconWidth, int iconHeight) const override;
+	std::vector<ResizableDialogControl> GetResizableControls() override;
+	void SetupListView();
+	void InsertColumn(const Column &column, int index);
+	UINT GetColumnTextStringId(ColumnType columnType);
+	void RefreshSummaries();
+	void AddRow(const std::vector<std::wstring> &columnText);
+
+	INT_PTR OnCommand(WPARAM wParam, LPARAM lParam) override;
+	void OnReset();
+	void OnExport();
+
+	INT_PTR OnClose() override;
+	void SaveState() override;
+	INT_PTR OnNcDestroy() override;
+
+	PerformanceTraceDialogPersistentSettings *m_persistentSettings;
+};
@@ -0,0 +1,257 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "PluginDiagnosticsDialog.h"
+#include "MainResource.h"
+#include "Plugins/PluginProfiler.h"
+#include "ResourceHelper.h"
+#include "../Helper/WindowHelper.h"
+#include <glog/logging.h>
+#include <format>
+
+namespace
+{
+
+std::wstring FormatMilliseconds(Plugins::PluginProfiler::Clock::duration duration)
+{
+	return std::format(L"{:.3f}",
+		std::chrono::duration<double, std::milli>(duration).count());
+}
+
+std::wstring FormatSlowestCalls(const std::vector<Plugins::PluginProfiler::Call> &slowestCalls)
+{
+	std::wstring text;
+
+	for (const auto &call : slowestCalls)
+	{
+		if (!text.empty())
+		{
+			text += L", ";
+		}
+
+		text += std::format(L"{} ({})", call.description, FormatMilliseconds(call.duration));
+	}
+
+	return text;
+}
+
+}
+
+PluginDiagnosticsDialog *PluginDiagnosticsDialog::Create(HINSTANCE resourceInstance, HWND parent,
+	Plugins::PluginProfiler *profiler)
+{
+	return new PluginDiagnosticsDialog(resourceInstance, parent, profiler);
+}
+
+PluginDiagnosticsDialog::PluginDiagnosticsDialog(HINSTANCE resourceInstance, HWND parent,
+	Plugins::PluginProfiler *profiler) :
+	ThemedDialog(resourceInstance, IDD_PLUGIN_DIAGNOSTICS, parent,
+		BaseDialog::DialogSizingType::Both),
+	m_profiler(profiler),
+	m_persistentSettings(&PluginDiagnosticsDialogPersistentSettings::GetInstance())
+{
+}
+
+INT_PTR PluginDiagnosticsDialog::OnInitDialog()
+{
+	SetupListView();
+
+	m_persistentSettings->RestoreDialogPosition(m_hDlg, true);
+
+	return TRUE;
+}
+
+wil::unique_hicon PluginDiagnosticsDialog::GetDialogIcon(int iconWidth, int iconHeight) const
+{
+	UNREFERENCED_PARAMETER(iconWidth);
+	UNREFERENCED_PARAMETER(iconHeight);
+
+	return wil::unique_hicon(LoadIcon(GetModuleHandle(nullptr), MAKEINTRESOURCE(IDI_MAIN)));
+}
+
+std::vector<ResizableDialogControl> PluginDiagnosticsDialog::GetResizableControls()
+{
+	std::vector<ResizableDialogControl> controls;
+	controls.emplace_back(GetDlgItem(m_hDlg, IDC_PLUGIN_DIAGNOSTICS_LIST), MovingType::None,
+		SizingType::Both);
+	controls.emplace_back(GetDlgItem(m_hDlg, IDC_PLUGIN_DIAGNOSTICS_REFRESH),
+		MovingType::Vertical, SizingType::None);
+	controls.emplace_back(GetDlgItem(m_hDlg, IDC_PLUGIN_DIAGNOSTICS_RESET), MovingType::Vertical,
+		SizingType::None);
+	controls.emplace_back(GetDlgItem(m_hDlg, IDCANCEL), MovingType::Both, SizingType::None);
+	return controls;
+}
+
+void PluginDiagnosticsDialog::SetupListView()
+{
+	HWND listView = GetDlgItem(m_hDlg, IDC_PLUGIN_DIAGNOSTICS_LIST);
+	ListView_SetExtendedListViewStyle(listView,
+		LVS_EX_LABELTIP | LVS_EX_FULLROWSELECT | LVS_EX_DOUBLEBUFFER);
+
+	int index = 0;
+
+	for (auto column : COLUMNS)
+	{
+		InsertColumn(column, index);
+		index++;
+	}
+
+	RefreshProfiles();
+}
+
+void PluginDiagnosticsDialog::InsertColumn(const Column &column, int index)
+{
+	std::wstring columnText =
+		ResourceHelper::LoadString(GetResourceInstance(), GetColumnTextStringId(column.type));
+
+	RECT listViewRect;
+	HWND listView = GetDlgItem(m_hDlg, IDC_PLUGIN_DIAGNOSTICS_LIST);
+	[[maybe_unused]] auto res = GetClientRect(listView, &listViewRect);
+	assert(res);
+
+	LVCOLUMN lvColumn = {};
+	lvColumn.mask = LVCF_TEXT | LVCF_WIDTH;
+	lvColumn.pszText = columnText.data();
+	lvColumn.cx = static_cast<int>(column.percentageWidth * GetRectWidth(&listViewRect));
+	[[maybe_unused]] int insertedIndex = ListView_InsertColumn(listView, index, &lvColumn);
+	assert(insertedIndex == index);
+}
+
+UINT PluginDiagnosticsDialog::GetColumnTextStringId(ColumnType columnType)
+{
+	switch (columnType)
+	{
+	case ColumnType::Plugin:
+		return IDS_PLUGIN_DIAGNOSTICS_COLUMN_PLUGIN;
+
+	case ColumnType::Calls:
+		return IDS_PLUGIN_DIAGNOSTICS_COLUMN_CALLS;
+
+	case ColumnType::Failed:
+		return IDS_PLUGIN_DIAGNOSTICS_COLUMN_FAILED;
+
+	case ColumnType::Deferred:
+		return IDS_PLUGIN_DIAGNOSTICS_COLUMN_DEFERRED;
+
+	case ColumnType::Total:
+		return IDS_PLUGIN_DIAGNOSTICS_COLUMN_TOTAL;
+
+	case ColumnType::Average:
+		return IDS_PLUGIN_DIAGNOSTICS_COLUMN_AVERAGE;
+
+	case ColumnType::Slowest:
+		return IDS_PLUGIN_DIAGNOSTICS_COLUMN_SLOWEST;
+
+	default:
+		LOG(FATAL) << "Plugin diagnostics column type not found";
+		__assume(0);
+	}
+}
+
+void PluginDiagnosticsDialog::RefreshProfiles()
+{
+	HWND listView = GetDlgItem(m_hDlg, IDC_PLUGIN_DIAGNOSTICS_LIST);
+	SendMessage(listView, WM_SETREDRAW, FALSE, NULL);
+
+	ListView_DeleteAllItems(listView);
+
+	for (const auto &[pluginId, profile] : m_profiler->GetProfiles())
+	{
+		std::wstring averageText;
+
+		if (profile.numCalls > 0)
+		{
+			averageText = FormatMilliseconds(profile.totalDuration / profile.numCalls);
+		}
+
+		AddRow({ profile.pluginName, std::to_wstring(profile.numCalls),
+			std::to_wstring(profile.numFailedCalls), std::to_wstring(profile.numDeferredCalls),
+			FormatMilliseconds(profile.totalDuration), averageText,
+			FormatSlowestCalls(profile.slowestCalls) });
+	}
+
+	SendMessage(listView, WM_SETREDRAW, TRUE, NULL);
+}
+
+void PluginDiagnosticsDialog::AddRow(const std::vector<std::wstring> &columnText)
+{
+	DCHECK_EQ(columnText.size(), std::size(COLUMNS));
+
+	HWND listView = GetDlgItem(m_hDlg, IDC_PLUGIN_DIAGNOSTICS_LIST);
+
+	std::wstring firstColumnText = columnText[0];
+
+	LVITEM item = {};
+	item.mask = LVIF_TEXT;
+	item.iItem = ListView_GetItemCount(listView);
+	item.iSubItem = 0;
+	item.pszText = firstColumnText.data();
+	int index = ListView_InsertItem(listView, &item);
+	CHECK_NE(index, -1);
+
+	for (int i = 1; i < std::ssize(columnText); i++)
+	{
+		std::wstring text = columnText[i];
+		ListView_SetItemText(listView, index, i, text.data());
+	}
+}
+
+INT_PTR PluginDiagnosticsDialog::OnCommand(WPARAM wParam, LPARAM lParam)
+{
+	UNREFERENCED_PARAMETER(lParam);
+
+	switch (LOWORD(wParam))
+	{
+	case IDC_PLUGIN_DIAGNOSTICS_REFRESH:
+		RefreshProfiles();
+		break;
+
+	case IDC_PLUGIN_DIAGNOSTICS_RESET:
+		OnReset();
+		break;
+
+	case IDCANCEL:
+		DestroyWindow(m_hDlg);
+		break;
+	}
+
+	return 0;
+}
+
+void PluginDiagnosticsDialog::OnReset()
+{
+	m_profiler->Reset();
+	RefreshProfiles();
+}
+
+INT_PTR PluginDiagnosticsDialog::OnClose()
+{
+	DestroyWindow(m_hDlg);
+	return 0;
+}
+
+void PluginDiagnosticsDialog::SaveState()
+{
+	m_persistentSettings->SaveDialogPosition(m_hDlg);
+	m_persistentSettings->m_bStateSaved = TRUE;
+}
+
+INT_PTR PluginDiagnosticsDialog::OnNcDestroy()
+{
+	delete this;
+
+	return 0;
+}
+
+PluginDiagnosticsDialogPersistentSettings::PluginDiagnosticsDialogPersistentSettings() :
+	DialogSettings(SETTINGS_KEY.c_str())
+{
+}
+
+PluginDiagnosticsDialogPersistentSettings &PluginDiagnosticsDialogPersistentSettings::GetInstance()
+{
+	static PluginDiagnosticsDialogPersistentSettings persistentSettings;
+	return persistentSettings;
+}
@@ -0,0 +1,84 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "ThemedDialog.h"
+#include "../Helper/DialogSettings.h"
+#include <string>
+#include <vector>
+
+namespace Plugins
+{
+class PluginProfiler;
+}
+
+class PluginDiagnosticsDialog;
+
+class PluginDiagnosticsDialogPersistentSettings : public DialogSettings
+{
+public:
+	static PluginDiagnosticsDialogPersistentSettings &GetInstance();
+
+private:
+	friend PluginDiagnosticsDialog;
+
+	static const inline std::wstring SETTINGS_KEY = L"PluginDiagnostics";
+
+	PluginDiagnosticsDialogPersistentSettings();
+};
+
+// Displays the data recorded by PluginProfiler, so that plugins which are slowing down the
+// application can be identified.
+class PluginDiagnosticsDialog : public ThemedDialog
+{
+public:
+	static PluginDiagnosticsDialog *Create(HINSTANCE resourceInstance, HWND parent,
+		Plugins::PluginProfiler *profiler);
+
+private:
+	enum class ColumnType
+	{
+		Plugin,
+		Calls,
+		Failed,
+		Deferred,
+		Total,
+		Average,
+		Slowest
+	};
+
+	struct Column
+	{
+		ColumnType type;
+		float percentageWidth;
+	};
+
+	static inline const Column COLUMNS[] = { { ColumnType::Plugin, 0.18f },
+		{ ColumnType::Calls, 0.08f }, { ColumnType::Failed, 0.08f },
+		{ ColumnType::Deferred, 0.09f }, { ColumnType::Total, 0.1f },
+		{ ColumnType::Average, 0.11f }, { ColumnType::Slowest, 0.34f } };
+
+	PluginDiagnosticsDialog(HINSTANCE resourceInstance, HWND parent,
+		Plugins::PluginProfiler *profiler);
+
+	INT_PTR OnInitDialog() override;
+	wil::unique_hicon GetDialogIcon(int iconWidth, int iconHeight) const override;
+	std::vector<ResizableDialogControl> GetResizableControls() override;
+	void SetupListView();
+	void InsertColumn(const Column &column, int index);
+	UINT GetColumnTextStringId(ColumnType columnType);
+	void RefreshProfiles();
+	void AddRow(const std::vector<std::wstring> &columnText);
+
+	INT_PTR OnCommand(WPARAM wParam, LPARAM lParam) override;
+	void OnReset();
+
+	INT_PTR OnClose() override;
+	void SaveState() override;
+	INT_PTR OnNcDestroy() override;
+
+	Plugins::PluginProfiler *m_profiler;
+	PluginDiagnosticsDialogPersistentSettings *m_persistentSettings;
+};
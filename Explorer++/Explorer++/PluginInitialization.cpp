@@ -33,3 +33,18 @@ void Explorerplusplus::InitializePlugins()
 
 	UpdateMenuAcceleratorStrings(GetMenu(m_hContainer), m_acceleratorManager);
 }
+
+void Explorerplusplus::SchedulePluginEventDelivery(
+	Plugins::PluginEventDispatcher::DeliveryTiming timing)
+{
+	switch (timing)
+	{
+	case Plugins::PluginEventDispatcher::DeliveryTiming::NextMessage:
+		PostMessage(m_hContainer, WM_APP_DELIVER_PLUGIN_EVENTS, 0, 0);
+		break;
+
+	case Plugins::PluginEventDispatcher::DeliveryTiming::WhenIdle:
+		SetTimer(m_hContainer, PLUGIN_EVENTS_TIMER_ID, USER_TIMER_MINIMUM, nullptr);
+		break;
+	}
+}
@@ -29,3 +29,13 @@ Plugins::PluginCommandManager *Explorerplusplus::GetPluginCommandManager()
 {
 	return &m_pluginCommandManager;
 }
+
+Plugins::PluginEventDispatcher *Explorerplusplus::GetPluginEventDispatcher()
+{
+	return &m_pluginEventDispatcher;
+}
+
+Plugins::PluginProfiler *Explorerplusplus::GetPluginProfiler()
+{
+	return &m_pluginProfiler;
+}
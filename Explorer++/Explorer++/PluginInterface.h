@@ -12,7 +12,9 @@ class UiTheming;
 namespace Plugins
 {
 class PluginCommandManager;
+class PluginEventDispatcher;
 class PluginMenuManager;
+class PluginProfiler;
 }
 
 __interface PluginInterface
@@ -23,4 +25,6 @@ __interface PluginInterface
 	UiTheming *GetUiTheming();
 	AcceleratorUpdater *GetAccleratorUpdater();
 	Plugins::PluginCommandManager *GetPluginCommandManager();
+	Plugins::PluginEventDispatcher *GetPluginEventDispatcher();
+	Plugins::PluginProfiler *GetPluginProfiler();
 };
@@ -4,7 +4,11 @@
 
 #include "stdafx.h"
 #include "Plugins/ApiBinding.h"
+#include "CoreInterface.h"
+#include "Plugins/ColumnsApi.h"
 #include "Plugins/CommandApi/Events/CommandInvoked.h"
+#include "Plugins/ItemsApi/ItemsApi.h"
+#include "Plugins/Manifest.h"
 #include "Plugins/MenuApi.h"
 #include "Plugins/PluginMenuManager.h"
 #include "Plugins/TabsApi/Events/TabCreated.h"
@@ -13,17 +17,26 @@
 #include "Plugins/TabsApi/Events/TabUpdated.h"
 #include "Plugins/TabsApi/TabsApi.h"
 #include "Plugins/UiApi.h"
+#include "ShellBrowser/ShellBrowserImpl.h"
 #include "ShellBrowser/SortModes.h"
 #include "ShellBrowser/ViewModes.h"
+#include "Tab.h"
 #include "TabContainer.h"
 #include "UiTheming.h"
 #include <sol/sol.hpp>
 
-void BindTabsAPI(sol::state &state, CoreInterface *coreInterface, TabContainer *tabContainer);
-void BindMenuApi(sol::state &state, Plugins::PluginMenuManager *pluginMenuManager);
+void BindTabsAPI(int pluginId, sol::state &state, CoreInterface *coreInterface,
+	TabContainer *tabContainer, Plugins::PluginEventDispatcher *dispatcher);
+void BindItemsApi(sol::state &state, TabContainer *tabContainer);
+void BindMenuApi(int pluginId, sol::state &state, Plugins::PluginMenuManager *pluginMenuManager,
+	Plugins::PluginProfiler *profiler);
 void BindUiApi(sol::state &state, UiTheming *uiTheming);
 void BindCommandApi(int pluginId, sol::state &state,
-	Plugins::PluginCommandManager *pluginCommandManager);
+	Plugins::PluginCommandManager *pluginCommandManager,
+	Plugins::PluginEventDispatcher *dispatcher);
+void BindColumnsApi(int pluginId, const std::wstring &pluginDirectory,
+	const Plugins::Manifest &manifest, sol::state &state,
+	Plugins::PluginColumnManager *pluginColumnManager);
 template <typename T>
 void BindObserverMethods(sol::state &state, sol::table &parentTable,
 	const std::string &observerTableName, const std::shared_ptr<T> &object);
@@ -32,15 +45,23 @@ void AddEnum(sol::state &state, sol::table &parentTable, const std::string &name
 sol::table MarkTableReadOnly(sol::state &state, sol::table &table);
 int deny(lua_State *state);
 
-void Plugins::BindAllApiMethods(int pluginId, sol::state &state, PluginInterface *pluginInterface)
+void Plugins::BindAllApiMethods(int pluginId, const std::wstring &pluginDirectory,
+	const Manifest &manifest, sol::state &state, PluginInterface *pluginInterface)
 {
-	BindTabsAPI(state, pluginInterface->GetCoreInterface(), pluginInterface->GetTabContainer());
-	BindMenuApi(state, pluginInterface->GetPluginMenuManager());
+	BindTabsAPI(pluginId, state, pluginInterface->GetCoreInterface(),
+		pluginInterface->GetTabContainer(), pluginInterface->GetPluginEventDispatcher());
+	BindItemsApi(state, pluginInterface->GetTabContainer());
+	BindMenuApi(pluginId, state, pluginInterface->GetPluginMenuManager(),
+		pluginInterface->GetPluginProfiler());
 	BindUiApi(state, pluginInterface->GetUiTheming());
-	BindCommandApi(pluginId, state, pluginInterface->GetPluginCommandManager());
+	BindCommandApi(pluginId, state, pluginInterface->GetPluginCommandManager(),
+		pluginInterface->GetPluginEventDispatcher());
+	BindColumnsApi(pluginId, pluginDirectory, manifest, state,
+		pluginInterface->GetCoreInterface()->GetPluginColumnManager());
 }
 
-void BindTabsAPI(sol::state &state, CoreInterface *coreInterface, TabContainer *tabContainer)
+void BindTabsAPI(int pluginId, sol::state &state, CoreInterface *coreInterface,
+	TabContainer *tabContainer, Plugins::PluginEventDispatcher *dispatcher)
 {
 	std::shared_ptr<Plugins::TabsApi> tabsApi =
 		std::make_shared<Plugins::TabsApi>(coreInterface, tabContainer);
@@ -57,18 +78,19 @@ void BindTabsAPI(sol::state &state, CoreInterface *coreInterface, TabContainer *
 	tabsMetaTable.set_function("close", &Plugins::TabsApi::close, tabsApi);
 
 	std::shared_ptr<Plugins::TabCreated> tabCreated =
-		std::make_shared<Plugins::TabCreated>(tabContainer);
+		std::make_shared<Plugins::TabCreated>(tabContainer, dispatcher, pluginId);
 	BindObserverMethods(state, tabsMetaTable, "onCreated", tabCreated);
 
-	std::shared_ptr<Plugins::TabMoved> tabMoved = std::make_shared<Plugins::TabMoved>(tabContainer);
+	std::shared_ptr<Plugins::TabMoved> tabMoved =
+		std::make_shared<Plugins::TabMoved>(tabContainer, dispatcher, pluginId);
 	BindObserverMethods(state, tabsMetaTable, "onMoved", tabMoved);
 
 	std::shared_ptr<Plugins::TabUpdated> tabUpdated =
-		std::make_shared<Plugins::TabUpdated>(tabContainer);
+		std::make_shared<Plugins::TabUpdated>(tabContainer, dispatcher, pluginId);
 	BindObserverMethods(state, tabsMetaTable, "onUpdated", tabUpdated);
 
 	std::shared_ptr<Plugins::TabRemoved> tabRemoved =
-		std::make_shared<Plugins::TabRemoved>(tabContainer);
+		std::make_shared<Plugins::TabRemoved>(tabContainer, dispatcher, pluginId);
 	BindObserverMethods(state, tabsMetaTable, "onRemoved", tabRemoved);
 
 	// clang-format off
@@ -90,10 +112,58 @@ void BindTabsAPI(sol::state &state, CoreInterface *coreInterface, TabContainer *
 	AddEnum<SortMode>(state, tabsMetaTable, "SortMode");
 }
 
-void BindMenuApi(sol::state &state, Plugins::PluginMenuManager *pluginMenuManager)
+void BindItemsApi(sol::state &state, TabContainer *tabContainer)
+{
+	std::shared_ptr<Plugins::ItemsApi> itemsApi = std::make_shared<Plugins::ItemsApi>(
+		[tabContainer](int tabId) -> std::shared_ptr<ItemSource>
+		{
+			auto *tab = tabContainer->GetTabOptional(tabId);
+
+			if (!tab)
+			{
+				return nullptr;
+			}
+
+			return tab->GetShellBrowserWeak().lock();
+		});
+
+	sol::table itemsTable = state.create_named_table("items");
+	sol::table itemsMetaTable = MarkTableReadOnly(state, itemsTable);
+
+	itemsMetaTable.set_function("count", &Plugins::ItemsApi::count, itemsApi);
+	itemsMetaTable.set_function("getAll", &Plugins::ItemsApi::getAll, itemsApi);
+	itemsMetaTable.set_function("getSelected", &Plugins::ItemsApi::getSelected, itemsApi);
+	itemsMetaTable.set_function("filter", &Plugins::ItemsApi::filter, itemsApi);
+	itemsMetaTable.set_function("forEach", &Plugins::ItemsApi::forEach, itemsApi);
+	itemsMetaTable.set_function("select", &Plugins::ItemsApi::select, itemsApi);
+	itemsMetaTable.set_function("setSelected", &Plugins::ItemsApi::setSelected, itemsApi);
+
+	Plugins::BindItemViewType(itemsMetaTable);
+}
+
+void Plugins::BindItemViewType(sol::table &parentTable)
+{
+	// The properties are all read-only and are read from the underlying item on each access.
+	// clang-format off
+	parentTable.new_usertype<Plugins::ItemView>("ItemView",
+		sol::no_constructor,
+		"valid", sol::readonly_property(&Plugins::ItemView::isValid),
+		"name", sol::readonly_property(&Plugins::ItemView::getName),
+		"size", sol::readonly_property(&Plugins::ItemView::getSize),
+		"attributes", sol::readonly_property(&Plugins::ItemView::getAttributes),
+		"isFolder", sol::readonly_property(&Plugins::ItemView::isFolder),
+		"created", sol::readonly_property(&Plugins::ItemView::getCreated),
+		"modified", sol::readonly_property(&Plugins::ItemView::getModified),
+		"accessed", sol::readonly_property(&Plugins::ItemView::getAccessed),
+		"__tostring", &Plugins::ItemView::toString);
+	// clang-format on
+}
+
+void BindMenuApi(int pluginId, sol::state &state, Plugins::PluginMenuManager *pluginMenuManager,
+	Plugins::PluginProfiler *profiler)
 {
 	std::shared_ptr<Plugins::MenuApi> menuApi =
-		std::make_shared<Plugins::MenuApi>(pluginMenuManager);
+		std::make_shared<Plugins::MenuApi>(pluginMenuManager, profiler, pluginId);
 
 	sol::table menuTable = state.create_named_table("menu");
 	sol::table metaTable = MarkTableReadOnly(state, menuTable);
@@ -114,16 +184,32 @@ void BindUiApi(sol::state &state, UiTheming *uiTheming)
 }
 
 void BindCommandApi(int pluginId, sol::state &state,
-	Plugins::PluginCommandManager *pluginCommandManager)
+	Plugins::PluginCommandManager *pluginCommandManager,
+	Plugins::PluginEventDispatcher *dispatcher)
 {
 	sol::table commandsTable = state.create_named_table("commands");
 	sol::table commandsMetaTable = MarkTableReadOnly(state, commandsTable);
 
 	std::shared_ptr<Plugins::CommandInvoked> commandInvoked =
-		std::make_shared<Plugins::CommandInvoked>(pluginCommandManager, pluginId);
+		std::make_shared<Plugins::CommandInvoked>(pluginCommandManager, dispatcher, pluginId);
 	BindObserverMethods(state, commandsMetaTable, "onCommand", commandInvoked);
 }
 
+void BindColumnsApi(int pluginId, const std::wstring &pluginDirectory,
+	const Plugins::Manifest &manifest, sol::state &state,
+	Plugins::PluginColumnManager *pluginColumnManager)
+{
+	std::shared_ptr<Plugins::ColumnsApi> columnsApi = std::make_shared<Plugins::ColumnsApi>(
+		pluginColumnManager, pluginId, pluginDirectory, manifest.libraries);
+
+	sol::table columnsTable = state.create_named_table("columns");
+	sol::table columnsMetaTable = MarkTableReadOnly(state, columnsTable);
+
+	columnsMetaTable.set_function("register", &Plugins::ColumnsApi::registerColumn, columnsApi);
+	columnsMetaTable.set_function("remove", &Plugins::ColumnsApi::remove, columnsApi);
+	columnsMetaTable.set_function("getStats", &Plugins::ColumnsApi::getStats, columnsApi);
+}
+
 template <typename T>
 void BindObserverMethods(sol::state &state, sol::table &parentTable,
 	const std::string &observerTableName, const std::shared_ptr<T> &object)
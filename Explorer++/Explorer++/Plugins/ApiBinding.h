@@ -6,8 +6,13 @@
 
 #include "PluginInterface.h"
 #include <sol/forward.hpp>
+#include <string>
 
 namespace Plugins
 {
-void BindAllApiMethods(int pluginId, sol::state &state, PluginInterface *pluginInterface);
+struct Manifest;
+
+void BindAllApiMethods(int pluginId, const std::wstring &pluginDirectory, const Manifest &manifest,
+	sol::state &state, PluginInterface *pluginInterface);
+void BindItemViewType(sol::table &parentTable);
 }
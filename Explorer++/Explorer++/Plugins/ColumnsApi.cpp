@@ -0,0 +1,159 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "Plugins/ColumnsApi.h"
+#include "Plugins/PluginColumnManager.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace
+{
+
+namespace DefinitionConstants
+{
+constexpr char NAME[] = "name";
+constexpr char SCRIPT_FILE[] = "file";
+constexpr char FUNCTION[] = "func";
+constexpr char WIDTH[] = "width";
+constexpr char TIME_BUDGET[] = "timeBudget";
+}
+
+}
+
+Plugins::ColumnsApi::ColumnsApi(PluginColumnManager *pluginColumnManager, int pluginId,
+	const std::wstring &pluginDirectory, const std::vector<sol::lib> &libraries) :
+	m_pluginColumnManager(pluginColumnManager),
+	m_pluginId(pluginId),
+	m_pluginDirectory(pluginDirectory),
+	m_libraries(libraries)
+{
+}
+
+Plugins::ColumnsApi::~ColumnsApi()
+{
+	for (int columnId : m_columnIds)
+	{
+		m_pluginColumnManager->RemoveColumn(columnId);
+	}
+}
+
+std::optional<int> Plugins::ColumnsApi::registerColumn(sol::table definition)
+{
+	sol::optional<std::wstring> name = definition[DefinitionConstants::NAME];
+	sol::optional<std::wstring> file = definition[DefinitionConstants::SCRIPT_FILE];
+	sol::optional<std::string> function = definition[DefinitionConstants::FUNCTION];
+
+	if (!name || name->empty() || !file || !function || function->empty())
+	{
+		return std::nullopt;
+	}
+
+	auto scriptPath = resolveScriptPath(*file);
+
+	if (!scriptPath)
+	{
+		return std::nullopt;
+	}
+
+	int width = definition.get_or(DefinitionConstants::WIDTH, PluginColumn::DEFAULT_WIDTH);
+	int timeBudget = definition.get_or(DefinitionConstants::TIME_BUDGET,
+		static_cast<int>(PluginColumn::DEFAULT_TIME_BUDGET.count()));
+
+	if (width <= 0 || timeBudget <= 0)
+	{
+		return std::nullopt;
+	}
+
+	PluginColumn::Definition columnDefinition;
+	columnDefinition.name = *name;
+	columnDefinition.scriptPath = *scriptPath;
+	columnDefinition.functionName = *function;
+	columnDefinition.libraries = m_libraries;
+	columnDefinition.width = width;
+	columnDefinition.timeBudget =
+		(std::min)(std::chrono::milliseconds(timeBudget), PluginColumn::MAX_TIME_BUDGET);
+
+	auto columnId = m_pluginColumnManager->AddColumn(m_pluginId, std::move(columnDefinition));
+
+	if (!columnId)
+	{
+		return std::nullopt;
+	}
+
+	m_columnIds.push_back(*columnId);
+
+	return columnId;
+}
+
+void Plugins::ColumnsApi::remove(int columnId)
+{
+	auto itr = std::ranges::find(m_columnIds, columnId);
+
+	if (itr == m_columnIds.end())
+	{
+		return;
+	}
+
+	m_pluginColumnManager->RemoveColumn(columnId);
+
+	m_columnIds.erase(itr);
+}
+
+sol::object Plugins::ColumnsApi::getStats(int columnId, sol::this_state state)
+{
+	if (std::ranges::find(m_columnIds, columnId) == m_columnIds.end())
+	{
+		return sol::nil;
+	}
+
+	auto column = m_pluginColumnManager->GetColumn(columnId);
+
+	if (!column)
+	{
+		return sol::nil;
+	}
+
+	auto stats = column->GetStats();
+
+	sol::state_view lua(state);
+	sol::table statsTable = lua.create_table();
+	statsTable["calls"] = stats.numCalls;
+	statsTable["errors"] = stats.numErrors;
+	statsTable["timeouts"] = stats.numTimeouts;
+	statsTable["totalTime"] =
+		std::chrono::duration_cast<std::chrono::milliseconds>(stats.totalTime).count();
+	statsTable["disabled"] = stats.disabled;
+
+	return statsTable;
+}
+
+// The script must be within the plugin's directory.
+std::optional<std::wstring> Plugins::ColumnsApi::resolveScriptPath(const std::wstring &file) const
+{
+	std::filesystem::path relativePath(file);
+
+	if (relativePath.empty() || relativePath.has_root_path())
+	{
+		return std::nullopt;
+	}
+
+	relativePath = relativePath.lexically_normal();
+
+	if (relativePath.begin() != relativePath.end() && *relativePath.begin() == L"..")
+	{
+		return std::nullopt;
+	}
+
+	std::filesystem::path scriptPath = std::filesystem::path(m_pluginDirectory) / relativePath;
+
+	std::error_code error;
+
+	if (!std::filesystem::is_regular_file(scriptPath, error))
+	{
+		return std::nullopt;
+	}
+
+	return scriptPath.wstring();
+}
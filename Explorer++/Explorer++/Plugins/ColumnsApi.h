@@ -0,0 +1,44 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <sol/sol.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Plugins
+{
+class PluginColumnManager;
+
+// Allows a plugin to add columns to the details view. The text for a column is retrieved on
+// background threads (see PluginColumn), so a column is specified by the script file and function
+// that provide the text, rather than by a function in the plugin's own state. Columns are removed
+// when the plugin is unloaded.
+class ColumnsApi
+{
+public:
+	ColumnsApi(PluginColumnManager *pluginColumnManager, int pluginId,
+		const std::wstring &pluginDirectory, const std::vector<sol::lib> &libraries);
+	~ColumnsApi();
+
+	std::optional<int> registerColumn(sol::table definition);
+	void remove(int columnId);
+
+	// The stats cover all of the plugin's columns, since that's how the limits are applied (see
+	// PluginColumnUsage).
+	sol::object getStats(int columnId, sol::this_state state);
+
+private:
+	std::optional<std::wstring> resolveScriptPath(const std::wstring &file) const;
+
+	PluginColumnManager *const m_pluginColumnManager;
+	const int m_pluginId;
+	const std::wstring m_pluginDirectory;
+	const std::vector<sol::lib> m_libraries;
+
+	std::vector<int> m_columnIds;
+};
+}
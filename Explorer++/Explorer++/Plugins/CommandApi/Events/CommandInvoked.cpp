@@ -6,31 +6,33 @@
 #include "Plugins/CommandApi/Events/CommandInvoked.h"
 #include <sol/sol.hpp>
 
-Plugins::CommandInvoked::CommandInvoked(PluginCommandManager *pluginCommandManager, int pluginId) :
+Plugins::CommandInvoked::CommandInvoked(PluginCommandManager *pluginCommandManager,
+	PluginEventDispatcher *dispatcher, int pluginId) :
+	Event(dispatcher, pluginId, L"commands.onCommand"),
 	m_pluginCommandManager(pluginCommandManager),
 	m_pluginId(pluginId)
 {
 }
 
 boost::signals2::connection Plugins::CommandInvoked::connectObserver(
-	sol::protected_function observer, sol::this_state state)
+	sol::protected_function observer, sol::this_state state, int observerId)
 {
 	UNREFERENCED_PARAMETER(state);
 
 	return m_pluginCommandManager->AddCommandInvokedObserver(
-		[this, observer](int pluginId, const std::wstring &name)
+		[this, observer, observerId](int pluginId, const std::wstring &name)
 		{
-			onCommandInvoked(pluginId, name, observer);
+			onCommandInvoked(pluginId, name, observer, observerId);
 		});
 }
 
 void Plugins::CommandInvoked::onCommandInvoked(int pluginId, const std::wstring &name,
-	sol::protected_function observer)
+	sol::protected_function observer, int observerId)
 {
 	if (pluginId != m_pluginId)
 	{
 		return;
 	}
 
-	observer(name);
+	queueObserverCall(observerId, observer, name);
 }
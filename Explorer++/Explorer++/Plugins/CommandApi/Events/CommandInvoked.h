@@ -12,14 +12,16 @@ namespace Plugins
 class CommandInvoked : public Event
 {
 public:
-	CommandInvoked(PluginCommandManager *pluginCommandManager, int pluginId);
+	CommandInvoked(PluginCommandManager *pluginCommandManager, PluginEventDispatcher *dispatcher,
+		int pluginId);
 
 protected:
 	boost::signals2::connection connectObserver(sol::protected_function observer,
-		sol::this_state state) override;
+		sol::this_state state, int observerId) override;
 
 private:
-	void onCommandInvoked(int pluginId, const std::wstring &name, sol::protected_function observer);
+	void onCommandInvoked(int pluginId, const std::wstring &name, sol::protected_function observer,
+		int observerId);
 
 	PluginCommandManager *m_pluginCommandManager;
 	int m_pluginId;
@@ -6,7 +6,11 @@
 #include "Plugins/Event.h"
 #include <sol/sol.hpp>
 
-Plugins::Event::Event() : m_connectionIdCounter(1)
+Plugins::Event::Event(PluginEventDispatcher *dispatcher, int pluginId, std::wstring_view name) :
+	m_dispatcher(dispatcher),
+	m_pluginId(pluginId),
+	m_name(name),
+	m_connectionIdCounter(1)
 {
 }
 
@@ -16,6 +20,8 @@ Plugins::Event::~Event()
 	{
 		item.second.disconnect();
 	}
+
+	m_dispatcher->RemoveCalls(this);
 }
 
 int Plugins::Event::addObserver(sol::protected_function observer, sol::this_state state)
@@ -25,9 +31,9 @@ int Plugins::Event::addObserver(sol::protected_function observer, sol::this_stat
 		return -1;
 	}
 
-	auto connection = connectObserver(observer, state);
-
 	int id = m_connectionIdCounter++;
+
+	auto connection = connectObserver(observer, state, id);
 	m_connections.insert(std::make_pair(id, connection));
 
 	return id;
@@ -45,4 +51,20 @@ void Plugins::Event::removeObserver(int id)
 	itr->second.disconnect();
 
 	m_connections.erase(itr);
+
+	// Once an observer has been removed, it shouldn't be called again, even for events that
+	// occurred before it was removed.
+	m_dispatcher->RemoveCalls(this, id);
+
+	onObserverRemoved(id);
+}
+
+void Plugins::Event::onObserverRemoved(int observerId)
+{
+	UNREFERENCED_PARAMETER(observerId);
+}
+
+void Plugins::Event::queueCall(int observerId, PluginEventDispatcher::Call call)
+{
+	m_dispatcher->QueueCall(m_pluginId, this, observerId, m_name, std::move(call));
 }
@@ -4,16 +4,21 @@
 
 #pragma once
 
+#include "Plugins/PluginEventDispatcher.h"
 #include <boost/signals2.hpp>
 #include <sol/forward.hpp>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace Plugins
 {
+// Observers aren't called directly when the underlying event occurs. Instead, the calls are queued
+// and delivered in batches by the PluginEventDispatcher.
 class Event
 {
 public:
-	Event();
+	Event(PluginEventDispatcher *dispatcher, int pluginId, std::wstring_view name);
 	virtual ~Event();
 
 	int addObserver(sol::protected_function observer, sol::this_state state);
@@ -21,9 +26,27 @@ public:
 
 protected:
 	virtual boost::signals2::connection connectObserver(sol::protected_function observer,
-		sol::this_state state) = 0;
+		sol::this_state state, int observerId) = 0;
+
+	// Called after an observer has been explicitly removed.
+	virtual void onObserverRemoved(int observerId);
+
+	void queueCall(int observerId, PluginEventDispatcher::Call call);
+
+	// Queues a call to the observer with the specified arguments. The arguments are captured by
+	// value, so they should describe the state at the time the event occurred.
+	template <typename Observer, typename... Args>
+	void queueObserverCall(int observerId, const Observer &observer, Args... args)
+	{
+		queueCall(observerId,
+			[observer, args...]() mutable { return observer(args...).valid(); });
+	}
 
 private:
+	PluginEventDispatcher *const m_dispatcher;
+	const int m_pluginId;
+	const std::wstring m_name;
+
 	int m_connectionIdCounter;
 	std::unordered_map<int, boost::signals2::connection> m_connections;
 };
@@ -0,0 +1,157 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "Plugins/ItemsApi/ItemView.h"
+#include <sol/sol.hpp>
+
+namespace
+{
+
+// The number of 100 nanosecond intervals between 1601-01-01 (the FILETIME epoch) and 1970-01-01
+// (the Unix epoch).
+constexpr int64_t UNIX_EPOCH_OFFSET = 116444736000000000;
+constexpr int64_t TICKS_PER_SECOND = 10'000'000;
+
+}
+
+Plugins::ItemViewScope::ItemViewScope(int tabId, ValidityCheck validityCheck) :
+	m_tabId(tabId),
+	m_validityCheck(std::move(validityCheck))
+{
+}
+
+int Plugins::ItemViewScope::getTabId() const
+{
+	return m_tabId;
+}
+
+bool Plugins::ItemViewScope::isValid() const
+{
+	return m_validityCheck();
+}
+
+Plugins::ItemView::ItemView(std::shared_ptr<const ItemViewScope> scope, int internalIndex,
+	const WIN32_FIND_DATA *findData, bool isFindDataValid) :
+	m_scope(std::move(scope)),
+	m_internalIndex(internalIndex),
+	m_findData(findData),
+	m_isFindDataValid(isFindDataValid)
+{
+}
+
+const Plugins::ItemViewScope *Plugins::ItemView::getScope() const
+{
+	return m_scope.get();
+}
+
+int Plugins::ItemView::getInternalIndex() const
+{
+	return m_internalIndex;
+}
+
+bool Plugins::ItemView::isValid() const
+{
+	return m_scope->isValid();
+}
+
+sol::object Plugins::ItemView::getName(sol::this_state state) const
+{
+	if (!isValid())
+	{
+		return sol::lua_nil;
+	}
+
+	// The name is converted directly into a stack buffer and pushed from there, so that no
+	// intermediate strings are created.
+	char name[MAX_PATH * 3];
+	int length = WideCharToMultiByte(CP_UTF8, 0, m_findData->cFileName,
+		lstrlen(m_findData->cFileName), name, static_cast<int>(std::size(name)), nullptr, nullptr);
+
+	return sol::make_object(state, std::string_view(name, length));
+}
+
+std::optional<uint64_t> Plugins::ItemView::getSize() const
+{
+	if (!areDetailsAvailable())
+	{
+		return std::nullopt;
+	}
+
+	ULARGE_INTEGER size = { m_findData->nFileSizeLow, m_findData->nFileSizeHigh };
+	return size.QuadPart;
+}
+
+std::optional<DWORD> Plugins::ItemView::getAttributes() const
+{
+	if (!areDetailsAvailable())
+	{
+		return std::nullopt;
+	}
+
+	return m_findData->dwFileAttributes;
+}
+
+std::optional<bool> Plugins::ItemView::isFolder() const
+{
+	if (!areDetailsAvailable())
+	{
+		return std::nullopt;
+	}
+
+	return (m_findData->dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == FILE_ATTRIBUTE_DIRECTORY;
+}
+
+std::optional<int64_t> Plugins::ItemView::getCreated() const
+{
+	return getTime(&WIN32_FIND_DATA::ftCreationTime);
+}
+
+std::optional<int64_t> Plugins::ItemView::getModified() const
+{
+	return getTime(&WIN32_FIND_DATA::ftLastWriteTime);
+}
+
+std::optional<int64_t> Plugins::ItemView::getAccessed() const
+{
+	return getTime(&WIN32_FIND_DATA::ftLastAccessTime);
+}
+
+std::optional<int64_t> Plugins::ItemView::getTime(const FILETIME WIN32_FIND_DATA::*time) const
+{
+	if (!areDetailsAvailable())
+	{
+		return std::nullopt;
+	}
+
+	return FileTimeToUnixTime(m_findData->*time);
+}
+
+bool Plugins::ItemView::areDetailsAvailable() const
+{
+	return m_isFindDataValid && isValid();
+}
+
+std::wstring Plugins::ItemView::toString() const
+{
+	if (!isValid())
+	{
+		return L"(invalid item)";
+	}
+
+	return std::wstring(L"name = ") + m_findData->cFileName;
+}
+
+int64_t Plugins::FileTimeToUnixTime(const FILETIME &fileTime)
+{
+	ULARGE_INTEGER ticks = { fileTime.dwLowDateTime, fileTime.dwHighDateTime };
+	return (static_cast<int64_t>(ticks.QuadPart) - UNIX_EPOCH_OFFSET) / TICKS_PER_SECOND;
+}
+
+FILETIME Plugins::UnixTimeToFileTime(int64_t unixTime)
+{
+	ULARGE_INTEGER ticks;
+	ticks.QuadPart = static_cast<uint64_t>(unixTime * TICKS_PER_SECOND + UNIX_EPOCH_OFFSET);
+	return { ticks.LowPart, ticks.HighPart };
+}
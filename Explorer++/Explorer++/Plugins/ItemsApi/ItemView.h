@@ -0,0 +1,69 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <sol/forward.hpp>
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace Plugins
+{
+// Shared by each of the views created from a single pass over a tab's items. Views point directly
+// at the data held for each item, so they can only be used while that data is intact.
+class ItemViewScope
+{
+public:
+	using ValidityCheck = std::function<bool()>;
+
+	ItemViewScope(int tabId, ValidityCheck validityCheck);
+
+	int getTabId() const;
+	bool isValid() const;
+
+private:
+	const int m_tabId;
+	const ValidityCheck m_validityCheck;
+};
+
+// A read-only view of a single item. Creating a view doesn't copy any of the item's data; each
+// property is read from the underlying item when it's accessed. Once the scope is no longer valid
+// (e.g. because the tab has navigated elsewhere), every property other than valid will be nil.
+class ItemView
+{
+public:
+	ItemView(std::shared_ptr<const ItemViewScope> scope, int internalIndex,
+		const WIN32_FIND_DATA *findData, bool isFindDataValid);
+
+	const ItemViewScope *getScope() const;
+	int getInternalIndex() const;
+
+	bool isValid() const;
+	sol::object getName(sol::this_state state) const;
+	std::optional<uint64_t> getSize() const;
+	std::optional<DWORD> getAttributes() const;
+	std::optional<bool> isFolder() const;
+
+	// Times are returned as the number of seconds since the Unix epoch, so that they can be
+	// compared against values returned by os.time().
+	std::optional<int64_t> getCreated() const;
+	std::optional<int64_t> getModified() const;
+	std::optional<int64_t> getAccessed() const;
+
+	std::wstring toString() const;
+
+private:
+	std::optional<int64_t> getTime(const FILETIME WIN32_FIND_DATA::*time) const;
+	bool areDetailsAvailable() const;
+
+	std::shared_ptr<const ItemViewScope> m_scope;
+	int m_internalIndex;
+	const WIN32_FIND_DATA *m_findData;
+	bool m_isFindDataValid;
+};
+
+int64_t FileTimeToUnixTime(const FILETIME &fileTime);
+FILETIME UnixTimeToFileTime(int64_t unixTime);
+}
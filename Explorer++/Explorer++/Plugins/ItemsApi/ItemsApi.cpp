@@ -0,0 +1,259 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "Plugins/ItemsApi/ItemsApi.h"
+#include "ShellBrowser/ItemSource.h"
+#include <sol/sol.hpp>
+#include <limits>
+#include <unordered_set>
+
+namespace
+{
+
+namespace FilterConstants
+{
+constexpr char PATTERN[] = "pattern";
+constexpr char REGEX[] = "regex";
+constexpr char CASE_SENSITIVE[] = "caseSensitive";
+constexpr char ATTRIBUTES[] = "attributes";
+constexpr char MIN_SIZE[] = "minSize";
+constexpr char MAX_SIZE[] = "maxSize";
+constexpr char MODIFIED_AFTER[] = "modifiedAfter";
+constexpr char MODIFIED_BEFORE[] = "modifiedBefore";
+}
+
+bool MatchAll(const WIN32_FIND_DATA &findData, bool isFindDataValid)
+{
+	UNREFERENCED_PARAMETER(findData);
+	UNREFERENCED_PARAMETER(isFindDataValid);
+
+	return true;
+}
+
+}
+
+Plugins::ItemsApi::ItemsApi(ItemSourceLookup itemSourceLookup) :
+	m_itemSourceLookup(std::move(itemSourceLookup))
+{
+}
+
+std::optional<int> Plugins::ItemsApi::count(int tabId)
+{
+	auto itemSource = m_itemSourceLookup(tabId);
+
+	if (!itemSource)
+	{
+		return std::nullopt;
+	}
+
+	return itemSource->GetNumItems();
+}
+
+std::optional<std::vector<Plugins::ItemView>> Plugins::ItemsApi::getAll(int tabId)
+{
+	return createViews(tabId, false, MatchAll);
+}
+
+std::optional<std::vector<Plugins::ItemView>> Plugins::ItemsApi::getSelected(int tabId)
+{
+	return createViews(tabId, true, MatchAll);
+}
+
+std::optional<std::vector<Plugins::ItemView>> Plugins::ItemsApi::filter(int tabId,
+	sol::table filter)
+{
+	auto predicate = parseFilter(filter);
+
+	if (!predicate)
+	{
+		return std::nullopt;
+	}
+
+	return createViews(tabId, false, *predicate);
+}
+
+std::optional<int> Plugins::ItemsApi::forEach(int tabId, sol::protected_function callback)
+{
+	// The views are all created up front, since the callback is free to do things (such as
+	// navigating the tab) that would invalidate an iteration that was still in progress.
+	auto views = createViews(tabId, false, MatchAll);
+
+	if (!views || !callback)
+	{
+		return std::nullopt;
+	}
+
+	int numVisited = 0;
+
+	for (const auto &view : *views)
+	{
+		if (!view.isValid())
+		{
+			break;
+		}
+
+		sol::protected_function_result result = callback(view);
+		numVisited++;
+
+		if (!result.valid())
+		{
+			sol::error error = result;
+			throw error;
+		}
+
+		// Returning false from the callback stops the iteration.
+		sol::optional<bool> continueIteration = result;
+
+		if (continueIteration && !*continueIteration)
+		{
+			break;
+		}
+	}
+
+	return numVisited;
+}
+
+bool Plugins::ItemsApi::select(int tabId, sol::table filter, sol::optional<bool> select)
+{
+	auto itemSource = m_itemSourceLookup(tabId);
+
+	if (!itemSource)
+	{
+		return false;
+	}
+
+	auto predicate = parseFilter(filter);
+
+	if (!predicate)
+	{
+		return false;
+	}
+
+	itemSource->SelectItemsMatchingPredicate(*predicate, select.value_or(true));
+
+	return true;
+}
+
+bool Plugins::ItemsApi::setSelected(int tabId, sol::table views, sol::optional<bool> select)
+{
+	auto itemSource = m_itemSourceLookup(tabId);
+
+	if (!itemSource)
+	{
+		return false;
+	}
+
+	std::unordered_set<int> internalIndexes;
+
+	for (size_t i = 1; i <= views.size(); i++)
+	{
+		sol::optional<const ItemView &> view = views[i];
+
+		// Views that were retrieved from another tab, or that have since been invalidated, are
+		// ignored.
+		if (!view || view->getScope()->getTabId() != tabId || !view->isValid())
+		{
+			continue;
+		}
+
+		internalIndexes.insert(view->getInternalIndex());
+	}
+
+	itemSource->SelectItemsByInternalIndex(internalIndexes, select.value_or(true));
+
+	return true;
+}
+
+std::optional<std::vector<Plugins::ItemView>> Plugins::ItemsApi::createViews(int tabId,
+	bool selectedOnly, const ItemPredicate &predicate)
+{
+	auto itemSource = m_itemSourceLookup(tabId);
+
+	if (!itemSource)
+	{
+		return std::nullopt;
+	}
+
+	auto scope = std::make_shared<ItemViewScope>(tabId,
+		[weakItemSource = std::weak_ptr<ItemSource>(itemSource),
+			version = itemSource->GetItemStorageVersion()]
+		{
+			auto itemSource = weakItemSource.lock();
+			return itemSource && itemSource->GetItemStorageVersion() == version;
+		});
+
+	std::vector<ItemView> views;
+	views.reserve(selectedOnly ? itemSource->GetNumSelected() : itemSource->GetNumItems());
+
+	itemSource->VisitItems(
+		[&views, &scope, &predicate](int internalIndex, const WIN32_FIND_DATA &findData,
+			bool isFindDataValid)
+		{
+			if (predicate(findData, isFindDataValid))
+			{
+				views.emplace_back(scope, internalIndex, &findData, isFindDataValid);
+			}
+		},
+		selectedOnly);
+
+	return views;
+}
+
+std::optional<ItemPredicate> Plugins::ItemsApi::parseFilter(sol::table filter)
+{
+	std::vector<ItemPredicate> predicates;
+
+	bool caseSensitive = filter.get_or(FilterConstants::CASE_SENSITIVE, false);
+
+	sol::optional<std::wstring> pattern = filter[FilterConstants::PATTERN];
+
+	if (pattern)
+	{
+		predicates.push_back(ItemPredicates::MatchesWildcard(*pattern, caseSensitive));
+	}
+
+	sol::optional<std::wstring> regex = filter[FilterConstants::REGEX];
+
+	if (regex)
+	{
+		auto regexPredicate = ItemPredicates::MatchesRegex(*regex, caseSensitive);
+
+		if (!regexPredicate)
+		{
+			return std::nullopt;
+		}
+
+		predicates.push_back(*regexPredicate);
+	}
+
+	sol::optional<DWORD> attributes = filter[FilterConstants::ATTRIBUTES];
+
+	if (attributes)
+	{
+		predicates.push_back(ItemPredicates::HasAttributes(*attributes));
+	}
+
+	sol::optional<uint64_t> minSize = filter[FilterConstants::MIN_SIZE];
+	sol::optional<uint64_t> maxSize = filter[FilterConstants::MAX_SIZE];
+
+	if (minSize || maxSize)
+	{
+		predicates.push_back(ItemPredicates::SizeInRange(minSize.value_or(0),
+			maxSize.value_or((std::numeric_limits<uint64_t>::max)())));
+	}
+
+	sol::optional<int64_t> modifiedAfter = filter[FilterConstants::MODIFIED_AFTER];
+	sol::optional<int64_t> modifiedBefore = filter[FilterConstants::MODIFIED_BEFORE];
+
+	if (modifiedAfter || modifiedBefore)
+	{
+		FILETIME from = modifiedAfter ? UnixTimeToFileTime(*modifiedAfter) : FILETIME{ 0, 0 };
+		FILETIME to = modifiedBefore ? UnixTimeToFileTime(*modifiedBefore)
+									 : FILETIME{ 0xFFFFFFFF, 0x7FFFFFFF };
+		predicates.push_back(ItemPredicates::ModifiedInRange(from, to));
+	}
+
+	return ItemPredicates::All(std::move(predicates));
+}
@@ -0,0 +1,46 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "Plugins/ItemsApi/ItemView.h"
+#include "ShellBrowser/ItemPredicates.h"
+#include <sol/forward.hpp>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+class ItemSource;
+
+namespace Plugins
+{
+// Provides access to the items in a tab. Items are returned as views (see ItemView), so
+// retrieving the items in a large folder doesn't involve copying each item's data. Filtering and
+// selection are performed in bulk, so that plugins don't need to call back into the application
+// once per item.
+class ItemsApi
+{
+public:
+	// Returns the item source for the specified tab, or nullptr if there's no such tab.
+	using ItemSourceLookup = std::function<std::shared_ptr<ItemSource>(int tabId)>;
+
+	ItemsApi(ItemSourceLookup itemSourceLookup);
+
+	std::optional<int> count(int tabId);
+	std::optional<std::vector<ItemView>> getAll(int tabId);
+	std::optional<std::vector<ItemView>> getSelected(int tabId);
+	std::optional<std::vector<ItemView>> filter(int tabId, sol::table filter);
+	std::optional<int> forEach(int tabId, sol::protected_function callback);
+	bool select(int tabId, sol::table filter, sol::optional<bool> select);
+	bool setSelected(int tabId, sol::table views, sol::optional<bool> select);
+
+private:
+	std::optional<std::vector<ItemView>> createViews(int tabId, bool selectedOnly,
+		const ItemPredicate &predicate);
+	std::optional<ItemPredicate> parseFilter(sol::table filter);
+
+	const ItemSourceLookup m_itemSourceLookup;
+};
+}
@@ -18,7 +18,7 @@ Plugins::LuaPlugin::LuaPlugin(const std::wstring &directory, const Manifest &man
 	m_lua(onPanic),
 	m_id(idCounter++)
 {
-	BindAllApiMethods(m_id, m_lua, pluginInterface);
+	BindAllApiMethods(m_id, m_directory, m_manifest, m_lua, pluginInterface);
 }
 
 int Plugins::LuaPlugin::GetId() const
@@ -4,10 +4,14 @@
 
 #include "stdafx.h"
 #include "Plugins/MenuApi.h"
+#include "Plugins/PluginProfiler.h"
 #include <sol/sol.hpp>
 
-Plugins::MenuApi::MenuApi(PluginMenuManager *pluginMenuManager) :
-	m_pluginMenuManager(pluginMenuManager)
+Plugins::MenuApi::MenuApi(PluginMenuManager *pluginMenuManager, PluginProfiler *profiler,
+	int pluginId) :
+	m_pluginMenuManager(pluginMenuManager),
+	m_profiler(profiler),
+	m_pluginId(pluginId)
 {
 	m_connections.emplace_back(m_pluginMenuManager->AddMenuClickedObserver(
 		std::bind_front(&Plugins::MenuApi::onMenuItemClicked, this)));
@@ -59,5 +63,12 @@ void Plugins::MenuApi::onMenuItemClicked(int menuItemId)
 		return;
 	}
 
-	itr->second();
+	// The item was clicked by the user, so the callback is called directly, rather than being
+	// queued, though the call is still profiled.
+	PluginProfiler::ScopedCall profiledCall(m_profiler, m_pluginId, L"menu item callback");
+
+	if (!itr->second().valid())
+	{
+		profiledCall.SetFailed();
+	}
 }
@@ -12,10 +12,12 @@
 
 namespace Plugins
 {
+class PluginProfiler;
+
 class MenuApi
 {
 public:
-	MenuApi(PluginMenuManager *pluginMenuManager);
+	MenuApi(PluginMenuManager *pluginMenuManager, PluginProfiler *profiler, int pluginId);
 	~MenuApi();
 
 	std::optional<int> create(const std::wstring &text, sol::protected_function callback);
@@ -25,6 +27,8 @@ private:
 	void onMenuItemClicked(int menuItemId);
 
 	PluginMenuManager *m_pluginMenuManager;
+	PluginProfiler *m_profiler;
+	int m_pluginId;
 
 	std::vector<boost::signals2::scoped_connection> m_connections;
 
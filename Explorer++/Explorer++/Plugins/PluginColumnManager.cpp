@@ -0,0 +1,358 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "Plugins/PluginColumnManager.h"
+#include "Plugins/ItemsApi/ItemView.h"
+#include "ShellBrowser/ItemData.h"
+#include <filesystem>
+#include <unordered_map>
+
+namespace
+{
+
+// The number of Lua instructions that are executed between each check of the time budget.
+constexpr int BUDGET_CHECK_INSTRUCTION_COUNT = 1000;
+
+struct CallBudget
+{
+	std::chrono::steady_clock::time_point deadline;
+	bool exceeded = false;
+};
+
+// A thread only ever runs a single column call at a time, so the budget for the current call can be
+// stored per thread.
+thread_local CallBudget t_callBudget;
+
+void CheckCallBudget(lua_State *state, lua_Debug *debug)
+{
+	UNREFERENCED_PARAMETER(debug);
+
+	if (std::chrono::steady_clock::now() > t_callBudget.deadline)
+	{
+		t_callBudget.exceeded = true;
+		luaL_error(state, "The column exceeded its time budget.");
+	}
+}
+
+// Aborts any Lua code run while this object is alive, once the budget has been exceeded. The
+// error is raised from within the Lua VM, so it's reported the same way any other runtime error
+// would be (i.e. through the result of the protected call).
+class ScopedCallBudget : private boost::noncopyable
+{
+public:
+	ScopedCallBudget(lua_State *state, std::chrono::milliseconds budget) : m_state(state)
+	{
+		t_callBudget = { std::chrono::steady_clock::now() + budget, false };
+		lua_sethook(m_state, CheckCallBudget, LUA_MASKCOUNT, BUDGET_CHECK_INSTRUCTION_COUNT);
+	}
+
+	~ScopedCallBudget()
+	{
+		lua_sethook(m_state, nullptr, 0, 0);
+	}
+
+	bool WasExceeded() const
+	{
+		return t_callBudget.exceeded;
+	}
+
+private:
+	lua_State *const m_state;
+};
+
+}
+
+void Plugins::PluginColumnUsage::OnCallFinished(std::chrono::steady_clock::duration duration)
+{
+	m_numCalls++;
+	m_totalTimeMicroseconds +=
+		std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+void Plugins::PluginColumnUsage::OnError()
+{
+	m_numErrors++;
+}
+
+void Plugins::PluginColumnUsage::OnTimeout()
+{
+	if (++m_numTimeouts >= MAX_TIMEOUTS)
+	{
+		m_disabled = true;
+	}
+}
+
+bool Plugins::PluginColumnUsage::IsDisabled() const
+{
+	return m_disabled;
+}
+
+Plugins::PluginColumnUsage::Stats Plugins::PluginColumnUsage::GetStats() const
+{
+	return { m_numCalls, m_numErrors, m_numTimeouts,
+		std::chrono::microseconds(m_totalTimeMicroseconds.load()), m_disabled };
+}
+
+struct Plugins::PluginColumn::WorkerState
+{
+	sol::state lua;
+
+	// This references the state above, so needs to be declared after it (so that it's destroyed
+	// first).
+	sol::protected_function function;
+};
+
+Plugins::PluginColumn::PluginColumn(int id, int pluginId, Definition definition,
+	std::shared_ptr<PluginColumnUsage> usage) :
+	m_id(id),
+	m_pluginId(pluginId),
+	m_definition(std::move(definition)),
+	m_usage(std::move(usage))
+{
+}
+
+Plugins::PluginColumn::~PluginColumn() = default;
+
+int Plugins::PluginColumn::GetId() const
+{
+	return m_id;
+}
+
+int Plugins::PluginColumn::GetPluginId() const
+{
+	return m_pluginId;
+}
+
+const std::wstring &Plugins::PluginColumn::GetName() const
+{
+	return m_definition.name;
+}
+
+int Plugins::PluginColumn::GetWidth() const
+{
+	return m_definition.width;
+}
+
+std::chrono::milliseconds Plugins::PluginColumn::GetTimeBudget() const
+{
+	return m_definition.timeBudget;
+}
+
+std::wstring Plugins::PluginColumn::GetText(const BasicItemInfo_t &itemInfo)
+{
+	if (m_usage->IsDisabled())
+	{
+		return {};
+	}
+
+	WorkerState *workerState = GetWorkerState();
+
+	if (!workerState->function.valid())
+	{
+		// The script couldn't be loaded on this thread. That's already been counted as an error.
+		return {};
+	}
+
+	sol::state &lua = workerState->lua;
+
+	sol::table item = lua.create_table();
+	item["name"] = std::wstring(itemInfo.szDisplayName);
+	item["path"] = itemInfo.getFullPath();
+	item["isFolder"] =
+		(itemInfo.wfd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == FILE_ATTRIBUTE_DIRECTORY;
+
+	if (itemInfo.isFindDataValid)
+	{
+		ULARGE_INTEGER size = { itemInfo.wfd.nFileSizeLow, itemInfo.wfd.nFileSizeHigh };
+		item["size"] = size.QuadPart;
+		item["attributes"] = itemInfo.wfd.dwFileAttributes;
+		item["created"] = FileTimeToUnixTime(itemInfo.wfd.ftCreationTime);
+		item["modified"] = FileTimeToUnixTime(itemInfo.wfd.ftLastWriteTime);
+		item["accessed"] = FileTimeToUnixTime(itemInfo.wfd.ftLastAccessTime);
+	}
+
+	ScopedCallBudget budget(lua.lua_state(), m_definition.timeBudget);
+
+	auto start = std::chrono::steady_clock::now();
+	sol::protected_function_result result = workerState->function(item);
+	m_usage->OnCallFinished(std::chrono::steady_clock::now() - start);
+
+	if (!result.valid())
+	{
+		if (budget.WasExceeded())
+		{
+			m_usage->OnTimeout();
+		}
+		else
+		{
+			m_usage->OnError();
+		}
+
+		return {};
+	}
+
+	auto text = result.get<sol::optional<std::wstring>>();
+
+	if (!text)
+	{
+		return {};
+	}
+
+	return *text;
+}
+
+Plugins::PluginColumn::WorkerState *Plugins::PluginColumn::GetWorkerState()
+{
+	auto threadId = std::this_thread::get_id();
+
+	{
+		std::scoped_lock lock(m_workerStatesMutex);
+
+		auto itr = m_workerStates.find(threadId);
+
+		if (itr != m_workerStates.end())
+		{
+			return itr->second.get();
+		}
+	}
+
+	// Creating the state involves running the script, so the lock isn't held while that happens.
+	// Only this thread ever adds an entry for this thread ID, so there's no chance of the state
+	// being created twice.
+	auto workerState = CreateWorkerState();
+
+	std::scoped_lock lock(m_workerStatesMutex);
+	auto [itr, inserted] = m_workerStates.emplace(threadId, std::move(workerState));
+	return itr->second.get();
+}
+
+std::unique_ptr<Plugins::PluginColumn::WorkerState> Plugins::PluginColumn::CreateWorkerState()
+{
+	auto workerState = std::make_unique<WorkerState>();
+
+	for (auto library : m_definition.libraries)
+	{
+		// The io library can block indefinitely and, since the time budget can't interrupt a C
+		// function, there would be no way of stopping a call that did so.
+		if (library == sol::lib::io)
+		{
+			continue;
+		}
+
+		// See PluginManager::registerPlugin() for why std::move is used here.
+		workerState->lua.open_libraries(std::move(library));
+	}
+
+	sol::optional<sol::table> os = workerState->lua["os"];
+
+	if (os)
+	{
+		// os.execute() runs an arbitrary command and waits for it to finish, so, like the io
+		// library, it can block indefinitely.
+		(*os)["execute"] = sol::lua_nil;
+	}
+
+	// Running the script is subject to the maximum budget, since a script that doesn't return
+	// would otherwise block the worker thread indefinitely.
+	ScopedCallBudget budget(workerState->lua.lua_state(), MAX_TIME_BUDGET);
+
+	auto result = workerState->lua.safe_script_file(
+		std::filesystem::path(m_definition.scriptPath).string(), sol::script_pass_on_error);
+
+	if (!result.valid())
+	{
+		m_usage->OnError();
+		return workerState;
+	}
+
+	auto function = workerState->lua[m_definition.functionName]
+						.get<sol::optional<sol::protected_function>>();
+
+	if (!function)
+	{
+		m_usage->OnError();
+		return workerState;
+	}
+
+	workerState->function = *function;
+
+	return workerState;
+}
+
+Plugins::PluginColumnUsage::Stats Plugins::PluginColumn::GetStats() const
+{
+	return m_usage->GetStats();
+}
+
+std::optional<int> Plugins::PluginColumnManager::AddColumn(int pluginId,
+	PluginColumn::Definition definition)
+{
+	if (m_columns.size() >= MAX_COLUMNS)
+	{
+		return std::nullopt;
+	}
+
+	auto remainingTimeBudget = PluginColumn::MAX_TIME_BUDGET - GetAllocatedTimeBudget(pluginId);
+
+	if (remainingTimeBudget <= std::chrono::milliseconds::zero())
+	{
+		return std::nullopt;
+	}
+
+	definition.timeBudget = (std::min)(definition.timeBudget, remainingTimeBudget);
+
+	auto &usage = m_pluginUsage[pluginId];
+
+	if (!usage)
+	{
+		usage = std::make_shared<PluginColumnUsage>();
+	}
+
+	int columnId = m_idCounter++;
+	m_columns.push_back(
+		std::make_shared<PluginColumn>(columnId, pluginId, std::move(definition), usage));
+
+	return columnId;
+}
+
+void Plugins::PluginColumnManager::RemoveColumn(int columnId)
+{
+	std::erase_if(m_columns,
+		[columnId](const auto &column) { return column->GetId() == columnId; });
+}
+
+std::shared_ptr<Plugins::PluginColumn> Plugins::PluginColumnManager::GetColumn(int columnId) const
+{
+	auto itr = std::ranges::find_if(m_columns,
+		[columnId](const auto &column) { return column->GetId() == columnId; });
+
+	if (itr == m_columns.end())
+	{
+		return nullptr;
+	}
+
+	return *itr;
+}
+
+const std::vector<std::shared_ptr<Plugins::PluginColumn>> &
+Plugins::PluginColumnManager::GetColumns() const
+{
+	return m_columns;
+}
+
+std::chrono::milliseconds Plugins::PluginColumnManager::GetAllocatedTimeBudget(int pluginId) const
+{
+	std::chrono::milliseconds allocatedTimeBudget{ 0 };
+
+	for (const auto &column : m_columns)
+	{
+		if (column->GetPluginId() == pluginId)
+		{
+			allocatedTimeBudget += column->GetTimeBudget();
+		}
+	}
+
+	return allocatedTimeBudget;
+}
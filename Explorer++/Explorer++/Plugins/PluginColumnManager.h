@@ -0,0 +1,164 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <sol/sol.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct BasicItemInfo_t;
+
+namespace Plugins
+{
+
+// Tracks the calls made to the columns registered by a single plugin. The counters, and the
+// decision to disable the columns, apply to the plugin as a whole, so that a plugin can't get more
+// time on the worker threads by registering more columns. May be used from any thread.
+class PluginColumnUsage : private boost::noncopyable
+{
+public:
+	// The number of times a plugin's columns can exceed their budget before they're all disabled.
+	static constexpr uint64_t MAX_TIMEOUTS = 10;
+
+	struct Stats
+	{
+		uint64_t numCalls;
+		uint64_t numErrors;
+		uint64_t numTimeouts;
+		std::chrono::microseconds totalTime;
+		bool disabled;
+	};
+
+	void OnCallFinished(std::chrono::steady_clock::duration duration);
+	void OnError();
+	void OnTimeout();
+
+	bool IsDisabled() const;
+	Stats GetStats() const;
+
+private:
+	std::atomic<uint64_t> m_numCalls = 0;
+	std::atomic<uint64_t> m_numErrors = 0;
+	std::atomic<uint64_t> m_numTimeouts = 0;
+	std::atomic<int64_t> m_totalTimeMicroseconds = 0;
+	std::atomic<bool> m_disabled = false;
+};
+
+// A listview column whose text is provided by a plugin.
+//
+// The text is retrieved on the same background threads that are used for the built-in columns.
+// A Lua state can only be used by a single thread at a time, so the plugin's main state can't be
+// used there. Instead, each worker thread lazily creates its own state, loads the column's script
+// into it and calls the named function in that state. The function is passed a table describing
+// the item and should return a string (anything else results in the column being left empty). The
+// worker states have access to the standard libraries listed in the plugin's manifest (other than
+// io and os.execute, see below), but not to the rest of the plugin API, since that can only be
+// used on the main thread. The worker states are owned by the column, so they're freed as soon as
+// the column itself is.
+//
+// Each call is limited to a time budget. A call that exceeds its budget is aborted. Once a
+// plugin's columns have run out of time too often, they're all disabled (see PluginColumnUsage),
+// so that a slow plugin can't tie up the worker threads that the built-in columns also rely on.
+//
+// The budget is checked between Lua instructions, so it can't interrupt a single call into a C
+// library function. The io library and os.execute() are therefore left out of the worker states,
+// since they can block indefinitely. Other library functions (e.g. string.rep() with a large
+// count) can still overrun the budget, though they will always finish eventually.
+class PluginColumn : private boost::noncopyable
+{
+public:
+	static constexpr int DEFAULT_WIDTH = 150;
+	static constexpr std::chrono::milliseconds DEFAULT_TIME_BUDGET{ 50 };
+
+	// The combined budget of all the columns registered by a single plugin. The text for each
+	// column is retrieved separately, so this limits how long a plugin can spend on a single item.
+	static constexpr std::chrono::milliseconds MAX_TIME_BUDGET{ 1000 };
+
+	struct Definition
+	{
+		std::wstring name;
+		std::wstring scriptPath;
+		std::string functionName;
+		std::vector<sol::lib> libraries;
+		int width;
+		std::chrono::milliseconds timeBudget;
+	};
+
+	PluginColumn(int id, int pluginId, Definition definition,
+		std::shared_ptr<PluginColumnUsage> usage);
+	~PluginColumn();
+
+	int GetId() const;
+	int GetPluginId() const;
+	const std::wstring &GetName() const;
+	int GetWidth() const;
+	std::chrono::milliseconds GetTimeBudget() const;
+
+	// May be called from any thread. If the text can't be retrieved (e.g. because the script
+	// failed, ran out of time, or the column has been disabled), an empty string will be returned.
+	std::wstring GetText(const BasicItemInfo_t &itemInfo);
+
+	// Returns the stats for the plugin as a whole, rather than for this column alone.
+	PluginColumnUsage::Stats GetStats() const;
+
+private:
+	struct WorkerState;
+
+	WorkerState *GetWorkerState();
+	std::unique_ptr<WorkerState> CreateWorkerState();
+
+	const int m_id;
+	const int m_pluginId;
+	const Definition m_definition;
+	const std::shared_ptr<PluginColumnUsage> m_usage;
+
+	// Keyed by the thread that uses the state. Callers hold a reference to the column while
+	// retrieving text, so none of the states can be in use when the column is destroyed.
+	std::mutex m_workerStatesMutex;
+	std::unordered_map<std::thread::id, std::unique_ptr<WorkerState>> m_workerStates;
+};
+
+// Holds the columns that have been registered by plugins. Other than the methods on the columns
+// themselves, everything here should only be used on the main thread.
+//
+// Columns that are registered are shown in the details view of filesystem folders. A column is
+// added to a tab the next time the tab sets up its columns (e.g. when it navigates), rather than
+// immediately.
+class PluginColumnManager : private boost::noncopyable
+{
+public:
+	// The columns registered by a plugin share PluginColumn::MAX_TIME_BUDGET. If a column's budget
+	// exceeds what's left, it's reduced to fit. Once there's nothing left, or the maximum number of
+	// columns has been reached, no further columns can be added.
+	std::optional<int> AddColumn(int pluginId, PluginColumn::Definition definition);
+	void RemoveColumn(int columnId);
+
+	std::shared_ptr<PluginColumn> GetColumn(int columnId) const;
+
+	// Returns the registered columns, in the order they were added.
+	const std::vector<std::shared_ptr<PluginColumn>> &GetColumns() const;
+
+private:
+	static constexpr size_t MAX_COLUMNS = 64;
+
+	std::chrono::milliseconds GetAllocatedTimeBudget(int pluginId) const;
+
+	int m_idCounter = 1;
+	std::vector<std::shared_ptr<PluginColumn>> m_columns;
+
+	// Keyed by plugin ID. The usage for a plugin is retained after its columns are removed, so
+	// that re-registering a column doesn't reset the timeout count.
+	std::unordered_map<int, std::shared_ptr<PluginColumnUsage>> m_pluginUsage;
+};
+
+}
@@ -0,0 +1,126 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "Plugins/PluginEventDispatcher.h"
+#include "Plugins/PluginProfiler.h"
+#include <unordered_map>
+#include <unordered_set>
+
+Plugins::PluginEventDispatcher::PluginEventDispatcher(
+	ScheduleDeliveryCallback scheduleDeliveryCallback, PluginProfiler *profiler) :
+	m_scheduleDeliveryCallback(std::move(scheduleDeliveryCallback)),
+	m_profiler(profiler)
+{
+}
+
+void Plugins::PluginEventDispatcher::QueueCall(int pluginId, const void *source, int observerId,
+	std::wstring_view description, Call call)
+{
+	m_queuedCalls.emplace_back(pluginId, source, observerId, std::wstring(description),
+		std::move(call));
+
+	// If a call is queued while delivery is in progress (e.g. because an observer triggered
+	// another event), it will be picked up by the next batch.
+	ScheduleDelivery(DeliveryTiming::NextMessage);
+}
+
+void Plugins::PluginEventDispatcher::RemoveCalls(const void *source,
+	std::optional<int> observerId)
+{
+	auto matches = [source, observerId](const QueuedCall &queuedCall)
+	{
+		return queuedCall.source == source
+			&& (!observerId || queuedCall.observerId == *observerId);
+	};
+
+	std::erase_if(m_queuedCalls, matches);
+	std::erase_if(m_batch, matches);
+}
+
+void Plugins::PluginEventDispatcher::DeliverQueuedCalls()
+{
+	m_scheduledTiming.reset();
+
+	// A plugin could show a modal dialog (e.g. a message box) from within an observer, which would
+	// run a nested message loop. The calls will be delivered by the outer loop instead.
+	if (m_delivering || m_queuedCalls.empty())
+	{
+		return;
+	}
+
+	m_delivering = true;
+	m_batch = std::move(m_queuedCalls);
+	m_queuedCalls.clear();
+
+	std::unordered_map<int, std::chrono::steady_clock::duration> pluginDurations;
+	std::unordered_set<int> throttledPlugins;
+	std::deque<QueuedCall> deferredCalls;
+
+	while (!m_batch.empty())
+	{
+		QueuedCall queuedCall = std::move(m_batch.front());
+		m_batch.pop_front();
+
+		// Once a plugin has been throttled, all of its remaining calls need to be deferred, so that
+		// they're still delivered in the order they were queued.
+		if (throttledPlugins.contains(queuedCall.pluginId))
+		{
+			m_profiler->RecordDeferredCall(queuedCall.pluginId);
+			deferredCalls.push_back(std::move(queuedCall));
+			continue;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		bool succeeded = queuedCall.call();
+		auto duration = std::chrono::steady_clock::now() - start;
+
+		m_profiler->RecordCall(queuedCall.pluginId, queuedCall.description, duration, succeeded);
+
+		auto &pluginDuration = pluginDurations[queuedCall.pluginId];
+		pluginDuration += duration;
+
+		if (pluginDuration > PLUGIN_BATCH_BUDGET)
+		{
+			throttledPlugins.insert(queuedCall.pluginId);
+		}
+	}
+
+	m_delivering = false;
+
+	if (!m_queuedCalls.empty())
+	{
+		// Calls were queued during delivery. Although delivery will have been scheduled at that
+		// point, the scheduled delivery may already have been attempted (and skipped) if an
+		// observer ran a nested message loop. Any plugins that were throttled will be throttled
+		// again during the next delivery, once they exceed their budget.
+		ScheduleDelivery(DeliveryTiming::NextMessage);
+	}
+	else if (!deferredCalls.empty())
+	{
+		ScheduleDelivery(DeliveryTiming::WhenIdle);
+	}
+
+	// The deferred calls were queued before anything that was queued during delivery, so they go
+	// first.
+	m_queuedCalls.insert(m_queuedCalls.begin(), std::make_move_iterator(deferredCalls.begin()),
+		std::make_move_iterator(deferredCalls.end()));
+}
+
+size_t Plugins::PluginEventDispatcher::GetNumQueuedCalls() const
+{
+	return m_queuedCalls.size() + m_batch.size();
+}
+
+void Plugins::PluginEventDispatcher::ScheduleDelivery(DeliveryTiming timing)
+{
+	if (m_scheduledTiming
+		&& (*m_scheduledTiming == timing || *m_scheduledTiming == DeliveryTiming::NextMessage))
+	{
+		return;
+	}
+
+	m_scheduledTiming = timing;
+	m_scheduleDeliveryCallback(timing);
+}
@@ -0,0 +1,94 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Plugins
+{
+
+class PluginProfiler;
+
+// Plugin event observers aren't invoked at the point an event occurs. Instead, calls to them are
+// queued here and delivered together once control returns to the message loop. That means the
+// application finishes whatever it was doing (e.g. a navigation) before any plugin code runs, and
+// it allows events to be coalesced (see TabUpdated).
+//
+// Each plugin is given a time budget per batch. Once a plugin has exceeded its budget, its
+// remaining calls are deferred until the application is idle (i.e. until there are no other
+// messages waiting), rather than being run immediately. This prevents a slow plugin from making
+// the application unresponsive, while still guaranteeing that every event is eventually delivered
+// in order.
+//
+// This class should only be used on the main thread.
+class PluginEventDispatcher : private boost::noncopyable
+{
+public:
+	// Returns true if the call succeeded.
+	using Call = std::function<bool()>;
+
+	enum class DeliveryTiming
+	{
+		// Delivery should happen once the message loop is next reached.
+		NextMessage,
+
+		// Delivery should happen once there are no other messages waiting.
+		WhenIdle
+	};
+
+	// Called when the queued calls need to be delivered. The callback should arrange for
+	// DeliverQueuedCalls() to be called at the appropriate time.
+	using ScheduleDeliveryCallback = std::function<void(DeliveryTiming timing)>;
+
+	static constexpr std::chrono::milliseconds PLUGIN_BATCH_BUDGET{ 50 };
+
+	PluginEventDispatcher(ScheduleDeliveryCallback scheduleDeliveryCallback,
+		PluginProfiler *profiler);
+
+	// The source and observer ID identify the observer the call is for, so that any pending calls
+	// can be removed if the observer is. The description is used when profiling the call.
+	void QueueCall(int pluginId, const void *source, int observerId, std::wstring_view description,
+		Call call);
+
+	// Removes any pending calls for the specified source. If an observer ID is provided, only the
+	// calls for that observer will be removed.
+	void RemoveCalls(const void *source, std::optional<int> observerId = std::nullopt);
+
+	void DeliverQueuedCalls();
+
+	size_t GetNumQueuedCalls() const;
+
+private:
+	struct QueuedCall
+	{
+		int pluginId;
+		const void *source;
+		int observerId;
+		std::wstring description;
+		Call call;
+	};
+
+	void ScheduleDelivery(DeliveryTiming timing);
+
+	const ScheduleDeliveryCallback m_scheduleDeliveryCallback;
+	PluginProfiler *const m_profiler;
+
+	std::deque<QueuedCall> m_queuedCalls;
+
+	// The calls that are currently being delivered. Calls are removed from here before they're
+	// invoked, which means that an observer being removed during delivery works as expected.
+	std::deque<QueuedCall> m_batch;
+
+	bool m_delivering = false;
+	std::optional<DeliveryTiming> m_scheduledTiming;
+};
+
+}
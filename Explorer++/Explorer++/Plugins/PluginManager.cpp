@@ -7,6 +7,7 @@
 #include "AcceleratorUpdater.h"
 #include "Plugins/Manifest.h"
 #include "Plugins/PluginCommandManager.h"
+#include "Plugins/PluginProfiler.h"
 #include <filesystem>
 #include <sol/forward.hpp>
 
@@ -82,31 +83,42 @@ bool Plugins::PluginManager::registerPlugin(const std::filesystem::path &directo
 		return false;
 	}
 
-	try
-	{
-		plugin->GetLuaState().safe_script_file(pluginFile.string());
-	}
-	catch (const sol::error &)
-	{
-		// Ignore the error. An exception can be thrown for something
-		// simple like a Lua script trying to use a variable that
-		// doesn't exist. That definitely shouldn't result in the
-		// application being terminated because of an uncaught
-		// exception.
-		// The assumption here is that since the panic handler wasn't
-		// called, the Lua state is still usable. Loading the plugin
-		// even if there's an error can be potentially useful for users,
-		// as it means that the plugin might still offer some of its
-		// functionality (if that functionality was set up before the
-		// error occurred).
-	}
-	catch (const LuaPanicException &)
+	auto *profiler = m_pluginInterface->GetPluginProfiler();
+	profiler->RegisterPlugin(plugin->GetId(), manifest.name);
+
+	// The time taken to run the main script is recorded, since that's part of the startup time.
 	{
-		// If a panic has occurred, the Lua state is irretrievably
-		// broken. It's not safe to attempt to continue to use it.
-		// Returning here will ensure that the state is simply
-		// destroyed.
-		return false;
+		PluginProfiler::ScopedCall profiledCall(profiler, plugin->GetId(), L"main script");
+
+		try
+		{
+			plugin->GetLuaState().safe_script_file(pluginFile.string());
+		}
+		catch (const sol::error &)
+		{
+			profiledCall.SetFailed();
+
+			// Ignore the error. An exception can be thrown for something
+			// simple like a Lua script trying to use a variable that
+			// doesn't exist. That definitely shouldn't result in the
+			// application being terminated because of an uncaught
+			// exception.
+			// The assumption here is that since the panic handler wasn't
+			// called, the Lua state is still usable. Loading the plugin
+			// even if there's an error can be potentially useful for users,
+			// as it means that the plugin might still offer some of its
+			// functionality (if that functionality was set up before the
+			// error occurred).
+		}
+		catch (const LuaPanicException &)
+		{
+			// If a panic has occurred, the Lua state is irretrievably
+			// broken. It's not safe to attempt to continue to use it.
+			// Returning here will ensure that the state is simply
+			// destroyed.
+			profiledCall.SetFailed();
+			return false;
+		}
 	}
 
 	m_pluginInterface->GetAccleratorUpdater()->update(
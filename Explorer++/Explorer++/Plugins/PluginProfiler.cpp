@@ -0,0 +1,78 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "Plugins/PluginProfiler.h"
+#include <algorithm>
+
+Plugins::PluginProfiler::ScopedCall::ScopedCall(PluginProfiler *profiler, int pluginId,
+	std::wstring_view description) :
+	m_profiler(profiler),
+	m_pluginId(pluginId),
+	m_description(description),
+	m_start(Clock::now())
+{
+}
+
+Plugins::PluginProfiler::ScopedCall::~ScopedCall()
+{
+	m_profiler->RecordCall(m_pluginId, m_description, Clock::now() - m_start, m_succeeded);
+}
+
+void Plugins::PluginProfiler::ScopedCall::SetFailed()
+{
+	m_succeeded = false;
+}
+
+void Plugins::PluginProfiler::RegisterPlugin(int pluginId, const std::wstring &pluginName)
+{
+	m_profiles[pluginId].pluginName = pluginName;
+}
+
+void Plugins::PluginProfiler::RecordCall(int pluginId, std::wstring_view description,
+	Clock::duration duration, bool succeeded)
+{
+	auto &profile = m_profiles[pluginId];
+	profile.numCalls++;
+	profile.totalDuration += duration;
+
+	if (!succeeded)
+	{
+		profile.numFailedCalls++;
+	}
+
+	auto &slowestCalls = profile.slowestCalls;
+
+	if (slowestCalls.size() == MAX_SLOWEST_CALLS && duration <= slowestCalls.back().duration)
+	{
+		return;
+	}
+
+	auto position = std::ranges::upper_bound(slowestCalls, duration, std::greater{},
+		[](const Call &call) { return call.duration; });
+	slowestCalls.insert(position, { std::wstring(description), duration });
+
+	if (slowestCalls.size() > MAX_SLOWEST_CALLS)
+	{
+		slowestCalls.pop_back();
+	}
+}
+
+void Plugins::PluginProfiler::RecordDeferredCall(int pluginId)
+{
+	m_profiles[pluginId].numDeferredCalls++;
+}
+
+const std::map<int, Plugins::PluginProfiler::Profile> &Plugins::PluginProfiler::GetProfiles() const
+{
+	return m_profiles;
+}
+
+void Plugins::PluginProfiler::Reset()
+{
+	for (auto &[pluginId, profile] : m_profiles)
+	{
+		profile = { profile.pluginName };
+	}
+}
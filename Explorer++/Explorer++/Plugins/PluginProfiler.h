@@ -0,0 +1,84 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <chrono>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Plugins
+{
+
+// Records how much time each plugin spends running Lua code that the application calls into (e.g.
+// event observers, menu callbacks and the plugin's main script). This allows plugins that are
+// slowing down the application to be identified.
+//
+// This class should only be used on the main thread.
+class PluginProfiler : private boost::noncopyable
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	// The number of slowest calls that are retained for each plugin.
+	static constexpr size_t MAX_SLOWEST_CALLS = 5;
+
+	struct Call
+	{
+		std::wstring description;
+		Clock::duration duration;
+	};
+
+	struct Profile
+	{
+		std::wstring pluginName;
+		uint64_t numCalls = 0;
+		uint64_t numFailedCalls = 0;
+
+		// The number of calls that were postponed because the plugin had used up its time budget.
+		uint64_t numDeferredCalls = 0;
+
+		Clock::duration totalDuration = Clock::duration::zero();
+
+		// Sorted from slowest to fastest.
+		std::vector<Call> slowestCalls;
+	};
+
+	// Records a single call for the duration of its lifetime.
+	class ScopedCall : private boost::noncopyable
+	{
+	public:
+		ScopedCall(PluginProfiler *profiler, int pluginId, std::wstring_view description);
+		~ScopedCall();
+
+		void SetFailed();
+
+	private:
+		PluginProfiler *const m_profiler;
+		const int m_pluginId;
+		const std::wstring_view m_description;
+		const Clock::time_point m_start;
+		bool m_succeeded = true;
+	};
+
+	void RegisterPlugin(int pluginId, const std::wstring &pluginName);
+
+	void RecordCall(int pluginId, std::wstring_view description, Clock::duration duration,
+		bool succeeded);
+	void RecordDeferredCall(int pluginId);
+
+	// Keyed by plugin ID.
+	const std::map<int, Profile> &GetProfiles() const;
+
+	// Clears the recorded data, while retaining the list of plugins.
+	void Reset();
+
+private:
+	std::map<int, Profile> m_profiles;
+};
+
+}
@@ -8,28 +8,34 @@
 #include "TabContainer.h"
 #include <sol/sol.hpp>
 
-Plugins::TabCreated::TabCreated(TabContainer *tabContainer) : m_tabContainer(tabContainer)
+Plugins::TabCreated::TabCreated(TabContainer *tabContainer, PluginEventDispatcher *dispatcher,
+	int pluginId) :
+	Event(dispatcher, pluginId, L"tabs.onCreated"),
+	m_tabContainer(tabContainer)
 {
 }
 
 boost::signals2::connection Plugins::TabCreated::connectObserver(sol::protected_function observer,
-	sol::this_state state)
+	sol::this_state state, int observerId)
 {
 	UNREFERENCED_PARAMETER(state);
 
 	return m_tabContainer->tabCreatedSignal.AddObserver(
-		[this, observer](int tabId, BOOL switchToNewTab)
+		[this, observer, observerId](int tabId, BOOL switchToNewTab)
 		{
 			UNREFERENCED_PARAMETER(switchToNewTab);
 
-			onTabCreated(tabId, observer);
+			onTabCreated(tabId, observer, observerId);
 		});
 }
 
-void Plugins::TabCreated::onTabCreated(int tabId, sol::protected_function observer)
+void Plugins::TabCreated::onTabCreated(int tabId, sol::protected_function observer,
+	int observerId)
 {
 	const Tab &tabInternal = m_tabContainer->GetTab(tabId);
 
+	// The tab may have been closed by the time the observer is called, so the tab data needs to be
+	// retrieved now.
 	TabsApi::Tab tab(tabInternal);
-	observer(tab);
+	queueObserverCall(observerId, observer, tab);
 }
@@ -13,14 +13,14 @@ namespace Plugins
 class TabCreated : public Event
 {
 public:
-	TabCreated(TabContainer *tabContainer);
+	TabCreated(TabContainer *tabContainer, PluginEventDispatcher *dispatcher, int pluginId);
 
 protected:
 	boost::signals2::connection connectObserver(sol::protected_function observer,
-		sol::this_state state) override;
+		sol::this_state state, int observerId) override;
 
 private:
-	void onTabCreated(int tabId, sol::protected_function observer);
+	void onTabCreated(int tabId, sol::protected_function observer, int observerId);
 
 	TabContainer *m_tabContainer;
 };
@@ -7,18 +7,21 @@
 #include "TabContainer.h"
 #include <sol/sol.hpp>
 
-Plugins::TabMoved::TabMoved(TabContainer *tabContainer) : m_tabContainer(tabContainer)
+Plugins::TabMoved::TabMoved(TabContainer *tabContainer, PluginEventDispatcher *dispatcher,
+	int pluginId) :
+	Event(dispatcher, pluginId, L"tabs.onMoved"),
+	m_tabContainer(tabContainer)
 {
 }
 
 boost::signals2::connection Plugins::TabMoved::connectObserver(sol::protected_function observer,
-	sol::this_state state)
+	sol::this_state state, int observerId)
 {
 	UNREFERENCED_PARAMETER(state);
 
 	return m_tabContainer->tabMovedSignal.AddObserver(
-		[observer](const Tab &tab, int fromIndex, int toIndex)
+		[this, observer, observerId](const Tab &tab, int fromIndex, int toIndex)
 		{
-			observer(tab.GetId(), fromIndex, toIndex);
+			queueObserverCall(observerId, observer, tab.GetId(), fromIndex, toIndex);
 		});
 }
@@ -7,14 +7,19 @@
 #include "TabContainer.h"
 #include <sol/sol.hpp>
 
-Plugins::TabRemoved::TabRemoved(TabContainer *tabContainer) : m_tabContainer(tabContainer)
+Plugins::TabRemoved::TabRemoved(TabContainer *tabContainer, PluginEventDispatcher *dispatcher,
+	int pluginId) :
+	Event(dispatcher, pluginId, L"tabs.onRemoved"),
+	m_tabContainer(tabContainer)
 {
 }
 
 boost::signals2::connection Plugins::TabRemoved::connectObserver(sol::protected_function observer,
-	sol::this_state state)
+	sol::this_state state, int observerId)
 {
 	UNREFERENCED_PARAMETER(state);
 
-	return m_tabContainer->tabRemovedSignal.AddObserver(observer);
+	return m_tabContainer->tabRemovedSignal.AddObserver(
+		[this, observer, observerId](int tabId)
+		{ queueObserverCall(observerId, observer, tabId); });
 }
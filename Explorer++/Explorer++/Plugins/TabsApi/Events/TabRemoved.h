@@ -13,11 +13,11 @@ namespace Plugins
 class TabRemoved : public Event
 {
 public:
-	TabRemoved(TabContainer *tabContainer);
+	TabRemoved(TabContainer *tabContainer, PluginEventDispatcher *dispatcher, int pluginId);
 
 protected:
 	boost::signals2::connection connectObserver(sol::protected_function observer,
-		sol::this_state state) override;
+		sol::this_state state, int observerId) override;
 
 private:
 	TabContainer *m_tabContainer;
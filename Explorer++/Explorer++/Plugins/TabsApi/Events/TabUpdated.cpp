@@ -4,43 +4,91 @@
 
 #include "stdafx.h"
 #include "Plugins/TabsApi/Events/TabUpdated.h"
-#include "Plugins/TabsApi/TabsApi.h"
 #include "TabContainer.h"
 #include <sol/sol.hpp>
 
-Plugins::TabUpdated::TabUpdated(TabContainer *tabContainer) : m_tabContainer(tabContainer)
+Plugins::TabUpdated::TabUpdated(TabContainer *tabContainer, PluginEventDispatcher *dispatcher,
+	int pluginId) :
+	Event(dispatcher, pluginId, L"tabs.onUpdated"),
+	m_tabContainer(tabContainer)
 {
 }
 
 boost::signals2::connection Plugins::TabUpdated::connectObserver(sol::protected_function observer,
-	sol::this_state state)
+	sol::this_state state, int observerId)
 {
 	return m_tabContainer->tabUpdatedSignal.AddObserver(
-		[this, observer, state](const Tab &tab, Tab::PropertyType propertyType)
+		[this, observer, state, observerId](const Tab &tab, Tab::PropertyType propertyType)
 		{
-			onTabUpdated(observer, state, tab, propertyType);
+			onTabUpdated(observer, state, observerId, tab, propertyType);
 		});
 }
 
+void Plugins::TabUpdated::onObserverRemoved(int observerId)
+{
+	std::erase_if(m_pendingUpdates,
+		[observerId](const auto &entry) { return entry.first.first == observerId; });
+}
+
 void Plugins::TabUpdated::onTabUpdated(sol::protected_function observer, sol::this_state state,
-	const Tab &tab, Tab::PropertyType propertyType)
+	int observerId, const Tab &tab, Tab::PropertyType propertyType)
 {
-	sol::state_view existingState = state;
+	PendingUpdateKey key(observerId, tab.GetId());
+	auto itr = m_pendingUpdates.find(key);
 
-	sol::table changeInfo = existingState.create_table();
+	if (itr == m_pendingUpdates.end())
+	{
+		itr = m_pendingUpdates.emplace(key, PendingUpdate{ TabsApi::Tab(tab) }).first;
+
+		queueCall(observerId,
+			[this, observer, state, key]() { return deliverUpdate(observer, state, key); });
+	}
+	else
+	{
+		// There's already a call queued for this update, which will pick up the data below.
+		itr->second.tab = TabsApi::Tab(tab);
+	}
 
 	switch (propertyType)
 	{
 	case Tab::PropertyType::Name:
-		changeInfo["name"] = tab.GetName();
+		itr->second.name = tab.GetName();
 		break;
 
 	case Tab::PropertyType::LockState:
-		changeInfo["lockState"] = tab.GetLockState();
+		itr->second.lockState = tab.GetLockState();
 		break;
 	}
+}
+
+bool Plugins::TabUpdated::deliverUpdate(sol::protected_function observer, sol::this_state state,
+	const PendingUpdateKey &key)
+{
+	auto itr = m_pendingUpdates.find(key);
+
+	if (itr == m_pendingUpdates.end())
+	{
+		return true;
+	}
+
+	// Any further updates that occur while the observer is running (or after it has run) should
+	// result in a new call being queued.
+	PendingUpdate update = std::move(itr->second);
+	m_pendingUpdates.erase(itr);
 
-	TabsApi::Tab tabData(tab);
+	sol::state_view existingState = state;
+
+	sol::table changeInfo = existingState.create_table();
+
+	if (update.name)
+	{
+		changeInfo["name"] = *update.name;
+	}
+
+	if (update.lockState)
+	{
+		changeInfo["lockState"] = *update.lockState;
+	}
 
-	observer(tab.GetId(), changeInfo, tabData);
+	return observer(key.second, changeInfo, update.tab).valid();
 }
@@ -5,25 +5,47 @@
 #pragma once
 
 #include "Plugins/Event.h"
+#include "Plugins/TabsApi/TabsApi.h"
 #include "Tab.h"
+#include <map>
+#include <optional>
+#include <utility>
 
 class TabContainer;
 
 namespace Plugins
 {
+// A tab can be updated several times in quick succession (e.g. its name changes each time it
+// navigates). Updates are coalesced, so that each observer is called at most once per tab per
+// batch. The change info passed to the observer then contains every property that changed, along
+// with its latest value.
 class TabUpdated : public Event
 {
 public:
-	TabUpdated(TabContainer *tabContainer);
+	TabUpdated(TabContainer *tabContainer, PluginEventDispatcher *dispatcher, int pluginId);
 
 protected:
 	boost::signals2::connection connectObserver(sol::protected_function observer,
-		sol::this_state state) override;
+		sol::this_state state, int observerId) override;
+	void onObserverRemoved(int observerId) override;
 
 private:
-	void onTabUpdated(sol::protected_function observer, sol::this_state state, const Tab &tab,
-		Tab::PropertyType propertyType);
+	// Keyed by observer ID and tab ID.
+	using PendingUpdateKey = std::pair<int, int>;
+
+	struct PendingUpdate
+	{
+		TabsApi::Tab tab;
+		std::optional<std::wstring> name;
+		std::optional<Tab::LockState> lockState;
+	};
+
+	void onTabUpdated(sol::protected_function observer, sol::this_state state, int observerId,
+		const Tab &tab, Tab::PropertyType propertyType);
+	bool deliverUpdate(sol::protected_function observer, sol::this_state state,
+		const PendingUpdateKey &key);
 
 	TabContainer *m_tabContainer;
+	std::map<PendingUpdateKey, PendingUpdate> m_pendingUpdates;
 };
 }
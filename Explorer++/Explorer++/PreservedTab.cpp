@@ -4,34 +4,95 @@
 
 #include "stdafx.h"
 #include "PreservedTab.h"
+#include "ShellBrowser/HistoryEntry.h"
 #include "ShellBrowser/PreservedHistoryEntry.h"
 #include "ShellBrowser/ShellBrowserImpl.h"
 #include "ShellBrowser/ShellNavigationController.h"
 
-PreservedTab::PreservedTab(const Tab &tab, int index) :
-	id(tab.GetId()),
+PreservedTab::PreservedTab(const Tab &tab, int id, int index) :
+	id(id),
 	index(index),
-	history(CopyHistoryEntries(tab)),
 	currentEntry(tab.GetShellBrowser()->GetNavigationController()->GetCurrentIndex()),
 	useCustomName(tab.GetUseCustomName()),
 	customName(tab.GetUseCustomName() ? tab.GetName() : std::wstring()),
 	lockState(tab.GetLockState()),
 	preservedFolderState(tab.GetShellBrowser())
+{
+	const auto *navigationController = tab.GetShellBrowser()->GetNavigationController();
+
+	for (int i = 0; i < navigationController->GetNumHistoryEntries(); i++)
+	{
+		const auto *entry = navigationController->GetEntryAtIndex(i);
+		AddHistoryEntry(entry->GetPidl().Raw(), entry->GetDisplayName(),
+			entry->GetFullPathForDisplay(), entry->GetSystemIconIndex());
+	}
+
+	// The tab won't have any further entries added, so there's no need to retain any spare
+	// capacity.
+	m_historyPidls.shrink_to_fit();
+	m_history.shrink_to_fit();
+}
+
+PreservedTab::PreservedTab(int id, int index, const FolderSettings &folderSettings) :
+	id(id),
+	index(index),
+	currentEntry(0),
+	useCustomName(false),
+	lockState(Tab::LockState::NotLocked),
+	preservedFolderState(folderSettings)
 {
 }
 
 PreservedTab::~PreservedTab() = default;
 
-std::vector<std::unique_ptr<PreservedHistoryEntry>> PreservedTab::CopyHistoryEntries(const Tab &tab)
+void PreservedTab::AddHistoryEntry(PCIDLIST_ABSOLUTE pidl, const std::wstring &displayName,
+	const std::wstring &fullPathForDisplay, std::optional<int> systemIconIndex)
+{
+	auto pidlOffset = static_cast<uint32_t>(m_historyPidls.size());
+	auto *pidlData = reinterpret_cast<const BYTE *>(pidl);
+	m_historyPidls.insert(m_historyPidls.end(), pidlData, pidlData + ILGetSize(pidl));
+
+	m_history.push_back({ pidlOffset, displayName, fullPathForDisplay, systemIconIndex });
+}
+
+size_t PreservedTab::GetNumHistoryEntries() const
+{
+	return m_history.size();
+}
+
+const PreservedTab::HistoryEntryInfo &PreservedTab::GetHistoryEntry(size_t index) const
+{
+	return m_history.at(index);
+}
+
+PidlAbsolute PreservedTab::GetHistoryEntryPidl(size_t index) const
+{
+	// Item IDs are byte-packed, so the pidl can be read directly from the buffer, regardless of
+	// its alignment.
+	return reinterpret_cast<PCIDLIST_ABSOLUTE>(
+		m_historyPidls.data() + m_history.at(index).pidlOffset);
+}
+
+const PreservedTab::HistoryEntryInfo &PreservedTab::GetCurrentHistoryEntry() const
+{
+	return GetHistoryEntry(currentEntry);
+}
+
+PidlAbsolute PreservedTab::GetCurrentHistoryEntryPidl() const
+{
+	return GetHistoryEntryPidl(currentEntry);
+}
+
+std::vector<std::unique_ptr<PreservedHistoryEntry>> PreservedTab::BuildHistoryEntries() const
 {
 	std::vector<std::unique_ptr<PreservedHistoryEntry>> history;
+	history.reserve(m_history.size());
 
-	for (int i = 0; i < tab.GetShellBrowser()->GetNavigationController()->GetNumHistoryEntries();
-		 i++)
+	for (size_t i = 0; i < m_history.size(); i++)
 	{
-		auto entry = std::make_unique<PreservedHistoryEntry>(
-			*tab.GetShellBrowser()->GetNavigationController()->GetEntryAtIndex(i));
-		history.push_back(std::move(entry));
+		const auto &entry = m_history[i];
+		history.push_back(std::make_unique<PreservedHistoryEntry>(GetHistoryEntryPidl(i),
+			entry.displayName, entry.fullPathForDisplay, entry.systemIconIndex));
 	}
 
 	return history;
@@ -6,19 +6,53 @@
 
 #include "ShellBrowser/PreservedFolderState.h"
 #include "Tab.h"
+#include "../Helper/PidlHelper.h"
 #include <boost/core/noncopyable.hpp>
+#include <optional>
+#include <vector>
 
 struct PreservedHistoryEntry;
 
+// Holds the state of a closed tab, so that the tab can later be restored. A large number of closed
+// tabs can be retained, so the history for the tab is stored compactly. The pidls for all history
+// entries are stored back-to-back in a single buffer, rather than being allocated individually.
+// The full set of history entries is only built when the tab is restored.
 struct PreservedTab : private boost::noncopyable
 {
-	PreservedTab(const Tab &tab, int index);
+	struct HistoryEntryInfo
+	{
+		// The offset of the entry's pidl within the shared pidl buffer.
+		uint32_t pidlOffset;
+
+		std::wstring displayName;
+		std::wstring fullPathForDisplay;
+		std::optional<int> systemIconIndex;
+	};
+
+	PreservedTab(const Tab &tab, int id, int index);
+
+	// Creates a tab with no history entries. Used when loading closed tabs from storage. Entries
+	// should be added with AddHistoryEntry().
+	PreservedTab(int id, int index, const FolderSettings &folderSettings);
+
 	~PreservedTab();
 
+	void AddHistoryEntry(PCIDLIST_ABSOLUTE pidl, const std::wstring &displayName,
+		const std::wstring &fullPathForDisplay, std::optional<int> systemIconIndex);
+	size_t GetNumHistoryEntries() const;
+	const HistoryEntryInfo &GetHistoryEntry(size_t index) const;
+	PidlAbsolute GetHistoryEntryPidl(size_t index) const;
+	const HistoryEntryInfo &GetCurrentHistoryEntry() const;
+	PidlAbsolute GetCurrentHistoryEntryPidl() const;
+
+	// Builds the full set of history entries, in the form needed to restore the tab.
+	std::vector<std::unique_ptr<PreservedHistoryEntry>> BuildHistoryEntries() const;
+
+	// Identifies the closed tab. This is assigned by the TabRestorer and is distinct from the ID of
+	// the original tab.
 	int id;
-	int index;
 
-	std::vector<std::unique_ptr<PreservedHistoryEntry>> history;
+	int index;
 	int currentEntry;
 
 	bool useCustomName;
@@ -28,5 +62,6 @@ struct PreservedTab : private boost::noncopyable
 	PreservedFolderState preservedFolderState;
 
 private:
-	static std::vector<std::unique_ptr<PreservedHistoryEntry>> CopyHistoryEntries(const Tab &tab);
+	std::vector<BYTE> m_historyPidls;
+	std::vector<HistoryEntryInfo> m_history;
 };
@@ -187,6 +187,12 @@ LONG Explorerplusplus::SaveGenericSettingsToRegistry()
 		RegistrySettings::SaveDword(hSettingsKey, _T("Language"), m_config->language);
 		RegistrySettings::SaveDword(hSettingsKey, _T("OpenTabsInForeground"),
 			m_config->openTabsInForeground);
+		RegistrySettings::SaveDword(hSettingsKey, _T("HibernateInactiveTabs"),
+			m_config->hibernateInactiveTabs);
+		RegistrySettings::SaveDword(hSettingsKey, _T("TabHibernationTimeout"),
+			static_cast<DWORD>(m_config->tabHibernationTimeout.count()));
+		RegistrySettings::SaveDword(hSettingsKey, _T("TabHibernationMemoryBudget"),
+			m_config->tabHibernationMemoryBudgetMB);
 
 		RegistrySettings::SaveDword(hSettingsKey, _T("DisplayMixedFilesAndFolders"),
 			m_config->globalFolderSettings.displayMixedFilesAndFolders);
@@ -418,6 +424,12 @@ LONG Explorerplusplus::LoadGenericSettingsFromRegistry()
 
 		RegistrySettings::Read32BitValueFromRegistry(hSettingsKey, _T("OpenTabsInForeground"),
 			m_config->openTabsInForeground);
+		RegistrySettings::Read32BitValueFromRegistry(hSettingsKey, _T("HibernateInactiveTabs"),
+			m_config->hibernateInactiveTabs);
+		RegistrySettings::ReadDword(hSettingsKey, _T("TabHibernationTimeout"),
+			[this](DWORD value) { m_config->tabHibernationTimeout = std::chrono::minutes(value); });
+		RegistrySettings::Read32BitValueFromRegistry(hSettingsKey, _T("TabHibernationMemoryBudget"),
+			m_config->tabHibernationMemoryBudgetMB);
 
 		RegistrySettings::Read32BitValueFromRegistry(hSettingsKey,
 			_T("DisplayMixedFilesAndFolders"),
@@ -0,0 +1,67 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "SettingsChangeTracker.h"
+#include "ApplicationModel.h"
+#include "Bookmarks/BookmarkTree.h"
+#include "ColorRuleModel.h"
+
+SettingsChangeTracker::SettingsChangeTracker(BookmarkTree *bookmarkTree,
+	ColorRuleModel *colorRuleModel, Applications::ApplicationModel *applicationModel,
+	ChangedCallback changedCallback) :
+	m_changedCallback(changedCallback)
+{
+	MarkAllChanged();
+
+	auto onBookmarksChanged = [this] { OnSectionChanged(Section::Bookmarks); };
+	m_connections.push_back(bookmarkTree->bookmarkItemAddedSignal.AddObserver(
+		[onBookmarksChanged](BookmarkItem &, size_t) { onBookmarksChanged(); }));
+	m_connections.push_back(bookmarkTree->bookmarkItemUpdatedSignal.AddObserver(
+		[onBookmarksChanged](BookmarkItem &, BookmarkItem::PropertyType)
+		{ onBookmarksChanged(); }));
+	m_connections.push_back(bookmarkTree->bookmarkItemMovedSignal.AddObserver(
+		[onBookmarksChanged](BookmarkItem *, const BookmarkItem *, size_t, const BookmarkItem *,
+			size_t) { onBookmarksChanged(); }));
+	m_connections.push_back(bookmarkTree->bookmarkItemRemovedSignal.AddObserver(
+		[onBookmarksChanged](const std::wstring &) { onBookmarksChanged(); }));
+
+	ObserveMovableModel(colorRuleModel, Section::ColorRules);
+	ObserveMovableModel(applicationModel, Section::ApplicationToolbar);
+}
+
+template <typename ModelType>
+void SettingsChangeTracker::ObserveMovableModel(ModelType *model, Section section)
+{
+	auto onChanged = [this, section] { OnSectionChanged(section); };
+	m_connections.push_back(
+		model->AddItemAddedObserver([onChanged](auto *, size_t) { onChanged(); }));
+	m_connections.push_back(model->AddItemUpdatedObserver([onChanged](auto *) { onChanged(); }));
+	m_connections.push_back(
+		model->AddItemMovedObserver([onChanged](auto *, size_t, size_t) { onChanged(); }));
+	m_connections.push_back(
+		model->AddItemRemovedObserver([onChanged](const auto *, size_t) { onChanged(); }));
+	m_connections.push_back(model->AddAllItemsRemovedObserver(onChanged));
+}
+
+bool SettingsChangeTracker::HasChanged(Section section) const
+{
+	return m_changedSections.contains(section);
+}
+
+void SettingsChangeTracker::MarkAllChanged()
+{
+	m_changedSections = { Section::Bookmarks, Section::ColorRules, Section::ApplicationToolbar };
+}
+
+void SettingsChangeTracker::ClearChanged(Section section)
+{
+	m_changedSections.erase(section);
+}
+
+void SettingsChangeTracker::OnSectionChanged(Section section)
+{
+	m_changedSections.insert(section);
+	m_changedCallback();
+}
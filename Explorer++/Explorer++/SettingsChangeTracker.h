@@ -0,0 +1,55 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <boost/signals2.hpp>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+class BookmarkTree;
+class ColorRuleModel;
+
+namespace Applications
+{
+class ApplicationModel;
+}
+
+// Tracks which of the model-backed settings sections have changed since they were last saved. When
+// settings are stored in the registry, each section is written separately, so a section that hasn't
+// changed doesn't need to be written again. That's important for bookmarks in particular, since
+// saving them involves deleting and recreating the entire bookmarks key.
+class SettingsChangeTracker : private boost::noncopyable
+{
+public:
+	enum class Section
+	{
+		Bookmarks,
+		ColorRules,
+		ApplicationToolbar
+	};
+
+	using ChangedCallback = std::function<void()>;
+
+	// The callback will be invoked whenever a section changes. Note that all sections are initially
+	// considered to have changed, since it's not known whether the saved settings are up to date.
+	SettingsChangeTracker(BookmarkTree *bookmarkTree, ColorRuleModel *colorRuleModel,
+		Applications::ApplicationModel *applicationModel, ChangedCallback changedCallback);
+
+	bool HasChanged(Section section) const;
+	void MarkAllChanged();
+	void ClearChanged(Section section);
+
+private:
+	template <typename ModelType>
+	void ObserveMovableModel(ModelType *model, Section section);
+
+	void OnSectionChanged(Section section);
+
+	ChangedCallback m_changedCallback;
+	std::unordered_set<Section> m_changedSections;
+	std::vector<boost::signals2::scoped_connection> m_connections;
+};
@@ -5,6 +5,8 @@
 #include "stdafx.h"
 #include "ShellBrowserImpl.h"
 #include "Config.h"
+#include "DirectoryEnumerationCache.h"
+#include "DirectoryEnumerationCacheFactory.h"
 #include "DocumentServiceProvider.h"
 #include "HistoryEntry.h"
 #include "IconFetcher.h"
@@ -17,6 +19,7 @@
 #include "WebBrowserApp.h"
 #include "../Helper/ListViewHelper.h"
 #include "../Helper/Macros.h"
+#include "../Helper/PerformanceTracer.h"
 #include "../Helper/ShellHelper.h"
 #include "../Helper/WinRTBaseWrapper.h"
 #include <wil/com.h>
@@ -26,6 +29,9 @@
 
 HRESULT ShellBrowserImpl::Navigate(NavigateParams &navigateParams)
 {
+	// This covers the entire navigation, up until the point the items are shown.
+	ScopedTraceSpan span("ShellBrowser", "Navigate");
+
 	SetCursor(LoadCursor(nullptr, IDC_WAIT));
 
 	auto resetCursor = wil::scope_exit([] { SetCursor(LoadCursor(nullptr, IDC_ARROW)); });
@@ -57,7 +63,14 @@ void ShellBrowserImpl::PrepareToChangeFolders()
 
 	m_shellChangeWatcher.StopWatchingAll();
 
-	StoreCurrentlySelectedItems();
+	// If the tab is hibernated, the listview is empty and the selection was saved when the tab was
+	// hibernated, so there's nothing to store here.
+	if (!m_hibernationState)
+	{
+		StoreCurrentlySelectedItems();
+	}
+
+	m_hibernationState.reset();
 
 	ListView_DeleteAllItems(m_hListView);
 
@@ -69,16 +82,18 @@ void ShellBrowserImpl::PrepareToChangeFolders()
 
 void ShellBrowserImpl::ClearPendingResults()
 {
-	m_columnThreadPool.clear_queue();
-	m_columnResults.clear();
+	m_columnTaskQueue.CancelPendingTasks();
+	m_columnResults.DiscardPending();
+	m_pendingMetadataColumns.clear();
+	m_pendingPluginColumns.clear();
 
 	m_iconFetcher->ClearQueue();
 
-	m_thumbnailThreadPool.clear_queue();
-	m_thumbnailResults.clear();
+	m_thumbnailTaskQueue.CancelPendingTasks();
+	m_thumbnailResults.DiscardPending();
 
-	m_infoTipsThreadPool.clear_queue();
-	m_infoTipResults.clear();
+	m_infoTipsTaskQueue.CancelPendingTasks();
+	m_infoTipResults.DiscardPending();
 }
 
 void ShellBrowserImpl::ResetFolderState()
@@ -106,6 +121,7 @@ void ShellBrowserImpl::ResetFolderState()
 	LeaveCriticalSection(&m_csDirectoryAltered);
 
 	m_itemInfoMap.clear();
+	m_itemStorageVersion++;
 
 	m_renamedItemOldPidl.reset();
 }
@@ -155,8 +171,40 @@ HRESULT ShellBrowserImpl::PerformEnumeration(NavigateParams &navigateParams,
 	std::wstring parsingPath;
 	RETURN_IF_FAILED(GetDisplayName(parent.get(), child, SHGDN_FORPARSING, parsingPath));
 
-	RETURN_IF_FAILED(
-		EnumerateFolder(navigateParams.pidl.Raw(), m_hOwner, m_folderSettings.showHidden, items));
+	// If the directory is already being shown, this is a refresh, in which case the directory should
+	// always be enumerated again.
+	bool isRefresh = m_directoryState.pidlDirectory
+		&& ArePidlsEquivalent(m_directoryState.pidlDirectory.get(), navigateParams.pidl.Raw());
+
+	auto *enumerationCache =
+		DirectoryEnumerationCacheFactory::GetInstance()->GetDirectoryEnumerationCache();
+	std::shared_ptr<const DirectorySnapshot> snapshot;
+
+	if (!isRefresh)
+	{
+		snapshot = enumerationCache->MaybeGetSnapshot(navigateParams.pidl.Raw(),
+			m_folderSettings.showHidden);
+	}
+
+	TraceCounterAdjust("ShellBrowser", snapshot ? "EnumerationCacheHits" : "EnumerationCacheMisses",
+		1);
+
+	if (snapshot)
+	{
+		items = GetItemsFromSnapshot(*snapshot);
+	}
+	else
+	{
+		RETURN_IF_FAILED(EnumerateFolder(navigateParams.pidl.Raw(), m_hOwner,
+			m_folderSettings.showHidden, items));
+
+		// The tab only needs the snapshot while the items are being copied out of it, so the
+		// returned reference isn't kept. The cache decides how long the snapshot is retained.
+		enumerationCache->AddSnapshot(CreateDirectorySnapshot(navigateParams.pidl.Raw(),
+			parsingPath, m_folderSettings.showHidden, items));
+		TraceCounter("ShellBrowser", "EnumerationCacheBytes",
+			static_cast<int64_t>(enumerationCache->GetMemoryUsage()));
+	}
 
 	PrepareToChangeFolders();
 
@@ -179,6 +227,8 @@ HRESULT ShellBrowserImpl::PerformEnumeration(NavigateParams &navigateParams,
 HRESULT ShellBrowserImpl::EnumerateFolder(PCIDLIST_ABSOLUTE pidlDirectory, HWND owner,
 	bool showHidden, std::vector<ShellBrowserImpl::ItemInfo_t> &items)
 {
+	ScopedTraceSpan span("ShellBrowser", "EnumerateFolder");
+
 	wil::com_ptr_nothrow<IShellFolder> shellFolder;
 	RETURN_IF_FAILED(BindToIdl(pidlDirectory, IID_PPV_ARGS(&shellFolder)));
 
@@ -190,12 +240,17 @@ HRESULT ShellBrowserImpl::EnumerateFolder(PCIDLIST_ABSOLUTE pidlDirectory, HWND
 	}
 
 	ShellEnumerator enumerator;
-	std::vector<PidlChild> outputPidls;
+	std::vector<unique_pidl_child> outputPidls;
 	RETURN_IF_FAILED(enumerator.EnumerateDirectory(shellFolder.get(), owner, flags, outputPidls));
 
-	for (const auto &pidl : outputPidls)
+	items.reserve(items.size() + outputPidls.size());
+
+	bool inRecycleBin = IsRecycleBin(pidlDirectory);
+
+	for (auto &pidl : outputPidls)
 	{
-		auto item = GetItemInformation(shellFolder.get(), pidlDirectory, pidl.Raw());
+		auto item =
+			GetItemInformation(shellFolder.get(), pidlDirectory, std::move(pidl), inRecycleBin);
 
 		if (item)
 		{
@@ -203,9 +258,66 @@ HRESULT ShellBrowserImpl::EnumerateFolder(PCIDLIST_ABSOLUTE pidlDirectory, HWND
 		}
 	}
 
+	TraceCounter("ShellBrowser", "ItemsEnumerated", static_cast<int64_t>(items.size()));
+
 	return S_OK;
 }
 
+DirectorySnapshot ShellBrowserImpl::CreateDirectorySnapshot(PCIDLIST_ABSOLUTE pidlDirectory,
+	const std::wstring &parsingPath, bool showHidden,
+	const std::vector<ShellBrowserImpl::ItemInfo_t> &items)
+{
+	DirectorySnapshot snapshot;
+	snapshot.directory = pidlDirectory;
+	snapshot.parsingPath = parsingPath;
+	snapshot.showHidden = showHidden;
+	snapshot.items.reserve(items.size());
+
+	for (const auto &item : items)
+	{
+		DirectorySnapshotItem snapshotItem;
+		snapshotItem.pidl = item.pridl.get();
+		snapshotItem.findData = item.wfd;
+		snapshotItem.isFindDataValid = item.isFindDataValid;
+		snapshotItem.parsingName = item.parsingName;
+		snapshotItem.displayName = item.displayName;
+		snapshotItem.editingName = item.editingName;
+		snapshot.items.push_back(std::move(snapshotItem));
+	}
+
+	return snapshot;
+}
+
+std::vector<ShellBrowserImpl::ItemInfo_t> ShellBrowserImpl::GetItemsFromSnapshot(
+	const DirectorySnapshot &snapshot)
+{
+	std::vector<ItemInfo_t> items;
+	items.reserve(snapshot.items.size());
+
+	for (const auto &snapshotItem : snapshot.items)
+	{
+		ItemInfo_t itemInfo;
+		itemInfo.pidlComplete.reset(ILCombine(snapshot.directory.Raw(), snapshotItem.pidl.Raw()));
+		itemInfo.pridl.reset(ILCloneChild(snapshotItem.pidl.Raw()));
+		itemInfo.wfd = snapshotItem.findData;
+		itemInfo.isFindDataValid = snapshotItem.isFindDataValid;
+		itemInfo.parsingName = snapshotItem.parsingName;
+		itemInfo.displayName = snapshotItem.displayName;
+		itemInfo.editingName = snapshotItem.editingName;
+
+		if (PathIsRoot(snapshotItem.parsingName.c_str()))
+		{
+			itemInfo.bDrive = TRUE;
+			StringCchCopy(itemInfo.szDrive, SIZEOF_ARRAY(itemInfo.szDrive),
+				snapshotItem.parsingName.c_str());
+		}
+
+		items.push_back(std::move(itemInfo));
+	}
+
+	return items;
+}
+
 void ShellBrowserImpl::NotifyShellOfNavigation(PCIDLIST_ABSOLUTE pidl)
 {
 	if (m_config->replaceExplorerMode == +DefaultFileManager::ReplaceExplorerMode::None)
@@ -378,13 +490,24 @@ int ShellBrowserImpl::AddItemInternal(int itemIndex, ItemInfo_t itemInfo, BOOL s
 
 std::optional<ShellBrowserImpl::ItemInfo_t> ShellBrowserImpl::GetItemInformation(
 	IShellFolder *shellFolder, PCIDLIST_ABSOLUTE pidlDirectory, PCITEMID_CHILD pidlChild)
+{
+	return GetItemInformation(shellFolder, pidlDirectory,
+		unique_pidl_child(ILCloneChild(pidlChild)), IsRecycleBin(pidlDirectory));
+}
+
+// This overload takes ownership of the child pidl, which avoids having to copy it. Additionally,
+// whether or not the directory is the recycle bin is passed in, so that the check only needs to be
+// performed once when retrieving information for every item in a directory.
+std::optional<ShellBrowserImpl::ItemInfo_t> ShellBrowserImpl::GetItemInformation(
+	IShellFolder *shellFolder, PCIDLIST_ABSOLUTE pidlDirectory, unique_pidl_child ownedPidlChild,
+	bool inRecycleBin)
 {
 	ItemInfo_t itemInfo;
 
-	unique_pidl_absolute pidlItem(ILCombine(pidlDirectory, pidlChild));
+	itemInfo.pidlComplete.reset(ILCombine(pidlDirectory, ownedPidlChild.get()));
+	itemInfo.pridl = std::move(ownedPidlChild);
 
-	itemInfo.pidlComplete.reset(ILCloneFull(pidlItem.get()));
-	itemInfo.pridl.reset(ILCloneChild(pidlChild));
+	PCITEMID_CHILD pidlChild = itemInfo.pridl.get();
 
 	std::wstring parsingName;
 	HRESULT hr = GetDisplayName(shellFolder, pidlChild, SHGDN_FORPARSING, parsingName);
@@ -407,19 +530,13 @@ std::optional<ShellBrowserImpl::ItemInfo_t> ShellBrowserImpl::GetItemInformation
 
 	SHGDNF displayNameFlags = SHGDN_INFOLDER;
 
-	unique_pidl_absolute recycleBinPidl;
-	hr = SHGetKnownFolderIDList(FOLDERID_RecycleBinFolder, KF_FLAG_DEFAULT, nullptr,
-		wil::out_param(recycleBinPidl));
-
-	bool isRecycleBin = SUCCEEDED(hr) && ArePidlsEquivalent(pidlDirectory, recycleBinPidl.get());
-
 	// SHGDN_INFOLDER | SHGDN_FORPARSING is used to ensure that the name retrieved for a filesystem
 	// file contains an extension, even if extensions are hidden in Windows Explorer. When using
 	// SHGDN_INFOLDER by itself, the resulting name won't contain an extension if extensions are
 	// hidden in Windows Explorer.
 	// Note that the recycle bin is excluded here, as the parsing names for the items are completely
 	// different to their regular display names.
-	if (!isRecycleBin && WI_IsFlagSet(attributes, SFGAO_FILESYSTEM)
+	if (!inRecycleBin && WI_IsFlagSet(attributes, SFGAO_FILESYSTEM)
 		&& WI_IsFlagClear(attributes, SFGAO_FOLDER))
 	{
 		WI_SetFlag(displayNameFlags, SHGDN_FORPARSING);
@@ -482,6 +599,15 @@ std::optional<ShellBrowserImpl::ItemInfo_t> ShellBrowserImpl::GetItemInformation
 	return std::move(itemInfo);
 }
 
+bool ShellBrowserImpl::IsRecycleBin(PCIDLIST_ABSOLUTE pidlDirectory)
+{
+	unique_pidl_absolute recycleBinPidl;
+	HRESULT hr = SHGetKnownFolderIDList(FOLDERID_RecycleBinFolder, KF_FLAG_DEFAULT, nullptr,
+		wil::out_param(recycleBinPidl));
+
+	return SUCCEEDED(hr) && ArePidlsEquivalent(pidlDirectory, recycleBinPidl.get());
+}
+
 HRESULT ShellBrowserImpl::ExtractFindDataUsingPropertyStore(IShellFolder *shellFolder,
 	PCITEMID_CHILD pidlChild, WIN32_FIND_DATA &output)
 {
@@ -532,6 +658,8 @@ HRESULT ShellBrowserImpl::ExtractFindDataUsingPropertyStore(IShellFolder *shellF
 void ShellBrowserImpl::OnEnumerationCompleted(std::vector<ShellBrowserImpl::ItemInfo_t> &&items,
 	const NavigateParams &navigateParams)
 {
+	ScopedTraceSpan span("ShellBrowser", "InsertItems");
+
 	for (auto &item : items)
 	{
 		AddItemInternal(-1, std::move(item), FALSE);
@@ -798,6 +926,7 @@ void ShellBrowserImpl::RemoveItem(int iItemInternal)
 	}
 
 	m_itemInfoMap.erase(iItemInternal);
+	m_itemStorageVersion++;
 
 	nItems = ListView_GetItemCount(m_hListView);
 
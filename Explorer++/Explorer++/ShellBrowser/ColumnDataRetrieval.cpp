@@ -7,12 +7,14 @@
 #include "Columns.h"
 #include "FolderSettings.h"
 #include "ItemData.h"
+#include "../Helper/CachedFormatter.h"
 #include "../Helper/DriveInfo.h"
 #include "../Helper/FileOperations.h"
 #include "../Helper/FolderSize.h"
 #include "../Helper/Helper.h"
 #include "../Helper/Macros.h"
 #include "../Helper/StringHelper.h"
+#include "../Helper/TaskScheduler.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <wil/com.h>
 #include <IPHlpApi.h>
@@ -281,7 +283,11 @@ std::wstring GetSizeColumnText(const BasicItemInfo_t &itemInfo,
 	ULARGE_INTEGER fileSize = { itemInfo.wfd.nFileSizeLow, itemInfo.wfd.nFileSizeHigh };
 	auto displayFormat = globalFolderSettings.forceSize ? globalFolderSettings.sizeDisplayFormat
 														: +SizeDisplayFormat::None;
-	return FormatSizeString(fileSize.QuadPart, displayFormat);
+
+	wchar_t sizeText[64];
+	size_t length = CachedFormatter::GetForCurrentThread().FormatSize(fileSize.QuadPart,
+		displayFormat, sizeText);
+	return std::wstring(sizeText, length);
 }
 
 std::wstring GetFolderSizeColumnText(const BasicItemInfo_t &itemInfo,
@@ -308,37 +314,37 @@ std::wstring GetTimeColumnText(const BasicItemInfo_t &itemInfo, TimeType timeTyp
 		return L"";
 	}
 
-	TCHAR fileTime[64];
-	BOOL bRet = FALSE;
+	const FILETIME *time = nullptr;
 
 	switch (timeType)
 	{
 	case TimeType::Modified:
-		bRet = CreateFileTimeString(&itemInfo.wfd.ftLastWriteTime, fileTime, SIZEOF_ARRAY(fileTime),
-			globalFolderSettings.showFriendlyDates);
+		time = &itemInfo.wfd.ftLastWriteTime;
 		break;
 
 	case TimeType::Created:
-		bRet = CreateFileTimeString(&itemInfo.wfd.ftCreationTime, fileTime, SIZEOF_ARRAY(fileTime),
-			globalFolderSettings.showFriendlyDates);
+		time = &itemInfo.wfd.ftCreationTime;
 		break;
 
 	case TimeType::Accessed:
-		bRet = CreateFileTimeString(&itemInfo.wfd.ftLastAccessTime, fileTime,
-			SIZEOF_ARRAY(fileTime), globalFolderSettings.showFriendlyDates);
+		time = &itemInfo.wfd.ftLastAccessTime;
 		break;
 
 	default:
 		assert(false);
-		break;
+		return EMPTY_STRING;
 	}
 
-	if (!bRet)
+	wchar_t fileTime[128];
+	size_t length = CachedFormatter::GetForCurrentThread().FormatFileTime(*time,
+		globalFolderSettings.showFriendlyDates, fileTime);
+
+	if (length == 0)
 	{
 		return EMPTY_STRING;
 	}
 
-	return fileTime;
+	return std::wstring(fileTime, length);
 }
 
 std::wstring GetRealSizeColumnText(const BasicItemInfo_t &itemInfo,
@@ -807,13 +813,22 @@ std::wstring GetMediaMetadataColumnText(const BasicItemInfo_t &itemInfo,
 		return EMPTY_STRING;
 	}
 
+	std::wstring text = FormatMediaMetadata(mediaMetadataType, tempBuffer);
+
+	free(tempBuffer);
+
+	return text;
+}
+
+std::wstring FormatMediaMetadata(MediaMetadataType mediaMetadataType, const BYTE *tempBuffer)
+{
 	TCHAR szOutput[512];
 
 	switch (mediaMetadataType)
 	{
 	case MediaMetadataType::Bitrate:
 	{
-		DWORD bitRate = *(reinterpret_cast<DWORD *>(tempBuffer));
+		DWORD bitRate = *(reinterpret_cast<const DWORD *>(tempBuffer));
 
 		if (bitRate > 1000)
 		{
@@ -837,7 +852,7 @@ std::wstring GetMediaMetadataColumnText(const BasicItemInfo_t &itemInfo,
 		/* Note that the duration itself is in 100-nanosecond units
 		(see http://msdn.microsoft.com/en-us/library/windows/desktop/dd798053(v=vs.85).aspx). */
 		boost::posix_time::time_duration duration =
-			boost::posix_time::microseconds(*(reinterpret_cast<QWORD *>(tempBuffer)) / 10);
+			boost::posix_time::microseconds(*(reinterpret_cast<const QWORD *>(tempBuffer)) / 10);
 		dateStream << duration;
 
 		StringCchCopy(szOutput, std::size(szOutput), dateStream.str().c_str());
@@ -845,7 +860,7 @@ std::wstring GetMediaMetadataColumnText(const BasicItemInfo_t &itemInfo,
 	break;
 
 	case MediaMetadataType::Protected:
-		if (*(reinterpret_cast<BOOL *>(tempBuffer)))
+		if (*(reinterpret_cast<const BOOL *>(tempBuffer)))
 		{
 			StringCchCopy(szOutput, std::size(szOutput), L"Yes");
 		}
@@ -877,12 +892,11 @@ std::wstring GetMediaMetadataColumnText(const BasicItemInfo_t &itemInfo,
 	case MediaMetadataType::Writer:
 	case MediaMetadataType::Year:
 	default:
-		StringCchCopy(szOutput, std::size(szOutput), reinterpret_cast<TCHAR *>(tempBuffer));
+		StringCchCopy(szOutput, std::size(szOutput),
+			reinterpret_cast<const TCHAR *>(tempBuffer));
 		break;
 	}
 
-	free(tempBuffer);
-
 	return szOutput;
 }
 
@@ -1014,3 +1028,247 @@ BOOL GetDriveSpaceColumnRawData(const BasicItemInfo_t &itemInfo, bool TotalSize,
 
 	return res;
 }
+
+bool IsMetadataColumn(ColumnType columnType)
+{
+	return GetDocumentPropertyKey(columnType) || GetImagePropertyId(columnType)
+		|| GetMediaMetadataType(columnType);
+}
+
+std::optional<PROPERTYKEY> GetDocumentPropertyKey(ColumnType columnType)
+{
+	switch (columnType)
+	{
+	case ColumnType::Title:
+		return PKEY_Title;
+	case ColumnType::Subject:
+		return PKEY_Subject;
+	case ColumnType::Authors:
+		return PKEY_Author;
+	case ColumnType::Keywords:
+		return PKEY_Keywords;
+	case ColumnType::Comment:
+		return PKEY_Comment;
+
+	default:
+		break;
+	}
+
+	return std::nullopt;
+}
+
+std::optional<PROPID> GetImagePropertyId(ColumnType columnType)
+{
+	switch (columnType)
+	{
+	case ColumnType::CameraModel:
+		return PropertyTagEquipModel;
+	case ColumnType::DateTaken:
+		return PropertyTagDateTime;
+	case ColumnType::Width:
+		return PropertyTagImageWidth;
+	case ColumnType::Height:
+		return PropertyTagImageHeight;
+
+	default:
+		break;
+	}
+
+	return std::nullopt;
+}
+
+std::optional<MediaMetadataType> GetMediaMetadataType(ColumnType columnType)
+{
+	switch (columnType)
+	{
+	case ColumnType::MediaBitrate:
+		return MediaMetadataType::Bitrate;
+	case ColumnType::MediaCopyright:
+		return MediaMetadataType::Copyright;
+	case ColumnType::MediaDuration:
+		return MediaMetadataType::Duration;
+	case ColumnType::MediaProtected:
+		return MediaMetadataType::Protected;
+	case ColumnType::MediaRating:
+		return MediaMetadataType::Rating;
+	case ColumnType::MediaAlbumArtist:
+		return MediaMetadataType::AlbumArtist;
+	case ColumnType::MediaAlbum:
+		return MediaMetadataType::AlbumTitle;
+	case ColumnType::MediaBeatsPerMinute:
+		return MediaMetadataType::BeatsPerMinute;
+	case ColumnType::MediaComposer:
+		return MediaMetadataType::Composer;
+	case ColumnType::MediaConductor:
+		return MediaMetadataType::Conductor;
+	case ColumnType::MediaDirector:
+		return MediaMetadataType::Director;
+	case ColumnType::MediaGenre:
+		return MediaMetadataType::Genre;
+	case ColumnType::MediaLanguage:
+		return MediaMetadataType::Language;
+	case ColumnType::MediaBroadcastDate:
+		return MediaMetadataType::BroadcastDate;
+	case ColumnType::MediaChannel:
+		return MediaMetadataType::Channel;
+	case ColumnType::MediaStationName:
+		return MediaMetadataType::StationName;
+	case ColumnType::MediaMood:
+		return MediaMetadataType::Mood;
+	case ColumnType::MediaParentalRating:
+		return MediaMetadataType::ParentalRating;
+	case ColumnType::MediaParentalRatingReason:
+		return MediaMetadataType::ParentalRatingReason;
+	case ColumnType::MediaPeriod:
+		return MediaMetadataType::Period;
+	case ColumnType::MediaProducer:
+		return MediaMetadataType::Producer;
+	case ColumnType::MediaPublisher:
+		return MediaMetadataType::Publisher;
+	case ColumnType::MediaWriter:
+		return MediaMetadataType::Writer;
+	case ColumnType::MediaYear:
+		return MediaMetadataType::Year;
+
+	default:
+		break;
+	}
+
+	return std::nullopt;
+}
+
+std::vector<std::wstring> GetMetadataColumnTexts(const std::vector<ColumnType> &columnTypes,
+	const BasicItemInfo_t &basicItemInfo, const GlobalFolderSettings &globalFolderSettings,
+	const CancellationToken &cancellationToken)
+{
+	std::vector<std::wstring> columnTexts(columnTypes.size());
+
+	// The requested columns are grouped by the source their values are read from. Each source is
+	// then only opened once, no matter how many of its values are needed.
+	std::vector<size_t> documentIndexes;
+	std::vector<PROPERTYKEY> documentKeys;
+	std::vector<size_t> imageIndexes;
+	std::vector<PROPID> imagePropIds;
+	std::vector<size_t> mediaIndexes;
+	std::vector<MediaMetadataType> mediaTypes;
+	std::vector<const TCHAR *> mediaAttributeNames;
+
+	for (size_t i = 0; i < columnTypes.size(); i++)
+	{
+		if (auto key = GetDocumentPropertyKey(columnTypes[i]))
+		{
+			documentIndexes.push_back(i);
+			documentKeys.push_back(*key);
+		}
+		else if (auto propId = GetImagePropertyId(columnTypes[i]))
+		{
+			imageIndexes.push_back(i);
+			imagePropIds.push_back(*propId);
+		}
+		else if (auto mediaMetadataType = GetMediaMetadataType(columnTypes[i]))
+		{
+			mediaIndexes.push_back(i);
+			mediaTypes.push_back(*mediaMetadataType);
+			mediaAttributeNames.push_back(GetMediaMetadataAttributeName(*mediaMetadataType));
+		}
+		else
+		{
+			DCHECK(false) << "Not a metadata column";
+		}
+	}
+
+	if (!documentKeys.empty() && !cancellationToken.IsCancelled())
+	{
+		auto values = GetDocumentPropertyTexts(basicItemInfo, documentKeys, globalFolderSettings);
+
+		for (size_t i = 0; i < values.size(); i++)
+		{
+			columnTexts[documentIndexes[i]] = std::move(values[i]);
+		}
+	}
+
+	if (!imagePropIds.empty() && !cancellationToken.IsCancelled())
+	{
+		auto values = ReadImageProperties(basicItemInfo.getFullPath().c_str(), imagePropIds);
+
+		for (size_t i = 0; i < values.size(); i++)
+		{
+			if (values[i])
+			{
+				columnTexts[imageIndexes[i]] = std::move(*values[i]);
+			}
+		}
+	}
+
+	if (!mediaAttributeNames.empty() && !cancellationToken.IsCancelled())
+	{
+		auto values =
+			GetMediaMetadataAttributes(basicItemInfo.getFullPath().c_str(), mediaAttributeNames);
+
+		for (size_t i = 0; i < values.size(); i++)
+		{
+			if (values[i])
+			{
+				columnTexts[mediaIndexes[i]] =
+					FormatMediaMetadata(mediaTypes[i], values[i]->data());
+			}
+		}
+	}
+
+	return columnTexts;
+}
+
+std::vector<std::wstring> GetDocumentPropertyTexts(const BasicItemInfo_t &basicItemInfo,
+	const std::vector<PROPERTYKEY> &keys, const GlobalFolderSettings &globalFolderSettings)
+{
+	std::vector<std::wstring> texts(keys.size());
+
+	wil::com_ptr_nothrow<IShellItem2> shellItem;
+	HRESULT hr =
+		SHCreateItemFromIDList(basicItemInfo.pidlComplete.get(), IID_PPV_ARGS(&shellItem));
+
+	if (FAILED(hr))
+	{
+		return texts;
+	}
+
+	// Opening the property store is the expensive part, since it involves loading the property
+	// handler for the item, which will then typically open and parse the file.
+	wil::com_ptr_nothrow<IPropertyStore> propertyStore;
+	hr = shellItem->GetPropertyStore(GPS_DEFAULT, IID_PPV_ARGS(&propertyStore));
+
+	if (FAILED(hr))
+	{
+		return texts;
+	}
+
+	for (size_t i = 0; i < keys.size(); i++)
+	{
+		wil::unique_prop_variant propertyValue;
+		hr = propertyStore->GetValue(keys[i], &propertyValue);
+
+		if (FAILED(hr) || propertyValue.vt == VT_EMPTY)
+		{
+			continue;
+		}
+
+		wil::unique_variant value;
+		hr = PropVariantToVariant(&propertyValue, &value);
+
+		if (FAILED(hr))
+		{
+			continue;
+		}
+
+		TCHAR text[512];
+		hr = ConvertVariantToString(&value, text, std::size(text),
+			globalFolderSettings.showFriendlyDates);
+
+		if (SUCCEEDED(hr))
+		{
+			texts[i] = text;
+		}
+	}
+
+	return texts;
+}
@@ -5,8 +5,12 @@
 #pragma once
 
 #include "Columns.h"
+#include <propsys.h>
+#include <optional>
 #include <string>
+#include <vector>
 
+class CancellationToken;
 struct BasicItemInfo_t;
 struct GlobalFolderSettings;
 
@@ -97,6 +101,7 @@ std::wstring GetPrinterColumnText(const BasicItemInfo_t &itemInfo,
 std::wstring GetNetworkAdapterColumnText(const BasicItemInfo_t &itemInfo);
 std::wstring GetMediaMetadataColumnText(const BasicItemInfo_t &itemInfo,
 	MediaMetadataType mediaMetadataType);
+std::wstring FormatMediaMetadata(MediaMetadataType mediaMetadataType, const BYTE *tempBuffer);
 const TCHAR *GetMediaMetadataAttributeName(MediaMetadataType mediaMetadataType);
 std::wstring GetDriveSpaceColumnText(const BasicItemInfo_t &itemInfo, bool TotalSize,
 	const GlobalFolderSettings &globalFolderSettings);
@@ -106,3 +111,22 @@ std::wstring GetSizeColumnText(const BasicItemInfo_t &itemInfo,
 	const GlobalFolderSettings &globalFolderSettings);
 std::wstring GetFolderSizeColumnText(const BasicItemInfo_t &itemInfo,
 	const GlobalFolderSettings &globalFolderSettings);
+
+// Metadata columns are those whose values are read from the contents of a file (document
+// properties, image properties and media attributes). Retrieving one of these values means opening
+// the file, so when several metadata columns are shown, the values for an item are retrieved
+// together, via GetMetadataColumnTexts(). That opens each source once per item, rather than once
+// per column.
+bool IsMetadataColumn(ColumnType columnType);
+std::optional<PROPERTYKEY> GetDocumentPropertyKey(ColumnType columnType);
+std::optional<PROPID> GetImagePropertyId(ColumnType columnType);
+std::optional<MediaMetadataType> GetMediaMetadataType(ColumnType columnType);
+
+// Returns the text for each of the specified metadata columns, in the same order. The text for a
+// column will be empty if its value couldn't be retrieved. The token is checked before each source
+// is opened; if it's cancelled, the remaining texts are left empty.
+std::vector<std::wstring> GetMetadataColumnTexts(const std::vector<ColumnType> &columnTypes,
+	const BasicItemInfo_t &basicItemInfo, const GlobalFolderSettings &globalFolderSettings,
+	const CancellationToken &cancellationToken);
+std::vector<std::wstring> GetDocumentPropertyTexts(const BasicItemInfo_t &basicItemInfo,
+	const std::vector<PROPERTYKEY> &keys, const GlobalFolderSettings &globalFolderSettings);
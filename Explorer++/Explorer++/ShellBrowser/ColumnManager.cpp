@@ -9,63 +9,189 @@
 #include "Config.h"
 #include "ItemData.h"
 #include "MainResource.h"
+#include "Plugins/PluginColumnManager.h"
 #include "ResourceHelper.h"
 #include "SortModes.h"
 #include "ViewModes.h"
+#include "../Helper/PerformanceTracer.h"
+#include <algorithm>
 #include <cassert>
 #include <list>
 
 void ShellBrowserImpl::QueueColumnTask(int itemInternalIndex, ColumnType columnType)
 {
-	int columnResultID = m_columnResultIDCounter++;
+	BasicItemInfo_t basicItemInfo = getBasicItemInfo(itemInternalIndex);
+	GlobalFolderSettings globalFolderSettings = m_config->globalFolderSettings;
+
+	m_columnTaskQueue.Post(
+		[resultQueue = &m_columnResults, generation = m_columnResults.GetGeneration(), columnType,
+			itemInternalIndex, basicItemInfo,
+			globalFolderSettings](const CancellationToken &cancellationToken)
+		{
+			if (cancellationToken.IsCancelled())
+			{
+				return;
+			}
+
+			resultQueue->Push(generation,
+				GetColumnTextAsync(columnType, itemInternalIndex, basicItemInfo,
+					globalFolderSettings));
+		});
+}
+
+void ShellBrowserImpl::QueueMetadataColumnTask(int itemInternalIndex, ColumnType columnType)
+{
+	auto itr = m_pendingMetadataColumns.find(itemInternalIndex);
+
+	if (itr != m_pendingMetadataColumns.end())
+	{
+		// If the column was added after the metadata for this item was requested, it won't be
+		// part of the existing request, so it needs to be retrieved separately.
+		if (std::ranges::find(itr->second, columnType) == itr->second.end())
+		{
+			QueueColumnTask(itemInternalIndex, columnType);
+		}
+
+		return;
+	}
+
+	// Rather than retrieving only the requested column, the values for all the visible metadata
+	// columns are retrieved at once, since the listview will ask for them shortly anyway.
+	std::vector<ColumnType> columnTypes;
+
+	for (const Column_t &column : *m_pActiveColumns)
+	{
+		if (column.checked && IsMetadataColumn(column.type))
+		{
+			columnTypes.push_back(column.type);
+		}
+	}
+
+	if (std::ranges::find(columnTypes, columnType) == columnTypes.end())
+	{
+		columnTypes.push_back(columnType);
+	}
 
 	BasicItemInfo_t basicItemInfo = getBasicItemInfo(itemInternalIndex);
 	GlobalFolderSettings globalFolderSettings = m_config->globalFolderSettings;
 
-	auto result = m_columnThreadPool.push(
-		[listView = m_hListView, columnResultID, columnType, itemInternalIndex, basicItemInfo,
-			globalFolderSettings](int id)
+	m_columnTaskQueue.Post(
+		[resultQueue = &m_columnResults, generation = m_columnResults.GetGeneration(),
+			itemInternalIndex, columnTypes, basicItemInfo,
+			globalFolderSettings](const CancellationToken &cancellationToken)
 		{
-			UNREFERENCED_PARAMETER(id);
+			ScopedTraceSpan span("ShellBrowser", "GetMetadataColumnTexts");
+
+			auto columnTexts = GetMetadataColumnTexts(columnTypes, basicItemInfo,
+				globalFolderSettings, cancellationToken);
 
-			return GetColumnTextAsync(listView, columnResultID, columnType, itemInternalIndex,
-				basicItemInfo, globalFolderSettings);
+			// The texts may be incomplete in this case and the results would be discarded anyway.
+			if (cancellationToken.IsCancelled())
+			{
+				return;
+			}
+
+			for (size_t i = 0; i < columnTypes.size(); i++)
+			{
+				ColumnResult_t result;
+				result.itemInternalIndex = itemInternalIndex;
+				result.columnType = columnTypes[i];
+				result.columnText = std::move(columnTexts[i]);
+				resultQueue->Push(generation, std::move(result));
+			}
 		});
 
-	// The function call above might finish before this line runs,
-	// but that doesn't matter, as the results won't be processed
-	// until a message posted to the main thread has been handled
-	// (which can only occur after this function has returned).
-	m_columnResults.insert({ columnResultID, std::move(result) });
+	m_pendingMetadataColumns.emplace(itemInternalIndex, std::move(columnTypes));
 }
 
-ShellBrowserImpl::ColumnResult_t ShellBrowserImpl::GetColumnTextAsync(HWND listView,
-	int columnResultId, ColumnType columnType, int internalIndex,
-	const BasicItemInfo_t &basicItemInfo, const GlobalFolderSettings &globalFolderSettings)
+void ShellBrowserImpl::QueuePluginColumnTask(int itemInternalIndex, int pluginColumnId)
 {
-	std::wstring columnText = GetColumnText(columnType, basicItemInfo, globalFolderSettings);
+	auto [itr, inserted] = m_pendingPluginColumns.emplace(itemInternalIndex, pluginColumnId);
+
+	if (!inserted)
+	{
+		return;
+	}
 
-	// This message may be delivered before this function has returned.
-	// That doesn't actually matter, since the message handler will
-	// simply wait for the result to be returned.
-	PostMessage(listView, WM_APP_COLUMN_RESULT_READY, columnResultId, 0);
+	auto pluginColumn = m_pluginColumnManager->GetColumn(pluginColumnId);
+
+	if (!pluginColumn)
+	{
+		// The plugin has removed the column, though it will still be shown until the columns are
+		// next set up. An empty result is queued, so that the text is still set (and the item
+		// isn't requested again).
+		ColumnResult_t result;
+		result.itemInternalIndex = itemInternalIndex;
+		result.pluginColumnId = pluginColumnId;
+		m_columnResults.Push(m_columnResults.GetGeneration(), std::move(result));
+		return;
+	}
+
+	BasicItemInfo_t basicItemInfo = getBasicItemInfo(itemInternalIndex);
+
+	// The column object is captured here, so that it stays alive while the task is running, even
+	// if the plugin removes it in the meantime.
+	m_columnTaskQueue.Post(
+		[resultQueue = &m_columnResults, generation = m_columnResults.GetGeneration(),
+			pluginColumn, itemInternalIndex,
+			basicItemInfo](const CancellationToken &cancellationToken)
+		{
+			if (cancellationToken.IsCancelled())
+			{
+				return;
+			}
+
+			ScopedTraceSpan span("ShellBrowser", "GetPluginColumnText");
+
+			ColumnResult_t result;
+			result.itemInternalIndex = itemInternalIndex;
+			result.columnText = pluginColumn->GetText(basicItemInfo);
+			result.pluginColumnId = pluginColumn->GetId();
+			resultQueue->Push(generation, std::move(result));
+		});
+}
+
+ShellBrowserImpl::ColumnResult_t ShellBrowserImpl::GetColumnTextAsync(ColumnType columnType,
+	int internalIndex, const BasicItemInfo_t &basicItemInfo,
+	const GlobalFolderSettings &globalFolderSettings)
+{
+	ScopedTraceSpan span("ShellBrowser", "GetColumnText");
 
 	ColumnResult_t result;
 	result.itemInternalIndex = internalIndex;
 	result.columnType = columnType;
-	result.columnText = columnText;
+	result.columnText = GetColumnText(columnType, basicItemInfo, globalFolderSettings);
 
 	return result;
 }
 
-void ShellBrowserImpl::ProcessColumnResult(int columnResultId)
+void ShellBrowserImpl::ProcessColumnResults()
 {
-	auto itr = m_columnResults.find(columnResultId);
+	size_t numResults = m_columnResults.Drain([this](const ColumnResult_t &result)
+		{ ProcessColumnResult(result); });
+
+	TraceCounter("ShellBrowser", "ColumnResultsPerBatch", static_cast<int64_t>(numResults));
+}
 
-	if (itr == m_columnResults.end())
+void ShellBrowserImpl::ProcessColumnResult(const ColumnResult_t &result)
+{
+	if (result.pluginColumnId)
 	{
-		// This result is for a previous folder. It can be ignored.
-		return;
+		m_pendingPluginColumns.erase({ result.itemInternalIndex, *result.pluginColumnId });
+	}
+	else
+	{
+		auto pendingItr = m_pendingMetadataColumns.find(result.itemInternalIndex);
+
+		if (pendingItr != m_pendingMetadataColumns.end())
+		{
+			std::erase(pendingItr->second, result.columnType);
+
+			if (pendingItr->second.empty())
+			{
+				m_pendingMetadataColumns.erase(pendingItr);
+			}
+		}
 	}
 
 	if (m_folderSettings.viewMode != +ViewMode::Details)
@@ -73,8 +199,6 @@ void ShellBrowserImpl::ProcessColumnResult(int columnResultId)
 		return;
 	}
 
-	auto result = itr->second.get();
-
 	auto index = LocateItemByInternalIndex(result.itemInternalIndex);
 
 	if (!index)
@@ -83,7 +207,9 @@ void ShellBrowserImpl::ProcessColumnResult(int columnResultId)
 		return;
 	}
 
-	auto columnIndex = GetColumnIndexByType(result.columnType);
+	auto columnIndex = result.pluginColumnId
+		? GetColumnIndexByLParam(PLUGIN_COLUMN_LPARAM_BASE + *result.pluginColumnId)
+		: GetColumnIndexByType(result.columnType);
 
 	if (!columnIndex)
 	{
@@ -94,11 +220,14 @@ void ShellBrowserImpl::ProcessColumnResult(int columnResultId)
 	auto columnText = std::make_unique<TCHAR[]>(result.columnText.size() + 1);
 	StringCchCopy(columnText.get(), result.columnText.size() + 1, result.columnText.c_str());
 	ListView_SetItemText(m_hListView, *index, *columnIndex, columnText.get());
-
-	m_columnResults.erase(itr);
 }
 
 std::optional<int> ShellBrowserImpl::GetColumnIndexByType(ColumnType columnType) const
+{
+	return GetColumnIndexByLParam(static_cast<LPARAM>(columnType));
+}
+
+std::optional<int> ShellBrowserImpl::GetColumnIndexByLParam(LPARAM lParam) const
 {
 	HWND header = ListView_GetHeader(m_hListView);
 
@@ -115,7 +244,7 @@ std::optional<int> ShellBrowserImpl::GetColumnIndexByType(ColumnType columnType)
 			continue;
 		}
 
-		if (static_cast<ColumnType::_integral>(hdItem.lParam) == columnType._to_integral())
+		if (hdItem.lParam == lParam)
 		{
 			return i;
 		}
@@ -125,6 +254,34 @@ std::optional<int> ShellBrowserImpl::GetColumnIndexByType(ColumnType columnType)
 }
 
 std::optional<ColumnType> ShellBrowserImpl::GetColumnTypeByIndex(int index) const
+{
+	auto lParam = GetColumnLParamByIndex(index);
+
+	if (!lParam || IsPluginColumnLParam(*lParam))
+	{
+		return std::nullopt;
+	}
+
+	auto columnType =
+		ColumnType::_from_integral_nothrow(static_cast<ColumnType::_integral>(*lParam));
+	CHECK(columnType);
+
+	return *columnType;
+}
+
+std::optional<int> ShellBrowserImpl::GetPluginColumnIdByIndex(int index) const
+{
+	auto lParam = GetColumnLParamByIndex(index);
+
+	if (!lParam || !IsPluginColumnLParam(*lParam))
+	{
+		return std::nullopt;
+	}
+
+	return static_cast<int>(*lParam - PLUGIN_COLUMN_LPARAM_BASE);
+}
+
+std::optional<LPARAM> ShellBrowserImpl::GetColumnLParamByIndex(int index) const
 {
 	HWND hHeader = ListView_GetHeader(m_hListView);
 
@@ -137,11 +294,12 @@ std::optional<ColumnType> ShellBrowserImpl::GetColumnTypeByIndex(int index) cons
 		return std::nullopt;
 	}
 
-	auto columnType =
-		ColumnType::_from_integral_nothrow(static_cast<ColumnType::_integral>(hdItem.lParam));
-	CHECK(columnType);
+	return hdItem.lParam;
+}
 
-	return *columnType;
+bool ShellBrowserImpl::IsPluginColumnLParam(LPARAM lParam)
+{
+	return lParam >= PLUGIN_COLUMN_LPARAM_BASE;
 }
 
 void ShellBrowserImpl::AddFirstColumn()
@@ -175,6 +333,20 @@ void ShellBrowserImpl::SetUpListViewColumns()
 		m_nActiveColumns++;
 	}
 
+	// Plugin columns are only shown for filesystem folders and always appear after the built-in
+	// columns.
+	if (m_pActiveColumns == &m_folderColumns.realFolderColumns)
+	{
+		for (const auto &pluginColumn : m_pluginColumnManager->GetColumns())
+		{
+			InsertPluginColumn(pluginColumn->GetId(), pluginColumn->GetName(), currentIndex,
+				pluginColumn->GetWidth());
+
+			currentIndex++;
+			m_nActiveColumns++;
+		}
+	}
+
 	for (int i = m_nCurrentColumns + m_nActiveColumns; i >= m_nActiveColumns; i--)
 	{
 		ListView_DeleteColumn(m_hListView, i);
@@ -211,6 +383,25 @@ void ShellBrowserImpl::InsertColumn(ColumnType columnType, int columnIndex, int
 	Header_SetItem(header, actualColumnIndex, &hdItem);
 }
 
+void ShellBrowserImpl::InsertPluginColumn(int pluginColumnId, const std::wstring &name,
+	int columnIndex, int width)
+{
+	std::wstring columnText = name;
+
+	LV_COLUMN lvColumn;
+	lvColumn.mask = LVCF_TEXT | LVCF_WIDTH;
+	lvColumn.pszText = columnText.data();
+	lvColumn.cx = width;
+	int actualColumnIndex = ListView_InsertColumn(m_hListView, columnIndex, &lvColumn);
+
+	HWND header = ListView_GetHeader(m_hListView);
+
+	HDITEM hdItem;
+	hdItem.mask = HDI_LPARAM;
+	hdItem.lParam = PLUGIN_COLUMN_LPARAM_BASE + pluginColumnId;
+	Header_SetItem(header, actualColumnIndex, &hdItem);
+}
+
 void ShellBrowserImpl::DeleteAllColumns()
 {
 	HWND header = ListView_GetHeader(m_hListView);
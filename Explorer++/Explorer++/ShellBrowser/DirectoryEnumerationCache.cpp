@@ -0,0 +1,214 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "DirectoryEnumerationCache.h"
+#include "../Helper/ShellHelper.h"
+#include <glog/logging.h>
+
+namespace
+{
+
+HWND CreateMessageWindow()
+{
+	HWND messageWindow = CreateWindow(WC_STATIC, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, nullptr,
+		GetModuleHandle(nullptr), nullptr);
+	CHECK(messageWindow);
+	return messageWindow;
+}
+
+}
+
+DirectoryEnumerationCache::DirectoryEnumerationCache(uint64_t memoryBudget) :
+	m_memoryBudget(memoryBudget),
+	m_messageWindow(CreateMessageWindow()),
+	m_shellChangeWatcher(m_messageWindow.get(),
+		std::bind_front(&DirectoryEnumerationCache::ProcessShellChangeNotifications, this),
+		ShellChangeWatcher::Delivery::Immediate)
+{
+}
+
+std::shared_ptr<const DirectorySnapshot> DirectoryEnumerationCache::MaybeGetSnapshot(
+	PCIDLIST_ABSOLUTE pidlDirectory, bool showHidden)
+{
+	auto itr = std::find_if(m_entries.begin(), m_entries.end(),
+		[pidlDirectory, showHidden](const Entry &entry) {
+			return entry.snapshot->showHidden == showHidden
+				&& ArePidlsEquivalent(entry.snapshot->directory.Raw(), pidlDirectory);
+		});
+
+	if (itr == m_entries.end())
+	{
+		return nullptr;
+	}
+
+	return MarkUsed(itr);
+}
+
+std::shared_ptr<const DirectorySnapshot> DirectoryEnumerationCache::MaybeGetSnapshotForPath(
+	const std::wstring &parsingPath)
+{
+	auto matchingItr = m_entries.end();
+
+	for (auto itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+	{
+		const auto &snapshot = itr->snapshot;
+
+		if (CompareStringOrdinal(snapshot->parsingPath.c_str(),
+				static_cast<int>(snapshot->parsingPath.size()), parsingPath.c_str(),
+				static_cast<int>(parsingPath.size()), TRUE)
+			!= CSTR_EQUAL)
+		{
+			continue;
+		}
+
+		if (!snapshot->showHidden)
+		{
+			return MarkUsed(itr);
+		}
+
+		matchingItr = itr;
+	}
+
+	if (matchingItr == m_entries.end())
+	{
+		return nullptr;
+	}
+
+	return MarkUsed(matchingItr);
+}
+
+std::shared_ptr<const DirectorySnapshot> DirectoryEnumerationCache::AddSnapshot(
+	DirectorySnapshot &&snapshot)
+{
+	RemoveEntries(
+		[&snapshot](const Entry &entry)
+		{
+			return entry.snapshot->showHidden == snapshot.showHidden
+				&& ArePidlsEquivalent(entry.snapshot->directory.Raw(), snapshot.directory.Raw());
+		});
+
+	auto sharedSnapshot = std::make_shared<const DirectorySnapshot>(std::move(snapshot));
+	uint64_t memoryUsage = EstimateSnapshotMemoryUsage(*sharedSnapshot);
+
+	if (memoryUsage > m_memoryBudget)
+	{
+		return sharedSnapshot;
+	}
+
+	// A snapshot that can't be kept up to date can't be shared, since there would be no way of
+	// knowing whether it's stale.
+	ULONG changeNotifyId = m_shellChangeWatcher.StartWatching(sharedSnapshot->directory.Raw(),
+		SHCNE_ATTRIBUTES | SHCNE_CREATE | SHCNE_DELETE | SHCNE_MKDIR | SHCNE_RENAMEFOLDER
+			| SHCNE_RENAMEITEM | SHCNE_RMDIR | SHCNE_UPDATEDIR | SHCNE_UPDATEITEM | SHCNE_DRIVEADD
+			| SHCNE_DRIVEREMOVED);
+
+	if (changeNotifyId == 0)
+	{
+		return sharedSnapshot;
+	}
+
+	RemoveLeastRecentlyUsedEntries(memoryUsage);
+
+	m_entries.push_back({ sharedSnapshot, changeNotifyId, memoryUsage });
+	m_memoryUsage += memoryUsage;
+
+	return sharedSnapshot;
+}
+
+void DirectoryEnumerationCache::InvalidateSnapshots(PCIDLIST_ABSOLUTE pidlDirectory)
+{
+	RemoveEntries([pidlDirectory](const Entry &entry)
+		{ return ArePidlsEquivalent(entry.snapshot->directory.Raw(), pidlDirectory); });
+}
+
+uint64_t DirectoryEnumerationCache::GetMemoryUsage() const
+{
+	return m_memoryUsage;
+}
+
+uint64_t DirectoryEnumerationCache::EstimateSnapshotMemoryUsage(const DirectorySnapshot &snapshot)
+{
+	uint64_t total = sizeof(DirectorySnapshot) + snapshot.parsingPath.capacity() * sizeof(wchar_t)
+		+ snapshot.items.capacity() * sizeof(DirectorySnapshotItem);
+
+	if (snapshot.directory.HasValue())
+	{
+		total += ILGetSize(snapshot.directory.Raw());
+	}
+
+	for (const auto &item : snapshot.items)
+	{
+		if (item.pidl.HasValue())
+		{
+			total += ILGetSize(item.pidl.Raw());
+		}
+
+		total += (item.parsingName.capacity() + item.displayName.capacity()
+					 + item.editingName.capacity())
+			* sizeof(wchar_t);
+	}
+
+	return total;
+}
+
+void DirectoryEnumerationCache::ProcessShellChangeNotifications(
+	const std::vector<ShellChangeNotification> &shellChangeNotifications)
+{
+	RemoveEntries(
+		[&shellChangeNotifications](const Entry &entry)
+		{
+			return std::any_of(shellChangeNotifications.begin(), shellChangeNotifications.end(),
+				[directory = entry.snapshot->directory.Raw()](const ShellChangeNotification &change)
+				{ return DoesNotificationAffectDirectory(change, directory); });
+		});
+}
+
+bool DirectoryEnumerationCache::DoesNotificationAffectDirectory(
+	const ShellChangeNotification &change, PCIDLIST_ABSOLUTE pidlDirectory)
+{
+	if (change.pidl1
+		&& (ILIsParent(pidlDirectory, change.pidl1.get(), TRUE)
+			|| ArePidlsEquivalent(pidlDirectory, change.pidl1.get())))
+	{
+		return true;
+	}
+
+	// Items renamed into the directory will only appear in the second pidl.
+	return change.pidl2 && ILIsParent(pidlDirectory, change.pidl2.get(), TRUE);
+}
+
+std::shared_ptr<const DirectorySnapshot> DirectoryEnumerationCache::MarkUsed(
+	std::vector<Entry>::iterator itr)
+{
+	std::rotate(itr, itr + 1, m_entries.end());
+	return m_entries.back().snapshot;
+}
+
+void DirectoryEnumerationCache::RemoveEntries(std::function<bool(const Entry &entry)> predicate)
+{
+	auto removedEntries = std::ranges::stable_partition(m_entries, std::not_fn(predicate));
+
+	for (const auto &entry : removedEntries)
+	{
+		m_shellChangeWatcher.StopWatching(entry.changeNotifyId);
+		m_memoryUsage -= entry.memoryUsage;
+	}
+
+	m_entries.erase(removedEntries.begin(), removedEntries.end());
+}
+
+void DirectoryEnumerationCache::RemoveLeastRecentlyUsedEntries(uint64_t requiredSpace)
+{
+	auto itr = m_entries.begin();
+
+	while (itr != m_entries.end() && m_memoryUsage + requiredSpace > m_memoryBudget)
+	{
+		m_shellChangeWatcher.StopWatching(itr->changeNotifyId);
+		m_memoryUsage -= itr->memoryUsage;
+		++itr;
+	}
+
+	m_entries.erase(m_entries.begin(), itr);
+}
@@ -0,0 +1,96 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "ShellChangeWatcher.h"
+#include "../Helper/PidlHelper.h"
+#include <boost/core/noncopyable.hpp>
+#include <wil/resource.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct DirectorySnapshotItem
+{
+	PidlChild pidl;
+	WIN32_FIND_DATA findData;
+	bool isFindDataValid;
+	std::wstring parsingName;
+	std::wstring displayName;
+	std::wstring editingName;
+};
+
+// Contains the results of enumerating a directory. A snapshot is shared between all the tabs that
+// are showing the directory, so it's never modified once created.
+struct DirectorySnapshot
+{
+	PidlAbsolute directory;
+	std::wstring parsingPath;
+	bool showHidden;
+	std::vector<DirectorySnapshotItem> items;
+};
+
+// Enumerating a large directory can take a significant amount of time. When the same directory is
+// opened in multiple tabs (or in both panes), the results of the first enumeration can be reused.
+//
+// Tabs copy the items out of a snapshot and don't hold on to it once the navigation is complete, so
+// showing a directory doesn't cost a tab any more memory than it otherwise would. Instead, the
+// cache owns the snapshots and keeps the most recently used ones, up to a fixed memory budget.
+// While a snapshot is cached, the directory is monitored and any change to the directory will
+// result in the snapshot being dropped, so that a stale snapshot is never returned. Change
+// notifications are processed as soon as they're received (rather than being batched, as they are
+// for tabs), since a tab may navigate to the directory at any point.
+class DirectoryEnumerationCache : private boost::noncopyable
+{
+public:
+	static constexpr uint64_t DEFAULT_MEMORY_BUDGET = 32 * 1024 * 1024;
+
+	explicit DirectoryEnumerationCache(uint64_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+
+	// Returns the snapshot for the specified directory, if one is cached.
+	std::shared_ptr<const DirectorySnapshot> MaybeGetSnapshot(PCIDLIST_ABSOLUTE pidlDirectory,
+		bool showHidden);
+
+	// Returns a snapshot for the directory with the specified parsing path (compared without
+	// regard to case), if one is cached. This allows the contents of a directory to be looked up
+	// without having to parse the path (which may require accessing the disk). If snapshots both
+	// with and without hidden items are cached, the one without hidden items is returned.
+	std::shared_ptr<const DirectorySnapshot> MaybeGetSnapshotForPath(
+		const std::wstring &parsingPath);
+
+	// Adds a snapshot to the cache, replacing any existing snapshot for the same directory. If the
+	// directory can't be monitored, or the snapshot is larger than the memory budget, the snapshot
+	// won't be cached.
+	std::shared_ptr<const DirectorySnapshot> AddSnapshot(DirectorySnapshot &&snapshot);
+
+	void InvalidateSnapshots(PCIDLIST_ABSOLUTE pidlDirectory);
+
+	uint64_t GetMemoryUsage() const;
+
+	static uint64_t EstimateSnapshotMemoryUsage(const DirectorySnapshot &snapshot);
+
+private:
+	// Entries are ordered from least to most recently used.
+	struct Entry
+	{
+		std::shared_ptr<const DirectorySnapshot> snapshot;
+		ULONG changeNotifyId;
+		uint64_t memoryUsage;
+	};
+
+	void ProcessShellChangeNotifications(
+		const std::vector<ShellChangeNotification> &shellChangeNotifications);
+	static bool DoesNotificationAffectDirectory(const ShellChangeNotification &change,
+		PCIDLIST_ABSOLUTE pidlDirectory);
+	std::shared_ptr<const DirectorySnapshot> MarkUsed(std::vector<Entry>::iterator itr);
+	void RemoveEntries(std::function<bool(const Entry &entry)> predicate);
+	void RemoveLeastRecentlyUsedEntries(uint64_t requiredSpace);
+
+	const uint64_t m_memoryBudget;
+	wil::unique_hwnd m_messageWindow;
+	ShellChangeWatcher m_shellChangeWatcher;
+	std::vector<Entry> m_entries;
+	uint64_t m_memoryUsage = 0;
+};
@@ -0,0 +1,29 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "DirectoryEnumerationCacheFactory.h"
+#include "DirectoryEnumerationCache.h"
+
+DirectoryEnumerationCacheFactory::~DirectoryEnumerationCacheFactory() = default;
+
+DirectoryEnumerationCacheFactory *DirectoryEnumerationCacheFactory::GetInstance()
+{
+	if (!m_staticInstance)
+	{
+		m_staticInstance = new DirectoryEnumerationCacheFactory();
+	}
+
+	return m_staticInstance;
+}
+
+DirectoryEnumerationCache *DirectoryEnumerationCacheFactory::GetDirectoryEnumerationCache()
+{
+	if (!m_directoryEnumerationCache)
+	{
+		m_directoryEnumerationCache = std::make_unique<DirectoryEnumerationCache>();
+	}
+
+	return m_directoryEnumerationCache.get();
+}
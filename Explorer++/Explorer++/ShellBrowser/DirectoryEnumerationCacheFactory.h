@@ -0,0 +1,25 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <memory>
+
+class DirectoryEnumerationCache;
+
+class DirectoryEnumerationCacheFactory
+{
+public:
+	static DirectoryEnumerationCacheFactory *GetInstance();
+
+	DirectoryEnumerationCache *GetDirectoryEnumerationCache();
+
+private:
+	DirectoryEnumerationCacheFactory() = default;
+	~DirectoryEnumerationCacheFactory();
+
+	static inline DirectoryEnumerationCacheFactory *m_staticInstance = nullptr;
+
+	std::unique_ptr<DirectoryEnumerationCache> m_directoryEnumerationCache;
+};
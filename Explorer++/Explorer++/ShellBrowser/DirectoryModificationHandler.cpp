@@ -5,6 +5,8 @@
 #include "stdafx.h"
 #include "ShellBrowserImpl.h"
 #include "Config.h"
+#include "DirectoryEnumerationCache.h"
+#include "DirectoryEnumerationCacheFactory.h"
 #include "ItemData.h"
 #include "ShellNavigationController.h"
 #include "ViewModes.h"
@@ -214,6 +216,18 @@ void ShellBrowserImpl::DirectoryAltered()
 	LeaveCriticalSection(&m_csDirectoryAltered);
 }
 
+void ShellBrowserImpl::InvalidateCachedSnapshot(int folderId)
+{
+	if (folderId != m_uniqueFolderId)
+	{
+		return;
+	}
+
+	auto *enumerationCache =
+		DirectoryEnumerationCacheFactory::GetInstance()->GetDirectoryEnumerationCache();
+	enumerationCache->InvalidateSnapshots(m_directoryState.pidlDirectory.get());
+}
+
 void CALLBACK TimerProc(HWND hwnd, UINT uMsg, UINT_PTR idEvent, DWORD dwTime)
 {
 	UNREFERENCED_PARAMETER(uMsg);
@@ -231,6 +245,15 @@ void ShellBrowserImpl::FilesModified(DWORD Action, const TCHAR *FileName, int Ev
 
 	SetTimer(m_hOwner, EventId, 200, TimerProc);
 
+	// Any cached snapshot of the directory is out of date as soon as a change is seen, so it's
+	// invalidated straight away, rather than once the changes are processed above. This method is
+	// called on the directory monitoring thread and the cache can only be used from the main
+	// thread, so the invalidation is performed there.
+	if (m_AlteredList.empty())
+	{
+		PostMessage(m_hOwner, WM_USER_DIRECTORYCHANGED, EventId, iFolderIndex);
+	}
+
 	AlteredFile_t af;
 
 	StringCchCopy(af.szFileName, std::size(af.szFileName), FileName);
@@ -505,8 +528,8 @@ void ShellBrowserImpl::InvalidateAllColumnsForItem(int itemIndex)
 		return;
 	}
 
-	auto numColumns = std::count_if(m_pActiveColumns->begin(), m_pActiveColumns->end(),
-		[](const Column_t &column) { return column.checked; });
+	// This includes any plugin columns, which are inserted after the built-in columns.
+	int numColumns = Header_GetItemCount(ListView_GetHeader(m_hListView));
 
 	for (int i = 0; i < numColumns; i++)
 	{
@@ -6,6 +6,7 @@
 #include "ShellBrowserImpl.h"
 #include "ItemData.h"
 #include "ViewModes.h"
+#include "../Helper/PerformanceTracer.h"
 #include <wil/com.h>
 #include <thumbcache.h>
 #include <list>
@@ -58,8 +59,8 @@ void ShellBrowserImpl::RemoveThumbnailsView()
 
 	nItems = ListView_GetItemCount(m_hListView);
 
-	m_thumbnailThreadPool.clear_queue();
-	m_thumbnailResults.clear();
+	m_thumbnailTaskQueue.CancelPendingTasks();
+	m_thumbnailResults.DiscardPending();
 
 	for (i = 0; i < nItems; i++)
 	{
@@ -80,34 +81,38 @@ void ShellBrowserImpl::RemoveThumbnailsView()
 
 void ShellBrowserImpl::QueueThumbnailTask(int internalIndex)
 {
-	int thumbnailResultID = m_thumbnailResultIDCounter++;
-
 	BasicItemInfo_t basicItemInfo = getBasicItemInfo(internalIndex);
 
-	auto result = m_thumbnailThreadPool.push(
-		[this, thumbnailResultID, internalIndex, basicItemInfo](
-			int id) -> std::optional<ThumbnailResult_t>
+	m_thumbnailTaskQueue.Post(
+		[resultQueue = &m_thumbnailResults, generation = m_thumbnailResults.GetGeneration(),
+			internalIndex, basicItemInfo](const CancellationToken &cancellationToken)
 		{
-			UNREFERENCED_PARAMETER(id);
+			if (cancellationToken.IsCancelled())
+			{
+				return;
+			}
+
+			ScopedTraceSpan span("ShellBrowser", "GetThumbnail");
 
 			auto bitmap = GetThumbnail(basicItemInfo.pidlComplete.get(),
 				WTS_EXTRACT | WTS_SCALETOREQUESTEDSIZE);
 
 			if (!bitmap)
 			{
-				return std::nullopt;
+				// Thumbnail lookup failed.
+				return;
 			}
 
-			PostMessage(m_hListView, WM_APP_THUMBNAIL_RESULT_READY, thumbnailResultID, 0);
+			if (cancellationToken.IsCancelled())
+			{
+				return;
+			}
 
 			ThumbnailResult_t result;
 			result.itemInternalIndex = internalIndex;
 			result.bitmap = std::move(bitmap);
-
-			return result;
+			resultQueue->Push(generation, std::move(result));
 		});
-
-	m_thumbnailResults.insert({ thumbnailResultID, std::move(result) });
 }
 
 std::optional<int> ShellBrowserImpl::GetCachedThumbnailIndex(const ItemInfo_t &itemInfo)
@@ -165,31 +170,22 @@ wil::unique_hbitmap ShellBrowserImpl::GetThumbnail(PIDLIST_ABSOLUTE pidl, WTS_FL
 		reinterpret_cast<HBITMAP>(CopyImage(bitmap, IMAGE_BITMAP, 0, 0, LR_DEFAULTCOLOR)));
 }
 
-void ShellBrowserImpl::ProcessThumbnailResult(int thumbnailResultId)
+void ShellBrowserImpl::ProcessThumbnailResults()
 {
-	auto itr = m_thumbnailResults.find(thumbnailResultId);
-
-	if (itr == m_thumbnailResults.end())
-	{
-		return;
-	}
+	m_thumbnailResults.Drain([this](const ThumbnailResult_t &result)
+		{ ProcessThumbnailResult(result); });
+}
 
+void ShellBrowserImpl::ProcessThumbnailResult(const ThumbnailResult_t &result)
+{
 	if (m_folderSettings.viewMode != +ViewMode::Thumbnails)
 	{
 		return;
 	}
 
-	auto result = itr->second.get();
-
-	if (!result)
-	{
-		// Thumbnail lookup failed.
-		return;
-	}
-
-	int imageIndex = GetExtractedThumbnail(result->bitmap.get());
+	int imageIndex = GetExtractedThumbnail(result.bitmap.get());
 
-	auto index = LocateItemByInternalIndex(result->itemInternalIndex);
+	auto index = LocateItemByInternalIndex(result.itemInternalIndex);
 
 	if (!index)
 	{
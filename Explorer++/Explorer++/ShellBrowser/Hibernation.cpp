@@ -0,0 +1,133 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "ShellBrowserImpl.h"
+#include "ShellNavigationController.h"
+#include "../Helper/ListViewHelper.h"
+
+// Releases the data held for the items in the current folder, while keeping the tab (and its
+// history) intact. The folder will be enumerated again once Wake() is called.
+void ShellBrowserImpl::Hibernate()
+{
+	if (m_hibernationState || !m_bFolderVisited)
+	{
+		return;
+	}
+
+	HibernationState hibernationState;
+	hibernationState.scrollPosition = ListViewHelper::GetScrollPosition(m_hListView);
+	hibernationState.reclaimedBytes = EstimateItemMemoryUsage();
+
+	SaveColumnWidths();
+	StoreCurrentlySelectedItems();
+	ClearPendingResults();
+
+	m_shellChangeWatcher.StopWatchingAll();
+
+	ReleaseItemData();
+
+	m_hibernationState = hibernationState;
+}
+
+void ShellBrowserImpl::ReleaseItemData()
+{
+	SendMessage(m_hListView, WM_SETREDRAW, FALSE, NULL);
+	ListView_DeleteAllItems(m_hListView);
+	ListView_RemoveAllGroups(m_hListView);
+	SendMessage(m_hListView, WM_SETREDRAW, TRUE, NULL);
+
+	m_listViewGroups.clear();
+
+	// The directory the tab is in still needs to be known (e.g. so that the tab name can be shown),
+	// so that information is retained.
+	auto pidlDirectory = std::move(m_directoryState.pidlDirectory);
+	auto directory = std::move(m_directoryState.directory);
+	bool virtualFolder = m_directoryState.virtualFolder;
+
+	ResetFolderState();
+
+	m_directoryState.pidlDirectory = std::move(pidlDirectory);
+	m_directoryState.directory = std::move(directory);
+	m_directoryState.virtualFolder = virtualFolder;
+
+	// Clearing the map won't release the memory used by the buckets, so the map is swapped with an
+	// empty instance instead.
+	std::unordered_map<int, ItemInfo_t>().swap(m_itemInfoMap);
+	m_itemStorageVersion++;
+}
+
+void ShellBrowserImpl::Wake()
+{
+	if (!m_hibernationState)
+	{
+		return;
+	}
+
+	// Navigating will reset the hibernation state, so it needs to be copied here.
+	auto hibernationState = *m_hibernationState;
+
+	HRESULT hr = m_navigationController->Refresh();
+
+	if (FAILED(hr))
+	{
+		m_hibernationState.reset();
+		return;
+	}
+
+	// The contents of the folder may have changed while the tab was hibernated, which
+	// SetScrollPosition() accounts for.
+	ListViewHelper::SetScrollPosition(m_hListView, hibernationState.scrollPosition);
+}
+
+bool ShellBrowserImpl::IsHibernated() const
+{
+	return m_hibernationState.has_value();
+}
+
+std::optional<uint64_t> ShellBrowserImpl::GetHibernationReclaimedBytes() const
+{
+	if (!m_hibernationState)
+	{
+		return std::nullopt;
+	}
+
+	return m_hibernationState->reclaimedBytes;
+}
+
+// Returns an estimate of the amount of memory used to store the items in the current folder. This
+// doesn't include memory held by the listview control itself.
+uint64_t ShellBrowserImpl::EstimateItemMemoryUsage() const
+{
+	uint64_t total = 0;
+
+	for (const auto &[internalIndex, itemInfo] : m_itemInfoMap)
+	{
+		UNREFERENCED_PARAMETER(internalIndex);
+
+		// Each node in the map also contains a pointer to the next node, in addition to the bucket
+		// pointer.
+		total += sizeof(std::pair<const int, ItemInfo_t>) + 2 * sizeof(void *);
+
+		if (itemInfo.pidlComplete)
+		{
+			total += ILGetSize(itemInfo.pidlComplete.get());
+		}
+
+		if (itemInfo.pridl)
+		{
+			total += ILGetSize(itemInfo.pridl.get());
+		}
+
+		total += (itemInfo.parsingName.capacity() + itemInfo.displayName.capacity()
+					 + itemInfo.editingName.capacity())
+			* sizeof(wchar_t);
+	}
+
+	total += m_directoryState.cachedFolderSizes.size()
+		* (sizeof(std::pair<const int, ULONGLONG>) + 2 * sizeof(void *));
+	total += m_directoryState.filteredItemsList.size() * (sizeof(int) + 2 * sizeof(void *));
+
+	return total;
+}
@@ -0,0 +1,98 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "ShellBrowser/ItemPredicates.h"
+#include "../Helper/WildcardMatcher.h"
+#include <wil/common.h>
+#include <algorithm>
+#include <memory>
+#include <regex>
+
+namespace ItemPredicates
+{
+
+ItemPredicate MatchesWildcard(const std::wstring &pattern, bool caseSensitive)
+{
+	// The pattern is only processed once here, rather than each time an item is checked.
+	auto matcher = std::make_shared<const WildcardMatcher>(pattern, caseSensitive);
+
+	return [matcher](const WIN32_FIND_DATA &findData, bool isFindDataValid)
+	{
+		UNREFERENCED_PARAMETER(isFindDataValid);
+
+		return matcher->Matches(findData.cFileName);
+	};
+}
+
+std::optional<ItemPredicate> MatchesRegex(const std::wstring &pattern, bool caseSensitive)
+{
+	auto flags = std::regex_constants::ECMAScript | std::regex_constants::optimize;
+
+	if (!caseSensitive)
+	{
+		flags |= std::regex_constants::icase;
+	}
+
+	std::shared_ptr<const std::wregex> regex;
+
+	try
+	{
+		regex = std::make_shared<const std::wregex>(pattern, flags);
+	}
+	catch (const std::regex_error &)
+	{
+		return std::nullopt;
+	}
+
+	return [regex](const WIN32_FIND_DATA &findData, bool isFindDataValid)
+	{
+		UNREFERENCED_PARAMETER(isFindDataValid);
+
+		return std::regex_search(findData.cFileName, *regex);
+	};
+}
+
+ItemPredicate HasAttributes(DWORD attributes)
+{
+	return [attributes](const WIN32_FIND_DATA &findData, bool isFindDataValid)
+	{ return isFindDataValid && WI_AreAllFlagsSet(findData.dwFileAttributes, attributes); };
+}
+
+ItemPredicate SizeInRange(uint64_t minSize, uint64_t maxSize)
+{
+	return [minSize, maxSize](const WIN32_FIND_DATA &findData, bool isFindDataValid)
+	{
+		if (!isFindDataValid
+			|| WI_IsFlagSet(findData.dwFileAttributes, FILE_ATTRIBUTE_DIRECTORY))
+		{
+			return false;
+		}
+
+		ULARGE_INTEGER size = { { findData.nFileSizeLow, findData.nFileSizeHigh } };
+		return size.QuadPart >= minSize && size.QuadPart <= maxSize;
+	};
+}
+
+ItemPredicate ModifiedInRange(const FILETIME &from, const FILETIME &to)
+{
+	return [from, to](const WIN32_FIND_DATA &findData, bool isFindDataValid)
+	{
+		return isFindDataValid && CompareFileTime(&findData.ftLastWriteTime, &from) >= 0
+			&& CompareFileTime(&findData.ftLastWriteTime, &to) <= 0;
+	};
+}
+
+ItemPredicate All(std::vector<ItemPredicate> predicates)
+{
+	return [predicates = std::move(predicates)](const WIN32_FIND_DATA &findData,
+			   bool isFindDataValid)
+	{
+		return std::all_of(predicates.begin(), predicates.end(),
+			[&findData, isFindDataValid](const ItemPredicate &predicate)
+			{ return predicate(findData, isFindDataValid); });
+	};
+}
+
+}
@@ -0,0 +1,37 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Determines whether or not an item matches some condition. If isFindDataValid is false, only the
+// name (findData.cFileName) can be relied on. A predicate may be invoked concurrently from
+// multiple threads, so it shouldn't modify any shared state.
+using ItemPredicate = std::function<bool(const WIN32_FIND_DATA &findData, bool isFindDataValid)>;
+
+namespace ItemPredicates
+{
+
+ItemPredicate MatchesWildcard(const std::wstring &pattern, bool caseSensitive);
+
+// Returns std::nullopt if the regular expression is invalid.
+std::optional<ItemPredicate> MatchesRegex(const std::wstring &pattern, bool caseSensitive);
+
+// Matches items that have all of the specified attributes.
+ItemPredicate HasAttributes(DWORD attributes);
+
+// Matches files with a size in the range [minSize, maxSize]. Folders aren't matched.
+ItemPredicate SizeInRange(uint64_t minSize, uint64_t maxSize);
+
+// Matches items that were last modified within the range [from, to].
+ItemPredicate ModifiedInRange(const FILETIME &from, const FILETIME &to);
+
+// Matches items that match every one of the specified predicates.
+ItemPredicate All(std::vector<ItemPredicate> predicates);
+
+}
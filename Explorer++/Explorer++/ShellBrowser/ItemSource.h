@@ -0,0 +1,33 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "ItemPredicates.h"
+#include <functional>
+#include <unordered_set>
+
+// Provides read access to the items shown in a tab, along with the ability to change which of
+// those items are selected.
+class ItemSource
+{
+public:
+	// Invokes the visitor for each item (or each selected item), in the order the items are
+	// displayed. The find data passed to the visitor is a reference to the data held by this
+	// object, not a copy. It remains valid for as long as GetItemStorageVersion() returns the same
+	// value.
+	using ItemVisitor = std::function<void(int internalIndex, const WIN32_FIND_DATA &findData,
+		bool isFindDataValid)>;
+
+	virtual ~ItemSource() = default;
+
+	virtual int GetNumItems() const = 0;
+	virtual int GetNumSelected() const = 0;
+	virtual void VisitItems(const ItemVisitor &visitor, bool selectedOnly) const = 0;
+	virtual uint64_t GetItemStorageVersion() const = 0;
+
+	virtual void SelectItemsMatchingPredicate(const ItemPredicate &predicate, bool select) = 0;
+	virtual void SelectItemsByInternalIndex(const std::unordered_set<int> &internalIndexes,
+		bool select) = 0;
+};
@@ -21,6 +21,7 @@
 #include "../Helper/FileActionHandler.h"
 #include "../Helper/Helper.h"
 #include "../Helper/ListViewHelper.h"
+#include "../Helper/PerformanceTracer.h"
 #include "../Helper/ShellHelper.h"
 #include <boost/format.hpp>
 #include <glog/logging.h>
@@ -119,20 +120,24 @@ LRESULT ShellBrowserImpl::ListViewProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPAR
 		return 0;
 
 	case WM_APP_COLUMN_RESULT_READY:
-		ProcessColumnResult(static_cast<int>(wParam));
+		ProcessColumnResults();
 		break;
 
 	case WM_APP_THUMBNAIL_RESULT_READY:
-		ProcessThumbnailResult(static_cast<int>(wParam));
+		ProcessThumbnailResults();
 		break;
 
 	case WM_APP_INFO_TIP_READY:
-		ProcessInfoTipResult(static_cast<int>(wParam));
+		ProcessInfoTipResults();
 		break;
 
 	case WM_APP_PENDING_TASK_AVAILABLE:
 		OnPendingTaskAvailableMessage();
 		break;
+
+	case WM_APP_SELECTION_CHANGED:
+		OnSelectionChangedMessage();
+		break;
 	}
 
 	return DefSubclassProc(hwnd, uMsg, wParam, lParam);
@@ -387,10 +392,26 @@ void ShellBrowserImpl::OnListViewGetDisplayInfo(LPARAM lParam)
 
 	if (m_folderSettings.viewMode == +ViewMode::Details && (plvItem->mask & LVIF_TEXT) == LVIF_TEXT)
 	{
-		auto columnType = GetColumnTypeByIndex(plvItem->iSubItem);
-		assert(columnType);
+		auto pluginColumnId = GetPluginColumnIdByIndex(plvItem->iSubItem);
+
+		if (pluginColumnId)
+		{
+			QueuePluginColumnTask(internalIndex, *pluginColumnId);
+		}
+		else
+		{
+			auto columnType = GetColumnTypeByIndex(plvItem->iSubItem);
+			assert(columnType);
 
-		QueueColumnTask(internalIndex, *columnType);
+			if (IsMetadataColumn(*columnType))
+			{
+				QueueMetadataColumnTask(internalIndex, *columnType);
+			}
+			else
+			{
+				QueueColumnTask(internalIndex, *columnType);
+			}
+		}
 	}
 
 	if ((plvItem->mask & LVIF_IMAGE) == LVIF_IMAGE)
@@ -494,39 +515,46 @@ BOOL ShellBrowserImpl::OnListViewGetEmptyMarkup(NMLVEMPTYMARKUP *emptyMarkup)
 
 void ShellBrowserImpl::QueueInfoTipTask(int internalIndex, const std::wstring &existingInfoTip)
 {
-	int infoTipResultId = m_infoTipResultIDCounter++;
-
 	BasicItemInfo_t basicItemInfo = getBasicItemInfo(internalIndex);
 	Config configCopy = *m_config;
 	bool virtualFolder = InVirtualFolder();
 
-	auto result = m_infoTipsThreadPool.push(
-		[this, infoTipResultId, internalIndex, basicItemInfo, configCopy, virtualFolder,
-			existingInfoTip](int id)
+	m_infoTipsTaskQueue.Post(
+		[resultQueue = &m_infoTipResults, generation = m_infoTipResults.GetGeneration(),
+			resourceInstance = m_resourceInstance, internalIndex, basicItemInfo, configCopy,
+			virtualFolder, existingInfoTip](const CancellationToken &cancellationToken)
 		{
-			UNREFERENCED_PARAMETER(id);
+			if (cancellationToken.IsCancelled())
+			{
+				return;
+			}
+
+			ScopedTraceSpan span("ShellBrowser", "GetInfoTip");
 
-			auto result = GetInfoTipAsync(m_hListView, infoTipResultId, internalIndex,
-				basicItemInfo, configCopy, m_resourceInstance, virtualFolder);
+			auto result = GetInfoTipAsync(internalIndex, basicItemInfo, configCopy,
+				resourceInstance, virtualFolder);
+
+			if (!result || cancellationToken.IsCancelled())
+			{
+				return;
+			}
 
 			// If the item name is truncated in the listview,
 			// existingInfoTip will contain that value. Therefore, it's
 			// important that the rest of the infotip is concatenated onto
 			// that value if it's there.
-			if (result && !existingInfoTip.empty())
+			if (!existingInfoTip.empty())
 			{
 				result->infoTip = existingInfoTip + L"\n" + result->infoTip;
 			}
 
-			return result;
+			resultQueue->Push(generation, std::move(*result));
 		});
-
-	m_infoTipResults.insert({ infoTipResultId, std::move(result) });
 }
 
-std::optional<ShellBrowserImpl::InfoTipResult> ShellBrowserImpl::GetInfoTipAsync(HWND listView,
-	int infoTipResultId, int internalIndex, const BasicItemInfo_t &basicItemInfo,
-	const Config &config, HINSTANCE resourceInstance, bool virtualFolder)
+std::optional<ShellBrowserImpl::InfoTipResult> ShellBrowserImpl::GetInfoTipAsync(
+	int internalIndex, const BasicItemInfo_t &basicItemInfo, const Config &config,
+	HINSTANCE resourceInstance, bool virtualFolder)
 {
 	std::wstring infoTip;
 
@@ -563,8 +591,6 @@ std::optional<ShellBrowserImpl::InfoTipResult> ShellBrowserImpl::GetInfoTipAsync
 		infoTip = str(boost::wformat(_T("%s: %s")) % dateModified % fileModificationText);
 	}
 
-	PostMessage(listView, WM_APP_INFO_TIP_READY, infoTipResultId, 0);
-
 	InfoTipResult result;
 	result.itemInternalIndex = internalIndex;
 	result.infoTip = infoTip;
@@ -572,24 +598,22 @@ std::optional<ShellBrowserImpl::InfoTipResult> ShellBrowserImpl::GetInfoTipAsync
 	return result;
 }
 
-void ShellBrowserImpl::ProcessInfoTipResult(int infoTipResultId)
+bool ShellBrowserImpl::NotifyResultsReady(UINT message)
 {
-	auto itr = m_infoTipResults.find(infoTipResultId);
-
-	if (itr == m_infoTipResults.end())
-	{
-		return;
-	}
-
-	auto result = itr->second.get();
-	m_infoTipResults.erase(itr);
+	// This is called on a background thread, whenever a result queue goes from being empty to
+	// holding a result. All the results that are available will be processed when the message is
+	// received.
+	return PostMessage(m_hListView, message, 0, 0) != 0;
+}
 
-	if (!result)
-	{
-		return;
-	}
+void ShellBrowserImpl::ProcessInfoTipResults()
+{
+	m_infoTipResults.Drain([this](const InfoTipResult &result) { ProcessInfoTipResult(result); });
+}
 
-	auto index = LocateItemByInternalIndex(result->itemInternalIndex);
+void ShellBrowserImpl::ProcessInfoTipResult(const InfoTipResult &result)
+{
+	auto index = LocateItemByInternalIndex(result.itemInternalIndex);
 
 	if (!index)
 	{
@@ -597,7 +621,7 @@ void ShellBrowserImpl::ProcessInfoTipResult(int infoTipResultId)
 	}
 
 	TCHAR infoTipText[256];
-	StringCchCopy(infoTipText, std::size(infoTipText), result->infoTip.c_str());
+	StringCchCopy(infoTipText, std::size(infoTipText), result.infoTip.c_str());
 
 	LVSETINFOTIP infoTip;
 	infoTip.cbSize = sizeof(infoTip);
@@ -623,7 +647,7 @@ void ShellBrowserImpl::OnListViewItemInserted(const NMLISTVIEW *itemData)
 
 void ShellBrowserImpl::OnListViewItemChanged(const NMLISTVIEW *changeData)
 {
-	if (changeData->uChanged != LVIF_STATE)
+	if (changeData->uChanged != LVIF_STATE || m_batchSelectionChangeInProgress)
 	{
 		return;
 	}
@@ -656,19 +680,42 @@ void ShellBrowserImpl::OnListViewItemChanged(const NMLISTVIEW *changeData)
 
 	UpdateFileSelectionInfo(static_cast<int>(changeData->lParam), currentlySelected);
 
+	QueueSelectionChangedNotification();
+}
+
+// Operations like selecting all items or inverting the selection will result in a separate change
+// notification for every item. Broadcasting each of those changes would be wasteful, since
+// observers are only interested in the final selection. So, instead, a single notification is
+// broadcast once control returns to the message loop. The selection counts are updated
+// incrementally as each item changes, so they're accurate by the time observers are notified.
+void ShellBrowserImpl::QueueSelectionChangedNotification()
+{
+	if (m_selectionChangedNotificationPending)
+	{
+		return;
+	}
+
+	PostMessage(m_hListView, WM_APP_SELECTION_CHANGED, 0, 0);
+	m_selectionChangedNotificationPending = true;
+}
+
+void ShellBrowserImpl::OnSelectionChangedMessage()
+{
+	m_selectionChangedNotificationPending = false;
+
 	listViewSelectionChanged.m_signal();
 }
 
 void ShellBrowserImpl::UpdateFileSelectionInfo(int internalIndex, BOOL selected)
 {
+	const auto &itemInfo = m_itemInfoMap.at(internalIndex);
 	ULARGE_INTEGER ulFileSize;
 	BOOL isFolder;
 
-	isFolder = (m_itemInfoMap.at(internalIndex).wfd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
-		== FILE_ATTRIBUTE_DIRECTORY;
+	isFolder = (itemInfo.wfd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == FILE_ATTRIBUTE_DIRECTORY;
 
-	ulFileSize.LowPart = m_itemInfoMap.at(internalIndex).wfd.nFileSizeLow;
-	ulFileSize.HighPart = m_itemInfoMap.at(internalIndex).wfd.nFileSizeHigh;
+	ulFileSize.LowPart = itemInfo.wfd.nFileSizeLow;
+	ulFileSize.HighPart = itemInfo.wfd.nFileSizeHigh;
 
 	if (selected)
 	{
@@ -10,3 +10,8 @@ PreservedFolderState::PreservedFolderState(const ShellBrowserImpl *shellBrowser)
 	folderSettings(shellBrowser->GetFolderSettings())
 {
 }
+
+PreservedFolderState::PreservedFolderState(const FolderSettings &folderSettings) :
+	folderSettings(folderSettings)
+{
+}
@@ -13,6 +13,7 @@ struct PreservedFolderState : private boost::noncopyable
 {
 public:
 	PreservedFolderState(const ShellBrowserImpl *shellBrowser);
+	PreservedFolderState(const FolderSettings &folderSettings);
 
 	FolderSettings folderSettings;
 };
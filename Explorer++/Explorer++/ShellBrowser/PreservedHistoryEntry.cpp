@@ -7,10 +7,19 @@
 #include "HistoryEntry.h"
 
 PreservedHistoryEntry::PreservedHistoryEntry(const HistoryEntry &entry) :
-	id(entry.GetId()),
 	pidl(entry.GetPidl()),
 	displayName(entry.GetDisplayName()),
 	fullPathForDisplay(entry.GetFullPathForDisplay()),
 	systemIconIndex(entry.GetSystemIconIndex())
 {
 }
+
+PreservedHistoryEntry::PreservedHistoryEntry(const PidlAbsolute &pidl,
+	const std::wstring &displayName, const std::wstring &fullPathForDisplay,
+	std::optional<int> systemIconIndex) :
+	pidl(pidl),
+	displayName(displayName),
+	fullPathForDisplay(fullPathForDisplay),
+	systemIconIndex(systemIconIndex)
+{
+}
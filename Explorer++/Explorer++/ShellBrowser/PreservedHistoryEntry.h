@@ -14,8 +14,8 @@ struct PreservedHistoryEntry : private boost::noncopyable
 {
 public:
 	PreservedHistoryEntry(const HistoryEntry &entry);
-
-	const int id;
+	PreservedHistoryEntry(const PidlAbsolute &pidl, const std::wstring &displayName,
+		const std::wstring &fullPathForDisplay, std::optional<int> systemIconIndex);
 
 	PidlAbsolute pidl;
 	std::wstring displayName;
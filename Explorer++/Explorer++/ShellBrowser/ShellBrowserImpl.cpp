@@ -19,6 +19,7 @@
 #include "ShellBrowserEmbedder.h"
 #include "ShellBrowserHelper.h"
 #include "ShellNavigationController.h"
+#include "SortHelper.h"
 #include "SortModes.h"
 #include "ThemeManager.h"
 #include "ViewModeHelper.h"
@@ -31,6 +32,8 @@
 #include "../Helper/Macros.h"
 #include "../Helper/ShellHelper.h"
 #include <wil/com.h>
+#include <algorithm>
+#include <execution>
 #include <list>
 
 void CALLBACK TimerProc(HWND hwnd, UINT uMsg, UINT_PTR idEvent, DWORD dwTime);
@@ -84,15 +87,13 @@ ShellBrowserImpl::ShellBrowserImpl(HWND hOwner, ShellBrowserEmbedder *embedder,
 	m_folderColumns(initialColumns
 			? *initialColumns
 			: coreInterface->GetConfig()->globalFolderSettings.folderColumns),
-	m_columnThreadPool(1, std::bind(CoInitializeEx, nullptr, COINIT_APARTMENTTHREADED),
-		CoUninitialize),
-	m_columnResultIDCounter(0),
-	m_thumbnailThreadPool(1, std::bind(CoInitializeEx, nullptr, COINIT_APARTMENTTHREADED),
-		CoUninitialize),
-	m_thumbnailResultIDCounter(0),
-	m_infoTipsThreadPool(1, std::bind(CoInitializeEx, nullptr, COINIT_APARTMENTTHREADED),
-		CoUninitialize),
-	m_infoTipResultIDCounter(0),
+	m_columnResults([this] { return NotifyResultsReady(WM_APP_COLUMN_RESULT_READY); }),
+	m_columnTaskQueue(coreInterface->GetTaskScheduler(), TaskPriority::Background),
+	m_pluginColumnManager(coreInterface->GetPluginColumnManager()),
+	m_thumbnailResults([this] { return NotifyResultsReady(WM_APP_THUMBNAIL_RESULT_READY); }),
+	m_thumbnailTaskQueue(coreInterface->GetTaskScheduler(), TaskPriority::Background),
+	m_infoTipResults([this] { return NotifyResultsReady(WM_APP_INFO_TIP_READY); }),
+	m_infoTipsTaskQueue(coreInterface->GetTaskScheduler(), TaskPriority::Background),
 	m_draggedDataObject(nullptr),
 	m_shellWindowRegistered(false),
 	m_shellChangeWatcher(GetHWND(),
@@ -102,7 +103,8 @@ ShellBrowserImpl::ShellBrowserImpl(HWND hOwner, ShellBrowserEmbedder *embedder,
 		coreInterface->GetConfig())
 {
 	InitializeListView();
-	m_iconFetcher = std::make_unique<IconFetcherImpl>(m_hListView, m_cachedIcons);
+	m_iconFetcher = std::make_unique<IconFetcherImpl>(m_hListView, m_cachedIcons,
+		coreInterface->GetTaskScheduler(), TaskPriority::Background);
 	m_navigationController =
 		std::make_unique<ShellNavigationController>(this, tabNavigation, m_iconFetcher.get());
 
@@ -144,9 +146,9 @@ ShellBrowserImpl::~ShellBrowserImpl()
 
 	DestroyWindow(m_hListView);
 
-	m_columnThreadPool.clear_queue();
-	m_thumbnailThreadPool.clear_queue();
-	m_infoTipsThreadPool.clear_queue();
+	m_columnTaskQueue.CancelPendingTasks();
+	m_thumbnailTaskQueue.CancelPendingTasks();
+	m_infoTipsTaskQueue.CancelPendingTasks();
 
 	DeleteCriticalSection(&m_csDirectoryAltered);
 
@@ -378,8 +380,10 @@ void ShellBrowserImpl::SetViewModeInternal(ViewMode viewMode)
 
 	if (viewMode != +ViewMode::Details)
 	{
-		m_columnThreadPool.clear_queue();
-		m_columnResults.clear();
+		m_columnTaskQueue.CancelPendingTasks();
+		m_columnResults.DiscardPending();
+		m_pendingMetadataColumns.clear();
+		m_pendingPluginColumns.clear();
 	}
 
 	if (viewMode != +ViewMode::Details && viewMode != +ViewMode::Tiles)
@@ -534,6 +538,14 @@ int ShellBrowserImpl::GetId() const
 	return *m_ID;
 }
 
+void ShellBrowserImpl::SetTaskPriority(TaskPriority priority)
+{
+	m_columnTaskQueue.SetPriority(priority);
+	m_thumbnailTaskQueue.SetPriority(priority);
+	m_infoTipsTaskQueue.SetPriority(priority);
+	m_iconFetcher->SetTaskPriority(priority);
+}
+
 std::wstring ShellBrowserImpl::GetItemName(int index) const
 {
 	return GetItemByIndex(index).wfd.cFileName;
@@ -601,6 +613,123 @@ void ShellBrowserImpl::SelectItems(const std::vector<PidlAbsolute> &pidls)
 	}
 }
 
+// Selects (or deselects) each item that matches the predicate. The predicate is evaluated for every
+// item first and the resulting changes are then applied to the listview as a single batch. Items
+// that are already in the requested state are left alone.
+void ShellBrowserImpl::SelectItemsMatchingPredicate(const ItemPredicate &predicate, bool select)
+{
+	int numItems = ListView_GetItemCount(m_hListView);
+
+	std::vector<const ItemInfo_t *> items;
+	items.reserve(numItems);
+
+	for (int i = 0; i < numItems; i++)
+	{
+		items.push_back(&GetItemByIndex(i));
+	}
+
+	// Note that std::vector<bool> isn't used here, since it doesn't allow separate elements to be
+	// written to concurrently.
+	std::vector<char> matches(items.size());
+
+	auto evaluatePredicate = [&items, &matches, &predicate](const ItemInfo_t *const &item)
+	{
+		size_t index = &item - items.data();
+		matches[index] = predicate(item->wfd, item->isFindDataValid);
+	};
+
+	if (numItems >= PARALLEL_PREDICATE_THRESHOLD)
+	{
+		std::for_each(std::execution::par, items.begin(), items.end(), evaluatePredicate);
+	}
+	else
+	{
+		std::for_each(items.begin(), items.end(), evaluatePredicate);
+	}
+
+	UINT targetState = select ? LVIS_SELECTED : 0;
+	std::vector<int> changedItems;
+
+	for (int i = 0; i < numItems; i++)
+	{
+		if (matches[i] && ListView_GetItemState(m_hListView, i, LVIS_SELECTED) != targetState)
+		{
+			changedItems.push_back(i);
+		}
+	}
+
+	SetItemsSelectionState(changedItems, select);
+}
+
+void ShellBrowserImpl::SelectItemsByInternalIndex(const std::unordered_set<int> &internalIndexes,
+	bool select)
+{
+	int numItems = ListView_GetItemCount(m_hListView);
+	UINT targetState = select ? LVIS_SELECTED : 0;
+	std::vector<int> changedItems;
+
+	for (int i = 0; i < numItems; i++)
+	{
+		if (internalIndexes.contains(GetItemInternalIndex(i))
+			&& ListView_GetItemState(m_hListView, i, LVIS_SELECTED) != targetState)
+		{
+			changedItems.push_back(i);
+		}
+	}
+
+	SetItemsSelectionState(changedItems, select);
+}
+
+// Changes the selection state of each of the specified items, all of which are expected to
+// currently be in the opposite state. The listview still sends an LVN_ITEMCHANGED notification for
+// each item, but the handling of those notifications is skipped. The same bookkeeping is performed
+// here directly, and observers are notified once the entire batch has been applied.
+void ShellBrowserImpl::SetItemsSelectionState(const std::vector<int> &items, bool select)
+{
+	if (items.empty())
+	{
+		return;
+	}
+
+	SendMessage(m_hListView, WM_SETREDRAW, FALSE, 0);
+	m_batchSelectionChangeInProgress = true;
+
+	for (int item : items)
+	{
+		ListViewHelper::SelectItem(m_hListView, item, select);
+
+		if (m_config->checkBoxSelection.get())
+		{
+			ListView_SetCheckState(m_hListView, item, select);
+		}
+
+		UpdateFileSelectionInfo(GetItemInternalIndex(item), select);
+	}
+
+	m_batchSelectionChangeInProgress = false;
+	SendMessage(m_hListView, WM_SETREDRAW, TRUE, 0);
+
+	QueueSelectionChangedNotification();
+}
+
+void ShellBrowserImpl::VisitItems(const ItemVisitor &visitor, bool selectedOnly) const
+{
+	UINT flags = selectedOnly ? LVNI_SELECTED : LVNI_ALL;
+	int index = -1;
+
+	while ((index = ListView_GetNextItem(m_hListView, index, flags)) != -1)
+	{
+		int internalIndex = GetItemInternalIndex(index);
+		const auto &item = m_itemInfoMap.at(internalIndex);
+		visitor(internalIndex, item.wfd, item.isFindDataValid);
+	}
+}
+
+uint64_t ShellBrowserImpl::GetItemStorageVersion() const
+{
+	return m_itemStorageVersion;
+}
+
 int ShellBrowserImpl::LocateFileItemIndex(const TCHAR *szFileName) const
 {
 	LV_FINDINFO lvFind;
@@ -750,46 +879,24 @@ int ShellBrowserImpl::GenerateUniqueItemId()
 
 int ShellBrowserImpl::DetermineItemSortedPosition(LPARAM lParam) const
 {
-	LVITEM lvItem;
-	BOOL bItem;
-	int res = 1;
-	int nItems = 0;
-	int i = 0;
-
-	nItems = ListView_GetItemCount(m_hListView);
-
-	while (res > 0 && i < nItems)
-	{
-		lvItem.mask = LVIF_PARAM;
-		lvItem.iItem = i;
-		lvItem.iSubItem = 0;
-		bItem = ListView_GetItem(m_hListView, &lvItem);
-
-		if (bItem)
+	return DetermineSortedPosition(ListView_GetItemCount(m_hListView),
+		[this, lParam](int position)
 		{
-			res = Sort(static_cast<int>(lParam), static_cast<int>(lvItem.lParam));
-		}
-		else
-		{
-			res = 0;
-		}
-
-		i++;
-	}
+			LVITEM lvItem;
+			lvItem.mask = LVIF_PARAM;
+			lvItem.iItem = position;
+			lvItem.iSubItem = 0;
+			BOOL res = ListView_GetItem(m_hListView, &lvItem);
 
-	/* The item will always be inserted BEFORE
-	the item at position i that we specify here.
-	For example, specifying 0, will place the item
-	at 0 (and push 0 to 1), specifying 1 will place
-	the item at 1 (and push 1 to 2).
-	Therefore, to place in the last position, need
-	to place AFTER last item. */
-	if ((i - 1) == nItems - 1 && res > 0)
-	{
-		i++;
-	}
+			// If the item can't be retrieved, the new item will simply be inserted at this
+			// position.
+			if (!res)
+			{
+				return 0;
+			}
 
-	return i - 1;
+			return Sort(static_cast<int>(lParam), static_cast<int>(lvItem.lParam));
+		});
 }
 
 int ShellBrowserImpl::GetNumItems() const
@@ -8,6 +8,8 @@
 #include "ColumnDataRetrieval.h"
 #include "Columns.h"
 #include "FolderSettings.h"
+#include "ItemPredicates.h"
+#include "ItemSource.h"
 #include "MainFontSetter.h"
 #include "ServiceProvider.h"
 #include "ShellBrowser.h"
@@ -15,10 +17,12 @@
 #include "SignalWrapper.h"
 #include "SortModes.h"
 #include "ViewModes.h"
+#include "../Helper/ListViewHelper.h"
 #include "../Helper/ShellDropTargetWindow.h"
+#include "../Helper/ResultQueue.h"
 #include "../Helper/ShellHelper.h"
+#include "../Helper/TaskScheduler.h"
 #include "../Helper/WinRTBaseWrapper.h"
-#include "../ThirdParty/CTPL/cpl_stl.h"
 #include <boost/core/noncopyable.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
@@ -30,19 +34,22 @@
 #include <future>
 #include <list>
 #include <optional>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 
 #define WM_USER_UPDATEWINDOWS (WM_APP + 17)
 #define WM_USER_FILESADDED (WM_APP + 51)
+#define WM_USER_DIRECTORYCHANGED (WM_APP + 52)
 
 class AcceleratorManager;
 struct BasicItemInfo_t;
 class CachedIcons;
 struct Config;
 class CoreInterface;
+struct DirectorySnapshot;
 class FileActionHandler;
-class IconFetcher;
+class IconFetcherImpl;
 class IconResourceLoader;
 struct PreservedFolderState;
 struct PreservedHistoryEntry;
@@ -51,6 +58,11 @@ class ShellNavigationController;
 class TabNavigationInterface;
 class WindowSubclassWrapper;
 
+namespace Plugins
+{
+class PluginColumnManager;
+}
+
 typedef struct
 {
 	ULARGE_INTEGER TotalFolderSize;
@@ -59,6 +71,7 @@ typedef struct
 
 class ShellBrowserImpl :
 	public ShellBrowser,
+	public ItemSource,
 	public ShellDropTargetWindow<int>,
 	public std::enable_shared_from_this<ShellBrowserImpl>,
 	private boost::noncopyable
@@ -117,18 +130,23 @@ public:
 	void SetGroupSortDirection(SortDirection direction);
 	bool GetShowHidden() const;
 	void SetShowHidden(bool showHidden);
-	int GetNumItems() const;
+	int GetNumItems() const override;
 	int GetNumSelectedFiles() const;
 	int GetNumSelectedFolders() const;
-	int GetNumSelected() const;
+	int GetNumSelected() const override;
 
 	/* ID. */
 	void SetID(int id);
 	int GetId() const;
 
+	// Sets the priority of the background work (e.g. column text and thumbnail retrieval) that's
+	// performed for this tab.
+	void SetTaskPriority(TaskPriority priority);
+
 	/* Directory modification support. */
 	void FilesModified(DWORD Action, const TCHAR *FileName, int EventId, int iFolderIndex);
 	void DirectoryAltered();
+	void InvalidateCachedSnapshot(int folderId);
 	void SetDirMonitorId(int dirMonitorId);
 	void ClearDirMonitorId();
 	std::optional<int> GetDirMonitorId() const;
@@ -142,6 +160,9 @@ public:
 	std::wstring GetItemDisplayName(int index) const;
 	std::wstring GetItemFullName(int index) const;
 
+	void VisitItems(const ItemVisitor &visitor, bool selectedOnly) const override;
+	uint64_t GetItemStorageVersion() const override;
+
 	void ShowPropertiesForSelectedFiles() const;
 
 	/* Column support. */
@@ -165,6 +186,9 @@ public:
 	void SetFileAttributesForSelection();
 
 	void SelectItems(const std::vector<PidlAbsolute> &pidls);
+	void SelectItemsMatchingPredicate(const ItemPredicate &predicate, bool select) override;
+	void SelectItemsByInternalIndex(const std::unordered_set<int> &internalIndexes,
+		bool select) override;
 	uint64_t GetTotalDirectorySize();
 	uint64_t GetSelectionSize();
 	int LocateFileItemIndex(const TCHAR *szFileName) const;
@@ -190,6 +214,13 @@ public:
 	void OnDeviceChange(UINT eventType, LONG_PTR eventData);
 	void AutoSizeColumns();
 
+	/* Hibernation. */
+	void Hibernate();
+	void Wake();
+	bool IsHibernated() const;
+	std::optional<uint64_t> GetHibernationReclaimedBytes() const;
+	uint64_t EstimateItemMemoryUsage() const;
+
 	// Signals
 	SignalWrapper<ShellBrowserImpl, void()> directoryModified;
 	SignalWrapper<ShellBrowserImpl, void()> listViewSelectionChanged;
@@ -198,6 +229,9 @@ public:
 private:
 	using PendingWorkQueueTask = std::function<void()>;
 
+	// Directories with at least this many items will have item predicates evaluated in parallel.
+	static constexpr int PARALLEL_PREDICATE_THRESHOLD = 2000;
+
 	struct ItemInfo_t
 	{
 		unique_pidl_absolute pidlComplete;
@@ -257,6 +291,10 @@ private:
 		int itemInternalIndex;
 		ColumnType columnType;
 		std::wstring columnText;
+
+		// Set if the result is for a column provided by a plugin, in which case columnType isn't
+		// used.
+		std::optional<int> pluginColumnId;
 	};
 
 	struct ThumbnailResult_t
@@ -303,6 +341,14 @@ private:
 		}
 	};
 
+	// Contains the state needed to restore the listview when a hibernated tab is woken. The items
+	// themselves aren't saved; they'll be enumerated again.
+	struct HibernationState
+	{
+		ListViewHelper::ScrollPosition scrollPosition;
+		uint64_t reclaimedBytes = 0;
+	};
+
 	enum class GroupByDateType
 	{
 		Created,
@@ -381,10 +427,16 @@ private:
 	static const UINT WM_APP_THUMBNAIL_RESULT_READY = WM_APP + 151;
 	static const UINT WM_APP_INFO_TIP_READY = WM_APP + 152;
 	static const UINT WM_APP_PENDING_TASK_AVAILABLE = WM_APP + 153;
+	static const UINT WM_APP_SELECTION_CHANGED = WM_APP + 154;
 
 	static const int THUMBNAIL_ITEM_WIDTH = 120;
 	static const int THUMBNAIL_ITEM_HEIGHT = 120;
 
+	// Each column stores an identifier in its header item's lParam. For the built-in columns,
+	// that's the column type. Plugin columns store their ID, offset by this value, which is
+	// larger than any column type.
+	static const LPARAM PLUGIN_COLUMN_LPARAM_BASE = 0x10000;
+
 	ShellBrowserImpl(HWND hOwner, ShellBrowserEmbedder *embedder, CoreInterface *coreInterface,
 		TabNavigationInterface *tabNavigation, FileActionHandler *fileActionHandler,
 		const std::vector<std::unique_ptr<PreservedHistoryEntry>> &history, int currentEntry,
@@ -405,6 +457,12 @@ private:
 		std::vector<ItemInfo_t> &items);
 	static std::optional<ItemInfo_t> GetItemInformation(IShellFolder *shellFolder,
 		PCIDLIST_ABSOLUTE pidlDirectory, PCITEMID_CHILD pidlChild);
+	static std::optional<ItemInfo_t> GetItemInformation(IShellFolder *shellFolder,
+		PCIDLIST_ABSOLUTE pidlDirectory, unique_pidl_child pidlChild, bool inRecycleBin);
+	static bool IsRecycleBin(PCIDLIST_ABSOLUTE pidlDirectory);
+	static DirectorySnapshot CreateDirectorySnapshot(PCIDLIST_ABSOLUTE pidlDirectory,
+		const std::wstring &parsingPath, bool showHidden, const std::vector<ItemInfo_t> &items);
+	static std::vector<ItemInfo_t> GetItemsFromSnapshot(const DirectorySnapshot &snapshot);
 	void PrepareToChangeFolders();
 	void ClearPendingResults();
 	void ResetFolderState();
@@ -445,13 +503,18 @@ private:
 	LRESULT OnListViewGetInfoTip(NMLVGETINFOTIP *getInfoTip);
 	BOOL OnListViewGetEmptyMarkup(NMLVEMPTYMARKUP *emptyMarkup);
 	void QueueInfoTipTask(int internalIndex, const std::wstring &existingInfoTip);
-	static std::optional<InfoTipResult> GetInfoTipAsync(HWND listView, int infoTipResultId,
-		int internalIndex, const BasicItemInfo_t &basicItemInfo, const Config &config,
-		HINSTANCE resourceInstance, bool virtualFolder);
-	void ProcessInfoTipResult(int infoTipResultId);
+	static std::optional<InfoTipResult> GetInfoTipAsync(int internalIndex,
+		const BasicItemInfo_t &basicItemInfo, const Config &config, HINSTANCE resourceInstance,
+		bool virtualFolder);
+	void ProcessInfoTipResults();
+	void ProcessInfoTipResult(const InfoTipResult &result);
+	bool NotifyResultsReady(UINT message);
 	void OnListViewItemInserted(const NMLISTVIEW *itemData);
 	void OnListViewItemChanged(const NMLISTVIEW *changeData);
+	void SetItemsSelectionState(const std::vector<int> &items, bool select);
 	void UpdateFileSelectionInfo(int internalIndex, BOOL selected);
+	void QueueSelectionChangedNotification();
+	void OnSelectionChangedMessage();
 	void OnListViewKeyDown(const NMLVKEYDOWN *lvKeyDown);
 	std::vector<PidlAbsolute> GetSelectedItemPidls() const;
 	void OnListViewBeginDrag(const NMLISTVIEW *info);
@@ -495,17 +558,27 @@ private:
 	void SetUpListViewColumns();
 	void DeleteAllColumns();
 	void QueueColumnTask(int itemInternalIndex, ColumnType columnType);
-	static ColumnResult_t GetColumnTextAsync(HWND listView, int columnResultId,
-		ColumnType columnType, int internalIndex, const BasicItemInfo_t &basicItemInfo,
-		const GlobalFolderSettings &globalFolderSettings);
+	void QueueMetadataColumnTask(int itemInternalIndex, ColumnType columnType);
+	static ColumnResult_t GetColumnTextAsync(ColumnType columnType, int internalIndex,
+		const BasicItemInfo_t &basicItemInfo, const GlobalFolderSettings &globalFolderSettings);
 	void InsertColumn(ColumnType columnType, int columnIndex, int width);
 	void SetActiveColumnSet();
 	void GetColumnInternal(ColumnType columnType, Column_t *pci) const;
 	Column_t GetFirstCheckedColumn();
 	void SaveColumnWidths();
-	void ProcessColumnResult(int columnResultId);
+	void ProcessColumnResults();
+	void ProcessColumnResult(const ColumnResult_t &result);
 	std::optional<int> GetColumnIndexByType(ColumnType columnType) const;
 	std::optional<ColumnType> GetColumnTypeByIndex(int index) const;
+	std::optional<LPARAM> GetColumnLParamByIndex(int index) const;
+	std::optional<int> GetColumnIndexByLParam(LPARAM lParam) const;
+
+	/* Plugin column support. */
+	void InsertPluginColumn(int pluginColumnId, const std::wstring &name, int columnIndex,
+		int width);
+	void QueuePluginColumnTask(int itemInternalIndex, int pluginColumnId);
+	std::optional<int> GetPluginColumnIdByIndex(int index) const;
+	static bool IsPluginColumnLParam(LPARAM lParam);
 
 	/* Device change support. */
 	void UpdateDriveIcon(const TCHAR *szDrive);
@@ -592,7 +665,8 @@ private:
 	void QueueThumbnailTask(int internalIndex);
 	std::optional<int> GetCachedThumbnailIndex(const ItemInfo_t &itemInfo);
 	static wil::unique_hbitmap GetThumbnail(PIDLIST_ABSOLUTE pidl, WTS_FLAGS flags);
-	void ProcessThumbnailResult(int thumbnailResultId);
+	void ProcessThumbnailResults();
+	void ProcessThumbnailResult(const ThumbnailResult_t &result);
 	void SetupThumbnailsView();
 	void RemoveThumbnailsView();
 	int GetIconThumbnail(int iInternalIndex) const;
@@ -624,6 +698,9 @@ private:
 
 	void OnApplicationShuttingDown();
 
+	/* Hibernation. */
+	void ReleaseItemData();
+
 	/* Miscellaneous. */
 	BOOL CompareVirtualFolders(UINT uFolderCSIDL) const;
 	int LocateFileItemInternalIndex(const TCHAR *szFileName) const;
@@ -664,22 +741,43 @@ private:
 	as display name. */
 	std::unordered_map<int, ItemInfo_t> m_itemInfoMap;
 
-	ctpl::thread_pool m_columnThreadPool;
-	std::unordered_map<int, std::future<ColumnResult_t>> m_columnResults;
-	int m_columnResultIDCounter;
+	// Incremented whenever an item is removed from m_itemInfoMap (or the map is cleared). Inserting
+	// an item doesn't move any of the existing items, so doesn't change the version.
+	uint64_t m_itemStorageVersion = 0;
+
+	// Set when a selection changed notification has been posted, but not yet processed.
+	bool m_selectionChangedNotificationPending = false;
 
-	std::unique_ptr<IconFetcher> m_iconFetcher;
+	// Set while SetItemsSelectionState() is changing the selection, so that the individual change
+	// notifications generated by the listview can be ignored.
+	bool m_batchSelectionChangeInProgress = false;
+
+	// Each result queue is declared before the task queue that feeds it, so that any running
+	// tasks will have finished (when the task queue is destroyed) before the result queue is
+	// destroyed.
+	ResultQueue<ColumnResult_t> m_columnResults;
+	TaskQueue m_columnTaskQueue;
+
+	// The metadata columns that have been requested for each item, but whose results haven't been
+	// processed yet. All the metadata columns for an item are retrieved by a single task.
+	std::unordered_map<int, std::vector<ColumnType>> m_pendingMetadataColumns;
+
+	// The (item internal index, plugin column ID) pairs whose text has been requested, but not
+	// yet received. The listview will keep asking for an item's text until it's been set, so this
+	// prevents a plugin from being called multiple times for the same item.
+	std::set<std::pair<int, int>> m_pendingPluginColumns;
+	Plugins::PluginColumnManager *const m_pluginColumnManager;
+
+	std::unique_ptr<IconFetcherImpl> m_iconFetcher;
 	CachedIcons *m_cachedIcons;
 
 	IconResourceLoader *m_iconResourceLoader;
 
-	ctpl::thread_pool m_thumbnailThreadPool;
-	std::unordered_map<int, std::future<std::optional<ThumbnailResult_t>>> m_thumbnailResults;
-	int m_thumbnailResultIDCounter;
+	ResultQueue<ThumbnailResult_t> m_thumbnailResults;
+	TaskQueue m_thumbnailTaskQueue;
 
-	ctpl::thread_pool m_infoTipsThreadPool;
-	std::unordered_map<int, std::future<std::optional<InfoTipResult>>> m_infoTipResults;
-	int m_infoTipResultIDCounter;
+	ResultQueue<InfoTipResult> m_infoTipResults;
+	TaskQueue m_infoTipsTaskQueue;
 
 	/* Internal state. */
 	const HINSTANCE m_resourceInstance;
@@ -742,4 +840,7 @@ private:
 
 	ListViewGroupSet m_listViewGroups;
 	int m_groupIdCounter;
+
+	/* Hibernation. */
+	std::optional<HibernationState> m_hibernationState;
 };
@@ -369,3 +369,16 @@ int SortByMediaMetadata(const BasicItemInfo_t &itemInfo1, const BasicItemInfo_t
 
 	return StrCmpLogicalW(mediaMetadata1.c_str(), mediaMetadata2.c_str());
 }
+
+int DetermineSortedPosition(int numItems, const std::function<int(int position)> &compareToItem)
+{
+	for (int i = 0; i < numItems; i++)
+	{
+		if (compareToItem(i) <= 0)
+		{
+			return i;
+		}
+	}
+
+	return numItems;
+}
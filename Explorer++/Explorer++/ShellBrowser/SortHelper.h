@@ -6,6 +6,7 @@
 
 #include "ColumnDataRetrieval.h"
 #include "FolderSettings.h"
+#include <functional>
 
 struct BasicItemInfo_t;
 
@@ -44,3 +45,9 @@ int SortByPrinterProperty(const BasicItemInfo_t &itemInfo1, const BasicItemInfo_
 int SortByNetworkAdapterStatus(const BasicItemInfo_t &itemInfo1, const BasicItemInfo_t &itemInfo2);
 int SortByMediaMetadata(const BasicItemInfo_t &itemInfo1, const BasicItemInfo_t &itemInfo2,
 	MediaMetadataType mediaMetadataType);
+
+// Returns the position at which a new item should be inserted into a set of items that's already
+// sorted. compareToItem is passed the position of an existing item and should return a value
+// greater than 0 if the new item sorts after that item. The search is linear, since the items are
+// typically stored in a listview, which provides no way to access items other than one at a time.
+int DetermineSortedPosition(int numItems, const std::function<int(int position)> &compareToItem);
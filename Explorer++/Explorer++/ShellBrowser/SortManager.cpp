@@ -9,11 +9,14 @@
 #include "SortHelper.h"
 #include "SortModes.h"
 #include "ViewModes.h"
+#include "../Helper/PerformanceTracer.h"
 #include <propkey.h>
 #include <cassert>
 
 void ShellBrowserImpl::SortFolder()
 {
+	ScopedTraceSpan span("ShellBrowser", "SortFolder");
+
 	SendMessage(m_hListView, LVM_SORTITEMS, reinterpret_cast<WPARAM>(this),
 		reinterpret_cast<LPARAM>(SortStub));
 
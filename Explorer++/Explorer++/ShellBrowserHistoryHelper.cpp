@@ -4,12 +4,14 @@
 
 #include "stdafx.h"
 #include "ShellBrowserHistoryHelper.h"
+#include "FrequentLocationsService.h"
 #include "HistoryService.h"
 
 ShellBrowserHistoryHelper::ShellBrowserHistoryHelper(ShellBrowser *shellBrowser,
-	HistoryService *historyService) :
+	HistoryService *historyService, FrequentLocationsService *frequentLocationsService) :
 	ShellBrowserHelper(shellBrowser),
-	m_historyService(historyService)
+	m_historyService(historyService),
+	m_frequentLocationsService(frequentLocationsService)
 {
 	// There's no need to explicitly remove this observer, since this object is tied to the
 	// lifetime of the shellBrowser instance.
@@ -20,4 +22,5 @@ ShellBrowserHistoryHelper::ShellBrowserHistoryHelper(ShellBrowser *shellBrowser,
 void ShellBrowserHistoryHelper::OnNavigationCommitted(const NavigateParams &navigateParams)
 {
 	m_historyService->AddHistoryItem(navigateParams.pidl);
+	m_frequentLocationsService->RegisterLocationVisit(navigateParams.pidl);
 }
@@ -6,15 +6,18 @@
 
 #include "ShellBrowser/ShellBrowserHelper.h"
 
+class FrequentLocationsService;
 class HistoryService;
 
 class ShellBrowserHistoryHelper : public ShellBrowserHelper<ShellBrowserHistoryHelper>
 {
 public:
-	ShellBrowserHistoryHelper(ShellBrowser *shellBrowser, HistoryService *historyService);
+	ShellBrowserHistoryHelper(ShellBrowser *shellBrowser, HistoryService *historyService,
+		FrequentLocationsService *frequentLocationsService);
 
 private:
 	void OnNavigationCommitted(const NavigateParams &navigateParams);
 
 	HistoryService *const m_historyService;
+	FrequentLocationsService *const m_frequentLocationsService;
 };
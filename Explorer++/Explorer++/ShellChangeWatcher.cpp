@@ -4,14 +4,16 @@
 
 #include "stdafx.h"
 #include "ShellChangeWatcher.h"
+#include "../Helper/PerformanceTracer.h"
 #include "../Helper/StringHelper.h"
 #include "../Helper/WindowSubclassWrapper.h"
 #include <glog/logging.h>
 
 ShellChangeWatcher::ShellChangeWatcher(HWND hwnd,
-	ProcessNotificationsCallback processNotificationsCallback) :
+	ProcessNotificationsCallback processNotificationsCallback, Delivery delivery) :
 	m_hwnd(hwnd),
-	m_processNotificationsCallback(processNotificationsCallback)
+	m_processNotificationsCallback(processNotificationsCallback),
+	m_delivery(delivery)
 {
 	m_windowSubclasses.push_back(std::make_unique<WindowSubclassWrapper>(hwnd,
 		std::bind_front(&ShellChangeWatcher::WndProc, this)));
@@ -106,6 +108,12 @@ void ShellChangeWatcher::OnShellNotify(WPARAM wParam, LPARAM lParam)
 
 	SHChangeNotification_Unlock(lock);
 
+	if (m_delivery == Delivery::Immediate)
+	{
+		OnProcessShellChangeNotifications();
+		return;
+	}
+
 	SetTimer(m_hwnd, PROCESS_SHELL_CHANGES_TIMER_ID, PROCESS_SHELL_CHANGES_TIMEOUT, nullptr);
 }
 
@@ -113,6 +121,10 @@ void ShellChangeWatcher::OnProcessShellChangeNotifications()
 {
 	KillTimer(m_hwnd, PROCESS_SHELL_CHANGES_TIMER_ID);
 
+	ScopedTraceSpan span("ShellChangeWatcher", "ProcessNotifications");
+	TraceCounter("ShellChangeWatcher", "NotificationBatchSize",
+		static_cast<int64_t>(m_shellChangeNotifications.size()));
+
 	m_processNotificationsCallback(m_shellChangeNotifications);
 
 	m_shellChangeNotifications.clear();
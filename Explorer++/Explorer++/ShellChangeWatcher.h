@@ -31,7 +31,18 @@ public:
 	using ProcessNotificationsCallback =
 		std::function<void(const std::vector<ShellChangeNotification> &shellNotifications)>;
 
-	ShellChangeWatcher(HWND hwnd, ProcessNotificationsCallback processNotificationsCallback);
+	enum class Delivery
+	{
+		// Notifications are collected and passed to the callback together, once no further
+		// notifications have been received for a short period of time.
+		Batched,
+
+		// Each notification is passed to the callback as soon as it's received.
+		Immediate
+	};
+
+	ShellChangeWatcher(HWND hwnd, ProcessNotificationsCallback processNotificationsCallback,
+		Delivery delivery = Delivery::Batched);
 	~ShellChangeWatcher();
 
 	ULONG StartWatching(PCIDLIST_ABSOLUTE pidl, LONG events, bool recursive = false);
@@ -53,4 +64,5 @@ private:
 	std::set<ULONG> m_changeNotifyIds;
 	std::vector<ShellChangeNotification> m_shellChangeNotifications;
 	ProcessNotificationsCallback m_processNotificationsCallback;
+	const Delivery m_delivery;
 };
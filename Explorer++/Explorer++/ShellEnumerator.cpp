@@ -6,9 +6,11 @@
 #include "ShellEnumerator.h"
 #include "../Helper/ShellHelper.h"
 #include <wil/common.h>
+#include <algorithm>
+#include <array>
 
 HRESULT ShellEnumerator::EnumerateDirectory(IShellFolder *shellFolder, HWND embedder, Flags flags,
-	std::vector<PidlChild> &outputItems)
+	std::vector<unique_pidl_child> &outputItems)
 {
 	SHCONTF enumFlags = SHCONTF_FOLDERS | SHCONTF_NONFOLDERS;
 
@@ -25,12 +27,39 @@ HRESULT ShellEnumerator::EnumerateDirectory(IShellFolder *shellFolder, HWND embe
 		return hr;
 	}
 
-	ULONG numFetched = 1;
-	unique_pidl_child pidlItem;
+	std::array<PITEMID_CHILD, BATCH_SIZE> batch;
+	ULONG batchSize = BATCH_SIZE;
 
-	while (enumerator->Next(1, wil::out_param(pidlItem), &numFetched) == S_OK && (numFetched == 1))
+	while (true)
 	{
-		outputItems.emplace_back(pidlItem.get());
+		ULONG numFetched = 0;
+		hr = enumerator->Next(batchSize, batch.data(), &numFetched);
+
+		// Ownership of every item returned is taken before the result is checked, so that the items
+		// are freed if they're discarded. Next() returns S_FALSE once there are no more items. Any
+		// items returned along with that value are still valid.
+		for (ULONG i = 0; i < (std::min)(numFetched, batchSize); i++)
+		{
+			unique_pidl_child pidl(batch[i]);
+
+			if (SUCCEEDED(hr))
+			{
+				outputItems.push_back(std::move(pidl));
+			}
+		}
+
+		// Some enumerators only support retrieving a single item at a time and will fail if asked
+		// for more than that.
+		if (FAILED(hr) && batchSize > 1 && outputItems.empty())
+		{
+			batchSize = 1;
+			continue;
+		}
+
+		if (hr != S_OK || numFetched == 0)
+		{
+			break;
+		}
 	}
 
 	return S_OK;
@@ -4,7 +4,7 @@
 
 #pragma once
 
-#include "../Helper/PidlHelper.h"
+#include "../Helper/ShellHelper.h"
 #include <shobjidl_core.h>
 #include <vector>
 
@@ -20,8 +20,15 @@ public:
 		IncludeHidden = 1 << 0
 	};
 
+	// The pidls returned by the enumerator are passed back directly, without being copied.
 	HRESULT EnumerateDirectory(IShellFolder *shellFolder, HWND embedder, Flags flags,
-		std::vector<PidlChild> &outputItems);
+		std::vector<unique_pidl_child> &outputItems);
+
+private:
+	// The number of items that will be requested from the enumerator at once. Retrieving items in
+	// batches reduces the number of calls that need to be made (which is relevant when the
+	// enumerator is implemented out of process, for example).
+	static constexpr ULONG BATCH_SIZE = 256;
 };
 
 DEFINE_ENUM_FLAG_OPERATORS(ShellEnumerator::Flags);
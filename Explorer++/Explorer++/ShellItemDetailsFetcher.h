@@ -0,0 +1,46 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <ShlObj.h>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+
+// The details needed to show a shell item in a menu.
+struct ShellItemDetails
+{
+	std::wstring displayName;
+	std::wstring parsingPath;
+	std::wstring displayPath;
+	bool isFolder = false;
+
+	// Used to determine whether cached details are old enough to be worth refreshing.
+	std::chrono::steady_clock::time_point retrievalTime;
+};
+
+// Retrieves item details in the background. Retrieving the details of an item can require
+// accessing the disk or the network (e.g. for a history entry on a disconnected network share), so
+// it's not something that should be done on the UI thread.
+class ShellItemDetailsFetcher
+{
+public:
+	using Callback = std::function<void(const ShellItemDetails &details)>;
+
+	virtual ~ShellItemDetailsFetcher() = default;
+
+	// The callback will be invoked on the thread that created the fetcher, once the details are
+	// available.
+	virtual void QueueDetailsTask(PCIDLIST_ABSOLUTE pidl, Callback callback) = 0;
+
+	// Cancels all the tasks that haven't completed yet, regardless of which caller queued them.
+	// The callbacks for those tasks won't be invoked. Only one menu is shown at a time, so this is
+	// used when a menu is rebuilt and its outstanding requests are no longer needed.
+	virtual void CancelPendingTasks() = 0;
+
+	// Returns the details most recently retrieved for the item, if there are any.
+	virtual std::optional<ShellItemDetails> GetCachedDetails(PCIDLIST_ABSOLUTE pidl) const = 0;
+};
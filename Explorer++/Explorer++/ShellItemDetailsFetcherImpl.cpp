@@ -0,0 +1,136 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "ShellItemDetailsFetcherImpl.h"
+#include "../Helper/PerformanceTracer.h"
+#include "../Helper/ShellHelper.h"
+#include "../Helper/WindowSubclassWrapper.h"
+#include <glog/logging.h>
+
+namespace
+{
+
+HWND CreateMessageWindow()
+{
+	HWND messageWindow = CreateWindow(WC_STATIC, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, nullptr,
+		GetModuleHandle(nullptr), nullptr);
+	CHECK(messageWindow);
+	return messageWindow;
+}
+
+}
+
+ShellItemDetailsFetcherImpl::ShellItemDetailsFetcherImpl(TaskScheduler *taskScheduler) :
+	m_messageWindow(CreateMessageWindow()),
+	m_detailsResults([messageWindow = m_messageWindow.get()]()
+		{ return PostMessage(messageWindow, WM_APP_DETAILS_RESULT_READY, 0, 0) != 0; }),
+	m_detailsTaskQueue(taskScheduler, TaskPriority::Normal, MAX_CONCURRENT_TASKS)
+{
+	m_windowSubclasses.push_back(std::make_unique<WindowSubclassWrapper>(m_messageWindow.get(),
+		std::bind_front(&ShellItemDetailsFetcherImpl::WindowSubclass, this)));
+}
+
+ShellItemDetailsFetcherImpl::~ShellItemDetailsFetcherImpl()
+{
+	m_detailsTaskQueue.CancelPendingTasks();
+}
+
+LRESULT ShellItemDetailsFetcherImpl::WindowSubclass(HWND hwnd, UINT msg, WPARAM wParam,
+	LPARAM lParam)
+{
+	switch (msg)
+	{
+	case WM_APP_DETAILS_RESULT_READY:
+		ProcessDetailsResults();
+		return 0;
+	}
+
+	return DefSubclassProc(hwnd, msg, wParam, lParam);
+}
+
+void ShellItemDetailsFetcherImpl::QueueDetailsTask(PCIDLIST_ABSOLUTE pidl, Callback callback)
+{
+	TraceCounterAdjust("ShellItemDetailsFetcher", "Requests", 1);
+
+	m_detailsTaskQueue.Post(
+		[resultQueue = &m_detailsResults, generation = m_detailsResults.GetGeneration(),
+			copiedPidl = PidlAbsolute(pidl), callback = std::move(callback)]() mutable
+		{
+			DetailsResult result;
+			result.details = FetchDetails(copiedPidl.Raw());
+			result.pidl = std::move(copiedPidl);
+			result.callback = std::move(callback);
+			resultQueue->Push(generation, std::move(result));
+		});
+}
+
+void ShellItemDetailsFetcherImpl::CancelPendingTasks()
+{
+	// Any tasks that are already running will still push their results, but those results will
+	// belong to the previous generation and so will be dropped.
+	m_detailsResults.DiscardPending();
+	m_detailsTaskQueue.CancelPendingTasks();
+}
+
+ShellItemDetails ShellItemDetailsFetcherImpl::FetchDetails(PCIDLIST_ABSOLUTE pidl)
+{
+	ScopedTraceSpan span("ShellItemDetailsFetcher", "FetchDetails");
+
+	ShellItemDetails details;
+
+	// If any of the details can't be retrieved, the corresponding field will simply be left empty,
+	// with the caller determining what should be shown instead.
+	GetDisplayName(pidl, SHGDN_NORMAL, details.displayName);
+	GetDisplayName(pidl, SHGDN_FORPARSING, details.parsingPath);
+
+	SFGAOF attributes = SFGAO_FOLDER;
+	HRESULT hr = GetItemAttributes(pidl, &attributes);
+
+	if (SUCCEEDED(hr))
+	{
+		details.isFolder = WI_IsFlagSet(attributes, SFGAO_FOLDER);
+	}
+
+	if (auto displayPath = GetFolderPathForDisplay(pidl))
+	{
+		details.displayPath = *displayPath;
+	}
+
+	details.retrievalTime = std::chrono::steady_clock::now();
+
+	return details;
+}
+
+void ShellItemDetailsFetcherImpl::ProcessDetailsResults()
+{
+	m_detailsResults.Drain([this](const DetailsResult &result) { ProcessDetailsResult(result); });
+}
+
+void ShellItemDetailsFetcherImpl::ProcessDetailsResult(const DetailsResult &result)
+{
+	if (m_cachedDetails.size() >= MAX_CACHED_ITEMS && !m_cachedDetails.contains(result.pidl))
+	{
+		// The cache only exists to avoid showing placeholders for items that have recently been
+		// shown, so there's little to be gained from evicting entries selectively.
+		m_cachedDetails.clear();
+	}
+
+	m_cachedDetails.insert_or_assign(result.pidl, result.details);
+
+	result.callback(result.details);
+}
+
+std::optional<ShellItemDetails> ShellItemDetailsFetcherImpl::GetCachedDetails(
+	PCIDLIST_ABSOLUTE pidl) const
+{
+	auto itr = m_cachedDetails.find(PidlAbsolute(pidl));
+
+	if (itr == m_cachedDetails.end())
+	{
+		return std::nullopt;
+	}
+
+	return itr->second;
+}
@@ -0,0 +1,68 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "ShellItemDetailsFetcher.h"
+#include "../Helper/PidlHelper.h"
+#include "../Helper/ResultQueue.h"
+#include "../Helper/TaskScheduler.h"
+#include <boost/core/noncopyable.hpp>
+#include <boost/functional/hash.hpp>
+#include <wil/resource.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class WindowSubclassWrapper;
+
+// Retrieves item details on the shared task scheduler. Retrieved details are cached by pidl, so
+// that a menu showing the same set of items (e.g. the history menu) can be populated immediately
+// the next time it's opened.
+class ShellItemDetailsFetcherImpl : public ShellItemDetailsFetcher, private boost::noncopyable
+{
+public:
+	ShellItemDetailsFetcherImpl(TaskScheduler *taskScheduler);
+	~ShellItemDetailsFetcherImpl();
+
+	void QueueDetailsTask(PCIDLIST_ABSOLUTE pidl, Callback callback) override;
+	void CancelPendingTasks() override;
+	std::optional<ShellItemDetails> GetCachedDetails(PCIDLIST_ABSOLUTE pidl) const override;
+
+	// Synchronously retrieves the details for an item.
+	static ShellItemDetails FetchDetails(PCIDLIST_ABSOLUTE pidl);
+
+private:
+	static constexpr UINT WM_APP_DETAILS_RESULT_READY = WM_APP + 1;
+
+	// Some items (e.g. those on a disconnected network share) can take a long time to resolve, so
+	// a second task is allowed to run alongside them, to avoid a single slow item holding up the
+	// rest of a menu. The limit is kept low, since menu details are less urgent than the column
+	// and icon tasks that share the worker threads.
+	static constexpr int MAX_CONCURRENT_TASKS = 2;
+
+	// Each entry is fairly small, but there's no upper limit on the number of distinct items that
+	// can be requested over the lifetime of the application.
+	static constexpr size_t MAX_CACHED_ITEMS = 1000;
+
+	struct DetailsResult
+	{
+		PidlAbsolute pidl;
+		ShellItemDetails details;
+		Callback callback;
+	};
+
+	LRESULT WindowSubclass(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
+	void ProcessDetailsResults();
+	void ProcessDetailsResult(const DetailsResult &result);
+
+	wil::unique_hwnd m_messageWindow;
+	std::vector<std::unique_ptr<WindowSubclassWrapper>> m_windowSubclasses;
+
+	// This needs to be declared before the task queue, so that it outlives any running tasks.
+	ResultQueue<DetailsResult> m_detailsResults;
+	TaskQueue m_detailsTaskQueue;
+
+	std::unordered_map<PidlAbsolute, ShellItemDetails, boost::hash<PidlAbsolute>> m_cachedDetails;
+};
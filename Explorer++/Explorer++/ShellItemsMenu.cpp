@@ -8,15 +8,17 @@
 #include "IconFetcher.h"
 #include "MenuView.h"
 #include "NavigationHelper.h"
+#include "ShellItemDetailsFetcher.h"
 #include "../Helper/ImageHelper.h"
-#include "../Helper/ShellHelper.h"
 #include <glog/logging.h>
 
 ShellItemsMenu::ShellItemsMenu(MenuView *menuView, const std::vector<PidlAbsolute> &pidls,
-	BrowserWindow *browserWindow, IconFetcher *iconFetcher, UINT menuStartId, UINT menuEndId) :
+	BrowserWindow *browserWindow, IconFetcher *iconFetcher, ShellItemDetailsFetcher *detailsFetcher,
+	UINT menuStartId, UINT menuEndId) :
 	MenuBase(menuView),
 	m_browserWindow(browserWindow),
 	m_iconFetcher(iconFetcher),
+	m_detailsFetcher(detailsFetcher),
 	m_menuStartId(menuStartId),
 	m_menuEndId(menuEndId),
 	m_idCounter(menuStartId),
@@ -39,10 +41,18 @@ ShellItemsMenu::~ShellItemsMenu()
 
 void ShellItemsMenu::RebuildMenu(const std::vector<PidlAbsolute> &pidls)
 {
+	// Any details that are still outstanding are for the previous set of items, so there's no
+	// point in continuing to retrieve them.
+	if (!m_pendingDetailsCallbackIds.empty())
+	{
+		m_detailsFetcher->CancelPendingTasks();
+	}
+
 	m_menuView->ClearMenu();
 	m_idCounter = m_menuStartId;
 	m_idPidlMap.clear();
 	m_pendingIconCallbackIds.clear();
+	m_pendingDetailsCallbackIds.clear();
 
 	for (const auto &pidl : pidls)
 	{
@@ -52,71 +62,108 @@ void ShellItemsMenu::RebuildMenu(const std::vector<PidlAbsolute> &pidls)
 
 void ShellItemsMenu::AddMenuItemForPidl(PCIDLIST_ABSOLUTE pidl)
 {
-	std::wstring name;
-	HRESULT hr = GetDisplayName(pidl, SHGDN_NORMAL, name);
+	auto id = m_idCounter++;
 
-	if (FAILED(hr))
+	if (id >= m_menuEndId)
 	{
-		DCHECK(false);
+		return;
+	}
+
+	auto cachedDetails = m_detailsFetcher->GetCachedDetails(pidl);
 
-		name = L"(Unknown)";
+	if (cachedDetails)
+	{
+		m_menuView->AppendItem(id, GetTextForDetails(*cachedDetails),
+			GetIconForDetails(*cachedDetails), cachedDetails->displayPath);
+	}
+	else
+	{
+		m_menuView->AppendItem(id, PLACEHOLDER_TEXT, GetPlaceholderIcon());
 	}
 
-	auto id = m_idCounter++;
+	auto [itr, didInsert] = m_idPidlMap.insert({ id, pidl });
+	DCHECK(didInsert);
 
-	if (id >= m_menuEndId)
+	// Cached details may be out of date (e.g. if the item has since been renamed), so they're
+	// refreshed once they reach a certain age. The icon is retrieved at the same time, rather than
+	// waiting for the details to be available first.
+	if (!cachedDetails
+		|| std::chrono::steady_clock::now() - cachedDetails->retrievalTime
+			>= CACHED_DETAILS_REFRESH_INTERVAL)
 	{
-		return;
+		QueueDetailsUpdateTask(pidl, id);
 	}
 
-	auto bitmap = GetShellItemIcon(pidl);
 	QueueIconUpdateTask(pidl, id);
+}
 
-	std::wstring displayPath;
-
-	if (auto optionalDisplayPath = GetFolderPathForDisplay(pidl))
+std::wstring ShellItemsMenu::GetTextForDetails(const ShellItemDetails &details)
+{
+	if (details.displayName.empty())
 	{
-		displayPath = *optionalDisplayPath;
+		return L"(Unknown)";
 	}
 
-	m_menuView->AppendItem(id, name, std::move(bitmap), displayPath);
+	return details.displayName;
+}
 
-	auto [itr, didInsert] = m_idPidlMap.insert({ id, pidl });
-	DCHECK(didInsert);
+wil::unique_hbitmap ShellItemsMenu::GetIconForDetails(const ShellItemDetails &details)
+{
+	int iconIndex = m_iconFetcher->GetCachedIconIndexOrDefault(details.parsingPath,
+		details.isFolder ? DefaultIconType::Folder : DefaultIconType::File);
+	return ImageHelper::ImageListIconToBitmap(m_systemImageList.get(), iconIndex);
 }
 
-wil::unique_hbitmap ShellItemsMenu::GetShellItemIcon(PCIDLIST_ABSOLUTE pidl)
+wil::unique_hbitmap ShellItemsMenu::GetPlaceholderIcon()
 {
-	std::wstring itemPath;
-	HRESULT hr = GetDisplayName(pidl, SHGDN_FORPARSING, itemPath);
+	// Most of the items shown in these menus are folders, so the default folder icon is the one
+	// least likely to visibly change once the actual icon has been retrieved.
+	int iconIndex = m_iconFetcher->GetCachedIconIndexOrDefault(L"", DefaultIconType::Folder);
+	return ImageHelper::ImageListIconToBitmap(m_systemImageList.get(), iconIndex);
+}
 
-	if (FAILED(hr))
-	{
-		return nullptr;
-	}
+void ShellItemsMenu::QueueDetailsUpdateTask(PCIDLIST_ABSOLUTE pidl, UINT menuItemId)
+{
+	int detailsCallbackId = m_detailsCallbackIdCounter++;
 
-	SFGAOF attributes = SFGAO_FOLDER;
-	hr = GetItemAttributes(pidl, &attributes);
+	// The details may be returned immediately, so the callback ID needs to be registered before
+	// the task is queued.
+	auto [itr, didInsert] = m_pendingDetailsCallbackIds.insert(detailsCallbackId);
+	DCHECK(didInsert);
 
-	if (FAILED(hr))
-	{
-		return nullptr;
-	}
+	m_detailsFetcher->QueueDetailsTask(pidl,
+		[this, destroyed = m_destroyed, menuItemId, detailsCallbackId](
+			const ShellItemDetails &details)
+		{
+			if (*destroyed)
+			{
+				return;
+			}
 
-	DefaultIconType defaultIconType;
+			OnDetailsRetrieved(menuItemId, details, detailsCallbackId);
+		});
+}
 
-	if (WI_IsFlagSet(attributes, SFGAO_FOLDER))
-	{
-		defaultIconType = DefaultIconType::Folder;
-	}
-	else
+void ShellItemsMenu::OnDetailsRetrieved(UINT menuItemId, const ShellItemDetails &details,
+	int callbackId)
+{
+	auto itr = m_pendingDetailsCallbackIds.find(callbackId);
+
+	// As with icons, the details might be for an item that was removed when the menu was rebuilt.
+	if (itr == m_pendingDetailsCallbackIds.end())
 	{
-		defaultIconType = DefaultIconType::File;
+		return;
 	}
 
-	int iconIndex = m_iconFetcher->GetCachedIconIndexOrDefault(itemPath, defaultIconType);
+	m_pendingDetailsCallbackIds.erase(itr);
 
-	return ImageHelper::ImageListIconToBitmap(m_systemImageList.get(), iconIndex);
+	m_menuView->SetItemText(menuItemId, GetTextForDetails(details));
+	m_menuView->SetHelpTextForItem(menuItemId, details.displayPath);
+
+	// If the icon has already been retrieved, it will have been cached, so this will simply set the
+	// same icon again. Otherwise, this replaces the placeholder icon with the best icon that's
+	// currently available.
+	m_menuView->SetBitmapForItem(menuItemId, GetIconForDetails(details));
 }
 
 void ShellItemsMenu::QueueIconUpdateTask(PCIDLIST_ABSOLUTE pidl, UINT menuItemId)
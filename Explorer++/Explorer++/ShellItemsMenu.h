@@ -9,26 +9,43 @@
 #include <wil/com.h>
 #include <wil/resource.h>
 #include <commoncontrols.h>
+#include <chrono>
 
 class BrowserWindow;
 class IconFetcher;
+class ShellItemDetailsFetcher;
+struct ShellItemDetails;
 
 // Displays a set of shell items in a menu, with the name and icon of each item being displayed.
 // An item can be both clicked (to open it in the current tab) and middle-clicked (to open it in a
 // new tab), with the ctrl and shift keys used to control exactly how an item is opened.
+//
+// The details of each item are retrieved in the background, so that building the menu never
+// blocks on the shell. Items whose details haven't been retrieved before are initially shown with
+// a placeholder, which is replaced once the details are available. Cached details are only
+// refreshed once they're older than CACHED_DETAILS_REFRESH_INTERVAL, since some menus (e.g. the
+// history menu) are rebuilt frequently.
 class ShellItemsMenu : public MenuBase
 {
 public:
 	ShellItemsMenu(MenuView *menuView, const std::vector<PidlAbsolute> &pidls,
-		BrowserWindow *browserWindow, IconFetcher *iconFetcher, UINT menuStartId = 1,
+		BrowserWindow *browserWindow, IconFetcher *iconFetcher,
+		ShellItemDetailsFetcher *detailsFetcher, UINT menuStartId = 1,
 		UINT menuEndId = (std::numeric_limits<UINT>::max)());
 	~ShellItemsMenu();
 
 	void RebuildMenu(const std::vector<PidlAbsolute> &pidls);
 
 private:
+	static constexpr wchar_t PLACEHOLDER_TEXT[] = L"...";
+	static constexpr std::chrono::seconds CACHED_DETAILS_REFRESH_INTERVAL{ 60 };
+
 	void AddMenuItemForPidl(PCIDLIST_ABSOLUTE pidl);
-	wil::unique_hbitmap GetShellItemIcon(PCIDLIST_ABSOLUTE pidl);
+	static std::wstring GetTextForDetails(const ShellItemDetails &details);
+	wil::unique_hbitmap GetIconForDetails(const ShellItemDetails &details);
+	wil::unique_hbitmap GetPlaceholderIcon();
+	void QueueDetailsUpdateTask(PCIDLIST_ABSOLUTE pidl, UINT menuItemId);
+	void OnDetailsRetrieved(UINT menuItemId, const ShellItemDetails &details, int callbackId);
 	void QueueIconUpdateTask(PCIDLIST_ABSOLUTE pidl, UINT menuItemId);
 	void OnIconRetrieved(UINT menuItemId, int iconIndex, int callbackId);
 
@@ -39,6 +56,7 @@ private:
 
 	BrowserWindow *const m_browserWindow;
 	IconFetcher *const m_iconFetcher;
+	ShellItemDetailsFetcher *const m_detailsFetcher;
 	const UINT m_menuStartId;
 	const UINT m_menuEndId;
 	UINT m_idCounter;
@@ -48,6 +66,9 @@ private:
 	int m_iconCallbackIdCounter = 0;
 	std::set<int> m_pendingIconCallbackIds;
 
+	int m_detailsCallbackIdCounter = 0;
+	std::set<int> m_pendingDetailsCallbackIds;
+
 	std::shared_ptr<bool> m_destroyed;
 
 	std::vector<boost::signals2::scoped_connection> m_connections;
@@ -58,11 +58,9 @@ ShellTreeView::ShellTreeView(HWND hParent, BrowserWindow *browserWindow,
 	m_config(coreInterface->GetConfig()),
 	m_fileActionHandler(fileActionHandler),
 	m_cachedIcons(cachedIcons),
-	m_iconThreadPool(1, std::bind(CoInitializeEx, nullptr, COINIT_APARTMENTTHREADED),
-		CoUninitialize),
+	m_iconTaskQueue(coreInterface->GetTaskScheduler()),
 	m_iconResultIDCounter(0),
-	m_subfoldersThreadPool(1, std::bind(CoInitializeEx, nullptr, COINIT_APARTMENTTHREADED),
-		CoUninitialize),
+	m_subfoldersTaskQueue(coreInterface->GetTaskScheduler()),
 	m_subfoldersResultIDCounter(0),
 	m_dropExpandItem(nullptr),
 	m_shellChangeWatcher(GetHWND(),
@@ -154,7 +152,7 @@ HWND ShellTreeView::CreateTreeView(HWND parent)
 
 ShellTreeView::~ShellTreeView()
 {
-	m_iconThreadPool.clear_queue();
+	m_iconTaskQueue.CancelPendingTasks();
 }
 
 void ShellTreeView::OnApplicationShuttingDown()
@@ -513,11 +511,9 @@ void ShellTreeView::QueueIconTask(HTREEITEM treeItem)
 
 	int iconResultID = m_iconResultIDCounter++;
 
-	auto result = m_iconThreadPool.push(
-		[this, iconResultID, nodeId = node->GetId(), treeItem, basicItemInfo](int id)
+	auto result = m_iconTaskQueue.Push(
+		[this, iconResultID, nodeId = node->GetId(), treeItem, basicItemInfo]()
 		{
-			UNREFERENCED_PARAMETER(id);
-
 			return FindIconAsync(m_hTreeView, iconResultID, nodeId, treeItem,
 				basicItemInfo.pidl.get());
 		});
@@ -601,11 +597,9 @@ void ShellTreeView::QueueSubfoldersTask(HTREEITEM item)
 
 	int subfoldersResultID = m_subfoldersResultIDCounter++;
 
-	auto result = m_subfoldersThreadPool.push(
-		[this, subfoldersResultID, item, basicItemInfo](int id)
+	auto result = m_subfoldersTaskQueue.Push(
+		[this, subfoldersResultID, item, basicItemInfo]()
 		{
-			UNREFERENCED_PARAMETER(id);
-
 			return CheckSubfoldersAsync(m_hTreeView, subfoldersResultID, item,
 				basicItemInfo.pidl.get());
 		});
@@ -11,9 +11,9 @@
 #include "../Helper/ShellContextMenu.h"
 #include "../Helper/ShellDropTargetWindow.h"
 #include "../Helper/ShellHelper.h"
+#include "../Helper/TaskScheduler.h"
 #include "../Helper/WindowSubclassWrapper.h"
 #include "../Helper/iDirectoryMonitor.h"
-#include "../ThirdParty/CTPL/cpl_stl.h"
 #include <boost/signals2.hpp>
 #include <wil/com.h>
 #include <optional>
@@ -242,11 +242,11 @@ private:
 	// be set. Once the treeview font is set, the same font will be applied to the tooltip control.
 	MainFontSetter m_fontSetter;
 
-	ctpl::thread_pool m_iconThreadPool;
+	TaskQueue m_iconTaskQueue;
 	std::unordered_map<int, std::future<std::optional<IconResult>>> m_iconResults;
 	int m_iconResultIDCounter;
 
-	ctpl::thread_pool m_subfoldersThreadPool;
+	TaskQueue m_subfoldersTaskQueue;
 	std::unordered_map<int, std::future<std::optional<SubfoldersResult>>> m_subfoldersResults;
 	int m_subfoldersResultIDCounter;
 
@@ -26,6 +26,7 @@
 #include "../Helper/Macros.h"
 #include "../Helper/MenuHelper.h"
 #include "../Helper/ShellHelper.h"
+#include "../Helper/StringHelper.h"
 #include "../Helper/TabHelper.h"
 #include "../Helper/WindowHelper.h"
 #include "../Helper/iDirectoryMonitor.h"
@@ -674,7 +675,20 @@ void TabContainer::OnGetDispInfo(NMTTDISPINFO *dispInfo)
 		return;
 	}
 
-	StringCchCopy(tabToolTip, std::size(tabToolTip), path->c_str());
+	std::wstring toolTipText = *path;
+
+	// Tabs that have been hibernated don't hold any data for the items in their folder, so this is
+	// indicated to the user.
+	auto reclaimedBytes = tab.GetShellBrowser()->GetHibernationReclaimedBytes();
+
+	if (reclaimedBytes)
+	{
+		toolTipText = std::format(L"{} ({}: {})", toolTipText,
+			ResourceHelper::LoadString(m_resourceInstance, IDS_TAB_HIBERNATED),
+			FormatSizeString(*reclaimedBytes));
+	}
+
+	StringCchCopy(tabToolTip, std::size(tabToolTip), toolTipText.c_str());
 
 	dispInfo->lpszText = tabToolTip;
 }
@@ -886,8 +900,9 @@ Tab &TabContainer::CreateNewTab(const std::wstring &directory, const TabSettings
 Tab &TabContainer::CreateNewTab(const PreservedTab &preservedTab)
 {
 	auto shellBrowser = ShellBrowserImpl::CreateFromPreserved(m_coreInterface->GetMainWindow(),
-		m_embedder, m_coreInterface, m_tabNavigation, m_fileActionHandler, preservedTab.history,
-		preservedTab.currentEntry, preservedTab.preservedFolderState);
+		m_embedder, m_coreInterface, m_tabNavigation, m_fileActionHandler,
+		preservedTab.BuildHistoryEntries(), preservedTab.currentEntry,
+		preservedTab.preservedFolderState);
 	auto tabTemp = std::make_unique<Tab>(preservedTab, shellBrowser);
 	auto item = m_tabs.insert({ tabTemp->GetId(), std::move(tabTemp) });
 
@@ -895,9 +910,9 @@ Tab &TabContainer::CreateNewTab(const PreservedTab &preservedTab)
 
 	TabSettings tabSettings(_index = preservedTab.index, _selected = true);
 
-	PreservedHistoryEntry *entry = preservedTab.history.at(preservedTab.currentEntry).get();
+	auto pidl = preservedTab.GetCurrentHistoryEntryPidl();
 	auto navigateParams =
-		NavigateParams::Normal(entry->pidl.Raw(), HistoryEntryType::ReplaceCurrentEntry);
+		NavigateParams::Normal(pidl.Raw(), HistoryEntryType::ReplaceCurrentEntry);
 	return SetUpNewTab(tab, navigateParams, tabSettings);
 }
 
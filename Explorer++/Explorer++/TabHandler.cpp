@@ -5,13 +5,16 @@
 #include "stdafx.h"
 #include "Explorer++.h"
 #include "Bookmarks/BookmarkTreeFactory.h"
+#include "ClosedTabsStorage.h"
 #include "Config.h"
+#include "Explorer++_internal.h"
 #include "LoadSaveInterface.h"
 #include "MainMenuSubMenuView.h"
 #include "MainResource.h"
 #include "MenuRanges.h"
 #include "ShellBrowser/ShellBrowserImpl.h"
 #include "TabContainer.h"
+#include "TabHibernationManager.h"
 #include "TabRestorer.h"
 #include "TabRestorerMenu.h"
 #include "TabStorage.h"
@@ -63,6 +66,7 @@ void Explorerplusplus::InitializeTabs()
 	m_connections.push_back(m_config->extendTabControl.addObserver(updateLayoutObserverMethod));
 
 	m_tabRestorer = std::make_unique<TabRestorer>(tabContainer);
+	LoadClosedTabs();
 
 	// TODO: These should be initialized when the main menu is initialized, but that's not possible
 	// at the moment, due to the dependence on m_tabRestorer, which itself depends on tabContainer.
@@ -72,6 +76,9 @@ void Explorerplusplus::InitializeTabs()
 		m_tabRestorer.get(), m_acceleratorManager, m_resourceInstance, MENU_RECENT_TABS_START_ID,
 		MENU_RECENT_TABS_END_ID);
 
+	m_tabHibernationManager =
+		std::make_unique<TabHibernationManager>(tabContainer, m_config.get(), m_pDirMon);
+
 	m_tabsInitializedSignal();
 }
 
@@ -265,6 +272,32 @@ void Explorerplusplus::CreateCommandLineTabs()
 	}
 }
 
+// Closed tabs are stored alongside the other data files, so that they can still be restored after
+// the application is restarted.
+void Explorerplusplus::LoadClosedTabs()
+{
+	auto path = GetDataFilePath(NExplorerplusplus::CLOSED_TABS_FILENAME);
+
+	if (!path)
+	{
+		return;
+	}
+
+	m_tabRestorer->AddPreviouslyClosedTabs(ClosedTabsStorage::Load(*path));
+}
+
+void Explorerplusplus::SaveClosedTabs()
+{
+	auto path = GetDataFilePath(NExplorerplusplus::CLOSED_TABS_FILENAME);
+
+	if (!path)
+	{
+		return;
+	}
+
+	ClosedTabsStorage::Save(*path, m_tabRestorer->GetClosedTabs());
+}
+
 void Explorerplusplus::OnTabSelected(const Tab &tab)
 {
 	/* Hide the old listview. */
@@ -273,6 +306,13 @@ void Explorerplusplus::OnTabSelected(const Tab &tab)
 	m_hActiveListView = tab.GetShellBrowser()->GetListView();
 	m_pActiveShellBrowser = tab.GetShellBrowser();
 
+	// Background work for the selected tab takes priority over work for the other tabs.
+	for (const auto &[tabId, currentTab] : GetActivePane()->GetTabContainer()->GetAllTabs())
+	{
+		currentTab->GetShellBrowser()->SetTaskPriority(
+			currentTab.get() == &tab ? TaskPriority::Foreground : TaskPriority::Background);
+	}
+
 	UpdateWindowStates(tab);
 
 	/* Show the new listview. */
@@ -324,16 +364,11 @@ void Explorerplusplus::HideTabBar()
 
 void Explorerplusplus::OnTabListViewSelectionChanged(const Tab &tab)
 {
-	/* The selection for this tab has changed, so invalidate any
-	folder size calculations that are occurring for this tab
-	(applies only to folder sizes that will be shown in the display
-	window). */
-	for (auto &item : m_DWFolderSizes)
+	// The selection for this tab has changed, so any folder size calculation that's occurring for
+	// this tab (for the display window) is no longer needed.
+	if (m_displayWindowFolderSizeRequest && m_displayWindowFolderSizeRequest->tabId == tab.GetId())
 	{
-		if (item.iTabId == tab.GetId())
-		{
-			item.bValid = FALSE;
-		}
+		CancelDisplayWindowFolderSizeRequest();
 	}
 
 	if (GetActivePane()->GetTabContainer()->IsTabSelected(tab))
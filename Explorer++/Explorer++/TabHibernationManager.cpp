@@ -0,0 +1,165 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "TabHibernationManager.h"
+#include "Config.h"
+#include "ShellBrowser/ShellBrowserImpl.h"
+#include "TabContainer.h"
+#include "../Helper/iDirectoryMonitor.h"
+#include <glog/logging.h>
+
+TabHibernationManager::TabHibernationManager(TabContainer *tabContainer, const Config *config,
+	IDirectoryMonitor *directoryMonitor) :
+	m_tabContainer(tabContainer),
+	m_config(config),
+	m_directoryMonitor(directoryMonitor)
+{
+	for (const auto &[tabId, tab] : m_tabContainer->GetAllTabs())
+	{
+		UNREFERENCED_PARAMETER(tab);
+
+		m_lastActiveTimes[tabId] = Clock::now();
+	}
+
+	m_connections.push_back(m_tabContainer->tabCreatedSignal.AddObserver(
+		std::bind_front(&TabHibernationManager::OnTabCreated, this)));
+
+	// A hibernated tab needs to be woken before anything else attempts to query the items in the
+	// tab, which is why this observer is added at the front.
+	m_connections.push_back(m_tabContainer->tabSelectedSignal.AddObserver(
+		std::bind_front(&TabHibernationManager::OnTabSelected, this), boost::signals2::at_front));
+
+	m_connections.push_back(m_tabContainer->tabRemovedSignal.AddObserver(
+		std::bind_front(&TabHibernationManager::OnTabRemoved, this)));
+	m_connections.push_back(m_tabContainer->tabNavigationCompletedSignal.AddObserver(
+		std::bind_front(&TabHibernationManager::OnNavigationCompleted, this)));
+}
+
+void TabHibernationManager::OnTabCreated(int tabId, BOOL switchToNewTab)
+{
+	UNREFERENCED_PARAMETER(switchToNewTab);
+
+	m_lastActiveTimes[tabId] = Clock::now();
+}
+
+void TabHibernationManager::OnTabSelected(const Tab &tab)
+{
+	m_lastActiveTimes[tab.GetId()] = Clock::now();
+
+	tab.GetShellBrowser()->Wake();
+}
+
+void TabHibernationManager::OnTabRemoved(int tabId)
+{
+	m_lastActiveTimes.erase(tabId);
+}
+
+void TabHibernationManager::OnNavigationCompleted(const Tab &tab,
+	const NavigateParams &navigateParams)
+{
+	UNREFERENCED_PARAMETER(navigateParams);
+
+	m_lastActiveTimes[tab.GetId()] = Clock::now();
+}
+
+void TabHibernationManager::HibernateInactiveTabs()
+{
+	if (!m_config->hibernateInactiveTabs)
+	{
+		return;
+	}
+
+	uint64_t memoryBudget =
+		static_cast<uint64_t>((std::max)(m_config->tabHibernationMemoryBudgetMB, 0)) * 1024 * 1024;
+
+	auto tabIds = SelectTabsToHibernate(GetHibernationCandidatesByAge(), Clock::now(),
+		m_config->tabHibernationTimeout, memoryBudget);
+
+	for (int tabId : tabIds)
+	{
+		HibernateTab(m_tabContainer->GetTab(tabId));
+	}
+}
+
+std::vector<int> TabHibernationManager::SelectTabsToHibernate(
+	const std::vector<HibernationCandidate> &candidatesByAge, Clock::time_point now,
+	std::chrono::minutes timeout, uint64_t memoryBudget)
+{
+	uint64_t totalMemoryUsage = 0;
+
+	for (const auto &candidate : candidatesByAge)
+	{
+		totalMemoryUsage += candidate.memoryUsage;
+	}
+
+	std::vector<int> tabIds;
+
+	for (const auto &candidate : candidatesByAge)
+	{
+		bool timedOut = timeout.count() > 0 && (now - candidate.lastActiveTime) >= timeout;
+		bool overBudget = memoryBudget > 0 && totalMemoryUsage > memoryBudget;
+
+		if (!timedOut && !overBudget)
+		{
+			continue;
+		}
+
+		tabIds.push_back(candidate.tabId);
+
+		totalMemoryUsage -= candidate.memoryUsage;
+	}
+
+	return tabIds;
+}
+
+// Returns the set of tabs that can be hibernated, with the least recently used tabs appearing
+// first.
+std::vector<TabHibernationManager::HibernationCandidate>
+TabHibernationManager::GetHibernationCandidatesByAge() const
+{
+	std::vector<HibernationCandidate> candidates;
+
+	for (const auto &[tabId, tab] : m_tabContainer->GetAllTabs())
+	{
+		if (m_tabContainer->IsTabSelected(*tab) || tab->GetShellBrowser()->IsHibernated())
+		{
+			continue;
+		}
+
+		candidates.push_back({ tabId, m_lastActiveTimes.at(tabId),
+			tab->GetShellBrowser()->EstimateItemMemoryUsage() });
+	}
+
+	std::sort(candidates.begin(), candidates.end(),
+		[](const HibernationCandidate &candidate1, const HibernationCandidate &candidate2)
+		{ return candidate1.lastActiveTime < candidate2.lastActiveTime; });
+
+	return candidates;
+}
+
+void TabHibernationManager::HibernateTab(const Tab &tab)
+{
+	auto *shellBrowser = tab.GetShellBrowser();
+
+	// Directory monitoring will be started again once the tab is woken, since the folder will be
+	// navigated to again.
+	auto dirMonitorId = shellBrowser->GetDirMonitorId();
+
+	if (dirMonitorId)
+	{
+		m_directoryMonitor->StopDirectoryMonitor(*dirMonitorId);
+		shellBrowser->ClearDirMonitorId();
+	}
+
+	shellBrowser->Hibernate();
+
+	auto reclaimedBytes = shellBrowser->GetHibernationReclaimedBytes();
+
+	if (reclaimedBytes)
+	{
+		LOG(INFO) << "Hibernated tab " << tab.GetId() << ", reclaiming approximately "
+				  << *reclaimedBytes << " bytes";
+	}
+}
@@ -0,0 +1,68 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <boost/signals2.hpp>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+struct Config;
+__interface IDirectoryMonitor;
+struct NavigateParams;
+class Tab;
+class TabContainer;
+
+// Hibernates tabs that haven't been used for a period of time (or once the tabs in the background
+// are using too much memory). A hibernated tab releases the data it holds for the items in its
+// current folder and stops monitoring that folder. The folder is enumerated again once the tab is
+// selected.
+class TabHibernationManager : private boost::noncopyable
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct HibernationCandidate
+	{
+		int tabId;
+		Clock::time_point lastActiveTime;
+		uint64_t memoryUsage;
+	};
+
+	// The interval at which tabs are checked.
+	static constexpr std::chrono::minutes CHECK_INTERVAL = std::chrono::minutes(1);
+
+	TabHibernationManager(TabContainer *tabContainer, const Config *config,
+		IDirectoryMonitor *directoryMonitor);
+
+	void HibernateInactiveTabs();
+
+	// Returns the tabs that should be hibernated, given a set of candidates ordered from least to
+	// most recently used. A tab is selected if it's been inactive for at least the timeout, or if
+	// the candidates that remain are using more memory than the budget. A timeout or budget of 0
+	// disables the corresponding check.
+	static std::vector<int> SelectTabsToHibernate(
+		const std::vector<HibernationCandidate> &candidatesByAge, Clock::time_point now,
+		std::chrono::minutes timeout, uint64_t memoryBudget);
+
+private:
+	void OnTabCreated(int tabId, BOOL switchToNewTab);
+	void OnTabSelected(const Tab &tab);
+	void OnTabRemoved(int tabId);
+	void OnNavigationCompleted(const Tab &tab, const NavigateParams &navigateParams);
+
+	std::vector<HibernationCandidate> GetHibernationCandidatesByAge() const;
+	void HibernateTab(const Tab &tab);
+
+	TabContainer *const m_tabContainer;
+	const Config *const m_config;
+	IDirectoryMonitor *const m_directoryMonitor;
+
+	// Maps tab IDs to the last time the tab was active.
+	std::unordered_map<int, Clock::time_point> m_lastActiveTimes;
+
+	std::vector<boost::signals2::scoped_connection> m_connections;
+};
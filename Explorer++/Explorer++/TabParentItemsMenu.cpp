@@ -10,16 +10,17 @@
 #include "../Helper/ShellHelper.h"
 
 TabParentItemsMenu::TabParentItemsMenu(MenuView *menuView, BrowserWindow *browserWindow,
-	IconFetcher *iconFetcher) :
+	IconFetcher *iconFetcher, ShellItemDetailsFetcher *detailsFetcher) :
 	ShellItemsMenu(menuView, GetParentPidlCollection(browserWindow->GetActiveShellBrowser()),
-		browserWindow, iconFetcher)
+		browserWindow, iconFetcher, detailsFetcher)
 {
 }
 
 TabParentItemsMenu::TabParentItemsMenu(MenuView *menuView, BrowserWindow *browserWindow,
-	IconFetcher *iconFetcher, UINT menuStartId, UINT menuEndId) :
+	IconFetcher *iconFetcher, ShellItemDetailsFetcher *detailsFetcher, UINT menuStartId,
+	UINT menuEndId) :
 	ShellItemsMenu(menuView, GetParentPidlCollection(browserWindow->GetActiveShellBrowser()),
-		browserWindow, iconFetcher, menuStartId, menuEndId)
+		browserWindow, iconFetcher, detailsFetcher, menuStartId, menuEndId)
 {
 }
 
@@ -12,9 +12,10 @@ class ShellBrowser;
 class TabParentItemsMenu : public ShellItemsMenu
 {
 public:
-	TabParentItemsMenu(MenuView *menuView, BrowserWindow *browserWindow, IconFetcher *iconFetcher);
 	TabParentItemsMenu(MenuView *menuView, BrowserWindow *browserWindow, IconFetcher *iconFetcher,
-		UINT menuStartId, UINT menuEndId);
+		ShellItemDetailsFetcher *detailsFetcher);
+	TabParentItemsMenu(MenuView *menuView, BrowserWindow *browserWindow, IconFetcher *iconFetcher,
+		ShellItemDetailsFetcher *detailsFetcher, UINT menuStartId, UINT menuEndId);
 
 private:
 	static std::vector<PidlAbsolute> GetParentPidlCollection(const ShellBrowser *shellBrowser);
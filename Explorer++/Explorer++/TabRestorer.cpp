@@ -6,7 +6,9 @@
 #include "TabRestorer.h"
 #include "TabContainer.h"
 
-TabRestorer::TabRestorer(TabContainer *tabContainer) : m_tabContainer(tabContainer)
+TabRestorer::TabRestorer(TabContainer *tabContainer, size_t maxClosedTabs) :
+	m_tabContainer(tabContainer),
+	m_maxClosedTabs(maxClosedTabs)
 {
 	m_connections.push_back(m_tabContainer->tabPreRemovalSignal.AddObserver(
 		std::bind_front(&TabRestorer::OnTabPreRemoval, this)));
@@ -14,12 +16,40 @@ TabRestorer::TabRestorer(TabContainer *tabContainer) : m_tabContainer(tabContain
 
 void TabRestorer::OnTabPreRemoval(const Tab &tab)
 {
-	auto closedTab = std::make_unique<PreservedTab>(tab, m_tabContainer->GetTabIndex(tab));
-	m_closedTabs.insert(m_closedTabs.begin(), std::move(closedTab));
+	auto closedTab = std::make_unique<PreservedTab>(tab, m_closedTabIdCounter++,
+		m_tabContainer->GetTabIndex(tab));
+	m_closedTabs.push_front(std::move(closedTab));
+	RemoveExcessTabs();
 	m_itemsChangedSignal();
 }
 
-const std::vector<std::unique_ptr<PreservedTab>> &TabRestorer::GetClosedTabs() const
+void TabRestorer::AddPreviouslyClosedTabs(std::vector<std::unique_ptr<PreservedTab>> closedTabs)
+{
+	if (closedTabs.empty())
+	{
+		return;
+	}
+
+	for (auto &closedTab : closedTabs)
+	{
+		// Tabs loaded from storage don't have a meaningful ID, so each one is assigned an ID here.
+		closedTab->id = m_closedTabIdCounter++;
+		m_closedTabs.push_back(std::move(closedTab));
+	}
+
+	RemoveExcessTabs();
+	m_itemsChangedSignal();
+}
+
+void TabRestorer::RemoveExcessTabs()
+{
+	while (m_closedTabs.size() > m_maxClosedTabs)
+	{
+		m_closedTabs.pop_back();
+	}
+}
+
+const TabRestorer::ClosedTabs &TabRestorer::GetClosedTabs() const
 {
 	return m_closedTabs;
 }
@@ -7,17 +7,33 @@
 #include "PreservedTab.h"
 #include <boost/core/noncopyable.hpp>
 #include <boost/signals2.hpp>
+#include <deque>
+#include <memory>
+#include <vector>
 
 class TabContainer;
 
+// Tracks recently closed tabs, so that they can be restored. Only a fixed number of tabs are
+// retained. Once that limit is reached, closing a tab will cause the oldest closed tab to be
+// discarded.
 class TabRestorer : private boost::noncopyable
 {
 public:
 	using ItemsChangedSignal = boost::signals2::signal<void()>;
 
-	TabRestorer(TabContainer *tabContainer);
+	// Closed tabs, with the most recently closed tab first.
+	using ClosedTabs = std::deque<std::unique_ptr<PreservedTab>>;
 
-	const std::vector<std::unique_ptr<PreservedTab>> &GetClosedTabs() const;
+	static constexpr size_t MAX_CLOSED_TABS = 50;
+
+	TabRestorer(TabContainer *tabContainer, size_t maxClosedTabs = MAX_CLOSED_TABS);
+
+	// Adds tabs that were closed in a previous session (e.g. tabs loaded from storage). The tabs
+	// should be ordered from most to least recently closed and are treated as being older than any
+	// tabs closed in this session.
+	void AddPreviouslyClosedTabs(std::vector<std::unique_ptr<PreservedTab>> closedTabs);
+
+	const ClosedTabs &GetClosedTabs() const;
 	const PreservedTab *GetTabById(int id) const;
 	void RestoreLastTab();
 	void RestoreTabById(int id);
@@ -27,11 +43,14 @@ public:
 
 private:
 	void OnTabPreRemoval(const Tab &tab);
+	void RemoveExcessTabs();
 
 	TabContainer *m_tabContainer;
+	const size_t m_maxClosedTabs;
 	std::vector<boost::signals2::scoped_connection> m_connections;
 
-	std::vector<std::unique_ptr<PreservedTab>> m_closedTabs;
+	ClosedTabs m_closedTabs;
+	int m_closedTabIdCounter = 0;
 
 	ItemsChangedSignal m_itemsChangedSignal;
 };
@@ -9,7 +9,6 @@
 #include "MainResource.h"
 #include "MenuView.h"
 #include "ResourceHelper.h"
-#include "ShellBrowser/PreservedHistoryEntry.h"
 #include "TabRestorer.h"
 #include "../Helper/ImageHelper.h"
 #include "../Helper/ShellHelper.h"
@@ -72,9 +71,9 @@ void TabRestorerMenu::AddMenuItemForClosedTab(const PreservedTab *closedTab,
 		return;
 	}
 
-	auto currentEntry = closedTab->history.at(closedTab->currentEntry).get();
+	const auto &currentEntry = closedTab->GetCurrentHistoryEntry();
 
-	std::wstring menuText = currentEntry->displayName;
+	std::wstring menuText = currentEntry.displayName;
 
 	if (addAcceleratorText)
 	{
@@ -87,7 +86,7 @@ void TabRestorerMenu::AddMenuItemForClosedTab(const PreservedTab *closedTab,
 	}
 
 	wil::unique_hbitmap bitmap;
-	auto iconIndex = currentEntry->systemIconIndex;
+	auto iconIndex = currentEntry.systemIconIndex;
 
 	if (iconIndex)
 	{
@@ -99,7 +98,7 @@ void TabRestorerMenu::AddMenuItemForClosedTab(const PreservedTab *closedTab,
 			ImageHelper::ImageListIconToBitmap(m_systemImageList.get(), m_defaultFolderIconIndex);
 	}
 
-	m_menuView->AppendItem(id, menuText, std::move(bitmap), currentEntry->fullPathForDisplay);
+	m_menuView->AppendItem(id, menuText, std::move(bitmap), currentEntry.fullPathForDisplay);
 
 	auto [itr, didInsert] = m_menuItemMappings.insert({ id, closedTab->id });
 	DCHECK(didInsert);
@@ -11,7 +11,6 @@
 #include "ShellBrowser/ShellBrowserImpl.h"
 #include "TabContainer.h"
 #include "../Helper/BaseDialog.h"
-#include "../Helper/ListViewHelper.h"
 #include "../Helper/Macros.h"
 #include "../Helper/RegistrySettings.h"
 #include "../Helper/WindowHelper.h"
@@ -124,19 +123,8 @@ void WildcardSelectDialog::OnOk()
 void WildcardSelectDialog::SelectItems(TCHAR *szPattern)
 {
 	const auto &tab = m_browserWindow->GetActivePane()->GetTabContainer()->GetSelectedTab();
-	HWND hListView = tab.GetShellBrowser()->GetListView();
-
-	int nItems = ListView_GetItemCount(hListView);
-
-	for (int i = 0; i < nItems; i++)
-	{
-		std::wstring filename = tab.GetShellBrowser()->GetItemName(i);
-
-		if (CheckWildcardMatch(szPattern, filename.c_str(), FALSE) == 1)
-		{
-			ListViewHelper::SelectItem(hListView, i, m_bSelect);
-		}
-	}
+	tab.GetShellBrowser()->SelectItemsMatchingPredicate(
+		ItemPredicates::MatchesWildcard(szPattern, false), m_bSelect);
 }
 
 void WildcardSelectDialog::OnCancel()
@@ -44,6 +44,8 @@ HWND g_hwndRunScript = nullptr;
 HWND g_hwndOptions = nullptr;
 HWND g_hwndManageBookmarks = nullptr;
 HWND g_hwndSearchTabs = nullptr;
+HWND g_hwndPerformanceTrace = nullptr;
+HWND g_hwndPluginDiagnostics = nullptr;
 
 ATOM RegisterMainWindowClass(HINSTANCE hInstance)
 {
@@ -346,7 +348,9 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 		would be taken even when the dialog has focus. */
 		if (!IsDialogMessage(g_hwndSearch, &msg) && !IsDialogMessage(g_hwndManageBookmarks, &msg)
 			&& !IsDialogMessage(g_hwndRunScript, &msg) && !IsDialogMessage(g_hwndOptions, &msg)
-			&& !IsDialogMessage(g_hwndSearchTabs, &msg))
+			&& !IsDialogMessage(g_hwndSearchTabs, &msg)
+			&& !IsDialogMessage(g_hwndPerformanceTrace, &msg)
+			&& !IsDialogMessage(g_hwndPluginDiagnostics, &msg))
 		{
 			if (!TranslateAccelerator(hwnd, acceleratorManager.GetAcceleratorTable(), &msg))
 			{
@@ -113,6 +113,9 @@ will need to be changed correspondingly. */
 #define HASH_DISPLAY_MIXED_FILES_AND_FOLDERS 1168704423
 #define HASH_USE_NATURAL_SORT_ORDER 528323501
 #define HASH_OPEN_TABS_IN_FOREGROUND 2957281235
+#define HASH_HIBERNATE_INACTIVE_TABS 3346649460
+#define HASH_TAB_HIBERNATION_TIMEOUT 3028566102
+#define HASH_TAB_HIBERNATION_MEMORY_BUDGET 3876863011
 #define HASH_GROUP_SORT_DIRECTION_GLOBAL 790225996
 #define HASH_GO_UP_ON_DOUBLE_CLICK 1809284638
 #define HASH_MAIN_FONT 3006124449
@@ -669,6 +672,17 @@ void Explorerplusplus::SaveGenericSettingsToXML(IXMLDOMDocument *pXMLDom, IXMLDO
 	XMLSettings::WriteStandardSetting(pXMLDom, pe.get(), _T("Setting"), _T("OpenTabsInForeground"),
 		XMLSettings::EncodeBoolValue(m_config->openTabsInForeground));
 
+	XMLSettings::AddWhiteSpaceToNode(pXMLDom, bstr_wsntt.get(), pe.get());
+	XMLSettings::WriteStandardSetting(pXMLDom, pe.get(), _T("Setting"), _T("HibernateInactiveTabs"),
+		XMLSettings::EncodeBoolValue(m_config->hibernateInactiveTabs));
+	XMLSettings::AddWhiteSpaceToNode(pXMLDom, bstr_wsntt.get(), pe.get());
+	XMLSettings::WriteStandardSetting(pXMLDom, pe.get(), _T("Setting"), _T("TabHibernationTimeout"),
+		XMLSettings::EncodeIntValue(static_cast<int>(m_config->tabHibernationTimeout.count())));
+	XMLSettings::AddWhiteSpaceToNode(pXMLDom, bstr_wsntt.get(), pe.get());
+	XMLSettings::WriteStandardSetting(pXMLDom, pe.get(), _T("Setting"),
+		_T("TabHibernationMemoryBudget"),
+		XMLSettings::EncodeIntValue(m_config->tabHibernationMemoryBudgetMB));
+
 	XMLSettings::AddWhiteSpaceToNode(pXMLDom, bstr_wsntt.get(), pe.get());
 	XMLSettings::WriteStandardSetting(pXMLDom, pe.get(), _T("Setting"),
 		_T("GroupSortDirectionGlobal"),
@@ -1220,6 +1234,20 @@ void Explorerplusplus::MapAttributeToValue(IXMLDOMNode *pNode, WCHAR *wszName, W
 		m_config->openTabsInForeground = XMLSettings::DecodeBoolValue(wszValue);
 		break;
 
+	case HASH_HIBERNATE_INACTIVE_TABS:
+		m_config->hibernateInactiveTabs = XMLSettings::DecodeBoolValue(wszValue);
+		break;
+
+	case HASH_TAB_HIBERNATION_TIMEOUT:
+		m_config->tabHibernationTimeout =
+			std::chrono::minutes((std::max)(XMLSettings::DecodeIntValue(wszValue), 0));
+		break;
+
+	case HASH_TAB_HIBERNATION_MEMORY_BUDGET:
+		m_config->tabHibernationMemoryBudgetMB =
+			(std::max)(XMLSettings::DecodeIntValue(wszValue), 0);
+		break;
+
 	case HASH_GROUP_SORT_DIRECTION_GLOBAL:
 		m_config->defaultFolderSettings.groupSortDirection =
 			SortDirection::_from_integral(XMLSettings::DecodeIntValue(wszValue));
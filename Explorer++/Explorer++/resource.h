@@ -218,6 +218,29 @@
 #define IDS_BACKGROUND_CONTEXT_MENU_PASTE_SHORTCUT 399
 #define IDS_GENERAL_OPEN_IN_NEW_TAB_HELP_TEXT 400
 #define IDS_SEARCH_OPEN_ITEM_LOCATION_HELP_TEXT 401
+#define IDS_ADVANCED_OPTION_HIBERNATE_INACTIVE_TABS_NAME 402
+#define IDS_ADVANCED_OPTION_HIBERNATE_INACTIVE_TABS_DESCRIPTION 403
+#define IDS_TAB_HIBERNATED 404
+#define IDD_PERFORMANCE_TRACE           405
+#define IDS_PERFORMANCE_TRACE_COLUMN_CATEGORY 406
+#define IDS_PERFORMANCE_TRACE_COLUMN_NAME 407
+#define IDS_PERFORMANCE_TRACE_COLUMN_TYPE 408
+#define IDS_PERFORMANCE_TRACE_COLUMN_COUNT 409
+#define IDS_PERFORMANCE_TRACE_COLUMN_TOTAL 410
+#define IDS_PERFORMANCE_TRACE_COLUMN_AVERAGE 411
+#define IDS_PERFORMANCE_TRACE_COLUMN_MAXIMUM 412
+#define IDS_PERFORMANCE_TRACE_TYPE_SPAN 413
+#define IDS_PERFORMANCE_TRACE_TYPE_COUNTER 414
+#define IDS_PERFORMANCE_TRACE_FILTER 415
+#define IDS_PERFORMANCE_TRACE_EXPORT_FAILED 416
+#define IDD_PLUGIN_DIAGNOSTICS          417
+#define IDS_PLUGIN_DIAGNOSTICS_COLUMN_PLUGIN 418
+#define IDS_PLUGIN_DIAGNOSTICS_COLUMN_CALLS 419
+#define IDS_PLUGIN_DIAGNOSTICS_COLUMN_FAILED 420
+#define IDS_PLUGIN_DIAGNOSTICS_COLUMN_DEFERRED 421
+#define IDS_PLUGIN_DIAGNOSTICS_COLUMN_TOTAL 422
+#define IDS_PLUGIN_DIAGNOSTICS_COLUMN_AVERAGE 423
+#define IDS_PLUGIN_DIAGNOSTICS_COLUMN_SLOWEST 424
 #define IDC_DEFAULTCOLUMNS_DESCRIPTION  1001
 #define IDC_COLUMNS_DESCRIPTION         1001
 #define IDC_SETTINGS_CHECK_EXTENSIONS   1002
@@ -441,6 +464,13 @@
 #define IDC_OPTIONS_FONT_RESET_TO_DEFAULT 1371
 #define IDC_OPTIONS_FONT_SAMPLE         1372
 #define IDC_OPTIONS_MAIN_FONT           1373
+#define IDC_PERFORMANCE_TRACE_LIST      1374
+#define IDC_PERFORMANCE_TRACE_REFRESH   1375
+#define IDC_PERFORMANCE_TRACE_RESET     1376
+#define IDC_PERFORMANCE_TRACE_EXPORT    1377
+#define IDC_PLUGIN_DIAGNOSTICS_LIST     1378
+#define IDC_PLUGIN_DIAGNOSTICS_REFRESH  1379
+#define IDC_PLUGIN_DIAGNOSTICS_RESET    1380
 #define IDS_COLUMN_DESCRIPTION_NAME     2000
 #define IDS_COLUMN_DESCRIPTION_TYPE     2001
 #define IDS_COLUMN_DESCRIPTION_SIZE     2002
@@ -869,6 +899,8 @@
 #define IDM_VIEW_DUAL_PANE              40548
 #define IDM_GO_HISTORY                  40550
 #define IDM_EDIT_PASTE_SYMBOLIC_LINK    40551
+#define IDM_TOOLS_PERFORMANCE_TRACE     40552
+#define IDM_TOOLS_PLUGIN_DIAGNOSTICS    40553
 #define IDM_SORTBY_NAME                 50000
 #define IDM_SORTBY_SIZE                 50001
 #define IDM_SORTBY_TYPE                 50002
@@ -1013,9 +1045,9 @@
 // 
 #ifdef APSTUDIO_INVOKED
 #ifndef APSTUDIO_READONLY_SYMBOLS
-#define _APS_NEXT_RESOURCE_VALUE        402
-#define _APS_NEXT_COMMAND_VALUE         40552
-#define _APS_NEXT_CONTROL_VALUE         1374
+#define _APS_NEXT_RESOURCE_VALUE        425
+#define _APS_NEXT_COMMAND_VALUE         40554
+#define _APS_NEXT_CONTROL_VALUE         1381
 #define _APS_NEXT_SYMED_VALUE           101
 #endif
 #endif
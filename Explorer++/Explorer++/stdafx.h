@@ -24,7 +24,6 @@
 #include "../Helper/DisableUnaligned.h"
 
 // Third-party Header Files:
-#include "../ThirdParty/CTPL/cpl_stl.h"
 #include <nlohmann/json.hpp>
 #include <cereal/archives/binary.hpp>
 #include <cereal/types/memory.hpp>
@@ -0,0 +1,167 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "AppendOnlyJournal.h"
+#include <fstream>
+
+AppendOnlyJournal::AppendOnlyJournal(const std::filesystem::path &path, uint32_t magic,
+	uint32_t version) :
+	m_path(path),
+	m_magic(magic),
+	m_version(version)
+{
+}
+
+void AppendOnlyJournal::Load(const RecordReader &reader)
+{
+	m_numRecords = 0;
+
+	std::ifstream inputStream(m_path, std::ios::binary);
+
+	if (!inputStream)
+	{
+		return;
+	}
+
+	uint32_t magic;
+	uint32_t version;
+	inputStream.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+	inputStream.read(reinterpret_cast<char *>(&version), sizeof(version));
+
+	if (!inputStream || magic != m_magic || version != m_version)
+	{
+		// The file can't be used, so it will simply be replaced.
+		inputStream.close();
+		Rewrite({});
+		return;
+	}
+
+	size_t numRecords = 0;
+	auto validEndPosition = inputStream.tellg();
+	bool invalidDataFound = false;
+
+	while (inputStream.peek() != std::char_traits<char>::eof())
+	{
+		if (!reader(inputStream))
+		{
+			invalidDataFound = true;
+			break;
+		}
+
+		numRecords++;
+		validEndPosition = inputStream.tellg();
+	}
+
+	inputStream.close();
+
+	if (invalidDataFound)
+	{
+		// Any data after the last valid record is discarded. If that wasn't done, new records would
+		// be appended after the invalid data and would never be read back.
+		std::error_code error;
+		std::filesystem::resize_file(m_path, static_cast<uintmax_t>(validEndPosition), error);
+	}
+
+	m_numRecords = numRecords;
+}
+
+bool AppendOnlyJournal::Append(const std::string &record)
+{
+	std::error_code error;
+	bool exists = std::filesystem::exists(m_path, error);
+
+	std::ofstream outputStream(m_path, std::ios::binary | std::ios::app);
+
+	if (!outputStream)
+	{
+		return false;
+	}
+
+	if (!exists && !WriteHeader(outputStream))
+	{
+		return false;
+	}
+
+	if (!WriteRecord(outputStream, record))
+	{
+		return false;
+	}
+
+	outputStream.flush();
+
+	if (!outputStream)
+	{
+		return false;
+	}
+
+	m_numRecords++;
+
+	return true;
+}
+
+bool AppendOnlyJournal::Rewrite(const std::vector<std::string> &records)
+{
+	// The journal is written to a temporary file first, so that the existing journal remains intact
+	// if writing fails part way through.
+	auto temporaryPath = m_path;
+	temporaryPath += L".tmp";
+
+	{
+		std::ofstream outputStream(temporaryPath, std::ios::binary | std::ios::trunc);
+
+		if (!outputStream || !WriteHeader(outputStream))
+		{
+			return false;
+		}
+
+		for (const auto &record : records)
+		{
+			if (!WriteRecord(outputStream, record))
+			{
+				return false;
+			}
+		}
+
+		outputStream.flush();
+
+		if (!outputStream)
+		{
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporaryPath, m_path, error);
+
+	if (error)
+	{
+		std::filesystem::remove(temporaryPath, error);
+		return false;
+	}
+
+	m_numRecords = records.size();
+
+	return true;
+}
+
+size_t AppendOnlyJournal::GetNumRecords() const
+{
+	return m_numRecords;
+}
+
+bool AppendOnlyJournal::WriteHeader(std::ostream &stream) const
+{
+	stream.write(reinterpret_cast<const char *>(&m_magic), sizeof(m_magic));
+	stream.write(reinterpret_cast<const char *>(&m_version), sizeof(m_version));
+	return stream.good();
+}
+
+bool AppendOnlyJournal::WriteRecord(std::ostream &stream, const std::string &record)
+{
+	// Each record is written in a single call, which minimizes the chance of only part of the
+	// record being written.
+	stream.write(record.data(), record.size());
+	return stream.good();
+}
@@ -0,0 +1,52 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// A file made up of a header, followed by a sequence of records. Records are only ever appended to
+// the end of the file, so the existing contents of the file never need to be rewritten when a
+// record is added. Since a record can be superseded by a later record, the file will grow over
+// time, which is why it can be compacted, by rewriting it with a specific set of records.
+//
+// The layout of each record is up to the caller. Records are passed in already serialized and are
+// read back through a callback, with the journal itself only being responsible for the header and
+// for the file as a whole.
+class AppendOnlyJournal
+{
+public:
+	// Reads a single record from the stream. Should return false if the record is invalid or
+	// incomplete.
+	using RecordReader = std::function<bool(std::istream &stream)>;
+
+	AppendOnlyJournal(const std::filesystem::path &path, uint32_t magic, uint32_t version);
+
+	// Invokes the reader for each record in the journal, in the order the records were added. If
+	// the journal ends with an invalid record (e.g. because the application crashed while writing
+	// it), that record and anything after it is discarded. If the header doesn't match, the
+	// journal is replaced with an empty one.
+	void Load(const RecordReader &reader);
+
+	bool Append(const std::string &record);
+
+	// Replaces the contents of the journal with the specified records.
+	bool Rewrite(const std::vector<std::string> &records);
+
+	// Returns the number of records in the journal, including superseded records.
+	size_t GetNumRecords() const;
+
+private:
+	bool WriteHeader(std::ostream &stream) const;
+	static bool WriteRecord(std::ostream &stream, const std::string &record);
+
+	const std::filesystem::path m_path;
+	const uint32_t m_magic;
+	const uint32_t m_version;
+	size_t m_numRecords = 0;
+};
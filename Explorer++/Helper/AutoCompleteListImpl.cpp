@@ -0,0 +1,103 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "AutoCompleteListImpl.h"
+
+AutoCompleteListImpl::AutoCompleteListImpl() :
+	m_sharedState(std::make_shared<SharedState>()),
+	m_strings(std::make_shared<const Strings>())
+{
+	m_sharedState->strings = m_strings;
+}
+
+AutoCompleteListImpl::AutoCompleteListImpl(std::shared_ptr<SharedState> sharedState,
+	std::shared_ptr<const Strings> strings, size_t index) :
+	m_sharedState(sharedState),
+	m_strings(strings),
+	m_index(index)
+{
+}
+
+void AutoCompleteListImpl::SetStrings(Strings strings)
+{
+	auto updatedStrings = std::make_shared<const Strings>(std::move(strings));
+
+	std::scoped_lock lock(m_sharedState->mutex);
+	m_sharedState->strings = updatedStrings;
+}
+
+IFACEMETHODIMP AutoCompleteListImpl::Next(ULONG numItems, LPOLESTR *items, ULONG *numItemsFetched)
+{
+	if (!items || (numItems > 1 && !numItemsFetched))
+	{
+		return E_POINTER;
+	}
+
+	ULONG numFetched = 0;
+
+	while (numFetched < numItems && m_index < m_strings->size())
+	{
+		HRESULT hr = SHStrDup((*m_strings)[m_index].c_str(), &items[numFetched]);
+
+		if (FAILED(hr))
+		{
+			for (ULONG i = 0; i < numFetched; i++)
+			{
+				CoTaskMemFree(items[i]);
+				items[i] = nullptr;
+			}
+
+			if (numItemsFetched)
+			{
+				*numItemsFetched = 0;
+			}
+
+			return hr;
+		}
+
+		numFetched++;
+		m_index++;
+	}
+
+	if (numItemsFetched)
+	{
+		*numItemsFetched = numFetched;
+	}
+
+	return (numFetched == numItems) ? S_OK : S_FALSE;
+}
+
+IFACEMETHODIMP AutoCompleteListImpl::Skip(ULONG numItems)
+{
+	m_index += numItems;
+
+	if (m_index > m_strings->size())
+	{
+		m_index = m_strings->size();
+		return S_FALSE;
+	}
+
+	return S_OK;
+}
+
+IFACEMETHODIMP AutoCompleteListImpl::Reset()
+{
+	std::scoped_lock lock(m_sharedState->mutex);
+	m_strings = m_sharedState->strings;
+	m_index = 0;
+	return S_OK;
+}
+
+IFACEMETHODIMP AutoCompleteListImpl::Clone(IEnumString **enumerator)
+{
+	if (!enumerator)
+	{
+		return E_POINTER;
+	}
+
+	auto clone = winrt::make_self<AutoCompleteListImpl>(m_sharedState, m_strings, m_index);
+	*enumerator = clone.detach();
+	return S_OK;
+}
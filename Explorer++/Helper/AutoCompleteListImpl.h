@@ -0,0 +1,52 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "WinRTBaseWrapper.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// A string enumerator that can be used as the source for an autocomplete object (see
+// IAutoComplete::Init()). The autocomplete object enumerates its source on a background thread, so
+// the list of strings is never modified in place. Instead, SetStrings() swaps in a new list, which
+// the enumerator (and any clones of it) will start returning the next time they're reset.
+class AutoCompleteListImpl : public winrt::implements<AutoCompleteListImpl, IEnumString>
+{
+public:
+	using Strings = std::vector<std::wstring>;
+
+	AutoCompleteListImpl();
+
+	// May be called from any thread.
+	void SetStrings(Strings strings);
+
+	// IEnumString
+	IFACEMETHODIMP Next(ULONG numItems, LPOLESTR *items, ULONG *numItemsFetched);
+	IFACEMETHODIMP Skip(ULONG numItems);
+	IFACEMETHODIMP Reset();
+	IFACEMETHODIMP Clone(IEnumString **enumerator);
+
+private:
+	struct SharedState
+	{
+		std::mutex mutex;
+		std::shared_ptr<const Strings> strings;
+	};
+
+public:
+	// Used when cloning an enumerator. The clone shares the list of strings with the original.
+	AutoCompleteListImpl(std::shared_ptr<SharedState> sharedState,
+		std::shared_ptr<const Strings> strings, size_t index);
+
+private:
+	const std::shared_ptr<SharedState> m_sharedState;
+
+	// The list being enumerated. This is only updated when the enumeration is reset, so that the
+	// list can't change part way through an enumeration.
+	std::shared_ptr<const Strings> m_strings;
+	size_t m_index = 0;
+};
@@ -0,0 +1,649 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "CachedFormatter.h"
+#include "Macros.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace
+{
+
+constexpr uint64_t TICKS_PER_SECOND = 10'000'000;
+constexpr uint64_t TICKS_PER_MINUTE = 60 * TICKS_PER_SECOND;
+constexpr uint64_t TICKS_PER_HOUR = 60 * TICKS_PER_MINUTE;
+constexpr uint64_t TICKS_PER_DAY = 24 * TICKS_PER_HOUR;
+
+// Time zone offsets (and the points at which daylight saving time starts and ends) are always
+// aligned to 15 minute intervals, so the offset is constant within each interval.
+constexpr uint64_t BIAS_BUCKET_TICKS = 15 * TICKS_PER_MINUTE;
+
+constexpr const wchar_t *SIZE_STRINGS[] = { L"bytes", L"KB", L"MB", L"GB", L"TB", L"PB" };
+
+uint64_t FileTimeToTicks(const FILETIME &fileTime)
+{
+	return (static_cast<uint64_t>(fileTime.dwHighDateTime) << 32) | fileTime.dwLowDateTime;
+}
+
+FILETIME TicksToFileTime(uint64_t ticks)
+{
+	return { static_cast<DWORD>(ticks & 0xFFFFFFFF), static_cast<DWORD>(ticks >> 32) };
+}
+
+std::wstring GetLocaleString(LCTYPE type)
+{
+	wchar_t value[128];
+	int length = GetLocaleInfoEx(LOCALE_NAME_USER_DEFAULT, type, value, SIZEOF_ARRAY(value));
+
+	if (length == 0)
+	{
+		return {};
+	}
+
+	// The returned length includes the terminating null character.
+	return std::wstring(value, length - 1);
+}
+
+}
+
+class CachedFormatter::BufferWriter
+{
+public:
+	explicit BufferWriter(std::span<wchar_t> buffer) : m_buffer(buffer)
+	{
+	}
+
+	void Append(wchar_t character)
+	{
+		if (m_length < m_buffer.size())
+		{
+			m_buffer[m_length] = character;
+		}
+
+		m_length++;
+	}
+
+	void Append(std::wstring_view text)
+	{
+		for (wchar_t character : text)
+		{
+			Append(character);
+		}
+	}
+
+	void AppendNumber(int number, int minWidth)
+	{
+		wchar_t digits[16];
+		int numDigits = 0;
+
+		do
+		{
+			digits[numDigits++] = static_cast<wchar_t>(L'0' + (number % 10));
+			number /= 10;
+		} while (number > 0);
+
+		for (int i = numDigits; i < minWidth; i++)
+		{
+			Append(L'0');
+		}
+
+		while (numDigits > 0)
+		{
+			Append(digits[--numDigits]);
+		}
+	}
+
+	// Null terminates the output and returns its length, or returns 0 if the output didn't fit.
+	size_t Finish()
+	{
+		if (m_length == 0 || m_length >= m_buffer.size())
+		{
+			if (!m_buffer.empty())
+			{
+				m_buffer[0] = L'\0';
+			}
+
+			return 0;
+		}
+
+		m_buffer[m_length] = L'\0';
+		return m_length;
+	}
+
+private:
+	const std::span<wchar_t> m_buffer;
+	size_t m_length = 0;
+};
+
+CachedFormatter::CachedFormatter() :
+	m_localeGeneration(s_localeGeneration.load(std::memory_order_acquire)),
+	m_biasCache(BIAS_CACHE_SIZE),
+	m_dateCache(DATE_CACHE_SIZE)
+{
+	LoadLocaleData();
+}
+
+CachedFormatter &CachedFormatter::GetForCurrentThread()
+{
+	static thread_local CachedFormatter formatter;
+	return formatter;
+}
+
+void CachedFormatter::InvalidateAll()
+{
+	s_localeGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void CachedFormatter::RefreshIfInvalidated()
+{
+	uint32_t currentGeneration = s_localeGeneration.load(std::memory_order_acquire);
+
+	if (currentGeneration == m_localeGeneration)
+	{
+		return;
+	}
+
+	m_localeGeneration = currentGeneration;
+
+	std::fill(m_biasCache.begin(), m_biasCache.end(), BiasCacheEntry());
+
+	for (auto &entry : m_dateCache)
+	{
+		entry.day = -1;
+	}
+
+	LoadLocaleData();
+}
+
+void CachedFormatter::LoadLocaleData()
+{
+	m_timeFormatParsed = ParseTimeFormat(GetLocaleString(LOCALE_STIMEFORMAT));
+	m_amDesignator = GetLocaleString(LOCALE_S1159);
+	m_pmDesignator = GetLocaleString(LOCALE_S2359);
+	m_decimalSeparator = GetLocaleString(LOCALE_SDECIMAL);
+	m_thousandSeparator = GetLocaleString(LOCALE_STHOUSAND);
+
+	// The grouping is given as a list of group sizes, starting from the decimal point (e.g.
+	// "3;2;0"). A trailing 0 indicates that the last group size is repeated.
+	m_grouping.clear();
+	m_repeatLastGroup = false;
+
+	for (wchar_t character : GetLocaleString(LOCALE_SGROUPING))
+	{
+		if (character >= L'0' && character <= L'9')
+		{
+			m_grouping.push_back(character - L'0');
+		}
+	}
+
+	if (!m_grouping.empty() && m_grouping.back() == 0)
+	{
+		m_grouping.pop_back();
+		m_repeatLastGroup = true;
+	}
+}
+
+// Parses the time format pattern into a set of tokens that can be rendered without calling
+// GetTimeFormat(). Returns false if the pattern contains anything that isn't understood here, in
+// which case each time will be formatted by GetTimeFormat() instead.
+bool CachedFormatter::ParseTimeFormat(std::wstring_view timeFormat)
+{
+	m_timeFormatTokens.clear();
+
+	if (timeFormat.empty())
+	{
+		return false;
+	}
+
+	auto appendLiteral = [this](wchar_t character)
+	{
+		if (m_timeFormatTokens.empty() || m_timeFormatTokens.back().field != TimeField::Literal)
+		{
+			m_timeFormatTokens.push_back({ TimeField::Literal });
+		}
+
+		m_timeFormatTokens.back().literal += character;
+	};
+
+	size_t index = 0;
+
+	while (index < timeFormat.size())
+	{
+		wchar_t character = timeFormat[index];
+
+		if (character == L'\'')
+		{
+			index++;
+
+			while (true)
+			{
+				if (index >= timeFormat.size())
+				{
+					// Unterminated quoted string.
+					return false;
+				}
+
+				if (timeFormat[index] == L'\'')
+				{
+					// Two consecutive quotes represent a literal quote.
+					if (index + 1 < timeFormat.size() && timeFormat[index + 1] == L'\'')
+					{
+						appendLiteral(L'\'');
+						index += 2;
+						continue;
+					}
+
+					index++;
+					break;
+				}
+
+				appendLiteral(timeFormat[index]);
+				index++;
+			}
+
+			continue;
+		}
+
+		std::optional<TimeField> field;
+
+		switch (character)
+		{
+		case L'h':
+			field = TimeField::Hour12;
+			break;
+
+		case L'H':
+			field = TimeField::Hour24;
+			break;
+
+		case L'm':
+			field = TimeField::Minute;
+			break;
+
+		case L's':
+			field = TimeField::Second;
+			break;
+
+		case L't':
+			field = TimeField::Marker;
+			break;
+		}
+
+		if (!field)
+		{
+			if ((character >= L'a' && character <= L'z')
+				|| (character >= L'A' && character <= L'Z'))
+			{
+				return false;
+			}
+
+			appendLiteral(character);
+			index++;
+			continue;
+		}
+
+		int width = 0;
+
+		while (index < timeFormat.size() && timeFormat[index] == character)
+		{
+			width++;
+			index++;
+		}
+
+		if (width > 2)
+		{
+			return false;
+		}
+
+		m_timeFormatTokens.push_back({ *field, width });
+	}
+
+	return true;
+}
+
+size_t CachedFormatter::FormatFileTime(const FILETIME &utcFileTime, bool friendlyDate,
+	std::span<wchar_t> buffer)
+{
+	RefreshIfInvalidated();
+
+	BufferWriter writer(buffer);
+
+	auto localTicks = GetLocalTicks(FileTimeToTicks(utcFileTime));
+
+	if (!localTicks)
+	{
+		return writer.Finish();
+	}
+
+	int64_t day = *localTicks / TICKS_PER_DAY;
+
+	if (friendlyDate)
+	{
+		FILETIME now;
+		GetSystemTimeAsFileTime(&now);
+		auto localNow = GetLocalTicks(FileTimeToTicks(now));
+
+		if (localNow)
+		{
+			int64_t today = *localNow / TICKS_PER_DAY;
+
+			if (day == today || day == today - 1)
+			{
+				writer.Append(day == today ? L"Today" : L"Yesterday");
+				writer.Append(L", ");
+				WriteTime(*localTicks, writer);
+				return writer.Finish();
+			}
+		}
+	}
+
+	auto dateText = GetDateText(*localTicks);
+
+	if (!dateText)
+	{
+		return writer.Finish();
+	}
+
+	writer.Append(*dateText);
+	writer.Append(L' ');
+	WriteTime(*localTicks, writer);
+	return writer.Finish();
+}
+
+std::optional<int64_t> CachedFormatter::GetLocalTicks(uint64_t utcTicks)
+{
+	// FileTimeToSystemTime() rejects any value that has the high bit set.
+	if (utcTicks > static_cast<uint64_t>(INT64_MAX))
+	{
+		return std::nullopt;
+	}
+
+	uint64_t bucket = utcTicks / BIAS_BUCKET_TICKS;
+	auto &entry = m_biasCache[bucket % m_biasCache.size()];
+
+	if (entry.bucket != bucket)
+	{
+		FILETIME bucketStart = TicksToFileTime(bucket * BIAS_BUCKET_TICKS);
+		SYSTEMTIME utcSystemTime;
+		SYSTEMTIME localSystemTime;
+		FILETIME localFileTime;
+
+		if (!FileTimeToSystemTime(&bucketStart, &utcSystemTime)
+			|| !SystemTimeToTzSpecificLocalTime(nullptr, &utcSystemTime, &localSystemTime)
+			|| !SystemTimeToFileTime(&localSystemTime, &localFileTime))
+		{
+			return std::nullopt;
+		}
+
+		entry.bucket = bucket;
+		entry.biasTicks = static_cast<int64_t>(FileTimeToTicks(localFileTime))
+			- static_cast<int64_t>(bucket * BIAS_BUCKET_TICKS);
+	}
+
+	int64_t localTicks = static_cast<int64_t>(utcTicks) + entry.biasTicks;
+
+	if (localTicks < 0)
+	{
+		return std::nullopt;
+	}
+
+	return localTicks;
+}
+
+std::optional<std::wstring_view> CachedFormatter::GetDateText(int64_t localTicks)
+{
+	int64_t day = localTicks / TICKS_PER_DAY;
+	auto &entry = m_dateCache[static_cast<size_t>(day) % m_dateCache.size()];
+
+	if (entry.day != day)
+	{
+		FILETIME localFileTime = TicksToFileTime(localTicks);
+		SYSTEMTIME localSystemTime;
+
+		if (!FileTimeToSystemTime(&localFileTime, &localSystemTime))
+		{
+			return std::nullopt;
+		}
+
+		int length = GetDateFormat(LOCALE_USER_DEFAULT, LOCALE_USE_CP_ACP, &localSystemTime,
+			nullptr, entry.text, SIZEOF_ARRAY(entry.text));
+
+		if (length == 0)
+		{
+			entry.day = -1;
+			return std::nullopt;
+		}
+
+		entry.day = day;
+		entry.length = length - 1;
+	}
+
+	return std::wstring_view(entry.text, entry.length);
+}
+
+void CachedFormatter::WriteTime(int64_t localTicks, BufferWriter &writer)
+{
+	if (!m_timeFormatParsed)
+	{
+		FILETIME localFileTime = TicksToFileTime(localTicks);
+		SYSTEMTIME localSystemTime;
+		wchar_t timeText[128];
+
+		if (!FileTimeToSystemTime(&localFileTime, &localSystemTime))
+		{
+			return;
+		}
+
+		int length = GetTimeFormat(LOCALE_USER_DEFAULT, LOCALE_USE_CP_ACP, &localSystemTime,
+			nullptr, timeText, SIZEOF_ARRAY(timeText));
+
+		if (length != 0)
+		{
+			writer.Append(std::wstring_view(timeText, length - 1));
+		}
+
+		return;
+	}
+
+	uint64_t timeOfDay = static_cast<uint64_t>(localTicks) % TICKS_PER_DAY;
+	int hour = static_cast<int>(timeOfDay / TICKS_PER_HOUR);
+	int minute = static_cast<int>((timeOfDay % TICKS_PER_HOUR) / TICKS_PER_MINUTE);
+	int second = static_cast<int>((timeOfDay % TICKS_PER_MINUTE) / TICKS_PER_SECOND);
+	const std::wstring &designator = (hour < 12) ? m_amDesignator : m_pmDesignator;
+
+	for (const auto &token : m_timeFormatTokens)
+	{
+		switch (token.field)
+		{
+		case TimeField::Literal:
+			writer.Append(token.literal);
+			break;
+
+		case TimeField::Hour12:
+			writer.AppendNumber((hour % 12 == 0) ? 12 : hour % 12, token.width);
+			break;
+
+		case TimeField::Hour24:
+			writer.AppendNumber(hour, token.width);
+			break;
+
+		case TimeField::Minute:
+			writer.AppendNumber(minute, token.width);
+			break;
+
+		case TimeField::Second:
+			writer.AppendNumber(second, token.width);
+			break;
+
+		case TimeField::Marker:
+			if (token.width == 1)
+			{
+				if (!designator.empty())
+				{
+					writer.Append(designator[0]);
+				}
+			}
+			else
+			{
+				writer.Append(designator);
+			}
+			break;
+		}
+	}
+}
+
+size_t CachedFormatter::FormatSize(uint64_t size, SizeDisplayFormat sizeDisplayFormat,
+	std::span<wchar_t> buffer)
+{
+	RefreshIfInvalidated();
+
+	BufferWriter writer(buffer);
+
+	// The calculation here mirrors FormatSizeString(), so that the two produce exactly the same
+	// text.
+	auto sizeAsDouble = static_cast<double>(size);
+	int sizeIndex = 0;
+
+	if (sizeDisplayFormat != +SizeDisplayFormat::None)
+	{
+		switch (sizeDisplayFormat)
+		{
+		case SizeDisplayFormat::Bytes:
+			sizeIndex = 0;
+			break;
+
+		case SizeDisplayFormat::KB:
+			sizeIndex = 1;
+			break;
+
+		case SizeDisplayFormat::MB:
+			sizeIndex = 2;
+			break;
+
+		case SizeDisplayFormat::GB:
+			sizeIndex = 3;
+			break;
+
+		case SizeDisplayFormat::TB:
+			sizeIndex = 4;
+			break;
+
+		case SizeDisplayFormat::PB:
+			sizeIndex = 5;
+			break;
+		}
+
+		for (int i = 0; i < sizeIndex; i++)
+		{
+			sizeAsDouble /= 1024;
+		}
+	}
+	else
+	{
+		while ((sizeAsDouble / 1024) >= 1)
+		{
+			sizeAsDouble /= 1024;
+			sizeIndex++;
+		}
+
+		if (sizeIndex >= static_cast<int>(std::size(SIZE_STRINGS)))
+		{
+			return writer.Finish();
+		}
+	}
+
+	int precision;
+
+	if (sizeIndex == 0)
+	{
+		precision = 0;
+	}
+	else if (sizeAsDouble < 10)
+	{
+		precision = 2;
+	}
+	else if (sizeAsDouble < 100)
+	{
+		precision = 1;
+	}
+	else
+	{
+		precision = 0;
+	}
+
+	// The value is truncated, rather than rounded, to the displayed precision.
+	int least = static_cast<int>(
+		(sizeAsDouble - static_cast<int>(sizeAsDouble)) * pow(10.0, precision + 1));
+
+	if (least >= 5)
+	{
+		sizeAsDouble -= 5.0 * pow(10.0, -(precision + 1));
+	}
+
+	char digits[64];
+	auto [numberEnd, error] = std::to_chars(std::begin(digits), std::end(digits), sizeAsDouble,
+		std::chars_format::fixed, precision);
+
+	if (error != std::errc())
+	{
+		return writer.Finish();
+	}
+
+	std::string_view number(digits, numberEnd - digits);
+	auto decimalPointPosition = number.find('.');
+
+	WriteGroupedNumber(number.substr(0, decimalPointPosition), writer);
+
+	if (decimalPointPosition != std::string_view::npos)
+	{
+		writer.Append(m_decimalSeparator);
+
+		for (char digit : number.substr(decimalPointPosition + 1))
+		{
+			writer.Append(static_cast<wchar_t>(digit));
+		}
+	}
+
+	writer.Append(L' ');
+	writer.Append(SIZE_STRINGS[sizeIndex]);
+	return writer.Finish();
+}
+
+void CachedFormatter::WriteGroupedNumber(std::string_view digits, BufferWriter &writer) const
+{
+	// Determine where each separator goes, working back from the least significant digit.
+	bool separatorBefore[64] = {};
+	size_t remaining = digits.size();
+	size_t groupIndex = 0;
+
+	while (groupIndex < m_grouping.size())
+	{
+		auto groupSize = static_cast<size_t>(m_grouping[groupIndex]);
+
+		if (groupSize == 0 || remaining <= groupSize)
+		{
+			break;
+		}
+
+		remaining -= groupSize;
+		separatorBefore[remaining] = true;
+
+		if (groupIndex + 1 < m_grouping.size() || !m_repeatLastGroup)
+		{
+			groupIndex++;
+		}
+	}
+
+	for (size_t i = 0; i < digits.size(); i++)
+	{
+		if (separatorBefore[i])
+		{
+			writer.Append(m_thousandSeparator);
+		}
+
+		writer.Append(static_cast<wchar_t>(digits[i]));
+	}
+}
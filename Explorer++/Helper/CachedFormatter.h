@@ -0,0 +1,110 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "StringHelper.h"
+#include <boost/core/noncopyable.hpp>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Formats file times and file sizes for display. The text produced is the same as that produced by
+// CreateFileTimeString() and FormatSizeString(), but most of the work those functions do for each
+// call is the same from one call to the next:
+//
+// - The locale data (the time format pattern, AM/PM designators and number separators) is read
+//   once and then reused until InvalidateAll() is called.
+// - The offset between UTC and local time is cached per 15 minute interval.
+// - The date portion of a formatted time is cached per calendar day, since a folder will typically
+//   contain many items that were modified on the same day.
+//
+// Output is written directly into a caller-provided buffer, so formatting a value doesn't allocate.
+//
+// Instances aren't thread-safe. GetForCurrentThread() returns an instance that's only used by the
+// calling thread.
+class CachedFormatter : private boost::noncopyable
+{
+public:
+	CachedFormatter();
+
+	static CachedFormatter &GetForCurrentThread();
+
+	// Should be called whenever the regional settings or time zone may have changed. The cached
+	// data in every instance will be rebuilt the next time that instance is used.
+	static void InvalidateAll();
+
+	// Each of these methods returns the number of characters written (not including the
+	// terminating null character). If the value can't be formatted, or the buffer isn't large
+	// enough, 0 will be returned.
+	size_t FormatFileTime(const FILETIME &utcFileTime, bool friendlyDate,
+		std::span<wchar_t> buffer);
+	size_t FormatSize(uint64_t size, SizeDisplayFormat sizeDisplayFormat,
+		std::span<wchar_t> buffer);
+
+private:
+	static constexpr size_t BIAS_CACHE_SIZE = 64;
+	static constexpr size_t DATE_CACHE_SIZE = 256;
+	static constexpr size_t MAX_CACHED_DATE_LENGTH = 80;
+
+	enum class TimeField
+	{
+		Literal,
+		Hour12,
+		Hour24,
+		Minute,
+		Second,
+		Marker
+	};
+
+	struct TimeFormatToken
+	{
+		TimeField field;
+		int width = 0;
+		std::wstring literal;
+	};
+
+	struct BiasCacheEntry
+	{
+		uint64_t bucket = UINT64_MAX;
+		int64_t biasTicks = 0;
+	};
+
+	struct DateCacheEntry
+	{
+		int64_t day = -1;
+		size_t length = 0;
+		wchar_t text[MAX_CACHED_DATE_LENGTH];
+	};
+
+	class BufferWriter;
+
+	void RefreshIfInvalidated();
+	void LoadLocaleData();
+	bool ParseTimeFormat(std::wstring_view timeFormat);
+
+	std::optional<int64_t> GetLocalTicks(uint64_t utcTicks);
+	std::optional<std::wstring_view> GetDateText(int64_t localTicks);
+	void WriteTime(int64_t localTicks, BufferWriter &writer);
+	void WriteGroupedNumber(std::string_view digits, BufferWriter &writer) const;
+
+	static inline std::atomic<uint32_t> s_localeGeneration = 0;
+	uint32_t m_localeGeneration;
+
+	bool m_timeFormatParsed = false;
+	std::vector<TimeFormatToken> m_timeFormatTokens;
+	std::wstring m_amDesignator;
+	std::wstring m_pmDesignator;
+	std::wstring m_decimalSeparator;
+	std::wstring m_thousandSeparator;
+	std::vector<int> m_grouping;
+	bool m_repeatLastGroup = false;
+
+	std::vector<BiasCacheEntry> m_biasCache;
+	std::vector<DateCacheEntry> m_dateCache;
+};
@@ -4,6 +4,7 @@
 
 #include "stdafx.h"
 #include "CachedIcons.h"
+#include "PerformanceTracer.h"
 
 CachedIcons::CachedIcons(std::size_t maxItems) : m_maxItems(maxItems)
 {
@@ -17,7 +18,10 @@ CachedIcons::iterator CachedIcons::end()
 
 void CachedIcons::addOrUpdateFileIcon(const std::wstring &filePath, int iconIndex)
 {
-	auto cachedItr = findByPath(filePath);
+	// The index is queried directly here, so that this lookup isn't counted as a cache hit or
+	// miss.
+	CachedIconSetByPath &pathIndex = m_cachedIconSet.get<1>();
+	auto cachedItr = pathIndex.find(filePath);
 
 	if (cachedItr != end())
 	{
@@ -60,5 +64,9 @@ void CachedIcons::replace(CachedIconSetByPath::iterator itr, const CachedIcon &c
 CachedIcons::iterator CachedIcons::findByPath(const std::wstring &filePath)
 {
 	CachedIconSetByPath &pathIndex = m_cachedIconSet.get<1>();
-	return pathIndex.find(filePath);
+	auto itr = pathIndex.find(filePath);
+
+	TraceCounterAdjust("CachedIcons", (itr != pathIndex.end()) ? "Hits" : "Misses", 1);
+
+	return itr;
 }
@@ -6,13 +6,23 @@
 #include "FolderSize.h"
 #include <filesystem>
 
-FolderInfo GetFolderInfo(const std::wstring &path)
+namespace
+{
+
+bool AddFolderInfo(const std::wstring &path, FolderInfo &folderInfo,
+	const FolderInfoProgressCallback &progressCallback)
 {
-	FolderInfo folderInfo = {};
 	std::error_code error;
 
 	for (const auto &entry : std::filesystem::directory_iterator(path, error))
 	{
+		// This is checked for every entry, rather than once per folder, so that a calculation can
+		// be stopped promptly even when a single folder contains a large number of items.
+		if (!progressCallback(folderInfo))
+		{
+			return false;
+		}
+
 		std::error_code typeErrorCode;
 		auto isDirectory = entry.is_directory(typeErrorCode);
 
@@ -25,11 +35,10 @@ FolderInfo GetFolderInfo(const std::wstring &path)
 		{
 			folderInfo.numFolders++;
 
-			FolderInfo subFolderInfo = GetFolderInfo(entry.path());
-
-			folderInfo.size += subFolderInfo.size;
-			folderInfo.numFolders += subFolderInfo.numFolders;
-			folderInfo.numFiles += subFolderInfo.numFiles;
+			if (!AddFolderInfo(entry.path(), folderInfo, progressCallback))
+			{
+				return false;
+			}
 		}
 		else
 		{
@@ -46,21 +55,26 @@ FolderInfo GetFolderInfo(const std::wstring &path)
 		}
 	}
 
-	return folderInfo;
+	return true;
 }
 
-DWORD WINAPI Thread_CalculateFolderSize(LPVOID lpParameter)
-{
-	FolderSize_t *pFolderSize = reinterpret_cast<FolderSize_t *>(lpParameter);
-
-	auto folderInfo = GetFolderInfo(pFolderSize->szPath);
+}
 
-	ULARGE_INTEGER size;
-	size.QuadPart = folderInfo.size;
+FolderInfo GetFolderInfo(const std::wstring &path)
+{
+	auto folderInfo = GetFolderInfo(path, [](const FolderInfo &) { return true; });
+	return *folderInfo;
+}
 
-	pFolderSize->pfnCallback(folderInfo.numFolders, folderInfo.numFiles, &size, pFolderSize->pData);
+std::optional<FolderInfo> GetFolderInfo(const std::wstring &path,
+	FolderInfoProgressCallback progressCallback)
+{
+	FolderInfo folderInfo = {};
 
-	free(pFolderSize);
+	if (!AddFolderInfo(path, folderInfo, progressCallback))
+	{
+		return std::nullopt;
+	}
 
-	return 1;
+	return folderInfo;
 }
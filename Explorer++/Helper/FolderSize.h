@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <functional>
+#include <optional>
+#include <string>
+
 struct FolderInfo
 {
 	std::uintmax_t size;
@@ -11,13 +15,12 @@ struct FolderInfo
 	int numFiles;
 };
 
-FolderInfo GetFolderInfo(const std::wstring &path);
+// Invoked before each item is processed, with the totals so far. Returning false will stop the
+// calculation.
+using FolderInfoProgressCallback = std::function<bool(const FolderInfo &runningTotal)>;
 
-typedef struct
-{
-	TCHAR szPath[MAX_PATH];
-	LPVOID pData;
-	void (*pfnCallback)(int nFolders, int nFiles, PULARGE_INTEGER lTotalFolderSize, LPVOID pData);
-} FolderSize_t;
+FolderInfo GetFolderInfo(const std::wstring &path);
 
-DWORD WINAPI Thread_CalculateFolderSize(LPVOID lpParameter);
+// Returns std::nullopt if the calculation was stopped by the progress callback.
+std::optional<FolderInfo> GetFolderInfo(const std::wstring &path,
+	FolderInfoProgressCallback progressCallback);
@@ -14,6 +14,7 @@
 #include <wil/resource.h>
 #include <WbemIdl.h>
 #include <comutil.h>
+#include <format>
 
 // Required for CLSID_WbemLocator.
 #pragma comment(lib, "wbemuuid.lib")
@@ -350,76 +351,94 @@ DWORD GetNumFileHardLinks(const TCHAR *lpszFileName)
 
 BOOL ReadImageProperty(const TCHAR *lpszImage, PROPID propId, TCHAR *szProperty, int cchMax)
 {
+	auto properties = ReadImageProperties(lpszImage, { propId });
+
+	if (!properties[0])
+	{
+		return FALSE;
+	}
+
+	return SUCCEEDED(StringCchCopy(szProperty, cchMax, properties[0]->c_str()));
+}
+
+std::vector<std::optional<std::wstring>> ReadImageProperties(const TCHAR *image,
+	const std::vector<PROPID> &propIds)
+{
+	std::vector<std::optional<std::wstring>> properties(propIds.size());
+
 	Gdiplus::GdiplusStartupInput gdiplusStartupInput;
 	ULONG_PTR token;
 	Gdiplus::Status status = GdiplusStartup(&token, &gdiplusStartupInput, nullptr);
 
 	if (status != Gdiplus::Ok)
 	{
-		return FALSE;
+		return properties;
 	}
 
-	BOOL bSuccess = FALSE;
+	auto shutdown = wil::scope_exit([token] { Gdiplus::GdiplusShutdown(token); });
+
+	// The image needs to be destroyed before GdiplusShutdown is called, which the declaration
+	// order here guarantees.
+	Gdiplus::Image gdiplusImage(image, FALSE);
 
-	/* This object needs to be
-	deleted before GdiplusShutdown
-	is called. If it were stack
-	allocated, it would go out of
-	scope _after_ the call to
-	GdiplusShutdown. By allocating
-	it on the heap, the lifetime
-	can be directly controlled. */
-	auto *image = new Gdiplus::Image(lpszImage, FALSE);
+	if (gdiplusImage.GetLastStatus() != Gdiplus::Ok)
+	{
+		return properties;
+	}
 
-	if (image->GetLastStatus() == Gdiplus::Ok)
+	for (size_t i = 0; i < propIds.size(); i++)
 	{
+		PROPID propId = propIds[i];
+
 		if (propId == PropertyTagImageWidth)
 		{
-			bSuccess = TRUE;
-			StringCchPrintf(szProperty, cchMax, _T("%u pixels"), image->GetWidth());
+			properties[i] = std::format(L"{} pixels", gdiplusImage.GetWidth());
+			continue;
 		}
 		else if (propId == PropertyTagImageHeight)
 		{
-			bSuccess = TRUE;
-			StringCchPrintf(szProperty, cchMax, _T("%u pixels"), image->GetHeight());
+			properties[i] = std::format(L"{} pixels", gdiplusImage.GetHeight());
+			continue;
 		}
-		else
+
+		UINT size = gdiplusImage.GetPropertyItemSize(propId);
+
+		if (size == 0)
 		{
-			UINT size = image->GetPropertyItemSize(propId);
+			continue;
+		}
 
-			if (size != 0)
-			{
-				auto *propertyItem = reinterpret_cast<Gdiplus::PropertyItem *>(malloc(size));
+		std::vector<std::byte> buffer(size);
+		auto *propertyItem = reinterpret_cast<Gdiplus::PropertyItem *>(buffer.data());
+		status = gdiplusImage.GetPropertyItem(propId, size, propertyItem);
 
-				if (propertyItem != nullptr)
-				{
-					status = image->GetPropertyItem(propId, size, propertyItem);
+		if (status != Gdiplus::Ok || propertyItem->type != PropertyTagTypeASCII)
+		{
+			continue;
+		}
 
-					if (status == Gdiplus::Ok)
-					{
-						if (propertyItem->type == PropertyTagTypeASCII)
-						{
-							int iRes = MultiByteToWideChar(CP_ACP, 0,
-								reinterpret_cast<LPCSTR>(propertyItem->value), -1, szProperty,
-								cchMax);
-
-							if (iRes != 0)
-							{
-								bSuccess = TRUE;
-							}
-						}
-					}
+		auto *value = reinterpret_cast<LPCSTR>(propertyItem->value);
+		int length = MultiByteToWideChar(CP_ACP, 0, value, -1, nullptr, 0);
 
-					free(propertyItem);
-				}
-			}
+		if (length == 0)
+		{
+			continue;
 		}
-	}
 
-	delete image;
-	Gdiplus::GdiplusShutdown(token);
+		std::wstring convertedValue(length, '\0');
+		length = MultiByteToWideChar(CP_ACP, 0, value, -1, convertedValue.data(), length);
 
-	return bSuccess;
+		if (length == 0)
+		{
+			continue;
+		}
+
+		// The converted length includes the terminating null character.
+		convertedValue.resize(length - 1);
+		properties[i] = std::move(convertedValue);
+	}
+
+	return properties;
 }
 
 BOOL GetFileNameFromUser(HWND hwnd, TCHAR *fullFileName, UINT cchMax, const TCHAR *initialDirectory)
@@ -653,66 +672,97 @@ HRESULT GetCPUBrandString(std::wstring &cpuBrand)
 
 HRESULT GetMediaMetadata(const TCHAR *szFileName, const TCHAR *szAttribute, BYTE **pszOutput)
 {
-	typedef HRESULT(WINAPI * WMCREATEEDITOR_PROC)(IWMMetadataEditor **);
-	WMCREATEEDITOR_PROC pWMCreateEditor = nullptr;
-	HMODULE hWMVCore;
-	IWMMetadataEditor *pEditor = nullptr;
-	IWMHeaderInfo *pWMHeaderInfo = nullptr;
-	HRESULT hr = E_FAIL;
+	auto attributes = GetMediaMetadataAttributes(szFileName, { szAttribute });
+
+	if (!attributes[0])
+	{
+		return E_FAIL;
+	}
+
+	*pszOutput = static_cast<BYTE *>(malloc(attributes[0]->size()));
+
+	if (!*pszOutput)
+	{
+		return E_OUTOFMEMORY;
+	}
+
+	memcpy(*pszOutput, attributes[0]->data(), attributes[0]->size());
+
+	return S_OK;
+}
+
+std::vector<std::optional<std::vector<BYTE>>> GetMediaMetadataAttributes(const TCHAR *fileName,
+	const std::vector<const TCHAR *> &attributeNames)
+{
+	std::vector<std::optional<std::vector<BYTE>>> attributes(attributeNames.size());
 
-	hWMVCore = LoadLibrary(_T("wmvcore.dll"));
+	wil::unique_hmodule wmvCore(LoadLibrary(_T("wmvcore.dll")));
 
-	if (hWMVCore != nullptr)
+	if (!wmvCore)
 	{
-		pWMCreateEditor = (WMCREATEEDITOR_PROC) GetProcAddress(hWMVCore, "WMCreateEditor");
+		return attributes;
+	}
 
-		if (pWMCreateEditor != nullptr)
-		{
-			hr = pWMCreateEditor(&pEditor);
+	using WMCreateEditorType = HRESULT(WINAPI *)(IWMMetadataEditor **);
+	auto wmCreateEditor =
+		reinterpret_cast<WMCreateEditorType>(GetProcAddress(wmvCore.get(), "WMCreateEditor"));
 
-			if (SUCCEEDED(hr))
-			{
-				hr = pEditor->Open(szFileName);
+	if (!wmCreateEditor)
+	{
+		return attributes;
+	}
 
-				if (SUCCEEDED(hr))
-				{
-					hr = pEditor->QueryInterface(IID_PPV_ARGS(&pWMHeaderInfo));
+	wil::com_ptr_nothrow<IWMMetadataEditor> editor;
+	HRESULT hr = wmCreateEditor(&editor);
 
-					if (SUCCEEDED(hr))
-					{
-						WORD wStreamNum;
-						WMT_ATTR_DATATYPE type;
-						WORD cbLength;
+	if (FAILED(hr))
+	{
+		return attributes;
+	}
 
-						/* Any stream. Should be zero for MP3 files. */
-						wStreamNum = 0;
+	hr = editor->Open(fileName);
 
-						hr = pWMHeaderInfo->GetAttributeByName(&wStreamNum, szAttribute, &type,
-							nullptr, &cbLength);
+	if (FAILED(hr))
+	{
+		return attributes;
+	}
 
-						if (SUCCEEDED(hr))
-						{
-							*pszOutput = (BYTE *) malloc(cbLength);
+	auto closeEditor = wil::scope_exit([&editor] { editor->Close(); });
 
-							if (*pszOutput != nullptr)
-							{
-								hr = pWMHeaderInfo->GetAttributeByName(&wStreamNum, szAttribute,
-									&type, *pszOutput, &cbLength);
-							}
-						}
+	auto headerInfo = editor.try_query<IWMHeaderInfo>();
 
-						pWMHeaderInfo->Release();
-					}
-				}
+	if (!headerInfo)
+	{
+		return attributes;
+	}
 
-				pEditor->Release();
-			}
+	for (size_t i = 0; i < attributeNames.size(); i++)
+	{
+		/* Any stream. Should be zero for MP3 files. */
+		WORD streamNum = 0;
+		WMT_ATTR_DATATYPE type;
+		WORD length;
+		hr = headerInfo->GetAttributeByName(&streamNum, attributeNames[i], &type, nullptr,
+			&length);
+
+		if (FAILED(hr))
+		{
+			continue;
+		}
+
+		std::vector<BYTE> value(length);
+		hr = headerInfo->GetAttributeByName(&streamNum, attributeNames[i], &type, value.data(),
+			&length);
+
+		if (FAILED(hr))
+		{
+			continue;
 		}
 
-		FreeLibrary(hWMVCore);
+		attributes[i] = std::move(value);
 	}
 
-	return hr;
+	return attributes;
 }
 
 void SetFORMATETC(FORMATETC *pftc, CLIPFORMAT cfFormat, DVTARGETDEVICE *ptd, DWORD dwAspect,
@@ -8,6 +8,7 @@
 #include <windows.h>
 #include <optional>
 #include <string>
+#include <vector>
 
 struct LangAndCodePage
 {
@@ -37,6 +38,14 @@ BOOL GetFileOwner(const TCHAR *szFile, TCHAR *szOwner, size_t cchMax);
 DWORD GetNumFileHardLinks(const TCHAR *lpszFileName);
 BOOL ReadImageProperty(const TCHAR *lpszImage, PROPID propId, TCHAR *szProperty, int cchMax);
 HRESULT GetMediaMetadata(const TCHAR *szFileName, const TCHAR *szAttribute, BYTE **pszOutput);
+
+// Each of these functions reads a set of values from a file in one go, so the file only has to be
+// opened (and, in the case of an image, decoded) once. The returned vector contains an entry for
+// each requested value, in the same order. An entry is empty if that value couldn't be read.
+std::vector<std::optional<std::wstring>> ReadImageProperties(const TCHAR *image,
+	const std::vector<PROPID> &propIds);
+std::vector<std::optional<std::vector<BYTE>>> GetMediaMetadataAttributes(const TCHAR *fileName,
+	const std::vector<const TCHAR *> &attributeNames);
 BOOL IsImage(const TCHAR *fileName);
 BOOL GetFileProductVersion(const TCHAR *szFullFileName, DWORD *pdwProductVersionLS,
 	DWORD *pdwProductVersionMS);
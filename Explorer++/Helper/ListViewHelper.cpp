@@ -5,6 +5,7 @@
 #include "stdafx.h"
 #include "ListViewHelper.h"
 #include "Macros.h"
+#include <algorithm>
 
 namespace
 {
@@ -430,4 +431,76 @@ std::optional<int> GetLastSelectedItemIndex(HWND listView)
 	return lastItemIndex;
 }
 
+ScrollPosition GetScrollPosition(HWND listView)
+{
+	ScrollPosition scrollPosition;
+	DWORD view = ListView_GetView(listView);
+
+	if (view == LV_VIEW_DETAILS || view == LV_VIEW_LIST)
+	{
+		scrollPosition.topIndex = ListView_GetTopIndex(listView);
+	}
+	else
+	{
+		ListView_GetOrigin(listView, &scrollPosition.origin);
+	}
+
+	return scrollPosition;
+}
+
+void SetScrollPosition(HWND listView, const ScrollPosition &scrollPosition)
+{
+	int numItems = ListView_GetItemCount(listView);
+
+	if (numItems == 0)
+	{
+		return;
+	}
+
+	DWORD view = ListView_GetView(listView);
+
+	if (view == LV_VIEW_DETAILS || view == LV_VIEW_LIST)
+	{
+		int targetIndex = (std::min)(scrollPosition.topIndex, numItems - 1);
+		int currentIndex = ListView_GetTopIndex(listView);
+
+		RECT targetRect;
+		RECT currentRect;
+
+		if (!ListView_GetItemRect(listView, targetIndex, &targetRect, LVIR_BOUNDS)
+			|| !ListView_GetItemRect(listView, currentIndex, &currentRect, LVIR_BOUNDS))
+		{
+			return;
+		}
+
+		if (view == LV_VIEW_DETAILS)
+		{
+			ListView_Scroll(listView, 0, targetRect.top - currentRect.top);
+		}
+		else
+		{
+			// In list view, the horizontal scroll amount is specified in columns, rather than
+			// pixels.
+			int columnWidth = currentRect.right - currentRect.left;
+
+			if (columnWidth > 0)
+			{
+				ListView_Scroll(listView, (targetRect.left - currentRect.left) / columnWidth, 0);
+			}
+		}
+	}
+	else
+	{
+		POINT currentOrigin;
+
+		if (!ListView_GetOrigin(listView, &currentOrigin))
+		{
+			return;
+		}
+
+		ListView_Scroll(listView, scrollPosition.origin.x - currentOrigin.x,
+			scrollPosition.origin.y - currentOrigin.y);
+	}
+}
+
 }
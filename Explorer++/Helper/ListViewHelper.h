@@ -9,6 +9,14 @@
 namespace ListViewHelper
 {
 
+// The scroll position of a listview. Which member is used depends on the view: the first visible
+// item is used in details and list view, while the view origin is used in the other views.
+struct ScrollPosition
+{
+	int topIndex = 0;
+	POINT origin = {};
+};
+
 void SelectItem(HWND hListView, int iItem, BOOL bSelect);
 void SelectAllItems(HWND hListView, BOOL bSelect);
 int InvertSelection(HWND hListView);
@@ -20,5 +28,11 @@ void AddRemoveExtendedStyle(HWND hListView, DWORD dwStyle, BOOL bAdd);
 BOOL SwapItems(HWND hListView, int iItem1, int iItem2, BOOL bSwapLPARAM);
 void PositionInsertMark(HWND hListView, const POINT *ppt);
 std::optional<int> GetLastSelectedItemIndex(HWND listView);
+ScrollPosition GetScrollPosition(HWND listView);
+
+// Restores a position previously returned by GetScrollPosition(). The items in the listview may
+// have changed in the meantime (e.g. because they were removed and then added again), in which
+// case the first visible item will be clamped to the number of items.
+void SetScrollPosition(HWND listView, const ScrollPosition &scrollPosition);
 
 }
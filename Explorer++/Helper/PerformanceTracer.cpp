@@ -0,0 +1,174 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "PerformanceTracer.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <fstream>
+
+namespace
+{
+
+int64_t ToMicroseconds(PerformanceTracer::Clock::duration duration)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+}
+
+PerformanceTracer &PerformanceTracer::GetInstance()
+{
+	static PerformanceTracer tracer;
+	return tracer;
+}
+
+PerformanceTracer::PerformanceTracer() : m_startTime(Clock::now()), m_events(MAX_EVENTS)
+{
+}
+
+void PerformanceTracer::SetEnabled(bool enabled)
+{
+	m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void PerformanceTracer::AddSpan(const char *category, const char *name, Clock::time_point start,
+	Clock::time_point end)
+{
+	auto duration = end - start;
+
+	std::scoped_lock lock(m_mutex);
+
+	m_events.push_back(
+		{ EventType::Span, category, name, GetCurrentThreadId(), start, duration, 0 });
+
+	auto &summary = m_spanSummaries[{ category, name }];
+	summary.category = category;
+	summary.name = name;
+	summary.count++;
+	summary.totalDuration += duration;
+	summary.maxDuration = (std::max)(summary.maxDuration, duration);
+}
+
+void PerformanceTracer::SetCounter(const char *category, const char *name, int64_t value)
+{
+	std::scoped_lock lock(m_mutex);
+	SetCounterLocked(category, name, value);
+}
+
+void PerformanceTracer::AdjustCounter(const char *category, const char *name, int64_t delta)
+{
+	std::scoped_lock lock(m_mutex);
+
+	auto itr = m_counterSummaries.find({ category, name });
+	int64_t currentValue = (itr != m_counterSummaries.end()) ? itr->second.value : 0;
+	SetCounterLocked(category, name, currentValue + delta);
+}
+
+void PerformanceTracer::SetCounterLocked(const char *category, const char *name, int64_t value)
+{
+	m_events.push_back(
+		{ EventType::Counter, category, name, GetCurrentThreadId(), Clock::now(), {}, value });
+
+	auto [itr, inserted] = m_counterSummaries.try_emplace({ category, name });
+	auto &summary = itr->second;
+
+	if (inserted)
+	{
+		summary.category = category;
+		summary.name = name;
+		summary.maxValue = value;
+	}
+
+	summary.value = value;
+	summary.maxValue = (std::max)(summary.maxValue, value);
+}
+
+std::vector<PerformanceTracer::SpanSummary> PerformanceTracer::GetSpanSummaries() const
+{
+	std::scoped_lock lock(m_mutex);
+
+	std::vector<SpanSummary> summaries;
+
+	for (const auto &[key, summary] : m_spanSummaries)
+	{
+		summaries.push_back(summary);
+	}
+
+	return summaries;
+}
+
+std::vector<PerformanceTracer::CounterSummary> PerformanceTracer::GetCounterSummaries() const
+{
+	std::scoped_lock lock(m_mutex);
+
+	std::vector<CounterSummary> summaries;
+
+	for (const auto &[key, summary] : m_counterSummaries)
+	{
+		summaries.push_back(summary);
+	}
+
+	return summaries;
+}
+
+void PerformanceTracer::Clear()
+{
+	std::scoped_lock lock(m_mutex);
+
+	m_events.clear();
+	m_spanSummaries.clear();
+
+	// Some counters track the current size of something (e.g. the number of tasks queued in the
+	// TaskScheduler). Resetting those counters would mean that their values would no longer be
+	// accurate, so only the maximum values are reset.
+	for (auto &[key, summary] : m_counterSummaries)
+	{
+		summary.maxValue = summary.value;
+	}
+}
+
+bool PerformanceTracer::ExportTrace(const std::wstring &filePath) const
+{
+	nlohmann::json traceEvents = nlohmann::json::array();
+	DWORD processId = GetCurrentProcessId();
+
+	{
+		std::scoped_lock lock(m_mutex);
+
+		for (const auto &event : m_events)
+		{
+			nlohmann::json traceEvent = { { "cat", event.category }, { "name", event.name },
+				{ "pid", processId }, { "tid", event.threadId },
+				{ "ts", ToMicroseconds(event.timestamp - m_startTime) } };
+
+			switch (event.type)
+			{
+			case EventType::Span:
+				traceEvent["ph"] = "X";
+				traceEvent["dur"] = ToMicroseconds(event.duration);
+				break;
+
+			case EventType::Counter:
+				traceEvent["ph"] = "C";
+				traceEvent["args"] = { { "value", event.value } };
+				break;
+			}
+
+			traceEvents.push_back(std::move(traceEvent));
+		}
+	}
+
+	nlohmann::json trace = { { "traceEvents", traceEvents }, { "displayTimeUnit", "ms" } };
+
+	std::ofstream outputStream(filePath);
+
+	if (!outputStream)
+	{
+		return false;
+	}
+
+	outputStream << trace.dump();
+	return outputStream.good();
+}
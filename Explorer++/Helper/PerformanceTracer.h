@@ -0,0 +1,170 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <boost/circular_buffer.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Records named spans (e.g. how long it took to enumerate a folder) and counters (e.g. the number
+// of icon cache hits) from various parts of the application, so that it's possible to see where
+// time is being spent.
+//
+// Tracing is disabled by default. While disabled, recording an event consists only of checking a
+// single flag, so instrumentation can be left in performance-sensitive code. While enabled, the
+// most recent events are kept (up to a fixed limit) and summaries of every span and counter are
+// maintained. The recorded events can be exported in the Trace Event Format used by Chrome's
+// about:tracing page (and loadable by viewers such as Perfetto).
+//
+// All the names passed to this class (categories, span names and counter names) are expected to be
+// string literals, since they're stored without being copied.
+class PerformanceTracer : private boost::noncopyable
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct SpanSummary
+	{
+		std::string_view category;
+		std::string_view name;
+		uint64_t count = 0;
+		Clock::duration totalDuration = {};
+		Clock::duration maxDuration = {};
+	};
+
+	struct CounterSummary
+	{
+		std::string_view category;
+		std::string_view name;
+		int64_t value = 0;
+		int64_t maxValue = 0;
+	};
+
+	static PerformanceTracer &GetInstance();
+
+	bool IsEnabled() const
+	{
+		return m_enabled.load(std::memory_order_relaxed);
+	}
+
+	void SetEnabled(bool enabled);
+
+	void AddSpan(const char *category, const char *name, Clock::time_point start,
+		Clock::time_point end);
+
+	// Counters can either be set to an absolute value (e.g. the current size of a queue) or
+	// adjusted by some amount (e.g. incremented each time there's a cache hit).
+	void SetCounter(const char *category, const char *name, int64_t value);
+	void AdjustCounter(const char *category, const char *name, int64_t delta);
+
+	std::vector<SpanSummary> GetSpanSummaries() const;
+	std::vector<CounterSummary> GetCounterSummaries() const;
+	void Clear();
+
+	bool ExportTrace(const std::wstring &filePath) const;
+
+private:
+	// The maximum number of individual events that are kept. Older events are discarded once
+	// this limit has been reached (though they're still included in the summaries).
+	static constexpr size_t MAX_EVENTS = 100'000;
+
+	enum class EventType
+	{
+		Span,
+		Counter
+	};
+
+	struct Event
+	{
+		EventType type;
+		const char *category;
+		const char *name;
+		DWORD threadId;
+		Clock::time_point timestamp;
+
+		// For spans, this is the duration. For counters, it's the updated value.
+		Clock::duration duration;
+		int64_t value;
+	};
+
+	using SummaryKey = std::pair<std::string_view, std::string_view>;
+
+	PerformanceTracer();
+
+	void SetCounterLocked(const char *category, const char *name, int64_t value);
+
+	std::atomic<bool> m_enabled = false;
+	const Clock::time_point m_startTime;
+
+	mutable std::mutex m_mutex;
+	boost::circular_buffer<Event> m_events;
+	std::map<SummaryKey, SpanSummary> m_spanSummaries;
+	std::map<SummaryKey, CounterSummary> m_counterSummaries;
+};
+
+// Records a span that covers the lifetime of this object. If tracing is disabled when the object is
+// created, nothing is recorded.
+class ScopedTraceSpan : private boost::noncopyable
+{
+public:
+	ScopedTraceSpan(const char *category, const char *name);
+	~ScopedTraceSpan();
+
+private:
+	const char *const m_category;
+	const char *const m_name;
+	const bool m_enabled;
+	PerformanceTracer::Clock::time_point m_start;
+};
+
+inline ScopedTraceSpan::ScopedTraceSpan(const char *category, const char *name) :
+	m_category(category),
+	m_name(name),
+	m_enabled(PerformanceTracer::GetInstance().IsEnabled())
+{
+	if (m_enabled)
+	{
+		m_start = PerformanceTracer::Clock::now();
+	}
+}
+
+inline ScopedTraceSpan::~ScopedTraceSpan()
+{
+	if (m_enabled)
+	{
+		PerformanceTracer::GetInstance().AddSpan(m_category, m_name, m_start,
+			PerformanceTracer::Clock::now());
+	}
+}
+
+// These are convenience functions that check whether tracing is enabled before doing anything
+// else.
+inline void TraceCounter(const char *category, const char *name, int64_t value)
+{
+	auto &tracer = PerformanceTracer::GetInstance();
+
+	if (tracer.IsEnabled())
+	{
+		tracer.SetCounter(category, name, value);
+	}
+}
+
+inline void TraceCounterAdjust(const char *category, const char *name, int64_t delta)
+{
+	auto &tracer = PerformanceTracer::GetInstance();
+
+	if (tracer.IsEnabled())
+	{
+		tracer.AdjustCounter(category, name, delta);
+	}
+}
@@ -27,6 +27,26 @@ bool operator==(const PidlAbsolute &pidl1, const PidlAbsolute &pidl2)
 	}
 }
 
+bool IsValidPidlData(std::span<const BYTE> data)
+{
+	size_t offset = 0;
+
+	while (offset + sizeof(USHORT) <= data.size())
+	{
+		USHORT itemSize;
+		memcpy(&itemSize, data.data() + offset, sizeof(itemSize));
+
+		if (itemSize == 0)
+		{
+			return offset + sizeof(USHORT) == data.size();
+		}
+
+		offset += itemSize;
+	}
+
+	return false;
+}
+
 std::size_t hash_value(const PidlAbsolute &pidl)
 {
 	// It's important that the hash here is the same for pidls that compare equal. That should be
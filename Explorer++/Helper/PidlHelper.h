@@ -6,6 +6,7 @@
 
 #include <wil/resource.h>
 #include <ShlObj.h>
+#include <span>
 #include <type_traits>
 
 // The accessor class here simply stops PidlBase from being accessed directly (since PidlBase is
@@ -102,6 +103,10 @@ bool operator==(const PidlAbsolute &pidl1, const PidlAbsolute &pidl2);
 // standard containers by passing the appropriate template parameter.
 std::size_t hash_value(const PidlAbsolute &pidl);
 
+// Checks that the data consists of a set of item IDs, followed by a terminator, with the terminator
+// appearing at the very end of the data. Used to validate pidls read back from storage.
+bool IsValidPidlData(std::span<const BYTE> data);
+
 template <typename T,
 	typename = std::enable_if_t<std::is_same_v<T, PidlAbsolute> || std::is_same_v<T, PidlRelative>
 		|| std::is_same_v<T, PidlChild>>>
@@ -0,0 +1,237 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "PerformanceTracer.h"
+#include <boost/core/noncopyable.hpp>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+// Delivers results from any number of background threads to a single consumer thread (typically
+// the UI thread that owns a window).
+//
+// Producers push results onto a lock-free stack. The notification callback is only invoked when a
+// push finds the queue empty, so a burst of results is announced by a single notification (e.g. a
+// single posted message), rather than one notification per result. The consumer then retrieves
+// everything that's available in one pass, by calling Drain(). If the callback reports that the
+// notification couldn't be sent (e.g. because the message queue was full), the next push will try
+// again, even though the queue isn't empty at that point.
+//
+// Nodes are recycled once the consumer has processed them, so once the pool has grown to the
+// number of results that are typically in flight, pushing a result doesn't allocate.
+//
+// Results can be invalidated in bulk (e.g. when navigating to a different folder) by calling
+// DiscardPending(). Producers capture the current generation (via GetGeneration()) on the consumer
+// thread at the point the work is queued and pass it back when pushing the result. Results from an
+// earlier generation are dropped when drained.
+//
+// Other than Push(), all methods must be called on the consumer thread. Any producers must have
+// finished before the queue is destroyed.
+namespace ResultQueueDetail
+{
+
+// The number of results that have been pushed, but not yet drained, across every queue. This is
+// only used for tracing.
+inline std::atomic<int64_t> g_numPendingResults = 0;
+
+}
+
+template <typename T>
+class ResultQueue : private boost::noncopyable
+{
+public:
+	// Returns true if the notification was sent.
+	using NotifyCallback = std::function<bool()>;
+
+	explicit ResultQueue(NotifyCallback notifyCallback) :
+		m_notifyCallback(std::move(notifyCallback))
+	{
+	}
+
+	~ResultQueue()
+	{
+		Node *pendingHead = m_pendingHead.exchange(nullptr);
+		int64_t numPending = 0;
+
+		for (Node *node = pendingHead; node; node = node->next)
+		{
+			numPending++;
+		}
+
+		if (numPending > 0)
+		{
+			AdjustPendingResults(-numPending);
+		}
+
+		DeleteNodes(pendingHead);
+		DeleteNodes(m_freeHead);
+	}
+
+	uint64_t GetGeneration() const
+	{
+		return m_generation;
+	}
+
+	void DiscardPending()
+	{
+		m_generation++;
+	}
+
+	// May be called from any thread.
+	void Push(uint64_t generation, T value)
+	{
+		Node *node = AcquireNode();
+		node->generation = generation;
+		node->value.emplace(std::move(value));
+
+		node->next = m_pendingHead.load(std::memory_order_relaxed);
+
+		while (!m_pendingHead.compare_exchange_weak(node->next, node, std::memory_order_release,
+			std::memory_order_relaxed))
+		{
+		}
+
+		AdjustPendingResults(1);
+
+		// If the queue already contained results, a notification has already been sent and the
+		// consumer will pick up this result at the same time as the others. That's not the case if
+		// sending the previous notification failed, since the consumer would then never be
+		// notified about the results already in the queue.
+		bool notify = !node->next
+			|| (m_notificationFailed.load(std::memory_order_relaxed)
+				&& m_notificationFailed.exchange(false, std::memory_order_relaxed));
+
+		if (notify && !m_notifyCallback())
+		{
+			m_notificationFailed.store(true, std::memory_order_relaxed);
+		}
+	}
+
+	// Invokes the callback, in the order the results were pushed, for each of the results that are
+	// currently available. Returns the number of results that were passed to the callback.
+	template <typename Callback>
+	size_t Drain(Callback &&callback)
+	{
+		Node *head = m_pendingHead.exchange(nullptr, std::memory_order_acquire);
+
+		if (!head)
+		{
+			return 0;
+		}
+
+		// The stack holds the most recent result first, so it's reversed here to process the
+		// results in order.
+		Node *reversedHead = nullptr;
+		Node *tail = head;
+		int64_t numDrained = 0;
+
+		while (head)
+		{
+			Node *next = head->next;
+			head->next = reversedHead;
+			reversedHead = head;
+			head = next;
+			numDrained++;
+		}
+
+		AdjustPendingResults(-numDrained);
+
+		size_t numProcessed = 0;
+
+		for (Node *node = reversedHead; node; node = node->next)
+		{
+			// The generation is checked for each result, since the callback itself may discard the
+			// remaining results.
+			if (node->generation == m_generation)
+			{
+				callback(*node->value);
+				numProcessed++;
+			}
+
+			node->value.reset();
+		}
+
+		ReleaseNodes(reversedHead, tail);
+
+		return numProcessed;
+	}
+
+	// The total number of nodes that have been allocated over the lifetime of the queue.
+	size_t GetNumNodesAllocated() const
+	{
+		return m_numNodesAllocated.load(std::memory_order_relaxed);
+	}
+
+private:
+	struct Node
+	{
+		Node *next = nullptr;
+		uint64_t generation = 0;
+		std::optional<T> value;
+	};
+
+	Node *AcquireNode()
+	{
+		{
+			std::scoped_lock lock(m_freeMutex);
+
+			if (m_freeHead)
+			{
+				Node *node = m_freeHead;
+				m_freeHead = node->next;
+				return node;
+			}
+		}
+
+		m_numNodesAllocated.fetch_add(1, std::memory_order_relaxed);
+		return new Node;
+	}
+
+	// The total is recorded as an absolute value, so that it's accurate even if tracing is enabled
+	// while results are pending.
+	static void AdjustPendingResults(int64_t delta)
+	{
+		auto numPendingResults =
+			ResultQueueDetail::g_numPendingResults.fetch_add(delta, std::memory_order_relaxed)
+			+ delta;
+		TraceCounter("ResultQueue", "PendingResults", numPendingResults);
+	}
+
+	// Returns the chain [head, tail] to the free list in one step.
+	void ReleaseNodes(Node *head, Node *tail)
+	{
+		std::scoped_lock lock(m_freeMutex);
+		tail->next = m_freeHead;
+		m_freeHead = head;
+	}
+
+	static void DeleteNodes(Node *head)
+	{
+		while (head)
+		{
+			Node *next = head->next;
+			delete head;
+			head = next;
+		}
+	}
+
+	const NotifyCallback m_notifyCallback;
+	std::atomic<Node *> m_pendingHead = nullptr;
+	std::atomic<bool> m_notificationFailed = false;
+
+	// The free list is popped by multiple producers, so it's protected by a mutex, rather than
+	// being lock-free (which would open it up to the ABA problem). The lock is only ever held for
+	// a few instructions and is only taken once per drain on the consumer side.
+	std::mutex m_freeMutex;
+	Node *m_freeHead = nullptr;
+
+	std::atomic<size_t> m_numNodesAllocated = 0;
+
+	// Only accessed on the consumer thread.
+	uint64_t m_generation = 0;
+};
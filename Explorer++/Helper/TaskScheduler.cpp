@@ -0,0 +1,299 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "TaskScheduler.h"
+#include "PerformanceTracer.h"
+#include <glog/logging.h>
+#include <wil/resource.h>
+#include <algorithm>
+
+CancellationToken::CancellationToken() : m_cancelled(std::make_shared<std::atomic<bool>>(false))
+{
+}
+
+bool CancellationToken::IsCancelled() const
+{
+	return m_cancelled->load(std::memory_order_relaxed);
+}
+
+void CancellationToken::Cancel()
+{
+	m_cancelled->store(true, std::memory_order_relaxed);
+}
+
+TaskScheduler::TaskScheduler(int numWorkers) :
+	m_maxBackgroundWorkers((std::max)(1, numWorkers / 2))
+{
+	CHECK_GT(numWorkers, 0);
+
+	for (int i = 0; i < numWorkers; i++)
+	{
+		m_workers.emplace_back(&TaskScheduler::WorkerMain, this);
+	}
+}
+
+TaskScheduler::~TaskScheduler()
+{
+	{
+		std::scoped_lock lock(m_mutex);
+
+		// Each queue should be destroyed before the scheduler, since the queue destructor is
+		// responsible for waiting for the queue's running tasks to finish.
+		DCHECK(m_queues.empty());
+
+		m_stopping = true;
+	}
+
+	m_workAvailable.notify_all();
+
+	for (auto &worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+int TaskScheduler::GetNumWorkers() const
+{
+	return static_cast<int>(m_workers.size());
+}
+
+int TaskScheduler::GetDefaultNumWorkers()
+{
+	// hardware_concurrency() can return 0 if the value can't be determined.
+	return std::clamp(static_cast<int>(std::thread::hardware_concurrency()), MIN_WORKERS,
+		MAX_WORKERS);
+}
+
+void TaskScheduler::AddQueue(TaskQueue *queue)
+{
+	std::scoped_lock lock(m_mutex);
+	m_queues.push_back(queue);
+}
+
+void TaskScheduler::RemoveQueue(TaskQueue *queue)
+{
+	std::unique_lock lock(m_mutex);
+
+	m_taskFinished.wait(lock, [queue] { return queue->m_numRunningTasks == 0; });
+
+	auto itr = std::find(m_queues.begin(), m_queues.end(), queue);
+	CHECK(itr != m_queues.end());
+	auto index = static_cast<size_t>(itr - m_queues.begin());
+	m_queues.erase(itr);
+
+	// Keep rotating from the same position.
+	if (m_nextQueueIndex > index)
+	{
+		m_nextQueueIndex--;
+	}
+}
+
+void TaskScheduler::WorkerMain()
+{
+	HRESULT hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
+	auto comCleanup = wil::scope_exit(
+		[hr]
+		{
+			if (SUCCEEDED(hr))
+			{
+				CoUninitialize();
+			}
+		});
+
+	std::unique_lock lock(m_mutex);
+
+	while (true)
+	{
+		TaskQueue *queue = nullptr;
+
+		m_workAvailable.wait(lock,
+			[this, &queue]
+			{
+				if (m_stopping)
+				{
+					return true;
+				}
+
+				queue = FindNextQueueLocked();
+				return queue != nullptr;
+			});
+
+		if (m_stopping)
+		{
+			return;
+		}
+
+		TaskQueue::Task task = std::move(queue->m_tasks.front());
+		queue->m_tasks.pop_front();
+		queue->m_numRunningTasks++;
+
+		m_numQueuedTasks--;
+		m_numRunningTasks++;
+		TraceTaskCountsLocked();
+
+		// The priority is captured here, since the queue's priority may change while the task is
+		// running.
+		bool background = (queue->m_priority == TaskPriority::Background);
+
+		if (background)
+		{
+			m_numRunningBackgroundTasks++;
+		}
+
+		CancellationToken cancellationToken = queue->m_cancellationToken;
+
+		lock.unlock();
+		task(cancellationToken);
+
+		// The task is destroyed before the lock is reacquired, since destroying it may destroy
+		// arbitrary captured state.
+		task = nullptr;
+		lock.lock();
+
+		if (background)
+		{
+			m_numRunningBackgroundTasks--;
+		}
+
+		queue->m_numRunningTasks--;
+
+		m_numRunningTasks--;
+		TraceTaskCountsLocked();
+
+		if (queue->m_numRunningTasks == 0)
+		{
+			m_taskFinished.notify_all();
+		}
+
+		// Note that there's no need to wake another worker here. If finishing this task has made
+		// another task runnable (e.g. because a concurrency limit is no longer being hit), this
+		// worker will pick it up on the next iteration.
+	}
+}
+
+TaskQueue *TaskScheduler::FindNextQueueLocked()
+{
+	TaskQueue *selectedQueue = nullptr;
+	size_t selectedIndex = 0;
+
+	for (size_t i = 0; i < m_queues.size(); i++)
+	{
+		size_t index = (m_nextQueueIndex + i) % m_queues.size();
+		TaskQueue *queue = m_queues[index];
+
+		if (!IsQueueRunnableLocked(queue))
+		{
+			continue;
+		}
+
+		if (!selectedQueue || queue->m_priority < selectedQueue->m_priority)
+		{
+			selectedQueue = queue;
+			selectedIndex = index;
+
+			if (queue->m_priority == TaskPriority::Foreground)
+			{
+				break;
+			}
+		}
+	}
+
+	if (selectedQueue)
+	{
+		m_nextQueueIndex = selectedIndex + 1;
+	}
+
+	return selectedQueue;
+}
+
+bool TaskScheduler::IsQueueRunnableLocked(const TaskQueue *queue) const
+{
+	if (queue->m_tasks.empty() || queue->m_numRunningTasks >= queue->m_maxConcurrency)
+	{
+		return false;
+	}
+
+	if (queue->m_priority == TaskPriority::Background
+		&& m_numRunningBackgroundTasks >= m_maxBackgroundWorkers)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+// The counts are always recorded as absolute values (rather than being adjusted), so that they're
+// accurate even if tracing is enabled while tasks are queued or running.
+void TaskScheduler::TraceTaskCountsLocked() const
+{
+	TraceCounter("TaskScheduler", "QueuedTasks", m_numQueuedTasks);
+	TraceCounter("TaskScheduler", "RunningTasks", m_numRunningTasks);
+}
+
+TaskQueue::TaskQueue(TaskScheduler *scheduler, TaskPriority priority, int maxConcurrency) :
+	m_scheduler(scheduler),
+	m_maxConcurrency(maxConcurrency),
+	m_priority(priority)
+{
+	CHECK_GT(maxConcurrency, 0);
+
+	m_scheduler->AddQueue(this);
+}
+
+TaskQueue::~TaskQueue()
+{
+	CancelPendingTasks();
+	m_scheduler->RemoveQueue(this);
+}
+
+void TaskQueue::PushTask(Task task)
+{
+	{
+		std::scoped_lock lock(m_scheduler->m_mutex);
+		m_tasks.push_back(std::move(task));
+
+		m_scheduler->m_numQueuedTasks++;
+		m_scheduler->TraceTaskCountsLocked();
+	}
+
+	m_scheduler->m_workAvailable.notify_one();
+}
+
+void TaskQueue::CancelPendingTasks()
+{
+	std::deque<Task> cancelledTasks;
+
+	{
+		std::scoped_lock lock(m_scheduler->m_mutex);
+
+		cancelledTasks.swap(m_tasks);
+
+		m_scheduler->m_numQueuedTasks -= static_cast<int64_t>(cancelledTasks.size());
+		m_scheduler->TraceTaskCountsLocked();
+
+		m_cancellationToken.Cancel();
+		m_cancellationToken = CancellationToken();
+	}
+
+	// The cancelled tasks are destroyed here, outside the lock.
+}
+
+TaskPriority TaskQueue::GetPriority() const
+{
+	std::scoped_lock lock(m_scheduler->m_mutex);
+	return m_priority;
+}
+
+void TaskQueue::SetPriority(TaskPriority priority)
+{
+	{
+		std::scoped_lock lock(m_scheduler->m_mutex);
+		m_priority = priority;
+	}
+
+	// Raising the priority of a background queue may allow tasks to run that were previously
+	// being held back.
+	m_scheduler->m_workAvailable.notify_all();
+}
@@ -0,0 +1,190 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class TaskQueue;
+
+enum class TaskPriority
+{
+	// Work for the part of the UI the user is currently interacting with (e.g. the selected tab).
+	Foreground,
+
+	Normal,
+
+	// Work for parts of the UI that aren't currently visible (e.g. tabs that aren't selected).
+	// These tasks only run when there are no higher priority tasks waiting and only on a limited
+	// number of workers at any one time.
+	Background
+};
+
+// Allows a running task to check whether the queue it was pushed onto has since been cancelled, so
+// that it can stop early. Copies of a token share the same state. Components that need to cancel
+// individual tasks (rather than everything in a queue) can create and cancel tokens of their own.
+class CancellationToken
+{
+public:
+	CancellationToken();
+
+	bool IsCancelled() const;
+	void Cancel();
+
+private:
+	std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+// A single, process-wide set of worker threads that runs the background work queued by the rest
+// of the application. Each worker initializes COM (as a single-threaded apartment), so tasks can
+// freely make use of the shell.
+//
+// Work isn't pushed directly onto the scheduler. Instead, each component creates one or more
+// TaskQueue instances and pushes tasks onto those. The queue determines the priority of its tasks
+// and allows the tasks to be cancelled as a group. When picking the next task to run, a worker
+// will select the highest priority queue that has a task available, rotating between queues of
+// the same priority, so that one busy queue can't starve the others.
+class TaskScheduler : private boost::noncopyable
+{
+public:
+	explicit TaskScheduler(int numWorkers = GetDefaultNumWorkers());
+	~TaskScheduler();
+
+	int GetNumWorkers() const;
+	static int GetDefaultNumWorkers();
+
+private:
+	friend TaskQueue;
+
+	static constexpr int MIN_WORKERS = 2;
+	static constexpr int MAX_WORKERS = 16;
+
+	void AddQueue(TaskQueue *queue);
+	void RemoveQueue(TaskQueue *queue);
+
+	void WorkerMain();
+	TaskQueue *FindNextQueueLocked();
+	bool IsQueueRunnableLocked(const TaskQueue *queue) const;
+	void TraceTaskCountsLocked() const;
+
+	std::vector<std::thread> m_workers;
+	const int m_maxBackgroundWorkers;
+
+	std::mutex m_mutex;
+	std::condition_variable m_workAvailable;
+	std::condition_variable m_taskFinished;
+	std::vector<TaskQueue *> m_queues;
+	size_t m_nextQueueIndex = 0;
+	int m_numRunningBackgroundTasks = 0;
+	bool m_stopping = false;
+
+	// The totals across all queues. These are only used for tracing.
+	int64_t m_numQueuedTasks = 0;
+	int64_t m_numRunningTasks = 0;
+};
+
+// A queue of tasks belonging to a single component (e.g. the column text requests for a single
+// tab). By default, the tasks in a queue run one at a time, in the order they were pushed. A higher
+// concurrency limit can be given when the queue is created, though that's only worthwhile for work
+// that doesn't contend for a single resource (e.g. the disk) and the reason for the limit should be
+// documented where the queue is created. Destroying a queue cancels any tasks that haven't started
+// yet and waits for any running tasks to finish.
+class TaskQueue : private boost::noncopyable
+{
+public:
+	TaskQueue(TaskScheduler *scheduler, TaskPriority priority = TaskPriority::Normal,
+		int maxConcurrency = 1);
+	~TaskQueue();
+
+	// The task can either take no arguments or take a const reference to a CancellationToken. The
+	// result of the task can be retrieved through the returned future. If the task is cancelled
+	// before it starts, the future will hold a std::future_error (broken_promise) instead.
+	template <typename F>
+	auto Push(F &&function);
+
+	// Equivalent to Push(), except that no future is returned. This avoids the cost of allocating
+	// the shared state for tasks that deliver their results some other way (e.g. through a
+	// ResultQueue).
+	template <typename F>
+	void Post(F &&function);
+
+	// Removes all the tasks that haven't started yet and signals the cancellation token passed to
+	// any tasks that are currently running.
+	void CancelPendingTasks();
+
+	TaskPriority GetPriority() const;
+	void SetPriority(TaskPriority priority);
+
+private:
+	friend TaskScheduler;
+
+	using Task = std::function<void(const CancellationToken &cancellationToken)>;
+
+	void PushTask(Task task);
+
+	TaskScheduler *const m_scheduler;
+	const int m_maxConcurrency;
+
+	// These are all protected by the scheduler's mutex.
+	TaskPriority m_priority;
+	std::deque<Task> m_tasks;
+	int m_numRunningTasks = 0;
+	CancellationToken m_cancellationToken;
+};
+
+template <typename F>
+auto TaskQueue::Push(F &&function)
+{
+	using FunctionType = std::decay_t<F>;
+
+	if constexpr (std::is_invocable_v<FunctionType &, const CancellationToken &>)
+	{
+		using ResultType = std::invoke_result_t<FunctionType &, const CancellationToken &>;
+
+		auto packagedTask =
+			std::make_shared<std::packaged_task<ResultType(const CancellationToken &)>>(
+				std::forward<F>(function));
+		auto future = packagedTask->get_future();
+		PushTask([packagedTask](const CancellationToken &cancellationToken)
+			{ (*packagedTask)(cancellationToken); });
+		return future;
+	}
+	else
+	{
+		using ResultType = std::invoke_result_t<FunctionType &>;
+
+		auto packagedTask =
+			std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(function));
+		auto future = packagedTask->get_future();
+		PushTask([packagedTask](const CancellationToken &) { (*packagedTask)(); });
+		return future;
+	}
+}
+
+template <typename F>
+void TaskQueue::Post(F &&function)
+{
+	using FunctionType = std::decay_t<F>;
+
+	if constexpr (std::is_invocable_v<FunctionType &, const CancellationToken &>)
+	{
+		PushTask(std::forward<F>(function));
+	}
+	else
+	{
+		PushTask([function = std::forward<F>(function)](const CancellationToken &) mutable
+			{ function(); });
+	}
+}
@@ -0,0 +1,115 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "stdafx.h"
+#include "WildcardMatcher.h"
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <optional>
+
+WildcardMatcher::WildcardMatcher(std::wstring_view pattern, bool caseSensitive) :
+	m_caseSensitive(caseSensitive)
+{
+	std::vector<std::wstring> patterns;
+	boost::split(patterns, pattern, [](wchar_t c) { return c == ':'; });
+
+	for (auto &currentPattern : patterns)
+	{
+		boost::trim(currentPattern);
+
+		if (currentPattern.empty())
+		{
+			continue;
+		}
+
+		m_patterns.push_back(caseSensitive ? currentPattern : ToLowercase(currentPattern));
+	}
+}
+
+bool WildcardMatcher::Matches(std::wstring_view text) const
+{
+	std::wstring lowercaseText;
+
+	if (!m_caseSensitive)
+	{
+		lowercaseText = ToLowercase(text);
+		text = lowercaseText;
+	}
+
+	for (const auto &pattern : m_patterns)
+	{
+		if (MatchesSinglePattern(pattern, text))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool WildcardMatcher::MatchesSinglePattern(std::wstring_view pattern, std::wstring_view text)
+{
+	size_t patternIndex = 0;
+	size_t textIndex = 0;
+
+	// The position of the most recent '*' in the pattern and the position in the text it was
+	// matched at. If a later part of the pattern fails to match, the '*' can be made to match one
+	// more character and the rest of the pattern retried from there.
+	std::optional<size_t> starPatternIndex;
+	size_t starTextIndex = 0;
+
+	while (textIndex < text.size())
+	{
+		if (patternIndex < pattern.size()
+			&& (pattern[patternIndex] == '?' || pattern[patternIndex] == text[textIndex]))
+		{
+			patternIndex++;
+			textIndex++;
+		}
+		else if (patternIndex < pattern.size() && pattern[patternIndex] == '*')
+		{
+			starPatternIndex = patternIndex;
+			starTextIndex = textIndex;
+			patternIndex++;
+		}
+		else if (starPatternIndex)
+		{
+			patternIndex = *starPatternIndex + 1;
+			starTextIndex++;
+			textIndex = starTextIndex;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	while (patternIndex < pattern.size() && pattern[patternIndex] == '*')
+	{
+		patternIndex++;
+	}
+
+	return patternIndex == pattern.size();
+}
+
+std::wstring WildcardMatcher::ToLowercase(std::wstring_view text)
+{
+	if (text.empty())
+	{
+		return {};
+	}
+
+	std::wstring lowercaseText(text.size(), '\0');
+	int res = LCMapStringEx(LOCALE_NAME_USER_DEFAULT, LCMAP_LOWERCASE, text.data(),
+		static_cast<int>(text.size()), lowercaseText.data(),
+		static_cast<int>(lowercaseText.size()), nullptr, nullptr, 0);
+
+	if (res == 0)
+	{
+		return std::wstring(text);
+	}
+
+	lowercaseText.resize(res);
+	return lowercaseText;
+}
@@ -0,0 +1,28 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A pre-processed version of a wildcard pattern, which can be efficiently matched against many
+// strings. The pattern syntax is the same as the syntax accepted by CheckWildcardMatch() (i.e. '*'
+// matches any sequence of characters, '?' matches a single character and multiple patterns can be
+// separated by ':').
+class WildcardMatcher
+{
+public:
+	WildcardMatcher(std::wstring_view pattern, bool caseSensitive);
+
+	bool Matches(std::wstring_view text) const;
+
+private:
+	static bool MatchesSinglePattern(std::wstring_view pattern, std::wstring_view text);
+	static std::wstring ToLowercase(std::wstring_view text);
+
+	std::vector<std::wstring> m_patterns;
+	const bool m_caseSensitive;
+};
@@ -0,0 +1,157 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "AddressBarCompleter.h"
+#include "Bookmarks/BookmarkSearchIndex.h"
+#include "Bookmarks/BookmarkTree.h"
+#include "FrequentLocationsService.h"
+#include "HistoryService.h"
+#include "ShellBrowser/DirectoryEnumerationCache.h"
+#include "ShellTestHelper.h"
+#include "../Helper/ShellHelper.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+class AddressBarCompleterTest : public Test
+{
+protected:
+	AddressBarCompleterTest() :
+		m_completer(&m_historyService, &m_frequentLocationsService, &m_bookmarkTree,
+			&m_bookmarkSearchIndex, &m_enumerationCache)
+	{
+	}
+
+	void AddBookmark(const std::wstring &location, const std::wstring &name = L"Bookmark")
+	{
+		auto *parent = m_bookmarkTree.GetBookmarksMenuFolder();
+		m_bookmarkTree.AddBookmarkItem(parent,
+			std::make_unique<BookmarkItem>(std::nullopt, name, location),
+			parent->GetChildren().size());
+	}
+
+	// Adds a snapshot of the Windows directory that contains the specified items. The snapshot is
+	// only cached while a reference to it is held.
+	std::shared_ptr<const DirectorySnapshot> AddWindowsSnapshot(
+		const std::vector<std::wstring> &itemNames, std::wstring &outputWindowsPath)
+	{
+		PidlAbsolute pidlWindows;
+		HRESULT hr = SHGetKnownFolderIDList(FOLDERID_Windows, KF_FLAG_DEFAULT, nullptr,
+			PidlOutParam(pidlWindows));
+		EXPECT_HRESULT_SUCCEEDED(hr);
+
+		hr = GetDisplayName(pidlWindows.Raw(), SHGDN_FORPARSING, outputWindowsPath);
+		EXPECT_HRESULT_SUCCEEDED(hr);
+
+		DirectorySnapshot snapshot;
+		snapshot.directory = pidlWindows;
+		snapshot.parsingPath = outputWindowsPath;
+		snapshot.showHidden = false;
+
+		for (const auto &itemName : itemNames)
+		{
+			DirectorySnapshotItem item = {};
+			item.parsingName = outputWindowsPath + L"\\" + itemName;
+			item.displayName = itemName;
+			item.editingName = itemName;
+			snapshot.items.push_back(std::move(item));
+		}
+
+		return m_enumerationCache.AddSnapshot(std::move(snapshot));
+	}
+
+	HistoryService m_historyService;
+	FrequentLocationsService m_frequentLocationsService;
+	BookmarkTree m_bookmarkTree;
+	BookmarkSearchIndex m_bookmarkSearchIndex{ &m_bookmarkTree };
+	DirectoryEnumerationCache m_enumerationCache;
+	AddressBarCompleter m_completer;
+};
+
+TEST_F(AddressBarCompleterTest, IndexedLocations)
+{
+	m_historyService.AddHistoryItem(CreateSimplePidlForTest(L"C:\\Projects\\First"));
+	AddBookmark(L"C:\\Projects\\Bookmarked");
+
+	auto pidlSecond = CreateSimplePidlForTest(L"C:\\Projects\\Second");
+	m_frequentLocationsService.RegisterLocationVisit(pidlSecond);
+	m_frequentLocationsService.RegisterLocationVisit(pidlSecond);
+
+	// The frequently visited location should be ranked first, followed by the bookmark and then
+	// the location that's only in history.
+	EXPECT_THAT(m_completer.GetSuggestions(L"c:\\projects\\"),
+		ElementsAre(L"C:\\Projects\\Second", L"C:\\Projects\\Bookmarked",
+			L"C:\\Projects\\First"));
+	EXPECT_THAT(m_completer.GetSuggestions(L"D:\\"), IsEmpty());
+}
+
+TEST_F(AddressBarCompleterTest, IndexUpdated)
+{
+	m_historyService.AddHistoryItem(CreateSimplePidlForTest(L"C:\\Projects\\First"));
+	EXPECT_THAT(m_completer.GetSuggestions(L"C:\\Projects"), ElementsAre(L"C:\\Projects\\First"));
+
+	m_historyService.AddHistoryItem(CreateSimplePidlForTest(L"C:\\Projects\\Second"));
+	EXPECT_THAT(m_completer.GetSuggestions(L"C:\\Projects"),
+		ElementsAre(L"C:\\Projects\\Second", L"C:\\Projects\\First"));
+
+	AddBookmark(L"C:\\Projects\\Bookmarked");
+	EXPECT_THAT(m_completer.GetSuggestions(L"C:\\Projects\\B"),
+		ElementsAre(L"C:\\Projects\\Bookmarked"));
+}
+
+TEST_F(AddressBarCompleterTest, DirectoryChildren)
+{
+	std::wstring windowsPath;
+	auto snapshot = AddWindowsSnapshot({ L"Music", L"downloads", L"Documents" }, windowsPath);
+	ASSERT_NE(snapshot, nullptr);
+
+	// Items should be matched without regard to case and returned in alphabetical order.
+	EXPECT_THAT(m_completer.GetSuggestions(windowsPath + L"\\DO"),
+		ElementsAre(windowsPath + L"\\Documents", windowsPath + L"\\downloads"));
+	EXPECT_THAT(m_completer.GetSuggestions(windowsPath + L"\\"),
+		ElementsAre(windowsPath + L"\\Documents", windowsPath + L"\\downloads",
+			windowsPath + L"\\Music"));
+	EXPECT_THAT(m_completer.GetSuggestions(windowsPath + L"\\Videos"), IsEmpty());
+
+	// Once the snapshot is no longer cached, suggestions for the directory's children should no
+	// longer be provided.
+	snapshot.reset();
+	EXPECT_THAT(m_completer.GetSuggestions(windowsPath + L"\\"), IsEmpty());
+}
+
+TEST_F(AddressBarCompleterTest, DuplicateSuggestionsRemoved)
+{
+	std::wstring windowsPath;
+	auto snapshot = AddWindowsSnapshot({ L"Documents", L"Music" }, windowsPath);
+	ASSERT_NE(snapshot, nullptr);
+
+	AddBookmark(windowsPath + L"\\Music");
+
+	// The bookmark should be ranked first. Since the directory item refers to the same location,
+	// it shouldn't be suggested a second time.
+	EXPECT_THAT(m_completer.GetSuggestions(windowsPath + L"\\"),
+		ElementsAre(windowsPath + L"\\Music", windowsPath + L"\\Documents"));
+}
+
+TEST_F(AddressBarCompleterTest, BookmarkNameMatches)
+{
+	AddBookmark(L"C:\\Projects\\Explorer++", L"Explorer++ source");
+	AddBookmark(L"D:\\Photos\\2020", L"Holiday photos");
+	AddBookmark(L"E:\\Backups", L"Source backups");
+	AddBookmark(L"F:\\Photos", L"Archive");
+
+	// Bookmarks should be matched on the words in their name, not just on their location.
+	EXPECT_THAT(m_completer.GetSuggestions(L"source"),
+		ElementsAre(L"C:\\Projects\\Explorer++", L"E:\\Backups"));
+	EXPECT_THAT(m_completer.GetSuggestions(L"hol"), ElementsAre(L"D:\\Photos\\2020"));
+
+	// A match in the name should be ranked above a match in the location.
+	EXPECT_THAT(m_completer.GetSuggestions(L"photos"),
+		ElementsAre(L"D:\\Photos\\2020", L"F:\\Photos"));
+
+	// Once a path separator has been entered, the text should only be treated as a path.
+	EXPECT_THAT(m_completer.GetSuggestions(L"holiday\\"), IsEmpty());
+}
@@ -0,0 +1,100 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "../Helper/AppendOnlyJournal.h"
+#include "TempFileTestHelper.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <istream>
+
+using namespace testing;
+
+class AppendOnlyJournalTest : public Test
+{
+protected:
+	static constexpr uint32_t MAGIC = 0x54534554;
+
+	// Each record is a single 32-bit value.
+	static std::string BuildRecord(uint32_t value)
+	{
+		return std::string(reinterpret_cast<const char *>(&value), sizeof(value));
+	}
+
+	static std::vector<uint32_t> LoadValues(AppendOnlyJournal &journal)
+	{
+		std::vector<uint32_t> values;
+
+		journal.Load(
+			[&values](std::istream &stream)
+			{
+				uint32_t value;
+				stream.read(reinterpret_cast<char *>(&value), sizeof(value));
+
+				if (!stream)
+				{
+					return false;
+				}
+
+				values.push_back(value);
+				return true;
+			});
+
+		return values;
+	}
+
+	const TempFileForTest m_journalFile{ L".dat" };
+	const std::filesystem::path m_journalPath = m_journalFile.GetPath();
+};
+
+TEST_F(AppendOnlyJournalTest, AppendAndRewrite)
+{
+	AppendOnlyJournal journal(m_journalPath, MAGIC, 1);
+	EXPECT_THAT(LoadValues(journal), IsEmpty());
+
+	EXPECT_TRUE(journal.Append(BuildRecord(1)));
+	EXPECT_TRUE(journal.Append(BuildRecord(2)));
+	EXPECT_EQ(journal.GetNumRecords(), 2U);
+	EXPECT_THAT(LoadValues(journal), ElementsAre(1U, 2U));
+
+	EXPECT_TRUE(journal.Rewrite({ BuildRecord(3) }));
+	EXPECT_EQ(journal.GetNumRecords(), 1U);
+	EXPECT_THAT(LoadValues(journal), ElementsAre(3U));
+
+	// The temporary file used while rewriting should have been renamed into place.
+	auto temporaryPath = m_journalPath;
+	temporaryPath += L".tmp";
+	EXPECT_FALSE(std::filesystem::exists(temporaryPath));
+}
+
+TEST_F(AppendOnlyJournalTest, TruncatedRecord)
+{
+	AppendOnlyJournal journal(m_journalPath, MAGIC, 1);
+	journal.Append(BuildRecord(1));
+	journal.Append(BuildRecord(2));
+
+	std::filesystem::resize_file(m_journalPath, std::filesystem::file_size(m_journalPath) - 1);
+
+	EXPECT_THAT(LoadValues(journal), ElementsAre(1U));
+	EXPECT_EQ(journal.GetNumRecords(), 1U);
+
+	// The partial record should have been removed, so that the new record is read back.
+	journal.Append(BuildRecord(3));
+	EXPECT_THAT(LoadValues(journal), ElementsAre(1U, 3U));
+}
+
+TEST_F(AppendOnlyJournalTest, VersionMismatch)
+{
+	{
+		AppendOnlyJournal journal(m_journalPath, MAGIC, 1);
+		journal.Append(BuildRecord(1));
+	}
+
+	// A journal with a different version can't be read, so should be replaced with an empty one.
+	AppendOnlyJournal journal(m_journalPath, MAGIC, 2);
+	EXPECT_THAT(LoadValues(journal), IsEmpty());
+
+	journal.Append(BuildRecord(2));
+	EXPECT_THAT(LoadValues(journal), ElementsAre(2U));
+}
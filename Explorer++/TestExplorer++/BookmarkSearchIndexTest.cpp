@@ -0,0 +1,102 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "Bookmarks/BookmarkSearchIndex.h"
+#include "Bookmarks/BookmarkTree.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+class BookmarkSearchIndexTest : public Test
+{
+protected:
+	BookmarkItem *AddBookmark(BookmarkItem *parent, const std::wstring &name,
+		const std::wstring &location)
+	{
+		return m_bookmarkTree.AddBookmarkItem(parent,
+			std::make_unique<BookmarkItem>(std::nullopt, name, location),
+			parent->GetChildren().size());
+	}
+
+	BookmarkItem *AddFolder(BookmarkItem *parent, const std::wstring &name)
+	{
+		return m_bookmarkTree.AddBookmarkItem(parent,
+			std::make_unique<BookmarkItem>(std::nullopt, name, std::nullopt),
+			parent->GetChildren().size());
+	}
+
+	BookmarkTree m_bookmarkTree;
+};
+
+TEST_F(BookmarkSearchIndexTest, ExistingItems)
+{
+	auto *bookmark =
+		AddBookmark(m_bookmarkTree.GetBookmarksMenuFolder(), L"Projects", L"C:\\Projects");
+
+	BookmarkSearchIndex searchIndex(&m_bookmarkTree);
+	EXPECT_THAT(searchIndex.Search(L"proj", 10), ElementsAre(bookmark));
+}
+
+TEST_F(BookmarkSearchIndexTest, PrefixAndMultipleWords)
+{
+	BookmarkSearchIndex searchIndex(&m_bookmarkTree);
+
+	auto *bookmark1 = AddBookmark(m_bookmarkTree.GetBookmarksMenuFolder(), L"Windows Fonts",
+		L"C:\\Windows\\Fonts");
+	auto *bookmark2 =
+		AddBookmark(m_bookmarkTree.GetBookmarksMenuFolder(), L"Documents", L"D:\\Documents");
+
+	EXPECT_THAT(searchIndex.Search(L"WIN", 10), ElementsAre(bookmark1));
+	EXPECT_THAT(searchIndex.Search(L"win font", 10), ElementsAre(bookmark1));
+	EXPECT_THAT(searchIndex.Search(L"win doc", 10), IsEmpty());
+	EXPECT_THAT(searchIndex.Search(L"d doc", 10), ElementsAre(bookmark2));
+	EXPECT_THAT(searchIndex.Search(L"", 10), IsEmpty());
+}
+
+TEST_F(BookmarkSearchIndexTest, Ranking)
+{
+	BookmarkSearchIndex searchIndex(&m_bookmarkTree);
+
+	auto *locationMatch =
+		AddBookmark(m_bookmarkTree.GetBookmarksMenuFolder(), L"Pictures", L"C:\\Music\\Pictures");
+	auto *prefixMatch =
+		AddBookmark(m_bookmarkTree.GetBookmarksMenuFolder(), L"Musical", L"C:\\Other");
+	auto *exactMatch = AddBookmark(m_bookmarkTree.GetBookmarksMenuFolder(), L"Music", L"C:\\Other");
+
+	EXPECT_THAT(searchIndex.Search(L"music", 10),
+		ElementsAre(exactMatch, prefixMatch, locationMatch));
+	EXPECT_THAT(searchIndex.Search(L"music", 1), ElementsAre(exactMatch));
+}
+
+TEST_F(BookmarkSearchIndexTest, Update)
+{
+	BookmarkSearchIndex searchIndex(&m_bookmarkTree);
+
+	auto *bookmark =
+		AddBookmark(m_bookmarkTree.GetBookmarksMenuFolder(), L"Downloads", L"C:\\Downloads");
+
+	bookmark->SetName(L"Videos");
+	EXPECT_THAT(searchIndex.Search(L"videos", 10), ElementsAre(bookmark));
+	EXPECT_THAT(searchIndex.Search(L"downloads", 10), ElementsAre(bookmark));
+
+	bookmark->SetLocation(L"C:\\Videos");
+	EXPECT_THAT(searchIndex.Search(L"downloads", 10), IsEmpty());
+}
+
+TEST_F(BookmarkSearchIndexTest, Remove)
+{
+	BookmarkSearchIndex searchIndex(&m_bookmarkTree);
+
+	auto *folder = AddFolder(m_bookmarkTree.GetBookmarksMenuFolder(), L"Work");
+	auto *bookmark = AddBookmark(folder, L"Reports", L"C:\\Reports");
+
+	EXPECT_THAT(searchIndex.Search(L"work", 10), ElementsAre(folder));
+	EXPECT_THAT(searchIndex.Search(L"reports", 10), ElementsAre(bookmark));
+
+	m_bookmarkTree.RemoveBookmarkItem(folder);
+	EXPECT_THAT(searchIndex.Search(L"work", 10), IsEmpty());
+	EXPECT_THAT(searchIndex.Search(L"reports", 10), IsEmpty());
+}
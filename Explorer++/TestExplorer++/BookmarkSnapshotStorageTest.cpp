@@ -0,0 +1,108 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "Bookmarks/BookmarkSnapshotStorage.h"
+#include "BookmarkStorageTestHelper.h"
+#include "Bookmarks/BookmarkTree.h"
+#include "TempFileTestHelper.h"
+#include <gtest/gtest.h>
+#include <fstream>
+#include <limits>
+
+using namespace testing;
+
+class BookmarkSnapshotStorageTest : public Test
+{
+protected:
+	BookmarkSnapshotStorageTest()
+	{
+		std::ofstream sourceStream(m_sourcePath, std::ios::binary | std::ios::trunc);
+		sourceStream << "<ExplorerPlusPlus />";
+	}
+
+	void SaveReferenceSnapshot()
+	{
+		BookmarkTree referenceBookmarkTree;
+		BuildV2LoadSaveReferenceTree(&referenceBookmarkTree);
+		ASSERT_TRUE(
+			BookmarkSnapshotStorage::Save(m_snapshotPath, m_sourcePath, &referenceBookmarkTree));
+	}
+
+	static void ExpectEmpty(const BookmarkTree &bookmarkTree)
+	{
+		EXPECT_TRUE(bookmarkTree.GetBookmarksToolbarFolder()->GetChildren().empty());
+		EXPECT_TRUE(bookmarkTree.GetBookmarksMenuFolder()->GetChildren().empty());
+		EXPECT_TRUE(bookmarkTree.GetOtherBookmarksFolder()->GetChildren().empty());
+	}
+
+	const TempFileForTest m_snapshotFile{ L".dat" };
+	const TempFileForTest m_sourceFile{ L".xml" };
+	const std::filesystem::path m_snapshotPath = m_snapshotFile.GetPath();
+	const std::filesystem::path m_sourcePath = m_sourceFile.GetPath();
+};
+
+TEST_F(BookmarkSnapshotStorageTest, SaveLoad)
+{
+	SaveReferenceSnapshot();
+
+	BookmarkTree loadedBookmarkTree;
+	ASSERT_TRUE(BookmarkSnapshotStorage::Load(m_snapshotPath, m_sourcePath, &loadedBookmarkTree));
+
+	BookmarkTree referenceBookmarkTree;
+	BuildV2LoadSaveReferenceTree(&referenceBookmarkTree);
+	CompareBookmarkTrees(&loadedBookmarkTree, &referenceBookmarkTree, true);
+}
+
+TEST_F(BookmarkSnapshotStorageTest, StaleSnapshot)
+{
+	SaveReferenceSnapshot();
+
+	{
+		// Simulates the config file being edited after the snapshot was written.
+		std::ofstream sourceStream(m_sourcePath, std::ios::binary | std::ios::app);
+		sourceStream << "<!-- Edited -->";
+	}
+
+	BookmarkTree loadedBookmarkTree;
+	EXPECT_FALSE(BookmarkSnapshotStorage::Load(m_snapshotPath, m_sourcePath, &loadedBookmarkTree));
+	ExpectEmpty(loadedBookmarkTree);
+}
+
+TEST_F(BookmarkSnapshotStorageTest, TruncatedSnapshot)
+{
+	SaveReferenceSnapshot();
+
+	std::filesystem::resize_file(m_snapshotPath, std::filesystem::file_size(m_snapshotPath) / 2);
+
+	BookmarkTree loadedBookmarkTree;
+	EXPECT_FALSE(BookmarkSnapshotStorage::Load(m_snapshotPath, m_sourcePath, &loadedBookmarkTree));
+	ExpectEmpty(loadedBookmarkTree);
+}
+
+TEST_F(BookmarkSnapshotStorageTest, CorruptedLength)
+{
+	SaveReferenceSnapshot();
+
+	{
+		// Overwrites the number of children in the bookmarks toolbar folder, which follows the
+		// header (a 4 byte version and the 16 byte source file information) and the two 8 byte
+		// folder dates.
+		std::fstream stream(m_snapshotPath, std::ios::binary | std::ios::in | std::ios::out);
+		stream.seekp(36);
+		uint64_t length = (std::numeric_limits<uint64_t>::max)();
+		stream.write(reinterpret_cast<const char *>(&length), sizeof(length));
+	}
+
+	BookmarkTree loadedBookmarkTree;
+	EXPECT_FALSE(BookmarkSnapshotStorage::Load(m_snapshotPath, m_sourcePath, &loadedBookmarkTree));
+	ExpectEmpty(loadedBookmarkTree);
+}
+
+TEST_F(BookmarkSnapshotStorageTest, MissingSnapshot)
+{
+	BookmarkTree loadedBookmarkTree;
+	EXPECT_FALSE(BookmarkSnapshotStorage::Load(m_snapshotPath, m_sourcePath, &loadedBookmarkTree));
+	ExpectEmpty(loadedBookmarkTree);
+}
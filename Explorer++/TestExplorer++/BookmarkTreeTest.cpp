@@ -139,6 +139,59 @@ TEST(BookmarkTreeTest, RemoveChildren)
 	EXPECT_EQ(bookmarkTree.GetOtherBookmarksFolder()->GetChildren().size(), 0U);
 }
 
+TEST(BookmarkTreeTest, GetBookmarkItemById)
+{
+	BookmarkTree bookmarkTree;
+
+	EXPECT_EQ(bookmarkTree.GetBookmarkItemById(bookmarkTree.GetRoot()->GetGUID()),
+		bookmarkTree.GetRoot());
+	EXPECT_EQ(bookmarkTree.GetBookmarkItemById(bookmarkTree.GetBookmarksMenuFolder()->GetGUID()),
+		bookmarkTree.GetBookmarksMenuFolder());
+	EXPECT_EQ(bookmarkTree.GetBookmarkItemById(L"invalid"), nullptr);
+
+	auto folder = std::make_unique<BookmarkItem>(std::nullopt, L"Test folder", std::nullopt);
+	auto rawFolder = folder.get();
+
+	auto bookmark = std::make_unique<BookmarkItem>(std::nullopt, L"Test bookmark", L"C:\\");
+	auto rawBookmark = bookmark.get();
+	std::wstring bookmarkGuid = rawBookmark->GetGUID();
+	folder->AddChild(std::move(bookmark));
+
+	// Items nested within an added folder should be indexed as well.
+	bookmarkTree.AddBookmarkItem(bookmarkTree.GetBookmarksMenuFolder(), std::move(folder), 0);
+	EXPECT_EQ(bookmarkTree.GetBookmarkItemById(rawFolder->GetGUID()), rawFolder);
+	EXPECT_EQ(bookmarkTree.GetBookmarkItemById(bookmarkGuid), rawBookmark);
+
+	bookmarkTree.MoveBookmarkItem(rawFolder, bookmarkTree.GetBookmarksToolbarFolder(), 0);
+	EXPECT_EQ(bookmarkTree.GetBookmarkItemById(bookmarkGuid), rawBookmark);
+
+	std::wstring folderGuid = rawFolder->GetGUID();
+	bookmarkTree.RemoveBookmarkItem(rawFolder);
+	EXPECT_EQ(bookmarkTree.GetBookmarkItemById(folderGuid), nullptr);
+	EXPECT_EQ(bookmarkTree.GetBookmarkItemById(bookmarkGuid), nullptr);
+}
+
+TEST(BookmarkTreeTest, DuplicateGuid)
+{
+	BookmarkTree bookmarkTree;
+
+	const std::wstring guid = L"10000000-0000-0000-0000-000000000001";
+	auto *originalBookmark = bookmarkTree.AddBookmarkItem(bookmarkTree.GetBookmarksMenuFolder(),
+		std::make_unique<BookmarkItem>(guid, L"Original", L"C:\\"), 0);
+	auto *duplicateBookmark = bookmarkTree.AddBookmarkItem(bookmarkTree.GetBookmarksMenuFolder(),
+		std::make_unique<BookmarkItem>(guid, L"Duplicate", L"D:\\"), 1);
+
+	// The second item should have been assigned a new GUID, so that both items can be looked up.
+	EXPECT_EQ(originalBookmark->GetGUID(), guid);
+	EXPECT_NE(duplicateBookmark->GetGUID(), guid);
+	EXPECT_EQ(bookmarkTree.GetBookmarkItemById(guid), originalBookmark);
+	EXPECT_EQ(bookmarkTree.GetBookmarkItemById(duplicateBookmark->GetGUID()), duplicateBookmark);
+
+	// Removing the second item shouldn't affect the lookup of the first.
+	bookmarkTree.RemoveBookmarkItem(duplicateBookmark);
+	EXPECT_EQ(bookmarkTree.GetBookmarkItemById(guid), originalBookmark);
+}
+
 TEST_F(BookmarkTreeObserverTest, Add)
 {
 	m_bookmarkTree.bookmarkItemAddedSignal.AddObserver(
@@ -0,0 +1,125 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "../Helper/CachedFormatter.h"
+#include "../Helper/Helper.h"
+#include "../Helper/StringHelper.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+FILETIME TicksToFileTime(uint64_t ticks)
+{
+	return { static_cast<DWORD>(ticks & 0xFFFFFFFF), static_cast<DWORD>(ticks >> 32) };
+}
+
+std::wstring FormatFileTimeWithFormatter(CachedFormatter &formatter, const FILETIME &fileTime,
+	bool friendlyDate)
+{
+	wchar_t buffer[128];
+	size_t length = formatter.FormatFileTime(fileTime, friendlyDate, buffer);
+	return std::wstring(buffer, length);
+}
+
+std::wstring FormatFileTimeOriginal(const FILETIME &fileTime, bool friendlyDate)
+{
+	wchar_t buffer[128];
+	BOOL res = CreateFileTimeString(&fileTime, buffer, std::size(buffer), friendlyDate);
+	return res ? buffer : L"";
+}
+
+}
+
+TEST(CachedFormatterTest, SizeMatchesFormatSizeString)
+{
+	CachedFormatter formatter;
+	std::vector<uint64_t> sizes = { 0, 1, 999, 1023, 1024, 1536, 10239, 10240, 102400, 1048575,
+		2 * 1024 * 1024, 48169402368, 517964566528, 1000204886016, 1234567890123456 };
+
+	for (auto sizeDisplayFormat : SizeDisplayFormat::_values())
+	{
+		for (uint64_t size : sizes)
+		{
+			wchar_t buffer[64];
+			size_t length = formatter.FormatSize(size, sizeDisplayFormat, buffer);
+			EXPECT_EQ(std::wstring(buffer, length), FormatSizeString(size, sizeDisplayFormat));
+		}
+	}
+}
+
+TEST(CachedFormatterTest, FileTimeMatchesCreateFileTimeString)
+{
+	CachedFormatter formatter;
+
+	// 2000-01-01 00:00:00 UTC, which is then stepped forward by a little over 3 days at a time, so
+	// that a range of dates and times of day are covered.
+	constexpr uint64_t START_TICKS = 125911584000000000;
+	constexpr uint64_t STEP_TICKS = 2680000000000 + 1234567;
+
+	for (int i = 0; i < 2000; i++)
+	{
+		auto fileTime = TicksToFileTime(START_TICKS + i * STEP_TICKS);
+		EXPECT_EQ(FormatFileTimeWithFormatter(formatter, fileTime, false),
+			FormatFileTimeOriginal(fileTime, false));
+	}
+}
+
+TEST(CachedFormatterTest, FriendlyDates)
+{
+	CachedFormatter formatter;
+
+	FILETIME now;
+	GetSystemTimeAsFileTime(&now);
+
+	ULARGE_INTEGER nowTicks = { now.dwLowDateTime, now.dwHighDateTime };
+
+	// One hour ago, one day ago and one week ago. The first two will typically result in the
+	// "Today" and "Yesterday" text being used.
+	constexpr uint64_t TICKS_PER_HOUR = 36000000000;
+	std::vector<uint64_t> offsets = { TICKS_PER_HOUR, 24 * TICKS_PER_HOUR, 168 * TICKS_PER_HOUR };
+
+	for (uint64_t offset : offsets)
+	{
+		auto fileTime = TicksToFileTime(nowTicks.QuadPart - offset);
+		EXPECT_EQ(FormatFileTimeWithFormatter(formatter, fileTime, true),
+			FormatFileTimeOriginal(fileTime, true));
+	}
+}
+
+TEST(CachedFormatterTest, InvalidateAll)
+{
+	CachedFormatter formatter;
+	FILETIME fileTime = TicksToFileTime(125911584000000000);
+
+	auto original = FormatFileTimeWithFormatter(formatter, fileTime, false);
+	CachedFormatter::InvalidateAll();
+	EXPECT_EQ(FormatFileTimeWithFormatter(formatter, fileTime, false), original);
+}
+
+TEST(CachedFormatterTest, BufferTooSmall)
+{
+	CachedFormatter formatter;
+
+	wchar_t buffer[4];
+	EXPECT_EQ(formatter.FormatSize(1024, SizeDisplayFormat::None, buffer), 0u);
+	EXPECT_EQ(buffer[0], L'\0');
+
+	EXPECT_EQ(formatter.FormatFileTime(TicksToFileTime(125911584000000000), false, buffer), 0u);
+	EXPECT_EQ(buffer[0], L'\0');
+
+	// There should be exactly enough space for "1 bytes" and the terminating null character.
+	wchar_t exactBuffer[8];
+	EXPECT_EQ(formatter.FormatSize(1, SizeDisplayFormat::None, exactBuffer), 7u);
+	EXPECT_STREQ(exactBuffer, L"1 bytes");
+}
+
+TEST(CachedFormatterTest, InvalidFileTime)
+{
+	CachedFormatter formatter;
+
+	wchar_t buffer[128];
+	EXPECT_EQ(formatter.FormatFileTime(TicksToFileTime(UINT64_MAX), false, buffer), 0u);
+}
@@ -0,0 +1,142 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "ClosedTabsStorage.h"
+#include "PreservedTab.h"
+#include "ShellBrowser/PreservedHistoryEntry.h"
+#include "ShellTestHelper.h"
+#include "TempFileTestHelper.h"
+#include <gtest/gtest.h>
+#include <fstream>
+#include <limits>
+
+using namespace testing;
+
+class ClosedTabsStorageTest : public Test
+{
+protected:
+	static std::unique_ptr<PreservedTab> BuildClosedTab(int index,
+		const std::vector<std::wstring> &paths, int currentEntry)
+	{
+		FolderSettings folderSettings;
+		folderSettings.viewMode = ViewMode::Details;
+		folderSettings.sortMode = SortMode::DateModified;
+		folderSettings.sortDirection = SortDirection::Descending;
+		folderSettings.applyFilter = true;
+		folderSettings.filter = L"*.txt";
+
+		auto closedTab = std::make_unique<PreservedTab>(0, index, folderSettings);
+		closedTab->currentEntry = currentEntry;
+		closedTab->useCustomName = true;
+		closedTab->customName = L"Custom name";
+		closedTab->lockState = Tab::LockState::Locked;
+
+		for (const auto &path : paths)
+		{
+			closedTab->AddHistoryEntry(CreateSimplePidlForTest(path).Raw(), path, path, 5);
+		}
+
+		return closedTab;
+	}
+
+	const TempFileForTest m_storageFile{ L".dat" };
+	const std::filesystem::path m_storagePath = m_storageFile.GetPath();
+};
+
+TEST_F(ClosedTabsStorageTest, SaveLoad)
+{
+	TabRestorer::ClosedTabs closedTabs;
+	closedTabs.push_back(BuildClosedTab(2, { L"C:\\Fake1", L"C:\\Fake2", L"C:\\Fake3" }, 1));
+	closedTabs.push_back(BuildClosedTab(0, { L"C:\\Fake4" }, 0));
+	ASSERT_TRUE(ClosedTabsStorage::Save(m_storagePath, closedTabs));
+
+	auto loadedTabs = ClosedTabsStorage::Load(m_storagePath);
+	ASSERT_EQ(loadedTabs.size(), closedTabs.size());
+
+	for (size_t i = 0; i < loadedTabs.size(); i++)
+	{
+		const auto &loadedTab = *loadedTabs[i];
+		const auto &originalTab = *closedTabs[i];
+
+		EXPECT_EQ(loadedTab.index, originalTab.index);
+		EXPECT_EQ(loadedTab.currentEntry, originalTab.currentEntry);
+		EXPECT_EQ(loadedTab.useCustomName, originalTab.useCustomName);
+		EXPECT_EQ(loadedTab.customName, originalTab.customName);
+		EXPECT_EQ(loadedTab.lockState, originalTab.lockState);
+		EXPECT_EQ(loadedTab.preservedFolderState.folderSettings,
+			originalTab.preservedFolderState.folderSettings);
+
+		ASSERT_EQ(loadedTab.GetNumHistoryEntries(), originalTab.GetNumHistoryEntries());
+
+		for (size_t j = 0; j < loadedTab.GetNumHistoryEntries(); j++)
+		{
+			EXPECT_EQ(loadedTab.GetHistoryEntryPidl(j), originalTab.GetHistoryEntryPidl(j));
+			EXPECT_EQ(loadedTab.GetHistoryEntry(j).displayName,
+				originalTab.GetHistoryEntry(j).displayName);
+			EXPECT_EQ(loadedTab.GetHistoryEntry(j).fullPathForDisplay,
+				originalTab.GetHistoryEntry(j).fullPathForDisplay);
+
+			// Icon indexes are only valid within a single process, so shouldn't be saved.
+			EXPECT_EQ(loadedTab.GetHistoryEntry(j).systemIconIndex, std::nullopt);
+		}
+	}
+}
+
+TEST_F(ClosedTabsStorageTest, MissingFile)
+{
+	EXPECT_TRUE(ClosedTabsStorage::Load(m_storagePath).empty());
+}
+
+TEST_F(ClosedTabsStorageTest, InvalidFile)
+{
+	{
+		std::ofstream stream(m_storagePath, std::ios::binary);
+		stream << "not a closed tabs file";
+	}
+
+	EXPECT_TRUE(ClosedTabsStorage::Load(m_storagePath).empty());
+}
+
+TEST_F(ClosedTabsStorageTest, CorruptedLength)
+{
+	std::vector<std::unique_ptr<PreservedTab>> closedTabs;
+	closedTabs.push_back(BuildClosedTab(0, { L"C:\\Fake1" }, 0));
+	ASSERT_TRUE(ClosedTabsStorage::Save(m_storagePath, closedTabs));
+
+	{
+		// Overwrites the number of tabs, which directly follows the 4 byte version.
+		std::fstream stream(m_storagePath, std::ios::binary | std::ios::in | std::ios::out);
+		stream.seekp(4);
+		uint64_t length = (std::numeric_limits<uint64_t>::max)();
+		stream.write(reinterpret_cast<const char *>(&length), sizeof(length));
+	}
+
+	EXPECT_TRUE(ClosedTabsStorage::Load(m_storagePath).empty());
+}
+
+TEST(PreservedTabTest, HistoryEntries)
+{
+	PreservedTab preservedTab(0, 0, FolderSettings());
+	preservedTab.AddHistoryEntry(CreateSimplePidlForTest(L"C:\\Fake1").Raw(), L"Fake1",
+		L"C:\\Fake1", 1);
+	preservedTab.AddHistoryEntry(CreateSimplePidlForTest(L"C:\\Fake2\\Child").Raw(), L"Child",
+		L"C:\\Fake2\\Child", std::nullopt);
+	preservedTab.currentEntry = 1;
+
+	// Each pidl should be read back correctly from the shared buffer.
+	EXPECT_EQ(preservedTab.GetHistoryEntryPidl(0), CreateSimplePidlForTest(L"C:\\Fake1"));
+	EXPECT_EQ(preservedTab.GetCurrentHistoryEntryPidl(),
+		CreateSimplePidlForTest(L"C:\\Fake2\\Child"));
+	EXPECT_EQ(preservedTab.GetCurrentHistoryEntry().displayName, L"Child");
+
+	auto historyEntries = preservedTab.BuildHistoryEntries();
+	ASSERT_EQ(historyEntries.size(), 2U);
+	EXPECT_EQ(historyEntries[0]->pidl, CreateSimplePidlForTest(L"C:\\Fake1"));
+	EXPECT_EQ(historyEntries[0]->displayName, L"Fake1");
+	EXPECT_EQ(historyEntries[0]->systemIconIndex, 1);
+	EXPECT_EQ(historyEntries[1]->pidl, CreateSimplePidlForTest(L"C:\\Fake2\\Child"));
+	EXPECT_EQ(historyEntries[1]->fullPathForDisplay, L"C:\\Fake2\\Child");
+	EXPECT_EQ(historyEntries[1]->systemIconIndex, std::nullopt);
+}
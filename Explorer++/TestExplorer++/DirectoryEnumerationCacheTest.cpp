@@ -0,0 +1,146 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "ShellBrowser/DirectoryEnumerationCache.h"
+#include "../Helper/ShellHelper.h"
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+class DirectoryEnumerationCacheTest : public Test
+{
+protected:
+	void SetUp() override
+	{
+		HRESULT hr = SHGetKnownFolderIDList(FOLDERID_Windows, KF_FLAG_DEFAULT, nullptr,
+			PidlOutParam(m_pidlWindows));
+		ASSERT_HRESULT_SUCCEEDED(hr);
+
+		hr = SHGetKnownFolderIDList(FOLDERID_System, KF_FLAG_DEFAULT, nullptr,
+			PidlOutParam(m_pidlSystem));
+		ASSERT_HRESULT_SUCCEEDED(hr);
+	}
+
+	static DirectorySnapshot BuildSnapshot(const PidlAbsolute &directory, bool showHidden)
+	{
+		DirectorySnapshot snapshot;
+		snapshot.directory = directory;
+		snapshot.showHidden = showHidden;
+		return snapshot;
+	}
+
+	DirectoryEnumerationCache m_cache;
+	PidlAbsolute m_pidlWindows;
+	PidlAbsolute m_pidlSystem;
+};
+
+TEST_F(DirectoryEnumerationCacheTest, GetSnapshot)
+{
+	EXPECT_EQ(m_cache.MaybeGetSnapshot(m_pidlWindows.Raw(), false), nullptr);
+
+	auto snapshot = m_cache.AddSnapshot(BuildSnapshot(m_pidlWindows, false));
+	ASSERT_NE(snapshot, nullptr);
+
+	EXPECT_EQ(m_cache.MaybeGetSnapshot(m_pidlWindows.Raw(), false), snapshot);
+	EXPECT_EQ(m_cache.MaybeGetSnapshot(m_pidlSystem.Raw(), false), nullptr);
+
+	// Whether or not hidden items are included changes the results of the enumeration, so a
+	// snapshot should only be returned if that setting matches.
+	EXPECT_EQ(m_cache.MaybeGetSnapshot(m_pidlWindows.Raw(), true), nullptr);
+}
+
+TEST_F(DirectoryEnumerationCacheTest, SnapshotRetained)
+{
+	auto snapshot = m_cache.AddSnapshot(BuildSnapshot(m_pidlWindows, false));
+	ASSERT_NE(snapshot, nullptr);
+	EXPECT_EQ(m_cache.GetMemoryUsage(),
+		DirectoryEnumerationCache::EstimateSnapshotMemoryUsage(*snapshot));
+
+	// The cache owns the snapshot, so it should remain available once the caller has released its
+	// reference.
+	auto *rawSnapshot = snapshot.get();
+	snapshot.reset();
+	EXPECT_EQ(m_cache.MaybeGetSnapshot(m_pidlWindows.Raw(), false).get(), rawSnapshot);
+}
+
+TEST_F(DirectoryEnumerationCacheTest, MemoryBudget)
+{
+	uint64_t windowsSnapshotSize =
+		DirectoryEnumerationCache::EstimateSnapshotMemoryUsage(BuildSnapshot(m_pidlWindows, false));
+	uint64_t systemSnapshotSize =
+		DirectoryEnumerationCache::EstimateSnapshotMemoryUsage(BuildSnapshot(m_pidlSystem, false));
+	DirectoryEnumerationCache cache(windowsSnapshotSize + systemSnapshotSize);
+
+	auto snapshot1 = cache.AddSnapshot(BuildSnapshot(m_pidlWindows, false));
+	auto snapshot2 = cache.AddSnapshot(BuildSnapshot(m_pidlWindows, true));
+
+	// Retrieving the first snapshot marks it as the most recently used, so adding a third snapshot
+	// should evict the second.
+	EXPECT_EQ(cache.MaybeGetSnapshot(m_pidlWindows.Raw(), false), snapshot1);
+
+	auto snapshot3 = cache.AddSnapshot(BuildSnapshot(m_pidlSystem, false));
+	EXPECT_EQ(cache.MaybeGetSnapshot(m_pidlWindows.Raw(), false), snapshot1);
+	EXPECT_EQ(cache.MaybeGetSnapshot(m_pidlWindows.Raw(), true), nullptr);
+	EXPECT_EQ(cache.MaybeGetSnapshot(m_pidlSystem.Raw(), false), snapshot3);
+	EXPECT_EQ(cache.GetMemoryUsage(), windowsSnapshotSize + systemSnapshotSize);
+}
+
+TEST_F(DirectoryEnumerationCacheTest, SnapshotLargerThanBudget)
+{
+	DirectoryEnumerationCache cache(1);
+
+	auto snapshot = cache.AddSnapshot(BuildSnapshot(m_pidlWindows, false));
+	EXPECT_NE(snapshot, nullptr);
+	EXPECT_EQ(cache.MaybeGetSnapshot(m_pidlWindows.Raw(), false), nullptr);
+	EXPECT_EQ(cache.GetMemoryUsage(), 0u);
+}
+
+TEST_F(DirectoryEnumerationCacheTest, ReplaceSnapshot)
+{
+	auto snapshot1 = m_cache.AddSnapshot(BuildSnapshot(m_pidlWindows, false));
+	auto snapshot2 = m_cache.AddSnapshot(BuildSnapshot(m_pidlWindows, false));
+
+	// The original snapshot should remain valid, but the cache should only return the most recent
+	// snapshot.
+	EXPECT_NE(snapshot1, nullptr);
+	EXPECT_EQ(m_cache.MaybeGetSnapshot(m_pidlWindows.Raw(), false), snapshot2);
+}
+
+TEST_F(DirectoryEnumerationCacheTest, InvalidateSnapshots)
+{
+	auto snapshot1 = m_cache.AddSnapshot(BuildSnapshot(m_pidlWindows, false));
+	auto snapshot2 = m_cache.AddSnapshot(BuildSnapshot(m_pidlWindows, true));
+	auto snapshot3 = m_cache.AddSnapshot(BuildSnapshot(m_pidlSystem, false));
+
+	m_cache.InvalidateSnapshots(m_pidlWindows.Raw());
+
+	EXPECT_EQ(m_cache.MaybeGetSnapshot(m_pidlWindows.Raw(), false), nullptr);
+	EXPECT_EQ(m_cache.MaybeGetSnapshot(m_pidlWindows.Raw(), true), nullptr);
+	EXPECT_EQ(m_cache.MaybeGetSnapshot(m_pidlSystem.Raw(), false), snapshot3);
+}
+
+TEST_F(DirectoryEnumerationCacheTest, GetSnapshotForPath)
+{
+	std::wstring windowsPath;
+	ASSERT_HRESULT_SUCCEEDED(GetDisplayName(m_pidlWindows.Raw(), SHGDN_FORPARSING, windowsPath));
+
+	auto hiddenItemsSnapshot = BuildSnapshot(m_pidlWindows, true);
+	hiddenItemsSnapshot.parsingPath = windowsPath;
+	auto snapshot1 = m_cache.AddSnapshot(std::move(hiddenItemsSnapshot));
+
+	// The path should be compared without regard to case.
+	auto upperCasePath = windowsPath;
+	CharUpperBuff(upperCasePath.data(), static_cast<DWORD>(upperCasePath.size()));
+	EXPECT_EQ(m_cache.MaybeGetSnapshotForPath(upperCasePath), snapshot1);
+
+	// When there's a snapshot that doesn't include hidden items, that snapshot should be
+	// preferred.
+	auto snapshot = BuildSnapshot(m_pidlWindows, false);
+	snapshot.parsingPath = windowsPath;
+	auto snapshot2 = m_cache.AddSnapshot(std::move(snapshot));
+	EXPECT_EQ(m_cache.MaybeGetSnapshotForPath(windowsPath), snapshot2);
+
+	EXPECT_EQ(m_cache.MaybeGetSnapshotForPath(windowsPath + L"\\System32"), nullptr);
+}
@@ -0,0 +1,121 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "FrequentLocationsJournal.h"
+#include "ShellTestHelper.h"
+#include "TempFileTestHelper.h"
+#include <gtest/gtest.h>
+#include <fstream>
+
+using namespace testing;
+
+class FrequentLocationsJournalTest : public Test
+{
+protected:
+	const TempFileForTest m_journalFile{ L".dat" };
+	const std::filesystem::path m_journalPath = m_journalFile.GetPath();
+};
+
+TEST_F(FrequentLocationsJournalTest, AppendAndLoad)
+{
+	auto visitTime = std::chrono::floor<std::chrono::seconds>(LocationVisitInfo::Clock::now());
+	LocationVisitInfo visitInfo1(CreateSimplePidlForTest(L"C:\\Fake1"), visitTime);
+	visitInfo1.AddVisit(visitTime + std::chrono::hours(1));
+	LocationVisitInfo visitInfo2(CreateSimplePidlForTest(L"C:\\Fake2"), visitTime);
+
+	{
+		FrequentLocationsJournal journal(m_journalPath);
+		EXPECT_TRUE(journal.Load().empty());
+		EXPECT_TRUE(journal.Append(visitInfo1));
+		EXPECT_TRUE(journal.Append(visitInfo2));
+		EXPECT_EQ(journal.GetNumEntries(), 2U);
+	}
+
+	FrequentLocationsJournal journal(m_journalPath);
+	auto visits = journal.Load();
+	ASSERT_EQ(visits.size(), 2U);
+	EXPECT_EQ(visits[0].GetLocation(), visitInfo1.GetLocation());
+	EXPECT_EQ(visits[0].GetNumVisits(), 2);
+	EXPECT_EQ(visits[0].GetLastVisitTime(), visitInfo1.GetLastVisitTime());
+	EXPECT_EQ(visits[0].GetScore(), visitInfo1.GetScore());
+	EXPECT_EQ(visits[1].GetLocation(), visitInfo2.GetLocation());
+	EXPECT_EQ(visits[1].GetNumVisits(), 1);
+	EXPECT_EQ(journal.GetNumEntries(), 2U);
+}
+
+TEST_F(FrequentLocationsJournalTest, Rewrite)
+{
+	FrequentLocationsJournal journal(m_journalPath);
+	journal.Load();
+	journal.Append({ CreateSimplePidlForTest(L"C:\\Fake1") });
+	journal.Append({ CreateSimplePidlForTest(L"C:\\Fake2") });
+	journal.Append({ CreateSimplePidlForTest(L"C:\\Fake3") });
+
+	EXPECT_TRUE(journal.Rewrite({ { CreateSimplePidlForTest(L"C:\\Fake3") } }));
+	EXPECT_EQ(journal.GetNumEntries(), 1U);
+
+	auto visits = journal.Load();
+	ASSERT_EQ(visits.size(), 1U);
+	EXPECT_EQ(visits[0].GetLocation(), CreateSimplePidlForTest(L"C:\\Fake3"));
+}
+
+TEST_F(FrequentLocationsJournalTest, InvalidEntrySkipped)
+{
+	// A visit with an empty pidl can't be written, since there's no location to record.
+	LocationVisitInfo invalidVisit{ PidlAbsolute() };
+
+	FrequentLocationsJournal journal(m_journalPath);
+	journal.Load();
+	EXPECT_TRUE(journal.Append(invalidVisit));
+	EXPECT_TRUE(journal.Append({ CreateSimplePidlForTest(L"C:\\Fake1") }));
+	EXPECT_EQ(journal.GetNumEntries(), 1U);
+
+	EXPECT_TRUE(journal.Rewrite({ invalidVisit, { CreateSimplePidlForTest(L"C:\\Fake1") } }));
+	EXPECT_EQ(journal.GetNumEntries(), 1U);
+
+	auto visits = journal.Load();
+	ASSERT_EQ(visits.size(), 1U);
+	EXPECT_EQ(visits[0].GetLocation(), CreateSimplePidlForTest(L"C:\\Fake1"));
+}
+
+TEST_F(FrequentLocationsJournalTest, TruncatedEntry)
+{
+	{
+		FrequentLocationsJournal journal(m_journalPath);
+		journal.Load();
+		journal.Append({ CreateSimplePidlForTest(L"C:\\Fake1") });
+		journal.Append({ CreateSimplePidlForTest(L"C:\\Fake2") });
+	}
+
+	// Simulate a crash part of the way through writing the final entry.
+	std::filesystem::resize_file(m_journalPath, std::filesystem::file_size(m_journalPath) - 3);
+
+	FrequentLocationsJournal journal(m_journalPath);
+	auto visits = journal.Load();
+	ASSERT_EQ(visits.size(), 1U);
+	EXPECT_EQ(visits[0].GetLocation(), CreateSimplePidlForTest(L"C:\\Fake1"));
+
+	// The partial entry should have been removed, so that new entries can be appended.
+	journal.Append({ CreateSimplePidlForTest(L"C:\\Fake3") });
+
+	visits = FrequentLocationsJournal(m_journalPath).Load();
+	ASSERT_EQ(visits.size(), 2U);
+	EXPECT_EQ(visits[1].GetLocation(), CreateSimplePidlForTest(L"C:\\Fake3"));
+}
+
+TEST_F(FrequentLocationsJournalTest, InvalidFile)
+{
+	{
+		std::ofstream stream(m_journalPath, std::ios::binary);
+		stream << "not a journal";
+	}
+
+	FrequentLocationsJournal journal(m_journalPath);
+	EXPECT_TRUE(journal.Load().empty());
+	EXPECT_TRUE(journal.Append({ CreateSimplePidlForTest(L"C:\\Fake1") }));
+
+	auto visits = FrequentLocationsJournal(m_journalPath).Load();
+	ASSERT_EQ(visits.size(), 1U);
+}
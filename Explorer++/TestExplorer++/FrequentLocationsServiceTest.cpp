@@ -4,10 +4,13 @@
 
 #include "pch.h"
 #include "FrequentLocationsService.h"
+#include "FrequentLocationsJournal.h"
 #include "ShellTestHelper.h"
+#include "TempFileTestHelper.h"
 #include "../Helper/StringHelper.h"
 #include <gtest/gtest.h>
 
+using namespace std::chrono_literals;
 using namespace testing;
 
 bool operator==(const LocationVisitInfo &locationInfo1, const LocationVisitInfo &locationInfo2)
@@ -125,30 +128,77 @@ TEST(FrequentLocationsServiceTest, VisitCountOrderChanges)
 TEST(FrequentLocationsServiceTest, VisitTimeOrderChanges)
 {
 	FrequentLocationsService frequentLocationService;
+	auto baseTime = LocationVisitInfo::Clock::now();
 
 	PidlAbsolute fake1 = CreateSimplePidlForTest(L"C:\\Fake1");
-	frequentLocationService.RegisterLocationVisit(fake1);
+	frequentLocationService.RegisterLocationVisit(fake1, baseTime);
 
 	PidlAbsolute fake2 = CreateSimplePidlForTest(L"C:\\Fake2");
-	frequentLocationService.RegisterLocationVisit(fake2);
+	frequentLocationService.RegisterLocationVisit(fake2, baseTime + 1h);
 
-	frequentLocationService.RegisterLocationVisit(fake1);
-	frequentLocationService.RegisterLocationVisit(fake2);
+	frequentLocationService.RegisterLocationVisit(fake1, baseTime + 2h);
+	frequentLocationService.RegisterLocationVisit(fake2, baseTime + 3h);
 
 	const auto &visits = frequentLocationService.GetVisits();
 
-	// fake2 is the most recently visited item, so it should appear first.
+	// fake2 has been visited the same number of times as fake1, but more recently, so it should
+	// appear first.
 	std::vector<LocationVisitInfo> expectedVisits = { { fake2, 2 }, { fake1, 2 } };
 	EXPECT_THAT(visits, ElementsAreArray(expectedVisits));
 
-	frequentLocationService.RegisterLocationVisit(fake2);
-	frequentLocationService.RegisterLocationVisit(fake1);
+	frequentLocationService.RegisterLocationVisit(fake2, baseTime + 4h);
+	frequentLocationService.RegisterLocationVisit(fake1, baseTime + 24h);
 
-	// fake1 is now the most recently visited item.
+	// fake1 has now been visited sufficiently recently to outweigh the fact that its earlier visits
+	// were older.
 	expectedVisits = { { fake1, 3 }, { fake2, 3 } };
 	EXPECT_THAT(visits, ElementsAreArray(expectedVisits));
 }
 
+TEST(FrequentLocationsServiceTest, OlderVisitsDecay)
+{
+	FrequentLocationsService frequentLocationService;
+	auto baseTime = LocationVisitInfo::Clock::now();
+
+	PidlAbsolute fake1 = CreateSimplePidlForTest(L"C:\\Fake1");
+	PidlAbsolute fake2 = CreateSimplePidlForTest(L"C:\\Fake2");
+	PidlAbsolute fake3 = CreateSimplePidlForTest(L"C:\\Fake3");
+
+	for (int i = 0; i < 3; i++)
+	{
+		frequentLocationService.RegisterLocationVisit(fake1, baseTime - std::chrono::days(60));
+		frequentLocationService.RegisterLocationVisit(fake3, baseTime - std::chrono::days(7));
+	}
+
+	frequentLocationService.RegisterLocationVisit(fake2, baseTime);
+
+	// The visits to fake1 were long enough ago that they're now worth less than the single recent
+	// visit to fake2. The visits to fake3 are more recent and still outweigh that single visit.
+	std::vector<LocationVisitInfo> expectedVisits = { { fake3, 3 }, { fake2, 1 }, { fake1, 3 } };
+	EXPECT_THAT(frequentLocationService.GetVisits(), ElementsAreArray(expectedVisits));
+}
+
+TEST(FrequentLocationsServiceTest, MaxLocations)
+{
+	FrequentLocationsService frequentLocationService(2);
+	auto baseTime = LocationVisitInfo::Clock::now();
+
+	PidlAbsolute fake1 = CreateSimplePidlForTest(L"C:\\Fake1");
+	frequentLocationService.RegisterLocationVisit(fake1, baseTime);
+
+	PidlAbsolute fake2 = CreateSimplePidlForTest(L"C:\\Fake2");
+	frequentLocationService.RegisterLocationVisit(fake2, baseTime + 1h);
+
+	PidlAbsolute fake3 = CreateSimplePidlForTest(L"C:\\Fake3");
+	frequentLocationService.RegisterLocationVisit(fake3, baseTime + 2h);
+
+	// The lowest ranked location should have been removed.
+	EXPECT_EQ(frequentLocationService.GetNumLocations(), 2U);
+
+	std::vector<LocationVisitInfo> expectedVisits = { { fake3, 1 }, { fake2, 1 } };
+	EXPECT_THAT(frequentLocationService.GetVisits(), ElementsAreArray(expectedVisits));
+}
+
 TEST(FrequentLocationsServiceTest, LocationsChangedEvent)
 {
 	FrequentLocationsService frequentLocationService;
@@ -165,3 +215,96 @@ TEST(FrequentLocationsServiceTest, LocationsChangedEvent)
 	PidlAbsolute fake2 = CreateSimplePidlForTest(L"C:\\Fake2");
 	frequentLocationService.RegisterLocationVisit(fake2);
 }
+
+class FrequentLocationsServiceJournalTest : public Test
+{
+protected:
+	const TempFileForTest m_journalFile{ L".dat" };
+	const std::filesystem::path m_journalPath = m_journalFile.GetPath();
+};
+
+TEST_F(FrequentLocationsServiceJournalTest, Persistence)
+{
+	PidlAbsolute fake1 = CreateSimplePidlForTest(L"C:\\Fake1");
+	PidlAbsolute fake2 = CreateSimplePidlForTest(L"C:\\Fake2");
+	double originalScore;
+
+	{
+		FrequentLocationsService frequentLocationService;
+		frequentLocationService.SetJournal(
+			std::make_unique<FrequentLocationsJournal>(m_journalPath));
+		frequentLocationService.RegisterLocationVisit(fake1);
+		frequentLocationService.RegisterLocationVisit(fake2);
+		frequentLocationService.RegisterLocationVisit(fake1);
+
+		originalScore = frequentLocationService.GetVisits().begin()->GetScore();
+	}
+
+	FrequentLocationsService frequentLocationService;
+
+	MockFunction<void()> callback;
+	frequentLocationService.AddLocationsChangedObserver(callback.AsStdFunction());
+	EXPECT_CALL(callback, Call()).Times(1);
+
+	frequentLocationService.SetJournal(std::make_unique<FrequentLocationsJournal>(m_journalPath));
+
+	const auto &visits = frequentLocationService.GetVisits();
+	std::vector<LocationVisitInfo> expectedVisits = { { fake1, 2 }, { fake2, 1 } };
+	EXPECT_THAT(visits, ElementsAreArray(expectedVisits));
+	EXPECT_EQ(visits.begin()->GetScore(), originalScore);
+}
+
+TEST_F(FrequentLocationsServiceJournalTest, Compaction)
+{
+	const size_t maxLocations = 2;
+	auto baseTime = LocationVisitInfo::Clock::now();
+	std::vector<PidlAbsolute> pidls;
+
+	{
+		FrequentLocationsService frequentLocationService(maxLocations);
+		auto journal = std::make_unique<FrequentLocationsJournal>(m_journalPath);
+		auto *rawJournal = journal.get();
+		frequentLocationService.SetJournal(std::move(journal));
+
+		for (int i = 0; i < 10; i++)
+		{
+			pidls.push_back(CreateSimplePidlForTest(std::format(L"C:\\Fake{}", i)));
+			frequentLocationService.RegisterLocationVisit(pidls.back(),
+				baseTime + std::chrono::minutes(i));
+
+			// The journal should never be allowed to grow without bound.
+			EXPECT_LE(rawJournal->GetNumEntries(), maxLocations * 2);
+		}
+	}
+
+	FrequentLocationsService frequentLocationService(maxLocations);
+	frequentLocationService.SetJournal(std::make_unique<FrequentLocationsJournal>(m_journalPath));
+
+	std::vector<LocationVisitInfo> expectedVisits = { { pidls[9], 1 }, { pidls[8], 1 } };
+	EXPECT_THAT(frequentLocationService.GetVisits(), ElementsAreArray(expectedVisits));
+}
+
+TEST_F(FrequentLocationsServiceJournalTest, ExpiredLocationsRemoved)
+{
+	FrequentLocationsService frequentLocationService(3);
+	frequentLocationService.SetJournal(std::make_unique<FrequentLocationsJournal>(m_journalPath));
+
+	auto now = LocationVisitInfo::Clock::now();
+
+	PidlAbsolute fake1 = CreateSimplePidlForTest(L"C:\\Fake1");
+	frequentLocationService.RegisterLocationVisit(fake1,
+		now - FrequentLocationsService::EXPIRY_AGE - std::chrono::days(1));
+
+	PidlAbsolute fake2 = CreateSimplePidlForTest(L"C:\\Fake2");
+	PidlAbsolute fake3 = CreateSimplePidlForTest(L"C:\\Fake3");
+
+	for (int i = 0; i < 3; i++)
+	{
+		frequentLocationService.RegisterLocationVisit(fake2, now);
+		frequentLocationService.RegisterLocationVisit(fake3, now);
+	}
+
+	// The journal will have been compacted by this point and the location that hasn't been visited
+	// for a long time should have been removed as part of that.
+	EXPECT_EQ(frequentLocationService.GetNumLocations(), 2U);
+}
@@ -8,6 +8,7 @@
 #include "HistoryService.h"
 #include "IconFetcherMock.h"
 #include "PopupMenuView.h"
+#include "ShellItemDetailsFetcherFake.h"
 #include "ShellTestHelper.h"
 #include "../Helper/ShellHelper.h"
 #include <gtest/gtest.h>
@@ -18,7 +19,8 @@ class GlobalHistoryMenuTest : public Test
 {
 protected:
 	GlobalHistoryMenuTest() :
-		m_menu(&m_popupMenu, &m_historyService, &m_browserWindow, &m_iconFetcher)
+		m_menu(&m_popupMenu, &m_historyService, &m_browserWindow, &m_iconFetcher,
+			&m_detailsFetcher)
 	{
 	}
 
@@ -70,6 +72,7 @@ private:
 	HistoryService m_historyService;
 	BrowserWindowMock m_browserWindow;
 	IconFetcherMock m_iconFetcher;
+	ShellItemDetailsFetcherFake m_detailsFetcher;
 	GlobalHistoryMenu m_menu;
 	size_t m_historyItemCount = 0;
 };
@@ -0,0 +1,121 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "HistoryJournal.h"
+#include "ShellTestHelper.h"
+#include "TempFileTestHelper.h"
+#include <gtest/gtest.h>
+#include <fstream>
+
+using namespace testing;
+
+class HistoryJournalTest : public Test
+{
+protected:
+	static HistoryJournal::Entry BuildEntry(const std::wstring &path)
+	{
+		return { CreateSimplePidlForTest(path), path };
+	}
+
+	const TempFileForTest m_journalFile{ L".dat" };
+	const std::filesystem::path m_journalPath = m_journalFile.GetPath();
+};
+
+TEST_F(HistoryJournalTest, AppendAndLoad)
+{
+	{
+		HistoryJournal journal(m_journalPath);
+		EXPECT_TRUE(journal.Load().empty());
+		EXPECT_TRUE(journal.Append(BuildEntry(L"C:\\Fake1")));
+		EXPECT_TRUE(journal.Append(BuildEntry(L"C:\\Fake2")));
+		EXPECT_EQ(journal.GetNumEntries(), 2U);
+	}
+
+	HistoryJournal journal(m_journalPath);
+	auto entries = journal.Load();
+	ASSERT_EQ(entries.size(), 2U);
+	EXPECT_EQ(entries[0].pidl, CreateSimplePidlForTest(L"C:\\Fake1"));
+	EXPECT_EQ(entries[0].parsingPath, L"C:\\Fake1");
+	EXPECT_EQ(entries[1].pidl, CreateSimplePidlForTest(L"C:\\Fake2"));
+	EXPECT_EQ(entries[1].parsingPath, L"C:\\Fake2");
+	EXPECT_EQ(journal.GetNumEntries(), 2U);
+}
+
+TEST_F(HistoryJournalTest, Rewrite)
+{
+	HistoryJournal journal(m_journalPath);
+	journal.Load();
+	journal.Append(BuildEntry(L"C:\\Fake1"));
+	journal.Append(BuildEntry(L"C:\\Fake2"));
+	journal.Append(BuildEntry(L"C:\\Fake3"));
+
+	EXPECT_TRUE(journal.Rewrite({ BuildEntry(L"C:\\Fake3") }));
+	EXPECT_EQ(journal.GetNumEntries(), 1U);
+
+	auto entries = journal.Load();
+	ASSERT_EQ(entries.size(), 1U);
+	EXPECT_EQ(entries[0].parsingPath, L"C:\\Fake3");
+}
+
+TEST_F(HistoryJournalTest, InvalidEntrySkipped)
+{
+	// The path here is longer than any path that would be accepted when reading the journal, so
+	// the entry won't be written.
+	HistoryJournal::Entry invalidEntry = { CreateSimplePidlForTest(L"C:\\Fake1"),
+		std::wstring(40'000, L'a') };
+
+	HistoryJournal journal(m_journalPath);
+	journal.Load();
+	EXPECT_TRUE(journal.Append(invalidEntry));
+	EXPECT_TRUE(journal.Append(BuildEntry(L"C:\\Fake2")));
+	EXPECT_EQ(journal.GetNumEntries(), 1U);
+
+	EXPECT_TRUE(journal.Rewrite({ invalidEntry, BuildEntry(L"C:\\Fake2") }));
+	EXPECT_EQ(journal.GetNumEntries(), 1U);
+
+	auto entries = journal.Load();
+	ASSERT_EQ(entries.size(), 1U);
+	EXPECT_EQ(entries[0].parsingPath, L"C:\\Fake2");
+}
+
+TEST_F(HistoryJournalTest, TruncatedEntry)
+{
+	{
+		HistoryJournal journal(m_journalPath);
+		journal.Load();
+		journal.Append(BuildEntry(L"C:\\Fake1"));
+		journal.Append(BuildEntry(L"C:\\Fake2"));
+	}
+
+	// Simulate a crash part of the way through writing the final entry.
+	std::filesystem::resize_file(m_journalPath, std::filesystem::file_size(m_journalPath) - 3);
+
+	HistoryJournal journal(m_journalPath);
+	auto entries = journal.Load();
+	ASSERT_EQ(entries.size(), 1U);
+	EXPECT_EQ(entries[0].parsingPath, L"C:\\Fake1");
+
+	// The partial entry should have been removed, so that new entries can be appended.
+	journal.Append(BuildEntry(L"C:\\Fake3"));
+
+	entries = HistoryJournal(m_journalPath).Load();
+	ASSERT_EQ(entries.size(), 2U);
+	EXPECT_EQ(entries[1].parsingPath, L"C:\\Fake3");
+}
+
+TEST_F(HistoryJournalTest, InvalidFile)
+{
+	{
+		std::ofstream stream(m_journalPath, std::ios::binary);
+		stream << "not a journal";
+	}
+
+	HistoryJournal journal(m_journalPath);
+	EXPECT_TRUE(journal.Load().empty());
+	EXPECT_TRUE(journal.Append(BuildEntry(L"C:\\Fake1")));
+
+	auto entries = HistoryJournal(m_journalPath).Load();
+	ASSERT_EQ(entries.size(), 1U);
+}
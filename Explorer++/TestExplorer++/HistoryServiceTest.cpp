@@ -4,7 +4,9 @@
 
 #include "pch.h"
 #include "HistoryService.h"
+#include "HistoryJournal.h"
 #include "ShellTestHelper.h"
+#include "TempFileTestHelper.h"
 #include "../Helper/ShellHelper.h"
 #include <gtest/gtest.h>
 
@@ -13,11 +15,10 @@ using namespace testing;
 TEST(HistoryServiceTest, RepeatedNavigation)
 {
 	HistoryService historyService;
-	const auto &history = historyService.GetHistoryItems();
 
 	PidlAbsolute pidl = CreateSimplePidlForTest(L"C:\\Fake");
 	historyService.AddHistoryItem(pidl);
-	EXPECT_EQ(history.size(), 1U);
+	EXPECT_EQ(historyService.GetNumHistoryItems(), 1U);
 
 	MockFunction<void()> callback;
 	historyService.AddHistoryChangedObserver(callback.AsStdFunction());
@@ -25,5 +26,133 @@ TEST(HistoryServiceTest, RepeatedNavigation)
 
 	// A repeated navigation to the most recent entry should be ignored.
 	historyService.AddHistoryItem(pidl);
-	EXPECT_EQ(history.size(), 1U);
+	EXPECT_EQ(historyService.GetNumHistoryItems(), 1U);
+}
+
+TEST(HistoryServiceTest, RevisitMovesToFront)
+{
+	HistoryService historyService;
+
+	PidlAbsolute pidl1 = CreateSimplePidlForTest(L"C:\\Fake1");
+	PidlAbsolute pidl2 = CreateSimplePidlForTest(L"C:\\Fake2");
+	historyService.AddHistoryItem(pidl1);
+	historyService.AddHistoryItem(pidl2);
+	historyService.AddHistoryItem(pidl1);
+
+	// Each location should only appear once.
+	auto history = historyService.GetHistoryItems();
+	ASSERT_EQ(history.size(), 2U);
+	EXPECT_EQ(history[0], pidl1);
+	EXPECT_EQ(history[1], pidl2);
+}
+
+TEST(HistoryServiceTest, MaxItems)
+{
+	HistoryService historyService(2);
+
+	PidlAbsolute pidl1 = CreateSimplePidlForTest(L"C:\\Fake1");
+	PidlAbsolute pidl2 = CreateSimplePidlForTest(L"C:\\Fake2");
+	PidlAbsolute pidl3 = CreateSimplePidlForTest(L"C:\\Fake3");
+	historyService.AddHistoryItem(pidl1);
+	historyService.AddHistoryItem(pidl2);
+	historyService.AddHistoryItem(pidl3);
+
+	// The oldest item should have been removed.
+	auto history = historyService.GetHistoryItems();
+	ASSERT_EQ(history.size(), 2U);
+	EXPECT_EQ(history[0], pidl3);
+	EXPECT_EQ(history[1], pidl2);
+
+	history = historyService.GetHistoryItems(1);
+	ASSERT_EQ(history.size(), 1U);
+	EXPECT_EQ(history[0], pidl3);
+}
+
+TEST(HistoryServiceTest, PrefixQuery)
+{
+	HistoryService historyService;
+
+	PidlAbsolute pidl1 = CreateSimplePidlForTest(L"C:\\Projects\\First");
+	PidlAbsolute pidl2 = CreateSimplePidlForTest(L"C:\\Documents");
+	PidlAbsolute pidl3 = CreateSimplePidlForTest(L"C:\\Projects\\Second");
+	historyService.AddHistoryItem(pidl1);
+	historyService.AddHistoryItem(pidl2);
+	historyService.AddHistoryItem(pidl3);
+
+	// Matching should be case-insensitive, with the most recent items returned first.
+	auto items = historyService.GetHistoryItemsWithPrefix(L"c:\\projects", 10);
+	ASSERT_EQ(items.size(), 2U);
+	EXPECT_EQ(items[0], pidl3);
+	EXPECT_EQ(items[1], pidl1);
+
+	items = historyService.GetHistoryItemsWithPrefix(L"C:\\Projects", 1);
+	ASSERT_EQ(items.size(), 1U);
+	EXPECT_EQ(items[0], pidl3);
+
+	items = historyService.GetHistoryItemsWithPrefix(L"D:\\", 10);
+	EXPECT_TRUE(items.empty());
+}
+
+class HistoryServiceJournalTest : public Test
+{
+protected:
+	const TempFileForTest m_journalFile{ L".dat" };
+	const std::filesystem::path m_journalPath = m_journalFile.GetPath();
+};
+
+TEST_F(HistoryServiceJournalTest, Persistence)
+{
+	PidlAbsolute pidl1 = CreateSimplePidlForTest(L"C:\\Fake1");
+	PidlAbsolute pidl2 = CreateSimplePidlForTest(L"C:\\Fake2");
+
+	{
+		HistoryService historyService;
+		historyService.SetJournal(std::make_unique<HistoryJournal>(m_journalPath));
+		historyService.AddHistoryItem(pidl1);
+		historyService.AddHistoryItem(pidl2);
+		historyService.AddHistoryItem(pidl1);
+	}
+
+	HistoryService historyService;
+
+	MockFunction<void()> callback;
+	historyService.AddHistoryChangedObserver(callback.AsStdFunction());
+	EXPECT_CALL(callback, Call()).Times(1);
+
+	historyService.SetJournal(std::make_unique<HistoryJournal>(m_journalPath));
+
+	auto history = historyService.GetHistoryItems();
+	ASSERT_EQ(history.size(), 2U);
+	EXPECT_EQ(history[0], pidl1);
+	EXPECT_EQ(history[1], pidl2);
+}
+
+TEST_F(HistoryServiceJournalTest, Compaction)
+{
+	const size_t maxItems = 2;
+	std::vector<PidlAbsolute> pidls;
+
+	{
+		HistoryService historyService(maxItems);
+		auto journal = std::make_unique<HistoryJournal>(m_journalPath);
+		auto *rawJournal = journal.get();
+		historyService.SetJournal(std::move(journal));
+
+		for (int i = 0; i < 10; i++)
+		{
+			pidls.push_back(CreateSimplePidlForTest(std::format(L"C:\\Fake{}", i)));
+			historyService.AddHistoryItem(pidls.back());
+
+			// The journal should never be allowed to grow without bound.
+			EXPECT_LE(rawJournal->GetNumEntries(), maxItems * 2);
+		}
+	}
+
+	HistoryService historyService(maxItems);
+	historyService.SetJournal(std::make_unique<HistoryJournal>(m_journalPath));
+
+	auto history = historyService.GetHistoryItems();
+	ASSERT_EQ(history.size(), maxItems);
+	EXPECT_EQ(history[0], pidls[9]);
+	EXPECT_EQ(history[1], pidls[8]);
 }
@@ -0,0 +1,102 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "ShellBrowser/ItemPredicates.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+WIN32_FIND_DATA BuildFindData(const std::wstring &name, DWORD attributes, uint64_t size,
+	uint64_t lastWriteTime)
+{
+	WIN32_FIND_DATA findData = {};
+	StringCchCopy(findData.cFileName, std::size(findData.cFileName), name.c_str());
+	findData.dwFileAttributes = attributes;
+
+	ULARGE_INTEGER largeSize;
+	largeSize.QuadPart = size;
+	findData.nFileSizeLow = largeSize.LowPart;
+	findData.nFileSizeHigh = largeSize.HighPart;
+
+	ULARGE_INTEGER largeTime;
+	largeTime.QuadPart = lastWriteTime;
+	findData.ftLastWriteTime = { largeTime.LowPart, largeTime.HighPart };
+
+	return findData;
+}
+
+FILETIME BuildFileTime(uint64_t time)
+{
+	ULARGE_INTEGER largeTime;
+	largeTime.QuadPart = time;
+	return { largeTime.LowPart, largeTime.HighPart };
+}
+
+}
+
+TEST(ItemPredicatesTest, Wildcard)
+{
+	auto predicate = ItemPredicates::MatchesWildcard(L"*.txt", false);
+
+	EXPECT_TRUE(predicate(BuildFindData(L"Notes.TXT", FILE_ATTRIBUTE_NORMAL, 0, 0), true));
+	EXPECT_TRUE(predicate(BuildFindData(L"notes.txt", FILE_ATTRIBUTE_NORMAL, 0, 0), false));
+	EXPECT_FALSE(predicate(BuildFindData(L"notes.doc", FILE_ATTRIBUTE_NORMAL, 0, 0), true));
+}
+
+TEST(ItemPredicatesTest, Regex)
+{
+	auto predicate = ItemPredicates::MatchesRegex(L"^img_\\d+\\.jpg$", false);
+	ASSERT_TRUE(predicate.has_value());
+
+	EXPECT_TRUE((*predicate)(BuildFindData(L"IMG_1234.jpg", FILE_ATTRIBUTE_NORMAL, 0, 0), true));
+	EXPECT_FALSE((*predicate)(BuildFindData(L"IMG_abc.jpg", FILE_ATTRIBUTE_NORMAL, 0, 0), true));
+
+	EXPECT_FALSE(ItemPredicates::MatchesRegex(L"(unclosed", false).has_value());
+}
+
+TEST(ItemPredicatesTest, Attributes)
+{
+	auto predicate = ItemPredicates::HasAttributes(FILE_ATTRIBUTE_HIDDEN | FILE_ATTRIBUTE_SYSTEM);
+
+	EXPECT_TRUE(predicate(
+		BuildFindData(L"file", FILE_ATTRIBUTE_HIDDEN | FILE_ATTRIBUTE_SYSTEM, 0, 0), true));
+	EXPECT_FALSE(predicate(BuildFindData(L"file", FILE_ATTRIBUTE_HIDDEN, 0, 0), true));
+
+	// Attributes can't be checked if the find data isn't valid.
+	EXPECT_FALSE(predicate(
+		BuildFindData(L"file", FILE_ATTRIBUTE_HIDDEN | FILE_ATTRIBUTE_SYSTEM, 0, 0), false));
+}
+
+TEST(ItemPredicatesTest, Size)
+{
+	auto predicate = ItemPredicates::SizeInRange(100, 0x100000000);
+
+	EXPECT_TRUE(predicate(BuildFindData(L"file", FILE_ATTRIBUTE_NORMAL, 100, 0), true));
+	EXPECT_TRUE(predicate(BuildFindData(L"file", FILE_ATTRIBUTE_NORMAL, 0x100000000, 0), true));
+	EXPECT_FALSE(predicate(BuildFindData(L"file", FILE_ATTRIBUTE_NORMAL, 99, 0), true));
+	EXPECT_FALSE(predicate(BuildFindData(L"file", FILE_ATTRIBUTE_NORMAL, 0x100000001, 0), true));
+	EXPECT_FALSE(predicate(BuildFindData(L"folder", FILE_ATTRIBUTE_DIRECTORY, 200, 0), true));
+}
+
+TEST(ItemPredicatesTest, ModifiedDate)
+{
+	auto predicate = ItemPredicates::ModifiedInRange(BuildFileTime(1000), BuildFileTime(2000));
+
+	EXPECT_TRUE(predicate(BuildFindData(L"file", FILE_ATTRIBUTE_NORMAL, 0, 1000), true));
+	EXPECT_TRUE(predicate(BuildFindData(L"file", FILE_ATTRIBUTE_NORMAL, 0, 2000), true));
+	EXPECT_FALSE(predicate(BuildFindData(L"file", FILE_ATTRIBUTE_NORMAL, 0, 999), true));
+	EXPECT_FALSE(predicate(BuildFindData(L"file", FILE_ATTRIBUTE_NORMAL, 0, 2001), true));
+}
+
+TEST(ItemPredicatesTest, All)
+{
+	auto predicate = ItemPredicates::All({ ItemPredicates::MatchesWildcard(L"*.log", false),
+		ItemPredicates::SizeInRange(1000, UINT64_MAX) });
+
+	EXPECT_TRUE(predicate(BuildFindData(L"app.log", FILE_ATTRIBUTE_NORMAL, 5000, 0), true));
+	EXPECT_FALSE(predicate(BuildFindData(L"app.log", FILE_ATTRIBUTE_NORMAL, 10, 0), true));
+	EXPECT_FALSE(predicate(BuildFindData(L"app.txt", FILE_ATTRIBUTE_NORMAL, 5000, 0), true));
+}
@@ -0,0 +1,382 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "Plugins/ItemsApi/ItemsApi.h"
+#include "Plugins/ApiBinding.h"
+#include "ShellBrowser/ItemSource.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <sol/sol.hpp>
+#include <algorithm>
+#include <unordered_map>
+
+using namespace testing;
+
+namespace
+{
+
+class ItemSourceFake : public ItemSource
+{
+public:
+	void AddItem(const std::wstring &name, DWORD attributes, uint64_t size, int64_t modified)
+	{
+		WIN32_FIND_DATA findData = {};
+		StringCchCopy(findData.cFileName, std::size(findData.cFileName), name.c_str());
+		findData.dwFileAttributes = attributes;
+
+		ULARGE_INTEGER largeSize;
+		largeSize.QuadPart = size;
+		findData.nFileSizeLow = largeSize.LowPart;
+		findData.nFileSizeHigh = largeSize.HighPart;
+
+		findData.ftLastWriteTime = Plugins::UnixTimeToFileTime(modified);
+
+		m_items.push_back({ findData, false });
+	}
+
+	void BumpItemStorageVersion()
+	{
+		m_itemStorageVersion++;
+	}
+
+	bool IsSelected(int internalIndex) const
+	{
+		return m_items.at(internalIndex).selected;
+	}
+
+	int GetNumItems() const override
+	{
+		return static_cast<int>(m_items.size());
+	}
+
+	int GetNumSelected() const override
+	{
+		return static_cast<int>(std::count_if(m_items.begin(), m_items.end(),
+			[](const auto &item) { return item.selected; }));
+	}
+
+	void VisitItems(const ItemVisitor &visitor, bool selectedOnly) const override
+	{
+		for (size_t i = 0; i < m_items.size(); i++)
+		{
+			if (selectedOnly && !m_items[i].selected)
+			{
+				continue;
+			}
+
+			visitor(static_cast<int>(i), m_items[i].findData, true);
+		}
+	}
+
+	uint64_t GetItemStorageVersion() const override
+	{
+		return m_itemStorageVersion;
+	}
+
+	void SelectItemsMatchingPredicate(const ItemPredicate &predicate, bool select) override
+	{
+		for (auto &item : m_items)
+		{
+			if (predicate(item.findData, true))
+			{
+				item.selected = select;
+			}
+		}
+	}
+
+	void SelectItemsByInternalIndex(const std::unordered_set<int> &internalIndexes,
+		bool select) override
+	{
+		for (int internalIndex : internalIndexes)
+		{
+			m_items.at(internalIndex).selected = select;
+		}
+	}
+
+private:
+	struct Item
+	{
+		WIN32_FIND_DATA findData;
+		bool selected;
+	};
+
+	std::vector<Item> m_items;
+	uint64_t m_itemStorageVersion = 0;
+};
+
+std::vector<int> GetInternalIndexes(const std::optional<std::vector<Plugins::ItemView>> &views)
+{
+	std::vector<int> internalIndexes;
+
+	for (const auto &view : views.value())
+	{
+		internalIndexes.push_back(view.getInternalIndex());
+	}
+
+	return internalIndexes;
+}
+
+}
+
+class ItemsApiTest : public Test
+{
+protected:
+	static constexpr int TAB_ID = 1;
+	static constexpr int OTHER_TAB_ID = 2;
+
+	ItemsApiTest() :
+		m_itemsApi(
+			[this](int tabId) -> std::shared_ptr<ItemSource>
+			{
+				auto itr = m_itemSources.find(tabId);
+
+				if (itr == m_itemSources.end())
+				{
+					return nullptr;
+				}
+
+				return itr->second;
+			})
+	{
+		m_state.open_libraries(sol::lib::base);
+
+		sol::table itemsTable = m_state.create_named_table("items");
+		Plugins::BindItemViewType(itemsTable);
+
+		m_itemSources[TAB_ID] = std::make_shared<ItemSourceFake>();
+		m_itemSources[OTHER_TAB_ID] = std::make_shared<ItemSourceFake>();
+	}
+
+	ItemSourceFake *GetItemSource(int tabId)
+	{
+		return m_itemSources.at(tabId).get();
+	}
+
+	sol::table BuildViewsTable(const std::vector<Plugins::ItemView> &views)
+	{
+		sol::table viewsTable = m_state.create_table();
+
+		for (const auto &view : views)
+		{
+			viewsTable.add(view);
+		}
+
+		return viewsTable;
+	}
+
+	sol::state m_state;
+	std::unordered_map<int, std::shared_ptr<ItemSourceFake>> m_itemSources;
+	Plugins::ItemsApi m_itemsApi;
+};
+
+TEST_F(ItemsApiTest, UnknownTab)
+{
+	EXPECT_EQ(m_itemsApi.count(3), std::nullopt);
+	EXPECT_EQ(m_itemsApi.getAll(3), std::nullopt);
+	EXPECT_FALSE(m_itemsApi.select(3, m_state.create_table(), sol::nullopt));
+}
+
+TEST_F(ItemsApiTest, ViewsInvalidatedWhenStorageVersionChanges)
+{
+	auto *itemSource = GetItemSource(TAB_ID);
+	itemSource->AddItem(L"file1.txt", FILE_ATTRIBUTE_NORMAL, 100, 0);
+	itemSource->AddItem(L"file2.txt", FILE_ATTRIBUTE_NORMAL, 200, 0);
+
+	auto views = m_itemsApi.getAll(TAB_ID);
+	ASSERT_TRUE(views.has_value());
+	ASSERT_EQ(views->size(), 2u);
+
+	for (const auto &view : *views)
+	{
+		EXPECT_TRUE(view.isValid());
+		EXPECT_TRUE(view.getSize().has_value());
+	}
+
+	itemSource->BumpItemStorageVersion();
+
+	for (const auto &view : *views)
+	{
+		EXPECT_FALSE(view.isValid());
+		EXPECT_EQ(view.getSize(), std::nullopt);
+	}
+}
+
+TEST_F(ItemsApiTest, ViewsInvalidatedWhenItemSourceDestroyed)
+{
+	GetItemSource(TAB_ID)->AddItem(L"file.txt", FILE_ATTRIBUTE_NORMAL, 100, 0);
+
+	auto views = m_itemsApi.getAll(TAB_ID);
+	ASSERT_TRUE(views.has_value());
+	ASSERT_EQ(views->size(), 1u);
+	EXPECT_TRUE((*views)[0].isValid());
+
+	m_itemSources.erase(TAB_ID);
+	EXPECT_FALSE((*views)[0].isValid());
+}
+
+TEST_F(ItemsApiTest, SetSelectedIgnoresViewsFromOtherTabs)
+{
+	auto *itemSource = GetItemSource(TAB_ID);
+	itemSource->AddItem(L"file1.txt", FILE_ATTRIBUTE_NORMAL, 100, 0);
+	itemSource->AddItem(L"file2.txt", FILE_ATTRIBUTE_NORMAL, 200, 0);
+
+	auto *otherItemSource = GetItemSource(OTHER_TAB_ID);
+	otherItemSource->AddItem(L"other1.txt", FILE_ATTRIBUTE_NORMAL, 100, 0);
+	otherItemSource->AddItem(L"other2.txt", FILE_ATTRIBUTE_NORMAL, 200, 0);
+
+	auto views = m_itemsApi.getAll(TAB_ID);
+	auto otherViews = m_itemsApi.getAll(OTHER_TAB_ID);
+	ASSERT_TRUE(views.has_value());
+	ASSERT_TRUE(otherViews.has_value());
+
+	// The view from the other tab has the same internal index as the second item in this tab, so
+	// selecting it would be incorrect.
+	std::vector<Plugins::ItemView> mixedViews = { (*views)[0], (*otherViews)[1] };
+	EXPECT_TRUE(m_itemsApi.setSelected(TAB_ID, BuildViewsTable(mixedViews), sol::nullopt));
+
+	EXPECT_TRUE(itemSource->IsSelected(0));
+	EXPECT_FALSE(itemSource->IsSelected(1));
+	EXPECT_FALSE(otherItemSource->IsSelected(0));
+	EXPECT_FALSE(otherItemSource->IsSelected(1));
+}
+
+TEST_F(ItemsApiTest, SetSelectedIgnoresStaleViews)
+{
+	auto *itemSource = GetItemSource(TAB_ID);
+	itemSource->AddItem(L"file1.txt", FILE_ATTRIBUTE_NORMAL, 100, 0);
+	itemSource->AddItem(L"file2.txt", FILE_ATTRIBUTE_NORMAL, 200, 0);
+
+	auto views = m_itemsApi.getAll(TAB_ID);
+	ASSERT_TRUE(views.has_value());
+
+	itemSource->BumpItemStorageVersion();
+
+	EXPECT_TRUE(m_itemsApi.setSelected(TAB_ID, BuildViewsTable(*views), sol::nullopt));
+	EXPECT_EQ(itemSource->GetNumSelected(), 0);
+}
+
+TEST_F(ItemsApiTest, SetSelectedDeselects)
+{
+	auto *itemSource = GetItemSource(TAB_ID);
+	itemSource->AddItem(L"file1.txt", FILE_ATTRIBUTE_NORMAL, 100, 0);
+	itemSource->AddItem(L"file2.txt", FILE_ATTRIBUTE_NORMAL, 200, 0);
+	itemSource->SelectItemsByInternalIndex({ 0, 1 }, true);
+
+	auto views = m_itemsApi.getSelected(TAB_ID);
+	ASSERT_TRUE(views.has_value());
+	ASSERT_EQ(views->size(), 2u);
+
+	std::vector<Plugins::ItemView> firstView = { (*views)[0] };
+	EXPECT_TRUE(m_itemsApi.setSelected(TAB_ID, BuildViewsTable(firstView), false));
+
+	EXPECT_FALSE(itemSource->IsSelected(0));
+	EXPECT_TRUE(itemSource->IsSelected(1));
+}
+
+TEST_F(ItemsApiTest, InvalidRegex)
+{
+	auto *itemSource = GetItemSource(TAB_ID);
+	itemSource->AddItem(L"file.txt", FILE_ATTRIBUTE_NORMAL, 100, 0);
+
+	auto filter = m_state.create_table_with("regex", "(unclosed");
+
+	EXPECT_EQ(m_itemsApi.filter(TAB_ID, filter), std::nullopt);
+	EXPECT_FALSE(m_itemsApi.select(TAB_ID, filter, sol::nullopt));
+	EXPECT_EQ(itemSource->GetNumSelected(), 0);
+}
+
+TEST_F(ItemsApiTest, SizeBounds)
+{
+	auto *itemSource = GetItemSource(TAB_ID);
+	itemSource->AddItem(L"file1.txt", FILE_ATTRIBUTE_NORMAL, 100, 0);
+	itemSource->AddItem(L"file2.txt", FILE_ATTRIBUTE_NORMAL, 200, 0);
+	itemSource->AddItem(L"file3.txt", FILE_ATTRIBUTE_NORMAL, 300, 0);
+	itemSource->AddItem(L"folder", FILE_ATTRIBUTE_DIRECTORY, 0, 0);
+
+	// Both bounds are inclusive.
+	EXPECT_THAT(GetInternalIndexes(m_itemsApi.filter(TAB_ID,
+					m_state.create_table_with("minSize", 200, "maxSize", 300))),
+		ElementsAre(1, 2));
+
+	EXPECT_THAT(GetInternalIndexes(
+					m_itemsApi.filter(TAB_ID, m_state.create_table_with("minSize", 300))),
+		ElementsAre(2));
+
+	// Folders don't have a size, so they aren't matched, even when only an upper bound is set.
+	EXPECT_THAT(GetInternalIndexes(
+					m_itemsApi.filter(TAB_ID, m_state.create_table_with("maxSize", 100))),
+		ElementsAre(0));
+
+	EXPECT_THAT(GetInternalIndexes(m_itemsApi.filter(TAB_ID,
+					m_state.create_table_with("minSize", 301, "maxSize", 1000))),
+		IsEmpty());
+}
+
+TEST_F(ItemsApiTest, ModifiedBounds)
+{
+	auto *itemSource = GetItemSource(TAB_ID);
+	itemSource->AddItem(L"file1.txt", FILE_ATTRIBUTE_NORMAL, 0, 1'000'000);
+	itemSource->AddItem(L"file2.txt", FILE_ATTRIBUTE_NORMAL, 0, 2'000'000);
+	itemSource->AddItem(L"file3.txt", FILE_ATTRIBUTE_NORMAL, 0, 3'000'000);
+
+	EXPECT_THAT(GetInternalIndexes(m_itemsApi.filter(TAB_ID,
+					m_state.create_table_with("modifiedAfter", 2'000'000))),
+		ElementsAre(1, 2));
+
+	EXPECT_THAT(GetInternalIndexes(m_itemsApi.filter(TAB_ID,
+					m_state.create_table_with("modifiedBefore", 2'000'000))),
+		ElementsAre(0, 1));
+
+	EXPECT_THAT(GetInternalIndexes(m_itemsApi.filter(TAB_ID,
+					m_state.create_table_with("modifiedAfter", 2'000'000, "modifiedBefore",
+						2'000'000))),
+		ElementsAre(1));
+
+	EXPECT_THAT(GetInternalIndexes(m_itemsApi.filter(TAB_ID,
+					m_state.create_table_with("modifiedAfter", 3'000'001))),
+		IsEmpty());
+}
+
+TEST_F(ItemsApiTest, ForEach)
+{
+	auto *itemSource = GetItemSource(TAB_ID);
+	itemSource->AddItem(L"file1.txt", FILE_ATTRIBUTE_NORMAL, 100, 0);
+	itemSource->AddItem(L"file2.txt", FILE_ATTRIBUTE_NORMAL, 200, 0);
+	itemSource->AddItem(L"file3.txt", FILE_ATTRIBUTE_NORMAL, 300, 0);
+
+	m_state.script(R"(
+		totalSize = 0
+
+		function sumSizes(view)
+			totalSize = totalSize + view.size
+		end
+	)");
+
+	// A callback that doesn't return anything visits every item.
+	sol::protected_function callback = m_state["sumSizes"];
+	EXPECT_EQ(m_itemsApi.forEach(TAB_ID, callback), 3);
+	EXPECT_EQ(m_state.get<int>("totalSize"), 600);
+}
+
+TEST_F(ItemsApiTest, ForEachStopsEarly)
+{
+	auto *itemSource = GetItemSource(TAB_ID);
+	itemSource->AddItem(L"file1.txt", FILE_ATTRIBUTE_NORMAL, 100, 0);
+	itemSource->AddItem(L"file2.txt", FILE_ATTRIBUTE_NORMAL, 200, 0);
+	itemSource->AddItem(L"file3.txt", FILE_ATTRIBUTE_NORMAL, 300, 0);
+
+	m_state.script(R"(
+		numCalls = 0
+
+		function stopAfterSecond(view)
+			numCalls = numCalls + 1
+			return numCalls < 2
+		end
+	)");
+
+	sol::protected_function callback = m_state["stopAfterSecond"];
+	EXPECT_EQ(m_itemsApi.forEach(TAB_ID, callback), 2);
+	EXPECT_EQ(m_state.get<int>("numCalls"), 2);
+}
@@ -0,0 +1,104 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "../Helper/ListViewHelper.h"
+#include <gtest/gtest.h>
+#include <CommCtrl.h>
+#include <format>
+
+using namespace testing;
+
+class ListViewScrollPositionTest : public Test
+{
+protected:
+	void SetUp() override
+	{
+		// As with the other control tests, there's no message loop here. The window is never
+		// visible and the listview messages used below are all sent directly.
+		m_listView = CreateWindow(WC_LISTVIEW, L"", WS_POPUP | LVS_REPORT, 0, 0, 200, 200,
+			nullptr, nullptr, GetModuleHandle(nullptr), nullptr);
+		ASSERT_NE(m_listView, nullptr);
+
+		LVCOLUMN column = {};
+		column.mask = LVCF_WIDTH;
+		column.cx = 100;
+		int res = ListView_InsertColumn(m_listView, 0, &column);
+		ASSERT_NE(res, -1);
+	}
+
+	void TearDown() override
+	{
+		auto res = DestroyWindow(m_listView);
+		ASSERT_TRUE(res);
+	}
+
+	void AddItems(int numItems)
+	{
+		for (int i = 0; i < numItems; i++)
+		{
+			std::wstring text = std::format(L"Item {}", i);
+
+			LVITEM item = {};
+			item.mask = LVIF_TEXT;
+			item.iItem = i;
+			item.pszText = text.data();
+			int index = ListView_InsertItem(m_listView, &item);
+			ASSERT_EQ(index, i);
+		}
+	}
+
+	// This is what happens when a tab is hibernated and then woken; the items are removed and then
+	// added again.
+	void ReplaceItems(int numItems)
+	{
+		ListView_DeleteAllItems(m_listView);
+		AddItems(numItems);
+	}
+
+	HWND m_listView = nullptr;
+};
+
+TEST_F(ListViewScrollPositionTest, RestoreAfterItemsReplaced)
+{
+	AddItems(100);
+	ListView_EnsureVisible(m_listView, 50, false);
+
+	auto scrollPosition = ListViewHelper::GetScrollPosition(m_listView);
+	EXPECT_GT(scrollPosition.topIndex, 0);
+
+	ReplaceItems(100);
+	EXPECT_EQ(ListView_GetTopIndex(m_listView), 0);
+
+	ListViewHelper::SetScrollPosition(m_listView, scrollPosition);
+	EXPECT_EQ(ListView_GetTopIndex(m_listView), scrollPosition.topIndex);
+}
+
+TEST_F(ListViewScrollPositionTest, RestoreWithFewerItems)
+{
+	AddItems(100);
+	ListView_EnsureVisible(m_listView, 99, false);
+
+	auto scrollPosition = ListViewHelper::GetScrollPosition(m_listView);
+	EXPECT_GT(scrollPosition.topIndex, 20);
+
+	// The original position no longer exists, so the listview should be scrolled as far as
+	// possible instead.
+	ReplaceItems(20);
+	ListViewHelper::SetScrollPosition(m_listView, scrollPosition);
+	EXPECT_GT(ListView_GetTopIndex(m_listView), 0);
+	EXPECT_LT(ListView_GetTopIndex(m_listView), 20);
+}
+
+TEST_F(ListViewScrollPositionTest, RestoreWithNoItems)
+{
+	AddItems(100);
+	ListView_EnsureVisible(m_listView, 50, false);
+
+	auto scrollPosition = ListViewHelper::GetScrollPosition(m_listView);
+
+	ReplaceItems(0);
+	ListViewHelper::SetScrollPosition(m_listView, scrollPosition);
+	EXPECT_EQ(ListView_GetTopIndex(m_listView), 0);
+}
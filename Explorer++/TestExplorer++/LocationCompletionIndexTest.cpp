@@ -0,0 +1,133 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "LocationCompletionIndex.h"
+#include "LocationVisitInfo.h"
+#include "ShellTestHelper.h"
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+class LocationCompletionIndexTest : public Test
+{
+protected:
+	LocationCompletionIndexTest() : m_index(m_referenceTime)
+	{
+	}
+
+	static double BuildVisitScore(int numVisits, LocationVisitInfo::Clock::time_point visitTime)
+	{
+		LocationVisitInfo visitInfo(CreateSimplePidlForTest(L"C:\\Fake"), visitTime);
+
+		for (int i = 1; i < numVisits; i++)
+		{
+			visitInfo.AddVisit(visitTime);
+		}
+
+		return visitInfo.GetScore();
+	}
+
+	const LocationCompletionIndex::Clock::time_point m_referenceTime =
+		LocationCompletionIndex::Clock::now();
+	LocationCompletionIndex m_index;
+};
+
+TEST_F(LocationCompletionIndexTest, PrefixMatch)
+{
+	m_index.AddLocation(L"C:\\Windows", LocationCompletionIndex::Source::History);
+	m_index.AddLocation(L"C:\\Windows\\System32", LocationCompletionIndex::Source::History);
+	m_index.AddLocation(L"C:\\Users", LocationCompletionIndex::Source::History);
+	m_index.AddLocation(L"D:\\Windows", LocationCompletionIndex::Source::History);
+
+	EXPECT_THAT(m_index.Query(L"C:\\Win", 10),
+		ElementsAre(L"C:\\Windows", L"C:\\Windows\\System32"));
+	EXPECT_THAT(m_index.Query(L"C:\\", 10),
+		ElementsAre(L"C:\\Windows", L"C:\\Windows\\System32", L"C:\\Users"));
+	EXPECT_THAT(m_index.Query(L"E:\\", 10), IsEmpty());
+	EXPECT_THAT(m_index.Query(L"", 10), IsEmpty());
+}
+
+TEST_F(LocationCompletionIndexTest, CaseInsensitive)
+{
+	m_index.AddLocation(L"C:\\Windows", LocationCompletionIndex::Source::History);
+
+	// The path should be returned as it was added, regardless of the case of the query.
+	EXPECT_THAT(m_index.Query(L"c:\\wIN", 10), ElementsAre(L"C:\\Windows"));
+}
+
+TEST_F(LocationCompletionIndexTest, MaxResults)
+{
+	for (int i = 0; i < 10; i++)
+	{
+		m_index.AddLocation(L"C:\\Folder" + std::to_wstring(i),
+			LocationCompletionIndex::Source::History);
+	}
+
+	EXPECT_THAT(m_index.Query(L"C:\\Folder", 3),
+		ElementsAre(L"C:\\Folder0", L"C:\\Folder1", L"C:\\Folder2"));
+	EXPECT_THAT(m_index.Query(L"C:\\Folder", 0), IsEmpty());
+}
+
+TEST_F(LocationCompletionIndexTest, RankedByVisits)
+{
+	m_index.AddLocation(L"C:\\Folder1", LocationCompletionIndex::Source::FrequentLocations,
+		BuildVisitScore(1, m_referenceTime));
+	m_index.AddLocation(L"C:\\Folder2", LocationCompletionIndex::Source::FrequentLocations,
+		BuildVisitScore(10, m_referenceTime));
+	m_index.AddLocation(L"C:\\Folder3", LocationCompletionIndex::Source::FrequentLocations,
+		BuildVisitScore(5, m_referenceTime));
+
+	EXPECT_THAT(m_index.Query(L"C:\\", 10),
+		ElementsAre(L"C:\\Folder2", L"C:\\Folder3", L"C:\\Folder1"));
+}
+
+TEST_F(LocationCompletionIndexTest, RankedByRecency)
+{
+	using namespace std::chrono_literals;
+
+	m_index.AddLocation(L"C:\\Folder1", LocationCompletionIndex::Source::FrequentLocations,
+		BuildVisitScore(4, m_referenceTime - 4 * LocationVisitInfo::VISIT_HALF_LIFE));
+	m_index.AddLocation(L"C:\\Folder2", LocationCompletionIndex::Source::FrequentLocations,
+		BuildVisitScore(4, m_referenceTime - 1h));
+
+	// This location has been visited more than the first location, but it was last visited more
+	// than one half-life earlier, so should be ranked lower.
+	m_index.AddLocation(L"C:\\Folder3", LocationCompletionIndex::Source::FrequentLocations,
+		BuildVisitScore(7, m_referenceTime - 6 * LocationVisitInfo::VISIT_HALF_LIFE));
+
+	EXPECT_THAT(m_index.Query(L"C:\\", 10),
+		ElementsAre(L"C:\\Folder2", L"C:\\Folder1", L"C:\\Folder3"));
+}
+
+TEST_F(LocationCompletionIndexTest, BookmarksRankedHigher)
+{
+	m_index.AddLocation(L"C:\\Folder1", LocationCompletionIndex::Source::History);
+	m_index.AddLocation(L"C:\\Folder2", LocationCompletionIndex::Source::Bookmarks);
+
+	EXPECT_THAT(m_index.Query(L"C:\\", 10), ElementsAre(L"C:\\Folder2", L"C:\\Folder1"));
+}
+
+TEST_F(LocationCompletionIndexTest, MergeSources)
+{
+	m_index.AddLocation(L"C:\\Folder1", LocationCompletionIndex::Source::History);
+	m_index.AddLocation(L"C:\\Folder2", LocationCompletionIndex::Source::History);
+
+	// The same location added from a different source (and with different case) should be merged
+	// into the existing entry, with the visit information being used to rank it.
+	m_index.AddLocation(L"c:\\folder2", LocationCompletionIndex::Source::FrequentLocations,
+		BuildVisitScore(3, m_referenceTime));
+
+	EXPECT_EQ(m_index.GetNumLocations(), 2U);
+	EXPECT_THAT(m_index.Query(L"C:\\", 10), ElementsAre(L"C:\\Folder2", L"C:\\Folder1"));
+}
+
+TEST_F(LocationCompletionIndexTest, Clear)
+{
+	m_index.AddLocation(L"C:\\Windows", LocationCompletionIndex::Source::History);
+	m_index.Clear();
+
+	EXPECT_EQ(m_index.GetNumLocations(), 0U);
+	EXPECT_THAT(m_index.Query(L"C:\\", 10), IsEmpty());
+}
@@ -6,77 +6,130 @@
 #include "PasteSymLinksClient.h"
 #include "PasteSymLinksServer.h"
 #include <gtest/gtest.h>
+#include <format>
 
 using namespace std::chrono_literals;
 
-TEST(PasteSymLinksServerClientTest, ClientSendsResultsNormally)
+namespace
 {
-	PasteSymLinksServer server;
 
-	ClipboardOperations::PastedItems pastedItems = {
-		{ L"C:\\file1", {} },
-		{ L"C:\\file2", { ERROR_ACCESS_DENIED, std::system_category() } },
-		{ L"C:\\file3", {} },
-	};
+ClipboardOperations::PastedItem CreateFakeLink(const std::wstring &sourcePath)
+{
+	return { L"D:\\" + sourcePath, {} };
+}
+
+ClipboardOperations::PastedItems RunServerAndClient(const std::vector<std::wstring> &sourcePaths,
+	PasteSymLinksClient::LinkCreator linkCreator)
+{
+	PasteSymLinksServer server;
 
 	std::jthread thread;
 
-	auto clientThreadBody = [&pastedItems]
+	auto clientLauncher = [&thread, &linkCreator]
 	{
-		PasteSymLinksClient client;
-		client.NotifyServerOfResult(pastedItems);
+		thread = std::jthread(
+			[&linkCreator]
+			{
+				PasteSymLinksClient client;
+				client.CreateLinksAndNotifyServer(linkCreator, 5s);
+			});
+		return true;
 	};
 
-	auto clientLauncher = [&thread, clientThreadBody]
+	return server.LaunchClientAndWaitForResponse(sourcePaths, clientLauncher, 5s);
+}
+
+}
+
+TEST(PasteSymLinksServerClientTest, ClientSendsResultsNormally)
+{
+	std::vector<std::wstring> sourcePaths = { L"C:\\file1", L"C:\\file2", L"C:\\file3" };
+
+	auto linkCreator = [](const std::wstring &sourcePath) -> ClipboardOperations::PastedItem
 	{
-		thread = std::jthread(clientThreadBody);
-		return true;
+		if (sourcePath == L"C:\\file2")
+		{
+			return { sourcePath, { ERROR_ACCESS_DENIED, std::system_category() } };
+		}
+
+		return { sourcePath, {} };
+	};
+
+	ClipboardOperations::PastedItems expectedItems = {
+		{ L"C:\\file1", {} },
+		{ L"C:\\file2", { ERROR_ACCESS_DENIED, std::system_category() } },
+		{ L"C:\\file3", {} },
 	};
 
-	auto receivedItems = server.LaunchClientAndWaitForResponse(clientLauncher, 1s);
-	EXPECT_EQ(receivedItems, pastedItems);
+	auto receivedItems = RunServerAndClient(sourcePaths, linkCreator);
+	EXPECT_EQ(receivedItems, expectedItems);
 }
 
-TEST(PasteSymLinksServerClientTest, DataGreaterThanMaxSize)
+TEST(PasteSymLinksServerClientTest, NoItems)
 {
-	PasteSymLinksServer server;
+	auto receivedItems = RunServerAndClient({}, CreateFakeLink);
+	EXPECT_TRUE(receivedItems.empty());
+}
 
-	std::jthread thread;
+TEST(PasteSymLinksServerClientTest, DataGreaterThanSharedMemorySize)
+{
+	// The total size of the requests and results here is many times the size of the shared memory
+	// segment, so they can only be transferred if they're streamed.
+	std::vector<std::wstring> sourcePaths;
+	ClipboardOperations::PastedItems expectedItems;
 
-	auto clientThreadBody = []
+	for (int i = 0; i < 5000; i++)
 	{
-		// It's not realistic for an individual file path to be this long in practice. But if there
-		// are a large number of files on the clipboard and symlinks to those files are pasted, the
-		// memory limit could be reached. So, this is a simple way of simulating a situation where
-		// the serialized data is larger than the shared memory segment.
-		// Note that SHARED_MEMORY_SIZE is in bytes and the path here is a std::wstring, so the
-		// string will take twice that number of bytes. It's therefore guaranteed to not fit in the
-		// shared memory segment.
-		auto filePath =
-			L"C:\\" + std::wstring(PasteSymLinksServerClientBase::SHARED_MEMORY_SIZE, '0');
-		ClipboardOperations::PastedItems pastedItems = { { filePath, {} } };
-
-		PasteSymLinksClient client;
-		client.NotifyServerOfResult(pastedItems);
-	};
+		auto sourcePath = std::format(L"C:\\{}\\{}", std::wstring(200, 'a'), i);
+		sourcePaths.push_back(sourcePath);
+		expectedItems.push_back(CreateFakeLink(sourcePath));
+	}
+
+	auto receivedItems = RunServerAndClient(sourcePaths, CreateFakeLink);
+	EXPECT_EQ(receivedItems, expectedItems);
+}
+
+TEST(PasteSymLinksServerClientTest, MessageGreaterThanChannelSize)
+{
+	// It's not realistic for an individual file path to be this long in practice, but a single
+	// message should still be able to be larger than the channel that it's sent through.
+	auto sourcePath =
+		L"C:\\" + std::wstring(PasteSymLinksServerClientBase::SHARED_MEMORY_SIZE, '0');
 
-	auto clientLauncher = [&thread, clientThreadBody]
+	auto receivedItems = RunServerAndClient({ sourcePath }, CreateFakeLink);
+	EXPECT_EQ(receivedItems, ClipboardOperations::PastedItems{ CreateFakeLink(sourcePath) });
+}
+
+TEST(PasteSymLinksServerClientTest, ResultsInRequestOrder)
+{
+	std::vector<std::wstring> sourcePaths;
+	ClipboardOperations::PastedItems expectedItems;
+
+	for (int i = 0; i < 200; i++)
 	{
-		thread = std::jthread(clientThreadBody);
-		return true;
+		auto sourcePath = std::to_wstring(i);
+		sourcePaths.push_back(sourcePath);
+		expectedItems.push_back(CreateFakeLink(sourcePath));
+	}
+
+	// The links are created in parallel, so the earlier items in each batch will tend to finish
+	// last here. The results should still be returned in the original order.
+	auto linkCreator = [](const std::wstring &sourcePath)
+	{
+		std::this_thread::sleep_for(std::chrono::microseconds(1000 - std::stoi(sourcePath) * 5));
+		return CreateFakeLink(sourcePath);
 	};
 
-	// The data the client is attempting to send is larger than the shared memory size. In that
-	// case, no data should be received.
-	auto receivedItems = server.LaunchClientAndWaitForResponse(clientLauncher, 1s);
-	EXPECT_TRUE(receivedItems.empty());
+	auto receivedItems = RunServerAndClient(sourcePaths, linkCreator);
+	EXPECT_EQ(receivedItems, expectedItems);
 }
 
 TEST(PasteSymLinksServerClientTest, ClientLaunchFails)
 {
 	// If the client fails to launch, an empty result should be returned.
 	PasteSymLinksServer server;
-	auto receivedItems = server.LaunchClientAndWaitForResponse([] { return false; }, 1s);
+	auto receivedItems =
+		server.LaunchClientAndWaitForResponse({ L"C:\\file1" }, [] { return false; }, 1s);
 	EXPECT_TRUE(receivedItems.empty());
 }
 
@@ -85,20 +138,25 @@ TEST(PasteSymLinksServerClientTest, ClientFailsToSendResults)
 	// If the client doesn't send back any results, an empty result should be returned after the
 	// timeout.
 	PasteSymLinksServer server;
-	auto receivedItems = server.LaunchClientAndWaitForResponse([] { return true; }, 1s);
+	auto receivedItems =
+		server.LaunchClientAndWaitForResponse({ L"C:\\file1" }, [] { return true; }, 1s);
 	EXPECT_TRUE(receivedItems.empty());
 }
 
 TEST(PasteSymLinksServerClientTest, NoServer)
 {
-	ClipboardOperations::PastedItems pastedItems = {
-		{ L"C:\\file1", {} },
-		{ L"C:\\file2", {} },
-		{ L"C:\\file3", {} },
-	};
-
 	// If the server isn't present, the shared memory segment won't have been set up. This call
 	// should be safe, but do nothing.
+	bool linkCreatorCalled = false;
+
 	PasteSymLinksClient client;
-	client.NotifyServerOfResult(pastedItems);
+	client.CreateLinksAndNotifyServer(
+		[&linkCreatorCalled](const std::wstring &sourcePath)
+		{
+			linkCreatorCalled = true;
+			return CreateFakeLink(sourcePath);
+		},
+		1s);
+
+	EXPECT_FALSE(linkCreatorCalled);
 }
@@ -0,0 +1,160 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "TempFileTestHelper.h"
+#include "../Helper/PerformanceTracer.h"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+
+using namespace testing;
+
+class PerformanceTracerTest : public Test
+{
+protected:
+	PerformanceTracerTest() :
+		m_tracer(PerformanceTracer::GetInstance())
+	{
+		m_tracer.SetEnabled(true);
+		m_tracer.Clear();
+	}
+
+	~PerformanceTracerTest()
+	{
+		m_tracer.SetEnabled(false);
+		m_tracer.Clear();
+	}
+
+	std::optional<PerformanceTracer::SpanSummary> GetSpanSummary(std::string_view name)
+	{
+		auto summaries = m_tracer.GetSpanSummaries();
+		auto itr = std::find_if(summaries.begin(), summaries.end(),
+			[name](const auto &summary) { return summary.name == name; });
+
+		if (itr == summaries.end())
+		{
+			return std::nullopt;
+		}
+
+		return *itr;
+	}
+
+	std::optional<PerformanceTracer::CounterSummary> GetCounterSummary(std::string_view name)
+	{
+		auto summaries = m_tracer.GetCounterSummaries();
+		auto itr = std::find_if(summaries.begin(), summaries.end(),
+			[name](const auto &summary) { return summary.name == name; });
+
+		if (itr == summaries.end())
+		{
+			return std::nullopt;
+		}
+
+		return *itr;
+	}
+
+	PerformanceTracer &m_tracer;
+	const TempFileForTest m_traceFile{ L".json" };
+	const std::filesystem::path m_tracePath = m_traceFile.GetPath();
+};
+
+TEST_F(PerformanceTracerTest, NothingRecordedWhenDisabled)
+{
+	m_tracer.SetEnabled(false);
+
+	{
+		ScopedTraceSpan span("Test", "DisabledSpan");
+	}
+
+	TraceCounterAdjust("Test", "DisabledCounter", 1);
+
+	EXPECT_FALSE(GetSpanSummary("DisabledSpan"));
+	EXPECT_FALSE(GetCounterSummary("DisabledCounter"));
+}
+
+TEST_F(PerformanceTracerTest, SpanSummary)
+{
+	auto start = PerformanceTracer::Clock::now();
+	m_tracer.AddSpan("Test", "Span", start, start + std::chrono::milliseconds(10));
+	m_tracer.AddSpan("Test", "Span", start, start + std::chrono::milliseconds(30));
+
+	{
+		ScopedTraceSpan span("Test", "Span");
+	}
+
+	auto summary = GetSpanSummary("Span");
+	ASSERT_TRUE(summary);
+	EXPECT_EQ(summary->category, "Test");
+	EXPECT_EQ(summary->count, 3u);
+	EXPECT_GE(summary->totalDuration, std::chrono::milliseconds(40));
+	EXPECT_EQ(summary->maxDuration, std::chrono::milliseconds(30));
+}
+
+TEST_F(PerformanceTracerTest, Counters)
+{
+	TraceCounterAdjust("Test", "AdjustedCounter", 5);
+	TraceCounterAdjust("Test", "AdjustedCounter", -2);
+
+	auto summary = GetCounterSummary("AdjustedCounter");
+	ASSERT_TRUE(summary);
+	EXPECT_EQ(summary->value, 3);
+	EXPECT_EQ(summary->maxValue, 5);
+
+	TraceCounter("Test", "AbsoluteCounter", 10);
+	TraceCounter("Test", "AbsoluteCounter", 4);
+
+	summary = GetCounterSummary("AbsoluteCounter");
+	ASSERT_TRUE(summary);
+	EXPECT_EQ(summary->value, 4);
+	EXPECT_EQ(summary->maxValue, 10);
+}
+
+TEST_F(PerformanceTracerTest, Clear)
+{
+	auto start = PerformanceTracer::Clock::now();
+	m_tracer.AddSpan("Test", "ClearedSpan", start, start + std::chrono::milliseconds(1));
+	TraceCounter("Test", "RetainedCounter", 8);
+	TraceCounter("Test", "RetainedCounter", 2);
+
+	m_tracer.Clear();
+
+	EXPECT_FALSE(GetSpanSummary("ClearedSpan"));
+
+	// Counter values should be retained, though the maximum value should be reset.
+	auto summary = GetCounterSummary("RetainedCounter");
+	ASSERT_TRUE(summary);
+	EXPECT_EQ(summary->value, 2);
+	EXPECT_EQ(summary->maxValue, 2);
+}
+
+TEST_F(PerformanceTracerTest, ExportTrace)
+{
+	auto start = PerformanceTracer::Clock::now();
+	m_tracer.AddSpan("Test", "ExportedSpan", start, start + std::chrono::milliseconds(2));
+	TraceCounter("Test", "ExportedCounter", 7);
+
+	ASSERT_TRUE(m_tracer.ExportTrace(m_tracePath));
+
+	std::ifstream inputStream(m_tracePath);
+	auto trace = nlohmann::json::parse(inputStream);
+	const auto &traceEvents = trace.at("traceEvents");
+	ASSERT_TRUE(traceEvents.is_array());
+
+	auto spanItr = std::find_if(traceEvents.begin(), traceEvents.end(),
+		[](const auto &event) { return event.at("name") == "ExportedSpan"; });
+	ASSERT_NE(spanItr, traceEvents.end());
+	EXPECT_EQ(spanItr->at("ph"), "X");
+	EXPECT_EQ(spanItr->at("cat"), "Test");
+	EXPECT_EQ(spanItr->at("dur"), 2000);
+
+	auto counterItr = std::find_if(traceEvents.begin(), traceEvents.end(),
+		[](const auto &event) { return event.at("name") == "ExportedCounter"; });
+	ASSERT_NE(counterItr, traceEvents.end());
+	EXPECT_EQ(counterItr->at("ph"), "C");
+	EXPECT_EQ(counterItr->at("args").at("value"), 7);
+}
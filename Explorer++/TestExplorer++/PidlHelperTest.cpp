@@ -147,3 +147,27 @@ TEST(PidlAbsoluteEquality, Different)
 	TestPidlEquality(L"c:\\", L"c:\\windows", false);
 	TestPidlEquality(L"c:\\", L"d:\\path\\to\\item", false);
 }
+
+TEST(IsValidPidlData, Valid)
+{
+	PidlAbsolute pidl = CreateSimplePidlForTest(L"C:\\Fake");
+	auto *data = reinterpret_cast<const BYTE *>(pidl.Raw());
+	EXPECT_TRUE(IsValidPidlData({ data, ILGetSize(pidl.Raw()) }));
+}
+
+TEST(IsValidPidlData, Invalid)
+{
+	PidlAbsolute pidl = CreateSimplePidlForTest(L"C:\\Fake");
+	auto *data = reinterpret_cast<const BYTE *>(pidl.Raw());
+	UINT size = ILGetSize(pidl.Raw());
+
+	// Missing terminator.
+	EXPECT_FALSE(IsValidPidlData({ data, size - 1 }));
+
+	// Data after the terminator.
+	std::vector<BYTE> extendedData(data, data + size);
+	extendedData.push_back(0);
+	EXPECT_FALSE(IsValidPidlData(extendedData));
+
+	EXPECT_FALSE(IsValidPidlData({}));
+}
@@ -0,0 +1,234 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "Plugins/PluginColumnManager.h"
+#include "ShellTestHelper.h"
+#include "TempFileTestHelper.h"
+#include "ShellBrowser/ItemData.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace testing;
+
+class PluginColumnTest : public Test
+{
+protected:
+	void WriteScript(const std::string &script)
+	{
+		std::ofstream stream(m_scriptPath);
+		stream << script;
+	}
+
+	std::shared_ptr<Plugins::PluginColumn> CreateColumn(const std::string &functionName,
+		std::chrono::milliseconds timeBudget = Plugins::PluginColumn::DEFAULT_TIME_BUDGET,
+		std::vector<sol::lib> libraries = { sol::lib::base, sol::lib::string })
+	{
+		Plugins::PluginColumn::Definition definition;
+		definition.name = L"Test";
+		definition.scriptPath = m_scriptPath.wstring();
+		definition.functionName = functionName;
+		definition.libraries = std::move(libraries);
+		definition.width = Plugins::PluginColumn::DEFAULT_WIDTH;
+		definition.timeBudget = timeBudget;
+
+		return std::make_shared<Plugins::PluginColumn>(m_columnIdCounter++, 1,
+			std::move(definition), m_usage);
+	}
+
+	static BasicItemInfo_t BuildItemInfo(const std::wstring &name, DWORD size)
+	{
+		BasicItemInfo_t itemInfo;
+		itemInfo.pidlComplete.reset(
+			ILCloneFull(CreateSimplePidlForTest(L"C:\\Fake\\" + name).Raw()));
+		itemInfo.wfd = {};
+		itemInfo.wfd.nFileSizeLow = size;
+		itemInfo.isFindDataValid = true;
+		StringCchCopy(itemInfo.szDisplayName, std::size(itemInfo.szDisplayName), name.c_str());
+		itemInfo.isRoot = false;
+		return itemInfo;
+	}
+
+	const TempFileForTest m_scriptFile{ L".lua" };
+	const std::filesystem::path m_scriptPath = m_scriptFile.GetPath();
+	const std::shared_ptr<Plugins::PluginColumnUsage> m_usage =
+		std::make_shared<Plugins::PluginColumnUsage>();
+	int m_columnIdCounter = 1;
+};
+
+TEST_F(PluginColumnTest, GetText)
+{
+	WriteScript("function getText(item) return item.name .. \":\" .. item.size end");
+	auto column = CreateColumn("getText");
+
+	EXPECT_EQ(column->GetText(BuildItemInfo(L"file.txt", 1024)), L"file.txt:1024");
+
+	auto stats = column->GetStats();
+	EXPECT_EQ(stats.numCalls, 1u);
+	EXPECT_EQ(stats.numErrors, 0u);
+	EXPECT_EQ(stats.numTimeouts, 0u);
+	EXPECT_FALSE(stats.disabled);
+}
+
+TEST_F(PluginColumnTest, NilResult)
+{
+	WriteScript("function getText(item) return nil end");
+	auto column = CreateColumn("getText");
+
+	EXPECT_EQ(column->GetText(BuildItemInfo(L"file.txt", 0)), L"");
+	EXPECT_EQ(column->GetStats().numErrors, 0u);
+}
+
+TEST_F(PluginColumnTest, ScriptError)
+{
+	WriteScript("function getText(item) error(\"failed\") end");
+	auto column = CreateColumn("getText");
+
+	EXPECT_EQ(column->GetText(BuildItemInfo(L"file.txt", 0)), L"");
+
+	auto stats = column->GetStats();
+	EXPECT_EQ(stats.numCalls, 1u);
+	EXPECT_EQ(stats.numErrors, 1u);
+	EXPECT_EQ(stats.numTimeouts, 0u);
+}
+
+TEST_F(PluginColumnTest, MissingFunction)
+{
+	WriteScript("function getText(item) return \"text\" end");
+	auto column = CreateColumn("missingFunction");
+
+	EXPECT_EQ(column->GetText(BuildItemInfo(L"file.txt", 0)), L"");
+	EXPECT_EQ(column->GetText(BuildItemInfo(L"file.txt", 0)), L"");
+
+	// The script is only loaded once per thread, so the error should only be counted once.
+	auto stats = column->GetStats();
+	EXPECT_EQ(stats.numCalls, 0u);
+	EXPECT_EQ(stats.numErrors, 1u);
+}
+
+TEST_F(PluginColumnTest, TimeBudget)
+{
+	WriteScript("function getText(item) while true do end end");
+	auto column = CreateColumn("getText", std::chrono::milliseconds(10));
+
+	for (uint64_t i = 0; i < Plugins::PluginColumnUsage::MAX_TIMEOUTS; i++)
+	{
+		EXPECT_EQ(column->GetText(BuildItemInfo(L"file.txt", 0)), L"");
+	}
+
+	auto stats = column->GetStats();
+	EXPECT_EQ(stats.numCalls, Plugins::PluginColumnUsage::MAX_TIMEOUTS);
+	EXPECT_EQ(stats.numTimeouts, Plugins::PluginColumnUsage::MAX_TIMEOUTS);
+	EXPECT_EQ(stats.numErrors, 0u);
+	EXPECT_TRUE(stats.disabled);
+
+	// Once the column has been disabled, the script shouldn't be called at all.
+	EXPECT_EQ(column->GetText(BuildItemInfo(L"file.txt", 0)), L"");
+	EXPECT_EQ(column->GetStats().numCalls, Plugins::PluginColumnUsage::MAX_TIMEOUTS);
+}
+
+TEST_F(PluginColumnTest, TimeoutsCountedPerPlugin)
+{
+	WriteScript("function getText(item) while true do end end");
+	auto column1 = CreateColumn("getText", std::chrono::milliseconds(10));
+	auto column2 = CreateColumn("getText", std::chrono::milliseconds(10));
+
+	// Each column only times out half as often as would be needed to disable it on its own, but
+	// the timeouts all count against the plugin.
+	for (uint64_t i = 0; i < Plugins::PluginColumnUsage::MAX_TIMEOUTS / 2; i++)
+	{
+		EXPECT_EQ(column1->GetText(BuildItemInfo(L"file.txt", 0)), L"");
+		EXPECT_EQ(column2->GetText(BuildItemInfo(L"file.txt", 0)), L"");
+	}
+
+	EXPECT_EQ(column1->GetStats().numTimeouts, Plugins::PluginColumnUsage::MAX_TIMEOUTS);
+	EXPECT_TRUE(column1->GetStats().disabled);
+	EXPECT_TRUE(column2->GetStats().disabled);
+}
+
+TEST_F(PluginColumnTest, BlockingLibrariesExcluded)
+{
+	WriteScript("function getText(item)\n"
+				"  return tostring(io == nil) .. tostring(os.execute == nil) .. "
+				"tostring(os.time ~= nil)\n"
+				"end");
+	auto column = CreateColumn("getText", Plugins::PluginColumn::DEFAULT_TIME_BUDGET,
+		{ sol::lib::base, sol::lib::io, sol::lib::os });
+
+	EXPECT_EQ(column->GetText(BuildItemInfo(L"file.txt", 0)), L"truetruetrue");
+}
+
+TEST_F(PluginColumnTest, StatePerThread)
+{
+	WriteScript("count = 0\n"
+				"function getText(item) count = count + 1 return tostring(count) end");
+	auto column = CreateColumn("getText");
+
+	EXPECT_EQ(column->GetText(BuildItemInfo(L"file.txt", 0)), L"1");
+	EXPECT_EQ(column->GetText(BuildItemInfo(L"file.txt", 0)), L"2");
+
+	// A different thread has its own copy of the script, so has its own copy of the global
+	// variable.
+	std::wstring otherThreadText;
+	std::thread thread([&column, &otherThreadText]
+		{ otherThreadText = column->GetText(BuildItemInfo(L"file.txt", 0)); });
+	thread.join();
+
+	EXPECT_EQ(otherThreadText, L"1");
+	EXPECT_EQ(column->GetStats().numCalls, 3u);
+}
+
+TEST(PluginColumnManagerTest, AddRemove)
+{
+	Plugins::PluginColumnManager manager;
+
+	auto columnId1 = manager.AddColumn(1, { L"Column 1", L"", "", {}, 100, {} });
+	ASSERT_TRUE(columnId1.has_value());
+
+	auto columnId2 = manager.AddColumn(2, { L"Column 2", L"", "", {}, 100, {} });
+	ASSERT_TRUE(columnId2.has_value());
+	EXPECT_NE(*columnId1, *columnId2);
+
+	ASSERT_EQ(manager.GetColumns().size(), 2u);
+	EXPECT_EQ(manager.GetColumns()[0]->GetName(), L"Column 1");
+	EXPECT_EQ(manager.GetColumns()[1]->GetPluginId(), 2);
+
+	manager.RemoveColumn(*columnId1);
+	EXPECT_EQ(manager.GetColumn(*columnId1), nullptr);
+	ASSERT_NE(manager.GetColumn(*columnId2), nullptr);
+	EXPECT_EQ(manager.GetColumn(*columnId2)->GetName(), L"Column 2");
+}
+
+TEST(PluginColumnManagerTest, TimeBudgetSharedByPlugin)
+{
+	Plugins::PluginColumnManager manager;
+
+	auto timeBudget = Plugins::PluginColumn::MAX_TIME_BUDGET * 3 / 5;
+
+	auto columnId1 = manager.AddColumn(1, { L"Column 1", L"", "", {}, 100, timeBudget });
+	ASSERT_TRUE(columnId1.has_value());
+	EXPECT_EQ(manager.GetColumn(*columnId1)->GetTimeBudget(), timeBudget);
+
+	// The second column only gets whatever budget is left over.
+	auto columnId2 = manager.AddColumn(1, { L"Column 2", L"", "", {}, 100, timeBudget });
+	ASSERT_TRUE(columnId2.has_value());
+	EXPECT_EQ(manager.GetColumn(*columnId2)->GetTimeBudget(),
+		Plugins::PluginColumn::MAX_TIME_BUDGET - timeBudget);
+
+	// At this point, the plugin has no budget left.
+	EXPECT_FALSE(manager.AddColumn(1, { L"Column 3", L"", "", {}, 100, timeBudget }).has_value());
+
+	// Other plugins have their own budget.
+	auto columnId4 = manager.AddColumn(2, { L"Column 4", L"", "", {}, 100, timeBudget });
+	ASSERT_TRUE(columnId4.has_value());
+	EXPECT_EQ(manager.GetColumn(*columnId4)->GetTimeBudget(), timeBudget);
+
+	// Removing a column frees up its budget.
+	manager.RemoveColumn(*columnId1);
+	auto columnId5 = manager.AddColumn(1, { L"Column 5", L"", "", {}, 100, timeBudget });
+	ASSERT_TRUE(columnId5.has_value());
+	EXPECT_EQ(manager.GetColumn(*columnId5)->GetTimeBudget(), timeBudget);
+}
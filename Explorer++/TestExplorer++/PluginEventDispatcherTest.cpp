@@ -0,0 +1,210 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "Plugins/PluginEventDispatcher.h"
+#include "Plugins/PluginProfiler.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace Plugins;
+using namespace testing;
+
+class PluginEventDispatcherTest : public Test
+{
+protected:
+	static constexpr int PLUGIN_ID_1 = 1;
+	static constexpr int PLUGIN_ID_2 = 2;
+
+	PluginEventDispatcherTest() :
+		m_dispatcher([this](PluginEventDispatcher::DeliveryTiming timing)
+			{ m_scheduledTimings.push_back(timing); },
+			&m_profiler)
+	{
+	}
+
+	void QueueRecordingCall(int pluginId, int observerId, int value)
+	{
+		m_dispatcher.QueueCall(pluginId, &m_source, observerId, L"test",
+			[this, value]()
+			{
+				m_deliveredValues.push_back(value);
+				return true;
+			});
+	}
+
+	PluginProfiler m_profiler;
+	PluginEventDispatcher m_dispatcher;
+	std::vector<PluginEventDispatcher::DeliveryTiming> m_scheduledTimings;
+	std::vector<int> m_deliveredValues;
+	int m_source = 0;
+};
+
+TEST_F(PluginEventDispatcherTest, DeliveredInOrder)
+{
+	QueueRecordingCall(PLUGIN_ID_1, 1, 1);
+	QueueRecordingCall(PLUGIN_ID_2, 1, 2);
+	QueueRecordingCall(PLUGIN_ID_1, 2, 3);
+
+	// Nothing should be called until the calls are delivered, and delivery should only be
+	// scheduled once.
+	EXPECT_TRUE(m_deliveredValues.empty());
+	EXPECT_EQ(m_scheduledTimings,
+		std::vector{ PluginEventDispatcher::DeliveryTiming::NextMessage });
+	EXPECT_EQ(m_dispatcher.GetNumQueuedCalls(), 3u);
+
+	m_dispatcher.DeliverQueuedCalls();
+	EXPECT_EQ(m_deliveredValues, (std::vector{ 1, 2, 3 }));
+	EXPECT_EQ(m_dispatcher.GetNumQueuedCalls(), 0u);
+
+	const auto &profiles = m_profiler.GetProfiles();
+	EXPECT_EQ(profiles.at(PLUGIN_ID_1).numCalls, 2u);
+	EXPECT_EQ(profiles.at(PLUGIN_ID_2).numCalls, 1u);
+}
+
+TEST_F(PluginEventDispatcherTest, RemoveCalls)
+{
+	int otherSource = 0;
+
+	QueueRecordingCall(PLUGIN_ID_1, 1, 1);
+	QueueRecordingCall(PLUGIN_ID_1, 2, 2);
+	m_dispatcher.QueueCall(PLUGIN_ID_1, &otherSource, 1, L"test",
+		[this]()
+		{
+			m_deliveredValues.push_back(3);
+			return true;
+		});
+
+	m_dispatcher.RemoveCalls(&m_source, 1);
+	m_dispatcher.DeliverQueuedCalls();
+	EXPECT_EQ(m_deliveredValues, (std::vector{ 2, 3 }));
+
+	m_deliveredValues.clear();
+
+	QueueRecordingCall(PLUGIN_ID_1, 1, 1);
+	QueueRecordingCall(PLUGIN_ID_1, 2, 2);
+
+	m_dispatcher.RemoveCalls(&m_source);
+	m_dispatcher.DeliverQueuedCalls();
+	EXPECT_TRUE(m_deliveredValues.empty());
+}
+
+TEST_F(PluginEventDispatcherTest, RemoveDuringDelivery)
+{
+	m_dispatcher.QueueCall(PLUGIN_ID_1, &m_source, 1, L"test",
+		[this]()
+		{
+			m_dispatcher.RemoveCalls(&m_source, 2);
+			return true;
+		});
+	QueueRecordingCall(PLUGIN_ID_1, 2, 1);
+	QueueRecordingCall(PLUGIN_ID_1, 3, 2);
+
+	m_dispatcher.DeliverQueuedCalls();
+	EXPECT_EQ(m_deliveredValues, std::vector{ 2 });
+}
+
+TEST_F(PluginEventDispatcherTest, QueueDuringDelivery)
+{
+	m_dispatcher.QueueCall(PLUGIN_ID_1, &m_source, 1, L"test",
+		[this]()
+		{
+			QueueRecordingCall(PLUGIN_ID_1, 1, 1);
+			return true;
+		});
+
+	m_dispatcher.DeliverQueuedCalls();
+
+	// The call that was queued during delivery should be delivered as part of the next batch.
+	EXPECT_TRUE(m_deliveredValues.empty());
+	EXPECT_EQ(m_dispatcher.GetNumQueuedCalls(), 1u);
+	EXPECT_EQ(m_scheduledTimings.back(), PluginEventDispatcher::DeliveryTiming::NextMessage);
+
+	m_dispatcher.DeliverQueuedCalls();
+	EXPECT_EQ(m_deliveredValues, std::vector{ 1 });
+}
+
+TEST_F(PluginEventDispatcherTest, FailedCalls)
+{
+	m_dispatcher.QueueCall(PLUGIN_ID_1, &m_source, 1, L"test", []() { return false; });
+	QueueRecordingCall(PLUGIN_ID_1, 1, 1);
+
+	m_dispatcher.DeliverQueuedCalls();
+
+	const auto &profile = m_profiler.GetProfiles().at(PLUGIN_ID_1);
+	EXPECT_EQ(profile.numCalls, 2u);
+	EXPECT_EQ(profile.numFailedCalls, 1u);
+}
+
+TEST_F(PluginEventDispatcherTest, Throttling)
+{
+	m_dispatcher.QueueCall(PLUGIN_ID_1, &m_source, 1, L"slow",
+		[]()
+		{
+			std::this_thread::sleep_for(PluginEventDispatcher::PLUGIN_BATCH_BUDGET
+				+ std::chrono::milliseconds(10));
+			return true;
+		});
+	QueueRecordingCall(PLUGIN_ID_1, 1, 1);
+	QueueRecordingCall(PLUGIN_ID_2, 1, 2);
+	QueueRecordingCall(PLUGIN_ID_1, 1, 3);
+
+	m_dispatcher.DeliverQueuedCalls();
+
+	// The first plugin has used up its budget, so its remaining calls should be deferred. That
+	// shouldn't affect the second plugin.
+	EXPECT_EQ(m_deliveredValues, std::vector{ 2 });
+	EXPECT_EQ(m_dispatcher.GetNumQueuedCalls(), 2u);
+	EXPECT_EQ(m_scheduledTimings.back(), PluginEventDispatcher::DeliveryTiming::WhenIdle);
+	EXPECT_EQ(m_profiler.GetProfiles().at(PLUGIN_ID_1).numDeferredCalls, 2u);
+
+	m_dispatcher.DeliverQueuedCalls();
+	EXPECT_EQ(m_deliveredValues, (std::vector{ 2, 1, 3 }));
+	EXPECT_EQ(m_dispatcher.GetNumQueuedCalls(), 0u);
+}
+
+TEST(PluginProfilerTest, SlowestCalls)
+{
+	PluginProfiler profiler;
+	profiler.RegisterPlugin(1, L"Test plugin");
+
+	for (int i = 1; i <= 10; i++)
+	{
+		profiler.RecordCall(1, std::to_wstring(i), std::chrono::milliseconds(i % 7), true);
+	}
+
+	const auto &profile = profiler.GetProfiles().at(1);
+	EXPECT_EQ(profile.pluginName, L"Test plugin");
+	EXPECT_EQ(profile.numCalls, 10u);
+	EXPECT_EQ(profile.totalDuration,
+		std::chrono::milliseconds(1 + 2 + 3 + 4 + 5 + 6 + 0 + 1 + 2 + 3));
+
+	std::vector<std::wstring> slowestCallDescriptions;
+
+	for (const auto &call : profile.slowestCalls)
+	{
+		slowestCallDescriptions.push_back(call.description);
+	}
+
+	EXPECT_EQ(slowestCallDescriptions,
+		(std::vector<std::wstring>{ L"6", L"5", L"4", L"3", L"10" }));
+}
+
+TEST(PluginProfilerTest, Reset)
+{
+	PluginProfiler profiler;
+	profiler.RegisterPlugin(1, L"Test plugin");
+	profiler.RecordCall(1, L"call", std::chrono::milliseconds(5), false);
+	profiler.RecordDeferredCall(1);
+
+	profiler.Reset();
+
+	const auto &profile = profiler.GetProfiles().at(1);
+	EXPECT_EQ(profile.pluginName, L"Test plugin");
+	EXPECT_EQ(profile.numCalls, 0u);
+	EXPECT_EQ(profile.numFailedCalls, 0u);
+	EXPECT_EQ(profile.numDeferredCalls, 0u);
+	EXPECT_EQ(profile.totalDuration, PluginProfiler::Clock::duration::zero());
+	EXPECT_TRUE(profile.slowestCalls.empty());
+}
@@ -71,6 +71,24 @@ TEST_F(PopupMenuViewTest, SetBitmapForItem)
 	EXPECT_EQ(retrievedBitmap, rawBitmap);
 }
 
+TEST_F(PopupMenuViewTest, SetItemText)
+{
+	UINT id = 1;
+	m_popupMenu.AppendItem(id, L"Item");
+
+	m_popupMenu.SetItemText(id, L"Updated item");
+	EXPECT_EQ(m_popupMenu.GetItemTextForTesting(id), L"Updated item");
+}
+
+TEST_F(PopupMenuViewTest, SetHelpTextForItem)
+{
+	UINT id = 1;
+	m_popupMenu.AppendItem(id, L"Item", nullptr, L"Help text");
+
+	m_popupMenu.SetHelpTextForItem(id, L"Updated help text");
+	EXPECT_EQ(m_popupMenu.GetHelpTextForItem(id), L"Updated help text");
+}
+
 TEST_F(PopupMenuViewTest, ClearEmptyMenu)
 {
 	// Clearing an empty menu should have no effect, but also shouldn't cause any issues.
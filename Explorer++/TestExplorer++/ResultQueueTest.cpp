@@ -0,0 +1,176 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "../Helper/ResultQueue.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+TEST(ResultQueueTest, DrainInOrder)
+{
+	int numNotifications = 0;
+	ResultQueue<int> queue(
+		[&numNotifications]
+		{
+			numNotifications++;
+			return true;
+		});
+
+	queue.Push(queue.GetGeneration(), 1);
+	queue.Push(queue.GetGeneration(), 2);
+	queue.Push(queue.GetGeneration(), 3);
+
+	// Only the first result should have triggered a notification.
+	EXPECT_EQ(numNotifications, 1);
+
+	std::vector<int> results;
+	size_t numResults = queue.Drain([&results](int result) { results.push_back(result); });
+	EXPECT_EQ(numResults, 3u);
+	EXPECT_EQ(results, (std::vector<int>{ 1, 2, 3 }));
+
+	// The queue is empty at this point, so the next push should result in another notification.
+	queue.Push(queue.GetGeneration(), 4);
+	EXPECT_EQ(numNotifications, 2);
+}
+
+TEST(ResultQueueTest, NotificationRetriedAfterFailure)
+{
+	int numNotifications = 0;
+	bool notificationSucceeds = false;
+	ResultQueue<int> queue(
+		[&numNotifications, &notificationSucceeds]
+		{
+			numNotifications++;
+			return notificationSucceeds;
+		});
+
+	queue.Push(queue.GetGeneration(), 1);
+	EXPECT_EQ(numNotifications, 1);
+
+	// The first notification failed, so the consumer doesn't know about the first result. The next
+	// push should therefore try again, even though the queue isn't empty.
+	notificationSucceeds = true;
+	queue.Push(queue.GetGeneration(), 2);
+	EXPECT_EQ(numNotifications, 2);
+
+	// That notification succeeded, so there's no need to notify again.
+	queue.Push(queue.GetGeneration(), 3);
+	EXPECT_EQ(numNotifications, 2);
+
+	std::vector<int> results;
+	queue.Drain([&results](int result) { results.push_back(result); });
+	EXPECT_EQ(results, (std::vector<int>{ 1, 2, 3 }));
+}
+
+TEST(ResultQueueTest, DrainEmpty)
+{
+	ResultQueue<int> queue([] { return true; });
+
+	bool callbackInvoked = false;
+	size_t numResults = queue.Drain([&callbackInvoked](int) { callbackInvoked = true; });
+	EXPECT_EQ(numResults, 0u);
+	EXPECT_FALSE(callbackInvoked);
+}
+
+TEST(ResultQueueTest, DiscardPending)
+{
+	ResultQueue<int> queue([] { return true; });
+
+	auto previousGeneration = queue.GetGeneration();
+	queue.DiscardPending();
+
+	queue.Push(previousGeneration, 1);
+	queue.Push(queue.GetGeneration(), 2);
+
+	std::vector<int> results;
+	queue.Drain([&results](int result) { results.push_back(result); });
+	EXPECT_EQ(results, (std::vector<int>{ 2 }));
+}
+
+TEST(ResultQueueTest, NodesRecycled)
+{
+	ResultQueue<std::unique_ptr<int>> queue([] { return true; });
+
+	for (int i = 0; i < 100; i++)
+	{
+		queue.Push(queue.GetGeneration(), std::make_unique<int>(i));
+		queue.Push(queue.GetGeneration(), std::make_unique<int>(i));
+		queue.Drain([](const std::unique_ptr<int> &) {});
+	}
+
+	EXPECT_EQ(queue.GetNumNodesAllocated(), 2u);
+}
+
+TEST(ResultQueueTest, MultipleProducers)
+{
+	constexpr int NUM_PRODUCERS = 4;
+	constexpr int NUM_RESULTS_PER_PRODUCER = 1000;
+
+	std::atomic<int> numNotifications = 0;
+	ResultQueue<std::pair<int, int>> queue(
+		[&numNotifications]
+		{
+			numNotifications++;
+			return true;
+		});
+	auto generation = queue.GetGeneration();
+
+	std::vector<std::thread> producers;
+
+	for (int producer = 0; producer < NUM_PRODUCERS; producer++)
+	{
+		producers.emplace_back(
+			[&queue, generation, producer]
+			{
+				for (int i = 0; i < NUM_RESULTS_PER_PRODUCER; i++)
+				{
+					queue.Push(generation, { producer, i });
+				}
+			});
+	}
+
+	std::vector<int> nextExpected(NUM_PRODUCERS, 0);
+	int numResults = 0;
+	int numDrains = 0;
+
+	auto drain = [&]
+	{
+		size_t numDrained = queue.Drain(
+			[&nextExpected](const std::pair<int, int> &result)
+			{
+				// Results from any one producer should be received in the order they were
+				// pushed.
+				EXPECT_EQ(result.second, nextExpected[result.first]);
+				nextExpected[result.first]++;
+			});
+
+		if (numDrained > 0)
+		{
+			numDrains++;
+		}
+
+		numResults += static_cast<int>(numDrained);
+	};
+
+	while (numResults < NUM_PRODUCERS * NUM_RESULTS_PER_PRODUCER)
+	{
+		drain();
+	}
+
+	for (auto &producer : producers)
+	{
+		producer.join();
+	}
+
+	EXPECT_EQ(numResults, NUM_PRODUCERS * NUM_RESULTS_PER_PRODUCER);
+
+	// There should be exactly one notification for each time the queue went from empty to
+	// non-empty, which is the number of non-empty drains.
+	EXPECT_EQ(numNotifications, numDrains);
+}
@@ -0,0 +1,106 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "SettingsChangeTracker.h"
+#include "ApplicationModel.h"
+#include "Bookmarks/BookmarkTree.h"
+#include "ColorRuleModel.h"
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace Applications;
+
+class SettingsChangeTrackerTest : public Test
+{
+protected:
+	using Section = SettingsChangeTracker::Section;
+
+	SettingsChangeTrackerTest() :
+		m_tracker(&m_bookmarkTree, &m_colorRuleModel, &m_applicationModel,
+			m_changedCallback.AsStdFunction())
+	{
+	}
+
+	void ClearAllChanged()
+	{
+		m_tracker.ClearChanged(Section::Bookmarks);
+		m_tracker.ClearChanged(Section::ColorRules);
+		m_tracker.ClearChanged(Section::ApplicationToolbar);
+	}
+
+	BookmarkTree m_bookmarkTree;
+	ColorRuleModel m_colorRuleModel;
+	ApplicationModel m_applicationModel;
+	MockFunction<void()> m_changedCallback;
+	SettingsChangeTracker m_tracker;
+};
+
+TEST_F(SettingsChangeTrackerTest, InitiallyChanged)
+{
+	EXPECT_TRUE(m_tracker.HasChanged(Section::Bookmarks));
+	EXPECT_TRUE(m_tracker.HasChanged(Section::ColorRules));
+	EXPECT_TRUE(m_tracker.HasChanged(Section::ApplicationToolbar));
+
+	ClearAllChanged();
+	EXPECT_FALSE(m_tracker.HasChanged(Section::Bookmarks));
+
+	m_tracker.MarkAllChanged();
+	EXPECT_TRUE(m_tracker.HasChanged(Section::Bookmarks));
+	EXPECT_TRUE(m_tracker.HasChanged(Section::ColorRules));
+	EXPECT_TRUE(m_tracker.HasChanged(Section::ApplicationToolbar));
+}
+
+TEST_F(SettingsChangeTrackerTest, BookmarkChanges)
+{
+	ClearAllChanged();
+
+	EXPECT_CALL(m_changedCallback, Call()).Times(2);
+
+	auto bookmark = std::make_unique<BookmarkItem>(std::nullopt, L"Test bookmark", L"C:\\");
+	auto *rawBookmark = m_bookmarkTree.AddBookmarkItem(m_bookmarkTree.GetBookmarksMenuFolder(),
+		std::move(bookmark), 0);
+	EXPECT_TRUE(m_tracker.HasChanged(Section::Bookmarks));
+	EXPECT_FALSE(m_tracker.HasChanged(Section::ColorRules));
+	EXPECT_FALSE(m_tracker.HasChanged(Section::ApplicationToolbar));
+
+	m_tracker.ClearChanged(Section::Bookmarks);
+
+	rawBookmark->SetName(L"Updated name");
+	EXPECT_TRUE(m_tracker.HasChanged(Section::Bookmarks));
+}
+
+TEST_F(SettingsChangeTrackerTest, ColorRuleChanges)
+{
+	ClearAllChanged();
+
+	EXPECT_CALL(m_changedCallback, Call()).Times(2);
+
+	auto *colorRule = m_colorRuleModel.AddItem(
+		std::make_unique<ColorRule>(L"Description", L"*.txt", false, 0, RGB(0, 0, 0)));
+	EXPECT_TRUE(m_tracker.HasChanged(Section::ColorRules));
+	EXPECT_FALSE(m_tracker.HasChanged(Section::Bookmarks));
+
+	m_tracker.ClearChanged(Section::ColorRules);
+
+	m_colorRuleModel.RemoveItem(colorRule);
+	EXPECT_TRUE(m_tracker.HasChanged(Section::ColorRules));
+}
+
+TEST_F(SettingsChangeTrackerTest, ApplicationChanges)
+{
+	ClearAllChanged();
+
+	EXPECT_CALL(m_changedCallback, Call()).Times(2);
+
+	auto *application =
+		m_applicationModel.AddItem(std::make_unique<Application>(L"Notepad", L"notepad.exe"));
+	EXPECT_TRUE(m_tracker.HasChanged(Section::ApplicationToolbar));
+	EXPECT_FALSE(m_tracker.HasChanged(Section::ColorRules));
+
+	m_tracker.ClearChanged(Section::ApplicationToolbar);
+
+	application->SetName(L"Updated name");
+	EXPECT_TRUE(m_tracker.HasChanged(Section::ApplicationToolbar));
+}
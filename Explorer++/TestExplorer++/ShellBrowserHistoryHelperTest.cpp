@@ -4,6 +4,7 @@
 
 #include "pch.h"
 #include "ShellBrowserHistoryHelper.h"
+#include "FrequentLocationsService.h"
 #include "HistoryService.h"
 #include "IconFetcherMock.h"
 #include "ShellBrowserFake.h"
@@ -19,7 +20,8 @@ protected:
 	void NavigateInNewTab(const std::wstring &path, PidlAbsolute *outputPidl)
 	{
 		ShellBrowserFake shellBrowser(&m_tabNavigation, &m_iconFetcher);
-		ShellBrowserHistoryHelper::CreateAndAttachToShellBrowser(&shellBrowser, &m_historyService);
+		ShellBrowserHistoryHelper::CreateAndAttachToShellBrowser(&shellBrowser, &m_historyService,
+			&m_frequentLocationsService);
 		ASSERT_HRESULT_SUCCEEDED(
 			shellBrowser.NavigateToPath(path, HistoryEntryType::AddEntry, outputPidl));
 	}
@@ -27,11 +29,11 @@ protected:
 	TabNavigationMock m_tabNavigation;
 	IconFetcherMock m_iconFetcher;
 	HistoryService m_historyService;
+	FrequentLocationsService m_frequentLocationsService;
 };
 TEST_F(ShellBrowserHistoryHelperTest, NavigationInDifferentTabs)
 {
-	const auto &history = m_historyService.GetHistoryItems();
-	EXPECT_EQ(history.size(), 0U);
+	EXPECT_EQ(m_historyService.GetNumHistoryItems(), 0U);
 
 	MockFunction<void()> callback;
 	m_historyService.AddHistoryChangedObserver(callback.AsStdFunction());
@@ -39,16 +41,40 @@ TEST_F(ShellBrowserHistoryHelperTest, NavigationInDifferentTabs)
 
 	PidlAbsolute pidlFake1;
 	NavigateInNewTab(L"C:\\Fake1", &pidlFake1);
+	auto history = m_historyService.GetHistoryItems();
 	ASSERT_EQ(history.size(), 1U);
 	EXPECT_EQ(history[0], pidlFake1);
 
 	PidlAbsolute pidlFake2;
 	NavigateInNewTab(L"C:\\Fake2", &pidlFake2);
+	history = m_historyService.GetHistoryItems();
 	ASSERT_EQ(history.size(), 2U);
 	EXPECT_EQ(history[0], pidlFake2);
 
 	PidlAbsolute pidlFake3;
 	NavigateInNewTab(L"C:\\Fake3", &pidlFake3);
+	history = m_historyService.GetHistoryItems();
 	ASSERT_EQ(history.size(), 3U);
 	EXPECT_EQ(history[0], pidlFake3);
 }
+
+TEST_F(ShellBrowserHistoryHelperTest, LocationVisitsRegistered)
+{
+	PidlAbsolute pidlFake1;
+	NavigateInNewTab(L"C:\\Fake1", &pidlFake1);
+
+	PidlAbsolute pidlFake2;
+	NavigateInNewTab(L"C:\\Fake2", &pidlFake2);
+	NavigateInNewTab(L"C:\\Fake2", nullptr);
+
+	const auto &visits = m_frequentLocationsService.GetVisits();
+	ASSERT_EQ(visits.size(), 2U);
+
+	auto itr = visits.begin();
+	EXPECT_EQ(itr->GetLocation(), pidlFake2);
+	EXPECT_EQ(itr->GetNumVisits(), 2);
+
+	++itr;
+	EXPECT_EQ(itr->GetLocation(), pidlFake1);
+	EXPECT_EQ(itr->GetNumVisits(), 1);
+}
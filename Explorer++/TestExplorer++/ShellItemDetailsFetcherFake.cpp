@@ -0,0 +1,82 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "ShellItemDetailsFetcherFake.h"
+#include "ShellItemDetailsFetcherImpl.h"
+
+void ShellItemDetailsFetcherFake::QueueDetailsTask(PCIDLIST_ABSOLUTE pidl, Callback callback)
+{
+	if (m_ignoreRequests)
+	{
+		return;
+	}
+
+	if (m_deferResults)
+	{
+		m_pendingRequests.push_back({ pidl, std::move(callback) });
+		return;
+	}
+
+	ReturnResult(pidl, callback);
+}
+
+void ShellItemDetailsFetcherFake::CancelPendingTasks()
+{
+	m_pendingRequests.clear();
+}
+
+std::optional<ShellItemDetails> ShellItemDetailsFetcherFake::GetCachedDetails(
+	PCIDLIST_ABSOLUTE pidl) const
+{
+	auto itr = m_cachedDetails.find(PidlAbsolute(pidl));
+
+	if (itr == m_cachedDetails.end())
+	{
+		return std::nullopt;
+	}
+
+	return itr->second;
+}
+
+void ShellItemDetailsFetcherFake::SetDeferResults(bool deferResults)
+{
+	m_deferResults = deferResults;
+}
+
+void ShellItemDetailsFetcherFake::SetIgnoreRequests(bool ignoreRequests)
+{
+	m_ignoreRequests = ignoreRequests;
+}
+
+void ShellItemDetailsFetcherFake::TriggerPendingResultCallbacks()
+{
+	auto pendingRequests = std::move(m_pendingRequests);
+	m_pendingRequests.clear();
+
+	for (const auto &request : pendingRequests)
+	{
+		ReturnResult(request.pidl, request.callback);
+	}
+}
+
+size_t ShellItemDetailsFetcherFake::GetNumPendingRequests() const
+{
+	return m_pendingRequests.size();
+}
+
+void ShellItemDetailsFetcherFake::AgeCachedDetails(std::chrono::steady_clock::duration age)
+{
+	for (auto &[pidl, details] : m_cachedDetails)
+	{
+		details.retrievalTime -= age;
+	}
+}
+
+void ShellItemDetailsFetcherFake::ReturnResult(const PidlAbsolute &pidl, const Callback &callback)
+{
+	auto details = ShellItemDetailsFetcherImpl::FetchDetails(pidl.Raw());
+	m_cachedDetails.insert_or_assign(pidl, details);
+	callback(details);
+}
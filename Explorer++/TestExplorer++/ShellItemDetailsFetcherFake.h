@@ -0,0 +1,46 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include "ShellItemDetailsFetcher.h"
+#include "../Helper/PidlHelper.h"
+#include <boost/functional/hash.hpp>
+#include <unordered_map>
+#include <vector>
+
+// By default, details are retrieved and the callback invoked synchronously. Results can instead be
+// deferred, in which case they're only returned when TriggerPendingResultCallbacks() is called.
+class ShellItemDetailsFetcherFake : public ShellItemDetailsFetcher
+{
+public:
+	// ShellItemDetailsFetcher
+	void QueueDetailsTask(PCIDLIST_ABSOLUTE pidl, Callback callback) override;
+	void CancelPendingTasks() override;
+	std::optional<ShellItemDetails> GetCachedDetails(PCIDLIST_ABSOLUTE pidl) const override;
+
+	// ShellItemDetailsFetcherFake custom methods
+	void SetDeferResults(bool deferResults);
+	void SetIgnoreRequests(bool ignoreRequests);
+	void TriggerPendingResultCallbacks();
+	size_t GetNumPendingRequests() const;
+
+	// Makes each of the cached entries appear to have been retrieved the specified amount of time
+	// earlier than they actually were.
+	void AgeCachedDetails(std::chrono::steady_clock::duration age);
+
+private:
+	struct PendingRequest
+	{
+		PidlAbsolute pidl;
+		Callback callback;
+	};
+
+	void ReturnResult(const PidlAbsolute &pidl, const Callback &callback);
+
+	std::unordered_map<PidlAbsolute, ShellItemDetails, boost::hash<PidlAbsolute>> m_cachedDetails;
+	std::vector<PendingRequest> m_pendingRequests;
+	bool m_deferResults = false;
+	bool m_ignoreRequests = false;
+};
@@ -7,6 +7,7 @@
 #include "BrowserWindowMock.h"
 #include "IconFetcher.h"
 #include "PopupMenuView.h"
+#include "ShellItemDetailsFetcherFake.h"
 #include "ShellTestHelper.h"
 #include "../Helper/ShellHelper.h"
 #include <gmock/gmock.h>
@@ -117,14 +118,15 @@ protected:
 	std::unique_ptr<ShellItemsMenu> BuildMenu(MenuView *menuView,
 		const std::vector<PidlAbsolute> &pidls)
 	{
-		return std::make_unique<ShellItemsMenu>(menuView, pidls, &m_browserWindow, &m_iconFetcher);
+		return std::make_unique<ShellItemsMenu>(menuView, pidls, &m_browserWindow, &m_iconFetcher,
+			&m_detailsFetcher);
 	}
 
 	std::unique_ptr<ShellItemsMenu> BuildMenu(MenuView *menuView,
 		const std::vector<PidlAbsolute> &pidls, UINT menuStartId, UINT menuEndId)
 	{
 		return std::make_unique<ShellItemsMenu>(menuView, pidls, &m_browserWindow, &m_iconFetcher,
-			menuStartId, menuEndId);
+			&m_detailsFetcher, menuStartId, menuEndId);
 	}
 
 	void CheckItemDetails(const MenuView &menuView, const std::vector<PidlAbsolute> &pidls)
@@ -140,8 +142,19 @@ protected:
 		}
 	}
 
+	void CheckItemsArePlaceholders(const MenuView &menuView)
+	{
+		for (int i = 0; i < menuView.GetItemCountForTesting(); i++)
+		{
+			auto id = menuView.GetItemIdForTesting(i);
+			EXPECT_EQ(menuView.GetItemTextForTesting(id), L"...");
+			EXPECT_EQ(menuView.GetHelpTextForItem(id), L"");
+		}
+	}
+
 	BrowserWindowMock m_browserWindow;
 	IconFetcherFake m_iconFetcher;
+	ShellItemDetailsFetcherFake m_detailsFetcher;
 };
 
 TEST_F(ShellItemsMenuTest, CheckItems)
@@ -177,6 +190,101 @@ TEST_F(ShellItemsMenuTest, RebuildMenu)
 	CheckItemDetails(popupMenu, updatedPidls);
 }
 
+TEST_F(ShellItemsMenuTest, PlaceholdersShownUntilDetailsRetrieved)
+{
+	m_detailsFetcher.SetDeferResults(true);
+
+	PopupMenuView popupMenu;
+	auto pidls = BuildPidlCollection(3);
+	auto menu = BuildMenu(&popupMenu, pidls);
+
+	// The menu should be populated immediately, even though the details for each item haven't been
+	// retrieved yet.
+	ASSERT_EQ(popupMenu.GetItemCountForTesting(), 3);
+	CheckItemsArePlaceholders(popupMenu);
+
+	m_detailsFetcher.TriggerPendingResultCallbacks();
+	CheckItemDetails(popupMenu, pidls);
+}
+
+TEST_F(ShellItemsMenuTest, CachedDetailsShownImmediately)
+{
+	PopupMenuView popupMenu;
+	auto pidls = BuildPidlCollection(3);
+	auto menu = BuildMenu(&popupMenu, pidls);
+
+	// The details were retrieved when the menu was first built, so rebuilding the menu should use
+	// those details, rather than showing placeholders while the details are refreshed.
+	m_detailsFetcher.SetDeferResults(true);
+	menu->RebuildMenu(pidls);
+	CheckItemDetails(popupMenu, pidls);
+}
+
+TEST_F(ShellItemsMenuTest, RecentCachedDetailsNotRefreshed)
+{
+	PopupMenuView popupMenu;
+	auto pidls = BuildPidlCollection(3);
+	auto menu = BuildMenu(&popupMenu, pidls);
+
+	m_detailsFetcher.SetDeferResults(true);
+	menu->RebuildMenu(pidls);
+	EXPECT_EQ(m_detailsFetcher.GetNumPendingRequests(), 0u);
+
+	// Once the cached details are old enough, they should be refreshed.
+	m_detailsFetcher.AgeCachedDetails(std::chrono::hours(1));
+	menu->RebuildMenu(pidls);
+	EXPECT_EQ(m_detailsFetcher.GetNumPendingRequests(), pidls.size());
+}
+
+TEST_F(ShellItemsMenuTest, PendingDetailsCancelledWhenMenuRebuilt)
+{
+	m_detailsFetcher.SetDeferResults(true);
+
+	PopupMenuView popupMenu;
+	auto pidls = BuildPidlCollection(3);
+	auto menu = BuildMenu(&popupMenu, pidls);
+	EXPECT_EQ(m_detailsFetcher.GetNumPendingRequests(), pidls.size());
+
+	// The requests for the original items are no longer needed, so only the requests for the new
+	// items should remain.
+	auto updatedPidls = BuildPidlCollection(5);
+	menu->RebuildMenu(updatedPidls);
+	EXPECT_EQ(m_detailsFetcher.GetNumPendingRequests(), updatedPidls.size());
+
+	m_detailsFetcher.TriggerPendingResultCallbacks();
+	CheckItemDetails(popupMenu, updatedPidls);
+}
+
+TEST_F(ShellItemsMenuTest, DetailsRetrievalAfterMenuRebuilt)
+{
+	m_detailsFetcher.SetDeferResults(true);
+
+	PopupMenuView popupMenu;
+	auto pidls = BuildPidlCollection(3);
+	auto menu = BuildMenu(&popupMenu, pidls);
+
+	m_detailsFetcher.SetIgnoreRequests(true);
+	menu->RebuildMenu(pidls);
+
+	// The results are for the original menu items, so they shouldn't be applied to the items added
+	// when the menu was rebuilt.
+	m_detailsFetcher.TriggerPendingResultCallbacks();
+	CheckItemsArePlaceholders(popupMenu);
+}
+
+TEST_F(ShellItemsMenuTest, DetailsRetrievalAfterMenuDestroyed)
+{
+	m_detailsFetcher.SetDeferResults(true);
+
+	PopupMenuView popupMenu;
+	auto pidls = BuildPidlCollection(3);
+	auto menu = BuildMenu(&popupMenu, pidls);
+
+	menu.reset();
+
+	m_detailsFetcher.TriggerPendingResultCallbacks();
+}
+
 TEST_F(ShellItemsMenuTest, IconRetrievalAfterMenuRebuilt)
 {
 	PopupMenuView popupMenu;
@@ -235,7 +343,7 @@ protected:
 
 	ShellItemsMenuSelectionTest() :
 		m_pidls(BuildPidlCollection(3)),
-		m_menu(&m_popupMenu, m_pidls, &m_browserWindow, &m_iconFetcher)
+		m_menu(&m_popupMenu, m_pidls, &m_browserWindow, &m_iconFetcher, &m_detailsFetcher)
 	{
 	}
 
@@ -273,6 +381,7 @@ private:
 	std::vector<PidlAbsolute> m_pidls;
 	BrowserWindowMock m_browserWindow;
 	IconFetcherFake m_iconFetcher;
+	ShellItemDetailsFetcherFake m_detailsFetcher;
 	ShellItemsMenu m_menu;
 };
 
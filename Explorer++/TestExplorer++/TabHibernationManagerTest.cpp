@@ -0,0 +1,71 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "TabHibernationManager.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+using namespace testing;
+
+class TabHibernationManagerTest : public Test
+{
+protected:
+	using Clock = TabHibernationManager::Clock;
+	using Candidate = TabHibernationManager::HibernationCandidate;
+
+	static constexpr uint64_t MB = 1024 * 1024;
+
+	TabHibernationManagerTest() : m_now(Clock::now())
+	{
+	}
+
+	const Clock::time_point m_now;
+};
+
+TEST_F(TabHibernationManagerTest, Timeout)
+{
+	std::vector<Candidate> candidates = { { 1, m_now - 45min, 1 * MB },
+		{ 2, m_now - 30min, 1 * MB }, { 3, m_now - 10min, 1 * MB } };
+
+	EXPECT_THAT(TabHibernationManager::SelectTabsToHibernate(candidates, m_now, 30min, 0),
+		ElementsAre(1, 2));
+	EXPECT_THAT(TabHibernationManager::SelectTabsToHibernate(candidates, m_now, 60min, 0),
+		IsEmpty());
+}
+
+TEST_F(TabHibernationManagerTest, MemoryBudget)
+{
+	std::vector<Candidate> candidates = { { 1, m_now - 3min, 100 * MB },
+		{ 2, m_now - 2min, 200 * MB }, { 3, m_now - 1min, 300 * MB } };
+
+	// The least recently used tabs should be hibernated first, until the remaining tabs are within
+	// the budget.
+	EXPECT_THAT(TabHibernationManager::SelectTabsToHibernate(candidates, m_now, 30min, 350 * MB),
+		ElementsAre(1, 2));
+	EXPECT_THAT(TabHibernationManager::SelectTabsToHibernate(candidates, m_now, 30min, 600 * MB),
+		IsEmpty());
+}
+
+TEST_F(TabHibernationManagerTest, TimeoutAndMemoryBudget)
+{
+	std::vector<Candidate> candidates = { { 1, m_now - 45min, 10 * MB },
+		{ 2, m_now - 5min, 500 * MB }, { 3, m_now - 1min, 100 * MB } };
+
+	// The first tab has timed out. Hibernating it isn't enough to bring the memory usage within the
+	// budget, so the second tab should be hibernated as well.
+	EXPECT_THAT(TabHibernationManager::SelectTabsToHibernate(candidates, m_now, 30min, 550 * MB),
+		ElementsAre(1, 2));
+}
+
+TEST_F(TabHibernationManagerTest, ChecksDisabled)
+{
+	std::vector<Candidate> candidates = { { 1, m_now - 24h, 1000 * MB },
+		{ 2, m_now - 12h, 1000 * MB } };
+
+	// A timeout and budget of 0 should disable the corresponding checks.
+	EXPECT_THAT(TabHibernationManager::SelectTabsToHibernate(candidates, m_now, 0min, 0),
+		IsEmpty());
+}
@@ -0,0 +1,285 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "../Helper/TaskScheduler.h"
+#include "../Helper/PerformanceTracer.h"
+#include <gtest/gtest.h>
+#include <wil/resource.h>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+using namespace testing;
+
+namespace
+{
+
+// Blocks the scheduler's workers until Release() is called.
+class WorkerBlocker
+{
+public:
+	WorkerBlocker() : m_releaseFuture(m_releasePromise.get_future().share())
+	{
+	}
+
+	void Block(TaskQueue &queue, int numWorkers)
+	{
+		std::vector<std::future<void>> startedFutures;
+
+		for (int i = 0; i < numWorkers; i++)
+		{
+			auto startedPromise = std::make_shared<std::promise<void>>();
+			startedFutures.push_back(startedPromise->get_future());
+
+			queue.Push(
+				[startedPromise, releaseFuture = m_releaseFuture]
+				{
+					startedPromise->set_value();
+					releaseFuture.wait();
+				});
+		}
+
+		for (auto &startedFuture : startedFutures)
+		{
+			startedFuture.wait();
+		}
+	}
+
+	void Release()
+	{
+		m_releasePromise.set_value();
+	}
+
+private:
+	std::promise<void> m_releasePromise;
+	std::shared_future<void> m_releaseFuture;
+};
+
+}
+
+TEST(TaskSchedulerTest, Result)
+{
+	TaskScheduler scheduler(2);
+	TaskQueue queue(&scheduler);
+
+	auto future = queue.Push([] { return 42; });
+	EXPECT_EQ(future.get(), 42);
+}
+
+TEST(TaskSchedulerTest, Priority)
+{
+	TaskScheduler scheduler(1);
+	TaskQueue blockingQueue(&scheduler);
+	TaskQueue backgroundQueue(&scheduler, TaskPriority::Background);
+	TaskQueue normalQueue(&scheduler, TaskPriority::Normal);
+	TaskQueue foregroundQueue(&scheduler, TaskPriority::Foreground);
+
+	WorkerBlocker blocker;
+	blocker.Block(blockingQueue, 1);
+
+	std::mutex mutex;
+	std::vector<TaskPriority> order;
+
+	auto makeTask = [&mutex, &order](TaskPriority priority)
+	{
+		return [&mutex, &order, priority]
+		{
+			std::scoped_lock lock(mutex);
+			order.push_back(priority);
+		};
+	};
+
+	auto backgroundFuture = backgroundQueue.Push(makeTask(TaskPriority::Background));
+	auto normalFuture = normalQueue.Push(makeTask(TaskPriority::Normal));
+	auto foregroundFuture = foregroundQueue.Push(makeTask(TaskPriority::Foreground));
+
+	blocker.Release();
+
+	backgroundFuture.wait();
+	normalFuture.wait();
+	foregroundFuture.wait();
+
+	EXPECT_EQ(order,
+		(std::vector<TaskPriority>{ TaskPriority::Foreground, TaskPriority::Normal,
+			TaskPriority::Background }));
+}
+
+TEST(TaskSchedulerTest, SetPriority)
+{
+	TaskScheduler scheduler(1);
+	TaskQueue blockingQueue(&scheduler);
+	TaskQueue queue1(&scheduler, TaskPriority::Normal);
+	TaskQueue queue2(&scheduler, TaskPriority::Normal);
+
+	WorkerBlocker blocker;
+	blocker.Block(blockingQueue, 1);
+
+	std::mutex mutex;
+	std::vector<int> order;
+
+	auto future1 = queue1.Push(
+		[&mutex, &order]
+		{
+			std::scoped_lock lock(mutex);
+			order.push_back(1);
+		});
+	auto future2 = queue2.Push(
+		[&mutex, &order]
+		{
+			std::scoped_lock lock(mutex);
+			order.push_back(2);
+		});
+
+	queue1.SetPriority(TaskPriority::Background);
+	EXPECT_EQ(queue1.GetPriority(), TaskPriority::Background);
+
+	blocker.Release();
+
+	future1.wait();
+	future2.wait();
+
+	EXPECT_EQ(order, (std::vector<int>{ 2, 1 }));
+}
+
+TEST(TaskSchedulerTest, MaxConcurrency)
+{
+	TaskScheduler scheduler(4);
+	TaskQueue queue(&scheduler, TaskPriority::Normal, 1);
+
+	std::atomic<int> numRunning = 0;
+	std::atomic<int> maxRunning = 0;
+	std::vector<std::future<void>> futures;
+
+	for (int i = 0; i < 20; i++)
+	{
+		futures.push_back(queue.Push(
+			[&numRunning, &maxRunning]
+			{
+				int running = ++numRunning;
+				int currentMax = maxRunning;
+
+				while (running > currentMax
+					&& !maxRunning.compare_exchange_weak(currentMax, running))
+				{
+				}
+
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				numRunning--;
+			}));
+	}
+
+	for (auto &future : futures)
+	{
+		future.wait();
+	}
+
+	EXPECT_EQ(maxRunning, 1);
+}
+
+TEST(TaskSchedulerTest, CancelPendingTasks)
+{
+	TaskScheduler scheduler(1);
+	TaskQueue queue(&scheduler);
+
+	std::promise<void> startedPromise;
+	std::promise<void> releasePromise;
+	auto releaseFuture = releasePromise.get_future();
+
+	auto runningFuture = queue.Push(
+		[&startedPromise, &releaseFuture](const CancellationToken &cancellationToken)
+		{
+			startedPromise.set_value();
+			releaseFuture.wait();
+			return cancellationToken.IsCancelled();
+		});
+
+	startedPromise.get_future().wait();
+
+	bool pendingTaskRan = false;
+	auto pendingFuture = queue.Push([&pendingTaskRan] { pendingTaskRan = true; });
+
+	queue.CancelPendingTasks();
+	releasePromise.set_value();
+
+	// The running task should have been able to see that it was cancelled.
+	EXPECT_TRUE(runningFuture.get());
+
+	// The pending task should never have run.
+	EXPECT_THROW(pendingFuture.get(), std::future_error);
+	EXPECT_FALSE(pendingTaskRan);
+
+	// Tasks pushed after the cancellation should run as normal and shouldn't be considered
+	// cancelled.
+	auto newFuture =
+		queue.Push([](const CancellationToken &cancellationToken)
+			{ return cancellationToken.IsCancelled(); });
+	EXPECT_FALSE(newFuture.get());
+}
+
+TEST(TaskSchedulerTest, TaskCountsTraced)
+{
+	auto &tracer = PerformanceTracer::GetInstance();
+	tracer.SetEnabled(true);
+	auto disableTracing = wil::scope_exit([&tracer] { tracer.SetEnabled(false); });
+
+	auto getCounterValue = [&tracer](std::string_view name) -> std::optional<int64_t>
+	{
+		auto summaries = tracer.GetCounterSummaries();
+		auto itr = std::find_if(summaries.begin(), summaries.end(),
+			[name](const auto &summary)
+			{ return summary.category == "TaskScheduler" && summary.name == name; });
+
+		if (itr == summaries.end())
+		{
+			return std::nullopt;
+		}
+
+		return itr->value;
+	};
+
+	TaskScheduler scheduler(1);
+	TaskQueue queue(&scheduler);
+
+	WorkerBlocker blocker;
+	blocker.Block(queue, 1);
+
+	queue.Push([] {});
+	queue.Push([] {});
+
+	EXPECT_EQ(getCounterValue("QueuedTasks"), 2);
+	EXPECT_EQ(getCounterValue("RunningTasks"), 1);
+
+	queue.CancelPendingTasks();
+	EXPECT_EQ(getCounterValue("QueuedTasks"), 0);
+
+	blocker.Release();
+}
+
+TEST(TaskSchedulerTest, DestroyQueueWaitsForRunningTasks)
+{
+	TaskScheduler scheduler(2);
+	std::atomic<bool> taskFinished = false;
+
+	{
+		TaskQueue queue(&scheduler);
+
+		std::promise<void> startedPromise;
+		queue.Push(
+			[&startedPromise, &taskFinished]
+			{
+				startedPromise.set_value();
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+				taskFinished = true;
+			});
+
+		startedPromise.get_future().wait();
+	}
+
+	EXPECT_TRUE(taskFinished);
+}
@@ -0,0 +1,23 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "TempFileTestHelper.h"
+#include "../Helper/Helper.h"
+
+TempFileForTest::TempFileForTest(const std::wstring &extension) :
+	m_path(std::filesystem::temp_directory_path() / (L"ExplorerTest" + CreateGUID() + extension))
+{
+}
+
+TempFileForTest::~TempFileForTest()
+{
+	std::error_code error;
+	std::filesystem::remove(m_path, error);
+}
+
+const std::filesystem::path &TempFileForTest::GetPath() const
+{
+	return m_path;
+}
@@ -0,0 +1,24 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <filesystem>
+#include <string>
+
+// Provides a uniquely named path in the temporary directory, so that tests that write files don't
+// interfere with each other when run in parallel. The file (if it was created) is removed when
+// this object is destroyed.
+class TempFileForTest : private boost::noncopyable
+{
+public:
+	explicit TempFileForTest(const std::wstring &extension);
+	~TempFileForTest();
+
+	const std::filesystem::path &GetPath() const;
+
+private:
+	const std::filesystem::path m_path;
+};
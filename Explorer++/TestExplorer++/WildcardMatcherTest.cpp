@@ -0,0 +1,47 @@
+// Copyright (C) Explorer++ Project
+// SPDX-License-Identifier: GPL-3.0-only
+// See LICENSE in the top level directory
+
+#include "pch.h"
+#include "../Helper/WildcardMatcher.h"
+#include <gtest/gtest.h>
+
+TEST(WildcardMatcherTest, SimpleMatches)
+{
+	EXPECT_TRUE(WildcardMatcher(L"*.txt", true).Matches(L"Test.txt"));
+	EXPECT_TRUE(WildcardMatcher(L"?.txt", true).Matches(L"1.txt"));
+	EXPECT_TRUE(WildcardMatcher(L"?ab*cd.tx?", true).Matches(L"1abefghcd.txt"));
+	EXPECT_TRUE(WildcardMatcher(L"Test?1*txt", true).Matches(L"Test11test.txt"));
+	EXPECT_TRUE(WildcardMatcher(L"*", true).Matches(L""));
+}
+
+TEST(WildcardMatcherTest, SimpleMismatches)
+{
+	EXPECT_FALSE(WildcardMatcher(L"*.txt", true).Matches(L"Test.txt.bak"));
+	EXPECT_FALSE(WildcardMatcher(L"?.txt", true).Matches(L"12.txt"));
+	EXPECT_FALSE(WildcardMatcher(L"a*b*c", true).Matches(L"aXbY"));
+	EXPECT_FALSE(WildcardMatcher(L"", true).Matches(L"file"));
+}
+
+TEST(WildcardMatcherTest, Backtracking)
+{
+	EXPECT_TRUE(WildcardMatcher(L"*ab", true).Matches(L"aaab"));
+	EXPECT_TRUE(WildcardMatcher(L"a*a*a", true).Matches(L"aaaaa"));
+	EXPECT_TRUE(WildcardMatcher(L"*.tar.gz", true).Matches(L"archive.tar.tar.gz"));
+}
+
+TEST(WildcardMatcherTest, CaseSensitivity)
+{
+	EXPECT_FALSE(WildcardMatcher(L"*.TXT", true).Matches(L"test.txt"));
+	EXPECT_TRUE(WildcardMatcher(L"*.TXT", false).Matches(L"test.txt"));
+	EXPECT_TRUE(WildcardMatcher(L"привет", false).Matches(L"Привет"));
+	EXPECT_FALSE(WildcardMatcher(L"привет", true).Matches(L"Привет"));
+}
+
+TEST(WildcardMatcherTest, MultiplePatterns)
+{
+	WildcardMatcher matcher(L"*.h: *.cpp", true);
+	EXPECT_TRUE(matcher.Matches(L"file.h"));
+	EXPECT_TRUE(matcher.Matches(L"file.cpp"));
+	EXPECT_FALSE(matcher.Matches(L"file.txt"));
+}